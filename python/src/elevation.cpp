@@ -134,12 +134,34 @@ static PyObject *Elevation_calcShadowMask(PyObject *self, PyObject *args)
 {
     const char *pszInputImage, *pszOutputFile, *pszGDALFormat;
     float azimuth, zenith, maxHeight = 0.0;
-    if( !PyArg_ParseTuple(args, "ssfffs:shadowmask", &pszInputImage, &pszOutputFile, &azimuth, &zenith, &maxHeight, &pszGDALFormat))
+    unsigned int nCores = 1;
+    if( !PyArg_ParseTuple(args, "ssfffs|I:shadowmask", &pszInputImage, &pszOutputFile, &azimuth, &zenith, &maxHeight, &pszGDALFormat, &nCores))
         return NULL;
     
     try
     {
-        rsgis::cmds::executeCalcShadowMask(std::string(pszInputImage), std::string(pszOutputFile), azimuth, zenith, maxHeight, std::string(pszGDALFormat));
+        rsgis::cmds::executeCalcShadowMask(std::string(pszInputImage), std::string(pszOutputFile), azimuth, zenith, maxHeight, std::string(pszGDALFormat), nCores);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return NULL;
+    }
+    
+    Py_RETURN_NONE;
+}
+
+static PyObject *Elevation_calcSkyViewFactor(PyObject *self, PyObject *args)
+{
+    const char *pszInputImage, *pszOutputFile, *pszGDALFormat;
+    unsigned int nDirections = 16;
+    unsigned int nCores = 1;
+    if( !PyArg_ParseTuple(args, "ssIs|I:skyViewFactor", &pszInputImage, &pszOutputFile, &nDirections, &pszGDALFormat, &nCores))
+        return NULL;
+    
+    try
+    {
+        rsgis::cmds::executeCalcSkyViewFactor(std::string(pszInputImage), std::string(pszOutputFile), nDirections, std::string(pszGDALFormat), nCores);
     }
     catch(rsgis::cmds::RSGISCmdException &e)
     {
@@ -214,13 +236,14 @@ static PyObject *Elevation_dtmAspectMedianFilter(PyObject *self, PyObject *args)
 static PyObject *Elevation_fillDEMSoilleGratin1994(PyObject *self, PyObject *args)
 {
     const char *pszInputDTMImage, *pszValidMaskImage, *pszOutputFile, *pszGDALFormat;
+    unsigned int tileSize = 0;
 
-    if( !PyArg_ParseTuple(args, "ssss:fillDEMSoilleGratin1994", &pszInputDTMImage, &pszValidMaskImage, &pszOutputFile, &pszGDALFormat))
+    if( !PyArg_ParseTuple(args, "ssss|I:fillDEMSoilleGratin1994", &pszInputDTMImage, &pszValidMaskImage, &pszOutputFile, &pszGDALFormat, &tileSize))
         return NULL;
     
     try
     {
-        rsgis::cmds::executeDEMFillSoilleGratin1994(std::string(pszInputDTMImage), std::string(pszValidMaskImage), std::string(pszOutputFile), std::string(pszGDALFormat));
+        rsgis::cmds::executeDEMFillSoilleGratin1994(std::string(pszInputDTMImage), std::string(pszValidMaskImage), std::string(pszOutputFile), std::string(pszGDALFormat), tileSize);
     }
     catch(rsgis::cmds::RSGISCmdException &e)
     {
@@ -300,7 +323,7 @@ static PyMethodDef ElevationMethods[] = {
 ":param gdalformat: is a string with the output image format for the GDAL driver.\n"},
     
 {"shadowmask", Elevation_calcShadowMask, METH_VARARGS,
-"rsgislib.elevation.shadowmask(inputImage, outputImage, solarAzimuth, solarZenith, maxHeight, gdalformat)\n"
+"rsgislib.elevation.shadowmask(inputImage, outputImage, solarAzimuth, solarZenith, maxHeight, gdalformat, ncores=1)\n"
 "Calculates a shadow mask given an input elevation model\n"
 "\n"
 "Where:\n"
@@ -309,8 +332,21 @@ static PyMethodDef ElevationMethods[] = {
 ":param outputImage: is a string containing the name and path of the output file.\n"
 ":param solarAzimuth: is a float with the solar azimuth in degrees.\n"
 ":param solarZenith: is a float with the solar zenith in degrees.\n"
-":param maxHeight: is a float with the maximum height for the ray tracing (should be above the maximum elevation within the scene)."
-":param gdalformat: is a string with the output image format for the GDAL driver.\n"},
+":param maxHeight: is a float which is no longer used (the horizon is found across the whole scene) but retained for compatibility.\n"
+":param gdalformat: is a string with the output image format for the GDAL driver.\n"
+":param ncores: is an optional unsigned int specifying the number of threads to use (0 uses all available; default 1).\n"},
+
+{"skyViewFactor", Elevation_calcSkyViewFactor, METH_VARARGS,
+"rsgislib.elevation.skyViewFactor(inputImage, outputImage, ndirections, gdalformat, ncores=1)\n"
+"Calculates the sky view factor (proportion of the sky hemisphere visible, 0-1) for each pixel given an input elevation model\n"
+"\n"
+"Where:\n"
+"\n"
+":param inputImage: is a string containing the name and path of the input DEM file (must have a no data value defined).\n"
+":param outputImage: is a string containing the name and path of the output file.\n"
+":param ndirections: is an unsigned int with the number of azimuth directions for which the horizon is found (e.g., 16).\n"
+":param gdalformat: is a string with the output image format for the GDAL driver.\n"
+":param ncores: is an optional unsigned int specifying the number of threads to use (0 uses all available; default 1).\n"},
     
     
 {"localIncidenceAngle", Elevation_calcLocalIncidenceAngle, METH_VARARGS,
@@ -352,17 +388,21 @@ static PyMethodDef ElevationMethods[] = {
 ":param gdalformat: is a string with the output image format for the GDAL driver.\n"},
 
 {"fillDEMSoilleGratin1994", Elevation_fillDEMSoilleGratin1994, METH_VARARGS,
-"rsgislib.elevation.fillDEMSoilleGratin1994(inputDEMImage, validMaskImage, outputImage, gdalformat)\n"
+"rsgislib.elevation.fillDEMSoilleGratin1994(inputDEMImage, validMaskImage, outputImage, gdalformat, tilesize=0)\n"
 "Filter the local minima in a DEM using the Soille and Gratin 1994 algorithm.\n\n"
 "Soille, P., and Gratin, C. (1994). An efficient algorithm for drainage network\n"
 "extraction on DEMs. J. Visual Communication and Image Representation. 5(2). 181-189.\n"
 "\n"
+"The fill is implemented as a priority flood so integer and floating point DEMs are supported.\n"
+"If a tile size is given the DEM is filled in tiles (Barnes, 2016) rather than held in memory.\n"
+"\n"
 "Where:\n"
 "\n"
 ":param inputDEMImage: is a string containing the name and path of the input DEM file.\n"
 ":param validMaskImage: is a string containing the name and path to a binary image specifying the valid data region (1 == valid)\n"
 ":param outputImage: is a string containing the name and path of the output file.\n"
 ":param gdalformat: is a string with the output image format for the GDAL driver.\n"
+":param tilesize: is an optional integer with the size (in pixels) of the tiles used to fill DEMs too large for memory (Default = 0; fill in memory).\n"
 "\n"
 "Example::\n"
 "\n"
@@ -149,6 +149,67 @@ static PyObject *HistoCube_PopulateHistoCubeLayer(PyObject *self, PyObject *args
     Py_RETURN_NONE;
 }
 
+static PyObject *HistoCube_PopulateHistoCubeLayers(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    const char *pszCubeFile;
+    const char *pszClumpsImg;
+    PyObject *layerNamesObj;
+    PyObject *valsImgsObj;
+    PyObject *bandsObj;
+    unsigned int nCores = 1;
+    
+    static char *kwlist[] = {"filename", "layerNames", "clumpsImg", "valsImgs", "bands", "ncores", NULL};
+    
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "sOsOO|I:populateHistoCubeLayers", kwlist, &pszCubeFile, &layerNamesObj, &pszClumpsImg, &valsImgsObj, &bandsObj, &nCores))
+    {
+        return NULL;
+    }
+    
+    if( !PySequence_Check(layerNamesObj) || !PySequence_Check(valsImgsObj) || !PySequence_Check(bandsObj))
+    {
+        PyErr_SetString(GETSTATE(self)->error, "layerNames, valsImgs and bands arguments must be sequences");
+        return NULL;
+    }
+    
+    int nLayerNames = 0;
+    std::string *layerNamesArr = ExtractStringArrayFromSequence(layerNamesObj, &nLayerNames);
+    std::vector<std::string> layerNames(layerNamesArr, layerNamesArr+nLayerNames);
+    delete[] layerNamesArr;
+    
+    int nValsImgs = 0;
+    std::string *valsImgsArr = ExtractStringArrayFromSequence(valsImgsObj, &nValsImgs);
+    std::vector<std::string> valsImgs(valsImgsArr, valsImgsArr+nValsImgs);
+    delete[] valsImgsArr;
+    
+    std::vector<unsigned int> bands;
+    Py_ssize_t nBands = PySequence_Size(bandsObj);
+    bands.reserve(nBands);
+    for( Py_ssize_t n = 0; n < nBands; n++ )
+    {
+        PyObject *o = PySequence_GetItem(bandsObj, n);
+        if( ( o == NULL ) || ( o == Py_None ) || !RSGISPY_CHECK_INT(o) )
+        {
+            PyErr_SetString(GETSTATE(self)->error, "value in bands was not an int." );
+            Py_XDECREF(o);
+            return NULL;
+        }
+        bands.push_back(RSGISPY_UINT_EXTRACT(o));
+        Py_DECREF(o);
+    }
+    
+    try
+    {
+        rsgis::cmds::executePopulateHistoCubeLayers(std::string(pszCubeFile), layerNames, std::string(pszClumpsImg), valsImgs, bands, nCores);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return NULL;
+    }
+    
+    Py_RETURN_NONE;
+}
+
 static PyObject *HistoCube_ExportHistoBins2ImgBands(PyObject *self, PyObject *args, PyObject *keywds)
 {
     const char *pszCubeFile;
@@ -380,6 +441,22 @@ static PyMethodDef HistoCubeMethods[] = {
 "\n"
 },
 
+{"populateHistoCubeLayers", (PyCFunction)HistoCube_PopulateHistoCubeLayers, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.histocube.populateHistoCubeLayers(filename=string, layerNames=list, clumpsImg=string, valsImgs=list, bands=list, ncores=int)\n"
+"Populate a number of histogram layers (e.g., one for each acquisition date), each from a band of its own values image.\n"
+"The layers are accumulated in parallel and updates are written to the file a chunk at a time.\n"
+"Note, data is 'added' to any existing data already within the histogram(s).\n"
+"\n"
+"Where:\n"
+"\n"
+":param filename: is the file path and name for the histogram cube file.\n"
+":param layerNames: is a list of the names of the layers to be populated.\n"
+":param clumpsImg: is a clumps image that specifies which histogram cube row pixels in with values image are associated (note resolution must be the same as the values images).\n"
+":param valsImgs: is a list of images (one for each layer) with the values which are populated into the histogram cube.\n"
+":param bands: is a list of band numbers (one for each layer; note band numbers start at 1)\n"
+":param ncores: is the number of threads to use, one layer is populated on each thread (Optional, default is 1; 0 uses all available).\n"
+"\n"},
+
 {"exportHistoBins2ImgBands", (PyCFunction)HistoCube_ExportHistoBins2ImgBands, METH_VARARGS | METH_KEYWORDS,
 "rsgislib.histocube.exportHistoBins2ImgBands(filename=string, layerName=string, clumpsImg=string, outputImg=string, gdalformat=string, binidxs=list)\n"
 "Export bins from the histogram cube to an output image.\n"
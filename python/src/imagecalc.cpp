@@ -40,17 +40,29 @@ static struct ImageCalcState _state;
 
 static PyObject *ImageCalc_BandMath(PyObject *self, PyObject *args, PyObject *keywds)
 {
-    static char *kwlist[] = {"outputimg", "exp", "gdalformat", "datatype", "banddefseq", "expbandname", "outputexists", NULL};
+    static char *kwlist[] = {"outputimg", "exp", "gdalformat", "datatype", "banddefseq", "expbandname", "outputexists", "iooptions", NULL};
     const char *pszOutputFile, *pszExpression, *pszGDALFormat;
     int nDataType;
     int bExpBandName = 0;
     int bOutputImgExists = 0;
     PyObject *pBandDefnObj;
-    if( !PyArg_ParseTupleAndKeywords(args, keywds, "sssiO|ii:bandMath", kwlist, &pszOutputFile, &pszExpression, &pszGDALFormat, &nDataType, &pBandDefnObj, &bExpBandName, &bOutputImgExists))
+    PyObject *pIOOptionsObj = Py_None;
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "sssiO|iiO:bandMath", kwlist, &pszOutputFile, &pszExpression, &pszGDALFormat, &nDataType, &pBandDefnObj, &bExpBandName, &bOutputImgExists, &pIOOptionsObj))
     {
         return NULL;
     }
 
+    rsgis::cmds::RSGISImageIOOptionsCmds ioOptions;
+    if( pIOOptionsObj != Py_None )
+    {
+        std::string errMsg = "";
+        if( !RSGISPY_IMAGE_IO_OPTIONS_EXTRACT(pIOOptionsObj, &ioOptions, &errMsg) )
+        {
+            PyErr_SetString(GETSTATE(self)->error, errMsg.c_str());
+            return NULL;
+        }
+    }
+
     if( !PySequence_Check(pBandDefnObj))
     {
         PyErr_SetString(GETSTATE(self)->error, "last argument must be a sequence");
@@ -112,7 +124,7 @@ static PyObject *ImageCalc_BandMath(PyObject *self, PyObject *args, PyObject *ke
         rsgis::RSGISLibDataType type = (rsgis::RSGISLibDataType)nDataType;
         bool useExpAsbandName = (bool)bExpBandName;
         bool outputImgExists = (bool)bOutputImgExists;
-        rsgis::cmds::executeBandMaths(pRSGISStruct, nBandDefns, pszOutputFile, pszExpression, pszGDALFormat, type, useExpAsbandName, outputImgExists);
+        rsgis::cmds::executeBandMaths(pRSGISStruct, nBandDefns, pszOutputFile, pszExpression, pszGDALFormat, type, useExpAsbandName, outputImgExists, (pIOOptionsObj != Py_None)?&ioOptions:NULL);
     }
     catch(rsgis::cmds::RSGISCmdException &e)
     {
@@ -2072,7 +2084,7 @@ static PyObject *ImageCalc_CalcImgMeanInMask(PyObject *self, PyObject *args, PyO
 // Our list of functions in this module
 static PyMethodDef ImageCalcMethods[] = {
     {"bandMath", (PyCFunction)ImageCalc_BandMath, METH_VARARGS | METH_KEYWORDS,
-"rsgislib.imagecalc.bandMath(outputimg, exp, gdalformat, datatype, banddefseq, expbandname, outputexists)\n"
+"rsgislib.imagecalc.bandMath(outputimg, exp, gdalformat, datatype, banddefseq, expbandname, outputexists, iooptions)\n"
 "Performs band math calculation.\n"
 "The syntax for the expression is from the muparser library ('http://muparser.beltoforion.de <http://muparser.beltoforion.de>`): `see here <http://beltoforion.de/article.php?a=muparser&hl=en&p=features&s=idPageTop>`\n."
 "\n"
@@ -2084,7 +2096,18 @@ static PyMethodDef ImageCalcMethods[] = {
 ":param datatype: is an containing one of the values from rsgislib.TYPE_*\n"
 ":param banddefseq: is a sequence of rsgislib.imagecalc.BandDefn objects that define the inputs\n"
 ":param expbandname: is an optional bool specifying whether the band name should be the expression (Default = False).\n"
-":param outputexists: is an optional bool specifying whether the output image already exists and it should be editted rather than overwritten (Default=False)."
+":param outputexists: is an optional bool specifying whether the output image already exists and it should be editted rather than overwritten (Default=False).\n"
+":param iooptions: is an optional dict specifying how the output image is created and the GDAL cache used (Default=None, i.e., the defaults below). The keys are:\n"
+"      * 'creationoptions' - a dict of GDAL creation options (e.g., {'PREDICTOR':'2'}), which override the defaults for the driver.\n"
+"      * 'compression' - the compression (e.g., 'LZW', 'DEFLATE', 'ZSTD' or 'NONE'; default is the driver default).\n"
+"      * 'compressionlevel' - the compression level (default -1, the driver default).\n"
+"      * 'tiled' - whether a GTiff is tiled (default True).\n"
+"      * 'blocksize' - the block size in pixels, a multiple of 16 (default 256).\n"
+"      * 'cachemax' - the GDAL cache size in bytes while the command runs (default 0, the GDAL setting).\n"
+"      * 'ncores' - the number of threads GDAL uses to compress the blocks (default 1; 0 uses all the CPUs).\n"
+"      * 'overviews' - whether the overviews are built once the image has been written (default False).\n"
+"      * 'ovresampling' - the resampling used for the overviews (default 'AVERAGE').\n"
+"      * 'ovminsize' - overviews are built until they would be smaller than this number of pixels (default 256)."
 "\n"
 "Example::\n"
 "\n"
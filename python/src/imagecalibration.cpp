@@ -40,24 +40,11 @@ struct ImageCalibrationState
 static struct ImageCalibrationState _state;
 #endif
 
-static PyObject *ImageCalibration_landsat2Radiance(PyObject *self, PyObject *args)
+/** Reads a sequence of Landsat radiance band definitions, returning false (with the error set) if they are not valid. */
+static bool parseLandsatRadGainOffs(PyObject *self, PyObject *pBandDefnObj, std::vector<rsgis::cmds::CmdsLandsatRadianceGainsOffsets> *landsatRadGainOffs)
 {
-    const char *pszOutputFile, *pszGDALFormat;
-    PyObject *pBandDefnObj;
-    if( !PyArg_ParseTuple(args, "ssO:landsat2Radiance", &pszOutputFile, &pszGDALFormat, &pBandDefnObj))
-    {
-        return NULL;
-    }
-
-    if( !PySequence_Check(pBandDefnObj))
-    {
-        PyErr_SetString(GETSTATE(self)->error, "Last argument must be a sequence");
-        return NULL;
-    }
-
     Py_ssize_t nBandDefns = PySequence_Size(pBandDefnObj);
-    std::vector<rsgis::cmds::CmdsLandsatRadianceGainsOffsets> landsatRadGainOffs;
-    landsatRadGainOffs.reserve(nBandDefns);
+    landsatRadGainOffs->reserve(nBandDefns);
     
     for( Py_ssize_t n = 0; n < nBandDefns; n++ )
     {
@@ -69,7 +56,7 @@ static PyObject *ImageCalibration_landsat2Radiance(PyObject *self, PyObject *arg
             PyErr_SetString(GETSTATE(self)->error, "Could not find string attribute \'bandName\'" );
             Py_XDECREF(pBandName);
             Py_DECREF(o);
-            return NULL;
+            return false;
         }
 
         PyObject *pFileName = PyObject_GetAttrString(o, "fileName");
@@ -79,7 +66,7 @@ static PyObject *ImageCalibration_landsat2Radiance(PyObject *self, PyObject *arg
             Py_DECREF(pBandName);
             Py_XDECREF(pFileName);
             Py_DECREF(o);
-            return NULL;
+            return false;
         }
 
         PyObject *pBandIndex = PyObject_GetAttrString(o, "bandIndex");
@@ -90,7 +77,7 @@ static PyObject *ImageCalibration_landsat2Radiance(PyObject *self, PyObject *arg
             Py_DECREF(pFileName);
             Py_XDECREF(pBandIndex);
             Py_DECREF(o);
-            return NULL;
+            return false;
         }
         
         PyObject *pLMin = PyObject_GetAttrString(o, "lMin");
@@ -102,7 +89,7 @@ static PyObject *ImageCalibration_landsat2Radiance(PyObject *self, PyObject *arg
             Py_XDECREF(pBandIndex);
             Py_XDECREF(pLMin);
             Py_DECREF(o);
-            return NULL;
+            return false;
         }
         
         PyObject *pLMax = PyObject_GetAttrString(o, "lMax");
@@ -115,7 +102,7 @@ static PyObject *ImageCalibration_landsat2Radiance(PyObject *self, PyObject *arg
             Py_XDECREF(pLMin);
             Py_XDECREF(pLMax);
             Py_DECREF(o);
-            return NULL;
+            return false;
         }
         
         PyObject *pQCalMin = PyObject_GetAttrString(o, "qCalMin");
@@ -129,7 +116,7 @@ static PyObject *ImageCalibration_landsat2Radiance(PyObject *self, PyObject *arg
             Py_XDECREF(pLMax);
             Py_XDECREF(pQCalMin);
             Py_DECREF(o);
-            return NULL;
+            return false;
         }
         
         PyObject *pQCalMax = PyObject_GetAttrString(o, "qCalMax");
@@ -144,7 +131,7 @@ static PyObject *ImageCalibration_landsat2Radiance(PyObject *self, PyObject *arg
             Py_XDECREF(pQCalMin);
             Py_XDECREF(pQCalMax);
             Py_DECREF(o);
-            return NULL;
+            return false;
         }
                 
         rsgis::cmds::CmdsLandsatRadianceGainsOffsets radVals;
@@ -156,7 +143,7 @@ static PyObject *ImageCalibration_landsat2Radiance(PyObject *self, PyObject *arg
         radVals.qCalMin = RSGISPY_FLOAT_EXTRACT(pQCalMin);
         radVals.qCalMax = RSGISPY_FLOAT_EXTRACT(pQCalMax);
         
-        landsatRadGainOffs.push_back(radVals);
+        landsatRadGainOffs->push_back(radVals);
 
         Py_DECREF(pBandName);
         Py_DECREF(pFileName);
@@ -168,6 +155,192 @@ static PyObject *ImageCalibration_landsat2Radiance(PyObject *self, PyObject *arg
         Py_DECREF(o);
     }
     
+    return true;
+}
+
+/** Reads a 6S elevation / AOT LUT, returning NULL (with the error set) if it is not valid. */
+static std::vector<rsgis::cmds::Cmds6SBaseElevAOTLUT>* parse6SElevAOTLUT(PyObject *self, PyObject *pLUTObj)
+{
+    Py_ssize_t nLUTDefns = PySequence_Size(pLUTObj);
+    
+    std::vector<rsgis::cmds::Cmds6SBaseElevAOTLUT> *elevAOTLUT = new std::vector<rsgis::cmds::Cmds6SBaseElevAOTLUT>();
+    elevAOTLUT->reserve(nLUTDefns);
+    
+    for( Py_ssize_t n = 0; n < nLUTDefns; ++n )
+    {
+        PyObject *pElevLUTValuesObj = PySequence_GetItem(pLUTObj, n);
+        rsgis::cmds::Cmds6SBaseElevAOTLUT lutElevVal = rsgis::cmds::Cmds6SBaseElevAOTLUT();
+        
+        PyObject *pElev = PyObject_GetAttrString(pElevLUTValuesObj, "Elev");
+        if( ( pElev == NULL ) || ( pElev == Py_None ) || !RSGISPY_CHECK_FLOAT(pElev) )
+        {
+            PyErr_SetString(GETSTATE(self)->error, "Could not find float attribute \'Elev\' for the LUT (make sure it is a float!)" );
+            Py_XDECREF(pElev);
+            Py_DECREF(pElevLUTValuesObj);
+            return NULL;
+        }
+        lutElevVal.elev = RSGISPY_FLOAT_EXTRACT(pElev);
+        Py_DECREF(pElev);
+        
+        
+        PyObject *pAOTLUTValuesObj = PyObject_GetAttrString(pElevLUTValuesObj, "Coeffs");
+        
+        if( !PySequence_Check(pAOTLUTValuesObj))
+        {
+            PyErr_SetString(GETSTATE(self)->error, "Each element in the Elevation LUT have a sequence of AOT \'Coeffs\'.");
+            return NULL;
+        }
+        Py_ssize_t nAOTLUTDefns = PySequence_Size(pAOTLUTValuesObj);
+        lutElevVal.aotLUT = std::vector<rsgis::cmds::Cmds6SAOTLUT>();
+        lutElevVal.aotLUT.reserve(nAOTLUTDefns);
+        
+        for( Py_ssize_t k = 0; k < nAOTLUTDefns; ++k )
+        {
+            PyObject *pAOTValuesObj = PySequence_GetItem(pAOTLUTValuesObj, k);
+            rsgis::cmds::Cmds6SAOTLUT lutAOTVal = rsgis::cmds::Cmds6SAOTLUT();
+            
+            PyObject *pAOT = PyObject_GetAttrString(pAOTValuesObj, "AOT");
+            if( ( pAOT == NULL ) || ( pAOT == Py_None ) || !RSGISPY_CHECK_FLOAT(pAOT) )
+            {
+                PyErr_SetString(GETSTATE(self)->error, "Could not find float attribute \'AOT\' for the LUT (make sure it is a float!)" );
+                Py_XDECREF(pAOT);
+                Py_DECREF(pAOTValuesObj);
+                Py_DECREF(pElevLUTValuesObj);
+                return NULL;
+            }
+            lutAOTVal.aot = RSGISPY_FLOAT_EXTRACT(pAOT);
+            Py_DECREF(pAOT);
+            
+            PyObject *pBandValuesObj = PyObject_GetAttrString(pAOTValuesObj, "Coeffs");
+            
+            if( !PySequence_Check(pBandValuesObj))
+            {
+                PyErr_SetString(GETSTATE(self)->error, "Each element in the AOT LUT have a sequence \'Coeffs\'.");
+                Py_DECREF(pAOTValuesObj);
+                Py_DECREF(pElevLUTValuesObj);
+                return NULL;
+            }
+            Py_ssize_t nBandValDefns = PySequence_Size(pBandValuesObj);
+            
+            lutAOTVal.numValues = nBandValDefns;
+            lutAOTVal.imageBands = new unsigned int[lutAOTVal.numValues];
+            lutAOTVal.aX = new float[lutAOTVal.numValues];
+            lutAOTVal.bX = new float[lutAOTVal.numValues];
+            lutAOTVal.cX = new float[lutAOTVal.numValues];
+            
+            for( Py_ssize_t m = 0; m < nBandValDefns; ++m )
+            {
+                PyObject *o = PySequence_GetItem(pBandValuesObj, m);
+                PyObject *pBand = PyObject_GetAttrString(o, "band");
+                if( ( pBand == NULL ) || ( pBand == Py_None ) || !RSGISPY_CHECK_INT(pBand) )
+                {
+                    PyErr_SetString(GETSTATE(self)->error, "Could not find int attribute \'band\'" );
+                    Py_XDECREF(pBand);
+                    Py_DECREF(o);
+                    Py_DECREF(pAOTValuesObj);
+                    Py_DECREF(pElevLUTValuesObj);
+                    return NULL;
+                }
+                
+                PyObject *pAX = PyObject_GetAttrString(o, "aX");
+                if( ( pAX == NULL ) || ( pAX == Py_None ) || !RSGISPY_CHECK_FLOAT(pAX) )
+                {
+                    PyErr_SetString(GETSTATE(self)->error, "Could not find float attribute \'aX\'" );
+                    Py_XDECREF(pBand);
+                    Py_XDECREF(pAX);
+                    Py_DECREF(o);
+                    Py_DECREF(pAOTValuesObj);
+                    Py_DECREF(pElevLUTValuesObj);
+                    return NULL;
+                }
+                
+                PyObject *pBX = PyObject_GetAttrString(o, "bX");
+                if( ( pBX == NULL ) || ( pBX == Py_None ) || !RSGISPY_CHECK_FLOAT(pBX) )
+                {
+                    PyErr_SetString(GETSTATE(self)->error, "Could not find float attribute \'bX\'" );
+                    Py_XDECREF(pBand);
+                    Py_XDECREF(pAX);
+                    Py_XDECREF(pBX);
+                    Py_DECREF(o);
+                    Py_DECREF(pAOTValuesObj);
+                    Py_DECREF(pElevLUTValuesObj);
+                    return NULL;
+                }
+                
+                PyObject *pCX = PyObject_GetAttrString(o, "cX");
+                if( ( pCX == NULL ) || ( pCX == Py_None ) || !RSGISPY_CHECK_FLOAT(pCX) )
+                {
+                    PyErr_SetString(GETSTATE(self)->error, "Could not find float attribute \'cX\'" );
+                    Py_XDECREF(pBand);
+                    Py_XDECREF(pAX);
+                    Py_XDECREF(pBX);
+                    Py_XDECREF(pCX);
+                    Py_DECREF(o);
+                    Py_DECREF(pAOTValuesObj);
+                    Py_DECREF(pElevLUTValuesObj);
+                    return NULL;
+                }
+                
+                lutAOTVal.imageBands[m] = RSGISPY_INT_EXTRACT(pBand);
+                lutAOTVal.aX[m] = RSGISPY_FLOAT_EXTRACT(pAX);
+                lutAOTVal.bX[m] = RSGISPY_FLOAT_EXTRACT(pBX);
+                lutAOTVal.cX[m] = RSGISPY_FLOAT_EXTRACT(pCX);
+                
+                Py_DECREF(pBand);
+                Py_DECREF(pAX);
+                Py_DECREF(pBX);
+                Py_DECREF(pCX);
+                Py_DECREF(o);
+            }
+            Py_DECREF(pBandValuesObj);
+            
+            lutElevVal.aotLUT.push_back(lutAOTVal);
+            Py_DECREF(pAOTValuesObj);
+        }
+        
+        elevAOTLUT->push_back(lutElevVal);
+        Py_DECREF(pElevLUTValuesObj);
+    }
+    
+    return elevAOTLUT;
+}
+
+static void delete6SElevAOTLUT(std::vector<rsgis::cmds::Cmds6SBaseElevAOTLUT> *elevAOTLUT)
+{
+    for(std::vector<rsgis::cmds::Cmds6SBaseElevAOTLUT>::iterator iterLUT = elevAOTLUT->begin(); iterLUT != elevAOTLUT->end(); ++iterLUT)
+    {
+        for(std::vector<rsgis::cmds::Cmds6SAOTLUT>::iterator iterAOTLUT = (*iterLUT).aotLUT.begin(); iterAOTLUT != (*iterLUT).aotLUT.end(); ++iterAOTLUT)
+        {
+            delete[] (*iterAOTLUT).imageBands;
+            delete[] (*iterAOTLUT).aX;
+            delete[] (*iterAOTLUT).bX;
+            delete[] (*iterAOTLUT).cX;
+        }
+    }
+    delete elevAOTLUT;
+}
+
+static PyObject *ImageCalibration_landsat2Radiance(PyObject *self, PyObject *args)
+{
+    const char *pszOutputFile, *pszGDALFormat;
+    PyObject *pBandDefnObj;
+    if( !PyArg_ParseTuple(args, "ssO:landsat2Radiance", &pszOutputFile, &pszGDALFormat, &pBandDefnObj))
+    {
+        return NULL;
+    }
+
+    if( !PySequence_Check(pBandDefnObj))
+    {
+        PyErr_SetString(GETSTATE(self)->error, "Last argument must be a sequence");
+        return NULL;
+    }
+
+    std::vector<rsgis::cmds::CmdsLandsatRadianceGainsOffsets> landsatRadGainOffs;
+    if(!parseLandsatRadGainOffs(self, pBandDefnObj, &landsatRadGainOffs))
+    {
+        return NULL;
+    }
+    
     try
     {
         rsgis::cmds::executeConvertLandsat2Radiance(pszOutputFile, pszGDALFormat, landsatRadGainOffs);
@@ -689,169 +862,100 @@ static PyObject *ImageCalibration_Apply6SCoefficentsElevAOTLUTParam(PyObject *se
         return NULL;
     }
     
-    Py_ssize_t nLUTDefns = PySequence_Size(pLUTObj);
+    std::vector<rsgis::cmds::Cmds6SBaseElevAOTLUT> *elevAOTLUT = parse6SElevAOTLUT(self, pLUTObj);
+    if(elevAOTLUT == NULL)
+    {
+        return NULL;
+    }
     
-    std::vector<rsgis::cmds::Cmds6SBaseElevAOTLUT> *elevAOTLUT = new std::vector<rsgis::cmds::Cmds6SBaseElevAOTLUT>();
-    elevAOTLUT->reserve(nLUTDefns);
+    try
+    {
+        rsgis::RSGISLibDataType type = (rsgis::RSGISLibDataType)nDataType;
+        rsgis::cmds::executeRad2SREFElevAOTLUT6sParams(std::string(pszInputRadFile), std::string(pszInputDEMFile), std::string(pszInputAOTFile), std::string(pszOutputFile), std::string(pszGDALFormat), type, scaleFactor, elevAOTLUT, noDataVal, useNoDataVal);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return NULL;
+    }
     
-    for( Py_ssize_t n = 0; n < nLUTDefns; ++n )
+    delete6SElevAOTLUT(elevAOTLUT);
+    
+    Py_RETURN_NONE;
+}
+
+static PyObject *ImageCalibration_landsat2SREFElevAOTLUTParam(PyObject *self, PyObject *args)
+{
+    const char *pszInputDEMFile, *pszInputAOTFile, *pszOutputFile, *pszGDALFormat;
+    const char *pszOutputTOAFile = "";
+    int nDataType, year, month, day, useNoDataVal;
+    float scaleFactor, solarZenith, noDataVal;
+    float toaScaleFactor = 1000;
+    unsigned int numThreads = 1;
+    PyObject *pBandDefnObj, *pSolarIrrObj, *pLUTObj;
+    if( !PyArg_ParseTuple(args, "OssssifiiifOfiO|sfI:landsat2SREFElevAOTLUTParam", &pBandDefnObj, &pszInputDEMFile, &pszInputAOTFile, &pszOutputFile, &pszGDALFormat, &nDataType, &scaleFactor, &year, &month, &day, &solarZenith, &pSolarIrrObj, &noDataVal, &useNoDataVal, &pLUTObj, &pszOutputTOAFile, &toaScaleFactor, &numThreads))
     {
-        PyObject *pElevLUTValuesObj = PySequence_GetItem(pLUTObj, n);
-        rsgis::cmds::Cmds6SBaseElevAOTLUT lutElevVal = rsgis::cmds::Cmds6SBaseElevAOTLUT();
-        
-        PyObject *pElev = PyObject_GetAttrString(pElevLUTValuesObj, "Elev");
-        if( ( pElev == NULL ) || ( pElev == Py_None ) || !RSGISPY_CHECK_FLOAT(pElev) )
-        {
-            PyErr_SetString(GETSTATE(self)->error, "Could not find float attribute \'Elev\' for the LUT (make sure it is a float!)" );
-            Py_XDECREF(pElev);
-            Py_DECREF(pElevLUTValuesObj);
-            return NULL;
-        }
-        lutElevVal.elev = RSGISPY_FLOAT_EXTRACT(pElev);
-        Py_DECREF(pElev);
-        
-        
-        PyObject *pAOTLUTValuesObj = PyObject_GetAttrString(pElevLUTValuesObj, "Coeffs");
+        return NULL;
+    }
+    
+    if( !PySequence_Check(pBandDefnObj) || !PySequence_Check(pSolarIrrObj) || !PySequence_Check(pLUTObj) )
+    {
+        PyErr_SetString(GETSTATE(self)->error, "The band definitions, solar irradiance values and LUT must be sequences");
+        return NULL;
+    }
+    
+    std::vector<rsgis::cmds::CmdsLandsatRadianceGainsOffsets> landsatRadGainOffs;
+    if(!parseLandsatRadGainOffs(self, pBandDefnObj, &landsatRadGainOffs))
+    {
+        return NULL;
+    }
+    
+    Py_ssize_t nSolarIrrDefns = PySequence_Size(pSolarIrrObj);
+    unsigned int numSolarIrrVals = nSolarIrrDefns;
+    float *solarIrradiance = new float[numSolarIrrVals];
+    
+    for( Py_ssize_t n = 0; n < nSolarIrrDefns; n++ )
+    {
+        PyObject *o = PySequence_GetItem(pSolarIrrObj, n);
         
-        if( !PySequence_Check(pAOTLUTValuesObj))
+        PyObject *pIrradiance = PyObject_GetAttrString(o, "irradiance");
+        if( ( pIrradiance == NULL ) || ( pIrradiance == Py_None ) || !RSGISPY_CHECK_FLOAT(pIrradiance) )
         {
-            PyErr_SetString(GETSTATE(self)->error, "Each element in the Elevation LUT have a sequence of AOT \'Coeffs\'.");
+            PyErr_SetString(GETSTATE(self)->error, "Could not find float attribute \'irradiance\'" );
+            Py_XDECREF(pIrradiance);
+            Py_DECREF(o);
+            delete[] solarIrradiance;
             return NULL;
         }
-        Py_ssize_t nAOTLUTDefns = PySequence_Size(pAOTLUTValuesObj);
-        lutElevVal.aotLUT = std::vector<rsgis::cmds::Cmds6SAOTLUT>();
-        lutElevVal.aotLUT.reserve(nAOTLUTDefns);
         
-        for( Py_ssize_t k = 0; k < nAOTLUTDefns; ++k )
-        {
-            PyObject *pAOTValuesObj = PySequence_GetItem(pAOTLUTValuesObj, k);
-            rsgis::cmds::Cmds6SAOTLUT lutAOTVal = rsgis::cmds::Cmds6SAOTLUT();
-            
-            PyObject *pAOT = PyObject_GetAttrString(pAOTValuesObj, "AOT");
-            if( ( pAOT == NULL ) || ( pAOT == Py_None ) || !RSGISPY_CHECK_FLOAT(pAOT) )
-            {
-                PyErr_SetString(GETSTATE(self)->error, "Could not find float attribute \'AOT\' for the LUT (make sure it is a float!)" );
-                Py_XDECREF(pAOT);
-                Py_DECREF(pAOTValuesObj);
-                Py_DECREF(pElevLUTValuesObj);
-                return NULL;
-            }
-            lutAOTVal.aot = RSGISPY_FLOAT_EXTRACT(pAOT);
-            Py_DECREF(pAOT);
-            
-            PyObject *pBandValuesObj = PyObject_GetAttrString(pAOTValuesObj, "Coeffs");
-            
-            if( !PySequence_Check(pBandValuesObj))
-            {
-                PyErr_SetString(GETSTATE(self)->error, "Each element in the AOT LUT have a sequence \'Coeffs\'.");
-                Py_DECREF(pAOTValuesObj);
-                Py_DECREF(pElevLUTValuesObj);
-                return NULL;
-            }
-            Py_ssize_t nBandValDefns = PySequence_Size(pBandValuesObj);
-            
-            lutAOTVal.numValues = nBandValDefns;
-            lutAOTVal.imageBands = new unsigned int[lutAOTVal.numValues];
-            lutAOTVal.aX = new float[lutAOTVal.numValues];
-            lutAOTVal.bX = new float[lutAOTVal.numValues];
-            lutAOTVal.cX = new float[lutAOTVal.numValues];
-            
-            for( Py_ssize_t m = 0; m < nBandValDefns; ++m )
-            {
-                PyObject *o = PySequence_GetItem(pBandValuesObj, m);
-                PyObject *pBand = PyObject_GetAttrString(o, "band");
-                if( ( pBand == NULL ) || ( pBand == Py_None ) || !RSGISPY_CHECK_INT(pBand) )
-                {
-                    PyErr_SetString(GETSTATE(self)->error, "Could not find int attribute \'band\'" );
-                    Py_XDECREF(pBand);
-                    Py_DECREF(o);
-                    Py_DECREF(pAOTValuesObj);
-                    Py_DECREF(pElevLUTValuesObj);
-                    return NULL;
-                }
-                
-                PyObject *pAX = PyObject_GetAttrString(o, "aX");
-                if( ( pAX == NULL ) || ( pAX == Py_None ) || !RSGISPY_CHECK_FLOAT(pAX) )
-                {
-                    PyErr_SetString(GETSTATE(self)->error, "Could not find float attribute \'aX\'" );
-                    Py_XDECREF(pBand);
-                    Py_XDECREF(pAX);
-                    Py_DECREF(o);
-                    Py_DECREF(pAOTValuesObj);
-                    Py_DECREF(pElevLUTValuesObj);
-                    return NULL;
-                }
-                
-                PyObject *pBX = PyObject_GetAttrString(o, "bX");
-                if( ( pBX == NULL ) || ( pBX == Py_None ) || !RSGISPY_CHECK_FLOAT(pBX) )
-                {
-                    PyErr_SetString(GETSTATE(self)->error, "Could not find float attribute \'bX\'" );
-                    Py_XDECREF(pBand);
-                    Py_XDECREF(pAX);
-                    Py_XDECREF(pBX);
-                    Py_DECREF(o);
-                    Py_DECREF(pAOTValuesObj);
-                    Py_DECREF(pElevLUTValuesObj);
-                    return NULL;
-                }
-                
-                PyObject *pCX = PyObject_GetAttrString(o, "cX");
-                if( ( pCX == NULL ) || ( pCX == Py_None ) || !RSGISPY_CHECK_FLOAT(pCX) )
-                {
-                    PyErr_SetString(GETSTATE(self)->error, "Could not find float attribute \'cX\'" );
-                    Py_XDECREF(pBand);
-                    Py_XDECREF(pAX);
-                    Py_XDECREF(pBX);
-                    Py_XDECREF(pCX);
-                    Py_DECREF(o);
-                    Py_DECREF(pAOTValuesObj);
-                    Py_DECREF(pElevLUTValuesObj);
-                    return NULL;
-                }
-                
-                lutAOTVal.imageBands[m] = RSGISPY_INT_EXTRACT(pBand);
-                lutAOTVal.aX[m] = RSGISPY_FLOAT_EXTRACT(pAX);
-                lutAOTVal.bX[m] = RSGISPY_FLOAT_EXTRACT(pBX);
-                lutAOTVal.cX[m] = RSGISPY_FLOAT_EXTRACT(pCX);
-                
-                Py_DECREF(pBand);
-                Py_DECREF(pAX);
-                Py_DECREF(pBX);
-                Py_DECREF(pCX);
-                Py_DECREF(o);
-            }
-            Py_DECREF(pBandValuesObj);
-            
-            lutElevVal.aotLUT.push_back(lutAOTVal);
-            Py_DECREF(pAOTValuesObj);
-        }
+        solarIrradiance[n] = RSGISPY_FLOAT_EXTRACT(pIrradiance);
         
-        elevAOTLUT->push_back(lutElevVal);
-        Py_DECREF(pElevLUTValuesObj);
+        Py_DECREF(pIrradiance);
+        Py_DECREF(o);
+    }
+    
+    std::vector<rsgis::cmds::Cmds6SBaseElevAOTLUT> *elevAOTLUT = parse6SElevAOTLUT(self, pLUTObj);
+    if(elevAOTLUT == NULL)
+    {
+        delete[] solarIrradiance;
+        return NULL;
     }
     
     try
     {
         rsgis::RSGISLibDataType type = (rsgis::RSGISLibDataType)nDataType;
-        rsgis::cmds::executeRad2SREFElevAOTLUT6sParams(std::string(pszInputRadFile), std::string(pszInputDEMFile), std::string(pszInputAOTFile), std::string(pszOutputFile), std::string(pszGDALFormat), type, scaleFactor, elevAOTLUT, noDataVal, useNoDataVal);
+        rsgis::cmds::executeLandsatDN2SREFElevAOTLUT6sParams(landsatRadGainOffs, std::string(pszInputDEMFile), std::string(pszInputAOTFile), std::string(pszOutputFile), std::string(pszOutputTOAFile), std::string(pszGDALFormat), type, scaleFactor, toaScaleFactor, year, month, day, (solarZenith*(M_PI/180)), solarIrradiance, numSolarIrrVals, elevAOTLUT, noDataVal, useNoDataVal, numThreads);
     }
     catch(rsgis::cmds::RSGISCmdException &e)
     {
         PyErr_SetString(GETSTATE(self)->error, e.what());
+        delete[] solarIrradiance;
+        delete6SElevAOTLUT(elevAOTLUT);
         return NULL;
     }
     
-    for(std::vector<rsgis::cmds::Cmds6SBaseElevAOTLUT>::iterator iterLUT = elevAOTLUT->begin(); iterLUT != elevAOTLUT->end(); ++iterLUT)
-    {
-        for(std::vector<rsgis::cmds::Cmds6SAOTLUT>::iterator iterAOTLUT = (*iterLUT).aotLUT.begin(); iterAOTLUT != (*iterLUT).aotLUT.end(); ++iterAOTLUT)
-        {
-            delete[] (*iterAOTLUT).imageBands;
-            delete[] (*iterAOTLUT).aX;
-            delete[] (*iterAOTLUT).bX;
-            delete[] (*iterAOTLUT).cX;
-        }
-    }
-    delete elevAOTLUT;
+    delete[] solarIrradiance;
+    delete6SElevAOTLUT(elevAOTLUT);
     
     Py_RETURN_NONE;
 }
@@ -1134,16 +1238,17 @@ static PyObject *ImageCalibration_applyLandsatTMCloudFMask(PyObject *self, PyObj
     float scaleFactor;
     float whitenessThreshold = 0.7;
     int rmTmpImages = true;
+    unsigned int numThreads = 1;
     
     
-    if( !PyArg_ParseTuple(args, "ssssssfffffss|fi:applyLandsatTMCloudFMask", &pszInputTOAFile, &pszInputThermalFile, &pszInputSatFile, &pszValidAreaImg, &pszOutputFile, &pszGDALFormat, &sunAz, &sunZen, &senAz, &senZen, &scaleFactor, &pszTmpImgsBase, &pszTmpImgsFileExt, &whitenessThreshold, &rmTmpImages))
+    if( !PyArg_ParseTuple(args, "ssssssfffffss|fiI:applyLandsatTMCloudFMask", &pszInputTOAFile, &pszInputThermalFile, &pszInputSatFile, &pszValidAreaImg, &pszOutputFile, &pszGDALFormat, &sunAz, &sunZen, &senAz, &senZen, &scaleFactor, &pszTmpImgsBase, &pszTmpImgsFileExt, &whitenessThreshold, &rmTmpImages, &numThreads))
     {
         return NULL;
     }
     
     try
     {
-        rsgis::cmds::executeLandsatTMCloudFMask(std::string(pszInputTOAFile), std::string(pszInputThermalFile), std::string(pszInputSatFile), std::string(pszValidAreaImg), std::string(pszOutputFile), std::string(pszGDALFormat), sunAz, sunZen, senAz, senZen, whitenessThreshold, scaleFactor, std::string(pszTmpImgsBase), std::string(pszTmpImgsFileExt), (bool)rmTmpImages);
+        rsgis::cmds::executeLandsatTMCloudFMask(std::string(pszInputTOAFile), std::string(pszInputThermalFile), std::string(pszInputSatFile), std::string(pszValidAreaImg), std::string(pszOutputFile), std::string(pszGDALFormat), sunAz, sunZen, senAz, senZen, whitenessThreshold, scaleFactor, std::string(pszTmpImgsBase), std::string(pszTmpImgsFileExt), (bool)rmTmpImages, numThreads);
     }
     catch(rsgis::cmds::RSGISCmdException &e)
     {
@@ -1750,6 +1855,40 @@ static PyMethodDef ImageCalibrationMethods[] = {
 "                * \'cX\' - A float for the cX coefficient.\n"
 "\n"},
 
+{"landsat2SREFElevAOTLUTParam", ImageCalibration_landsat2SREFElevAOTLUTParam, METH_VARARGS,
+"imagecalibration.landsat2SREFElevAOTLUTParam(bandDefnSeq, inputDEMFile, inputAOTImage, outputFile, gdalFormat, datatype, scaleFactor, year, month, day, solarZenith, solarIrradianceVals, noDataValue, useNoDataValue, lutElevAOT, outputTOAFile='', toaScaleFactor=1000, ncores=1)\n"
+"Converts Landsat DN values to surface reflectance in a single pass over the images, giving the same result as running landsat2Radiance and\n"
+"apply6SCoeffElevAOTLUTParam (and optionally radiance2TOARefl) but without writing the intermediate radiance image.\n"
+"\n"
+"Where:\n"
+"\n"
+":param bandDefnSeq: is a sequence of rsgislib.imagecalibration.CmdsLandsatRadianceGainsOffsets objects that define the inputs, as for landsat2Radiance\n"
+"        * bandName - Name of image band in output file.\n"
+"        * fileName - input image file.\n"
+"        * bandIndex - Index (starting from 1) of the band in the image file.\n"
+"        * lMin - lMin value from Landsat header.\n"
+"        * lMax - lMax value from Landsat header.\n"
+"        * qCalMin - qCalMin value from Landsat header.\n"
+"        * qCalMax - qCalMax value from Landsat header.\n"
+":param inputDEMFile: is a string containing the name of the input DEM image file (needs to be the same size as the DN images.)\n"
+":param inputAOTImage: is a string containing the name of the input AOT image file (needs to be the same size as the DN images.)\n"
+":param outputFile: is a string containing the name of the output surface reflectance image file\n"
+":param gdalformat: is a string containing the GDAL format for the output file(s) - eg 'KEA'\n"
+":param datatype: is an containing one of the values from rsgislib.TYPE_*\n"
+":param scaleFactor: is a float which can be used to scale the output surface reflectance pixel values (e.g., multiple by 1000), set as 1 for no scaling.\n"
+":param year: is an int with the year of the sensor acquisition.\n"
+":param month: is an int with the month of the sensor acquisition.\n"
+":param day: is an int with the day of the sensor acquisition.\n"
+":param solarZenith: is a a float with the solar zenith in degrees at the time of the acquisition (note 90-solarElevation = solarZenith).\n"
+":param solarIrradianceVals: is a sequence of floats each with the name \'irradiance\' which is in order of the bands in bandDefnSeq.\n"
+":param noDataValue: is a float which if all the radiance bands contain that value will be ignored.\n"
+":param useNoDataValue: is a boolean as to whether the no data value specified is to be used.\n"
+":param lutElevAOT: is a sequence of objects defining the 6S coefficients for elevation and AOT, as for apply6SCoeffElevAOTLUTParam, where the band numbers (starting at 1) are in the order of bandDefnSeq.\n"
+":param outputTOAFile: is an optional string containing the name of an output TOA reflectance image file, which is not written if empty (default).\n"
+":param toaScaleFactor: is an optional float used to scale the output TOA reflectance pixel values (default 1000).\n"
+":param ncores: is an optional unsigned int specifying the number of threads to use (0 uses all available; default 1).\n"
+"\n"},
+
 {"applySubtractSingleOffsets", ImageCalibration_ApplySubtractSingleOffsets, METH_VARARGS,
 "imagecalibration.applySubtractSingleOffsets(inputFile, outputFile, gdalformat, datatype, nonNegative, useNoDataVal, noDataVal, darkObjReflVal, offsetsList)\n"
 "This function performs a dark obejct subtraction (DOS) using a set of defined offsets for retriving surface reflectance.\n"
@@ -1818,7 +1957,7 @@ static PyMethodDef ImageCalibrationMethods[] = {
 "\n"},
     
 {"applyLandsatTMCloudFMask", ImageCalibration_applyLandsatTMCloudFMask, METH_VARARGS,
-"imagecalibration.applyLandsatTMCloudFMask(inputTOAImage, inputThermalImage, inputSaturateImage, inValidAreaImage, outputImage, gdalFormat, sunAz, sunZen, senAz, senZen, scaleFactorIn, tmpImgsBase, tmpImgsFileExt, rmTmpImgs)\n"
+"imagecalibration.applyLandsatTMCloudFMask(inputTOAImage, inputThermalImage, inputSaturateImage, inValidAreaImage, outputImage, gdalFormat, sunAz, sunZen, senAz, senZen, scaleFactorIn, tmpImgsBase, tmpImgsFileExt, whitenessThreshold, rmTmpImgs, ncores=1)\n"
 "Applies the FMASK (Zhu and Woodcock 2012, RSE 118, pp83-94) cloud masking algorithm to the input image returning an output image with the cloud (pixel value 1) and shadow (pixel value 2).\n"
 "\n"
 "Where:\n"
@@ -1838,6 +1977,7 @@ static PyMethodDef ImageCalibrationMethods[] = {
 ":param tmpImgsFileExt: is a string for the file extention of the output images (e.g., .kea)\n"
 ":param whitenessThreshold: is a float specifying the whiteness threshold (default is 0.7; Equation 2), this parameter is optional.\n"
 ":param rmTmpImgs: is a bool specifying whether the tmp images should be deleted at the end of the processing (Optional; Default = True)\n"
+":param ncores: is an optional unsigned int specifying the number of threads to use (0 uses all available; default 1).\n"
 "\n"
 "Example::\n"
 "\n"
@@ -50,8 +50,10 @@ static PyObject *ImageFilter_Filter(PyObject *self, PyObject *args)
     const char *pszImageFormat = "KEA";
     const char *pszImageExt = "kea";
     int dataType = 9; // Default to 32 bit float
+    int stackOutput = false;
+    unsigned int numThreads = 1;
     PyObject *pImageFilterCmds;
-    if( !PyArg_ParseTuple(args, "ssO|ssi:applyfilters", &pszInputImage, &pszOutputImageBase, &pImageFilterCmds, &pszImageFormat, &pszImageExt, &dataType))
+    if( !PyArg_ParseTuple(args, "ssO|ssiiI:applyfilters", &pszInputImage, &pszOutputImageBase, &pImageFilterCmds, &pszImageFormat, &pszImageExt, &dataType, &stackOutput, &numThreads))
         return NULL;
 
     // extract the attributes from the sequence of objects into our structs
@@ -186,7 +188,7 @@ static PyObject *ImageFilter_Filter(PyObject *self, PyObject *args)
     try
     {
         rsgis::RSGISLibDataType type = (rsgis::RSGISLibDataType) dataType;
-        rsgis::cmds::executeFilter(pszInputImage, filterParameters, pszOutputImageBase, pszImageFormat, pszImageExt, type);
+        rsgis::cmds::executeFilter(pszInputImage, filterParameters, pszOutputImageBase, pszImageFormat, pszImageExt, type, (bool)stackOutput, numThreads);
 
         // Delete filter parameters
         for(std::vector<rsgis::cmds::RSGISFilterParameters*>::iterator iterFilter = filterParameters->begin(); iterFilter != filterParameters->end(); ++iterFilter)
@@ -247,8 +249,8 @@ static PyObject *ImageFilter_LeungMalikFilterBank(PyObject *self, PyObject *args
 // Our list of functions in this module
 static PyMethodDef ImageFilterMethods[] = {
     {"applyfilters", ImageFilter_Filter, METH_VARARGS, 
-"imagefilter.applyfilters(inputimage, outputImageBase, filterparameters, gdalformat, outExt, datatype)\n"
-"Filters images\n"
+"imagefilter.applyfilters(inputimage, outputImageBase, filterparameters, gdalformat, outExt, datatype, stackoutput, nthreads)\n"
+"Filters images. The input image is read once and all the filters are applied in a single pass.\n"
 "\n"
 "Where:\n"
 "\n"
@@ -257,6 +259,8 @@ static PyMethodDef ImageFilterMethods[] = {
 ":param filterparameters: is list of rsgislib.imagefilter.FilterParameters objects providing the type of filter and required parameters (see example)\n"
 ":param gdalformat: is a string containing the GDAL format for the output file - eg 'KEA'\n"
 ":param datatype: is an int containing one of the values from rsgislib.TYPE_*\n"
+":param stackoutput: is a boolean specifying whether a single multi-band image (outputImageBase.outExt) is produced rather than an image per filter (Default = False)\n"
+":param nthreads: is an unsigned int specifying the number of threads used to apply the filters (Default = 1; 0 uses all available cores)\n"
 "\n"
 "Example::\n"
 "\n"
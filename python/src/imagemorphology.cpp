@@ -575,7 +575,7 @@ static PyMethodDef ImageMorphologyMethods[] = {
 "\n"
 ":param inputImage: is a string specifying the name and path of the input file.\n"
 ":param outputImage: is a string specifying the name and path of the output file.\n"
-":param tempImage: is a string specifying the name and path of a tempory file used for intermediate processing step(s). If empty string ('') then an in memory image will be used.\n"
+":param tempImage: is no longer used (the operations are applied within a single pass through the image) but retained for compatibility; pass an empty string ('').\n"
 ":param morphOperator: is a string with the name and path to a .gmtxt file with a square binary matrix specifying the morphology operator\n"
 ":param useOpFile: is a boolean specifying whether the morphOperator file is present or whether a square operator (specified via opSize) should be used. (True = morphOperator, False = opSize)\n"
 ":param opSize: is a integer specifying the square operator size (only used if useOpFile is False)\n"
@@ -592,7 +592,7 @@ static PyMethodDef ImageMorphologyMethods[] = {
 "\n"
 ":param inputImage: is a string specifying the name and path of the input file.\n"
 ":param outputImage: is a string specifying the name and path of the output file.\n"
-":param tempImage: is a string specifying the name and path of a tempory file used for intermediate processing step(s). If empty string ('') then an in memory image will be used.\n"
+":param tempImage: is no longer used (the operations are applied within a single pass through the image) but retained for compatibility; pass an empty string ('').\n"
 ":param morphOperator: is a string with the name and path to a .gmtxt file with a square binary matrix specifying the morphology operator\n"
 ":param useOpFile: is a boolean specifying whether the morphOperator file is present or whether a square operator (specified via opSize) should be used. (True = morphOperator, False = opSize)\n"
 ":param opSize: is a integer specifying the square operator size (only used if useOpFile is False)\n"
@@ -609,7 +609,7 @@ static PyMethodDef ImageMorphologyMethods[] = {
 "\n"
 ":param inputImage: is a string specifying the name and path of the input file.\n"
 ":param outputImage: is a string specifying the name and path of the output file.\n"
-":param tempImage: is a string specifying the name and path of a tempory file used for intermediate processing step(s).\n"
+":param tempImage: is no longer used (the operations are applied within a single pass through the image) but retained for compatibility; pass an empty string ('').\n"
 ":param morphOperator: is a string with the name and path to a .gmtxt file with a square binary matrix specifying the morphology operator\n"
 ":param useOpFile: is a boolean specifying whether the morphOperator file is present or whether a square operator (specified via opSize) should be used. (True = morphOperator, False = opSize)\n"
 ":param opSize: is a integer specifying the square operator size (only used if useOpFile is False)\n"
@@ -625,7 +625,7 @@ static PyMethodDef ImageMorphologyMethods[] = {
 "\n"
 ":param inputImage: is a string specifying the name and path of the input file.\n"
 ":param outputImage: is a string specifying the name and path of the output file.\n"
-":param tempImage: is a string specifying the name and path of a tempory file used for intermediate processing step(s).\n"
+":param tempImage: is no longer used (the operations are applied within a single pass through the image) but retained for compatibility; pass an empty string ('').\n"
 ":param morphOperator: is a string with the name and path to a .gmtxt file with a square binary matrix specifying the morphology operator\n"
 ":param useOpFile: is a boolean specifying whether the morphOperator file is present or whether a square operator (specified via opSize) should be used. (True = morphOperator, False = opSize)\n"
 ":param opSize: is a integer specifying the square operator size (only used if useOpFile is False)\n"
@@ -42,10 +42,12 @@ static PyObject *ImageRegistration_BasicRegistration(PyObject *self, PyObject *a
     const char *pszInputReferenceImage, *pszInputFloatingmage, *pszOutputGCPFile;
     int pixelGap, windowSize, searchArea, subPixelResolution, metricType, outputType;
     float threshold, stdDevRefThreshold, stdDevFloatThreshold;
+    int fftCoarseShift = false;
+    unsigned int numThreads = 1;
     
-    if( !PyArg_ParseTuple(args, "ssifiiffiiis:basicregistration", &pszInputReferenceImage, &pszInputFloatingmage, &pixelGap, 
+    if( !PyArg_ParseTuple(args, "ssifiiffiiis|iI:basicregistration", &pszInputReferenceImage, &pszInputFloatingmage, &pixelGap, 
                                 &threshold, &windowSize, &searchArea, &stdDevRefThreshold, &stdDevFloatThreshold, &subPixelResolution, 
-                                &metricType, &outputType, &pszOutputGCPFile))
+                                &metricType, &outputType, &pszOutputGCPFile, &fftCoarseShift, &numThreads))
         return NULL;
 
     try
@@ -53,7 +55,7 @@ static PyObject *ImageRegistration_BasicRegistration(PyObject *self, PyObject *a
         rsgis::cmds:: excecuteBasicRegistration(pszInputReferenceImage, pszInputFloatingmage, pixelGap,
                                     threshold, windowSize, searchArea, stdDevRefThreshold,
                                     stdDevFloatThreshold, subPixelResolution, metricType,
-                                    outputType, pszOutputGCPFile);
+                                    outputType, pszOutputGCPFile, fftCoarseShift, numThreads);
     }
     catch(rsgis::cmds::RSGISCmdException &e)
     {
@@ -71,11 +73,13 @@ static PyObject *ImageRegistration_SingleLayerRegistration(PyObject *self, PyObj
         outputType, maxNumIterations, distanceThreshold;
     float threshold, stdDevRefThreshold, stdDevFloatThreshold, moveChangeThreshold,
         pSmoothness;
+    int fftCoarseShift = false;
+    unsigned int numThreads = 1;
     
-    if( !PyArg_ParseTuple(args, "ssifiiffiiiffiis:singlelayerregistration", &pszInputReferenceImage, &pszInputFloatingmage, &pixelGap, 
+    if( !PyArg_ParseTuple(args, "ssifiiffiiiffiis|iI:singlelayerregistration", &pszInputReferenceImage, &pszInputFloatingmage, &pixelGap, 
                                 &threshold, &windowSize, &searchArea, &stdDevRefThreshold, &stdDevFloatThreshold, &subPixelResolution,
                                 &distanceThreshold, &maxNumIterations, &moveChangeThreshold, &pSmoothness,
-                                &metricType, &outputType, &pszOutputGCPFile))
+                                &metricType, &outputType, &pszOutputGCPFile, &fftCoarseShift, &numThreads))
         return NULL;
 
     try
@@ -84,7 +88,7 @@ static PyObject *ImageRegistration_SingleLayerRegistration(PyObject *self, PyObj
                                     threshold, windowSize, searchArea, stdDevRefThreshold,
                                     stdDevFloatThreshold, subPixelResolution, distanceThreshold,
                                     maxNumIterations, moveChangeThreshold, pSmoothness, metricType,
-                                    outputType, pszOutputGCPFile);
+                                    outputType, pszOutputGCPFile, fftCoarseShift, numThreads);
     }
     catch(rsgis::cmds::RSGISCmdException &e)
     {
@@ -100,15 +104,17 @@ static PyObject *ImageRegistration_TriangularWarp(PyObject *self, PyObject *args
 	const char *pszInputImage, *pszInputGCPFile, *pszOutputFile, *pszProjFile, *pszGDALFormat;
 	float nResolution;
 	int genTransformImage = false;
+    unsigned int numThreads = 1;
+    double maxTransformError = 0;
     
-    if( !PyArg_ParseTuple(args, "ssssfs|i:triangularwarp", &pszInputImage, &pszInputGCPFile, &pszOutputFile, &pszProjFile, 
-                        &nResolution, &pszGDALFormat, &genTransformImage))
+    if( !PyArg_ParseTuple(args, "ssssfs|iId:triangularwarp", &pszInputImage, &pszInputGCPFile, &pszOutputFile, &pszProjFile, 
+                        &nResolution, &pszGDALFormat, &genTransformImage, &numThreads, &maxTransformError))
         return NULL;
 
     try
     {
         rsgis::cmds::excecuteTriangularWarp(pszInputImage, pszOutputFile, pszProjFile, pszInputGCPFile,
-                        nResolution, pszGDALFormat, genTransformImage);
+                        nResolution, pszGDALFormat, genTransformImage, numThreads, maxTransformError);
     }
     catch(rsgis::cmds::RSGISCmdException &e)
     {
@@ -124,15 +130,17 @@ static PyObject *ImageRegistration_NNWarp(PyObject *self, PyObject *args)
 	const char *pszInputImage, *pszInputGCPFile, *pszOutputFile, *pszProjFile, *pszGDALFormat;
 	float nResolution;
 	int genTransformImage = false;
+    unsigned int numThreads = 1;
+    double maxTransformError = 0;
     
-    if( !PyArg_ParseTuple(args, "ssssfs|i:nnwarp", &pszInputImage, &pszInputGCPFile, &pszOutputFile, &pszProjFile, 
-                        &nResolution, &pszGDALFormat, &genTransformImage))
+    if( !PyArg_ParseTuple(args, "ssssfs|iId:nnwarp", &pszInputImage, &pszInputGCPFile, &pszOutputFile, &pszProjFile, 
+                        &nResolution, &pszGDALFormat, &genTransformImage, &numThreads, &maxTransformError))
         return NULL;
 
     try
     {
         rsgis::cmds::excecuteNNWarp(pszInputImage, pszOutputFile, pszProjFile, pszInputGCPFile,
-                        nResolution, pszGDALFormat, genTransformImage);
+                        nResolution, pszGDALFormat, genTransformImage, numThreads, maxTransformError);
     }
     catch(rsgis::cmds::RSGISCmdException &e)
     {
@@ -149,15 +157,17 @@ static PyObject *ImageRegistration_PolyWarp(PyObject *self, PyObject *args)
 	float nResolution;
 	int nPolyOrder;
 	int genTransformImage = false;
+    unsigned int numThreads = 1;
+    double maxTransformError = 0;
     
-    if( !PyArg_ParseTuple(args, "ssssfis|i:polywarp", &pszInputImage, &pszInputGCPFile, &pszOutputFile, &pszProjFile, 
-                        &nResolution, &nPolyOrder, &pszGDALFormat, &genTransformImage))
+    if( !PyArg_ParseTuple(args, "ssssfis|iId:polywarp", &pszInputImage, &pszInputGCPFile, &pszOutputFile, &pszProjFile, 
+                        &nResolution, &nPolyOrder, &pszGDALFormat, &genTransformImage, &numThreads, &maxTransformError))
         return NULL;
 
     try
     {
         rsgis::cmds::excecutePolyWarp(pszInputImage, pszOutputFile, pszProjFile, pszInputGCPFile,
-                        nResolution, nPolyOrder, pszGDALFormat, genTransformImage);
+                        nResolution, nPolyOrder, pszGDALFormat, genTransformImage, numThreads, maxTransformError);
     }
     catch(rsgis::cmds::RSGISCmdException &e)
     {
@@ -214,7 +224,7 @@ static PyObject *ImageRegistration_ApplyOffset2Image(PyObject *self, PyObject *a
 // Our list of functions in this module
 static PyMethodDef ImageRegistrationMethods[] = {
     {"basicregistration", ImageRegistration_BasicRegistration, METH_VARARGS, 
-"imageregistration.basicregistration(reference, floating, pixelGap, threshold, window, search, stddevRef, stddevFloat, subpixelresolution, metric, outputType, output)\n"
+"imageregistration.basicregistration(reference, floating, pixelGap, threshold, window, search, stddevRef, stddevFloat, subpixelresolution, metric, outputType, output, fftCoarseShift, ncores)\n"
 "Generate tie points between floating and reference image using basic algorithm.\n"
 "\n"
 "Where:\n"
@@ -231,6 +241,8 @@ static PyMethodDef ImageRegistrationMethods[] = {
 ":param metric: is an the similarity metric used to compare images of type rsgislib.imageregistration.METRIC_* \n"
 ":param outputType: is an the format of the output file of type rsgislib.imageregistration.TYPE_* \n"
 ":param output: is a string giving specifying the output file, containing the generated tie points\n"
+":param fftCoarseShift: is an optional bool specifying whether the shift of each tie point is first estimated using phase correlation so the metric is only calculated around that shift rather than over the whole search area (default False).\n"
+":param ncores: is an optional unsigned int specifying the number of threads used to match the tie points (0 uses all available; default 1).\n"
 "\n"
 "Example::\n"
 "\n"
@@ -251,7 +263,7 @@ static PyMethodDef ImageRegistrationMethods[] = {
 },
 
     {"singlelayerregistration", ImageRegistration_SingleLayerRegistration, METH_VARARGS, 
-"imageregistration.singlelayerregistration(reference, floating, pixelGap, threshold, window, search, stddevRef, stddevFloat, subpixelresolution, distanceThreshold, maxiterations, movementThreshold, pSmoothness, metric, outputType, output)\n"
+"imageregistration.singlelayerregistration(reference, floating, pixelGap, threshold, window, search, stddevRef, stddevFloat, subpixelresolution, distanceThreshold, maxiterations, movementThreshold, pSmoothness, metric, outputType, output, fftCoarseShift, ncores)\n"
 "Generate tie points between floating and reference image using a single connected layer of tie points.\n"
 "\n"
 "Where:\n"
@@ -271,6 +283,8 @@ static PyMethodDef ImageRegistrationMethods[] = {
 ":param metric: is an the similarity metric used to compare images of type rsgislib.imageregistration.METRIC_* \n"
 ":param outputType: is an the format of the output file of type rsgislib.imageregistration.TYPE_* \n"
 ":param output: is a string giving specifying the output file, containing the generated tie points\n"
+":param fftCoarseShift: is an optional bool specifying whether the shift of each tie point is first estimated using phase correlation so the metric is only calculated around that shift rather than over the whole search area (default False).\n"
+":param ncores: is an optional unsigned int specifying the number of threads used to match the tie points (0 uses all available; default 1).\n"
 "\n"
 "Example::\n"
 "\n"
@@ -292,7 +306,7 @@ static PyMethodDef ImageRegistrationMethods[] = {
 },
 
     {"triangularwarp", ImageRegistration_TriangularWarp, METH_VARARGS, 
-"imageregistration.triangularwarp(inputimage, inputgcps, outputimage, wktStringFile, resolution, gdalformat, transformImage=False)\n"
+"imageregistration.triangularwarp(inputimage, inputgcps, outputimage, wktStringFile, resolution, gdalformat, transformImage=False, ncores=1, maxTransformError=0)\n"
 "Warp image from tie points using triangular interpolation.\n"
 "\n"
 "Where:\n"
@@ -304,6 +318,8 @@ static PyMethodDef ImageRegistrationMethods[] = {
 ":param resolution: is a float providing the resolution of the output file\n"
 ":param gdalformat: is a string providing the output format (e.g., KEA).\n"
 ":param transformImage: is a bool, if set to true will generate an image providing the transform for each pixel, rather than warping the input image \n"
+":param ncores: is an optional unsigned int specifying the number of threads used to warp the image (0 uses all available; default 1). The triangular warp always uses a single thread.\n"
+":param maxTransformError: is an optional float specifying the maximum error (in input pixels) allowed when the transform is approximated by bilinear interpolation between a grid of exact transforms; 0 calculates the transform for every pixel (default 0; gdalwarp uses 0.125).\n"
 "\n"
 "Example::\n"
 "\n"
@@ -319,7 +335,7 @@ static PyMethodDef ImageRegistrationMethods[] = {
 },  
 
     {"nnwarp", ImageRegistration_NNWarp, METH_VARARGS, 
-"imageregistration.nnwarp(inputimage, inputgcps, outputimage, wktStringFile, resolution, gdalformat, transformImage=False)\n"
+"imageregistration.nnwarp(inputimage, inputgcps, outputimage, wktStringFile, resolution, gdalformat, transformImage=False, ncores=1, maxTransformError=0)\n"
 "Warp image from tie points using a nearest neighbour interpolation.\n"
 "\n"
 "Where:\n"
@@ -331,6 +347,8 @@ static PyMethodDef ImageRegistrationMethods[] = {
 ":param resolution: is a float providing the resolution of the output file\n"
 ":param gdalformat: is a string providing the output format (e.g., KEA).\n"
 ":param transformImage: is a bool, if set to true will generate an image providing the transform for each pixel, rather than warping the input image \n"
+":param ncores: is an optional unsigned int specifying the number of threads used to warp the image (0 uses all available; default 1).\n"
+":param maxTransformError: is an optional float specifying the maximum error (in input pixels) allowed when the transform is approximated by bilinear interpolation between a grid of exact transforms; 0 calculates the transform for every pixel (default 0; gdalwarp uses 0.125).\n"
 "\n"
 "Example::\n"
 "\n"
@@ -346,7 +364,7 @@ static PyMethodDef ImageRegistrationMethods[] = {
 },  
 
     {"polywarp", ImageRegistration_PolyWarp, METH_VARARGS, 
-"imageregistration.polywarp(inputimage, inputgcps, outputimage, wktStringFile, resolution, polyOrder, gdalformat, transformImage=False)\n"
+"imageregistration.polywarp(inputimage, inputgcps, outputimage, wktStringFile, resolution, polyOrder, gdalformat, transformImage=False, ncores=1, maxTransformError=0)\n"
 "Warp image from tie points using a polynomial interpolation.\n"
 "\n"
 "Where:\n"
@@ -359,6 +377,8 @@ static PyMethodDef ImageRegistrationMethods[] = {
 ":param polyOrder: is an int specifying the order of polynomial to use.\n"
 ":param gdalformat: is a string providing the output format (e.g., KEA).\n"
 ":param transformImage: is a bool, if set to true will generate an image providing the transform for each pixel, rather than warping the input image \n"
+":param ncores: is an optional unsigned int specifying the number of threads used to warp the image (0 uses all available; default 1).\n"
+":param maxTransformError: is an optional float specifying the maximum error (in input pixels) allowed when the transform is approximated by bilinear interpolation between a grid of exact transforms; 0 calculates the transform for every pixel (default 0; gdalwarp uses 0.125).\n"
 "\n"
 "Example::\n"
 "\n"
@@ -291,12 +291,24 @@ static PyObject *ImageUtils_createImageMosaic(PyObject *self, PyObject *args)
     float backgroundVal, skipVal;
     int skipBand, nDataType, overlapBehaviour;
     PyObject *pInputImages; // List of input images
+    PyObject *pIOOptionsObj = Py_None;
 
     // Check parameters are present and of correct type
-    if( !PyArg_ParseTuple(args, "Osffiisi:createImageMosaic", &pInputImages, &pszOutputImage,
-                                &backgroundVal, &skipVal, &skipBand, &overlapBehaviour,&pszGDALFormat, &nDataType))
+    if( !PyArg_ParseTuple(args, "Osffiisi|O:createImageMosaic", &pInputImages, &pszOutputImage,
+                                &backgroundVal, &skipVal, &skipBand, &overlapBehaviour,&pszGDALFormat, &nDataType, &pIOOptionsObj))
         return NULL;
 
+    rsgis::cmds::RSGISImageIOOptionsCmds ioOptions;
+    if( pIOOptionsObj != Py_None )
+    {
+        std::string errMsg = "";
+        if( !RSGISPY_IMAGE_IO_OPTIONS_EXTRACT(pIOOptionsObj, &ioOptions, &errMsg) )
+        {
+            PyErr_SetString(GETSTATE(self)->error, errMsg.c_str());
+            return NULL;
+        }
+    }
+
     // TODO: Look into this function - doesn't seem to catch when only a single image is provided.
     if(!PySequence_Check(pInputImages)) {
         PyErr_SetString(GETSTATE(self)->error, "First argument must be a sequence");
@@ -315,7 +327,7 @@ static PyObject *ImageUtils_createImageMosaic(PyObject *self, PyObject *args)
     try
     {
         rsgis::cmds::executeImageMosaic(inputImages, numImages, pszOutputImage, backgroundVal, 
-                    skipVal, skipBand-1, overlapBehaviour, pszGDALFormat, (rsgis::RSGISLibDataType)nDataType);
+                    skipVal, skipBand-1, overlapBehaviour, pszGDALFormat, (rsgis::RSGISLibDataType)nDataType, (pIOOptionsObj != Py_None)?&ioOptions:NULL);
 
     }
     catch(rsgis::cmds::RSGISCmdException &e)
@@ -2197,7 +2209,7 @@ static PyMethodDef ImageUtilsMethods[] = {
 "\n"},
     
 {"createImageMosaic", ImageUtils_createImageMosaic, METH_VARARGS,
-"rsgislib.imageutils.createImageMosaic(inputimagelist, outputimage, backgroundVal, skipVal, skipBand, overlapBehaviour, gdalformat, datatype)\n"
+"rsgislib.imageutils.createImageMosaic(inputimagelist, outputimage, backgroundVal, skipVal, skipBand, overlapBehaviour, gdalformat, datatype, iooptions)\n"
 "Create mosaic from list of input images.\n"
 "\n"
 "Where\n"
@@ -2213,6 +2225,7 @@ static PyMethodDef ImageUtilsMethods[] = {
 "      * 2 - Overwrite if value of new pixel is higher (maximum)\n"
 ":param gdalformat: is a string providing the gdalformat of the output image (e.g., KEA).\n"
 ":param datatype: is a rsgislib.TYPE_* value providing the data type of the output image.\n"
+":param iooptions: is an optional dict specifying how the output image is created and the GDAL cache used (e.g., {'compression':'DEFLATE', 'overviews':True}); see rsgislib.imagecalc.bandMath for the keys (Default=None).\n"
 "\n"
 "Example::\n"
 "\n"
@@ -1261,8 +1261,10 @@ static PyObject *RasterGIS_InterpolateClumpValues2Img(PyObject *self, PyObject *
     const char *clumpsImage, *selectField, *eastingsField, *northingsField, *methodStr, *valueField, *outputFile, *imageFormat;
     int dataType, ratBand;
     ratBand = 1;
+    unsigned int numThreads = 1;
+    double searchRadius = 0;
 
-    if(!PyArg_ParseTuple(args, "ssssssssi|i:interpolateClumpValues2Image", &clumpsImage, &selectField, &eastingsField, &northingsField, &methodStr, &valueField, &outputFile, &imageFormat, &dataType, &ratBand))
+    if(!PyArg_ParseTuple(args, "ssssssssi|iId:interpolateClumpValues2Image", &clumpsImage, &selectField, &eastingsField, &northingsField, &methodStr, &valueField, &outputFile, &imageFormat, &dataType, &ratBand, &numThreads, &searchRadius))
     {
         return NULL;
     }
@@ -1270,7 +1272,7 @@ static PyObject *RasterGIS_InterpolateClumpValues2Img(PyObject *self, PyObject *
     try
     {
         rsgis::RSGISLibDataType type = (rsgis::RSGISLibDataType) dataType;
-        rsgis::cmds::executeInterpolateClumpValuesToImage(std::string(clumpsImage), std::string(selectField), std::string(eastingsField), std::string(northingsField), std::string(methodStr), std::string(valueField), std::string(outputFile), std::string(imageFormat), type, ratBand);
+        rsgis::cmds::executeInterpolateClumpValuesToImage(std::string(clumpsImage), std::string(selectField), std::string(eastingsField), std::string(northingsField), std::string(methodStr), std::string(valueField), std::string(outputFile), std::string(imageFormat), type, ratBand, numThreads, searchRadius);
     }
     catch (rsgis::cmds::RSGISCmdException &e)
     {
@@ -2599,7 +2601,7 @@ static PyMethodDef RasterGISMethods[] = {
 "\n"},
 
 {"interpolateClumpValues2Image", RasterGIS_InterpolateClumpValues2Img, METH_VARARGS,
-"rsgislib.rastergis.interpolateClumpValues2Image(clumpsImage, selectField, eastingsField, northingsField, methodStr, valueField, outputFile, gdalformat, gdaltype, ratBand)\n"
+"rsgislib.rastergis.interpolateClumpValues2Image(clumpsImage, selectField, eastingsField, northingsField, methodStr, valueField, outputFile, gdalformat, gdaltype, ratBand, ncores, searchRadius)\n"
 "Interpolates values from clumps to the whole image of pixels.\n"
 "\n"
 "Where:\n"
@@ -2608,12 +2610,14 @@ static PyMethodDef RasterGISMethods[] = {
 ":param selectField: is a string which defines the column name where a value of 1 defines the clumps which will be included in the analysis.\n"
 ":param eastingsField: is a string which defines a column with a eastings for each clump.\n"
 ":param northingsField: is a string which defines a column with a northings for each clump.\n"
-":param methodStr: is a string which defines a column with a value for each clump which will be used for the distance, nearestneighbour or naturalneighbour or naturalnearestneighbour or knearestneighbour or idwall anaylsis.\n"
+":param methodStr: is a string which defines a column with a value for each clump which will be used for the distance, nearestneighbour or naturalneighbour or naturalnearestneighbour or knearestneighbour or idwall or idwradius anaylsis.\n"
 ":param valueField: is a string which defines a column containing the values to be interpolated creating the new image.\n"
 ":param outputFile: is a string for the path to the output image file.\n"
 ":param gdalformat: is string defining the GDAL format of the output image.\n"
 ":param datatype: is an containing one of the values from rsgislib.TYPE_*\n"
-":param ratBand: is the image band with which the RAT is associated."
+":param ratBand: is the image band with which the RAT is associated.\n"
+":param ncores: is an optional unsigned int specifying the number of threads to use (0 uses all available; default 1). The triangulation based methods (e.g., naturalneighbour) hold a copy of the triangulation per thread.\n"
+":param searchRadius: is an optional float specifying the radius (in map units) within which the clumps are used by the idwradius method (required for idwradius)."
 "\n"},
     
 
@@ -29,6 +29,7 @@
 #include <string.h>
 
 #include "common/RSGISCommons.h"
+#include "cmds/RSGISCmdCommon.h"
 
 // hides differences between Python2 and 3. 
 // PyString for Python2 - PyUnicode for Python3
@@ -111,4 +112,139 @@ inline double RSGISPY_FLOAT_EXTRACT(PyObject *o)
 #endif
 }
 
+// populates ioOptions from a dict of image I/O options (see the iooptions parameter
+// of rsgislib.imagecalc.bandMath); returns false, with the error in errMsg, if
+// the dict is not valid.
+inline bool RSGISPY_IMAGE_IO_OPTIONS_EXTRACT(PyObject *o, rsgis::cmds::RSGISImageIOOptionsCmds *ioOptions, std::string *errMsg)
+{
+    if(!PyDict_Check(o))
+    {
+        *errMsg = "iooptions must be a dict";
+        return false;
+    }
+    PyObject *pVal = PyDict_GetItemString(o, "cachemax");
+    if(pVal != NULL)
+    {
+        if(!RSGISPY_CHECK_INT(pVal))
+        {
+            *errMsg = "iooptions \'cachemax\' must be an integer (bytes)";
+            return false;
+        }
+        ioOptions->cacheMax = PyLong_AsLongLong(pVal);
+    }
+    pVal = PyDict_GetItemString(o, "tiled");
+    if(pVal != NULL)
+    {
+        ioOptions->tiled = PyObject_IsTrue(pVal);
+    }
+    pVal = PyDict_GetItemString(o, "blocksize");
+    if(pVal != NULL)
+    {
+        if(!RSGISPY_CHECK_INT(pVal))
+        {
+            *errMsg = "iooptions \'blocksize\' must be an integer";
+            return false;
+        }
+        if(RSGISPY_INT_EXTRACT(pVal) < 0)
+        {
+            *errMsg = "iooptions \'blocksize\' must not be negative";
+            return false;
+        }
+        ioOptions->blockSize = RSGISPY_UINT_EXTRACT(pVal);
+    }
+    pVal = PyDict_GetItemString(o, "compression");
+    if(pVal != NULL)
+    {
+        if(!RSGISPY_CHECK_STRING(pVal))
+        {
+            *errMsg = "iooptions \'compression\' must be a string";
+            return false;
+        }
+        ioOptions->compression = RSGISPY_STRING_EXTRACT(pVal);
+    }
+    pVal = PyDict_GetItemString(o, "compressionlevel");
+    if(pVal != NULL)
+    {
+        if(!RSGISPY_CHECK_INT(pVal))
+        {
+            *errMsg = "iooptions \'compressionlevel\' must be an integer";
+            return false;
+        }
+        ioOptions->compressionLevel = RSGISPY_INT_EXTRACT(pVal);
+    }
+    pVal = PyDict_GetItemString(o, "ncores");
+    if(pVal != NULL)
+    {
+        if(!RSGISPY_CHECK_INT(pVal))
+        {
+            *errMsg = "iooptions \'ncores\' must be an integer";
+            return false;
+        }
+        if(RSGISPY_INT_EXTRACT(pVal) < 0)
+        {
+            *errMsg = "iooptions \'ncores\' must not be negative";
+            return false;
+        }
+        ioOptions->numThreads = RSGISPY_UINT_EXTRACT(pVal);
+    }
+    pVal = PyDict_GetItemString(o, "creationoptions");
+    if(pVal != NULL)
+    {
+        if(!PyDict_Check(pVal))
+        {
+            *errMsg = "iooptions \'creationoptions\' must be a dict of the GDAL creation option names and values";
+            return false;
+        }
+        PyObject *pKey, *pOptVal;
+        Py_ssize_t pos = 0;
+        while(PyDict_Next(pVal, &pos, &pKey, &pOptVal))
+        {
+            if(!RSGISPY_CHECK_STRING(pKey))
+            {
+                *errMsg = "iooptions \'creationoptions\' names must be strings";
+                return false;
+            }
+            PyObject *pOptStr = PyObject_Str(pOptVal);
+            if(pOptStr == NULL)
+            {
+                *errMsg = "iooptions \'creationoptions\' values must be convertable to strings";
+                return false;
+            }
+            ioOptions->creationOptions.push_back(std::pair<std::string, std::string>(RSGISPY_STRING_EXTRACT(pKey), RSGISPY_STRING_EXTRACT(pOptStr)));
+            Py_DECREF(pOptStr);
+        }
+    }
+    pVal = PyDict_GetItemString(o, "overviews");
+    if(pVal != NULL)
+    {
+        ioOptions->buildOverviews = PyObject_IsTrue(pVal);
+    }
+    pVal = PyDict_GetItemString(o, "ovresampling");
+    if(pVal != NULL)
+    {
+        if(!RSGISPY_CHECK_STRING(pVal))
+        {
+            *errMsg = "iooptions \'ovresampling\' must be a string";
+            return false;
+        }
+        ioOptions->overviewResampling = RSGISPY_STRING_EXTRACT(pVal);
+    }
+    pVal = PyDict_GetItemString(o, "ovminsize");
+    if(pVal != NULL)
+    {
+        if(!RSGISPY_CHECK_INT(pVal))
+        {
+            *errMsg = "iooptions \'ovminsize\' must be an integer";
+            return false;
+        }
+        if(RSGISPY_INT_EXTRACT(pVal) < 0)
+        {
+            *errMsg = "iooptions \'ovminsize\' must not be negative";
+            return false;
+        }
+        ioOptions->minOverviewSize = RSGISPY_UINT_EXTRACT(pVal);
+    }
+    return true;
+}
+
 #endif // RSGISPY_COMMON_H
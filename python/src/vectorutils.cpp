@@ -191,12 +191,13 @@ static PyObject *VectorUtils_PolygonsInPolygon(PyObject *self, PyObject *args)
 {
     const char *pszInputVector, *pszInputCoverVector, *pszOutputDIR, *pszAttributeName;
     int force = false;
-    if( !PyArg_ParseTuple(args, "ssss|i:polygonsInPolygon", &pszInputVector, &pszInputCoverVector, &pszOutputDIR, &pszAttributeName, &force))
+    unsigned int numThreads = 1;
+    if( !PyArg_ParseTuple(args, "ssss|iI:polygonsInPolygon", &pszInputVector, &pszInputCoverVector, &pszOutputDIR, &pszAttributeName, &force, &numThreads))
         return NULL;
 
     try
     {
-        rsgis::cmds::executePolygonsInPolygon(pszInputVector, pszInputCoverVector, pszOutputDIR, pszAttributeName, force);
+        rsgis::cmds::executePolygonsInPolygon(pszInputVector, pszInputCoverVector, pszOutputDIR, pszAttributeName, force, numThreads);
     }
     catch(rsgis::cmds::RSGISCmdException &e)
     {
@@ -705,6 +706,7 @@ static PyMethodDef VectorUtilsMethods[] = {
 ":param inputvector: is a string containing the name of the input vector\n"
 ":param outputvector: is a string containing the name of the output vector\n"
 ":param force: is a bool, specifying whether to force removal of the output vector if it exists\n"
+":param ncores: is an optional unsigned int specifying the number of threads used to test the polygons (Default: 1; 0 uses all the available cores). The input vector is read into memory.\n"
 "\n"
 "Example::\n"
 "\n"
@@ -788,7 +790,7 @@ static PyMethodDef VectorUtilsMethods[] = {
 "\n"},
 
 {"polygonsInPolygon", VectorUtils_PolygonsInPolygon, METH_VARARGS, 
-"vectorutils.polygonsInPolygon(inputvector, inputcovervector, outputDIR, attributeName, force)\n"
+"vectorutils.polygonsInPolygon(inputvector, inputcovervector, outputDIR, attributeName, force, ncores)\n"
 "A command to create a new polygon containing only polygons within cover vector. \n"
 "Loops through attributes and creates a new shapefile for each polygon in the cover vector.\n\n"
 "Where:\n"
@@ -797,6 +799,7 @@ static PyMethodDef VectorUtilsMethods[] = {
 ":param inputcovervector: is a string containing the name of the cover vector vector\n"
 ":param outputDIR: is a string containing the name of the output directory\n"
 ":param force: is a bool, specifying whether to force removal of the output vector if it exists\n"
+":param ncores: is an optional unsigned int specifying the number of threads used to test the polygons (Default: 1; 0 uses all the available cores). The input vector is read into memory.\n"
 "\n"
 "Example::\n"
 "\n"
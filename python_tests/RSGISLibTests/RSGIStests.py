@@ -39,6 +39,7 @@ try:
     from rsgislib import imageutils
     from rsgislib import vectorutils
     from rsgislib import imagecalc
+    from rsgislib import imagecalibration
     from rsgislib import rastergis
     from rsgislib import zonalstats
     from rsgislib import imageregistration
@@ -47,6 +48,9 @@ try:
     from rsgislib.segmentation import segutils
     from rsgislib.imagecalc import BandDefn
     from rsgislib import tools
+    from osgeo import gdal
+    from osgeo import ogr
+    import numpy
 except ImportError as err:
     print(err)
     sys.exit()
@@ -191,6 +195,18 @@ class RSGISTests:
         bandDefns.append(BandDefn("b2", inFileName, 2))
         imagecalc.bandMath(outputImage, expression, gdalformat, dataType, bandDefns)
 
+    def testBandMathIOOptions(self):
+        print("PYTHON TEST: Testing bandMath with iooptions")
+        outputImage = path + "TestOutputs/PSU142_b1mb2_deflate.tif"
+        bandDefns = [BandDefn("b1", inFileName, 1), BandDefn("b2", inFileName, 2)]
+        imagecalc.bandMath(outputImage, "b1*b2", "GTiff", rsgislib.TYPE_32FLOAT, bandDefns, iooptions={'compression':'DEFLATE', 'blocksize':128, 'ncores':2})
+        for key in ['ncores', 'blocksize']:
+            try:
+                imagecalc.bandMath(outputImage, "b1*b2", "GTiff", rsgislib.TYPE_32FLOAT, bandDefns, iooptions={key:-1})
+            except Exception:
+                continue
+            raise Exception('A negative value of \'{}\' in iooptions was not rejected.'.format(key))
+
     def testImageMaths(self):
         print("PYTHON TEST: Testing imageMath")
         outputImage = path + "TestOutputs/PSU142_multi1000.kea"
@@ -532,6 +548,153 @@ class RSGISTests:
         colourtable=True
         rastergis.populateStats(clumps, colourtable, pyramids)
 
+    def getRATColumnIdx(self, rat, colName):
+        for idx in range(rat.GetColumnCount()):
+            if rat.GetNameOfCol(idx) == colName:
+                return idx
+        raise Exception('Column {} is not in the attribute table.'.format(colName))
+
+    def testInterpolateClumpValues2ImageExhaustive(self):
+        print("PYTHON TEST: interpolateClumpValues2Image (compared to an exhaustive search)")
+        clumps = "./TestOutputs/RasterGIS/interp_pts_clumps.kea"
+        numPts = 50
+        xSize = 80
+        ySize = 70
+        tlX = 500000.0
+        tlY = 7000000.0
+        res = 2.0
+        searchRadius = 10.0
+        rand = numpy.random.RandomState(42)
+        ptsX = tlX + (rand.random_sample(numPts) * xSize * res)
+        ptsY = tlY - (rand.random_sample(numPts) * ySize * res)
+        ptsVal = rand.random_sample(numPts) * 100
+        
+        clumpsDS = gdal.GetDriverByName('KEA').Create(clumps, xSize, ySize, 1, gdal.GDT_UInt32)
+        clumpsDS.SetGeoTransform([tlX, res, 0, tlY, 0, -res])
+        band = clumpsDS.GetRasterBand(1)
+        band.WriteArray(((numpy.arange(xSize * ySize) % numPts) + 1).reshape((ySize, xSize)).astype(numpy.uint32))
+        rat = band.GetDefaultRAT()
+        rat.CreateColumn('Select', gdal.GFT_Integer, gdal.GFU_Generic)
+        rat.CreateColumn('Eastings', gdal.GFT_Real, gdal.GFU_Generic)
+        rat.CreateColumn('Northings', gdal.GFT_Real, gdal.GFU_Generic)
+        rat.CreateColumn('Value', gdal.GFT_Real, gdal.GFU_Generic)
+        rat.SetRowCount(numPts + 1)
+        rat.WriteArray(numpy.append([0], numpy.ones(numPts)).astype(numpy.int32), self.getRATColumnIdx(rat, 'Select'))
+        rat.WriteArray(numpy.append([0], ptsX), self.getRATColumnIdx(rat, 'Eastings'))
+        rat.WriteArray(numpy.append([0], ptsY), self.getRATColumnIdx(rat, 'Northings'))
+        rat.WriteArray(numpy.append([0], ptsVal), self.getRATColumnIdx(rat, 'Value'))
+        rat = None
+        band = None
+        clumpsDS = None
+        
+        # The image corners are added to the points with values from the linear trend of the points.
+        A = numpy.array([[numpy.sum(ptsX * ptsX), numpy.sum(ptsX * ptsY), numpy.sum(ptsX)], [numpy.sum(ptsX * ptsY), numpy.sum(ptsY * ptsY), numpy.sum(ptsY)], [numpy.sum(ptsX), numpy.sum(ptsY), numPts]])
+        B = numpy.array([numpy.sum(ptsX * ptsVal), numpy.sum(ptsY * ptsVal), numpy.sum(ptsVal)])
+        trend = numpy.linalg.solve(A, B)
+        brX = tlX + (xSize * res)
+        brY = tlY - (ySize * res)
+        cornersX = numpy.array([tlX, brX, brX, tlX])
+        cornersY = numpy.array([tlY, tlY, brY, brY])
+        allX = numpy.append(ptsX, cornersX)
+        allY = numpy.append(ptsY, cornersY)
+        allVal = numpy.append(ptsVal, (trend[0] * cornersX) + (trend[1] * cornersY) + trend[2])
+        
+        # Each pixel is interpolated at its top left corner.
+        pxlX, pxlY = numpy.meshgrid(tlX + (numpy.arange(xSize) * res), tlY - (numpy.arange(ySize) * res))
+        distSq = ((pxlX[:,:,numpy.newaxis] - allX) ** 2) + ((pxlY[:,:,numpy.newaxis] - allY) ** 2)
+        nearestVal = allVal[numpy.argmin(distSq, axis=2)]
+        onPt = numpy.any(distSq == 0, axis=2)
+        weights = 1.0 / (numpy.where(distSq == 0, 1.0, distSq) ** 4)
+        idwAll = numpy.sum(weights * allVal, axis=2) / numpy.sum(weights, axis=2)
+        idwAll = numpy.where(onPt, nearestVal, idwAll)
+        radiusWeights = numpy.where(distSq <= (searchRadius * searchRadius), weights, 0.0)
+        inRadius = numpy.any(radiusWeights > 0, axis=2)
+        idwRadius = numpy.sum(radiusWeights * allVal, axis=2) / numpy.where(inRadius, numpy.sum(radiusWeights, axis=2), 1.0)
+        idwRadius = numpy.where(onPt | numpy.logical_not(inRadius), nearestVal, idwRadius)
+        expectedVals = {'knearestneighbour':nearestVal, 'idwall':idwAll, 'idwradius':idwRadius}
+        
+        for method in ['knearestneighbour', 'idwall', 'idwradius']:
+            outVals = []
+            for ncores in [1, 4]:
+                outputFile = "./TestOutputs/RasterGIS/interp_pts_{}_{}cores.kea".format(method, ncores)
+                rastergis.interpolateClumpValues2Image(clumps, 'Select', 'Eastings', 'Northings', method, 'Value', outputFile, 'KEA', rsgislib.TYPE_32FLOAT, 1, ncores, searchRadius)
+                outDS = gdal.Open(outputFile)
+                outVals.append(outDS.GetRasterBand(1).ReadAsArray())
+                outDS = None
+            if not numpy.array_equal(outVals[0], outVals[1]):
+                raise Exception('The {} interpolation is different with 1 and 4 cores.'.format(method))
+            if not numpy.allclose(outVals[0], expectedVals[method], rtol=1e-5, atol=1e-4):
+                raise Exception('The {} interpolation differs from the exhaustive search by up to {}.'.format(method, numpy.max(numpy.abs(outVals[0] - expectedVals[method]))))
+        
+        # The triangulation based methods use a copy of the triangulation per thread.
+        for method in ['nearestneighbour', 'naturalneighbour']:
+            outVals = []
+            for ncores in [1, 4]:
+                outputFile = "./TestOutputs/RasterGIS/interp_pts_{}_{}cores.kea".format(method, ncores)
+                rastergis.interpolateClumpValues2Image(clumps, 'Select', 'Eastings', 'Northings', method, 'Value', outputFile, 'KEA', rsgislib.TYPE_32FLOAT, 1, ncores)
+                outDS = gdal.Open(outputFile)
+                outVals.append(outDS.GetRasterBand(1).ReadAsArray())
+                outDS = None
+            if not numpy.array_equal(outVals[0], outVals[1]):
+                raise Exception('The {} interpolation is different with 1 and 4 cores.'.format(method))
+            if (method == 'nearestneighbour') and (not numpy.allclose(outVals[0], nearestVal, rtol=1e-5, atol=1e-4)):
+                raise Exception('The nearestneighbour interpolation differs from the exhaustive search.')
+
+    def testCollapseRATChunked(self):
+        print("PYTHON TEST: collapseRAT (compared to the columns read with GDAL)")
+        clumps = "./TestOutputs/RasterGIS/collapse_rat_clumps.kea"
+        outputFile = "./TestOutputs/RasterGIS/collapse_rat_clumps_collapsed.kea"
+        # One clump per pixel so the RAT is read and written in several chunks of RAT_BLOCK_LENGTH (100000) rows.
+        xSize = 500
+        ySize = 500
+        numRows = (xSize * ySize) + 1
+        rand = numpy.random.RandomState(42)
+        selectVals = (rand.random_sample(numRows) < 0.3).astype(numpy.int32)
+        selectVals[0] = 0
+        intVals = rand.randint(-1000, 1000, numRows).astype(numpy.int32)
+        realVals = rand.random_sample(numRows) * 1000
+        strVals = numpy.array(['Clump{}'.format(i) for i in range(numRows)], dtype=numpy.bytes_)
+        
+        clumpsDS = gdal.GetDriverByName('KEA').Create(clumps, xSize, ySize, 1, gdal.GDT_UInt32)
+        clumpsDS.SetGeoTransform([500000.0, 1.0, 0, 7000000.0, 0, -1.0])
+        band = clumpsDS.GetRasterBand(1)
+        band.WriteArray(numpy.arange(1, numRows, dtype=numpy.uint32).reshape((ySize, xSize)))
+        rat = band.GetDefaultRAT()
+        rat.CreateColumn('Select', gdal.GFT_Integer, gdal.GFU_Generic)
+        rat.CreateColumn('IntCol', gdal.GFT_Integer, gdal.GFU_Generic)
+        rat.CreateColumn('RealCol', gdal.GFT_Real, gdal.GFU_Generic)
+        rat.CreateColumn('StrCol', gdal.GFT_String, gdal.GFU_Generic)
+        rat.SetRowCount(numRows)
+        rat.WriteArray(selectVals, self.getRATColumnIdx(rat, 'Select'))
+        rat.WriteArray(intVals, self.getRATColumnIdx(rat, 'IntCol'))
+        rat.WriteArray(realVals, self.getRATColumnIdx(rat, 'RealCol'))
+        rat.WriteArray(strVals, self.getRATColumnIdx(rat, 'StrCol'))
+        rat = None
+        band = None
+        clumpsDS = None
+        
+        rastergis.collapseRAT(clumps, 'Select', outputFile, 'KEA', 1)
+        
+        # The selected rows are numbered in order from 1 and the other clumps are set to 0.
+        selected = selectVals == 1
+        collapsedIDs = numpy.zeros(numRows, dtype=numpy.uint32)
+        collapsedIDs[selected] = numpy.arange(1, numpy.sum(selected) + 1)
+        outDS = gdal.Open(outputFile)
+        outBand = outDS.GetRasterBand(1)
+        if not numpy.array_equal(outBand.ReadAsArray(), collapsedIDs[1:].reshape((ySize, xSize))):
+            raise Exception('The collapsed clumps image is not numbered from the selected rows.')
+        outRAT = outBand.GetDefaultRAT()
+        if outRAT.GetRowCount() != (numpy.sum(selected) + 1):
+            raise Exception('The collapsed RAT has {} rows rather than {}.'.format(outRAT.GetRowCount(), numpy.sum(selected) + 1))
+        expectedCols = [('Select', selectVals), ('IntCol', intVals), ('RealCol', realVals), ('StrCol', strVals)]
+        for colName, colVals in expectedCols:
+            outColVals = outRAT.ReadAsArray(self.getRATColumnIdx(outRAT, colName))
+            if not numpy.array_equal(outColVals[1:], colVals[selected]):
+                raise Exception('Column {} of the collapsed RAT does not match the selected rows.'.format(colName))
+        outRAT = None
+        outBand = None
+        outDS = None
+
     # Image Utils 
     
     def testCreateTiles(self):
@@ -648,6 +811,42 @@ class RSGISTests:
         inputImage = './Rasters/injune_p142_casi_sub_utm.kea'
         imageutils.getGDALDataType(inputImage)
 
+    def testPerformRandomPxlSampleInMask(self):
+        print("PYTHON TEST: performRandomPxlSampleInMaskLowPxlCount (compared to the pixel counts of each mask value)")
+        inputImage = './TestOutputs/sample_mask.kea'
+        xSize = 60
+        ySize = 50
+        numSamples = 20
+        maskVals = [1, 2, 3]
+        # Mask value 1 covers most of the image, 3 a block of 300 pixels and 2 only 7 pixels.
+        maskArr = numpy.ones((ySize, xSize), dtype=numpy.int32)
+        maskArr[:, :5] = 0
+        maskArr[30:45, 30:50] = 3
+        maskArr[2, 10:17] = 2
+        maskDS = gdal.GetDriverByName('KEA').Create(inputImage, xSize, ySize, 1, gdal.GDT_Int32)
+        maskDS.SetGeoTransform([500000.0, 1.0, 0, 7000000.0, 0, -1.0])
+        maskDS.GetRasterBand(1).WriteArray(maskArr)
+        maskDS = None
+        
+        outVals = []
+        for run in range(2):
+            outputImage = './TestOutputs/sample_mask_samples{}.kea'.format(run)
+            imageutils.performRandomPxlSampleInMaskLowPxlCount(inputImage, outputImage, 'KEA', maskVals, numSamples, 5)
+            outDS = gdal.Open(outputImage)
+            outVals.append(outDS.GetRasterBand(1).ReadAsArray())
+            outDS = None
+        
+        if not numpy.array_equal(outVals[0], outVals[1]):
+            raise Exception('The samples are different for the same random seed.')
+        sampled = outVals[0] != 0
+        if not numpy.array_equal(outVals[0][sampled], maskArr[sampled]):
+            raise Exception('Pixels have been sampled outside of their mask value.')
+        for maskVal in maskVals:
+            numSampled = numpy.sum(outVals[0] == maskVal)
+            expectedNum = min(numSamples, numpy.sum(maskArr == maskVal))
+            if numSampled != expectedNum:
+                raise Exception('{} pixels were sampled with mask value {} rather than {}.'.format(numSampled, maskVal, expectedNum))
+
      # Zonal Stats
 
     def testPointValue2SHP(self):
@@ -704,6 +903,54 @@ class RSGISTests:
         outputHDF = './TestOutputs/InjuneP142.hdf'
         zonalstats.imageZoneToHDF(inputimage, inputvector, outputHDF, True, zonalstats.METHOD_POLYCONTAINSPIXELCENTER)
         
+    # Image Calibration
+    def testLandsatTMCloudFMaskNumCores(self):
+        print("PYTHON TEST: applyLandsatTMCloudFMask (1 core compared to 4 cores)")
+        xSize = 200
+        ySize = 320
+        rand = numpy.random.RandomState(42)
+        # Land with a water body and a block of cloud; reflectance and thermal (celsius) multiplied by 1000.
+        landRefl = [60, 80, 70, 300, 200, 100]
+        waterRefl = [70, 60, 40, 15, 8, 5]
+        cloudRefl = [600, 620, 640, 650, 500, 400]
+        toaArr = numpy.zeros((len(landRefl), ySize, xSize), dtype=numpy.uint16)
+        for b in range(len(landRefl)):
+            bandArr = numpy.full((ySize, xSize), landRefl[b], dtype=numpy.float64)
+            bandArr[:80, :60] = waterRefl[b]
+            bandArr[150:210, 100:160] = cloudRefl[b]
+            toaArr[b] = numpy.clip(bandArr + rand.normal(0, 5, (ySize, xSize)), 1, None).astype(numpy.uint16)
+        thermArr = numpy.full((ySize, xSize), 28000.0)
+        thermArr[:80, :60] = 20000
+        thermArr[150:210, 100:160] = 5000
+        thermArr = (thermArr + rand.normal(0, 200, (ySize, xSize))).astype(numpy.int16)
+        
+        inputs = [('./TestOutputs/fmask_toa.kea', toaArr, gdal.GDT_UInt16),
+                  ('./TestOutputs/fmask_thermal.kea', thermArr[numpy.newaxis], gdal.GDT_Int16),
+                  ('./TestOutputs/fmask_sat.kea', numpy.zeros((7, ySize, xSize), dtype=numpy.uint8), gdal.GDT_Byte),
+                  ('./TestOutputs/fmask_valid.kea', numpy.ones((1, ySize, xSize), dtype=numpy.uint8), gdal.GDT_Byte)]
+        for imgFile, imgArr, imgType in inputs:
+            # Blocks of 64 rows so the images are processed in several strips.
+            imgDS = gdal.GetDriverByName('KEA').Create(imgFile, xSize, ySize, imgArr.shape[0], imgType, ['IMAGEBLOCKSIZE=64'])
+            imgDS.SetGeoTransform([500000.0, 30.0, 0, 7000000.0, 0, -30.0])
+            for b in range(imgArr.shape[0]):
+                imgDS.GetRasterBand(b+1).WriteArray(imgArr[b])
+            imgDS = None
+        
+        outVals = []
+        for ncores in [1, 4]:
+            outputImage = './TestOutputs/fmask_clouds_{}cores.kea'.format(ncores)
+            tmpImgsBase = './TestOutputs/fmask_tmp_{}cores'.format(ncores)
+            imagecalibration.applyLandsatTMCloudFMask(inputs[0][0], inputs[1][0], inputs[2][0], inputs[3][0], outputImage, 'KEA', 150.0, 35.0, 0.0, 0.0, 1000, tmpImgsBase, '.kea', 0.7, True, ncores)
+            outDS = gdal.Open(outputImage)
+            outVals.append(outDS.GetRasterBand(1).ReadAsArray())
+            outDS = None
+        # The per-thread histograms are merged, so the percentiles and the mask must not depend on the number of cores.
+        if not numpy.array_equal(outVals[0], outVals[1]):
+            raise Exception('The cloud mask is different with 1 and 4 cores.')
+
+    def testEstimationLUTInversion(self):
+        print("PYTHON TEST: radar parameter estimation look up table inversion - CANNOT TEST - no binding for RSGISEstimationLUTInversion")
+
     # Image Registration
     def testBasicRegistration(self):
         print("PYTHON TEST: basicregistration")
@@ -720,6 +967,30 @@ class RSGISTests:
         outputType = imageregistration.TYPE_RSGIS_IMG2MAP
         output = './TestOutputs/injune_p142_casi_sub_utm_tie_points_basic.txt'
         imageregistration.basicregistration(reference, floating, pixelGap, threshold, window, search, stddevRef, stddevFloat, subpixelresolution, metric, outputType, output)
+
+    def testBasicRegistrationFFTCoarseShift(self):
+        print("PYTHON TEST: basicregistration (phase correlation coarse shift compared to the full search)")
+        reference = './Rasters/injune_p142_casi_sub_utm_single_band.vrt'
+        floating = './Rasters/injune_p142_casi_sub_utm_single_band_offset3x3y.vrt'
+        pixelGap = 50
+        threshold = 0.4
+        window = 100
+        search = 10
+        stddevRef = 2
+        stddevFloat = 2
+        subpixelresolution = 4
+        metric = imageregistration.METRIC_CORELATION
+        outputType = imageregistration.TYPE_RSGIS_IMG2MAP
+        outputFull = './TestOutputs/injune_p142_casi_sub_utm_tie_points_basic_fullsearch.txt'
+        outputFFT = './TestOutputs/injune_p142_casi_sub_utm_tie_points_basic_fftcoarse.txt'
+        imageregistration.basicregistration(reference, floating, pixelGap, threshold, window, search, stddevRef, stddevFloat, subpixelresolution, metric, outputType, outputFull, False)
+        imageregistration.basicregistration(reference, floating, pixelGap, threshold, window, search, stddevRef, stddevFloat, subpixelresolution, metric, outputType, outputFFT, True)
+        with open(outputFull, 'r') as f:
+            fullLines = f.readlines()
+        with open(outputFFT, 'r') as f:
+            fftLines = f.readlines()
+        if fullLines != fftLines:
+            raise Exception('The tie points found with the coarse shift are different to those from the full search.')
         
     def testSingleLayerRegistration(self):
         print("PYTHON TEST: singlelayerregistration")
@@ -820,6 +1091,44 @@ class RSGISTests:
         attribute = 'PSU'
         vectorutils.polygonsInPolygon(inputVector, coverVector, outDIR, attribute, True)
 
+    def testPolygonsInPolygonExhaustive(self):
+        print("PYTHON TEST: polygonsInPolygon (compared to an exhaustive search)")
+        inputVector = './Vectors/injune_p142_crowns_utm.shp'
+        coverVector = './Vectors/injune_p142_psu_utm.shp'
+        attribute = 'PSU'
+        outDIRs = ['./TestOutputs/PolysInPoly1Core', './TestOutputs/PolysInPoly4Cores']
+        for outDIR in outDIRs:
+            if os.path.isdir(outDIR) == False:
+                os.mkdir(outDIR)
+        vectorutils.polygonsInPolygon(inputVector, coverVector, outDIRs[0], attribute, True, 1)
+        vectorutils.polygonsInPolygon(inputVector, coverVector, outDIRs[1], attribute, True, 4)
+        
+        inputDS = ogr.Open(inputVector)
+        inputLyr = inputDS.GetLayer()
+        coverDS = ogr.Open(coverVector)
+        coverLyr = coverDS.GetLayer()
+        for coverFeat in coverLyr:
+            coverGeom = coverFeat.GetGeometryRef()
+            expectedIDs = []
+            inputLyr.ResetReading()
+            for inFeat in inputLyr:
+                if coverGeom.Contains(inFeat.GetGeometryRef()):
+                    expectedIDs.append(inFeat.GetField('ID'))
+            expectedIDs.sort()
+            
+            for outDIR in outDIRs:
+                outVector = os.path.join(outDIR, coverFeat.GetFieldAsString(attribute) + '.shp')
+                outDS = ogr.Open(outVector)
+                outIDs = sorted([outFeat.GetField('ID') for outFeat in outDS.GetLayer()])
+                outDS = None
+                if outIDs != expectedIDs:
+                    raise Exception('{} has {} polygons but {} are contained in the cover polygon.'.format(outVector, len(outIDs), len(expectedIDs)))
+        inputDS = None
+        coverDS = None
+
+    def testDelaunayTriangulation(self):
+        print("PYTHON TEST: Delaunay triangulation - CANNOT TEST - no binding creates a triangulation (spatialGraphClusterGeoms needs RSGISGraphGeomClusterer)")
+
 
     # Image filter
     def testFilter(self, allFilters=False):
@@ -897,6 +1206,7 @@ if __name__ == '__main__':
     parser = argparse.ArgumentParser()
     parser.add_argument("--all", action='store_true', default=False, help="Run all tests")
     parser.add_argument("--imagecalc", action='store_true', default=False, help="Run imagecalc tests")
+    parser.add_argument("--imagecalibration", action='store_true', default=False, help="Run imagecalibration tests")
     parser.add_argument("--imagefilter", action='store_true', default=False, help="Run imagefilter tests")
     parser.add_argument("--imageregistration", action='store_true', default=False, help="Run imageregistration tests")
     parser.add_argument("--imageutils", action='store_true', default=False, help="Run imageutils tests")
@@ -925,6 +1235,7 @@ if __name__ == '__main__':
         t.tryFuncAndCatch(t.testPCA)
         t.tryFuncAndCatch(t.testStandardise)
         t.tryFuncAndCatch(t.testBandMath)
+        t.tryFuncAndCatch(t.testBandMathIOOptions)
         t.tryFuncAndCatch(t.testImageMaths)
         t.tryFuncAndCatch(t.testReplaceValuesLessThan)
         t.tryFuncAndCatch(t.testUnitArea)
@@ -969,6 +1280,7 @@ if __name__ == '__main__':
         t.tryFuncAndCatch(t.testSetBandNames)
         t.tryFuncAndCatch(t.testGetRSGISLibDataType)
         t.tryFuncAndCatch(t.testGetGDALDataType)
+        t.tryFuncAndCatch(t.testPerformRandomPxlSampleInMask)
         
     if args.all or args.rastergis:
     
@@ -992,6 +1304,8 @@ if __name__ == '__main__':
         #t.tryFuncAndCatch(t.testCalcBorderLength)
         #t.tryFuncAndCatch(t.testCalcShapeIndices)
         t.tryFuncAndCatch(t.testFindChangeClumpsFromStdDev)
+        t.tryFuncAndCatch(t.testInterpolateClumpValues2ImageExhaustive)
+        t.tryFuncAndCatch(t.testCollapseRATChunked)
         t.tryFuncAndCatch(t.testCopyGDLATTColumns)
         
     if args.all or args.zonalstats:
@@ -1004,10 +1318,17 @@ if __name__ == '__main__':
         t.tryFuncAndCatch(t.testPixelVals2TXT)
         t.tryFuncAndCatch(t.testImageZone2HDF)
         
+    if args.all or args.imagecalibration:
+        
+        """ Image Calibration functions """
+        t.tryFuncAndCatch(t.testLandsatTMCloudFMaskNumCores)
+        t.tryFuncAndCatch(t.testEstimationLUTInversion)
+        
     if args.all or args.imageregistration:
         
         """ Image Registration functions """
         t.tryFuncAndCatch(t.testBasicRegistration)
+        t.tryFuncAndCatch(t.testBasicRegistrationFFTCoarseShift)
         t.tryFuncAndCatch(t.testSingleLayerRegistration)
         t.tryFuncAndCatch(t.testGCP2GDAL)
         t.tryFuncAndCatch(t.testTriangularWarp)
@@ -1023,6 +1344,8 @@ if __name__ == '__main__':
         t.tryFuncAndCatch(t.testFindReplaceText)
         t.tryFuncAndCatch(t.testCalcArea)
         t.tryFuncAndCatch(t.testPolygonsInPolygon)
+        t.tryFuncAndCatch(t.testPolygonsInPolygonExhaustive)
+        t.tryFuncAndCatch(t.testDelaunayTriangulation)
 
     if args.all or args.imagefilter:
         """ Image filter functions """ 
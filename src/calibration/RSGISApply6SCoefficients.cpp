@@ -299,12 +299,141 @@ namespace rsgis{namespace calib{
     
     
     
+    RSGISNearestValueIndex::RSGISNearestValueIndex(std::vector<float> *vals)
+    {
+        if(vals->empty())
+        {
+            throw rsgis::img::RSGISImageCalcException("An index cannot be built for an empty list of values.");
+        }
+        
+        std::vector<std::pair<float, unsigned int> > valIdxs;
+        valIdxs.reserve(vals->size());
+        for(unsigned int i = 0; i < vals->size(); ++i)
+        {
+            if(vals->at(i) != vals->at(i))
+            {
+                throw rsgis::img::RSGISImageCalcException("An index cannot be built for a list of values containing NaN.");
+            }
+            valIdxs.push_back(std::pair<float, unsigned int>(vals->at(i), i));
+        }
+        // Sorted by value and then index, so only the first (lowest index) of repeated values is kept.
+        std::sort(valIdxs.begin(), valIdxs.end());
+        for(std::vector<std::pair<float, unsigned int> >::iterator iterVals = valIdxs.begin(); iterVals != valIdxs.end(); ++iterVals)
+        {
+            if(this->sortVals.empty() || (this->sortVals.back() != (*iterVals).first))
+            {
+                this->sortVals.push_back((*iterVals).first);
+                this->sortIdxs.push_back((*iterVals).second);
+            }
+        }
+        unsigned int numVals = this->sortVals.size();
+        
+        this->minVal = this->sortVals.front();
+        double range = ((double)this->sortVals.back()) - this->minVal;
+        this->numCells = 1;
+        this->cellWidth = 1;
+        if(numVals > 1)
+        {
+            double minSpacing = range;
+            for(unsigned int k = 0; k < numVals-1; ++k)
+            {
+                if((((double)this->sortVals[k+1]) - this->sortVals[k]) < minSpacing)
+                {
+                    minSpacing = ((double)this->sortVals[k+1]) - this->sortVals[k];
+                }
+            }
+            // Cells of half the minimum spacing overlap at most two of the intervals
+            // within which each value is the nearest.
+            double numCellsReq = ceil(range / (minSpacing / 2));
+            if(numCellsReq > RSGIS_NEAREST_VALUE_INDEX_MAX_CELLS)
+            {
+                numCellsReq = RSGIS_NEAREST_VALUE_INDEX_MAX_CELLS;
+            }
+            if(numCellsReq > 1)
+            {
+                this->numCells = (long)numCellsReq;
+            }
+            this->cellWidth = range / this->numCells;
+        }
+        
+        this->cellFirst.resize(this->numCells);
+        this->cellLast.resize(this->numCells);
+        unsigned int first = 0;
+        unsigned int last = 0;
+        double cellStart = 0.0;
+        double cellEnd = 0.0;
+        for(long c = 0; c < this->numCells; ++c)
+        {
+            cellStart = this->minVal + (c * this->cellWidth);
+            cellEnd = this->minVal + ((c + 1) * this->cellWidth);
+            while(((first+1) < numVals) && (((((double)this->sortVals[first]) + this->sortVals[first+1]) / 2) < cellStart))
+            {
+                ++first;
+            }
+            last = first;
+            while(((last+1) < numVals) && (((((double)this->sortVals[last]) + this->sortVals[last+1]) / 2) <= cellEnd))
+            {
+                ++last;
+            }
+            // One more value either side is compared to allow for rounding at the cell edges.
+            this->cellFirst[c] = (first > 0)?(first-1):0;
+            this->cellLast[c] = ((last+1) < numVals)?(last+1):last;
+        }
+    }
+    
+    RSGISNearestValueIndex::~RSGISNearestValueIndex()
+    {
+        
+    }
+    
+    RSGIS6SElevAOTLUTIndex::RSGIS6SElevAOTLUTIndex(std::vector<LUT6SBaseElevAOT> *lut)
+    {
+        this->lut = lut;
+        if(lut->empty())
+        {
+            throw rsgis::img::RSGISImageCalcException("The elevation LUT is empty.");
+        }
+        
+        std::vector<float> elevVals;
+        std::vector<float> aotVals;
+        for(std::vector<LUT6SBaseElevAOT>::iterator iterLUT = lut->begin(); iterLUT != lut->end(); ++iterLUT)
+        {
+            elevVals.push_back((*iterLUT).elev);
+            if((*iterLUT).aotLUT.empty())
+            {
+                for(std::vector<RSGISNearestValueIndex*>::iterator iterIdx = this->aotIndexes.begin(); iterIdx != this->aotIndexes.end(); ++iterIdx)
+                {
+                    delete *iterIdx;
+                }
+                throw rsgis::img::RSGISImageCalcException("The AOT LUT is empty for an elevation within the LUT.");
+            }
+            aotVals.clear();
+            for(std::vector<LUT6SAOT>::iterator iterAOTLUT = (*iterLUT).aotLUT.begin(); iterAOTLUT != (*iterLUT).aotLUT.end(); ++iterAOTLUT)
+            {
+                aotVals.push_back((*iterAOTLUT).aot);
+            }
+            this->aotIndexes.push_back(new RSGISNearestValueIndex(&aotVals));
+        }
+        this->elevIndex = new RSGISNearestValueIndex(&elevVals);
+    }
+    
+    RSGIS6SElevAOTLUTIndex::~RSGIS6SElevAOTLUTIndex()
+    {
+        delete this->elevIndex;
+        for(std::vector<RSGISNearestValueIndex*>::iterator iterIdx = this->aotIndexes.begin(); iterIdx != this->aotIndexes.end(); ++iterIdx)
+        {
+            delete *iterIdx;
+        }
+    }
+    
+    
     RSGISApply6SCoefficientsElevAOTLUTParam::RSGISApply6SCoefficientsElevAOTLUTParam(unsigned int numOutBands, std::vector<LUT6SBaseElevAOT> *lut, float noDataVal, bool useNoDataVal, float scaleFactor):rsgis::img::RSGISCalcImageValue(numOutBands)
     {
 		this->lut = lut;
         this->scaleFactor = scaleFactor;
         this->noDataVal = noDataVal;
         this->useNoDataVal = useNoDataVal;
+        this->lutIndex = new RSGIS6SElevAOTLUTIndex(lut);
     }
     
     void RSGISApply6SCoefficientsElevAOTLUTParam::calcImageValue(float *bandValues, int numBands, double *output) 
@@ -346,76 +475,18 @@ namespace rsgis{namespace calib{
         }
         else
         {
-            LUT6SBaseElevAOT elevLUTVal;
-            unsigned int elevLUTIdx = 0;
-            float dist = 0.0;
-            float minDist = 0.0;
-                        
-            for(unsigned int i = 0; i < lut->size(); ++i)
-            {
-                dist = (lut->at(i).elev - elevVal) * (lut->at(i).elev - elevVal);
-                if(i == 0)
-                {
-                    minDist = dist;
-                    elevLUTIdx = i;
-                }
-                else if(dist < minDist)
-                {
-                    minDist = dist;
-                    elevLUTIdx = i;
-                }
-            }
-            
-            if(elevLUTIdx >= lut->size())
-            {
-                std::cerr << "elevVal = " << elevVal << std::endl;
-                std::cerr << "elevLUTIdx = " << elevLUTIdx << std::endl;
-                std::cerr << "lut->size() = " << lut->size() << std::endl;
-                
-                throw rsgis::img::RSGISImageCalcException("Elevation value is not within the LUT.");
-            }
-            
-            elevLUTVal = lut->at(elevLUTIdx);
+            const LUT6SAOT *aotLUTVal = this->lutIndex->findCoefficients(elevVal, aotVal);
             
-            LUT6SAOT aotLUTVal;
-            unsigned int aotLUTIdx = 0;
-            
-            for(unsigned int i = 0; i < elevLUTVal.aotLUT.size(); ++i)
+            for(unsigned int i = 0; i < aotLUTVal->numValues; ++i)
             {
-                dist = (elevLUTVal.aotLUT.at(i).aot - aotVal) * (elevLUTVal.aotLUT.at(i).aot - aotVal);
-                if(i == 0)
-                {
-                    minDist = dist;
-                    aotLUTIdx = i;
-                }
-                else if(dist < minDist)
+                if(aotLUTVal->imageBands[i] > numBands)
                 {
-                    minDist = dist;
-                    aotLUTIdx = i;
-                }
-            }
-                        
-            if(aotLUTIdx >= elevLUTVal.aotLUT.size())
-            {
-                std::cerr << "aotVal = " << aotVal << std::endl;
-                std::cerr << "aotLUTIdx = " << aotLUTIdx << std::endl;
-                std::cerr << "elevLUTVal.aotLUT.size() = " << elevLUTVal.aotLUT.size() << std::endl;
-                
-                throw rsgis::img::RSGISImageCalcException("AOT value is not within the LUT.");
-            }
-            
-            aotLUTVal = elevLUTVal.aotLUT.at(aotLUTIdx);
-            
-            for(unsigned int i = 0; i < aotLUTVal.numValues; ++i)
-            {
-                if(aotLUTVal.imageBands[i] > numBands)
-                {
-                    std::cout << "Image band: " << aotLUTVal.imageBands[i] << std::endl;
+                    std::cout << "Image band: " << aotLUTVal->imageBands[i] << std::endl;
                     throw rsgis::img::RSGISImageCalcException("Image band is not within image.");
                 }
                 
-                tmpVal=aotLUTVal.aX[i]*bandValues[aotLUTVal.imageBands[i]]-aotLUTVal.bX[i];
-                output[i] = (tmpVal/(1.0+aotLUTVal.cX[i]*tmpVal))*this->scaleFactor;
+                tmpVal=aotLUTVal->aX[i]*bandValues[aotLUTVal->imageBands[i]]-aotLUTVal->bX[i];
+                output[i] = (tmpVal/(1.0+aotLUTVal->cX[i]*tmpVal))*this->scaleFactor;
 
                 if(this->useNoDataVal & (this->noDataVal == 0.0))
                 {
@@ -439,7 +510,7 @@ namespace rsgis{namespace calib{
     
     RSGISApply6SCoefficientsElevAOTLUTParam::~RSGISApply6SCoefficientsElevAOTLUTParam()
     {
-        
+        delete this->lutIndex;
     }
     
     
@@ -29,6 +29,9 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include <algorithm>
+#include <math.h>
 
 #include "gdal_priv.h"
 
@@ -84,6 +87,84 @@ namespace rsgis{namespace calib{
         float elev;
         std::vector<LUT6SAOT> aotLUT;
     };
+    
+    /** The maximum number of cells in the regular grid used by RSGISNearestValueIndex. */
+    #define RSGIS_NEAREST_VALUE_INDEX_MAX_CELLS 65536
+    
+    /**
+     * Finds the index of the value nearest to a query value within a list of values
+     * (e.g., the elevations or AOTs of a 6S LUT). The values are sorted and a regular
+     * grid is built over their range, where each cell holds the range of sorted values
+     * which could be the nearest for a query within the cell, so a query only compares
+     * a couple of values rather than scanning the whole list. The result is the same as
+     * a linear scan keeping the first minimum squared distance (where values are equally
+     * near, or repeated, the lowest index is returned) unless the values are too close
+     * together for their squared distances to the query to differ as floats. A NaN query
+     * returns index 0 and queries outside of the range of the values return the first
+     * or last value.
+     */
+    class DllExport RSGISNearestValueIndex
+    {
+    public:
+        RSGISNearestValueIndex(std::vector<float> *vals);
+        inline unsigned int findNearest(float val) const
+        {
+            if(val != val)
+            {
+                return 0;
+            }
+            long cell = 0;
+            if(val > this->minVal)
+            {
+                double cellPos = floor((val - this->minVal) / this->cellWidth);
+                cell = (cellPos >= this->numCells)?(this->numCells-1):((long)cellPos);
+            }
+            unsigned int nearIdx = this->sortIdxs[this->cellFirst[cell]];
+            float minDist = (this->sortVals[this->cellFirst[cell]] - val) * (this->sortVals[this->cellFirst[cell]] - val);
+            float dist = 0.0;
+            for(unsigned int k = this->cellFirst[cell]+1; k <= this->cellLast[cell]; ++k)
+            {
+                dist = (this->sortVals[k] - val) * (this->sortVals[k] - val);
+                if((dist < minDist) || ((dist == minDist) && (this->sortIdxs[k] < nearIdx)))
+                {
+                    minDist = dist;
+                    nearIdx = this->sortIdxs[k];
+                }
+            }
+            return nearIdx;
+        };
+        ~RSGISNearestValueIndex();
+    protected:
+        std::vector<float> sortVals;
+        std::vector<unsigned int> sortIdxs;
+        std::vector<unsigned int> cellFirst;
+        std::vector<unsigned int> cellLast;
+        double minVal;
+        double cellWidth;
+        long numCells;
+    };
+    
+    /**
+     * Pre-indexes an elevation / AOT 6S LUT so the coefficients for a pixel are found
+     * with RSGISNearestValueIndex lookups (nearest elevation and then nearest AOT for
+     * that elevation) rather than scanning the LUT for each pixel.
+     */
+    class DllExport RSGIS6SElevAOTLUTIndex
+    {
+    public:
+        RSGIS6SElevAOTLUTIndex(std::vector<LUT6SBaseElevAOT> *lut);
+        inline const LUT6SAOT* findCoefficients(float elevVal, float aotVal) const
+        {
+            unsigned int elevIdx = this->elevIndex->findNearest(elevVal);
+            unsigned int aotIdx = this->aotIndexes[elevIdx]->findNearest(aotVal);
+            return &(*this->lut)[elevIdx].aotLUT[aotIdx];
+        };
+        ~RSGIS6SElevAOTLUTIndex();
+    protected:
+        std::vector<LUT6SBaseElevAOT> *lut;
+        RSGISNearestValueIndex *elevIndex;
+        std::vector<RSGISNearestValueIndex*> aotIndexes;
+    };
 	    
 	class DllExport RSGISApply6SCoefficientsSingleParam : public rsgis::img::RSGISCalcImageValue
     {
@@ -155,6 +236,7 @@ namespace rsgis{namespace calib{
         ~RSGISApply6SCoefficientsElevAOTLUTParam();
     protected:
         std::vector<LUT6SBaseElevAOT> *lut;
+        RSGIS6SElevAOTLUTIndex *lutIndex;
         float scaleFactor;
         float noDataVal;
         bool useNoDataVal;
@@ -1495,6 +1495,580 @@ namespace rsgis{namespace calib{
         }
     }
     
+    
+    RSGISLandsatFMaskFusedCloudMasking::RSGISLandsatFMaskFusedCloudMasking(unsigned int scaleFactor, unsigned int numLSBands, double whitenessThreshold, unsigned int numThreads)
+    {
+        this->scaleFactor = scaleFactor;
+        this->numLSBands = numLSBands;
+        this->whitenessThreshold = whitenessThreshold;
+        this->numThreads = rsgis::getNumProcessingThreads(numThreads);
+        
+        if((numLSBands == 7) | (numLSBands == 8))
+        {
+            this->numReflBands = 6;
+        }
+        else if(numLSBands == 9)
+        {
+            this->numReflBands = 7;
+        }
+        else
+        {
+            throw rsgis::img::RSGISImageCalcException("Number of landsat bands is not recognised.");
+        }
+        // Band order as used by RSGISLandsatFMaskPass1CloudMasking (refl, thermal and then saturation bands).
+        this->numPass1Bands = numLSBands * 2;
+        this->nirIdx = this->numReflBands - 3;
+        this->swir1Idx = this->numReflBands - 2;
+        this->therm1Idx = this->numReflBands;
+        
+        this->foundClearSkyStats = false;
+        this->propPCP = 0.0;
+        this->lowerWaterThres = 0.0;
+        this->upperWaterThres = 0.0;
+        this->lowerLandThres = 0.0;
+        this->upperLandThres = 0.0;
+        this->landNIR175Val = 0.0;
+        this->landSWIR175Val = 0.0;
+        this->landCloudProbUpperThres = 0.0;
+        this->waterCloudProbUpperThres = 0.0;
+    }
+    
+    void RSGISLandsatFMaskFusedCloudMasking::calcClearSkyStats(GDALDataset *reflDataset, GDALDataset *thermDataset, GDALDataset *saturateDataset, GDALDataset *validDataset)
+    {
+        if(((unsigned int)reflDataset->GetRasterCount()) != this->numReflBands)
+        {
+            throw RSGISImageException("The number of reflectance bands does not match the number of landsat bands.");
+        }
+        if(((unsigned int)thermDataset->GetRasterCount()) != (this->numLSBands - this->numReflBands))
+        {
+            throw RSGISImageException("The number of thermal bands does not match the number of landsat bands.");
+        }
+        if(((unsigned int)saturateDataset->GetRasterCount()) != this->numLSBands)
+        {
+            throw RSGISImageException("The number of saturation bands is not equal to the number of refl and thermal bands.");
+        }
+        
+        RSGISLandsatFMaskPass1CloudMasking cloudMaskPass1(this->scaleFactor, this->numLSBands, this->whitenessThreshold);
+        
+        // No data values are ignored within the histograms, as RSGISPopRATWithStats::populateRATWithPercentileStats.
+        int useThermNoData = false;
+        double thermNoData = thermDataset->GetRasterBand(1)->GetNoDataValue(&useThermNoData);
+        int useNIRNoData = false;
+        double nirNoData = reflDataset->GetRasterBand(this->nirIdx+1)->GetNoDataValue(&useNIRNoData);
+        int useSWIRNoData = false;
+        double swirNoData = reflDataset->GetRasterBand(this->swir1Idx+1)->GetNoDataValue(&useSWIRNoData);
+        
+        // Bins of 0.001 in the scaled units (i.e., degrees and reflectance).
+        double histBinWidth = ((double)this->scaleFactor) / 1000.0;
+        std::vector<rsgis::math::RSGISStreamingHistogram*> landThermHists;
+        std::vector<rsgis::math::RSGISStreamingHistogram*> waterThermHists;
+        std::vector<rsgis::math::RSGISStreamingHistogram*> landNIRHists;
+        std::vector<rsgis::math::RSGISStreamingHistogram*> landSWIRHists;
+        for(unsigned int t = 0; t < this->numThreads; ++t)
+        {
+            landThermHists.push_back(new rsgis::math::RSGISStreamingHistogram(histBinWidth));
+            waterThermHists.push_back(new rsgis::math::RSGISStreamingHistogram(histBinWidth));
+            landNIRHists.push_back(new rsgis::math::RSGISStreamingHistogram(histBinWidth));
+            landSWIRHists.push_back(new rsgis::math::RSGISStreamingHistogram(histBinWidth));
+        }
+        std::vector<unsigned long> numValidPxls(this->numThreads, 0);
+        std::vector<unsigned long> numPCPPxls(this->numThreads, 0);
+        
+        GDALDataset *datasets[4] = {reflDataset, thermDataset, saturateDataset, validDataset};
+        unsigned int numBandsRead[4] = {this->numReflBands, (this->numLSBands - this->numReflBands), this->numLSBands, 1};
+        unsigned int validBandIdx = this->numPass1Bands;
+        
+        try
+        {
+            this->processStrips(datasets, numBandsRead, 4, [&](float *stripData, size_t stripPxls, unsigned int yOff, unsigned int numRows, unsigned int threadIdx)
+            {
+                float *pxlVals = new float[this->numPass1Bands];
+                double *pass1Out = new double[16];
+                float therm1Val = 0;
+                float nirVal = 0;
+                float swir1Val = 0;
+                for(size_t i = 0; i < stripPxls; ++i)
+                {
+                    for(unsigned int b = 0; b < this->numPass1Bands; ++b)
+                    {
+                        pxlVals[b] = stripData[(b * stripPxls) + i];
+                    }
+                    therm1Val = pxlVals[this->therm1Idx];
+                    nirVal = pxlVals[this->nirIdx];
+                    swir1Val = pxlVals[this->swir1Idx];
+                    
+                    cloudMaskPass1.calcImageValue(pxlVals, this->numPass1Bands, pass1Out);
+                    
+                    if(stripData[(validBandIdx * stripPxls) + i] == 1)
+                    {
+                        ++numValidPxls[threadIdx];
+                    }
+                    if(pass1Out[8] == 1)
+                    {
+                        ++numPCPPxls[threadIdx];
+                    }
+                    
+                    // Equations 8 and 13: percentiles of the clear sky water and land temperatures.
+                    if(pass1Out[15] == 1)
+                    {
+                        if(!(useThermNoData && (therm1Val == thermNoData)))
+                        {
+                            waterThermHists[threadIdx]->addValue(therm1Val);
+                        }
+                    }
+                    else if(pass1Out[9] == 1)
+                    {
+                        if(!(useThermNoData && (therm1Val == thermNoData)))
+                        {
+                            landThermHists[threadIdx]->addValue(therm1Val);
+                        }
+                        if(!(useNIRNoData && (nirVal == nirNoData)))
+                        {
+                            landNIRHists[threadIdx]->addValue(nirVal);
+                        }
+                        if(!(useSWIRNoData && (swir1Val == swirNoData)))
+                        {
+                            landSWIRHists[threadIdx]->addValue(swir1Val);
+                        }
+                    }
+                }
+                delete[] pxlVals;
+                delete[] pass1Out;
+            });
+            
+            unsigned long totalValidPxls = 0;
+            unsigned long totalPCPPxls = 0;
+            for(unsigned int t = 0; t < this->numThreads; ++t)
+            {
+                totalValidPxls += numValidPxls[t];
+                totalPCPPxls += numPCPPxls[t];
+                if(t > 0)
+                {
+                    landThermHists[0]->merge(landThermHists[t]);
+                    waterThermHists[0]->merge(waterThermHists[t]);
+                    landNIRHists[0]->merge(landNIRHists[t]);
+                    landSWIRHists[0]->merge(landSWIRHists[t]);
+                }
+            }
+            
+            this->propPCP = 0.0;
+            if(totalValidPxls > 0)
+            {
+                this->propPCP = ((double)totalPCPPxls) / ((double)totalValidPxls);
+            }
+            
+            this->lowerWaterThres = this->getPercentile(waterThermHists[0], 17.5) / this->scaleFactor;
+            this->upperWaterThres = this->getPercentile(waterThermHists[0], 82.5) / this->scaleFactor;
+            this->lowerLandThres = this->getPercentile(landThermHists[0], 17.5) / this->scaleFactor;
+            this->upperLandThres = this->getPercentile(landThermHists[0], 82.5) / this->scaleFactor;
+            this->landNIR175Val = this->getPercentile(landNIRHists[0], 17.5);
+            this->landSWIR175Val = this->getPercentile(landSWIRHists[0], 17.5);
+        }
+        catch(RSGISException &e)
+        {
+            for(unsigned int t = 0; t < this->numThreads; ++t)
+            {
+                delete landThermHists[t];
+                delete waterThermHists[t];
+                delete landNIRHists[t];
+                delete landSWIRHists[t];
+            }
+            throw;
+        }
+        
+        for(unsigned int t = 0; t < this->numThreads; ++t)
+        {
+            delete landThermHists[t];
+            delete waterThermHists[t];
+            delete landNIRHists[t];
+            delete landSWIRHists[t];
+        }
+        this->foundClearSkyStats = true;
+    }
+    
+    void RSGISLandsatFMaskFusedCloudMasking::calcCloudMask(GDALDataset *reflDataset, GDALDataset *thermDataset, GDALDataset *saturateDataset, GDALDataset *outCloudMask)
+    {
+        if(!this->foundClearSkyStats)
+        {
+            throw RSGISImageException("The clear sky statistics must be calculated before the cloud mask.");
+        }
+        unsigned int width = reflDataset->GetRasterXSize();
+        unsigned int height = reflDataset->GetRasterYSize();
+        if((((unsigned int)outCloudMask->GetRasterXSize()) != width) || (((unsigned int)outCloudMask->GetRasterYSize()) != height))
+        {
+            throw RSGISImageException("The output cloud mask must be the same size as the input images.");
+        }
+        
+        RSGISLandsatFMaskPass1CloudMasking cloudMaskPass1(this->scaleFactor, this->numLSBands, this->whitenessThreshold);
+        RSGISLandsatFMaskPass2ClearSkyCloudProbCloudMasking cloudMaskPass2Prob(this->scaleFactor, this->numLSBands, this->upperWaterThres, this->upperLandThres, this->lowerLandThres);
+        unsigned int numPass2Bands = 1 + this->numLSBands + 16;
+        
+        // Pixel classes: 0 not cloud, 1 cloud, 2 cloud if the water cloud probability is above
+        // the threshold and 3 cloud if the land cloud probability is above the threshold.
+        rsgis::img::RSGISBitPackedImage pxlClasses(width, height, 2);
+        
+        // The cloud probabilities of the class 2 and 3 pixels are held as 16 bit codes,
+        // ceil(prob/probStep) offset by 32768. The thresholds are histogram bin centres plus
+        // 0.2 (or 0.5) so are multiples of probStep, half the bin width, and comparing the
+        // codes gives the same result as comparing the probabilities for thresholds within
+        // +/-16.38 (probabilities outside of that range are clamped to it).
+        double histBinWidth = 0.001;
+        double probStep = histBinWidth/2;
+        rsgis::img::RSGISBitPackedImage cloudProbCodes(width, height, 16);
+        auto getProbCode = [probStep](double prob) -> unsigned int
+        {
+            if(prob != prob)
+            {
+                return 0;
+            }
+            double code = ceil(prob/probStep) + 32768;
+            if(code < 0)
+            {
+                return 0;
+            }
+            else if(code > 65535)
+            {
+                return 65535;
+            }
+            return (unsigned int)code;
+        };
+        
+        std::vector<rsgis::math::RSGISStreamingHistogram*> landProbHists;
+        std::vector<rsgis::math::RSGISStreamingHistogram*> waterProbHists;
+        for(unsigned int t = 0; t < this->numThreads; ++t)
+        {
+            landProbHists.push_back(new rsgis::math::RSGISStreamingHistogram(histBinWidth));
+            waterProbHists.push_back(new rsgis::math::RSGISStreamingHistogram(histBinWidth));
+        }
+        
+        GDALDataset *datasets[3] = {reflDataset, thermDataset, saturateDataset};
+        unsigned int numBandsRead[3] = {this->numReflBands, (this->numLSBands - this->numReflBands), this->numLSBands};
+        
+        try
+        {
+            this->processStrips(datasets, numBandsRead, 3, [&](float *stripData, size_t stripPxls, unsigned int yOff, unsigned int numRows, unsigned int threadIdx)
+            {
+                float *pxlVals = new float[this->numPass1Bands];
+                double *pass1Out = new double[16];
+                float *pass2In = new float[numPass2Bands];
+                double *pass2Out = new double[6];
+                float therm1Val = 0;
+                float landWater = 0;
+                float waterCloudProb = 0;
+                float landCloudProb = 0;
+                bool noData = true;
+                bool waterTest = false;
+                bool pcp = false;
+                unsigned int pxlClass = 0;
+                for(size_t i = 0; i < stripPxls; ++i)
+                {
+                    noData = true;
+                    for(unsigned int b = 0; b < this->numPass1Bands; ++b)
+                    {
+                        pxlVals[b] = stripData[(b * stripPxls) + i];
+                        if(b < this->numLSBands)
+                        {
+                            // The pass 1 calculation scales the values in place so keep the input values.
+                            pass2In[b+1] = pxlVals[b];
+                            if(pxlVals[b] != 0.0)
+                            {
+                                noData = false;
+                            }
+                        }
+                    }
+                    therm1Val = pxlVals[this->therm1Idx];
+                    if((this->numLSBands == 7) && (therm1Val == 0))
+                    {
+                        noData = true;
+                    }
+                    
+                    cloudMaskPass1.calcImageValue(pxlVals, this->numPass1Bands, pass1Out);
+                    
+                    landWater = 0;
+                    if(pass1Out[9] == 1)
+                    {
+                        landWater = 1;
+                    }
+                    if(pass1Out[15] == 1)
+                    {
+                        landWater = 2;
+                    }
+                    pass2In[0] = landWater;
+                    for(unsigned int b = 0; b < 16; ++b)
+                    {
+                        pass2In[1+this->numLSBands+b] = pass1Out[b];
+                    }
+                    cloudMaskPass2Prob.calcImageValue(pass2In, numPass2Bands, pass2Out);
+                    waterCloudProb = pass2Out[2];
+                    landCloudProb = pass2Out[5];
+                    
+                    // Equation 17: percentiles of the land and water cloud probabilities.
+                    if(landWater == 1)
+                    {
+                        landProbHists[threadIdx]->addValue(landCloudProb);
+                    }
+                    else if(landWater == 2)
+                    {
+                        waterProbHists[threadIdx]->addValue(waterCloudProb);
+                    }
+                    
+                    // Equation 18, less the tests against the probability thresholds (see RSGISLandsatFMaskPass2CloudMasking).
+                    pxlClass = 0;
+                    if(!noData)
+                    {
+                        waterTest = (pass1Out[7] == 1);
+                        pcp = (pass1Out[8] == 1);
+                        if(((!waterTest) & (landCloudProb > 0.99)) | ((therm1Val/this->scaleFactor) < (this->lowerLandThres-35)))
+                        {
+                            pxlClass = 1;
+                        }
+                        else if(pcp & waterTest)
+                        {
+                            pxlClass = 2;
+                            cloudProbCodes.setValue(i % width, yOff + (i / width), getProbCode(waterCloudProb));
+                        }
+                        else if(pcp)
+                        {
+                            pxlClass = 3;
+                            cloudProbCodes.setValue(i % width, yOff + (i / width), getProbCode(landCloudProb));
+                        }
+                    }
+                    pxlClasses.setValue(i % width, yOff + (i / width), pxlClass);
+                }
+                delete[] pxlVals;
+                delete[] pass1Out;
+                delete[] pass2In;
+                delete[] pass2Out;
+            });
+            
+            for(unsigned int t = 1; t < this->numThreads; ++t)
+            {
+                landProbHists[0]->merge(landProbHists[t]);
+                waterProbHists[0]->merge(waterProbHists[t]);
+            }
+            
+            // Equation 18 threshold of 0.5 used in Zhu and Woodcock 2012, RSE 118, pp83-94 changed in Zhu et al (2015) RSE 159 pp269-277 to be dynamic:
+            this->landCloudProbUpperThres = this->getPercentile(landProbHists[0], 82.5) + 0.2;
+            this->waterCloudProbUpperThres = this->getPercentile(waterProbHists[0], 82.5) + 0.2;
+            if(this->waterCloudProbUpperThres > 0.5)
+            {
+                this->waterCloudProbUpperThres = 0.5;
+            }
+            
+            long long waterThresCode = llround(this->waterCloudProbUpperThres/probStep) + 32768;
+            long long landThresCode = llround(this->landCloudProbUpperThres/probStep) + 32768;
+            
+            GDALRasterBand *outBand = outCloudMask->GetRasterBand(1);
+            int *rowData = new int[width];
+            unsigned int pxlClass = 0;
+            for(unsigned int y = 0; y < height; ++y)
+            {
+                for(unsigned int x = 0; x < width; ++x)
+                {
+                    pxlClass = pxlClasses.getValue(x, y);
+                    if(pxlClass == 1)
+                    {
+                        rowData[x] = 1;
+                    }
+                    else if(pxlClass == 2)
+                    {
+                        rowData[x] = (((long long)cloudProbCodes.getValue(x, y)) > waterThresCode)?1:0;
+                    }
+                    else if(pxlClass == 3)
+                    {
+                        rowData[x] = (((long long)cloudProbCodes.getValue(x, y)) > landThresCode)?1:0;
+                    }
+                    else
+                    {
+                        rowData[x] = 0;
+                    }
+                }
+                if(outBand->RasterIO(GF_Write, 0, y, width, 1, rowData, width, 1, GDT_Int32, 0, 0) != CE_None)
+                {
+                    delete[] rowData;
+                    throw RSGISImageException("Failed to write the cloud mask.");
+                }
+            }
+            delete[] rowData;
+        }
+        catch(RSGISException &e)
+        {
+            for(unsigned int t = 0; t < this->numThreads; ++t)
+            {
+                delete landProbHists[t];
+                delete waterProbHists[t];
+            }
+            throw;
+        }
+        
+        for(unsigned int t = 0; t < this->numThreads; ++t)
+        {
+            delete landProbHists[t];
+            delete waterProbHists[t];
+        }
+    }
+    
+    void RSGISLandsatFMaskFusedCloudMasking::processStrips(GDALDataset **datasets, unsigned int *numBandsRead, unsigned int numDatasets, const std::function<void(float*, size_t, unsigned int, unsigned int, unsigned int)> &func)
+    {
+        unsigned int width = datasets[0]->GetRasterXSize();
+        unsigned int height = datasets[0]->GetRasterYSize();
+        unsigned int totalNumBands = 0;
+        for(unsigned int n = 0; n < numDatasets; ++n)
+        {
+            if((((unsigned int)datasets[n]->GetRasterXSize()) != width) || (((unsigned int)datasets[n]->GetRasterYSize()) != height))
+            {
+                throw RSGISImageException("The input images for FMask must all be the same size.");
+            }
+            if(numBandsRead[n] > ((unsigned int)datasets[n]->GetRasterCount()))
+            {
+                throw RSGISImageException("An input image for FMask does not have enough bands.");
+            }
+            totalNumBands += numBandsRead[n];
+        }
+        
+        // Strips are whole blocks of at least RSGIS_FMASK_MIN_STRIP_ROWS rows.
+        int xBlockSize = 0;
+        int yBlockSize = 0;
+        datasets[0]->GetRasterBand(1)->GetBlockSize(&xBlockSize, &yBlockSize);
+        if(yBlockSize < 1)
+        {
+            yBlockSize = 1;
+        }
+        unsigned int stripRows = ((RSGIS_FMASK_MIN_STRIP_ROWS + yBlockSize - 1) / yBlockSize) * yBlockSize;
+        size_t numStrips = (height + stripRows - 1) / stripRows;
+        
+        // GDAL datasets cannot be shared between threads so each thread has its own read-only handles.
+        std::vector<GDALDataset**> threadDatasets;
+        std::vector<float*> threadStripData;
+        bool openFailed = false;
+        std::string failedImage = "";
+        for(unsigned int t = 0; t < this->numThreads; ++t)
+        {
+            GDALDataset **tDatasets = new GDALDataset*[numDatasets];
+            for(unsigned int n = 0; n < numDatasets; ++n)
+            {
+                if(this->numThreads == 1)
+                {
+                    tDatasets[n] = datasets[n];
+                }
+                else if(openFailed)
+                {
+                    tDatasets[n] = NULL;
+                }
+                else
+                {
+                    tDatasets[n] = (GDALDataset *) GDALOpen(datasets[n]->GetDescription(), GA_ReadOnly);
+                    if(tDatasets[n] == NULL)
+                    {
+                        openFailed = true;
+                        failedImage = datasets[n]->GetDescription();
+                    }
+                }
+            }
+            threadDatasets.push_back(tDatasets);
+            threadStripData.push_back(new float[((size_t)width) * stripRows * totalNumBands]);
+        }
+        
+        auto freeThreadData = [&]()
+        {
+            for(unsigned int t = 0; t < this->numThreads; ++t)
+            {
+                if(this->numThreads > 1)
+                {
+                    for(unsigned int n = 0; n < numDatasets; ++n)
+                    {
+                        if(threadDatasets[t][n] != NULL)
+                        {
+                            GDALClose(threadDatasets[t][n]);
+                        }
+                    }
+                }
+                delete[] threadDatasets[t];
+                delete[] threadStripData[t];
+            }
+        };
+        
+        try
+        {
+            if(openFailed)
+            {
+                std::string message = std::string("Could not open image ") + failedImage + std::string(" for each thread.");
+                throw RSGISImageException(message.c_str());
+            }
+            
+            size_t feedbackBlockSize = (numStrips + 9) / 10;
+            if(feedbackBlockSize == 0)
+            {
+                feedbackBlockSize = 1;
+            }
+            int feedbackCounter = 0;
+            std::cout << "Started" << std::flush;
+            for(size_t blockStart = 0; blockStart < numStrips; blockStart += feedbackBlockSize)
+            {
+                std::cout << "." << feedbackCounter << "." << std::flush;
+                feedbackCounter = feedbackCounter + 10;
+                size_t blockEnd = blockStart + feedbackBlockSize;
+                if(blockEnd > numStrips)
+                {
+                    blockEnd = numStrips;
+                }
+                
+                rsgis::parallelForRange(blockStart, blockEnd, this->numThreads, 1, [&](size_t stripStart, size_t stripEnd, unsigned int threadIdx)
+                {
+                    GDALDataset **tDatasets = threadDatasets.at(threadIdx);
+                    float *stripData = threadStripData.at(threadIdx);
+                    for(size_t s = stripStart; s < stripEnd; ++s)
+                    {
+                        unsigned int yOff = s * stripRows;
+                        unsigned int numRows = stripRows;
+                        if((yOff + numRows) > height)
+                        {
+                            numRows = height - yOff;
+                        }
+                        size_t stripPxls = ((size_t)width) * numRows;
+                        
+                        unsigned int bandIdx = 0;
+                        for(unsigned int n = 0; n < numDatasets; ++n)
+                        {
+                            for(unsigned int b = 0; b < numBandsRead[n]; ++b)
+                            {
+                                if(tDatasets[n]->GetRasterBand(b+1)->RasterIO(GF_Read, 0, yOff, width, numRows, &stripData[bandIdx * stripPxls], width, numRows, GDT_Float32, 0, 0) != CE_None)
+                                {
+                                    throw RSGISImageException("Failed to read a strip of the input images for FMask.");
+                                }
+                                ++bandIdx;
+                            }
+                        }
+                        
+                        func(stripData, stripPxls, yOff, numRows, threadIdx);
+                    }
+                });
+            }
+            std::cout << " Complete.\n";
+        }
+        catch(std::exception &e)
+        {
+            freeThreadData();
+            throw;
+        }
+        freeThreadData();
+    }
+    
+    double RSGISLandsatFMaskFusedCloudMasking::getPercentile(rsgis::math::RSGISStreamingHistogram *hist, float percentile)
+    {
+        // As the RAT, a class without any pixels has a percentile of 0.
+        if(hist->getNumValues() == 0)
+        {
+            return 0.0;
+        }
+        return hist->calcPercentile(percentile);
+    }
+    
+    RSGISLandsatFMaskFusedCloudMasking::~RSGISLandsatFMaskFusedCloudMasking()
+    {
+        
+    }
+
 }}
 
 
@@ -26,6 +26,8 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include <functional>
 #include <math.h>
 
 #include "gdal_priv.h"
@@ -33,18 +35,25 @@
 #include "geos/geom/Envelope.h"
 
 #include "common/RSGISException.h"
+#include "common/RSGISImageException.h"
+#include "common/RSGISThreadUtils.h"
 
 #include "img/RSGISImageCalcException.h"
 #include "img/RSGISCalcImageValue.h"
 #include "img/RSGISCalcImage.h"
 #include "img/RSGISImageStatistics.h"
 #include "img/RSGISExtractImageValues.h"
+#include "img/RSGISBitPackedImage.h"
 
 #include "rastergis/RSGISPopRATWithStats.h"
 #include "rastergis/RSGISRasterAttUtils.h"
 #include "rastergis/RSGISCalcClusterLocation.h"
 
 #include "math/RSGISMathsUtils.h"
+#include "math/RSGISStreamingHistogram.h"
+
+/** The minimum number of rows read together (and given to a thread) by RSGISLandsatFMaskFusedCloudMasking. */
+#define RSGIS_FMASK_MIN_STRIP_ROWS 64
 
 // mark all exported classes/functions with DllExport to have
 // them exported by Visual Studio
@@ -431,6 +440,67 @@ namespace rsgis{namespace calib{
         bool calcImageValueCondition(float ***dataBlock, int numBands, int winSize, double *output) {throw rsgis::img::RSGISImageCalcException("Not implmented.");};
         ~RSGISExportMaskForOverPCPThreshold(){};
     };
+    
+    /**
+     * Produces the FMask (Zhu and Woodcock 2012, RSE 118, pp83-94) cloud mask, prior to the
+     * majority filter, with two reads of the input images and no intermediate images, using
+     * the per-pixel calculations of RSGISLandsatFMaskPass1CloudMasking and
+     * RSGISLandsatFMaskPass2ClearSkyCloudProbCloudMasking.
+     *
+     * calcClearSkyStats reads the images once, classifying the clear sky land and water and
+     * accumulating histograms of the clear sky thermal values (and the NIR and SWIR values over
+     * land) from which the temperature thresholds (equations 8 and 13) are calculated.
+     * calcCloudMask reads the images again to calculate the cloud probabilities and their
+     * histograms. The tests of equation 18 are held as a 2 bit per pixel class and the cloud
+     * probability as a 16 bit code so the mask is written once the probability thresholds
+     * (equation 17) are known without a third read of the images.
+     *
+     * Strips of rows are shared between numThreads threads, each with its own read-only
+     * handles on the input images, so the inputs must be images on disk (or otherwise
+     * re-openable from their description). All the inputs must be the same size.
+     */
+    class DllExport RSGISLandsatFMaskFusedCloudMasking
+    {
+    public:
+        RSGISLandsatFMaskFusedCloudMasking(unsigned int scaleFactor, unsigned int numLSBands, double whitenessThreshold=0.7, unsigned int numThreads=1);
+        void calcClearSkyStats(GDALDataset *reflDataset, GDALDataset *thermDataset, GDALDataset *saturateDataset, GDALDataset *validDataset);
+        /** Must be called after calcClearSkyStats; outCloudMask (1 band) is given values of 1 for cloud and 0 otherwise. */
+        void calcCloudMask(GDALDataset *reflDataset, GDALDataset *thermDataset, GDALDataset *saturateDataset, GDALDataset *outCloudMask);
+        double getPropOfPCPPixels(){return this->propPCP;};
+        double getLowerWaterThres(){return this->lowerWaterThres;};
+        double getUpperWaterThres(){return this->upperWaterThres;};
+        double getLowerLandThres(){return this->lowerLandThres;};
+        double getUpperLandThres(){return this->upperLandThres;};
+        /** The 17.5 percentile of the NIR band over the clear sky land, in the units of the input image. */
+        double getLandNIR175Val(){return this->landNIR175Val;};
+        /** The 17.5 percentile of the SWIR1 band over the clear sky land, in the units of the input image. */
+        double getLandSWIR175Val(){return this->landSWIR175Val;};
+        double getLandCloudProbUpperThres(){return this->landCloudProbUpperThres;};
+        double getWaterCloudProbUpperThres(){return this->waterCloudProbUpperThres;};
+        ~RSGISLandsatFMaskFusedCloudMasking();
+    protected:
+        void processStrips(GDALDataset **datasets, unsigned int *numBandsRead, unsigned int numDatasets, const std::function<void(float*, size_t, unsigned int, unsigned int, unsigned int)> &func);
+        double getPercentile(rsgis::math::RSGISStreamingHistogram *hist, float percentile);
+        unsigned int scaleFactor;
+        unsigned int numLSBands;
+        unsigned int numReflBands;
+        unsigned int numPass1Bands;
+        unsigned int nirIdx;
+        unsigned int swir1Idx;
+        unsigned int therm1Idx;
+        double whitenessThreshold;
+        unsigned int numThreads;
+        bool foundClearSkyStats;
+        double propPCP;
+        double lowerWaterThres;
+        double upperWaterThres;
+        double lowerLandThres;
+        double upperLandThres;
+        double landNIR175Val;
+        double landSWIR175Val;
+        double landCloudProbUpperThres;
+        double waterCloudProbUpperThres;
+    };
         
 }}
 
@@ -746,6 +746,309 @@ namespace rsgis{namespace calib{
     }
     
     
+    RSGISCalcDEMHorizons::RSGISCalcDEMHorizons(GDALDataset *demDS, unsigned int band, double noDataVal, unsigned int numThreads)
+    {
+        if((band == 0) | (band > ((unsigned int)demDS->GetRasterCount())))
+        {
+            throw rsgis::img::RSGISImageCalcException("Specified image band is not within the image.");
+        }
+        
+        this->noDataVal = noDataVal;
+        this->numThreads = rsgis::getNumProcessingThreads(numThreads);
+        this->width = demDS->GetRasterXSize();
+        this->height = demDS->GetRasterYSize();
+        
+        double *transformation = new double[6];
+        demDS->GetGeoTransform(transformation);
+        this->ewRes = fabs(transformation[1]);
+        this->nsRes = fabs(transformation[5]);
+        delete[] transformation;
+        
+        this->dem.resize(((size_t)this->width) * this->height);
+        if(demDS->GetRasterBand(band)->RasterIO(GF_Read, 0, 0, this->width, this->height, this->dem.data(), this->width, this->height, GDT_Float32, 0, 0) != CE_None)
+        {
+            throw rsgis::img::RSGISImageCalcException("Could not read the DEM.");
+        }
+    }
+    
+    void RSGISCalcDEMHorizons::calcShadowMask(GDALDataset *outDS, float sunZenith, float sunAzimuth)
+    {
+        const double degreesToRadians = M_PI / 180.0;
+        double sunZenRad = sunZenith * degreesToRadians;
+        double sunAzRad = sunAzimuth * degreesToRadians;
+        // Rise of the ray to the sun per unit horizontal distance.
+        double tanSunElev = tan((90.0 - sunZenith) * degreesToRadians);
+        
+        std::vector<unsigned char> shadowMask(this->dem.size(), 0);
+        
+        // Pixels facing away from the sun.
+        rsgis::parallelForRange(0, this->height, this->numThreads, 16, [&](size_t rowStart, size_t rowEnd, unsigned int threadIdx)
+        {
+            for(size_t y = rowStart; y < rowEnd; ++y)
+            {
+                for(long x = 0; x < this->width; ++x)
+                {
+                    size_t idx = (y * this->width) + x;
+                    if(!this->isNoData(this->dem[idx]) && this->isFacingAwayFromSun(x, y, sunZenRad, sunAzRad))
+                    {
+                        shadowMask[idx] = 1;
+                    }
+                }
+            }
+        });
+        
+        // Cast shadow, sweeping each line from the sun side keeping the maximum of the elevation 
+        // less the height of the ray to the sun (relative to the start of the line).
+        RSGISDEMSweepLines lines;
+        this->initSweepLines(sunAzimuth, &lines);
+        std::vector< std::vector<size_t> > threadPxls(this->numThreads);
+        rsgis::parallelForRange(0, (lines.maxLine - lines.minLine) + 1, this->numThreads, 64, [&](size_t lineStart, size_t lineEnd, unsigned int threadIdx)
+        {
+            std::vector<size_t> &pxls = threadPxls.at(threadIdx);
+            for(size_t l = lineStart; l < lineEnd; ++l)
+            {
+                this->getSweepLinePxls(&lines, lines.minLine + ((long)l), &pxls);
+                double maxRayElev = -std::numeric_limits<double>::infinity();
+                for(std::vector<size_t>::iterator iterPxl = pxls.begin(); iterPxl != pxls.end(); ++iterPxl)
+                {
+                    float elev = this->dem[*iterPxl];
+                    if(this->isNoData(elev))
+                    {
+                        continue;
+                    }
+                    long majorPos = lines.xMajor?((*iterPxl) % this->width):((*iterPxl) / this->width);
+                    double dist = majorPos * lines.majorDir * lines.stepDist;
+                    double rayElev = elev - (dist * tanSunElev);
+                    if(maxRayElev > rayElev)
+                    {
+                        shadowMask[*iterPxl] = 1;
+                    }
+                    else
+                    {
+                        maxRayElev = rayElev;
+                    }
+                }
+            }
+        });
+        
+        if(outDS->GetRasterBand(1)->RasterIO(GF_Write, 0, 0, this->width, this->height, shadowMask.data(), this->width, this->height, GDT_Byte, 0, 0) != CE_None)
+        {
+            throw rsgis::img::RSGISImageCalcException("Could not write the shadow mask.");
+        }
+    }
+    
+    void RSGISCalcDEMHorizons::calcSkyViewFactor(GDALDataset *outDS, unsigned int numDirections)
+    {
+        if(numDirections == 0)
+        {
+            throw rsgis::img::RSGISImageCalcException("The number of directions must be greater than zero.");
+        }
+        
+        std::vector<float> skyView(this->dem.size(), 0);
+        std::vector< std::vector<size_t> > threadPxls(this->numThreads);
+        std::vector< std::vector< std::pair<double, double> > > threadHulls(this->numThreads);
+        
+        std::cout << "Started " << std::flush;
+        for(unsigned int d = 0; d < numDirections; ++d)
+        {
+            std::cout << "." << std::flush;
+            RSGISDEMSweepLines lines;
+            this->initSweepLines((360.0 * d) / numDirections, &lines);
+            // Each pixel is on one line so the lines can be processed in parallel.
+            rsgis::parallelForRange(0, (lines.maxLine - lines.minLine) + 1, this->numThreads, 64, [&](size_t lineStart, size_t lineEnd, unsigned int threadIdx)
+            {
+                std::vector<size_t> &pxls = threadPxls.at(threadIdx);
+                // Upper convex hull of the (distance, elevation) profile beyond the current pixel.
+                std::vector< std::pair<double, double> > &hull = threadHulls.at(threadIdx);
+                for(size_t l = lineStart; l < lineEnd; ++l)
+                {
+                    this->getSweepLinePxls(&lines, lines.minLine + ((long)l), &pxls);
+                    hull.clear();
+                    for(std::vector<size_t>::iterator iterPxl = pxls.begin(); iterPxl != pxls.end(); ++iterPxl)
+                    {
+                        float elev = this->dem[*iterPxl];
+                        if(this->isNoData(elev))
+                        {
+                            continue;
+                        }
+                        long majorPos = lines.xMajor?((*iterPxl) % this->width):((*iterPxl) / this->width);
+                        double dist = majorPos * lines.majorDir * lines.stepDist;
+                        
+                        while(hull.size() >= 2)
+                        {
+                            std::pair<double, double> &top = hull.at(hull.size()-1);
+                            std::pair<double, double> &second = hull.at(hull.size()-2);
+                            if(((top.second - elev)/(top.first - dist)) <= ((second.second - elev)/(second.first - dist)))
+                            {
+                                hull.pop_back();
+                            }
+                            else
+                            {
+                                break;
+                            }
+                        }
+                        
+                        double cosSqHorizon = 1.0;
+                        if(!hull.empty())
+                        {
+                            double tanHorizon = (hull.back().second - elev)/(hull.back().first - dist);
+                            if(tanHorizon > 0)
+                            {
+                                cosSqHorizon = 1.0/(1.0 + (tanHorizon * tanHorizon));
+                            }
+                        }
+                        skyView[*iterPxl] += cosSqHorizon;
+                        hull.push_back(std::pair<double, double>(dist, elev));
+                    }
+                }
+            });
+        }
+        std::cout << " Complete.\n";
+        
+        for(size_t i = 0; i < skyView.size(); ++i)
+        {
+            if(this->isNoData(this->dem[i]))
+            {
+                skyView[i] = 0;
+            }
+            else
+            {
+                skyView[i] = skyView[i] / numDirections;
+            }
+        }
+        
+        if(outDS->GetRasterBand(1)->RasterIO(GF_Write, 0, 0, this->width, this->height, skyView.data(), this->width, this->height, GDT_Float32, 0, 0) != CE_None)
+        {
+            throw rsgis::img::RSGISImageCalcException("Could not write the sky view factor.");
+        }
+    }
+    
+    void RSGISCalcDEMHorizons::initSweepLines(double azimuth, RSGISDEMSweepLines *lines)
+    {
+        const double degreesToRadians = M_PI / 180.0;
+        // Pixels per unit distance in the direction of the azimuth (rows increase to the south).
+        double dx = sin(azimuth * degreesToRadians) / this->ewRes;
+        double dy = -cos(azimuth * degreesToRadians) / this->nsRes;
+        
+        long majorSize = this->width;
+        long minorSize = this->height;
+        if(fabs(dx) >= fabs(dy))
+        {
+            lines->xMajor = true;
+            lines->slope = dy / dx;
+            lines->majorDir = (dx > 0)?1:-1;
+            lines->stepDist = 1.0 / fabs(dx);
+        }
+        else
+        {
+            lines->xMajor = false;
+            lines->slope = dx / dy;
+            lines->majorDir = (dy > 0)?1:-1;
+            lines->stepDist = 1.0 / fabs(dy);
+            majorSize = this->height;
+            minorSize = this->width;
+        }
+        
+        // Line l contains the pixels with minor = floor(l + (major * slope) + 0.5).
+        double maxOffset = (majorSize - 1) * lines->slope;
+        lines->minLine = floor(-std::max(0.0, maxOffset)) - 1;
+        lines->maxLine = ceil((minorSize - 1) - std::min(0.0, maxOffset)) + 1;
+    }
+    
+    void RSGISCalcDEMHorizons::getSweepLinePxls(RSGISDEMSweepLines *lines, long line, std::vector<size_t> *pxls)
+    {
+        // Pixels are ordered from the end of the line in the direction of the azimuth.
+        pxls->clear();
+        long majorSize = lines->xMajor?this->width:this->height;
+        long minorSize = lines->xMajor?this->height:this->width;
+        long majorStart = (lines->majorDir > 0)?(majorSize - 1):0;
+        for(long i = 0; i < majorSize; ++i)
+        {
+            long major = majorStart - (i * lines->majorDir);
+            long minor = floor(line + (major * lines->slope) + 0.5);
+            if((minor >= 0) && (minor < minorSize))
+            {
+                if(lines->xMajor)
+                {
+                    pxls->push_back((((size_t)minor) * this->width) + major);
+                }
+                else
+                {
+                    pxls->push_back((((size_t)major) * this->width) + minor);
+                }
+            }
+        }
+    }
+    
+    bool RSGISCalcDEMHorizons::isFacingAwayFromSun(long x, long y, double sunZenRad, double sunAzRad)
+    {
+        // 3x3 window (edges replicated), no data values replaced with the mean (as RSGISCalcShadowBinaryMask).
+        double win[3][3];
+        double sumVals = 0.0;
+        int nVals = 0;
+        bool hasNoDataVal = false;
+        for(int i = 0; i < 3; ++i)
+        {
+            long wy = std::min(std::max(y + i - 1, 0L), this->height - 1);
+            for(int j = 0; j < 3; ++j)
+            {
+                long wx = std::min(std::max(x + j - 1, 0L), this->width - 1);
+                win[i][j] = this->dem[(((size_t)wy) * this->width) + wx];
+                if(this->isNoData(win[i][j]))
+                {
+                    hasNoDataVal = true;
+                }
+                else
+                {
+                    sumVals += win[i][j];
+                    ++nVals;
+                }
+            }
+        }
+        if(nVals <= 1)
+        {
+            // Call it flat ground.
+            return false;
+        }
+        if(hasNoDataVal)
+        {
+            double meanVal = sumVals / nVals;
+            for(int i = 0; i < 3; ++i)
+            {
+                for(int j = 0; j < 3; ++j)
+                {
+                    if(this->isNoData(win[i][j]))
+                    {
+                        win[i][j] = meanVal;
+                    }
+                }
+            }
+        }
+        
+        double dxSlope = ((win[0][0] + win[1][0] + win[1][0] + win[2][0]) - (win[0][2] + win[1][2] + win[1][2] + win[2][2]))/this->ewRes;
+        double dySlope = ((win[2][0] + win[2][1] + win[2][1] + win[2][2]) - (win[0][0] + win[0][1] + win[0][1] + win[0][2]))/this->nsRes;
+        if((dxSlope == 0) && (dySlope == 0))
+        {
+            // Flat area
+            return false;
+        }
+        double slopeRad = atan(sqrt((dxSlope * dxSlope) + (dySlope * dySlope))/8);
+        double aspect = atan2(dxSlope, dySlope);
+        if(aspect < 0)
+        {
+            aspect += 2 * M_PI;
+        }
+        
+        double ic = (cos(sunZenRad) * cos(slopeRad)) + (sin(sunZenRad) * sin(slopeRad) * cos(sunAzRad - aspect));
+        return (ic < 0);
+    }
+    
+    RSGISCalcDEMHorizons::~RSGISCalcDEMHorizons()
+    {
+        
+    }
+    
+    
     
     
 
@@ -26,6 +26,8 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include <limits>
 #include <math.h>
 
 #include "gdal_priv.h"
@@ -47,6 +49,8 @@
 
 #include "math/RSGISMathsUtils.h"
 
+#include "common/RSGISThreadUtils.h"
+
 #include <boost/math/special_functions/fpclassify.hpp>
 
 #ifndef M_PI
@@ -219,6 +223,51 @@ namespace rsgis{namespace calib{
         rsgis::img::RSGISExtractImagePixelsOnLine *extractPixels;
 	};
     
+    /**
+     * The set of parallel digital lines (one pixel per column or row along the 
+     * major axis) across the DEM for a direction, each pixel is on one line.
+     */
+    struct DllExport RSGISDEMSweepLines
+    {
+        bool xMajor; // Lines step one column at a time (otherwise one row)
+        double slope; // Change in the minor axis per step in the major axis
+        int majorDir; // Direction (+1/-1) along the major axis towards the azimuth
+        double stepDist; // Horizontal distance (map units) of one step along the major axis
+        long minLine;
+        long maxLine;
+    };
+    
+    /**
+     * Calculates cast shadow and the sky view factor from the horizons of a DEM held 
+     * in memory, sweeping along parallel lines in the direction of interest so each 
+     * direction is O(n) rather than tracing a ray from every pixel. The shadow mask 
+     * is the cast shadow (the running maximum of the elevation less the rise of the 
+     * sun ray from the sun side of each line) plus the pixels facing away from the sun.
+     * The horizon angle for the sky view factor is found with a convex hull of the 
+     * profile along each line (Dozier and Frew, 1990), with the sky view factor for 
+     * a horizontal surface being the mean of cos^2(horizon angle) over the directions.
+     */
+    class DllExport RSGISCalcDEMHorizons
+    {
+    public:
+        RSGISCalcDEMHorizons(GDALDataset *demDS, unsigned int band, double noDataVal, unsigned int numThreads=1);
+        void calcShadowMask(GDALDataset *outDS, float sunZenith, float sunAzimuth);
+        void calcSkyViewFactor(GDALDataset *outDS, unsigned int numDirections=16);
+        ~RSGISCalcDEMHorizons();
+    protected:
+        void initSweepLines(double azimuth, RSGISDEMSweepLines *lines);
+        void getSweepLinePxls(RSGISDEMSweepLines *lines, long line, std::vector<size_t> *pxls);
+        bool isFacingAwayFromSun(long x, long y, double sunZenRad, double sunAzRad);
+        inline bool isNoData(float val){return (val == this->noDataVal) || (boost::math::isnan)(val);};
+        std::vector<float> dem;
+        long width;
+        long height;
+        double ewRes;
+        double nsRes;
+        double noDataVal;
+        unsigned int numThreads;
+    };
+    
     class DllExport RSGISCalcRayIncidentAngle : public rsgis::img::RSGISCalcImageValue
 	{
 	public: 
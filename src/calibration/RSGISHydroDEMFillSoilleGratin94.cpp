@@ -27,46 +27,43 @@ namespace rsgis{namespace calib{
     
     RSGISHydroDEMFillSoilleGratin94::RSGISHydroDEMFillSoilleGratin94()
     {
-        
+        this->imgWidth = 0;
+        this->imgHeight = 0;
+        this->noDataVal = 0;
+        this->borderVal = 0;
+        this->imgEdgeOutlets = false;
     }
     
-    void RSGISHydroDEMFillSoilleGratin94::performSoilleGratin94Fill(GDALDataset *inDEMImgDS, GDALDataset *inValidImgDS, GDALDataset *outImgDS, bool calcBorderVal, long borderVal)
+    void RSGISHydroDEMFillSoilleGratin94::performSoilleGratin94Fill(GDALDataset *inDEMImgDS, GDALDataset *inValidImgDS, GDALDataset *outImgDS, bool calcBorderVal, double borderVal, unsigned int tileSize)
     {
         try
         {
             int numBands = inDEMImgDS->GetRasterCount();
             if(numBands != 1)
             {
-                rsgis::img::RSGISImageCalcException("The image to be filled should only have 1 image band.");
+                throw rsgis::img::RSGISImageCalcException("The image to be filled should only have 1 image band.");
             }
             
-            
-            GDALDataset **datasets = new GDALDataset*[3];
-            datasets[0] = inDEMImgDS;
-            datasets[1] = inValidImgDS;
-            datasets[2] = outImgDS;
-            
-            rsgis::img::RSGISImageUtils imgUtils;
-            if(!imgUtils.doImageSpatAndExtMatch(datasets, 3))
+            this->imgWidth = inDEMImgDS->GetRasterXSize();
+            this->imgHeight = inDEMImgDS->GetRasterYSize();
+            if((inValidImgDS->GetRasterXSize() != this->imgWidth) | (inValidImgDS->GetRasterYSize() != this->imgHeight) | (outImgDS->GetRasterXSize() != this->imgWidth) | (outImgDS->GetRasterYSize() != this->imgHeight))
             {
-                rsgis::img::RSGISImageCalcException("The images provided do not all have the same size and/or spaital header. The input image (e.g., DEM) and valid area image must be excatly the same.");
+                throw rsgis::img::RSGISImageCalcException("The images provided do not all have the same size. The input image (e.g., DEM) and valid area image must be excatly the same.");
             }
-            delete[] datasets;
-            
-            rsgis::img::ImageStats *stats = new rsgis::img::ImageStats();
             
             int useNoData = false;
-            double noDataVal = inDEMImgDS->GetRasterBand(1)->GetNoDataValue(&useNoData);
+            this->noDataVal = inDEMImgDS->GetRasterBand(1)->GetNoDataValue(&useNoData);
             
             if(useNoData)
             {
-                std::cout << "Fill layer has a no data value of " << noDataVal << std::endl;
+                std::cout << "Fill layer has a no data value of " << this->noDataVal << std::endl;
             }
             
             if(calcBorderVal)
             {
+                rsgis::img::ImageStats *stats = new rsgis::img::ImageStats();
                 rsgis::img::RSGISImageStatistics imgStats;
-                imgStats.calcImageStatisticsMask(inDEMImgDS, inValidImgDS, 1, &stats, &noDataVal, useNoData, 1, true);
+                imgStats.calcImageStatisticsMask(inDEMImgDS, inValidImgDS, 1, &stats, &this->noDataVal, useNoData, 1, true);
                 
                 if((stats->mean - stats->stddev) > stats->min)
                 {
@@ -76,97 +73,24 @@ namespace rsgis{namespace calib{
                 {
                     borderVal = floor((stats->mean)+0.5);
                 }
+                delete stats;
                 std::cout << "Calculated Border Value is " << borderVal << std::endl;
             }
-            else
-            {
-                rsgis::img::RSGISImageStatistics imgStats;
-                imgStats.calcImageStatisticsMask(inDEMImgDS, inValidImgDS, 1, &stats, &noDataVal, useNoData, 1, false);
-            }
-            
-            minVal = (long)stats->min;
-            maxVal = (long)stats->max;
-            delete stats;
-           
-            numLevels = (maxVal - minVal)+1;
-            
-            std::cout << "Range of Values [" << minVal << ", " << maxVal << "] Needs " << numLevels << " Levels." << std::endl;
+            this->borderVal = borderVal;
             
             if(!useNoData)
             {
-                noDataVal = 0.0;
-            }
-            
-            // Create the hierarchical queue.
-            pxQ = new std::list<Q2DPxl>*[numLevels];
-            for(long n = 0; n < numLevels; ++n)
-            {
-                pxQ[n] = new std::list<Q2DPxl>();
-            }
-            
-            
-            // Initialise the output image.
-            std::cout << "Initalise the Output Image and find boundary pixels.\n";
-            RSGISInitOutputImageSoilleGratin94 initOutImg = RSGISInitOutputImageSoilleGratin94(noDataVal, maxVal, borderVal, pxQ[0]);
-            rsgis::img::RSGISCalcImage calcImage = rsgis::img::RSGISCalcImage(&initOutImg);
-            calcImage.calcImageWindowData(&inValidImgDS, 1, outImgDS, 3, true);
-            
-            if(pxQ[0]->size() == 0)
-            {
-                this->getImagesEdgesToInitFill(outImgDS->GetRasterBand(1), borderVal, pxQ[0]);
-                //throw rsgis::img::RSGISImageCalcException("The were no edge pixels with the valid mask.");
+                this->noDataVal = 0.0;
             }
             
-            Q2DPxl pxl;
-            long hcrt = minVal;
-            long imgVal = 0;
-            long img2Val = 0;
-            int feedback = numLevels/10.0;
-            int feedbackCounter = 0;
-            std::cout << "Perform Fill:\n";
-            std::cout << "Started ." << std::flush;
-            for(long n = 0; n < numLevels; ++n)
+            if(tileSize == 0)
             {
-                if((feedback != 0) && ((n % feedback) == 0))
-                {
-                    std::cout << "." << feedbackCounter << "." << std::flush;
-                    feedbackCounter = feedbackCounter + 10;
-                }
-
-                while(!this->qEmpty(hcrt))
-                {
-                    pxl = this->qPopFront(hcrt);
-
-                    // Get Neightbours
-                    std::list<Q2DPxl> *nPxls = this->getNeighbours(pxl, inValidImgDS->GetRasterBand(1));
-                    for(std::list<Q2DPxl>::iterator iterNPxls = nPxls->begin(); iterNPxls != nPxls->end(); ++iterNPxls)
-                    {
-                        imgVal = this->getPxlVal((*iterNPxls), inDEMImgDS->GetRasterBand(1));
-                        img2Val = this->getPxlVal((*iterNPxls), outImgDS->GetRasterBand(1));
-
-                        if(img2Val == maxVal)
-                        {
-                            img2Val = this->rtnMax(hcrt, imgVal);
-                            this->setPxlVal((*iterNPxls), img2Val, outImgDS->GetRasterBand(1));
-                            if(img2Val < maxVal)
-                            {
-                                this->qPushBack(img2Val, (*iterNPxls));
-                            }
-                        }
-                    }
-                    delete nPxls;
-                    
-                }
-                
-                ++hcrt;
+                this->fillInMemory(inDEMImgDS->GetRasterBand(1), inValidImgDS->GetRasterBand(1), outImgDS->GetRasterBand(1));
             }
-            std::cout << ". Complete.\n";
-            
-            for(long n = 0; n < numLevels; ++n)
+            else
             {
-                delete pxQ[n];
+                this->fillTiled(inDEMImgDS->GetRasterBand(1), inValidImgDS->GetRasterBand(1), outImgDS->GetRasterBand(1), tileSize);
             }
-            delete[] pxQ;            
         }
         catch (rsgis::img::RSGISImageCalcException &e)
         {
@@ -182,224 +106,532 @@ namespace rsgis{namespace calib{
         }
     }
     
-    bool RSGISHydroDEMFillSoilleGratin94::qEmpty(long hcrt)
+    void RSGISHydroDEMFillSoilleGratin94::fillInMemory(GDALRasterBand *demBand, GDALRasterBand *validBand, GDALRasterBand *outBand)
     {
-        long qIdx = hcrt - this->minVal;
-        bool empty = pxQ[qIdx]->empty();
-        return empty;
-    }
-    
-    Q2DPxl RSGISHydroDEMFillSoilleGratin94::qPopFront(long hcrt)
-    {
-        long qIdx = hcrt - this->minVal;
-        Q2DPxl pxl = pxQ[qIdx]->front();
-        pxQ[qIdx]->pop_front();
-        return pxl;
-    }
-    
-    void RSGISHydroDEMFillSoilleGratin94::qPushBack(long hcrt, Q2DPxl pxl)
-    {
-        long qIdx = hcrt - this->minVal;
-        pxQ[qIdx]->push_back(pxl);
+        RSGISFillDEMTile tile;
+        tile.xOff = 0;
+        tile.yOff = 0;
+        tile.xSize = this->imgWidth;
+        tile.ySize = this->imgHeight;
+        tile.labelOffset = 0;
+        
+        std::cout << "Reading the image into memory.\n";
+        this->readTile(demBand, validBand, &tile);
+        this->imgEdgeOutlets = !this->tileHasBorderPxls(&tile);
+        if(this->imgEdgeOutlets)
+        {
+            std::cout << "No pixels border the valid region, using the image edges.\n";
+        }
+        
+        std::cout << "Perform Fill.\n";
+        this->floodTile(&tile, false, NULL);
+        
+        if(outBand->RasterIO(GF_Write, 0, 0, tile.xSize, tile.ySize, tile.out.data(), tile.xSize, tile.ySize, GDT_Float32, 0, 0) != CE_None)
+        {
+            throw rsgis::img::RSGISImageCalcException("Could not write the filled image.");
+        }
     }
     
-    std::list<Q2DPxl>* RSGISHydroDEMFillSoilleGratin94::getNeighbours(Q2DPxl pxl, GDALRasterBand *inValidImg) 
+    void RSGISHydroDEMFillSoilleGratin94::fillTiled(GDALRasterBand *demBand, GDALRasterBand *validBand, GDALRasterBand *outBand, unsigned int tileSize)
     {
-        std::list<Q2DPxl> *nPxls = new std::list<Q2DPxl>();
-        
-        long width = inValidImg->GetXSize();
-        long height = inValidImg->GetYSize();
-        
-        long minXPxl = pxl.x - 1;
-        long maxXPxl = pxl.x + 1;
-        long minYPxl = pxl.y - 1;
-        long maxYPxl = pxl.y + 1;
+        unsigned int nXTiles = ceil(((double)this->imgWidth) / tileSize);
+        unsigned int nYTiles = ceil(((double)this->imgHeight) / tileSize);
+        unsigned long numTiles = ((unsigned long)nXTiles) * nYTiles;
+        unsigned long labelsPerTile = 4 * ((unsigned long)tileSize);
+        unsigned long long numLabels = 2 + (((unsigned long long)numTiles) * labelsPerTile);
+        if(numLabels >= std::numeric_limits<unsigned int>::max())
+        {
+            throw rsgis::img::RSGISImageCalcException("Too many tiles, use a larger tile size.");
+        }
+        std::cout << "Filling using " << nXTiles << " x " << nYTiles << " tiles.\n";
         
-        if(minXPxl < 0)
+        std::vector<RSGISFillDEMTile> tiles(numTiles);
+        for(unsigned int r = 0; r < nYTiles; ++r)
         {
-            minXPxl = 0;
+            for(unsigned int c = 0; c < nXTiles; ++c)
+            {
+                RSGISFillDEMTile &tile = tiles.at((r * nXTiles) + c);
+                tile.xOff = ((long)c) * tileSize;
+                tile.yOff = ((long)r) * tileSize;
+                tile.xSize = std::min(((long)tileSize), this->imgWidth - tile.xOff);
+                tile.ySize = std::min(((long)tileSize), this->imgHeight - tile.yOff);
+                tile.labelOffset = 2 + (((r * nXTiles) + c) * labelsPerTile);
+            }
         }
-        if(minYPxl < 0)
+        
+        // Find whether any pixels border the valid region, otherwise the image edges are the outlets.
+        this->imgEdgeOutlets = true;
+        for(unsigned long t = 0; t < numTiles; ++t)
         {
-            minYPxl = 0;
+            this->readTile(demBand, validBand, &tiles.at(t));
+            bool found = this->tileHasBorderPxls(&tiles.at(t));
+            tiles.at(t).dem = std::vector<float>();
+            tiles.at(t).valid = std::vector<unsigned char>();
+            if(found)
+            {
+                this->imgEdgeOutlets = false;
+                break;
+            }
         }
-        if(maxXPxl >= width)
+        if(this->imgEdgeOutlets)
         {
-            maxXPxl = width-1;
+            std::cout << "No pixels border the valid region, using the image edges.\n";
         }
-        if(maxYPxl >= height)
+        
+        // Flood each tile from its edges, recording the spill elevations between the 
+        // regions and the labels and elevations of the pixels around the tile edges.
+        std::unordered_map<unsigned long long, float> spillEdges;
+        std::vector< std::vector<unsigned int> > edgeLabels(numTiles);
+        std::vector< std::vector<float> > edgeElevs(numTiles);
+        int feedback = numTiles/10;
+        int feedbackCounter = 0;
+        std::cout << "Flood tiles: Started " << std::flush;
+        for(unsigned long t = 0; t < numTiles; ++t)
         {
-            maxYPxl = height-1;
+            if((feedback == 0) || ((t % feedback) == 0))
+            {
+                std::cout << "." << feedbackCounter << "." << std::flush;
+                feedbackCounter = feedbackCounter + 10;
+            }
+            RSGISFillDEMTile &tile = tiles.at(t);
+            this->readTile(demBand, validBand, &tile);
+            this->floodTile(&tile, true, &spillEdges);
+            
+            unsigned int numPerimPxls = (2 * tile.xSize) + (2 * tile.ySize);
+            edgeLabels.at(t).resize(numPerimPxls);
+            edgeElevs.at(t).resize(numPerimPxls);
+            // Stored as top row, bottom row, left column, right column.
+            for(unsigned int x = 0; x < tile.xSize; ++x)
+            {
+                size_t topIdx = x;
+                size_t botIdx = (((size_t)tile.ySize-1) * tile.xSize) + x;
+                edgeLabels.at(t).at(x) = tile.labels.at(topIdx);
+                edgeElevs.at(t).at(x) = tile.out.at(topIdx);
+                edgeLabels.at(t).at(tile.xSize + x) = tile.labels.at(botIdx);
+                edgeElevs.at(t).at(tile.xSize + x) = tile.out.at(botIdx);
+            }
+            for(unsigned int y = 0; y < tile.ySize; ++y)
+            {
+                size_t leftIdx = ((size_t)y) * tile.xSize;
+                size_t rightIdx = leftIdx + tile.xSize - 1;
+                edgeLabels.at(t).at((2 * tile.xSize) + y) = tile.labels.at(leftIdx);
+                edgeElevs.at(t).at((2 * tile.xSize) + y) = tile.out.at(leftIdx);
+                edgeLabels.at(t).at((2 * tile.xSize) + tile.ySize + y) = tile.labels.at(rightIdx);
+                edgeElevs.at(t).at((2 * tile.xSize) + tile.ySize + y) = tile.out.at(rightIdx);
+            }
+            
+            tile.dem = std::vector<float>();
+            tile.valid = std::vector<unsigned char>();
+            tile.out = std::vector<float>();
+            tile.labels = std::vector<unsigned int>();
         }
-
-        int nWidth = (maxXPxl - minXPxl)+1;
-        int nHeight = (maxYPxl - minYPxl)+1;
+        std::cout << " Complete.\n";
         
-        float dataVal = 0;
-        long cPxlX = 0;
-        long cPxlY = minYPxl;
-        for(int i = 0; i < nHeight; ++i)
+        // Spill elevations between the edge pixels of neighbouring tiles (8 connectivity).
+        for(unsigned int r = 0; r < nYTiles; ++r)
         {
-            cPxlX = minXPxl;
-            for(int j = 0; j < nWidth; ++j)
+            for(unsigned int c = 0; c < nXTiles; ++c)
             {
-                if(!((cPxlX == pxl.x) & (cPxlY == pxl.y)))
+                unsigned long tA = (r * nXTiles) + c;
+                RSGISFillDEMTile &tileA = tiles.at(tA);
+                std::vector<unsigned int> &labelsA = edgeLabels.at(tA);
+                std::vector<float> &elevsA = edgeElevs.at(tA);
+                
+                if((c + 1) < nXTiles)
                 {
-                    inValidImg->RasterIO(GF_Read, cPxlX, cPxlY, 1, 1, &dataVal, 1, 1, GDT_Float32, 0, 0);
-
-                    if(dataVal == 1)
+                    // Right column of A with the left column of B.
+                    unsigned long tB = tA + 1;
+                    RSGISFillDEMTile &tileB = tiles.at(tB);
+                    for(int y = 0; y < ((int)tileA.ySize); ++y)
                     {
-                        nPxls->push_back(Q2DPxl(cPxlX, cPxlY));
+                        size_t idxA = (2 * tileA.xSize) + tileA.ySize + y;
+                        for(int dy = -1; dy <= 1; ++dy)
+                        {
+                            if(((y + dy) >= 0) && ((y + dy) < ((int)tileB.ySize)))
+                            {
+                                size_t idxB = (2 * tileB.xSize) + y + dy;
+                                this->addSpillEdge(&spillEdges, labelsA.at(idxA), edgeLabels.at(tB).at(idxB), std::max(elevsA.at(idxA), edgeElevs.at(tB).at(idxB)));
+                            }
+                        }
+                    }
+                }
+                if((r + 1) < nYTiles)
+                {
+                    // Bottom row of A with the top row of B.
+                    unsigned long tB = tA + nXTiles;
+                    RSGISFillDEMTile &tileB = tiles.at(tB);
+                    for(int x = 0; x < ((int)tileA.xSize); ++x)
+                    {
+                        size_t idxA = tileA.xSize + x;
+                        for(int dx = -1; dx <= 1; ++dx)
+                        {
+                            if(((x + dx) >= 0) && ((x + dx) < ((int)tileB.xSize)))
+                            {
+                                size_t idxB = x + dx;
+                                this->addSpillEdge(&spillEdges, labelsA.at(idxA), edgeLabels.at(tB).at(idxB), std::max(elevsA.at(idxA), edgeElevs.at(tB).at(idxB)));
+                            }
+                        }
+                    }
+                    
+                    // Bottom right corner of A with the top left of the tile below right.
+                    if((c + 1) < nXTiles)
+                    {
+                        unsigned long tD = tB + 1;
+                        size_t idxA = tileA.xSize + tileA.xSize - 1;
+                        this->addSpillEdge(&spillEdges, labelsA.at(idxA), edgeLabels.at(tD).at(0), std::max(elevsA.at(idxA), edgeElevs.at(tD).at(0)));
+                    }
+                    // Bottom left corner of A with the top right of the tile below left.
+                    if(c > 0)
+                    {
+                        unsigned long tD = tB - 1;
+                        size_t idxA = tileA.xSize;
+                        size_t idxD = tiles.at(tD).xSize - 1;
+                        this->addSpillEdge(&spillEdges, labelsA.at(idxA), edgeLabels.at(tD).at(idxD), std::max(elevsA.at(idxA), edgeElevs.at(tD).at(idxD)));
                     }
                 }
-                ++cPxlX;
             }
-            ++cPxlY;
         }
+        edgeLabels = std::vector< std::vector<unsigned int> >();
+        edgeElevs = std::vector< std::vector<float> >();
         
-        return nPxls;
-    }
-    
-    long RSGISHydroDEMFillSoilleGratin94::getPxlVal(Q2DPxl pxl, GDALRasterBand *imgData)
-    {
-        float outVal = 0;
-        imgData->RasterIO(GF_Read, pxl.x, pxl.y, 1, 1, &outVal, 1, 1, GDT_Float32, 0, 0);
-        return (long)outVal;
-    }
-    
-    void RSGISHydroDEMFillSoilleGratin94::setPxlVal(Q2DPxl pxl, long val, GDALRasterBand *imgData)
-    {
-        float outVal = val;
-        imgData->RasterIO(GF_Write, pxl.x, pxl.y, 1, 1, &outVal, 1, 1, GDT_Float32, 0, 0);
-    }
-    
-    long RSGISHydroDEMFillSoilleGratin94::rtnMax(long val1, long val2)
-    {
-        long outVal = val1;
-        if(val2 > val1)
+        // Flood the graph of spill elevations from the outlets to find the water level of each region.
+        std::cout << "Flood the graph of " << spillEdges.size() << " spill elevations.\n";
+        std::vector<unsigned int> edgeCounts(numLabels+1, 0);
+        for(std::unordered_map<unsigned long long, float>::iterator iterEdge = spillEdges.begin(); iterEdge != spillEdges.end(); ++iterEdge)
         {
-            outVal = val2;
+            ++edgeCounts.at((iterEdge->first >> 32) + 1);
+            ++edgeCounts.at((iterEdge->first & 0xFFFFFFFF) + 1);
         }
-        return outVal;
-    }
-    
-    void RSGISHydroDEMFillSoilleGratin94::getImagesEdgesToInitFill(GDALRasterBand *imgData, double borderVal, std::list<Q2DPxl> *pxQ)
-    {
-        try
+        for(unsigned long long l = 1; l <= numLabels; ++l)
         {
-            unsigned int xSize = imgData->GetXSize();
-            unsigned int ySize = imgData->GetYSize();
-            
-            //std::cout << "[" << xSize << ", " << ySize << "]\n";
-            
-            for(unsigned int x = 0; x < xSize; ++x)
+            edgeCounts.at(l) += edgeCounts.at(l-1);
+        }
+        std::vector<unsigned int> adjLabels(edgeCounts.at(numLabels));
+        std::vector<float> adjElevs(edgeCounts.at(numLabels));
+        std::vector<unsigned int> adjFill(edgeCounts.begin(), edgeCounts.end()-1);
+        for(std::unordered_map<unsigned long long, float>::iterator iterEdge = spillEdges.begin(); iterEdge != spillEdges.end(); ++iterEdge)
+        {
+            unsigned int label1 = iterEdge->first >> 32;
+            unsigned int label2 = iterEdge->first & 0xFFFFFFFF;
+            adjLabels.at(adjFill.at(label1)) = label2;
+            adjElevs.at(adjFill.at(label1)++) = iterEdge->second;
+            adjLabels.at(adjFill.at(label2)) = label1;
+            adjElevs.at(adjFill.at(label2)++) = iterEdge->second;
+        }
+        spillEdges.clear();
+        adjFill = std::vector<unsigned int>();
+        
+        std::vector<float> waterLevels(numLabels, std::numeric_limits<float>::infinity());
+        std::priority_queue<RSGISFillDEMPxl, std::vector<RSGISFillDEMPxl>, std::greater<RSGISFillDEMPxl> > graphQ;
+        waterLevels.at(outletLabel) = -std::numeric_limits<float>::infinity();
+        graphQ.push(RSGISFillDEMPxl(waterLevels.at(outletLabel), outletLabel));
+        while(!graphQ.empty())
+        {
+            RSGISFillDEMPxl node = graphQ.top();
+            graphQ.pop();
+            if(node.elev > waterLevels.at(node.idx))
             {
-                Q2DPxl q2Pxl = Q2DPxl(x, 0);
-                this->setPxlVal(q2Pxl, borderVal, imgData);
-                pxQ->push_back(q2Pxl);
+                continue;
             }
-            
-            for(unsigned int x = 0; x < xSize; ++x)
+            for(unsigned int e = edgeCounts.at(node.idx); e < edgeCounts.at(node.idx+1); ++e)
             {
-                Q2DPxl q2Pxl = Q2DPxl(x, (ySize-1));
-                this->setPxlVal(q2Pxl, borderVal, imgData);
-                pxQ->push_back(q2Pxl);
+                float level = std::max(node.elev, adjElevs.at(e));
+                if(level < waterLevels.at(adjLabels.at(e)))
+                {
+                    waterLevels.at(adjLabels.at(e)) = level;
+                    graphQ.push(RSGISFillDEMPxl(level, adjLabels.at(e)));
+                }
             }
+        }
+        edgeCounts = std::vector<unsigned int>();
+        adjLabels = std::vector<unsigned int>();
+        adjElevs = std::vector<float>();
+        
+        // Flood each tile again and raise each region to its water level.
+        feedbackCounter = 0;
+        std::cout << "Fill tiles: Started " << std::flush;
+        for(unsigned long t = 0; t < numTiles; ++t)
+        {
+            if((feedback == 0) || ((t % feedback) == 0))
+            {
+                std::cout << "." << feedbackCounter << "." << std::flush;
+                feedbackCounter = feedbackCounter + 10;
+            }
+            RSGISFillDEMTile &tile = tiles.at(t);
+            this->readTile(demBand, validBand, &tile);
+            this->floodTile(&tile, true, NULL);
             
-            for(unsigned int y = 0; y < ySize; ++y)
+            size_t numTilePxls = ((size_t)tile.xSize) * tile.ySize;
+            for(size_t i = 0; i < numTilePxls; ++i)
             {
-                Q2DPxl q2Pxl = Q2DPxl(0, y);
-                this->setPxlVal(q2Pxl, borderVal, imgData);
-                pxQ->push_back(q2Pxl);
+                unsigned int label = tile.labels[i];
+                // Labels not connected to an outlet have an infinite level and are left unchanged.
+                if((label > outletLabel) && (waterLevels[label] != std::numeric_limits<float>::infinity()) && (tile.out[i] < waterLevels[label]))
+                {
+                    tile.out[i] = waterLevels[label];
+                }
             }
             
-            for(unsigned int y = 0; y < ySize; ++y)
+            if(outBand->RasterIO(GF_Write, tile.xOff, tile.yOff, tile.xSize, tile.ySize, tile.out.data(), tile.xSize, tile.ySize, GDT_Float32, 0, 0) != CE_None)
             {
-                Q2DPxl q2Pxl = Q2DPxl((xSize-1), y);
-                this->setPxlVal(q2Pxl, borderVal, imgData);
-                pxQ->push_back(q2Pxl);
+                throw rsgis::img::RSGISImageCalcException("Could not write the filled image tile.");
             }
-
+            
+            tile.dem = std::vector<float>();
+            tile.valid = std::vector<unsigned char>();
+            tile.out = std::vector<float>();
+            tile.labels = std::vector<unsigned int>();
         }
-        catch (rsgis::img::RSGISImageCalcException &e)
+        std::cout << " Complete.\n";
+    }
+    
+    void RSGISHydroDEMFillSoilleGratin94::readTile(GDALRasterBand *demBand, GDALRasterBand *validBand, RSGISFillDEMTile *tile)
+    {
+        // The DEM and valid mask are read with a 1 pixel border (outside of the image is not valid).
+        unsigned int bufWidth = tile->xSize + 2;
+        unsigned int bufHeight = tile->ySize + 2;
+        size_t numBufPxls = ((size_t)bufWidth) * bufHeight;
+        tile->dem.assign(numBufPxls, 0);
+        tile->valid.assign(numBufPxls, 0);
+        
+        long readXStart = std::max(tile->xOff - 1, 0L);
+        long readYStart = std::max(tile->yOff - 1, 0L);
+        long readXEnd = std::min(tile->xOff + ((long)tile->xSize) + 1, this->imgWidth);
+        long readYEnd = std::min(tile->yOff + ((long)tile->ySize) + 1, this->imgHeight);
+        int readWidth = readXEnd - readXStart;
+        int readHeight = readYEnd - readYStart;
+        size_t bufOff = (((size_t)(readYStart - (tile->yOff - 1))) * bufWidth) + (readXStart - (tile->xOff - 1));
+        
+        std::vector<float> validVals(numBufPxls, 0);
+        if(demBand->RasterIO(GF_Read, readXStart, readYStart, readWidth, readHeight, tile->dem.data() + bufOff, readWidth, readHeight, GDT_Float32, 0, sizeof(float)*bufWidth) != CE_None)
         {
-            throw e;
+            throw rsgis::img::RSGISImageCalcException("Could not read the input image.");
         }
-        catch (rsgis::RSGISException &e)
+        if(validBand->RasterIO(GF_Read, readXStart, readYStart, readWidth, readHeight, validVals.data() + bufOff, readWidth, readHeight, GDT_Float32, 0, sizeof(float)*bufWidth) != CE_None)
         {
-            throw rsgis::img::RSGISImageCalcException(e.what());
+            throw rsgis::img::RSGISImageCalcException("Could not read the valid mask image.");
         }
-        catch (std::exception &e)
+        
+        for(size_t i = 0; i < numBufPxls; ++i)
         {
-            throw rsgis::img::RSGISImageCalcException(e.what());
+            // Pixels with a NaN elevation are not part of the valid region.
+            if((validVals[i] == 1) && !((boost::math::isnan)(tile->dem[i])))
+            {
+                tile->valid[i] = 1;
+            }
         }
     }
     
-    RSGISHydroDEMFillSoilleGratin94::~RSGISHydroDEMFillSoilleGratin94()
+    bool RSGISHydroDEMFillSoilleGratin94::tileHasBorderPxls(RSGISFillDEMTile *tile)
     {
-        
-    }
-    
-
-    RSGISInitOutputImageSoilleGratin94::RSGISInitOutputImageSoilleGratin94(double noDataVal, double dataVal, double borderVal, std::list<Q2DPxl> *pxQ): rsgis::img::RSGISCalcImageValue(1)
-    {
-        this->noDataVal = noDataVal;
-        this->dataVal = dataVal;
-        this->borderVal = borderVal;
-        this->pxQ = pxQ;
+        unsigned int bufWidth = tile->xSize + 2;
+        for(unsigned int y = 1; y <= tile->ySize; ++y)
+        {
+            for(unsigned int x = 1; x <= tile->xSize; ++x)
+            {
+                size_t idx = (((size_t)y) * bufWidth) + x;
+                if(tile->valid[idx] == 0)
+                {
+                    for(int dy = -1; dy <= 1; ++dy)
+                    {
+                        for(int dx = -1; dx <= 1; ++dx)
+                        {
+                            if(tile->valid[idx + (dy * ((long)bufWidth)) + dx] == 1)
+                            {
+                                return true;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        return false;
     }
     
-    void RSGISInitOutputImageSoilleGratin94::calcImageValue(float ***dataBlock, int numBands, int winSize, double *output, geos::geom::Envelope extent) 
+    void RSGISHydroDEMFillSoilleGratin94::floodTile(RSGISFillDEMTile *tile, bool labelPerimeter, std::unordered_map<unsigned long long, float> *spillEdges)
     {
-        if(winSize != 3)
-        {
-            throw rsgis::img::RSGISImageCalcException("Window Size must be 3.");
-        }
+        /*
+         * Priority flood with the pit queue of Barnes et al. (2014): pixels filled to the 
+         * level of the current pixel are processed in FIFO order without the priority queue. 
+         * If labelPerimeter is true the pixels around the tile edge are seeds at their own
+         * elevation, each with its own label, and where the regions flooded from two seeds 
+         * meet the spill elevation is recorded.
+         */
+        unsigned int xSize = tile->xSize;
+        unsigned int ySize = tile->ySize;
+        unsigned int bufWidth = xSize + 2;
+        size_t numPxls = ((size_t)xSize) * ySize;
+        tile->out.assign(numPxls, this->noDataVal);
+        tile->labels.assign(labelPerimeter?numPxls:0, 0);
+        std::vector<unsigned char> closed(numPxls, 0);
         
-        int hWinSize = (winSize-1)/2;
+        std::priority_queue<RSGISFillDEMPxl, std::vector<RSGISFillDEMPxl>, std::greater<RSGISFillDEMPxl> > openQ;
+        std::queue<size_t> pitQ;
         
-        if(dataBlock[0][hWinSize][hWinSize] == 1)
-        {
-            output[0] = dataVal;
-        }
-        else
+        const float *dem = tile->dem.data();
+        const unsigned char *valid = tile->valid.data();
+        float *out = tile->out.data();
+        unsigned int *labels = tile->labels.data();
+        
+        // Find the seeds.
+        for(unsigned int y = 0; y < ySize; ++y)
         {
-            bool boundary = false;
-            for(int i = 0; i < winSize; ++i)
+            for(unsigned int x = 0; x < xSize; ++x)
             {
-                for(int j = 0; j < winSize; ++j)
+                size_t idx = (((size_t)y) * xSize) + x;
+                size_t bufIdx = (((size_t)y+1) * bufWidth) + x + 1;
+                if(valid[bufIdx] == 1)
                 {
-                    if(dataBlock[0][i][j] == 1)
+                    long imgX = tile->xOff + x;
+                    long imgY = tile->yOff + y;
+                    if(this->imgEdgeOutlets && ((imgX == 0) | (imgY == 0) | (imgX == (this->imgWidth-1)) | (imgY == (this->imgHeight-1))))
                     {
-                        boundary = true;
-                        break;
+                        out[idx] = std::max(dem[bufIdx], ((float)this->borderVal));
+                        if(labelPerimeter)
+                        {
+                            labels[idx] = outletLabel;
+                        }
+                        closed[idx] = 1;
+                        openQ.push(RSGISFillDEMPxl(out[idx], idx));
+                    }
+                    else if(labelPerimeter && ((x == 0) | (y == 0) | (x == (xSize-1)) | (y == (ySize-1))))
+                    {
+                        out[idx] = dem[bufIdx];
+                        labels[idx] = tile->labelOffset + this->getPerimeterIdx(x, y, xSize, ySize);
+                        closed[idx] = 1;
+                        openQ.push(RSGISFillDEMPxl(out[idx], idx));
                     }
                 }
-                if(boundary)
+                else
                 {
-                    break;
+                    closed[idx] = 1;
+                    bool border = false;
+                    for(int dy = -1; (dy <= 1) && !border; ++dy)
+                    {
+                        for(int dx = -1; dx <= 1; ++dx)
+                        {
+                            if(valid[bufIdx + (dy * ((long)bufWidth)) + dx] == 1)
+                            {
+                                border = true;
+                                break;
+                            }
+                        }
+                    }
+                    if(border)
+                    {
+                        out[idx] = this->borderVal;
+                        if(labelPerimeter)
+                        {
+                            labels[idx] = outletLabel;
+                        }
+                        openQ.push(RSGISFillDEMPxl(out[idx], idx));
+                    }
                 }
             }
-            
-            if(boundary)
+        }
+        
+        size_t cIdx = 0;
+        while((!pitQ.empty()) | (!openQ.empty()))
+        {
+            if(!pitQ.empty())
             {
-                output[0] = borderVal;
-                this->pxQ->push_back(Q2DPxl(extent.getMaxX(), extent.getMaxY()));
+                cIdx = pitQ.front();
+                pitQ.pop();
             }
             else
             {
-                output[0] = noDataVal;
+                cIdx = openQ.top().idx;
+                openQ.pop();
+            }
+            
+            float cElev = out[cIdx];
+            long cX = cIdx % xSize;
+            long cY = cIdx / xSize;
+            for(long nY = std::max(cY-1, 0L); nY <= std::min(cY+1, ((long)ySize)-1); ++nY)
+            {
+                for(long nX = std::max(cX-1, 0L); nX <= std::min(cX+1, ((long)xSize)-1); ++nX)
+                {
+                    size_t nIdx = (((size_t)nY) * xSize) + nX;
+                    if(nIdx == cIdx)
+                    {
+                        continue;
+                    }
+                    if(!closed[nIdx])
+                    {
+                        // Not closed so must be a valid pixel.
+                        closed[nIdx] = 1;
+                        if(labelPerimeter)
+                        {
+                            labels[nIdx] = labels[cIdx];
+                        }
+                        float nElev = dem[(((size_t)nY+1) * bufWidth) + nX + 1];
+                        if(nElev <= cElev)
+                        {
+                            out[nIdx] = cElev;
+                            pitQ.push(nIdx);
+                        }
+                        else
+                        {
+                            out[nIdx] = nElev;
+                            openQ.push(RSGISFillDEMPxl(nElev, nIdx));
+                        }
+                    }
+                    else if((spillEdges != NULL) && (labels[nIdx] != 0) && (labels[nIdx] != labels[cIdx]))
+                    {
+                        this->addSpillEdge(spillEdges, labels[cIdx], labels[nIdx], std::max(cElev, out[nIdx]));
+                    }
+                }
             }
         }
     }
     
-    RSGISInitOutputImageSoilleGratin94::~RSGISInitOutputImageSoilleGratin94()
+    unsigned int RSGISHydroDEMFillSoilleGratin94::getPerimeterIdx(unsigned int x, unsigned int y, unsigned int xSize, unsigned int ySize)
     {
-        
+        unsigned int idx = 0;
+        if(y == 0)
+        {
+            idx = x;
+        }
+        else if(y == (ySize-1))
+        {
+            idx = xSize + x;
+        }
+        else if(x == 0)
+        {
+            idx = (2 * xSize) + (y - 1);
+        }
+        else
+        {
+            idx = (2 * xSize) + (ySize - 2) + (y - 1);
+        }
+        return idx;
     }
     
+    void RSGISHydroDEMFillSoilleGratin94::addSpillEdge(std::unordered_map<unsigned long long, float> *spillEdges, unsigned int label1, unsigned int label2, float elev)
+    {
+        if((label1 == 0) | (label2 == 0) | (label1 == label2))
+        {
+            return;
+        }
+        if(label1 > label2)
+        {
+            std::swap(label1, label2);
+        }
+        unsigned long long key = (((unsigned long long)label1) << 32) | label2;
+        std::unordered_map<unsigned long long, float>::iterator iterEdge = spillEdges->find(key);
+        if(iterEdge == spillEdges->end())
+        {
+            spillEdges->insert(std::pair<unsigned long long, float>(key, elev));
+        }
+        else if(elev < iterEdge->second)
+        {
+            iterEdge->second = elev;
+        }
+    }
     
+    RSGISHydroDEMFillSoilleGratin94::~RSGISHydroDEMFillSoilleGratin94()
+    {
+        
+    }
     
 }}
-
-
@@ -34,19 +34,19 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include <queue>
+#include <unordered_map>
+#include <limits>
+#include <algorithm>
 #include <math.h>
 
 #include "gdal_priv.h"
 
 #include "img/RSGISImageCalcException.h"
-#include "img/RSGISCalcImageValue.h"
 #include "img/RSGISImageUtils.h"
-#include "img/RSGISExtractImagePixelsInPolygon.h"
 #include "img/RSGISImageStatistics.h"
 
-
-#include "math/RSGISMathsUtils.h"
-
 #include <boost/math/special_functions/fpclassify.hpp>
 
 // mark all exported classes/functions with DllExport to have
@@ -64,66 +64,71 @@
 
 namespace rsgis{namespace calib{
     
-    
-    struct Q2DPxl
+    /** A pixel (index within the tile) and its elevation within the priority queue. */
+    struct RSGISFillDEMPxl
     {
-        Q2DPxl()
+        RSGISFillDEMPxl(float elev, size_t idx)
         {
-            this->x = 0;
-            this->y = 0;
+            this->elev = elev;
+            this->idx = idx;
         };
-        Q2DPxl(long x, long y)
+        float elev;
+        size_t idx;
+        bool operator>(const RSGISFillDEMPxl &pxl) const
         {
-            this->x = x;
-            this->y = y;
+            return this->elev > pxl.elev;
         };
-        long x;
-        long y;
     };
     
+    /** A block of the image being filled. The DEM and valid mask have a 1 pixel border around the tile. */
+    struct RSGISFillDEMTile
+    {
+        long xOff;
+        long yOff;
+        unsigned int xSize;
+        unsigned int ySize;
+        std::vector<float> dem;
+        std::vector<unsigned char> valid;
+        std::vector<float> out;
+        std::vector<unsigned int> labels;
+        unsigned int labelOffset;
+    };
     
+    /**
+     * Fills the local minima within the valid region (valid mask == 1) of the image. The pixels
+     * outside of the valid region which border it are given the border value and are the outlets
+     * from which the image is flooded (if there are none the image edges are used). A priority 
+     * flood (Barnes et al., 2014) is used, which gives the same result as the hierarchical queue 
+     * of Soille and Gratin (1994) but supports floating point values.
+     *
+     * If a tile size is given the image is processed in tiles so it does not need to be held in 
+     * memory, following Barnes (2016) Parallel priority-flood depression filling for trillion 
+     * cell digital elevation models on desktops or clusters. Computers & Geosciences, 96, 56-68.
+     * Each tile is flooded from its edges, recording the lowest spill elevation between the 
+     * regions flooded from each edge pixel. The graph of spill elevations within and between the 
+     * tiles is then flooded from the outlets to give the water level of each region, and finally 
+     * each tile is flooded again and raised to the water levels of its regions.
+     */
     class DllExport RSGISHydroDEMFillSoilleGratin94
     {
     public:
         RSGISHydroDEMFillSoilleGratin94();
-        void performSoilleGratin94Fill(GDALDataset *inDEMImgDS, GDALDataset *inValidImgDS, GDALDataset *outImgDS, bool calcBorderVal, long borderVal=0);
+        void performSoilleGratin94Fill(GDALDataset *inDEMImgDS, GDALDataset *inValidImgDS, GDALDataset *outImgDS, bool calcBorderVal, double borderVal=0, unsigned int tileSize=0);
         ~RSGISHydroDEMFillSoilleGratin94();
     protected:
-        bool qEmpty(long hcrt);
-        Q2DPxl qPopFront(long hcrt);
-        void qPushBack(long hcrt, Q2DPxl pxl);
-        std::list<Q2DPxl>* getNeighbours(Q2DPxl pxl, GDALRasterBand *inValidImg);
-        long getPxlVal(Q2DPxl pxl, GDALRasterBand *imgData);
-        void setPxlVal(Q2DPxl pxl, long val, GDALRasterBand *imgData);
-        long rtnMax(long val1, long val2);
-        void getImagesEdgesToInitFill(GDALRasterBand *imgData, double borderVal, std::list<Q2DPxl> *pxQ);
-        std::list<Q2DPxl> **pxQ;
-        long minVal;
-        long maxVal;
-        long numLevels;
-    };
-  
-    
-    class DllExport RSGISInitOutputImageSoilleGratin94 : public rsgis::img::RSGISCalcImageValue
-    {
-    public:
-        RSGISInitOutputImageSoilleGratin94(double noDataVal, double dataVal, double borderVal, std::list<Q2DPxl> *pxQ);
-        void calcImageValue(float *bandValues, int numBands, double *output) {throw rsgis::img::RSGISImageCalcException("Not implmented.");};
-        void calcImageValue(float *bandValues, int numBands) {throw rsgis::img::RSGISImageCalcException("Not implmented.");};
-        void calcImageValue(long *intBandValues, unsigned int numIntVals, float *floatBandValues, unsigned int numfloatVals) {throw rsgis::img::RSGISImageCalcException("Not implemented");};
-        void calcImageValue(long *intBandValues, unsigned int numIntVals, float *floatBandValues, unsigned int numfloatVals, double *output) {throw rsgis::img::RSGISImageCalcException("Not implemented");};
-        void calcImageValue(long *intBandValues, unsigned int numIntVals, float *floatBandValues, unsigned int numfloatVals, geos::geom::Envelope extent){throw rsgis::img::RSGISImageCalcException("Not implemented");};
-        void calcImageValue(float *bandValues, int numBands, geos::geom::Envelope extent) {throw rsgis::img::RSGISImageCalcException("Not implmented.");};
-        void calcImageValue(float *bandValues, int numBands, double *output, geos::geom::Envelope extent) {throw rsgis::img::RSGISImageCalcException("Not implmented.");};
-        void calcImageValue(float ***dataBlock, int numBands, int winSize, double *output) {throw rsgis::img::RSGISImageCalcException("No implemented");};
-        void calcImageValue(float ***dataBlock, int numBands, int winSize, double *output, geos::geom::Envelope extent);
-        bool calcImageValueCondition(float ***dataBlock, int numBands, int winSize, double *output) {throw rsgis::img::RSGISImageCalcException("Not implmented.");};
-        ~RSGISInitOutputImageSoilleGratin94();
-    protected:
+        void fillInMemory(GDALRasterBand *demBand, GDALRasterBand *validBand, GDALRasterBand *outBand);
+        void fillTiled(GDALRasterBand *demBand, GDALRasterBand *validBand, GDALRasterBand *outBand, unsigned int tileSize);
+        void readTile(GDALRasterBand *demBand, GDALRasterBand *validBand, RSGISFillDEMTile *tile);
+        void floodTile(RSGISFillDEMTile *tile, bool labelPerimeter, std::unordered_map<unsigned long long, float> *spillEdges);
+        bool tileHasBorderPxls(RSGISFillDEMTile *tile);
+        unsigned int getPerimeterIdx(unsigned int x, unsigned int y, unsigned int xSize, unsigned int ySize);
+        void addSpillEdge(std::unordered_map<unsigned long long, float> *spillEdges, unsigned int label1, unsigned int label2, float elev);
+        long imgWidth;
+        long imgHeight;
         double noDataVal;
-        double dataVal;
         double borderVal;
-        std::list<Q2DPxl> *pxQ;
+        bool imgEdgeOutlets;
+        static const unsigned int outletLabel = 1;
     };
     
 }}
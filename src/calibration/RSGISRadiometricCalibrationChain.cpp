@@ -0,0 +1,402 @@
+/*
+ *  RSGISRadiometricCalibrationChain.cpp
+ *  RSGIS_LIB
+ *
+ *  Created by agent on 19/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISRadiometricCalibrationChain.h"
+
+namespace rsgis{namespace calib{
+
+    RSGISLandsatDN2SREFCalibrationChain::RSGISLandsatDN2SREFCalibrationChain(unsigned int numBands, LandsatRadianceGainsOffsets *radGainOffs, float *solarIrradiance, double solarDistance, float solarZenith, float toaScaleFactor, std::vector<LUT6SBaseElevAOT> *lut, float srefScaleFactor, float noDataVal, bool useNoDataVal, unsigned int numThreads)
+    {
+        for(std::vector<LUT6SBaseElevAOT>::iterator iterLUT = lut->begin(); iterLUT != lut->end(); ++iterLUT)
+        {
+            for(std::vector<LUT6SAOT>::iterator iterAOTLUT = (*iterLUT).aotLUT.begin(); iterAOTLUT != (*iterLUT).aotLUT.end(); ++iterAOTLUT)
+            {
+                if((*iterAOTLUT).numValues != numBands)
+                {
+                    throw RSGISImageException("The number of 6S coefficients within the LUT must be the same as the number of bands.");
+                }
+                for(unsigned int i = 0; i < numBands; ++i)
+                {
+                    if(((*iterAOTLUT).imageBands[i] < 2) || ((*iterAOTLUT).imageBands[i] >= (numBands + 2)))
+                    {
+                        throw RSGISImageException("A 6S LUT image band is not within the radiance bands.");
+                    }
+                }
+            }
+        }
+
+        this->numBands = numBands;
+        this->radGainOffs = radGainOffs;
+        this->solarIrradiance = solarIrradiance;
+        this->distSq = solarDistance * solarDistance;
+        this->cosSolarZenith = cos(solarZenith);
+        this->toaScaleFactor = toaScaleFactor;
+        this->lut = lut;
+        this->srefScaleFactor = srefScaleFactor;
+        this->noDataVal = noDataVal;
+        this->useNoDataVal = useNoDataVal;
+        this->numThreads = rsgis::getNumProcessingThreads(numThreads);
+
+        this->radGains = new double[numBands];
+        for(unsigned int i = 0; i < numBands; ++i)
+        {
+            this->radGains[i] = (radGainOffs[i].lMax - radGainOffs[i].lMin)/(radGainOffs[i].qCalMax - radGainOffs[i].qCalMin);
+        }
+        this->lutIndex = new RSGIS6SElevAOTLUTIndex(lut);
+    }
+
+    void RSGISLandsatDN2SREFCalibrationChain::calcCalibratedImages(GDALDataset **dnDatasets, unsigned int numDNDatasets, GDALDataset *demDataset, GDALDataset *aotDataset, GDALDataset *srefDataset, GDALDataset *toaDataset)
+    {
+        unsigned int width = dnDatasets[0]->GetRasterXSize();
+        unsigned int height = dnDatasets[0]->GetRasterYSize();
+
+        // The DN images, DEM and AOT are read together, each thread having its own handles.
+        unsigned int numInDatasets = numDNDatasets + 2;
+        GDALDataset **inDatasets = new GDALDataset*[numInDatasets];
+        for(unsigned int n = 0; n < numDNDatasets; ++n)
+        {
+            inDatasets[n] = dnDatasets[n];
+        }
+        inDatasets[numDNDatasets] = demDataset;
+        inDatasets[numDNDatasets+1] = aotDataset;
+        for(unsigned int n = 0; n < numInDatasets; ++n)
+        {
+            if((((unsigned int)inDatasets[n]->GetRasterXSize()) != width) || (((unsigned int)inDatasets[n]->GetRasterYSize()) != height))
+            {
+                delete[] inDatasets;
+                throw RSGISImageException("The DN, DEM and AOT images must all be the same size.");
+            }
+        }
+        if((((unsigned int)srefDataset->GetRasterXSize()) != width) || (((unsigned int)srefDataset->GetRasterYSize()) != height) || (((unsigned int)srefDataset->GetRasterCount()) < this->numBands))
+        {
+            delete[] inDatasets;
+            throw RSGISImageException("The surface reflectance image must be the same size as the input images and have a band for each DN band.");
+        }
+        if((toaDataset != NULL) && ((((unsigned int)toaDataset->GetRasterXSize()) != width) || (((unsigned int)toaDataset->GetRasterYSize()) != height) || (((unsigned int)toaDataset->GetRasterCount()) < this->numBands)))
+        {
+            delete[] inDatasets;
+            throw RSGISImageException("The TOA reflectance image must be the same size as the input images and have a band for each DN band.");
+        }
+
+        // Find the image and band within the image of each DN band.
+        std::vector<unsigned int> dnDatasetIdxs(this->numBands, 0);
+        std::vector<unsigned int> dnBandIdxs(this->numBands, 0);
+        for(unsigned int i = 0; i < this->numBands; ++i)
+        {
+            unsigned int firstBand = 0;
+            bool found = false;
+            for(unsigned int n = 0; n < numDNDatasets; ++n)
+            {
+                if(this->radGainOffs[i].band < (firstBand + dnDatasets[n]->GetRasterCount()))
+                {
+                    dnDatasetIdxs[i] = n;
+                    dnBandIdxs[i] = this->radGainOffs[i].band - firstBand + 1;
+                    found = true;
+                    break;
+                }
+                firstBand += dnDatasets[n]->GetRasterCount();
+            }
+            if(!found)
+            {
+                delete[] inDatasets;
+                throw RSGISImageException("A DN band is not within the input images.");
+            }
+        }
+
+        int xBlockSize = 0;
+        int yBlockSize = 0;
+        dnDatasets[0]->GetRasterBand(1)->GetBlockSize(&xBlockSize, &yBlockSize);
+        if(yBlockSize < 1)
+        {
+            yBlockSize = 1;
+        }
+        unsigned int stripRows = ((RSGIS_CALIB_CHAIN_MIN_STRIP_ROWS + yBlockSize - 1) / yBlockSize) * yBlockSize;
+        size_t numStrips = (height + stripRows - 1) / stripRows;
+        size_t maxStripPxls = ((size_t)width) * stripRows;
+
+        // Each thread has its own input handles and input buffers, while the outputs are
+        // held for each strip within a group of numThreads strips so the strips can be
+        // written in order, by this thread, once the group has been calibrated.
+        std::vector<GDALDataset**> threadDatasets;
+        std::vector<float*> threadDNData;
+        std::vector<float*> threadElevAOTData;
+        std::vector<float*> threadRadVals;
+        std::vector<float*> stripSREFData;
+        std::vector<float*> stripTOAData;
+        bool openFailed = false;
+        std::string failedImage = "";
+        for(unsigned int t = 0; t < this->numThreads; ++t)
+        {
+            GDALDataset **tDatasets = new GDALDataset*[numInDatasets];
+            for(unsigned int n = 0; n < numInDatasets; ++n)
+            {
+                if(this->numThreads == 1)
+                {
+                    tDatasets[n] = inDatasets[n];
+                }
+                else if(openFailed)
+                {
+                    tDatasets[n] = NULL;
+                }
+                else
+                {
+                    tDatasets[n] = (GDALDataset *) GDALOpen(inDatasets[n]->GetDescription(), GA_ReadOnly);
+                    if(tDatasets[n] == NULL)
+                    {
+                        openFailed = true;
+                        failedImage = inDatasets[n]->GetDescription();
+                    }
+                }
+            }
+            threadDatasets.push_back(tDatasets);
+            threadDNData.push_back(new float[maxStripPxls * this->numBands]);
+            threadElevAOTData.push_back(new float[maxStripPxls * 2]);
+            threadRadVals.push_back(new float[this->numBands + 2]);
+            stripSREFData.push_back(new float[maxStripPxls * this->numBands]);
+            if(toaDataset != NULL)
+            {
+                stripTOAData.push_back(new float[maxStripPxls * this->numBands]);
+            }
+            else
+            {
+                stripTOAData.push_back(NULL);
+            }
+        }
+
+        auto freeThreadData = [&]()
+        {
+            for(unsigned int t = 0; t < this->numThreads; ++t)
+            {
+                if(this->numThreads > 1)
+                {
+                    for(unsigned int n = 0; n < numInDatasets; ++n)
+                    {
+                        if(threadDatasets[t][n] != NULL)
+                        {
+                            GDALClose(threadDatasets[t][n]);
+                        }
+                    }
+                }
+                delete[] threadDatasets[t];
+                delete[] threadDNData[t];
+                delete[] threadElevAOTData[t];
+                delete[] threadRadVals[t];
+                delete[] stripSREFData[t];
+                if(stripTOAData[t] != NULL)
+                {
+                    delete[] stripTOAData[t];
+                }
+            }
+            delete[] inDatasets;
+        };
+
+        try
+        {
+            if(openFailed)
+            {
+                std::string message = std::string("Could not open image ") + failedImage + std::string(" for each thread.");
+                throw RSGISImageException(message.c_str());
+            }
+
+            size_t feedbackStep = (numStrips + 9) / 10;
+            if(feedbackStep == 0)
+            {
+                feedbackStep = 1;
+            }
+            int feedbackCounter = 0;
+            std::cout << "Started" << std::flush;
+            for(size_t groupStart = 0; groupStart < numStrips; groupStart += this->numThreads)
+            {
+                size_t groupEnd = groupStart + this->numThreads;
+                if(groupEnd > numStrips)
+                {
+                    groupEnd = numStrips;
+                }
+
+                rsgis::parallelForRange(groupStart, groupEnd, this->numThreads, 1, [&](size_t stripStart, size_t stripEnd, unsigned int threadIdx)
+                {
+                    GDALDataset **tDatasets = threadDatasets.at(threadIdx);
+                    float *dnData = threadDNData.at(threadIdx);
+                    float *elevAOTData = threadElevAOTData.at(threadIdx);
+                    float *radVals = threadRadVals.at(threadIdx);
+                    for(size_t s = stripStart; s < stripEnd; ++s)
+                    {
+                        unsigned int yOff = s * stripRows;
+                        unsigned int numRows = stripRows;
+                        if((yOff + numRows) > height)
+                        {
+                            numRows = height - yOff;
+                        }
+                        size_t stripPxls = ((size_t)width) * numRows;
+                        float *srefData = stripSREFData.at(s - groupStart);
+                        float *toaData = stripTOAData.at(s - groupStart);
+
+                        for(unsigned int i = 0; i < this->numBands; ++i)
+                        {
+                            if(tDatasets[dnDatasetIdxs[i]]->GetRasterBand(dnBandIdxs[i])->RasterIO(GF_Read, 0, yOff, width, numRows, &dnData[i * stripPxls], width, numRows, GDT_Float32, 0, 0) != CE_None)
+                            {
+                                throw RSGISImageException("Failed to read a strip of the DN images.");
+                            }
+                        }
+                        for(unsigned int n = 0; n < 2; ++n)
+                        {
+                            if(tDatasets[numDNDatasets+n]->GetRasterBand(1)->RasterIO(GF_Read, 0, yOff, width, numRows, &elevAOTData[n * stripPxls], width, numRows, GDT_Float32, 0, 0) != CE_None)
+                            {
+                                throw RSGISImageException("Failed to read a strip of the DEM or AOT images.");
+                            }
+                        }
+
+                        for(size_t p = 0; p < stripPxls; ++p)
+                        {
+                            this->calcPxlValues(&dnData[p], stripPxls, elevAOTData[p], elevAOTData[stripPxls + p], radVals, &srefData[p], ((toaData != NULL)?(&toaData[p]):NULL));
+                        }
+                    }
+                });
+
+                for(size_t s = groupStart; s < groupEnd; ++s)
+                {
+                    if((s % feedbackStep) == 0)
+                    {
+                        std::cout << "." << feedbackCounter << "." << std::flush;
+                        feedbackCounter = feedbackCounter + 10;
+                    }
+                    unsigned int yOff = s * stripRows;
+                    unsigned int numRows = stripRows;
+                    if((yOff + numRows) > height)
+                    {
+                        numRows = height - yOff;
+                    }
+                    size_t stripPxls = ((size_t)width) * numRows;
+                    for(unsigned int i = 0; i < this->numBands; ++i)
+                    {
+                        if(srefDataset->GetRasterBand(i+1)->RasterIO(GF_Write, 0, yOff, width, numRows, &stripSREFData[s - groupStart][i * stripPxls], width, numRows, GDT_Float32, 0, 0) != CE_None)
+                        {
+                            throw RSGISImageException("Failed to write a strip of the surface reflectance image.");
+                        }
+                        if((toaDataset != NULL) && (toaDataset->GetRasterBand(i+1)->RasterIO(GF_Write, 0, yOff, width, numRows, &stripTOAData[s - groupStart][i * stripPxls], width, numRows, GDT_Float32, 0, 0) != CE_None))
+                        {
+                            throw RSGISImageException("Failed to write a strip of the TOA reflectance image.");
+                        }
+                    }
+                }
+            }
+            std::cout << " Complete.\n";
+        }
+        catch(std::exception &e)
+        {
+            freeThreadData();
+            throw;
+        }
+        freeThreadData();
+    }
+
+    void RSGISLandsatDN2SREFCalibrationChain::calcPxlValues(float *dnVals, size_t stripPxls, float elevVal, float aotVal, float *radVals, float *srefVals, float *toaVals)
+    {
+        // DN to radiance, where pixels which are 0 in all bands are the image border.
+        bool nodata = true;
+        for(unsigned int i = 0; i < this->numBands; ++i)
+        {
+            if(dnVals[i * stripPxls] != 0)
+            {
+                nodata = false;
+                break;
+            }
+        }
+
+        radVals[0] = elevVal;
+        radVals[1] = aotVal;
+        for(unsigned int i = 0; i < this->numBands; ++i)
+        {
+            if(nodata)
+            {
+                radVals[i+2] = 0;
+            }
+            else
+            {
+                radVals[i+2] = this->radGains[i] * (dnVals[i * stripPxls] - this->radGainOffs[i].qCalMin) + this->radGainOffs[i].lMin;
+            }
+
+            if(toaVals != NULL)
+            {
+                toaVals[i * stripPxls] = ((M_PI * radVals[i+2] * this->distSq)/(this->solarIrradiance[i] * this->cosSolarZenith)) * this->toaScaleFactor;
+            }
+        }
+
+        // Radiance to surface reflectance.
+        bool srefNoData = this->useNoDataVal;
+        if(this->useNoDataVal)
+        {
+            for(unsigned int i = 0; i < this->numBands; ++i)
+            {
+                if(radVals[i+2] != this->noDataVal)
+                {
+                    srefNoData = false;
+                    break;
+                }
+            }
+        }
+
+        if(srefNoData)
+        {
+            for(unsigned int i = 0; i < this->numBands; ++i)
+            {
+                srefVals[i * stripPxls] = 0;
+            }
+        }
+        else
+        {
+            const LUT6SAOT *aotLUTVal = this->lutIndex->findCoefficients(elevVal, aotVal);
+            double tmpVal = 0;
+            double outVal = 0;
+            for(unsigned int i = 0; i < this->numBands; ++i)
+            {
+                tmpVal = aotLUTVal->aX[i]*radVals[aotLUTVal->imageBands[i]]-aotLUTVal->bX[i];
+                outVal = (tmpVal/(1.0+aotLUTVal->cX[i]*tmpVal))*this->srefScaleFactor;
+
+                if(this->useNoDataVal & (this->noDataVal == 0.0))
+                {
+                    if(outVal < 1)
+                    {
+                        outVal = 1.0;
+                    }
+                    else
+                    {
+                        outVal = outVal + 1.0;
+                    }
+                }
+                if(outVal > this->srefScaleFactor)
+                {
+                    outVal = this->srefScaleFactor;
+                }
+                srefVals[i * stripPxls] = outVal;
+            }
+        }
+    }
+
+    RSGISLandsatDN2SREFCalibrationChain::~RSGISLandsatDN2SREFCalibrationChain()
+    {
+        delete[] this->radGains;
+        delete this->lutIndex;
+    }
+
+}}
+
@@ -0,0 +1,99 @@
+/*
+ *  RSGISRadiometricCalibrationChain.h
+ *  RSGIS_LIB
+ *
+ *  Created by agent on 19/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISRadiometricCalibrationChain_H
+#define RSGISRadiometricCalibrationChain_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <math.h>
+
+#include "gdal_priv.h"
+
+#include "common/RSGISImageException.h"
+#include "common/RSGISThreadUtils.h"
+
+#include "calibration/RSGISStandardDN2RadianceCalibration.h"
+#include "calibration/RSGISApply6SCoefficients.h"
+
+/** The minimum number of rows read and calibrated at a time by RSGISLandsatDN2SREFCalibrationChain. */
+#define RSGIS_CALIB_CHAIN_MIN_STRIP_ROWS 64
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_calib_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace calib{
+
+    /**
+     * Calibrates Landsat DN images to surface reflectance in a single pass, applying the
+     * same steps as RSGISLandsatRadianceCalibration (DN to radiance), RSGISCalculateTopOfAtmosphereReflectance
+     * (radiance to TOA reflectance) and RSGISApply6SCoefficientsElevAOTLUTParam (radiance to
+     * surface reflectance) to each strip of rows in memory, so no intermediate images are
+     * written. The TOA reflectance image is optional. The radiance is held as a float, as
+     * it would be within an intermediate radiance image, so the outputs match running the
+     * steps separately. The 6S coefficients are found using a RSGIS6SElevAOTLUTIndex.
+     *
+     * The band of radGainOffs[i] is the index (from 0) over all the bands of the DN images,
+     * in the order they are provided, and the 6S LUT image bands index the DEM (0), the AOT
+     * (1) and then the radiance bands (from 2), as for RSGISApply6SCoefficientsElevAOTLUTParam.
+     * The solar zenith is in radians. All the input images must be the same size.
+     */
+    class DllExport RSGISLandsatDN2SREFCalibrationChain
+    {
+    public:
+        RSGISLandsatDN2SREFCalibrationChain(unsigned int numBands, LandsatRadianceGainsOffsets *radGainOffs, float *solarIrradiance, double solarDistance, float solarZenith, float toaScaleFactor, std::vector<LUT6SBaseElevAOT> *lut, float srefScaleFactor, float noDataVal=0.0, bool useNoDataVal=false, unsigned int numThreads=1);
+        /** Writes the surface reflectance (and TOA reflectance if toaDataset is not NULL), which must have numBands bands. */
+        void calcCalibratedImages(GDALDataset **dnDatasets, unsigned int numDNDatasets, GDALDataset *demDataset, GDALDataset *aotDataset, GDALDataset *srefDataset, GDALDataset *toaDataset=NULL);
+        ~RSGISLandsatDN2SREFCalibrationChain();
+    protected:
+        /** Calibrates a pixel, where dnVals and the outputs have a stride of stripPxls between bands and radVals has numBands+2 values. */
+        void calcPxlValues(float *dnVals, size_t stripPxls, float elevVal, float aotVal, float *radVals, float *srefVals, float *toaVals);
+        unsigned int numBands;
+        LandsatRadianceGainsOffsets *radGainOffs;
+        double *radGains;
+        float *solarIrradiance;
+        double distSq;
+        float cosSolarZenith;
+        float toaScaleFactor;
+        std::vector<LUT6SBaseElevAOT> *lut;
+        RSGIS6SElevAOTLUTIndex *lutIndex;
+        float srefScaleFactor;
+        float noDataVal;
+        bool useNoDataVal;
+        unsigned int numThreads;
+    };
+
+}}
+
+#endif
+
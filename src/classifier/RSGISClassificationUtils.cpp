@@ -318,49 +318,25 @@ namespace rsgis{ namespace classifier{
             outData = imgUtils.createCopy(inImageData, outputImage, format, inImageData->GetRasterBand(1)->GetRasterDataType());
             imgUtils.copyUIntGDALDataset(inImageData, outData);
             
+            std::vector<size_t> singles;
             unsigned long singlesCount = 0;
-            bool singlesRemoved = false;
+            if(filterConnectivity == rsgis::img::rsgis_4connect)
+            {
+                singlesCount = this->findSinglePixelsConnect4(outData, tmpData, noDataVal, noDataValProvided, &singles);
+            }
+            else if(filterConnectivity == rsgis::img::rsgis_8connect)
+            {
+                singlesCount = this->findSinglePixelsConnect8(outData, tmpData, noDataVal, noDataValProvided, &singles);
+            }
+            else
+            {
+                throw rsgis::img::RSGISImageCalcException("Connectivity not recoginised (Only 4 or 8 are valid inputs)");
+            }
             
-            while(!singlesRemoved)
+            if(singlesCount > 0)
             {
-                if(filterConnectivity == rsgis::img::rsgis_4connect)
-                {
-                    singlesCount = this->findSinglePixelsConnect4(outData, tmpData, noDataVal, noDataValProvided);
-                }
-                else if(filterConnectivity == rsgis::img::rsgis_8connect)
-                {
-                    singlesCount = this->findSinglePixelsConnect8(outData, tmpData, noDataVal, noDataValProvided);
-                }
-                else
-                {
-                    throw rsgis::img::RSGISImageCalcException("Connectivity not recoginised (Only 4 or 8 are valid inputs)");
-                }
-                
-                if(singlesCount > 0)
-                {
-                    std::cout << "There are " << singlesCount << " single pixels within the image\n";
-                    if(filterConnectivity == rsgis::img::rsgis_4connect)
-                    {
-                        if(!eliminateSinglePixelsConnect4(outData, tmpData, outData, noDataVal, noDataValProvided))
-                        {
-                            singlesRemoved = true;
-                            break;
-                        }
-                    }
-                    else//if(filterConnectivity == rsgis::img::rsgis_8connect)
-                    {
-                        if(!eliminateSinglePixelsConnect8(outData, tmpData, outData, noDataVal, noDataValProvided))
-                        {
-                            singlesRemoved = true;
-                            break;
-                        }
-                    }
-                }
-                else
-                {
-                    singlesRemoved = true;
-                    break;
-                }
+                std::cout << "There are " << singlesCount << " single pixels within the image\n";
+                this->eliminateSinglePixels(outData, &singles, noDataVal, noDataValProvided, filterConnectivity);
             }
             std::cout << "Complete, all connected single pixels have been removed\n";
             
@@ -377,7 +353,7 @@ namespace rsgis{ namespace classifier{
         }
     }
     
-    unsigned long RSGISEliminateSingleClassPixels::findSinglePixelsConnect4(GDALDataset *inImageData, GDALDataset *tmpData, float noDataVal, bool noDataValProvided) 
+    unsigned long RSGISEliminateSingleClassPixels::findSinglePixelsConnect4(GDALDataset *inImageData, GDALDataset *tmpData, float noDataVal, bool noDataValProvided, std::vector<size_t> *singles) 
     {
         unsigned long countSingles = 0;
         try
@@ -471,6 +447,7 @@ namespace rsgis{ namespace classifier{
                         else
                         {
                             outData[j] = 1;
+                            singles->push_back((((size_t)i) * width) + j);
                             ++countSingles;
                         }
                     }
@@ -541,6 +518,7 @@ namespace rsgis{ namespace classifier{
                         else
                         {
                             outData[j] = 1;
+                            singles->push_back((((size_t)i) * width) + j);
                             ++countSingles;
                         }
                     }
@@ -627,6 +605,7 @@ namespace rsgis{ namespace classifier{
                         else
                         {
                             outData[j] = 1;
+                            singles->push_back((((size_t)i) * width) + j);
                             ++countSingles;
                         }
                     }
@@ -650,390 +629,7 @@ namespace rsgis{ namespace classifier{
         return countSingles;
     }
     
-    bool RSGISEliminateSingleClassPixels::eliminateSinglePixelsConnect4(GDALDataset *inImageData, GDALDataset *tmpData, GDALDataset *outDataset, float noDataVal, bool noDataValProvided) 
-    {
-        bool hasChangeOccured = false;
-        try
-        {
-            unsigned int width = inImageData->GetRasterXSize();
-            unsigned int height = inImageData->GetRasterYSize();
-            
-            GDALRasterBand *clumpBand = inImageData->GetRasterBand(1);
-            GDALRasterBand *singlePxlBand = tmpData->GetRasterBand(1);
-            GDALRasterBand *outBand = outDataset->GetRasterBand(1);
-            
-            unsigned int **inData = new unsigned int*[3];
-            inData[0] = new unsigned int[width];
-            inData[1] = new unsigned int[width];
-            inData[2] = new unsigned int[width];
-            
-            unsigned int **singlePxl = new unsigned int*[3];
-            singlePxl[0] = new unsigned int[width];
-            singlePxl[1] = new unsigned int[width];
-            singlePxl[2] = new unsigned int[width];
-            
-            rsgis::datastruct::SortedGenericList<unsigned int> *sortedList = new rsgis::datastruct::SortedGenericList<unsigned int>();
-            
-            unsigned int *outData = new unsigned int[width];
-            
-            int feedback = height/10;
-            int feedbackCounter = 0;
-            std::cout << "Started" << std::flush;
-            for(unsigned int i = 0; i < height; ++i)
-            {
-                if((i % feedback) == 0)
-                {
-                    std::cout << "." << feedbackCounter << "." << std::flush;
-                    feedbackCounter = feedbackCounter + 10;
-                }
-                if(i == 0)
-                {
-                    clumpBand->RasterIO(GF_Read, 0, i, width, 1, inData[1], width, 1, GDT_UInt32, 0, 0);
-                    clumpBand->RasterIO(GF_Read, 0, i+1, width, 1, inData[2], width, 1, GDT_UInt32, 0, 0);
-                    singlePxlBand->RasterIO(GF_Read, 0, i, width, 1, singlePxl[1], width, 1, GDT_UInt32, 0, 0);
-                    singlePxlBand->RasterIO(GF_Read, 0, i+1, width, 1, singlePxl[2], width, 1, GDT_UInt32, 0, 0);
-                    
-                    for(unsigned int j = 0; j < width; ++j)
-                    {
-                        if((noDataValProvided & (inData[1][j] != noDataVal)) | !noDataValProvided)
-                        {
-                            if(singlePxl[1][j] == 1)
-                            {
-                                if(j == 0)
-                                {
-                                    //right
-                                    if((j < width-1) && (singlePxl[1][j+1] == 0))
-                                    {
-                                        sortedList->add(&inData[1][j+1]);
-                                    }
-                                    //bottom
-                                    if(singlePxl[2][j] == 0)
-                                    {
-                                        sortedList->add(&inData[2][j]);
-                                    }
-                                    
-                                    if(sortedList->getSize() <= 1)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = *sortedList->getMostCommonValue();
-                                        hasChangeOccured = true;
-                                    }
-                                    sortedList->clearList();
-                                }
-                                else if(j == (width-1))
-                                {
-                                    //left
-                                    if((j > 0) && (singlePxl[1][j-1] == 0))
-                                    {
-                                        sortedList->add(&inData[1][j-1]);
-                                    }
-                                    //bottom
-                                    if(singlePxl[2][j] == 0)
-                                    {
-                                        sortedList->add(&inData[2][j]);
-                                    }
-                                    
-                                    if(sortedList->getSize() <= 1)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = *sortedList->getMostCommonValue();
-                                        hasChangeOccured = true;
-                                    }
-                                    sortedList->clearList();
-                                }
-                                else
-                                {
-                                    //left
-                                    if((j > 0) && (singlePxl[1][j-1] == 0))
-                                    {
-                                        sortedList->add(&inData[1][j-1]);
-                                    }
-                                    //right
-                                    if((j < width-1) && (singlePxl[1][j+1] == 0))
-                                    {
-                                        sortedList->add(&inData[1][j+1]);
-                                    }
-                                    //bottom
-                                    if(singlePxl[2][j] == 0)
-                                    {
-                                        sortedList->add(&inData[2][j]);
-                                    }
-                                    
-                                    if(sortedList->getSize() <= 1)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = *sortedList->getMostCommonValue();
-                                        hasChangeOccured = true;
-                                    }
-                                    sortedList->clearList();
-                                }
-                            }
-                            else
-                            {
-                                outData[j] = inData[1][j];
-                            }
-                        }
-                        else
-                        {
-                            outData[j] = inData[1][j];
-                        }
-                    }
-                    
-                }
-                else if(i == (height-1))
-                {
-                    clumpBand->RasterIO(GF_Read, 0, i-1, width, 1, inData[0], width, 1, GDT_UInt32, 0, 0);
-                    clumpBand->RasterIO(GF_Read, 0, i, width, 1, inData[1], width, 1, GDT_UInt32, 0, 0);
-                    singlePxlBand->RasterIO(GF_Read, 0, i-1, width, 1, singlePxl[0], width, 1, GDT_UInt32, 0, 0);
-                    singlePxlBand->RasterIO(GF_Read, 0, i, width, 1, singlePxl[1], width, 1, GDT_UInt32, 0, 0);
-                    
-                    for(unsigned int j = 0; j < width; ++j)
-                    {
-                        if((noDataValProvided & (inData[1][j] != noDataVal)) | !noDataValProvided)
-                        {
-                            if(singlePxl[1][j] == 1)
-                            {
-                                if(j == 0)
-                                {
-                                    //top
-                                    if(singlePxl[0][j] == 0)
-                                    {
-                                        sortedList->add(&inData[0][j]);
-                                    }
-                                    //right
-                                    if((j < width-1) && (singlePxl[1][j+1] == 0))
-                                    {
-                                        sortedList->add(&inData[1][j+1]);
-                                    }
-                                    
-                                    if(sortedList->getSize() <= 1)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = *sortedList->getMostCommonValue();
-                                        hasChangeOccured = true;
-                                    }
-                                    sortedList->clearList();
-                                }
-                                else if(j == (width-1))
-                                {
-                                    //top
-                                    if(singlePxl[0][j] == 0)
-                                    {
-                                        sortedList->add(&inData[0][j]);
-                                    }
-                                    //left
-                                    if((j > 0) && (singlePxl[1][j-1] == 0))
-                                    {
-                                        sortedList->add(&inData[1][j-1]);
-                                    }
-                                    
-                                    if(sortedList->getSize() <= 1)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = *sortedList->getMostCommonValue();
-                                        hasChangeOccured = true;
-                                    }
-                                    sortedList->clearList();
-                                }
-                                else
-                                {
-                                    //top
-                                    if(singlePxl[0][j] == 0)
-                                    {
-                                        sortedList->add(&inData[0][j]);
-                                    }
-                                    //left
-                                    if((j > 0) && (singlePxl[1][j-1] == 0))
-                                    {
-                                        sortedList->add(&inData[1][j-1]);
-                                    }
-                                    //right
-                                    if((j < width-1) && (singlePxl[1][j+1] == 0))
-                                    {
-                                        sortedList->add(&inData[1][j+1]);
-                                    }
-                                    
-                                    if(sortedList->getSize() <= 1)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = *sortedList->getMostCommonValue();
-                                        hasChangeOccured = true;
-                                    }
-                                    sortedList->clearList();
-                                }
-                            }
-                            else
-                            {
-                                outData[j] = inData[1][j];
-                            }
-                        }
-                        else
-                        {
-                            outData[j] = inData[1][j];
-                        }
-                    }
-                }
-                else
-                {
-                    clumpBand->RasterIO(GF_Read, 0, i-1, width, 1, inData[0], width, 1, GDT_UInt32, 0, 0);
-                    clumpBand->RasterIO(GF_Read, 0, i, width, 1, inData[1], width, 1, GDT_UInt32, 0, 0);
-                    clumpBand->RasterIO(GF_Read, 0, i+1, width, 1, inData[2], width, 1, GDT_UInt32, 0, 0);
-                    singlePxlBand->RasterIO(GF_Read, 0, i-1, width, 1, singlePxl[0], width, 1, GDT_UInt32, 0, 0);
-                    singlePxlBand->RasterIO(GF_Read, 0, i, width, 1, singlePxl[1], width, 1, GDT_UInt32, 0, 0);
-                    singlePxlBand->RasterIO(GF_Read, 0, i+1, width, 1, singlePxl[2], width, 1, GDT_UInt32, 0, 0);
-                    
-                    for(unsigned int j = 0; j < width; ++j)
-                    {
-                        if((noDataValProvided & (inData[1][j] != noDataVal)) | !noDataValProvided)
-                        {
-                            if(singlePxl[1][j] == 1)
-                            {
-                                if(j == 0)
-                                {
-                                    //top
-                                    if(singlePxl[0][j] == 0)
-                                    {
-                                        sortedList->add(&inData[0][j]);
-                                    }
-                                    //right
-                                    if((j < width-1) && (singlePxl[1][j+1] == 0))
-                                    {
-                                        sortedList->add(&inData[1][j+1]);
-                                    }
-                                    //bottom
-                                    if(singlePxl[2][j] == 0)
-                                    {
-                                        sortedList->add(&inData[2][j]);
-                                    }
-                                    
-                                    if(sortedList->getSize() <= 1)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = *sortedList->getMostCommonValue();
-                                        hasChangeOccured = true;
-                                    }
-                                    sortedList->clearList();
-                                }
-                                else if(j == (width-1))
-                                {
-                                    //top
-                                    if(singlePxl[0][j] == 0)
-                                    {
-                                        sortedList->add(&inData[0][j]);
-                                    }
-                                    //left
-                                    if((j > 0) && (singlePxl[1][j-1] == 0))
-                                    {
-                                        sortedList->add(&inData[1][j-1]);
-                                    }
-                                    //bottom
-                                    if(singlePxl[2][j] == 0)
-                                    {
-                                        sortedList->add(&inData[2][j]);
-                                    }
-                                    
-                                    if(sortedList->getSize() <= 1)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = *sortedList->getMostCommonValue();
-                                        hasChangeOccured = true;
-                                    }
-                                    sortedList->clearList();
-                                }
-                                else
-                                {
-                                    //top
-                                    if(singlePxl[0][j] == 0)
-                                    {
-                                        sortedList->add(&inData[0][j]);
-                                    }
-                                    //left
-                                    if((j > 0) && (singlePxl[1][j-1] == 0))
-                                    {
-                                        sortedList->add(&inData[1][j-1]);
-                                    }
-                                    //right
-                                    if((j < width-1) && (singlePxl[1][j+1] == 0))
-                                    {
-                                        sortedList->add(&inData[1][j+1]);
-                                    }
-                                    //bottom
-                                    if(singlePxl[2][j] == 0)
-                                    {
-                                        sortedList->add(&inData[2][j]);
-                                    }
-                                    
-                                    if(sortedList->getSize() <= 1)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = *sortedList->getMostCommonValue();
-                                        hasChangeOccured = true;
-                                    }
-                                    sortedList->clearList();
-                                }
-                            }
-                            else
-                            {
-                                outData[j] = inData[1][j];
-                            }
-                        }
-                        else
-                        {
-                            outData[j] = inData[1][j];
-                        }
-                    }
-                }
-                
-                outBand->RasterIO(GF_Write, 0, i, width, 1, outData, width, 1, GDT_UInt32, 0, 0);
-            }
-            std::cout << ". Complete\n";
-            
-            delete sortedList;
-            delete[] inData[0];
-            delete[] inData[1];
-            delete[] inData[2];
-            delete[] inData;
-            delete[] singlePxl[0];
-            delete[] singlePxl[1];
-            delete[] singlePxl[2];
-            delete[] singlePxl;
-            delete[] outData;
-        }
-        catch (rsgis::img::RSGISImageCalcException &e)
-        {
-            throw e;
-        }
-        return hasChangeOccured;
-    }
-    
-    unsigned long RSGISEliminateSingleClassPixels::findSinglePixelsConnect8(GDALDataset *inImageData, GDALDataset *tmpData, float noDataVal, bool noDataValProvided) 
+    unsigned long RSGISEliminateSingleClassPixels::findSinglePixelsConnect8(GDALDataset *inImageData, GDALDataset *tmpData, float noDataVal, bool noDataValProvided, std::vector<size_t> *singles) 
     {
         unsigned long countSingles = 0;
         try
@@ -1147,6 +743,7 @@ namespace rsgis{ namespace classifier{
                         else
                         {
                             outData[j] = 1;
+                            singles->push_back((((size_t)i) * width) + j);
                             ++countSingles;
                         }
                     }
@@ -1237,6 +834,7 @@ namespace rsgis{ namespace classifier{
                         else
                         {
                             outData[j] = 1;
+                            singles->push_back((((size_t)i) * width) + j);
                             ++countSingles;
                         }
                     }
@@ -1363,6 +961,7 @@ namespace rsgis{ namespace classifier{
                         else
                         {
                             outData[j] = 1;
+                            singles->push_back((((size_t)i) * width) + j);
                             ++countSingles;
                         }
                     }
@@ -1386,469 +985,162 @@ namespace rsgis{ namespace classifier{
         return countSingles;
     }
     
-    bool RSGISEliminateSingleClassPixels::eliminateSinglePixelsConnect8(GDALDataset *inImageData, GDALDataset *tmpData, GDALDataset *outDataset, float noDataVal, bool noDataValProvided) 
+    bool RSGISEliminateSingleClassPixels::eliminateSinglePixels(GDALDataset *imageData, std::vector<size_t> *singles, float noDataVal, bool noDataValProvided, rsgis::img::RSGISRasterConnectivity filterConnectivity)
     {
         bool hasChangeOccured = false;
         try
         {
-            unsigned int width = inImageData->GetRasterXSize();
-            unsigned int height = inImageData->GetRasterYSize();
+            unsigned int width = imageData->GetRasterXSize();
+            unsigned int height = imageData->GetRasterYSize();
             
-            GDALRasterBand *clumpBand = inImageData->GetRasterBand(1);
-            GDALRasterBand *singlePxlBand = tmpData->GetRasterBand(1);
-            GDALRasterBand *outBand = outDataset->GetRasterBand(1);
-            
-            unsigned int **inData = new unsigned int*[3];
-            inData[0] = new unsigned int[width];
-            inData[1] = new unsigned int[width];
-            inData[2] = new unsigned int[width];
-            
-            unsigned int **singlePxl = new unsigned int*[3];
-            singlePxl[0] = new unsigned int[width];
-            singlePxl[1] = new unsigned int[width];
-            singlePxl[2] = new unsigned int[width];
+            const int nOffX4[] = {0, -1, 1, 0};
+            const int nOffY4[] = {-1, 0, 0, 1};
+            const int nOffX8[] = {-1, 0, 1, -1, 1, -1, 0, 1};
+            const int nOffY8[] = {-1, -1, -1, 0, 0, 1, 1, 1};
+            const int *nOffX = nOffX4;
+            const int *nOffY = nOffY4;
+            unsigned int numNeighbours = 4;
+            if(filterConnectivity == rsgis::img::rsgis_8connect)
+            {
+                nOffX = nOffX8;
+                nOffY = nOffY8;
+                numNeighbours = 8;
+            }
             
+            rsgis::img::RSGISImageBlockCache<unsigned int> imgCache(imageData, GDT_UInt32);
+            std::unordered_set<size_t> singlesSet(singles->begin(), singles->end());
             rsgis::datastruct::SortedGenericList<unsigned int> *sortedList = new rsgis::datastruct::SortedGenericList<unsigned int>();
+            unsigned int *neighbourVals = new unsigned int[numNeighbours];
             
-            unsigned int *outData = new unsigned int[width];
+            std::vector<size_t> changedPxls;
+            std::vector<unsigned int> changedVals;
+            std::vector<size_t> unchangedPxls;
+            unsigned int x = 0;
+            unsigned int y = 0;
+            long nX = 0;
+            long nY = 0;
+            size_t nIdx = 0;
+            unsigned int numVals = 0;
             
-            int feedback = height/10;
-            int feedbackCounter = 0;
-            std::cout << "Started" << std::flush;
-            for(unsigned int i = 0; i < height; ++i)
+            // Each pass uses the pixel values and single pixels from the end of the previous
+            // pass. A changed pixel takes the value of a neighbour which is not single so is
+            // not single afterwards and a pixel which is not single never changes, so only the
+            // unchanged single pixels need checking for the next pass.
+            unsigned int passCount = 0;
+            while(!singles->empty())
             {
-                if((i % feedback) == 0)
+                changedPxls.clear();
+                changedVals.clear();
+                unchangedPxls.clear();
+                for(std::vector<size_t>::iterator iterPxls = singles->begin(); iterPxls != singles->end(); ++iterPxls)
                 {
-                    std::cout << "." << feedbackCounter << "." << std::flush;
-                    feedbackCounter = feedbackCounter + 10;
-                }
-                if(i == 0)
-                {
-                    clumpBand->RasterIO(GF_Read, 0, i, width, 1, inData[1], width, 1, GDT_UInt32, 0, 0);
-                    clumpBand->RasterIO(GF_Read, 0, i+1, width, 1, inData[2], width, 1, GDT_UInt32, 0, 0);
-                    singlePxlBand->RasterIO(GF_Read, 0, i, width, 1, singlePxl[1], width, 1, GDT_UInt32, 0, 0);
-                    singlePxlBand->RasterIO(GF_Read, 0, i+1, width, 1, singlePxl[2], width, 1, GDT_UInt32, 0, 0);
-                    
-                    for(unsigned int j = 0; j < width; ++j)
+                    x = (*iterPxls) % width;
+                    y = (*iterPxls) / width;
+                    numVals = 0;
+                    for(unsigned int n = 0; n < numNeighbours; ++n)
                     {
-                        if((noDataValProvided & (inData[1][j] != noDataVal)) | !noDataValProvided)
+                        nX = ((long)x) + nOffX[n];
+                        nY = ((long)y) + nOffY[n];
+                        if((nX >= 0) && (nX < ((long)width)) && (nY >= 0) && (nY < ((long)height)))
                         {
-                            if(singlePxl[1][j] == 1)
-                            {
-                                if(j == 0)
-                                {
-                                    //right
-                                    if((j < width-1) && (singlePxl[1][j+1] == 0))
-                                    {
-                                        sortedList->add(&inData[1][j+1]);
-                                    }
-                                    //bottom
-                                    else if(singlePxl[2][j] == 0)
-                                    {
-                                        sortedList->add(&inData[2][j]);
-                                    }
-                                    //bottom right
-                                    else if((j < width-1) && (singlePxl[2][j+1] == 0))
-                                    {
-                                        sortedList->add(&inData[2][j+1]);
-                                    }
-                                    
-                                    if(sortedList->getSize() <= 1)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = *sortedList->getMostCommonValue();
-                                        hasChangeOccured = true;
-                                    }
-                                    sortedList->clearList();
-                                }
-                                else if(j == (width-1))
-                                {
-                                    //left
-                                    if((j > 0) && (singlePxl[1][j-1] == 0))
-                                    {
-                                        sortedList->add(&inData[1][j-1]);
-                                    }
-                                    //bottom left 
-                                    else if((j > 0) && (singlePxl[2][j-1] == 0))
-                                    {
-                                        sortedList->add(&inData[2][j-1]);
-                                    }
-                                    //bottom
-                                    else if(singlePxl[2][j] == 0)
-                                    {
-                                        sortedList->add(&inData[2][j]);
-                                    }
-                                    
-                                    if(sortedList->getSize() <= 1)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = *sortedList->getMostCommonValue();
-                                        hasChangeOccured = true;
-                                    }
-                                    sortedList->clearList();
-                                }
-                                else
-                                {
-                                    //left
-                                    if((j > 0) && (singlePxl[1][j-1] == 0))
-                                    {
-                                        sortedList->add(&inData[1][j-1]);
-                                    }
-                                    //right
-                                    else if((j < width-1) && (singlePxl[1][j+1] == 0))
-                                    {
-                                        sortedList->add(&inData[1][j+1]);
-                                    }
-                                    //bottom left
-                                    else if((j > 0) && (singlePxl[2][j-1] == 0))
-                                    {
-                                        sortedList->add(&inData[2][j-1]);
-                                    }
-                                    //bottom
-                                    else if(singlePxl[2][j] == 0)
-                                    {
-                                        sortedList->add(&inData[2][j]);
-                                    }
-                                    //bottom right
-                                    else if((j < width-1) && (singlePxl[2][j+1] == 0))
-                                    {
-                                        sortedList->add(&inData[2][j+1]);
-                                    }
-                                    
-                                    if(sortedList->getSize() <= 1)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = *sortedList->getMostCommonValue();
-                                        hasChangeOccured = true;
-                                    }
-                                    sortedList->clearList();
-                                }
-                            }
-                            else
+                            nIdx = (((size_t)nY) * width) + nX;
+                            if(singlesSet.count(nIdx) == 0)
                             {
-                                outData[j] = inData[1][j];
+                                neighbourVals[numVals++] = imgCache.getValue(nX, nY);
                             }
                         }
-                        else
-                        {
-                            outData[j] = inData[1][j];
-                        }
                     }
                     
-                }
-                else if(i == (height-1))
-                {
-                    clumpBand->RasterIO(GF_Read, 0, i-1, width, 1, inData[0], width, 1, GDT_UInt32, 0, 0);
-                    clumpBand->RasterIO(GF_Read, 0, i, width, 1, inData[1], width, 1, GDT_UInt32, 0, 0);
-                    singlePxlBand->RasterIO(GF_Read, 0, i-1, width, 1, singlePxl[0], width, 1, GDT_UInt32, 0, 0);
-                    singlePxlBand->RasterIO(GF_Read, 0, i, width, 1, singlePxl[1], width, 1, GDT_UInt32, 0, 0);
+                    for(unsigned int n = 0; n < numVals; ++n)
+                    {
+                        sortedList->add(&neighbourVals[n]);
+                    }
                     
-                    for(unsigned int j = 0; j < width; ++j)
+                    if(sortedList->getSize() <= 1)
                     {
-                        if((noDataValProvided & (inData[1][j] != noDataVal)) | !noDataValProvided)
-                        {
-                            if(singlePxl[1][j] == 1)
-                            {
-                                if(j == 0)
-                                {
-                                    //top
-                                    if(singlePxl[0][j] == 0)
-                                    {
-                                        sortedList->add(&inData[0][j]);
-                                    }
-                                    //top right
-                                    if((j < width-1) && (singlePxl[0][j+1] == 0))
-                                    {
-                                        sortedList->add(&inData[0][j+1]);
-                                    }
-                                    //right
-                                    else if((j < width-1) && (singlePxl[1][j+1] == 0))
-                                    {
-                                        sortedList->add(&inData[1][j+1]);
-                                    }
-                                    
-                                    if(sortedList->getSize() <= 1)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = *sortedList->getMostCommonValue();
-                                        hasChangeOccured = true;
-                                    }
-                                    sortedList->clearList();
-                                }
-                                else if(j == (width-1))
-                                {
-                                    //top left
-                                    if((j > 0) && (singlePxl[0][j-1] == 0))
-                                    {
-                                        sortedList->add(&inData[0][j-1]);
-                                    }
-                                    //top
-                                    else if(singlePxl[0][j] == 0)
-                                    {
-                                        sortedList->add(&inData[0][j]);
-                                    }
-                                    //left
-                                    else if((j > 0) && (singlePxl[1][j-1] == 0))
-                                    {
-                                        sortedList->add(&inData[1][j-1]);
-                                    }
-                                    
-                                    if(sortedList->getSize() <= 1)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = *sortedList->getMostCommonValue();
-                                        hasChangeOccured = true;
-                                    }
-                                    sortedList->clearList();
-                                }
-                                else
-                                {
-                                    //top left
-                                    if((j > 0) && (singlePxl[0][j-1] == 0))
-                                    {
-                                        sortedList->add(&inData[0][j-1]);
-                                    }
-                                    //top
-                                    else if(singlePxl[0][j] == 0)
-                                    {
-                                        sortedList->add(&inData[0][j]);
-                                    }
-                                    //top right
-                                    if((j < width-1) && (singlePxl[0][j+1] == 0))
-                                    {
-                                        sortedList->add(&inData[0][j+1]);
-                                    }
-                                    //left
-                                    else if((j > 0) && (singlePxl[1][j-1] == 0))
-                                    {
-                                        sortedList->add(&inData[1][j-1]);
-                                    }
-                                    //right
-                                    else if((j < width-1) && (singlePxl[1][j+1] == 0))
-                                    {
-                                        sortedList->add(&inData[1][j+1]);
-                                    }
-                                    
-                                    if(sortedList->getSize() <= 1)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = *sortedList->getMostCommonValue();
-                                        hasChangeOccured = true;
-                                    }
-                                    sortedList->clearList();
-                                }
-                            }
-                            else
-                            {
-                                outData[j] = inData[1][j];
-                            }
-                        }
-                        else
-                        {
-                            outData[j] = inData[1][j];
-                        }
+                        unchangedPxls.push_back(*iterPxls);
+                    }
+                    else
+                    {
+                        changedPxls.push_back(*iterPxls);
+                        changedVals.push_back(*sortedList->getMostCommonValue());
                     }
+                    sortedList->clearList();
                 }
-                else
+                
+                if(changedPxls.empty())
                 {
-                    clumpBand->RasterIO(GF_Read, 0, i-1, width, 1, inData[0], width, 1, GDT_UInt32, 0, 0);
-                    clumpBand->RasterIO(GF_Read, 0, i, width, 1, inData[1], width, 1, GDT_UInt32, 0, 0);
-                    clumpBand->RasterIO(GF_Read, 0, i+1, width, 1, inData[2], width, 1, GDT_UInt32, 0, 0);
-                    singlePxlBand->RasterIO(GF_Read, 0, i-1, width, 1, singlePxl[0], width, 1, GDT_UInt32, 0, 0);
-                    singlePxlBand->RasterIO(GF_Read, 0, i, width, 1, singlePxl[1], width, 1, GDT_UInt32, 0, 0);
-                    singlePxlBand->RasterIO(GF_Read, 0, i+1, width, 1, singlePxl[2], width, 1, GDT_UInt32, 0, 0);
-                    
-                    for(unsigned int j = 0; j < width; ++j)
+                    break;
+                }
+                hasChangeOccured = true;
+                
+                for(size_t i = 0; i < changedPxls.size(); ++i)
+                {
+                    imgCache.setValue(changedPxls.at(i) % width, changedPxls.at(i) / width, changedVals.at(i));
+                    singlesSet.erase(changedPxls.at(i));
+                }
+                
+                singles->clear();
+                for(std::vector<size_t>::iterator iterPxls = unchangedPxls.begin(); iterPxls != unchangedPxls.end(); ++iterPxls)
+                {
+                    if(this->isSinglePixel(&imgCache, (*iterPxls) % width, (*iterPxls) / width, noDataVal, noDataValProvided, filterConnectivity))
                     {
-                        if((noDataValProvided & (inData[1][j] != noDataVal)) | !noDataValProvided)
-                        {
-                            if(singlePxl[1][j] == 1)
-                            {
-                                if(j == 0)
-                                {
-                                    //top
-                                    if(singlePxl[0][j] == 0)
-                                    {
-                                        sortedList->add(&inData[0][j]);
-                                    }
-                                    //top right
-                                    else if((j < width-1) && (singlePxl[0][j+1] == 0))
-                                    {
-                                        sortedList->add(&inData[0][j+1]);
-                                    }
-                                    //right
-                                    else if((j < width-1) && (singlePxl[1][j+1] == 0))
-                                    {
-                                        sortedList->add(&inData[1][j+1]);
-                                    }
-                                    //bottom
-                                    else if(singlePxl[2][j] == 0)
-                                    {
-                                        sortedList->add(&inData[2][j]);
-                                    }
-                                    //bottom right
-                                    else if(singlePxl[2][j+1] == 0)
-                                    {
-                                        sortedList->add(&inData[2][j+1]);
-                                    }
-                                    
-                                    if(sortedList->getSize() <= 1)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = *sortedList->getMostCommonValue();
-                                        hasChangeOccured = true;
-                                    }
-                                    sortedList->clearList();
-                                }
-                                else if(j == (width-1))
-                                {
-                                    //top left
-                                    if((j > 0) && (singlePxl[0][j-1] == 0))
-                                    {
-                                        sortedList->add(&inData[0][j-1]);
-                                    }
-                                    //top
-                                    else if(singlePxl[0][j] == 0)
-                                    {
-                                        sortedList->add(&inData[0][j]);
-                                    }
-                                    //left
-                                    else if((j > 0) && (singlePxl[1][j-1] == 0))
-                                    {
-                                        sortedList->add(&inData[1][j-1]);
-                                    }
-                                    //bottom left
-                                    else if((j > 0) && (singlePxl[2][j-1] == 0))
-                                    {
-                                        sortedList->add(&inData[2][j-1]);
-                                    }
-                                    //bottom
-                                    else if(singlePxl[2][j] == 0)
-                                    {
-                                        sortedList->add(&inData[2][j]);
-                                    }
-                                    
-                                    if(sortedList->getSize() <= 1)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = *sortedList->getMostCommonValue();
-                                        hasChangeOccured = true;
-                                    }
-                                    sortedList->clearList();
-                                }
-                                else
-                                {
-                                    //top left
-                                    if((j > 0) && (singlePxl[0][j-1] == 0))
-                                    {
-                                        sortedList->add(&inData[0][j-1]);
-                                    }
-                                    //top
-                                    else if(singlePxl[0][j] == 0)
-                                    {
-                                        sortedList->add(&inData[0][j]);
-                                    }
-                                    //top right
-                                    else if((j < width-1) && (singlePxl[0][j+1] == 0))
-                                    {
-                                        sortedList->add(&inData[0][j+1]);
-                                    }
-                                    //left
-                                    else if((j > 0) && (singlePxl[1][j-1] == 0))
-                                    {
-                                        sortedList->add(&inData[1][j-1]);
-                                    }
-                                    //right
-                                    else if((j < width-1) && (singlePxl[1][j+1] == 0))
-                                    {
-                                        sortedList->add(&inData[1][j+1]);
-                                    }
-                                    //bottom left
-                                    else if((j > 0) && (singlePxl[2][j-1] == 0))
-                                    {
-                                        sortedList->add(&inData[2][j-1]);
-                                    }
-                                    //bottom
-                                    else if(singlePxl[2][j] == 0)
-                                    {
-                                        sortedList->add(&inData[2][j]);
-                                    }
-                                    //bottom right
-                                    else if(singlePxl[2][j+1] == 0)
-                                    {
-                                        sortedList->add(&inData[2][j+1]);
-                                    }
-                                    
-                                    if(sortedList->getSize() <= 1)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = *sortedList->getMostCommonValue();
-                                        hasChangeOccured = true;
-                                    }
-                                    sortedList->clearList();
-                                }
-                            }
-                            else
-                            {
-                                outData[j] = inData[1][j];
-                            }
-                        }
-                        else
-                        {
-                            outData[j] = inData[1][j];
-                        }
+                        singles->push_back(*iterPxls);
+                    }
+                    else
+                    {
+                        singlesSet.erase(*iterPxls);
                     }
                 }
-                
-                outBand->RasterIO(GF_Write, 0, i, width, 1, outData, width, 1, GDT_UInt32, 0, 0);
+                ++passCount;
+                std::cout << "Pass " << passCount << ": " << changedPxls.size() << " pixels changed, there are " << singles->size() << " single pixels remaining\n";
             }
-            std::cout << ". Complete\n";
+            
+            imgCache.flush();
             
             delete sortedList;
-            delete[] inData[0];
-            delete[] inData[1];
-            delete[] inData[2];
-            delete[] inData;
-            delete[] singlePxl[0];
-            delete[] singlePxl[1];
-            delete[] singlePxl[2];
-            delete[] singlePxl;
-            delete[] outData;
+            delete[] neighbourVals;
         }
-        catch (rsgis::img::RSGISImageCalcException &e)
+        catch (RSGISImageException &e)
         {
-            throw e;
+            throw rsgis::img::RSGISImageCalcException(e.what());
         }
         return hasChangeOccured;
     }
     
+    bool RSGISEliminateSingleClassPixels::isSinglePixel(rsgis::img::RSGISImageBlockCache<unsigned int> *imgCache, unsigned int x, unsigned int y, float noDataVal, bool noDataValProvided, rsgis::img::RSGISRasterConnectivity filterConnectivity)
+    {
+        unsigned int val = imgCache->getValue(x, y);
+        if(noDataValProvided && (val == noDataVal))
+        {
+            return false;
+        }
+        
+        long width = imgCache->getWidth();
+        long height = imgCache->getHeight();
+        long cX = x;
+        long cY = y;
+        for(long nY = cY-1; nY <= cY+1; ++nY)
+        {
+            for(long nX = cX-1; nX <= cX+1; ++nX)
+            {
+                if((nX < 0) || (nX >= width) || (nY < 0) || (nY >= height) || ((nX == cX) && (nY == cY)))
+                {
+                    continue;
+                }
+                if((filterConnectivity == rsgis::img::rsgis_4connect) && (nX != cX) && (nY != cY))
+                {
+                    continue;
+                }
+                if(imgCache->getValue(nX, nY) == val)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+    
     unsigned int RSGISEliminateSingleClassPixels::findMostCommonVal(std::vector<unsigned int> values)
     {
         return 0;
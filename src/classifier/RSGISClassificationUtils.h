@@ -28,6 +28,7 @@
 #include <fstream>
 #include <string>
 #include <vector>
+#include <unordered_set>
 
 #include "common/RSGISClassificationException.h"
 
@@ -42,6 +43,7 @@
 
 #include "img/RSGISImageUtils.h"
 #include "img/RSGISImageCalcException.h"
+#include "img/RSGISImageBlockCache.h"
 
 #include "datastruct/SortedGenericList.cpp"
 
@@ -80,6 +82,12 @@ namespace rsgis{ namespace classifier{
         ~RSGISClassificationUtils();
     };
     
+    /**
+     * Replaces pixels which have no neighbour of the same class with the most common
+     * class of their neighbours. The single pixels are found in one pass of the image
+     * (also written to tmpData) and then only those pixels are revisited, through a
+     * block cache of the output image, until none remain or none can be changed.
+     */
     class DllExport RSGISEliminateSingleClassPixels
     {
     public:
@@ -87,10 +95,10 @@ namespace rsgis{ namespace classifier{
         void eliminate(GDALDataset *inImageData, GDALDataset *tmpData, std::string outputImage, float noDataVal, bool noDataValProvided, std::string format, rsgis::img::RSGISRasterConnectivity filterConnectivity);
         ~RSGISEliminateSingleClassPixels();
     private:
-        unsigned long findSinglePixelsConnect4(GDALDataset *inImageData, GDALDataset *tmpData, float noDataVal, bool noDataValProvided);
-        bool eliminateSinglePixelsConnect4(GDALDataset *inImageData, GDALDataset *tmpData, GDALDataset *outDataset, float noDataVal, bool noDataValProvided);
-        unsigned long findSinglePixelsConnect8(GDALDataset *inImageData, GDALDataset *tmpData, float noDataVal, bool noDataValProvided);
-        bool eliminateSinglePixelsConnect8(GDALDataset *inImageData, GDALDataset *tmpData, GDALDataset *outDataset, float noDataVal, bool noDataValProvided);
+        unsigned long findSinglePixelsConnect4(GDALDataset *inImageData, GDALDataset *tmpData, float noDataVal, bool noDataValProvided, std::vector<size_t> *singles);
+        unsigned long findSinglePixelsConnect8(GDALDataset *inImageData, GDALDataset *tmpData, float noDataVal, bool noDataValProvided, std::vector<size_t> *singles);
+        bool eliminateSinglePixels(GDALDataset *imageData, std::vector<size_t> *singles, float noDataVal, bool noDataValProvided, rsgis::img::RSGISRasterConnectivity filterConnectivity);
+        bool isSinglePixel(rsgis::img::RSGISImageBlockCache<unsigned int> *imgCache, unsigned int x, unsigned int y, float noDataVal, bool noDataValProvided, rsgis::img::RSGISRasterConnectivity filterConnectivity);
         unsigned int findMostCommonVal(std::vector<unsigned int> values);
     };
 	
@@ -71,8 +71,6 @@ namespace rsgis{namespace classifier{
             double tlY = 0;
             double xRes = 0;
             double yRes = 0;
-            unsigned int imgSizeX = 0;
-            unsigned int imgSizeY = 0;
             double demTlX = 0;
             double demTlY = 0;
             double demXRes = 0;
@@ -91,8 +89,6 @@ namespace rsgis{namespace classifier{
             {
                 yRes = yRes * (-1);
             }
-            imgSizeX = inputImage->GetRasterXSize();
-            imgSizeY = inputImage->GetRasterYSize();
             
             if(demProvided)
             {
@@ -111,10 +107,12 @@ namespace rsgis{namespace classifier{
             }
             delete[] trans;
             
-            srand(seed);
+            // Every pixel with a row in the attribute table (other than 0) can be sampled.
+            std::vector<long> rowStrata(numRows, 0);
+            rowStrata.at(0) = -1;
+            rsgis::img::RSGISStratifiedRandomSampler *sampler = this->sampleClassPixels(inputImage, &rowStrata, std::vector<std::string>(1, "all classes"), numPts, seed);
+            std::vector<rsgis::img::RSGISSamplePxl> *samples = sampler->getSamples(0);
             
-            unsigned int xPxl = 0;
-            unsigned int yPxl = 0;
             double eastings = 0;
             double northings = 0;
             float demVal = 0;
@@ -123,13 +121,10 @@ namespace rsgis{namespace classifier{
             RSGISAccPoint *tmpAccPt = NULL;
             std::list<RSGISAccPoint*> *accPts = new std::list<RSGISAccPoint*>();
             
-            while(accPts->size() < numPts)
+            for(std::vector<rsgis::img::RSGISSamplePxl>::iterator iterPxls = samples->begin(); iterPxls != samples->end(); ++iterPxls)
             {
-                xPxl = rand() % imgSizeX;
-                yPxl = rand() % imgSizeY;
-                
-                eastings = tlX + (((double)xPxl)*xRes);
-                northings = tlY - (((double)yPxl)*yRes);
+                eastings = tlX + (((double)(*iterPxls).xPxl)*xRes);
+                northings = tlY - (((double)(*iterPxls).yPxl)*yRes);
                 
                 if(demProvided)
                 {
@@ -147,31 +142,21 @@ namespace rsgis{namespace classifier{
                     demVal = 0;
                 }
                 
-                try
-                {
-                    classVal = findClassVal(inputImage, 1, attTable, inClassColIdx, xPxl, yPxl);
-                    
-                    tmpAccPt = new RSGISAccPoint();
-                    tmpAccPt->ptID = accPts->size()+1;
-                    tmpAccPt->eastings = eastings;
-                    tmpAccPt->northings = northings;
-                    tmpAccPt->elevation = demVal;
-                    tmpAccPt->mapClassName = classVal;
-                    tmpAccPt->trueClassName = classVal;
-                    tmpAccPt->status = -1;
-                    tmpAccPt->comment = "";
-                    
-                    accPts->push_back(tmpAccPt);
-                }
-                catch (rsgis::RSGISImageException &e)
-                {
-                    // Ignore as class not found...
-                }
-                catch (std::exception &e)
-                {
-                    throw rsgis::RSGISImageException(e.what());
-                }
-            }           
+                classVal = boost::trim_all_copy(std::string(attTable->GetValueAsString((*iterPxls).pxlVal, inClassColIdx)));
+                
+                tmpAccPt = new RSGISAccPoint();
+                tmpAccPt->ptID = accPts->size()+1;
+                tmpAccPt->eastings = eastings;
+                tmpAccPt->northings = northings;
+                tmpAccPt->elevation = demVal;
+                tmpAccPt->mapClassName = classVal;
+                tmpAccPt->trueClassName = classVal;
+                tmpAccPt->status = -1;
+                tmpAccPt->comment = "";
+                
+                accPts->push_back(tmpAccPt);
+            }
+            delete sampler;
             
             std::ofstream outFile;
             
@@ -276,8 +261,6 @@ namespace rsgis{namespace classifier{
             double tlY = 0;
             double xRes = 0;
             double yRes = 0;
-            unsigned int imgSizeX = 0;
-            unsigned int imgSizeY = 0;
             double demTlX = 0;
             double demTlY = 0;
             double demXRes = 0;
@@ -296,8 +279,6 @@ namespace rsgis{namespace classifier{
             {
                 yRes = yRes * (-1);
             }
-            imgSizeX = inputImage->GetRasterXSize();
-            imgSizeY = inputImage->GetRasterYSize();
             
             if(demProvided)
             {
@@ -331,89 +312,68 @@ namespace rsgis{namespace classifier{
             }
             
             
-            srand(seed);
+            // Map the attribute table rows to the class they belong to.
+            std::vector<long> rowStrata(numRows, -1);
+            std::vector<std::string> classNames(classes->begin(), classes->end());
+            std::map<std::string, size_t>::iterator iterMap;
+            for(int i = 1; i < numRows; ++i)
+            {
+                iterMap = classesLookUp.find(boost::trim_all_copy(std::string(attTable->GetValueAsString(i, inClassColIdx))));
+                if(iterMap != classesLookUp.end())
+                {
+                    rowStrata.at(i) = iterMap->second;
+                }
+            }
+            
+            std::cout << "Number of points to be generated: " << (classes->size() * numPts) << std::endl;
+            rsgis::img::RSGISStratifiedRandomSampler *sampler = this->sampleClassPixels(inputImage, &rowStrata, classNames, numPts, seed);
             
-            unsigned int xPxl = 0;
-            unsigned int yPxl = 0;
             double eastings = 0;
             double northings = 0;
             float demVal = 0;
-            std::string classVal = "";
-            std::map<std::string, size_t>::iterator iterMap;
             
             RSGISAccPoint *tmpAccPt = NULL;
-            
-            unsigned long totalNumPtsRequired = classes->size() * numPts;
             unsigned long ptsCount = 0;
             
-            
-            std::cout << "Number of points to be generated: " << totalNumPtsRequired << std::endl;
-            
-            while(ptsCount < totalNumPtsRequired)
+            for(idx = 0; idx < classNames.size(); ++idx)
             {
-                std::cout << "Completed " << floor((((double)ptsCount)/((double)totalNumPtsRequired))*100) << " %\r" << std::flush;
-                
-                xPxl = rand() % imgSizeX;
-                yPxl = rand() % imgSizeY;
-                                
-                eastings = tlX + (((double)xPxl)*xRes);
-                northings = tlY - (((double)yPxl)*yRes);
-                                
-                try
+                std::vector<rsgis::img::RSGISSamplePxl> *samples = sampler->getSamples(idx);
+                for(std::vector<rsgis::img::RSGISSamplePxl>::iterator iterPxls = samples->begin(); iterPxls != samples->end(); ++iterPxls)
                 {
-                    classVal = findClassVal(inputImage, 1, attTable, inClassColIdx, xPxl, yPxl);
-                                       
-                    iterMap = classesLookUp.find(classVal);
+                    eastings = tlX + (((double)(*iterPxls).xPxl)*xRes);
+                    northings = tlY - (((double)(*iterPxls).yPxl)*yRes);
                     
-                    if(iterMap == classesLookUp.end())
+                    if(demProvided)
                     {
-                        rsgis::RSGISImageException("Class name was not found!");
-                    }
-                    
-                    idx = iterMap->second;
-                    
-                    if(accClassPts->at(idx).size() < numPts)
-                    {
-                        if(demProvided)
+                        try
                         {
-                            try
-                            {
-                                demVal = findPixelVal(inputDEM, 1, eastings, northings, demTlX, demTlY, demXRes, demYRes, demSizeX, demSizeY);
-                            }
-                            catch (rsgis::RSGISImageException &e)
-                            {
-                                demVal = -99999;
-                            }
+                            demVal = findPixelVal(inputDEM, 1, eastings, northings, demTlX, demTlY, demXRes, demYRes, demSizeX, demSizeY);
                         }
-                        else
+                        catch (rsgis::RSGISImageException &e)
                         {
-                            demVal = 0;
+                            demVal = -99999;
                         }
-                        
-                        tmpAccPt = new RSGISAccPoint();
-                        tmpAccPt->ptID = ptsCount+1;
-                        tmpAccPt->eastings = eastings;
-                        tmpAccPt->northings = northings;
-                        tmpAccPt->elevation = demVal;
-                        tmpAccPt->mapClassName = classVal;
-                        tmpAccPt->trueClassName = classVal;
-                        tmpAccPt->status = -1;
-                        tmpAccPt->comment = "";
-                        
-                        accClassPts->at(idx).push_back(tmpAccPt);
-                        
-                        ++ptsCount;
-                    }                    
-                }
-                catch (rsgis::RSGISImageException &e)
-                {
-                    // Ignore as class not found...
-                }
-                catch (std::exception &e)
-                {
-                    throw rsgis::RSGISImageException(e.what());
+                    }
+                    else
+                    {
+                        demVal = 0;
+                    }
+                    
+                    tmpAccPt = new RSGISAccPoint();
+                    tmpAccPt->ptID = ptsCount+1;
+                    tmpAccPt->eastings = eastings;
+                    tmpAccPt->northings = northings;
+                    tmpAccPt->elevation = demVal;
+                    tmpAccPt->mapClassName = classNames.at(idx);
+                    tmpAccPt->trueClassName = classNames.at(idx);
+                    tmpAccPt->status = -1;
+                    tmpAccPt->comment = "";
+                    
+                    accClassPts->at(idx).push_back(tmpAccPt);
+                    ++ptsCount;
                 }
             }
+            delete sampler;
             
             
             std::ofstream outFile;
@@ -486,8 +446,6 @@ namespace rsgis{namespace classifier{
             double tlY = 0;
             double xRes = 0;
             double yRes = 0;
-            unsigned int imgSizeX = 0;
-            unsigned int imgSizeY = 0;
             
             // Get Transformation for Image
             double *trans = new double[6];
@@ -500,62 +458,35 @@ namespace rsgis{namespace classifier{
             {
                 yRes = yRes * (-1);
             }
-            imgSizeX = inputImage->GetRasterXSize();
-            imgSizeY = inputImage->GetRasterYSize();
             
             delete[] trans;
             
-            srand(seed);
-            
-            unsigned int xPxl = 0;
-            unsigned int yPxl = 0;
-            double eastings = 0;
-            double northings = 0;
-            std::string classVal = "";
-            long pxlVal = 0.0;
+            std::vector<long> rowStrata(imgClassColVals->size(), 0);
+            if(!rowStrata.empty())
+            {
+                rowStrata.at(0) = -1;
+            }
+            rsgis::img::RSGISStratifiedRandomSampler *sampler = this->sampleClassPixels(inputImage, &rowStrata, std::vector<std::string>(1, "all classes"), numPts, seed);
+            std::vector<rsgis::img::RSGISSamplePxl> *samples = sampler->getSamples(0);
             
             RSGISAccPoint *tmpAccPt = NULL;
             std::list<RSGISAccPoint*> *accPts = new std::list<RSGISAccPoint*>();
             
-            while(accPts->size() < numPts)
+            for(std::vector<rsgis::img::RSGISSamplePxl>::iterator iterPxls = samples->begin(); iterPxls != samples->end(); ++iterPxls)
             {
-                xPxl = rand() % imgSizeX;
-                yPxl = rand() % imgSizeY;
-                
-                eastings = tlX + (((double)xPxl)*xRes);
-                northings = tlY - (((double)yPxl)*yRes);
+                tmpAccPt = new RSGISAccPoint();
+                tmpAccPt->ptID = accPts->size()+1;
+                tmpAccPt->eastings = tlX + (((double)(*iterPxls).xPxl)*xRes);
+                tmpAccPt->northings = tlY - (((double)(*iterPxls).yPxl)*yRes);
+                tmpAccPt->elevation = 0.0;
+                tmpAccPt->mapClassName = imgClassColVals->at((*iterPxls).pxlVal);
+                tmpAccPt->trueClassName = "";
+                tmpAccPt->status = -1;
+                tmpAccPt->comment = "";
                 
-                
-                try
-                {
-                    pxlVal = long(this->findPixelVal(inputImage, 1, eastings, northings, tlX, tlY, xRes, yRes, imgSizeX, imgSizeY));
-                    
-                    if((pxlVal > 0) & (pxlVal < imgClassColVals->size()))
-                    {
-                        classVal = imgClassColVals->at(pxlVal);
-                        
-                        tmpAccPt = new RSGISAccPoint();
-                        tmpAccPt->ptID = accPts->size()+1;
-                        tmpAccPt->eastings = eastings;
-                        tmpAccPt->northings = northings;
-                        tmpAccPt->elevation = 0.0;
-                        tmpAccPt->mapClassName = classVal;
-                        tmpAccPt->trueClassName = "";
-                        tmpAccPt->status = -1;
-                        tmpAccPt->comment = "";
-                        
-                        accPts->push_back(tmpAccPt);
-                    }
-                }
-                catch (rsgis::RSGISImageException &e)
-                {
-                    // Ignore as class not found...
-                }
-                catch (std::exception &e)
-                {
-                    throw rsgis::RSGISImageException(e.what());
-                }
+                accPts->push_back(tmpAccPt);
             }
+            delete sampler;
             
             std::ofstream outFile;
             
@@ -678,8 +609,6 @@ namespace rsgis{namespace classifier{
             double tlY = 0;
             double xRes = 0;
             double yRes = 0;
-            unsigned int imgSizeX = 0;
-            unsigned int imgSizeY = 0;
             
             // Get Transformation for Image
             double *trans = new double[6];
@@ -692,82 +621,47 @@ namespace rsgis{namespace classifier{
             {
                 yRes = yRes * (-1);
             }
-            imgSizeX = inputImage->GetRasterXSize();
-            imgSizeY = inputImage->GetRasterYSize();
             
             delete[] trans;
             
-            srand(seed);
+            // Map the attribute table rows to the class they belong to.
+            std::vector<std::string> classNamesVec(classNames->begin(), classNames->end());
+            std::vector<long> rowStrata(histogram->size(), -1);
+            std::map<std::string, size_t>::iterator iterMap;
+            for(size_t i = 1; i < histogram->size(); ++i)
+            {
+                iterMap = classesLookUp.find(imgClassColVals->at(i));
+                if(iterMap != classesLookUp.end())
+                {
+                    rowStrata.at(i) = iterMap->second;
+                }
+            }
             
-            unsigned int xPxl = 0;
-            unsigned int yPxl = 0;
-            double eastings = 0;
-            double northings = 0;
-            std::string classVal = "";
-            long pxlVal = 0.0;
+            std::cout << "Number of points to be generated: " << (classNames->size() * numPts) << std::endl;
+            rsgis::img::RSGISStratifiedRandomSampler *sampler = this->sampleClassPixels(inputImage, &rowStrata, classNamesVec, numPts, seed);
             
             RSGISAccPoint *tmpAccPt = NULL;
-            std::map<std::string, size_t>::iterator iterMap;
-            
-            unsigned long totalNumPtsRequired = classNames->size() * numPts;
             unsigned long ptsCount = 0;
-            
-            std::cout << "Number of points to be generated: " << totalNumPtsRequired << std::endl;
-            
-            while(ptsCount < totalNumPtsRequired)
+            for(idx = 0; idx < classNamesVec.size(); ++idx)
             {
-                std::cout << "Completed " << floor((((double)ptsCount)/((double)totalNumPtsRequired))*100) << " %\r" << std::flush;
-                
-                xPxl = rand() % imgSizeX;
-                yPxl = rand() % imgSizeY;
-                
-                eastings = tlX + (((double)xPxl)*xRes);
-                northings = tlY - (((double)yPxl)*yRes);
-                
-                try
+                std::vector<rsgis::img::RSGISSamplePxl> *samples = sampler->getSamples(idx);
+                for(std::vector<rsgis::img::RSGISSamplePxl>::iterator iterPxls = samples->begin(); iterPxls != samples->end(); ++iterPxls)
                 {
-                    pxlVal = long(this->findPixelVal(inputImage, 1, eastings, northings, tlX, tlY, xRes, yRes, imgSizeX, imgSizeY));
+                    tmpAccPt = new RSGISAccPoint();
+                    tmpAccPt->ptID = ptsCount+1;
+                    tmpAccPt->eastings = tlX + (((double)(*iterPxls).xPxl)*xRes);
+                    tmpAccPt->northings = tlY - (((double)(*iterPxls).yPxl)*yRes);
+                    tmpAccPt->elevation = 0.0;
+                    tmpAccPt->mapClassName = classNamesVec.at(idx);
+                    tmpAccPt->trueClassName = "";
+                    tmpAccPt->status = -1;
+                    tmpAccPt->comment = "";
                     
-                    if((pxlVal > 0) & (pxlVal < imgClassColVals->size()))
-                    {
-                        classVal = imgClassColVals->at(pxlVal);
-                        
-                        iterMap = classesLookUp.find(classVal);
-                        
-                        if(iterMap == classesLookUp.end())
-                        {
-                            rsgis::RSGISImageException("Class name was not found!");
-                        }
-                        
-                        idx = iterMap->second;
-                        
-                        if(accClassPts->at(idx).size() < numPts)
-                        {
-                            tmpAccPt = new RSGISAccPoint();
-                            tmpAccPt->ptID = ptsCount+1;
-                            tmpAccPt->eastings = eastings;
-                            tmpAccPt->northings = northings;
-                            tmpAccPt->elevation = 0.0;
-                            tmpAccPt->mapClassName = classVal;
-                            tmpAccPt->trueClassName = "";
-                            tmpAccPt->status = -1;
-                            tmpAccPt->comment = "";
-                        
-                            accClassPts->at(idx).push_back(tmpAccPt);
-                            
-                            ++ptsCount;
-                        }
-                    }
-                }
-                catch (rsgis::RSGISImageException &e)
-                {
-                    // Ignore as class not found...
-                }
-                catch (std::exception &e)
-                {
-                    throw rsgis::RSGISImageException(e.what());
+                    accClassPts->at(idx).push_back(tmpAccPt);
+                    ++ptsCount;
                 }
             }
+            delete sampler;
             
             OGRFieldDefn imgClassField(vecClassImgCol.c_str(), OFTString);
             imgClassField.SetWidth(254);
@@ -876,29 +770,30 @@ namespace rsgis{namespace classifier{
             }
             
             unsigned long numClasses = classNames->size();
-            std::vector<std::pair<double, double> > **classPxlLst = new std::vector<std::pair<double, double> >*[numClasses];
-            unsigned int idx = 0;
             for(std::vector<std::string>::iterator iterClasses = classNames->begin(); iterClasses != classNames->end(); ++iterClasses)
             {
                 std::cout << "Class: \'" <<  *iterClasses << "\'" << std::endl;
-                classPxlLst[idx] = new std::vector<std::pair<double, double> >();
-                ++idx;
             }
             
-            rsgis::img::RSGISCalcImageValue *exClassPxlLocs = new RSGISExtractClassPxllocs(classPxlLst, numClasses);
-            rsgis::img::RSGISCalcImage calcImg = rsgis::img::RSGISCalcImage(exClassPxlLocs);
-            calcImg.calcImageExtent(&inputImage, 1, 0);
-            delete exClassPxlLocs;
-            
-            bool **usedPxl = new bool*[numClasses];
+            // Pixel values 1 to numClasses are the classes in the order they were found.
+            std::vector<long> pxlValStrata(numClasses+1, -1);
             for(unsigned long i = 0; i < numClasses; ++i)
             {
-                usedPxl[i] = new bool[classPxlLst[i]->size()];
-                for(unsigned long j = 0; j < classPxlLst[i]->size(); ++j)
-                {
-                    usedPxl[i][j] = false;
-                }
+                pxlValStrata.at(i+1) = i;
+            }
+            rsgis::img::RSGISStratifiedRandomSampler *sampler = this->sampleClassPixels(inputImage, &pxlValStrata, *classNames, numPts, seed);
+            
+            double *trans = new double[6];
+            inputImage->GetGeoTransform(trans);
+            double tlX = trans[0];
+            double tlY = trans[3];
+            double xRes = trans[1];
+            double yRes = trans[5];
+            if(yRes < 0)
+            {
+                yRes = yRes * (-1);
             }
+            delete[] trans;
             
             OGRFieldDefn imgClassField(vecClassImgCol.c_str(), OFTString);
             imgClassField.SetWidth(254);
@@ -927,52 +822,13 @@ namespace rsgis{namespace classifier{
             int imgClassColIdx = featDefn->GetFieldIndex(vecClassImgCol.c_str());
             int refClassColIdx = featDefn->GetFieldIndex(vecClassRefCol.c_str());
             int processedColIdx = featDefn->GetFieldIndex("Processed");
-            unsigned long pxlIdx = 0;
-            bool foundPxl = false;
-            unsigned long findPxlIterCount = 0;
-            unsigned long checkPt = 0;
-            bool usedAllPxls = false;
             for(unsigned long i = 0; i < numClasses; ++i)
             {
-                std::cout << "Processing Class \"" << classNames->at(i) << "\"\n";
-                srand(seed);
-                checkPt = classPxlLst[i]->size();
-                for(unsigned long j = 0; j < numPts; ++j)
+                std::vector<rsgis::img::RSGISSamplePxl> *samples = sampler->getSamples(i);
+                for(std::vector<rsgis::img::RSGISSamplePxl>::iterator iterPxls = samples->begin(); iterPxls != samples->end(); ++iterPxls)
                 {
-                    foundPxl = false;
-                    while(!foundPxl)
-                    {
-                        pxlIdx = rand() % classPxlLst[i]->size();
-                        if(!usedPxl[i][pxlIdx])
-                        {
-                            foundPxl = true;
-                            usedPxl[i][pxlIdx] = true;
-                        }
-                        else if(findPxlIterCount > checkPt)
-                        {
-                            usedAllPxls = true;
-                            for(unsigned long n = 0; n < classPxlLst[i]->size(); ++n)
-                            {
-                                if(!usedPxl[i][n])
-                                {
-                                    usedAllPxls = false;
-                                    break;
-                                }
-                            }
-                            
-                            if(usedAllPxls)
-                            {
-                                rsgis::utils::RSGISTextUtils txtUtils;
-                                throw rsgis::RSGISImageException("All pixels (n="+txtUtils.sizettostring(classPxlLst[i]->size())+") for class \""+classNames->at(i)+"\" have been sampled within the image");
-                            }
-                            checkPt = checkPt + classPxlLst[i]->size();
-                        }
-                        
-                        ++findPxlIterCount;
-                    }
-                    
                     OGRFeature *poFeature = new OGRFeature(featDefn);
-                    OGRPoint *pt = new OGRPoint(classPxlLst[i]->at(pxlIdx).first, classPxlLst[i]->at(pxlIdx).second, 0.0);
+                    OGRPoint *pt = new OGRPoint(tlX + ((((double)(*iterPxls).xPxl)+0.5)*xRes), tlY - ((((double)(*iterPxls).yPxl)+0.5)*yRes), 0.0);
                     poFeature->SetGeometryDirectly(pt);
                     
                     poFeature->SetField(imgClassColIdx, classNames->at(i).c_str());
@@ -980,15 +836,12 @@ namespace rsgis{namespace classifier{
                     poFeature->SetField(processedColIdx, 0);
                     
                     outputSHPLayer->CreateFeature(poFeature);
+                    OGRFeature::DestroyFeature(poFeature);
                 }
             }
             
+            delete sampler;
             delete classNames;
-            for(idx = 0; idx < numClasses; ++idx)
-            {
-                delete classPxlLst[idx];
-            }
-            delete[] classPxlLst;
         }
         catch(rsgis::RSGISImageException &e)
         {
@@ -1180,6 +1033,32 @@ namespace rsgis{namespace classifier{
     }
     
     
+    rsgis::img::RSGISStratifiedRandomSampler* RSGISGenAccuracyPoints::sampleClassPixels(GDALDataset *inputImage, std::vector<long> *pxlValStrata, std::vector<std::string> classNames, unsigned int numPts, unsigned int seed)
+    {
+        rsgis::img::RSGISStratifiedRandomSampler *sampler = new rsgis::img::RSGISStratifiedRandomSampler(classNames.size(), numPts, seed);
+        try
+        {
+            sampler->samplePixels(inputImage, 1, pxlValStrata);
+        }
+        catch(rsgis::RSGISImageException &e)
+        {
+            delete sampler;
+            throw e;
+        }
+        
+        for(unsigned int i = 0; i < classNames.size(); ++i)
+        {
+            if(!sampler->foundAllSamples(i))
+            {
+                rsgis::utils::RSGISTextUtils txtUtils;
+                std::string message = "All pixels (n="+txtUtils.uInt64bittostring(sampler->getNumPxls(i))+") for class \""+classNames.at(i)+"\" have been sampled within the image";
+                delete sampler;
+                throw rsgis::RSGISImageException(message);
+            }
+        }
+        return sampler;
+    }
+    
     float RSGISGenAccuracyPoints::findPixelVal(GDALDataset *image, unsigned int band, double eastings, double northings, double tlX, double tlY, double xRes, double yRes, unsigned int xSize, unsigned int ySize)
     {
         
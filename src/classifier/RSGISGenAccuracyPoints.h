@@ -40,6 +40,8 @@
 
 #include "rastergis/RSGISRasterAttUtils.h"
 
+#include "img/RSGISStratifiedRandomSampler.h"
+
 #include <boost/algorithm/string/trim_all.hpp>
 
 // mark all exported classes/functions with DllExport to have
@@ -117,6 +119,8 @@ namespace rsgis{namespace classifier{
         float findPixelVal(GDALDataset *image, unsigned int band, double eastings, double northings, double tlX, double tlY, double xRes, double yRes, unsigned int xSize, unsigned int ySize);
         std::string findClassVal(GDALDataset *image, unsigned int band, GDALRasterAttributeTable *attTable, unsigned int classNameColIdx, unsigned int xPxl, unsigned int yPxl);
         std::list<std::string>* findUniqueClasses(GDALRasterAttributeTable *attTable, unsigned int classNameColIdx, int histoColIdx);
+        /** Reads band 1 once selecting numPts pixels for each class (pxlValStrata maps pixel values to the class index); throws if a class has too few pixels. */
+        rsgis::img::RSGISStratifiedRandomSampler* sampleClassPixels(GDALDataset *inputImage, std::vector<long> *pxlValStrata, std::vector<std::string> classNames, unsigned int numPts, unsigned int seed);
     };
     
     class DllExport RSGISExtractClassPxllocs : public rsgis::img::RSGISCalcImageValue
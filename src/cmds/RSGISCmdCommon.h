@@ -25,6 +25,8 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include <utility>
 
 // mark all exported classes/functions with DllExport to have
 // them exported by Visual Studio
@@ -59,6 +61,22 @@ namespace rsgis{ namespace cmds {
         double mode;
     };
     
+    /** The image I/O options of a command (see rsgis::img::RSGISImageIOPolicy); the constructor gives the defaults of the policy. */
+    struct DllExport RSGISImageIOOptionsCmds
+    {
+        RSGISImageIOOptionsCmds():cacheMax(0), tiled(true), blockSize(256), compression(""), compressionLevel(-1), numThreads(1), buildOverviews(false), overviewResampling("AVERAGE"), minOverviewSize(256){};
+        long long cacheMax;
+        bool tiled;
+        unsigned int blockSize;
+        std::string compression;
+        int compressionLevel;
+        unsigned int numThreads;
+        std::vector<std::pair<std::string, std::string> > creationOptions;
+        bool buildOverviews;
+        std::string overviewResampling;
+        unsigned int minOverviewSize;
+    };
+    
 }}
 
 
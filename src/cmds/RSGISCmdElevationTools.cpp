@@ -222,7 +222,7 @@ namespace rsgis{ namespace cmds {
     }
 
     
-    void executeCalcShadowMask(std::string demImage, std::string outputImage, float solarAzimuth, float solarZenith, float maxHeight, std::string outImageFormat)
+    void executeCalcShadowMask(std::string demImage, std::string outputImage, float solarAzimuth, float solarZenith, float maxHeight, std::string outImageFormat, unsigned int numThreads)
     {
         try
         {
@@ -255,32 +255,66 @@ namespace rsgis{ namespace cmds {
                 throw rsgis::RSGISException("The DEM image file does not have a no data value defined. ");
             }
             
-            double *transformation = new double[6];
-            dataset->GetGeoTransform(transformation);
+            rsgis::img::RSGISImageUtils imgUtils;
+            GDALDataset *outImgDS = imgUtils.createCopy(dataset, 1, outputImage, outImageFormat, GDT_Byte);
             
-            float imageEWRes = transformation[1];
-            float imageNSRes = transformation[5];
+            // The horizon sweep has no upper limit on the ray so maxHeight is no longer required.
+            rsgis::calib::RSGISCalcDEMHorizons calcHorizons(dataset, 1, demNoDataVal, numThreads);
+            calcHorizons.calcShadowMask(outImgDS, solarZenith, solarAzimuth);
             
-            if(imageNSRes < 0)
+            GDALClose(dataset);
+            GDALClose(outImgDS);
+        }
+        catch(rsgis::RSGISException &e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception &e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+    }
+    
+    void executeCalcSkyViewFactor(std::string demImage, std::string outputImage, unsigned int numDirections, std::string outImageFormat, unsigned int numThreads)
+    {
+        try
+        {
+            GDALAllRegister();
+            
+            std::cout << "Open " << demImage << std::endl;
+            GDALDataset *dataset = (GDALDataset *) GDALOpen(demImage.c_str(), GA_ReadOnly);
+            if(dataset == NULL)
             {
-                imageNSRes = imageNSRes * (-1);
+                std::string message = std::string("Could not open image ") + demImage;
+                throw rsgis::RSGISImageException(message.c_str());
             }
             
-            delete[] transformation;
-            
-            rsgis::calib::RSGISCalcShadowBinaryMask *calcShadowMask = new rsgis::calib::RSGISCalcShadowBinaryMask(1, dataset, 0, imageEWRes, imageNSRes, solarZenith, solarAzimuth, maxHeight, demNoDataVal);
+            double demNoDataVal = 0.0;
+            int demNoDataValAvail = false;
+            demNoDataVal = dataset->GetRasterBand(1)->GetNoDataValue(&demNoDataValAvail);
+            if(!demNoDataValAvail)
+            {
+                GDALClose(dataset);
+                throw rsgis::RSGISException("The DEM image file does not have a no data value defined. ");
+            }
             
-            rsgis::img::RSGISCalcImage calcImage = rsgis::img::RSGISCalcImage(calcShadowMask, "", true);
+            rsgis::img::RSGISImageUtils imgUtils;
+            GDALDataset *outImgDS = imgUtils.createCopy(dataset, 1, outputImage, outImageFormat, GDT_Float32);
             
-            calcImage.calcImageWindowDataExtent(&dataset, 1, outputImage, 3, outImageFormat, GDT_Byte);
+            rsgis::calib::RSGISCalcDEMHorizons calcHorizons(dataset, 1, demNoDataVal, numThreads);
+            calcHorizons.calcSkyViewFactor(outImgDS, numDirections);
             
             GDALClose(dataset);
-            delete calcShadowMask;
+            GDALClose(outImgDS);
         }
         catch(rsgis::RSGISException &e)
         {
             throw RSGISCmdException(e.what());
         }
+        catch(std::exception &e)
+        {
+            throw RSGISCmdException(e.what());
+        }
     }
 
     
@@ -439,7 +473,7 @@ namespace rsgis{ namespace cmds {
         }
     }
     
-    void executeDEMFillSoilleGratin1994(std::string inImage, std::string validDataImg, std::string outputImage, std::string outImageFormat)
+    void executeDEMFillSoilleGratin1994(std::string inImage, std::string validDataImg, std::string outputImage, std::string outImageFormat, unsigned int tileSize)
     {
         try
         {
@@ -461,16 +495,16 @@ namespace rsgis{ namespace cmds {
             }
             
             GDALDataType imgDT = inImgDS->GetRasterBand(1)->GetRasterDataType();
-            if((imgDT == GDT_Float32) | (imgDT == GDT_Float64) | (imgDT == GDT_Unknown) | (imgDT == GDT_CInt16) | (imgDT == GDT_CInt32) | (imgDT == GDT_CFloat32) | (imgDT == GDT_CFloat64))
+            if((imgDT == GDT_Unknown) | (imgDT == GDT_CInt16) | (imgDT == GDT_CInt32) | (imgDT == GDT_CFloat32) | (imgDT == GDT_CFloat64))
             {
-                throw rsgis::RSGISImageException("Input image must be of an integer data type.");
+                throw rsgis::RSGISImageException("Input image must be of a real (non-complex) data type.");
             }
             
             rsgis::img::RSGISImageUtils imgUtils;
             GDALDataset *outImgDS = imgUtils.createCopy(inImgDS, 1, outputImage, outImageFormat, imgDT);
             
             rsgis::calib::RSGISHydroDEMFillSoilleGratin94 fillDEMInst;
-            fillDEMInst.performSoilleGratin94Fill(inImgDS, inValidImgDS, outImgDS, true);
+            fillDEMInst.performSoilleGratin94Fill(inImgDS, inValidImgDS, outImgDS, true, 0, tileSize);
             
             GDALClose(inImgDS);
             GDALClose(inValidImgDS);
@@ -60,8 +60,10 @@ namespace rsgis{ namespace cmds {
     DllExport void executeCatagoriseAspect(std::string aspectImage, std::string outputImage, std::string outImageFormat);
     /** A function to generate a hillshade layer */
     DllExport void executeCalcHillshade(std::string demImage, std::string outputImage, float solarAzimuth, float solarZenith, std::string outImageFormat);
-    /** A function to generate a shadow mask layer */
-    DllExport void executeCalcShadowMask(std::string demImage, std::string outputImage, float solarAzimuth, float solarZenith, float maxHeight, std::string outImageFormat);
+    /** A function to generate a shadow mask layer (maxHeight is ignored, retained for compatibility) */
+    DllExport void executeCalcShadowMask(std::string demImage, std::string outputImage, float solarAzimuth, float solarZenith, float maxHeight, std::string outImageFormat, unsigned int numThreads=1);
+    /** A function to calculate the sky view factor for each pixel within a DEM */
+    DllExport void executeCalcSkyViewFactor(std::string demImage, std::string outputImage, unsigned int numDirections, std::string outImageFormat, unsigned int numThreads=1);
     /** A function to generate a local incidence angle layer given the sun position */
     DllExport void executeCalcLocalIncidenceAngle(std::string demImage, std::string outputImage, float solarAzimuth, float solarZenith, std::string outImageFormat);
     /** A function to generate a local exitance angle layer given a viewers position */
@@ -69,7 +71,7 @@ namespace rsgis{ namespace cmds {
     /** A function to filter a DTM using a variable filter with respect to aspect */
     DllExport void executeDTMAspectMedianFilter(std::string demImage, std::string aspectImage, std::string outputImage, float aspectRange, int winHSize, std::string outImageFormat);
     /** A function to fill a DEM using the Soille and Gratin 1994 algorthm */
-    DllExport void executeDEMFillSoilleGratin1994(std::string inImage, std::string validDataImg, std::string outputImage, std::string outImageFormat);
+    DllExport void executeDEMFillSoilleGratin1994(std::string inImage, std::string validDataImg, std::string outputImage, std::string outImageFormat, unsigned int tileSize=0);
     /** A function which detreads an elevation model using local plane fitting */
     DllExport void executePlaneFitDetreadDEM(std::string demImage, std::string outputImage, std::string outImageFormat, int winSize);
 }}
@@ -38,7 +38,7 @@
 
 namespace rsgis{ namespace cmds {
 
-    void executeFilter(std::string inputImage, std::vector<rsgis::cmds::RSGISFilterParameters*> *filterParameters, std::string outputImageBase, std::string imageFormat, std::string imageExt, RSGISLibDataType outDataType) 
+    void executeFilter(std::string inputImage, std::vector<rsgis::cmds::RSGISFilterParameters*> *filterParameters, std::string outputImageBase, std::string imageFormat, std::string imageExt, RSGISLibDataType outDataType, bool stackOutput, unsigned int numThreads) 
     {
         try
         {
@@ -256,7 +256,7 @@ namespace rsgis{ namespace cmds {
                 throw rsgis::RSGISImageException(message.c_str());
             }
             
-            filterBank->executeFilters(dataset, 1, outputImageBase, imageFormat, imageExt, RSGIS_to_GDAL_Type(outDataType));
+            filterBank->executeFiltersSinglePass(dataset, 1, outputImageBase, imageFormat, imageExt, RSGIS_to_GDAL_Type(outDataType), stackOutput, numThreads);
             
             GDALClose(dataset[0]);
             delete[] dataset;
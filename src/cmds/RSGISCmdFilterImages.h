@@ -59,8 +59,10 @@ namespace rsgis{ namespace cmds {
         float angle;
     };
 
-    /** Function to apply filters to an image */
-    DllExport void executeFilter(std::string inputImage, std::vector <rsgis::cmds::RSGISFilterParameters*> *filterParameters, std::string outputImageBase, std::string imageFormat, std::string imageExt, RSGISLibDataType outDataType);
+    /** Function to apply filters to an image. The input image is read once and all the filters applied
+        in a single pass. If stackOutput is true then a single multi-band image is produced rather than
+        an image per filter. numThreads specifies the number of threads used (0 = all available cores). */
+    DllExport void executeFilter(std::string inputImage, std::vector <rsgis::cmds::RSGISFilterParameters*> *filterParameters, std::string outputImageBase, std::string imageFormat, std::string imageExt, RSGISLibDataType outDataType, bool stackOutput=false, unsigned int numThreads=1);
 
     /** Function to set up LeuncMalik Filter Band */
     DllExport std::vector<rsgis::cmds::RSGISFilterParameters*> *createLeungMalikFilterBank();
@@ -28,6 +28,8 @@
 #include "histocube/RSGISPopulateHistoCube.h"
 #include "histocube/RSGISExportHistoCube2Img.h"
 
+#include "common/RSGISThreadUtils.h"
+
 #include "img/RSGISCalcImage.h"
 #include "img/RSGISImageStatistics.h"
 
@@ -154,7 +156,7 @@ namespace rsgis{ namespace cmds {
                 unsigned int *dataArr = new unsigned int[dataArrLen];
                 histoCubeFileObj.getHistoRows(layerName, 0, maxRow, dataArr, dataArrLen);
                 
-                rsgis::histocube::RSGISPopHistoCubeLayerFromImgBandInMem popCubeLyrMem = rsgis::histocube::RSGISPopHistoCubeLayerFromImgBandInMem(dataArr, dataArrLen, bandIdx, maxRow, cubeLayer->scale, cubeLayer->offset, cubeLayer->bins);
+                rsgis::histocube::RSGISPopHistoCubeLayerFromImgBandInMem popCubeLyrMem(dataArr, dataArrLen, bandIdx, maxRow, cubeLayer->scale, cubeLayer->offset, cubeLayer->bins);
                 rsgis::img::RSGISCalcImage calcImgPopCubeMem = rsgis::img::RSGISCalcImage(&popCubeLyrMem);
                 calcImgPopCubeMem.calcImage(datasets, 1, 1);
                 
@@ -163,9 +165,10 @@ namespace rsgis{ namespace cmds {
             }
             else
             {
-                rsgis::histocube::RSGISPopHistoCubeLayerFromImgBand popCubeLyr = rsgis::histocube::RSGISPopHistoCubeLayerFromImgBand(&histoCubeFileObj, layerName, bandIdx, maxRow, cubeLayer->scale, cubeLayer->offset, cubeLayer->bins);
+                rsgis::histocube::RSGISPopHistoCubeLayerFromImgBand popCubeLyr(&histoCubeFileObj, layerName, bandIdx, maxRow, cubeLayer->scale, cubeLayer->offset, cubeLayer->bins);
                 rsgis::img::RSGISCalcImage calcImgPopCube = rsgis::img::RSGISCalcImage(&popCubeLyr);
                 calcImgPopCube.calcImage(datasets, 1, 1);
+                popCubeLyr.flushUpdates();
             }
             histoCubeFileObj.closeFile();
             GDALClose(datasets[0]);
@@ -182,6 +185,120 @@ namespace rsgis{ namespace cmds {
         }
     }
     
+    void executePopulateHistoCubeLayers(std::string histCubeFile, std::vector<std::string> layerNames, std::string clumpsImg, std::vector<std::string> valsImgs, std::vector<unsigned int> imgBands, unsigned int numThreads)
+    {
+        GDALAllRegister();
+        try
+        {
+            if((layerNames.size() != valsImgs.size()) | (layerNames.size() != imgBands.size()))
+            {
+                throw rsgis::RSGISHistoCubeException("The number of layers, values images and bands must be the same.");
+            }
+            
+            rsgis::histocube::RSGISHistoCubeFile histoCubeFileObj = rsgis::histocube::RSGISHistoCubeFile();
+            histoCubeFileObj.openFile(histCubeFile, true);
+            
+            std::vector<rsgis::histocube::RSGISHistCubeLayerMeta*> *cubeLayers = histoCubeFileObj.getCubeLayersList();
+            std::vector<rsgis::histocube::RSGISHistCubeLayerMeta*> popLayers;
+            for(std::vector<std::string>::iterator iterNames = layerNames.begin(); iterNames != layerNames.end(); ++iterNames)
+            {
+                rsgis::histocube::RSGISHistCubeLayerMeta *cubeLayer = NULL;
+                for(std::vector<rsgis::histocube::RSGISHistCubeLayerMeta*>::iterator iterLayers = cubeLayers->begin(); iterLayers != cubeLayers->end(); ++iterLayers)
+                {
+                    if((*iterLayers)->name == (*iterNames))
+                    {
+                        cubeLayer = (*iterLayers);
+                        break;
+                    }
+                }
+                if(cubeLayer == NULL)
+                {
+                    throw rsgis::RSGISHistoCubeException("Column was not found within the histogram cube.");
+                }
+                popLayers.push_back(cubeLayer);
+            }
+            
+            unsigned int maxRow = histoCubeFileObj.getNumFeatures()-1;
+            
+            // Each layer is accumulated by its own thread with its own image datasets;
+            // access to the HDF5 file is serialised using the mutex.
+            std::mutex fileMutex;
+            rsgis::parallelForRange(0, popLayers.size(), rsgis::getNumProcessingThreads(numThreads), 1, [&](size_t lyrStart, size_t lyrEnd, unsigned int threadIdx)
+            {
+                for(size_t i = lyrStart; i < lyrEnd; ++i)
+                {
+                    GDALDataset **datasets = new GDALDataset*[2];
+                    datasets[0] = (GDALDataset *) GDALOpen(clumpsImg.c_str(), GA_ReadOnly);
+                    if(datasets[0] == NULL)
+                    {
+                        delete[] datasets;
+                        std::string message = std::string("Could not open image ") + clumpsImg;
+                        throw rsgis::RSGISImageException(message.c_str());
+                    }
+                    
+                    if(datasets[0]->GetRasterCount() != 1)
+                    {
+                        GDALClose(datasets[0]);
+                        delete[] datasets;
+                        throw rsgis::RSGISImageException("The clumps image must only have 1 image band.");
+                    }
+                    
+                    datasets[1] = (GDALDataset *) GDALOpen(valsImgs.at(i).c_str(), GA_ReadOnly);
+                    if(datasets[1] == NULL)
+                    {
+                        GDALClose(datasets[0]);
+                        delete[] datasets;
+                        std::string message = std::string("Could not open image ") + valsImgs.at(i);
+                        throw rsgis::RSGISImageException(message.c_str());
+                    }
+                    
+                    if((imgBands.at(i) == 0) | (imgBands.at(i) > datasets[1]->GetRasterCount()))
+                    {
+                        GDALClose(datasets[0]);
+                        GDALClose(datasets[1]);
+                        delete[] datasets;
+                        throw rsgis::RSGISImageException("The band specified is not within the values image.");
+                    }
+                    
+                    try
+                    {
+                        rsgis::histocube::RSGISHistCubeLayerMeta *cubeLayer = popLayers.at(i);
+                        rsgis::histocube::RSGISPopHistoCubeLayerFromImgBand popCubeLyr(&histoCubeFileObj, cubeLayer->name, imgBands.at(i)-1, maxRow, cubeLayer->scale, cubeLayer->offset, cubeLayer->bins, &fileMutex);
+                        rsgis::img::RSGISCalcImage calcImgPopCube = rsgis::img::RSGISCalcImage(&popCubeLyr);
+                        calcImgPopCube.calcImage(datasets, 1, 1);
+                        popCubeLyr.flushUpdates();
+                    }
+                    catch(std::exception &e)
+                    {
+                        // Close this thread's datasets before the error is passed back to the calling thread.
+                        GDALClose(datasets[0]);
+                        GDALClose(datasets[1]);
+                        delete[] datasets;
+                        throw;
+                    }
+                    
+                    GDALClose(datasets[0]);
+                    GDALClose(datasets[1]);
+                    delete[] datasets;
+                }
+            });
+            
+            histoCubeFileObj.closeFile();
+        }
+        catch(rsgis::RSGISImageException &e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch(rsgis::RSGISHistoCubeException &e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch(rsgis::RSGISException &e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+    }
+    
     void executeExportHistBins2Img(std::string histCubeFile, std::string layerName, std::string clumpsImg, std::string outputImg, std::string gdalFormat, std::vector<unsigned int> exportBins) 
     {
         GDALAllRegister();
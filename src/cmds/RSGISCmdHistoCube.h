@@ -68,6 +68,9 @@ namespace rsgis{ namespace cmds {
     /** A function to populate a single histogram layer from multiple input files */
     DllExport void executePopulateSingleHistoCubeLayer(std::string histCubeFile, std::string layerName, std::string clumpsImg, std::string valsImg, unsigned int imgBand, bool inMem);
     
+    /** A function to populate a number of histogram layers (e.g., one for each date) in parallel, one values image for each layer */
+    DllExport void executePopulateHistoCubeLayers(std::string histCubeFile, std::vector<std::string> layerNames, std::string clumpsImg, std::vector<std::string> valsImgs, std::vector<unsigned int> imgBands, unsigned int numThreads=1);
+    
     /** A function to export histogram columns as a multi-band image dataset */
     DllExport void executeExportHistBins2Img(std::string histCubeFile, std::string layerName, std::string clumpsImg, std::string outputImg, std::string gdalFormat, std::vector<unsigned int> exportBins);
     
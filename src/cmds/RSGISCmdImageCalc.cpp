@@ -77,13 +77,14 @@
 
 namespace rsgis{ namespace cmds {
 
-    void executeBandMaths(VariableStruct *variables, unsigned int numVars, std::string outputImage, std::string mathsExpression, std::string gdalFormat, RSGISLibDataType outDataType, bool useExpAsbandName, bool editOutputImg)
+    void executeBandMaths(VariableStruct *variables, unsigned int numVars, std::string outputImage, std::string mathsExpression, std::string gdalFormat, RSGISLibDataType outDataType, bool useExpAsbandName, bool editOutputImg, RSGISImageIOOptionsCmds *ioOptions)
     {
         GDALAllRegister();
         GDALDataset **datasets = NULL;
         GDALDataset *outDataset = NULL;
         rsgis::img::RSGISBandMath *bandmaths = NULL;
         rsgis::img::RSGISCalcImage *calcImage = NULL;
+        rsgis::img::RSGISImageIOPolicy *ioPolicy = NULL;
         mu::Parser *muParser = new mu::Parser();
         bool openedOutput = false;
 
@@ -187,7 +188,8 @@ namespace rsgis{ namespace cmds {
             }
 
             bandmaths = new rsgis::img::RSGISBandMath(1, processVaribles, numVars, muParser);
-            calcImage = new rsgis::img::RSGISCalcImage(bandmaths, "", true);
+            ioPolicy = createImageIOPolicy(ioOptions);
+            calcImage = new rsgis::img::RSGISCalcImage(bandmaths, "", true, ioPolicy);
             if(editOutputImg)
             {
                 calcImage->calcImagePartialOutput(datasets, total_n_imgs, outDataset);
@@ -214,6 +216,7 @@ namespace rsgis{ namespace cmds {
             delete muParser;
             delete bandmaths;
             delete calcImage;
+            delete ioPolicy;
             if(useExpAsbandName)
             {
                 delete[] outBandName;
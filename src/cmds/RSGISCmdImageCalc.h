@@ -91,7 +91,7 @@ namespace rsgis{ namespace cmds {
     };
 
     /** Function to run the band maths tools */
-    DllExport void executeBandMaths(VariableStruct *variables, unsigned int numVars, std::string outputImage, std::string mathsExpression, std::string gdalFormat, RSGISLibDataType outDataType, bool useExpAsbandName, bool editOutputImg=false);
+    DllExport void executeBandMaths(VariableStruct *variables, unsigned int numVars, std::string outputImage, std::string mathsExpression, std::string gdalFormat, RSGISLibDataType outDataType, bool useExpAsbandName, bool editOutputImg=false, RSGISImageIOOptionsCmds *ioOptions=NULL);
     /** Function to run the image maths tools */
     DllExport void executeImageMaths(std::string inputImage, std::string outputImage, std::string mathsExpression, std::string imageFormat, RSGISLibDataType outDataType, bool useExpAsbandName, bool editOutputImg=false);
     /** Function to run the image band maths tools */
@@ -30,6 +30,7 @@
 #include "calibration/RSGISCloudMasking.h"
 #include "calibration/RSGISHydroDEMFillSoilleGratin94.h"
 #include "calibration/RSGISImgCalibUtils.h"
+#include "calibration/RSGISRadiometricCalibrationChain.h"
 
 #include "img/RSGISImageCalcException.h"
 #include "img/RSGISCalcImageValue.h"
@@ -54,6 +55,10 @@
 
 namespace rsgis{ namespace cmds {
     
+    /** Converts the 6S elevation / AOT LUT, with the bands (from 1) checked against numRasterBands, offsetting the bands for the DEM and AOT images. */
+    static std::vector<rsgis::calib::LUT6SBaseElevAOT>* convertCmds6SElevAOTLUT(std::vector<Cmds6SBaseElevAOTLUT> *lut, unsigned int numRasterBands);
+    static void deleteCmds6SElevAOTLUT(std::vector<rsgis::calib::LUT6SBaseElevAOT> *rsgisLUT);
+    
     void executeConvertLandsat2Radiance(std::string outputImage, std::string gdalFormat, std::vector<CmdsLandsatRadianceGainsOffsets> landsatRadGainOffs)
     {
         GDALAllRegister();
@@ -498,48 +503,18 @@ namespace rsgis{ namespace cmds {
             
             int numRasterBands = datasets[2]->GetRasterCount();
             
-            std::vector<rsgis::calib::LUT6SBaseElevAOT> *rsgisLUT = new std::vector<rsgis::calib::LUT6SBaseElevAOT>();
-            
-            for(std::vector<Cmds6SBaseElevAOTLUT>::iterator iterElevLUT = lut->begin(); iterElevLUT != lut->end(); ++iterElevLUT)
+            std::vector<rsgis::calib::LUT6SBaseElevAOT> *rsgisLUT = NULL;
+            try
             {
-                rsgis::calib::LUT6SBaseElevAOT lutElevVal = rsgis::calib::LUT6SBaseElevAOT();
-                std::cout << "Elevation: " << (*iterElevLUT).elev << std::endl;
-                lutElevVal.aotLUT = std::vector<rsgis::calib::LUT6SAOT>();
-                lutElevVal.aotLUT.reserve((*iterElevLUT).aotLUT.size());
-                
-                for(std::vector<Cmds6SAOTLUT>::iterator iterAOTLUT = (*iterElevLUT).aotLUT.begin(); iterAOTLUT != (*iterElevLUT).aotLUT.end(); ++iterAOTLUT)
-                {
-                    rsgis::calib::LUT6SAOT aotLUTVal = rsgis::calib::LUT6SAOT();
-                    aotLUTVal.aot = (*iterAOTLUT).aot;
-                    aotLUTVal.numValues = (*iterAOTLUT).numValues;
-                    aotLUTVal.imageBands = new unsigned int[aotLUTVal.numValues];
-                    aotLUTVal.aX = new float[aotLUTVal.numValues];
-                    aotLUTVal.bX = new float[aotLUTVal.numValues];
-                    aotLUTVal.cX = new float[aotLUTVal.numValues];
-                    
-                    std::cout << "\tAOT: " << (*iterAOTLUT).aot << std::endl;
-                    for(unsigned int i = 0; i < (*iterAOTLUT).numValues; ++i)
-                    {
-                        if((*iterAOTLUT).imageBands[i] > numRasterBands)
-                        {
-                            GDALClose(datasets[0]);
-                            GDALClose(datasets[1]);
-                            GDALClose(datasets[2]);
-                            delete[] datasets;
-                            throw rsgis::RSGISException("The number of input image bands is not equal to the number coefficients provided.");
-                        }
-                        aotLUTVal.imageBands[i] = (*iterAOTLUT).imageBands[i]+1;
-                        aotLUTVal.aX[i] = (*iterAOTLUT).aX[i];
-                        aotLUTVal.bX[i] = (*iterAOTLUT).bX[i];
-                        aotLUTVal.cX[i] = (*iterAOTLUT).cX[i];
-                        std::cout << "\t\tBand " << aotLUTVal.imageBands[i] << ": aX = " << aotLUTVal.aX[i] << " bX = " << aotLUTVal.bX[i] << " cX = " << aotLUTVal.cX[i] << std::endl;
-                    }
-                    
-                    lutElevVal.aotLUT.push_back(aotLUTVal);
-                }
-                lutElevVal.elev = (*iterElevLUT).elev;
-                
-                rsgisLUT->push_back(lutElevVal);
+                rsgisLUT = convertCmds6SElevAOTLUT(lut, numRasterBands);
+            }
+            catch(rsgis::RSGISException &e)
+            {
+                GDALClose(datasets[0]);
+                GDALClose(datasets[1]);
+                GDALClose(datasets[2]);
+                delete[] datasets;
+                throw;
             }
             
             std::cout << "Apply Coefficients to input image...\n";
@@ -552,22 +527,135 @@ namespace rsgis{ namespace cmds {
             delete apply6SCoefficients;
             delete calcImage;
             
-            for(std::vector<rsgis::calib::LUT6SBaseElevAOT>::iterator iterLUT = rsgisLUT->begin(); iterLUT != rsgisLUT->end(); ++iterLUT)
+            deleteCmds6SElevAOTLUT(rsgisLUT);
+            
+            GDALClose(datasets[0]);
+            GDALClose(datasets[1]);
+            GDALClose(datasets[2]);
+            delete[] datasets;
+        }
+        catch(rsgis::RSGISException &e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception &e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+    }
+    
+    void executeLandsatDN2SREFElevAOTLUT6sParams(std::vector<CmdsLandsatRadianceGainsOffsets> landsatRadGainOffs, std::string inputDEM, std::string inputAOTImg, std::string outputImage, std::string outputTOAImage, std::string gdalFormat, rsgis::RSGISLibDataType rsgisOutDataType, float scaleFactor, float toaScaleFactor, unsigned int year, unsigned int month, unsigned int day, float solarZenith, float *solarIrradiance, unsigned int numSolarIrrVals, std::vector<Cmds6SBaseElevAOTLUT> *lut, float noDataVal, bool useNoDataVal, unsigned int numThreads)
+    {
+        GDALAllRegister();
+        
+        try
+        {
+            unsigned int numBands = landsatRadGainOffs.size();
+            if(numBands == 0)
+            {
+                throw rsgis::RSGISException("At least one DN band must be provided.");
+            }
+            if(numSolarIrrVals != numBands)
+            {
+                throw rsgis::RSGISException("The number of DN bands and solar irradiance values are different.");
+            }
+            
+            GDALDataset **datasets = new GDALDataset*[numBands];
+            std::string *outBandNames = new std::string[numBands];
+            rsgis::calib::LandsatRadianceGainsOffsets *lsRadGainOffs = new rsgis::calib::LandsatRadianceGainsOffsets[numBands];
+            
+            unsigned int i = 0;
+            unsigned int numRasterBands = 0;
+            unsigned int totalNumRasterBands = 0;
+            for(std::vector<rsgis::cmds::CmdsLandsatRadianceGainsOffsets>::iterator iterBands = landsatRadGainOffs.begin(); iterBands != landsatRadGainOffs.end(); ++iterBands)
             {
-                for(std::vector<rsgis::calib::LUT6SAOT>::iterator iterAOTLUT = (*iterLUT).aotLUT.begin(); iterAOTLUT != (*iterLUT).aotLUT.end(); ++iterAOTLUT)
+                std::cout << "Opening: " << (*iterBands).imagePath << std::endl;
+                
+                datasets[i] = (GDALDataset *) GDALOpen((*iterBands).imagePath.c_str(), GA_ReadOnly);
+                if(datasets[i] == NULL)
+                {
+                    std::string message = std::string("Could not open image ") + (*iterBands).imagePath;
+                    throw RSGISImageException(message.c_str());
+                }
+                
+                numRasterBands = datasets[i]->GetRasterCount();
+                
+                if((*iterBands).band > numRasterBands)
                 {
-                    delete[] (*iterAOTLUT).imageBands;
-                    delete[] (*iterAOTLUT).aX;
-                    delete[] (*iterAOTLUT).bX;
-                    delete[] (*iterAOTLUT).cX;
+                    throw RSGISImageException("You have specified a band which is not within the image");
                 }
+                lsRadGainOffs[i].band = totalNumRasterBands + (*iterBands).band-1;
+                
+                lsRadGainOffs[i].lMax = (*iterBands).lMax;
+                lsRadGainOffs[i].lMin = (*iterBands).lMin;
+                lsRadGainOffs[i].qCalMax = (*iterBands).qCalMax;
+                lsRadGainOffs[i].qCalMin = (*iterBands).qCalMin;
+                
+                outBandNames[i] = (*iterBands).bandName;
+                
+                totalNumRasterBands += numRasterBands;
+                ++i;
             }
-            delete rsgisLUT;
             
-            GDALClose(datasets[0]);
-            GDALClose(datasets[1]);
-            GDALClose(datasets[2]);
+            std::cout << "Open DEM image: \'" << inputDEM << "\'" << std::endl;
+            GDALDataset *demDataset = (GDALDataset *) GDALOpen(inputDEM.c_str(), GA_ReadOnly);
+            if(demDataset == NULL)
+            {
+                std::string message = std::string("Could not open image ") + inputDEM;
+                throw rsgis::RSGISImageException(message.c_str());
+            }
+            
+            std::cout << "Open AOT image: \'" << inputAOTImg << "\'" << std::endl;
+            GDALDataset *aotDataset = (GDALDataset *) GDALOpen(inputAOTImg.c_str(), GA_ReadOnly);
+            if(aotDataset == NULL)
+            {
+                std::string message = std::string("Could not open image ") + inputAOTImg;
+                throw rsgis::RSGISImageException(message.c_str());
+            }
+            
+            std::vector<rsgis::calib::LUT6SBaseElevAOT> *rsgisLUT = convertCmds6SElevAOTLUT(lut, numBands);
+            
+            unsigned int julianDay = rsgis::calib::rsgisGetJulianDay(day, month, year);
+            double solarDistance = rsgis::calib::rsgisCalcSolarDistance(julianDay);
+            
+            rsgis::calib::RSGISLandsatDN2SREFCalibrationChain calibChain(numBands, lsRadGainOffs, solarIrradiance, solarDistance, solarZenith, toaScaleFactor, rsgisLUT, scaleFactor, noDataVal, useNoDataVal, numThreads);
+            
+            rsgis::img::RSGISImageUtils imgUtils;
+            GDALDataset *srefDataset = imgUtils.createCopy(datasets[0], numBands, outputImage, gdalFormat, RSGIS_to_GDAL_Type(rsgisOutDataType));
+            GDALDataset *toaDataset = NULL;
+            if(outputTOAImage != "")
+            {
+                toaDataset = imgUtils.createCopy(datasets[0], numBands, outputTOAImage, gdalFormat, RSGIS_to_GDAL_Type(rsgisOutDataType));
+            }
+            for(unsigned int n = 0; n < numBands; ++n)
+            {
+                srefDataset->GetRasterBand(n+1)->SetDescription(outBandNames[n].c_str());
+                if(toaDataset != NULL)
+                {
+                    toaDataset->GetRasterBand(n+1)->SetDescription(outBandNames[n].c_str());
+                }
+            }
+            
+            std::cout << "Calibrate DN to surface reflectance...\n";
+            calibChain.calcCalibratedImages(datasets, numBands, demDataset, aotDataset, srefDataset, toaDataset);
+            
+            GDALClose(srefDataset);
+            if(toaDataset != NULL)
+            {
+                GDALClose(toaDataset);
+            }
+            
+            deleteCmds6SElevAOTLUT(rsgisLUT);
+            
+            for(unsigned int n = 0; n < numBands; ++n)
+            {
+                GDALClose(datasets[n]);
+            }
+            GDALClose(demDataset);
+            GDALClose(aotDataset);
             delete[] datasets;
+            delete[] lsRadGainOffs;
+            delete[] outBandNames;
         }
         catch(rsgis::RSGISException &e)
         {
@@ -578,6 +666,71 @@ namespace rsgis{ namespace cmds {
             throw RSGISCmdException(e.what());
         }
     }
+    
+    static std::vector<rsgis::calib::LUT6SBaseElevAOT>* convertCmds6SElevAOTLUT(std::vector<Cmds6SBaseElevAOTLUT> *lut, unsigned int numRasterBands)
+    {
+        std::vector<rsgis::calib::LUT6SBaseElevAOT> *rsgisLUT = new std::vector<rsgis::calib::LUT6SBaseElevAOT>();
+        
+        for(std::vector<Cmds6SBaseElevAOTLUT>::iterator iterElevLUT = lut->begin(); iterElevLUT != lut->end(); ++iterElevLUT)
+        {
+            rsgis::calib::LUT6SBaseElevAOT lutElevVal = rsgis::calib::LUT6SBaseElevAOT();
+            std::cout << "Elevation: " << (*iterElevLUT).elev << std::endl;
+            lutElevVal.aotLUT = std::vector<rsgis::calib::LUT6SAOT>();
+            lutElevVal.aotLUT.reserve((*iterElevLUT).aotLUT.size());
+            
+            for(std::vector<Cmds6SAOTLUT>::iterator iterAOTLUT = (*iterElevLUT).aotLUT.begin(); iterAOTLUT != (*iterElevLUT).aotLUT.end(); ++iterAOTLUT)
+            {
+                for(unsigned int i = 0; i < (*iterAOTLUT).numValues; ++i)
+                {
+                    if((*iterAOTLUT).imageBands[i] > numRasterBands)
+                    {
+                        deleteCmds6SElevAOTLUT(rsgisLUT);
+                        throw rsgis::RSGISException("The number of input image bands is not equal to the number coefficients provided.");
+                    }
+                }
+                
+                rsgis::calib::LUT6SAOT aotLUTVal = rsgis::calib::LUT6SAOT();
+                aotLUTVal.aot = (*iterAOTLUT).aot;
+                aotLUTVal.numValues = (*iterAOTLUT).numValues;
+                aotLUTVal.imageBands = new unsigned int[aotLUTVal.numValues];
+                aotLUTVal.aX = new float[aotLUTVal.numValues];
+                aotLUTVal.bX = new float[aotLUTVal.numValues];
+                aotLUTVal.cX = new float[aotLUTVal.numValues];
+                
+                std::cout << "\tAOT: " << (*iterAOTLUT).aot << std::endl;
+                for(unsigned int i = 0; i < (*iterAOTLUT).numValues; ++i)
+                {
+                    aotLUTVal.imageBands[i] = (*iterAOTLUT).imageBands[i]+1;
+                    aotLUTVal.aX[i] = (*iterAOTLUT).aX[i];
+                    aotLUTVal.bX[i] = (*iterAOTLUT).bX[i];
+                    aotLUTVal.cX[i] = (*iterAOTLUT).cX[i];
+                    std::cout << "\t\tBand " << aotLUTVal.imageBands[i] << ": aX = " << aotLUTVal.aX[i] << " bX = " << aotLUTVal.bX[i] << " cX = " << aotLUTVal.cX[i] << std::endl;
+                }
+                
+                lutElevVal.aotLUT.push_back(aotLUTVal);
+            }
+            lutElevVal.elev = (*iterElevLUT).elev;
+            
+            rsgisLUT->push_back(lutElevVal);
+        }
+        
+        return rsgisLUT;
+    }
+    
+    static void deleteCmds6SElevAOTLUT(std::vector<rsgis::calib::LUT6SBaseElevAOT> *rsgisLUT)
+    {
+        for(std::vector<rsgis::calib::LUT6SBaseElevAOT>::iterator iterLUT = rsgisLUT->begin(); iterLUT != rsgisLUT->end(); ++iterLUT)
+        {
+            for(std::vector<rsgis::calib::LUT6SAOT>::iterator iterAOTLUT = (*iterLUT).aotLUT.begin(); iterAOTLUT != (*iterLUT).aotLUT.end(); ++iterAOTLUT)
+            {
+                delete[] (*iterAOTLUT).imageBands;
+                delete[] (*iterAOTLUT).aX;
+                delete[] (*iterAOTLUT).bX;
+                delete[] (*iterAOTLUT).cX;
+            }
+        }
+        delete rsgisLUT;
+    }
                 
     void executeApplySubtractOffsets(std::string inputImage, std::string outputImage, std::string offsetImage, bool nonNegative, std::string gdalFormat, rsgis::RSGISLibDataType rsgisOutDataType, float noDataVal, bool useNoDataVal, float darkObjReflVal) 
     {
@@ -762,19 +915,14 @@ namespace rsgis{ namespace cmds {
         }
     }
     
-    void executeLandsatTMCloudFMask(std::string inputTOAImage, std::string inputThermalImage, std::string inputSaturateImage, std::string validImg, std::string outputImage, std::string gdalFormat, double sunAz, double sunZen, double senAz, double senZen, float whitenessThreshold, float scaleFactorIn, std::string tmpImgsBase, std::string tmpImgFileExt, bool rmTmpImgs) 
+    void executeLandsatTMCloudFMask(std::string inputTOAImage, std::string inputThermalImage, std::string inputSaturateImage, std::string validImg, std::string outputImage, std::string gdalFormat, double sunAz, double sunZen, double senAz, double senZen, float whitenessThreshold, float scaleFactorIn, std::string tmpImgsBase, std::string tmpImgFileExt, bool rmTmpImgs, unsigned int numThreads) 
     {
         GDALAllRegister();
         try
         {
             std::cout.precision(12);
             rsgis::img::RSGISImageUtils imgUtils;
-            rsgis::rastergis::RSGISRasterAttUtils ratUtils;
-            rsgis::rastergis::RSGISPopRATWithStats calcClumpStats;
             
-            std::string pass1TmpOutImage = tmpImgsBase + "_pass1layers"+tmpImgFileExt;
-            std::string landWaterTmpOutImage = tmpImgsBase + "_landwater"+tmpImgFileExt;
-            std::string cloudLandProbTmpOutImage = tmpImgsBase + "_cloudProb"+tmpImgFileExt;
             std::string tmpNIRBandImg = tmpImgsBase + "_nirband"+tmpImgFileExt;
             std::string tmpNIRFillBandImg = tmpImgsBase + "_nirbandfill"+tmpImgFileExt;
             std::string tmpSWIRBandImg = tmpImgsBase + "_swirband"+tmpImgFileExt;
@@ -847,79 +995,20 @@ namespace rsgis{ namespace cmds {
             rsgis::rastergis::RSGISPopulateWithImageStats popImageStats;
             rsgis::rastergis::RSGISRasterAttUtils attUtils;
 
-            std::cout << "Apply first pass FMask to classifiy initial clear sky regions...\n";
-            rsgis::calib::RSGISLandsatFMaskPass1CloudMasking cloudMaskPass1 = rsgis::calib::RSGISLandsatFMaskPass1CloudMasking(scaleFactorIn, (numReflBands+numThermBands), whitenessThreshold);
-            rsgis::img::RSGISCalcImage *calcImage = new rsgis::img::RSGISCalcImage(&cloudMaskPass1, "", true);
-            datasets = new GDALDataset*[3];
-            datasets[0] = reflDataset;
-            datasets[1] = thermDataset;
-            datasets[2] = saturateDataset;
-            GDALDataset *pass1DS = imgUtils.createCopy(datasets, 3, 16, pass1TmpOutImage, gdalFormat, GDT_Float32);
-            calcImage->calcImage(datasets, 3, pass1DS);
-            delete calcImage;
-            delete[] datasets;
-            
-            std::vector<std::string> bandNames;
-            bandNames.push_back("ndsi");
-            bandNames.push_back("ndvi");
-            bandNames.push_back("basicTest");
-            bandNames.push_back("meanVis");
-            bandNames.push_back("whitenessTest");
-            bandNames.push_back("hotTest");
-            bandNames.push_back("nirswirTest");
-            bandNames.push_back("waterTest");
-            bandNames.push_back("pcp");
-            bandNames.push_back("clearSkyLand");
-            bandNames.push_back("snowTest");
-            bandNames.push_back("varProb");
-            bandNames.push_back("modNDVI");
-            bandNames.push_back("modNDSI");
-            bandNames.push_back("whiteness");
-            bandNames.push_back("clearSkyWater");
-            imgUtils.setImageBandNames(pass1DS, bandNames, true);
-            
-            
-            std::cout << "Export Land and Water regions and check PCP coverage.\n";
-            GDALDataset *landWaterClearSkyDS = imgUtils.createCopy(pass1DS, 1, landWaterTmpOutImage, gdalFormat, GDT_UInt32);
-            rsgis::calib::RSGISLandsatFMaskExportPass1LandWaterCloudMasking exportLandWaterRegions = rsgis::calib::RSGISLandsatFMaskExportPass1LandWaterCloudMasking();
-            datasets = new GDALDataset*[2];
-            datasets[0] = validAreaDataset;
-            datasets[1] = pass1DS;
-            calcImage = new rsgis::img::RSGISCalcImage(&exportLandWaterRegions, "", true);
-            calcImage->calcImage(datasets, 2, landWaterClearSkyDS);
-            double propPCP = exportLandWaterRegions.propOfPCPPixels();
-            delete calcImage;
-            delete[] datasets;
+            std::cout << "Apply first pass FMask to classifiy initial clear sky regions and check PCP coverage...\n";
+            rsgis::calib::RSGISLandsatFMaskFusedCloudMasking fusedFMask = rsgis::calib::RSGISLandsatFMaskFusedCloudMasking(scaleFactorIn, (numReflBands+numThermBands), whitenessThreshold, numThreads);
+            fusedFMask.calcClearSkyStats(reflDataset, thermDataset, saturateDataset, validAreaDataset);
+            double propPCP = fusedFMask.getPropOfPCPPixels();
             
             std::cout << "Proportion of PCP coverage of the scene is " << propPCP << std::endl;
             
             if(propPCP < 0.95)
             {
-                
-                popImageStats.populateImageWithRasterGISStats(landWaterClearSkyDS, true, true, 1);
-                
-                std::cout << "Populating RAT with Thermal Stats\n";
-                // Equation 8 and 13 calc percentiles (Zhu and Woodcock 2012, RSE 118, pp83-94):
-                std::vector<rsgis::rastergis::RSGISBandAttPercentiles *> *bandPercentStats = new std::vector<rsgis::rastergis::RSGISBandAttPercentiles *>();
-                rsgis::rastergis::RSGISBandAttPercentiles *tempUpperPercent = new rsgis::rastergis::RSGISBandAttPercentiles();
-                tempUpperPercent->fieldName = "UpperTempThres";
-                tempUpperPercent->percentile = 82.5;
-                bandPercentStats->push_back(tempUpperPercent);
-                rsgis::rastergis::RSGISBandAttPercentiles *tempLowerPercent = new rsgis::rastergis::RSGISBandAttPercentiles();
-                tempLowerPercent->fieldName = "LowerTempThres";
-                tempLowerPercent->percentile = 17.5;
-                bandPercentStats->push_back(tempLowerPercent);
-                calcClumpStats.populateRATWithPercentileStats(landWaterClearSkyDS, thermDataset, 1, bandPercentStats, 1, 200);
-                delete tempUpperPercent;
-                delete tempLowerPercent;
-                delete bandPercentStats;
-                
-                std::cout << "Get Thresholds From the RAT\n";
-                const GDALRasterAttributeTable *landWaterRAT = landWaterClearSkyDS->GetRasterBand(1)->GetDefaultRAT();
-                double lowerWaterThres = ratUtils.readDoubleColumnVal(landWaterRAT, "LowerTempThres", 2)/scaleFactorIn;
-                double upperWaterThres = ratUtils.readDoubleColumnVal(landWaterRAT, "UpperTempThres", 2)/scaleFactorIn;
-                double lowerLandThres = ratUtils.readDoubleColumnVal(landWaterRAT, "LowerTempThres", 1)/scaleFactorIn;
-                double upperLandThres = ratUtils.readDoubleColumnVal(landWaterRAT, "UpperTempThres", 1)/scaleFactorIn;
+                // Equation 8 and 13 percentiles (Zhu and Woodcock 2012, RSE 118, pp83-94) are calculated with the first pass.
+                double lowerWaterThres = fusedFMask.getLowerWaterThres();
+                double upperWaterThres = fusedFMask.getUpperWaterThres();
+                double lowerLandThres = fusedFMask.getLowerLandThres();
+                double upperLandThres = fusedFMask.getUpperLandThres();
                 
                 std::cout << "Lower Water Threshold = " << lowerWaterThres << std::endl;
                 std::cout << "Upper Water Threshold = " << upperWaterThres << std::endl;
@@ -927,75 +1016,12 @@ namespace rsgis{ namespace cmds {
                 std::cout << "Lower Land Threshold = " << lowerLandThres << std::endl;
                 std::cout << "Upper Land Threshold = " << upperLandThres << std::endl;
                 
-                std::cout << "Calculate the cloud probability over the land area...\n";
-                rsgis::calib::RSGISLandsatFMaskPass2ClearSkyCloudProbCloudMasking cloudMaskPass2Part1 = rsgis::calib::RSGISLandsatFMaskPass2ClearSkyCloudProbCloudMasking(scaleFactorIn, (numReflBands+numThermBands), upperWaterThres, upperLandThres, lowerLandThres);
-                calcImage = new rsgis::img::RSGISCalcImage(&cloudMaskPass2Part1, "", true);
-                datasets = new GDALDataset*[4];
-                datasets[0] = landWaterClearSkyDS;
-                datasets[1] = reflDataset;
-                datasets[2] = thermDataset;
-                datasets[3] = pass1DS;
-                GDALDataset *pass2DS = imgUtils.createCopy(pass1DS, 6, cloudLandProbTmpOutImage, gdalFormat, GDT_Float32);
-                calcImage->calcImage(datasets, 4, pass2DS);
-                delete calcImage;
-                delete[] datasets;
-                
-                bandNames = std::vector<std::string>();
-                bandNames.push_back("wTempProb");
-                bandNames.push_back("brightnessProb");
-                bandNames.push_back("waterCloudProb");
-                bandNames.push_back("landTempProb");
-                bandNames.push_back("varProb");
-                bandNames.push_back("landCloudProb");
-                imgUtils.setImageBandNames(pass2DS, bandNames, true);
-                
-                
-                // Equation 17 (Zhu and Woodcock 2012, RSE 118, pp83-94):
-                std::cout << "Calculate percentile probability thresholds for water and land...\n";
-                bandPercentStats = new std::vector<rsgis::rastergis::RSGISBandAttPercentiles *>();
-                rsgis::rastergis::RSGISBandAttPercentiles *landCloudProbPercent = new rsgis::rastergis::RSGISBandAttPercentiles();
-                landCloudProbPercent->fieldName = "UpperCloudLandThres";
-                landCloudProbPercent->percentile = 82.5; // THRESHOLD FOR DIFFERENCIATING LAND AND CLOUD
-                bandPercentStats->push_back(landCloudProbPercent);
-                calcClumpStats.populateRATWithPercentileStats(landWaterClearSkyDS, pass2DS, 6, bandPercentStats, 1, 200);
-                delete landCloudProbPercent;
-                delete bandPercentStats;
-                double landCloudProbUpperThres = ratUtils.readDoubleColumnVal(landWaterRAT, "UpperCloudLandThres", 1);
-                
-                // Equation 18 threshold of 0.5 used in Zhu and Woodcock 2012, RSE 118, pp83-94 changed in Zhu et al (2015) RSE 159 pp269-277 to be dynamic:
-                bandPercentStats = new std::vector<rsgis::rastergis::RSGISBandAttPercentiles *>();
-                rsgis::rastergis::RSGISBandAttPercentiles *waterCloudProbPercent = new rsgis::rastergis::RSGISBandAttPercentiles();
-                waterCloudProbPercent->fieldName = "UpperCloudWaterThres";
-                waterCloudProbPercent->percentile = 82.5; // THRESHOLD FOR DIFFERENCIATING LAND AND WATER
-                bandPercentStats->push_back(waterCloudProbPercent);
-                calcClumpStats.populateRATWithPercentileStats(landWaterClearSkyDS, pass2DS, 3, bandPercentStats, 1, 200);
-                delete waterCloudProbPercent;
-                delete bandPercentStats;
-                double waterCloudProbUpperThres = ratUtils.readDoubleColumnVal(landWaterRAT, "UpperCloudWaterThres", 2);
-                
-                landCloudProbUpperThres = landCloudProbUpperThres + 0.2;
-                waterCloudProbUpperThres = waterCloudProbUpperThres + 0.2;
-                if (waterCloudProbUpperThres > 0.5)
-                {
-                    waterCloudProbUpperThres = 0.5;
-                }
+                std::cout << "Apply second pass FMask to calculate cloud probability and classify clouds mask...\n";
+                GDALDataset *cloudMaskDS = imgUtils.createCopy(reflDataset, 1, tmpCloudsExtent, gdalFormat, GDT_Int32);
+                fusedFMask.calcCloudMask(reflDataset, thermDataset, saturateDataset, cloudMaskDS);
                 
-                std::cout << "Upper Land Cloud Prob Threshold = " << landCloudProbUpperThres << std::endl;
-                std::cout << "Upper Water Cloud Prob Threshold = " << waterCloudProbUpperThres << std::endl;
-
-                std::cout << "Apply second pass FMask to classify final clouds mask...\n";
-                rsgis::calib::RSGISLandsatFMaskPass2CloudMasking cloudMaskPass2Part2 = rsgis::calib::RSGISLandsatFMaskPass2CloudMasking(scaleFactorIn, (numReflBands+numThermBands), landCloudProbUpperThres, waterCloudProbUpperThres, lowerLandThres);
-                calcImage = new rsgis::img::RSGISCalcImage(&cloudMaskPass2Part2, "", true);
-                datasets = new GDALDataset*[5];
-                datasets[0] = landWaterClearSkyDS;
-                datasets[1] = reflDataset;
-                datasets[2] = thermDataset;
-                datasets[3] = pass1DS;
-                datasets[4] = pass2DS;
-                GDALDataset *cloudMaskDS = imgUtils.createCopy(pass1DS, 1, tmpCloudsExtent, gdalFormat, GDT_Int32);
-                calcImage->calcImage(datasets, 5, cloudMaskDS);
-                delete calcImage;
-                delete[] datasets;
+                std::cout << "Upper Land Cloud Prob Threshold = " << fusedFMask.getLandCloudProbUpperThres() << std::endl;
+                std::cout << "Upper Water Cloud Prob Threshold = " << fusedFMask.getWaterCloudProbUpperThres() << std::endl;
                 
                 std::cout << "Apply cloud majority filter...\n";
                 rsgis::calib::RSGISCalcImageCloudMajorityFilter cloudMajFilter = rsgis::calib::RSGISCalcImageCloudMajorityFilter();
@@ -1004,7 +1030,7 @@ namespace rsgis{ namespace cmds {
                 
                 
                 std::cout << "Get cloud objects\n";
-                GDALDataset *cloudClumpsDS = imgUtils.createCopy(pass1DS, 1, tmpCloudsClump, gdalFormat, GDT_UInt32);
+                GDALDataset *cloudClumpsDS = imgUtils.createCopy(reflDataset, 1, tmpCloudsClump, gdalFormat, GDT_UInt32);
                 rsgis::segment::RSGISClumpPxls clumpImg;
                 clumpImg.performClump(cloudMaskDS, cloudClumpsDS, true, 0.0, NULL);
                 popImageStats.populateImageWithRasterGISStats(cloudClumpsDS, true, true, true, 1);
@@ -1015,14 +1041,14 @@ namespace rsgis{ namespace cmds {
                 
                 size_t numcloudsRATHistoRows = 0;
                 int *cloudsRATHisto = attUtils.readIntColumn(cloudsRAT, "Histogram", &numcloudsRATHistoRows);
-                GDALDataset *cloudClumpsRMSmallDS = imgUtils.createCopy(pass1DS, 1, tmpCloudsClumpRMSmall, gdalFormat, GDT_UInt32);
+                GDALDataset *cloudClumpsRMSmallDS = imgUtils.createCopy(reflDataset, 1, tmpCloudsClumpRMSmall, gdalFormat, GDT_UInt32);
                 rsgis::segment::RSGISRemoveClumpsBelowThreshold rmClumpBelowSize = rsgis::segment::RSGISRemoveClumpsBelowThreshold(smallCloudThreshold, cloudsRATHisto, numcloudsRATHistoRows);
                 rsgis::img::RSGISCalcImage calcImgRmSmallClump = rsgis::img::RSGISCalcImage(&rmClumpBelowSize);
                 calcImgRmSmallClump.calcImage(&cloudClumpsDS, 1, 0, cloudClumpsRMSmallDS);
                 delete[] cloudsRATHisto;
                 
                 rsgis::segment::RSGISRelabelClumps relabelImg;
-                GDALDataset *cloudClumpsRMSmallReLblDS = imgUtils.createCopy(pass1DS, 1, tmpCloudsClumpRMSmallRelabel, gdalFormat, GDT_UInt32);
+                GDALDataset *cloudClumpsRMSmallReLblDS = imgUtils.createCopy(reflDataset, 1, tmpCloudsClumpRMSmallRelabel, gdalFormat, GDT_UInt32);
                 relabelImg.relabelClumpsCalcImg(cloudClumpsRMSmallDS, cloudClumpsRMSmallReLblDS);
                 popImageStats.populateImageWithRasterGISStats(cloudClumpsRMSmallReLblDS, true, true, 1);
 
@@ -1033,15 +1059,7 @@ namespace rsgis{ namespace cmds {
                     nirIdx = 5;
                 }
                 
-                bandPercentStats = new std::vector<rsgis::rastergis::RSGISBandAttPercentiles *>();
-                rsgis::rastergis::RSGISBandAttPercentiles *landNIRPercent = new rsgis::rastergis::RSGISBandAttPercentiles();
-                landNIRPercent->fieldName = "LowerNIRLandValue175";
-                landNIRPercent->percentile = 17.5; // NIR LAND THRESHOLD 17.5 %
-                bandPercentStats->push_back(landNIRPercent);
-                calcClumpStats.populateRATWithPercentileStats(landWaterClearSkyDS, reflDataset, nirIdx, bandPercentStats, 1, 200);
-                delete landNIRPercent;
-                delete bandPercentStats;
-                double landNIR175Val = ratUtils.readDoubleColumnVal(landWaterRAT, "LowerNIRLandValue175", 1);
+                double landNIR175Val = fusedFMask.getLandNIR175Val();
                 std::cout << "Land NIR 17.5% Percentile = " << landNIR175Val << std::endl;
                 
                 // Extract NIR band.
@@ -1068,15 +1086,7 @@ namespace rsgis{ namespace cmds {
                 {
                     swirIdx = 6;
                 }
-                bandPercentStats = new std::vector<rsgis::rastergis::RSGISBandAttPercentiles *>();
-                rsgis::rastergis::RSGISBandAttPercentiles *landSWIRPercent = new rsgis::rastergis::RSGISBandAttPercentiles();
-                landSWIRPercent->fieldName = "LowerSWIRLandValue175";
-                landSWIRPercent->percentile = 17.5; // SWIR LAND THRESHOLD 17.5 %
-                bandPercentStats->push_back(landSWIRPercent);
-                calcClumpStats.populateRATWithPercentileStats(landWaterClearSkyDS, reflDataset, swirIdx, bandPercentStats, 1, 200);
-                delete landSWIRPercent;
-                delete bandPercentStats;
-                double landSWIR175Val = ratUtils.readDoubleColumnVal(landWaterRAT, "LowerSWIRLandValue175", 1);
+                double landSWIR175Val = fusedFMask.getLandSWIR175Val();
                 std::cout << "Land SWIR 17.5% Percentile = " << landSWIR175Val << std::endl;
                 
                 // Extract SWIR band.
@@ -1114,12 +1124,12 @@ namespace rsgis{ namespace cmds {
                 delete[] datasets;
                 
 
-                GDALDataset *initCloudHeightsDS = imgUtils.createCopy(pass1DS, 2, tmpCloudsInitHeights, gdalFormat, GDT_Float32);
+                GDALDataset *initCloudHeightsDS = imgUtils.createCopy(reflDataset, 2, tmpCloudsInitHeights, gdalFormat, GDT_Float32);
                 rsgis::calib::RSGISCalcCloudParams calcCloudParams;
                 calcCloudParams.calcCloudHeights(thermDataset, cloudClumpsRMSmallReLblDS, initCloudHeightsDS, lowerLandThres, upperLandThres, scaleFactorIn);
                 
-                GDALDataset *cloudShadowTestRegionsDS = imgUtils.createCopy(pass1DS, 1, tmpCloudsShadowTestRegions, gdalFormat, GDT_Byte);
-                GDALDataset *cloudShadowRegionsDS = imgUtils.createCopy(pass1DS, 1, tmpCloudsShadows, gdalFormat, GDT_Byte);
+                GDALDataset *cloudShadowTestRegionsDS = imgUtils.createCopy(reflDataset, 1, tmpCloudsShadowTestRegions, gdalFormat, GDT_Byte);
+                GDALDataset *cloudShadowRegionsDS = imgUtils.createCopy(reflDataset, 1, tmpCloudsShadows, gdalFormat, GDT_Byte);
                 
                 calcCloudParams.projFitCloudShadow(cloudClumpsRMSmallReLblDS, initCloudHeightsDS, potentCloudShadowDS, cloudShadowTestRegionsDS, cloudShadowRegionsDS, sunAz, sunZen, senAz, senZen);
                 
@@ -1157,7 +1167,7 @@ namespace rsgis{ namespace cmds {
                 unsigned int columnIndex = attUtils.findColumnIndex(cloudsRATRelbl, "CloudMask");
                 rsgis::rastergis::RSGISExportColumns2ImageCalcImage calcImageVal = rsgis::rastergis::RSGISExportColumns2ImageCalcImage(1, cloudsRATRelbl, columnIndex);
                 rsgis::img::RSGISCalcImage calcImageExportRATCol(&calcImageVal);
-                GDALDataset *finalCloudsDS = imgUtils.createCopy(pass1DS, 1, tmpFinalClouds, gdalFormat, GDT_Byte);
+                GDALDataset *finalCloudsDS = imgUtils.createCopy(reflDataset, 1, tmpFinalClouds, gdalFormat, GDT_Byte);
                 calcImageExportRATCol.calcImage(&cloudClumpsRMSmallReLblDS, 1, 0, finalCloudsDS);
       
                 
@@ -1170,7 +1180,7 @@ namespace rsgis{ namespace cmds {
                 }
                 matrixUtils.freeMatrix(matrixMorphOperator);
                 
-                GDALDataset *finalResultDS = imgUtils.createCopy(pass1DS, 1, outputImage, gdalFormat, GDT_Byte);
+                GDALDataset *finalResultDS = imgUtils.createCopy(reflDataset, 1, outputImage, gdalFormat, GDT_Byte);
                 datasets = new GDALDataset*[2];
                 datasets[0] = finalCloudsDialateDS;
                 datasets[1] = finalShadowsDialateDS;
@@ -1213,9 +1223,6 @@ namespace rsgis{ namespace cmds {
                 delete[] blue;
                 delete[] classNames;
                 
-                GDALClose(pass1DS);
-                GDALClose(landWaterClearSkyDS);
-                GDALClose(pass2DS);
                 GDALClose(nirBandDS);
                 GDALClose(nirBandFillDS);
                 GDALClose(potentCloudShadowDS);
@@ -1245,9 +1252,6 @@ namespace rsgis{ namespace cmds {
                         throw RSGISImageException("Image driver is not available.");
                     }
                     
-                    poDriver->Delete(pass1TmpOutImage.c_str());
-                    poDriver->Delete(landWaterTmpOutImage.c_str());
-                    poDriver->Delete(cloudLandProbTmpOutImage.c_str());
                     poDriver->Delete(tmpNIRBandImg.c_str());
                     poDriver->Delete(tmpNIRFillBandImg.c_str());
                     poDriver->Delete(tmpPotentShadows.c_str());
@@ -1306,25 +1310,11 @@ namespace rsgis{ namespace cmds {
                 delete[] classNames;
                 
                 
-                GDALClose(pass1DS);
-                GDALClose(landWaterClearSkyDS);
                 GDALClose(reflDataset);
                 GDALClose(thermDataset);
                 GDALClose(saturateDataset);
                 GDALClose(validAreaDataset);
                 GDALClose(finalResultDS);
-                
-                if(rmTmpImgs)
-                {
-                    GDALDriver *poDriver = GetGDALDriverManager()->GetDriverByName(gdalFormat.c_str());
-                    if(poDriver == NULL)
-                    {
-                        throw RSGISImageException("Image driver is not available.");
-                    }
-                    
-                    poDriver->Delete(pass1TmpOutImage.c_str());
-                    poDriver->Delete(landWaterTmpOutImage.c_str());
-                }
             }
             
         }
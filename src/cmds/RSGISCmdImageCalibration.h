@@ -156,6 +156,9 @@ namespace rsgis{ namespace cmds {
     /** Function to convert radiance into surface reflectance using a LUT for surface elevation and AOT of 6S */
     DllExport void executeRad2SREFElevAOTLUT6sParams(std::string inputRadImage, std::string inputDEM, std::string inputAOTImg, std::string outputImage, std::string gdalFormat, rsgis::RSGISLibDataType rsgisOutDataType, float scaleFactor, std::vector<Cmds6SBaseElevAOTLUT> *lut, float noDataVal, bool useNoDataVal);
     
+    /** Function to convert DN landsat scene to surface reflectance in a single pass (radiance and, optionally, TOA reflectance are calculated in memory) using a LUT for surface elevation and AOT of 6S. The solar zenith is in radians and an empty outputTOAImage means the TOA reflectance is not written. */
+    DllExport void executeLandsatDN2SREFElevAOTLUT6sParams(std::vector<CmdsLandsatRadianceGainsOffsets> landsatRadGainOffs, std::string inputDEM, std::string inputAOTImg, std::string outputImage, std::string outputTOAImage, std::string gdalFormat, rsgis::RSGISLibDataType rsgisOutDataType, float scaleFactor, float toaScaleFactor, unsigned int year, unsigned int month, unsigned int day, float solarZenith, float *solarIrradiance, unsigned int numSolarIrrVals, std::vector<Cmds6SBaseElevAOTLUT> *lut, float noDataVal, bool useNoDataVal, unsigned int numThreads=1);
+    
     /** Function to apply an offset image within the context of dark object subtraction */
     DllExport void executeApplySubtractOffsets(std::string inputImage, std::string outputImage, std::string offsetImage, bool nonNegative, std::string gdalFormat, rsgis::RSGISLibDataType rsgisOutDataType, float noDataVal, bool useNoDataVal, float darkObjReflVal);
     
@@ -166,7 +169,7 @@ namespace rsgis{ namespace cmds {
     DllExport void executeGenerateSaturationMask(std::string outputImage, std::string gdalFormat, std::vector<CmdsSaturatedPixel> imgBandInfo);
     
     /** Function to apply the FMask algorithm for classifying cloud for Landsat TM and ETM+ data */
-    DllExport void executeLandsatTMCloudFMask(std::string inputTOAImage, std::string inputThermalImage, std::string inputSaturateImage, std::string validImg, std::string outputImage, std::string gdalFormat, double sunAz, double sunZen, double senAz, double senZen, float whitenessThreshold, float scaleFactorIn, std::string tmpImgsBase, std::string tmpImgFileExt, bool rmTmpImgs=true);
+    DllExport void executeLandsatTMCloudFMask(std::string inputTOAImage, std::string inputThermalImage, std::string inputSaturateImage, std::string validImg, std::string outputImage, std::string gdalFormat, double sunAz, double sunZen, double senAz, double senZen, float whitenessThreshold, float scaleFactorIn, std::string tmpImgsBase, std::string tmpImgFileExt, bool rmTmpImgs=true, unsigned int numThreads=1);
     
     /** Function to apply DOS offsets (per band) to the input image */
     DllExport void executeApplySubtractSingleOffsets(std::string inputImage, std::string outputImage, std::vector<double> offsetValues, bool nonNegative, std::string gdalFormat, rsgis::RSGISLibDataType rsgisOutDataType, float noDataVal, bool useNoDataVal, float darkObjReflVal);
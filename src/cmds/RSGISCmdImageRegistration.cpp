@@ -47,7 +47,7 @@ namespace rsgis{ namespace cmds {
     void excecuteBasicRegistration(std::string inputReferenceImage, std::string inputFloatingmage, int gcpGap,
                                                   float metricThreshold, int windowSize, int searchArea, float stdDevRefThreshold,
                                                   float stdDevFloatThreshold, int subPixelResolution, unsigned int metricTypeInt,
-                                                  unsigned int outputType, std::string outputGCPFile) 
+                                                  unsigned int outputType, std::string outputGCPFile, bool fftCoarseShift, unsigned int numThreads) 
     {
         
         try
@@ -94,8 +94,9 @@ namespace rsgis{ namespace cmds {
             
             rsgis::reg::RSGISImageRegistration *regImgs = new rsgis::reg::RSGISBasicImageRegistration(inRefDataset, inFloatDataset, gcpGap, metricThreshold,
                                                                                                       windowSize, searchArea, similarityMetric, stdDevRefThreshold,
-                                                                                                      stdDevFloatThreshold, subPixelResolution);
+                                                                                                      stdDevFloatThreshold, subPixelResolution, numThreads);
             
+            regImgs->setCoarseShiftEstimation(fftCoarseShift);
             regImgs->runCompleteRegistration();
             
             if(outputType == 1) // envi_img2img
@@ -135,7 +136,7 @@ namespace rsgis{ namespace cmds {
                                                   float metricThreshold, int windowSize, int searchArea, float stdDevRefThreshold,
                                                   float stdDevFloatThreshold, int subPixelResolution, int distanceThreshold,
                                                   int maxNumIterations, float moveChangeThreshold, float pSmoothness, unsigned int metricTypeInt,
-                                                  unsigned int outputType, std::string outputGCPFile) 
+                                                  unsigned int outputType, std::string outputGCPFile, bool fftCoarseShift, unsigned int numThreads) 
     {
                 
         try
@@ -185,8 +186,9 @@ namespace rsgis{ namespace cmds {
                                                                                                                    searchArea, similarityMetric, stdDevRefThreshold,
                                                                                                                    stdDevFloatThreshold, subPixelResolution,
                                                                                                                    distanceThreshold, maxNumIterations,
-                                                                                                                   moveChangeThreshold, pSmoothness);
+                                                                                                                   moveChangeThreshold, pSmoothness, numThreads);
             
+            regImgs->setCoarseShiftEstimation(fftCoarseShift);
             regImgs->runCompleteRegistration();
             
             if(outputType == 1) // envi_img2img
@@ -222,7 +224,7 @@ namespace rsgis{ namespace cmds {
         }
     }
     
-    void excecuteNNWarp(std::string inputImage, std::string outputImage, std::string projFile, std::string inputGCPs, float resolution, std::string imageFormat, bool genTransformImage) 
+    void excecuteNNWarp(std::string inputImage, std::string outputImage, std::string projFile, std::string inputGCPs, float resolution, std::string imageFormat, bool genTransformImage, unsigned int numThreads, double maxTransformError) 
     {
         
         try
@@ -238,7 +240,7 @@ namespace rsgis{ namespace cmds {
                 projWKTStr = textUtils.readFileToString(projFile);
             }
             
-            warp = new rsgis::reg::RSGISBasicNNGCPImageWarp(inputImage, outputImage, projWKTStr, inputGCPs, resolution, interpolator, imageFormat);
+            warp = new rsgis::reg::RSGISBasicNNGCPImageWarp(inputImage, outputImage, projWKTStr, inputGCPs, resolution, interpolator, imageFormat, numThreads, maxTransformError);
             if(genTransformImage)
             {
                 warp->generateTransformImage();
@@ -259,7 +261,7 @@ namespace rsgis{ namespace cmds {
         }
     }
     
-    void excecuteTriangularWarp(std::string inputImage, std::string outputImage, std::string projFile, std::string inputGCPs, float resolution, std::string imageFormat, bool genTransformImage) 
+    void excecuteTriangularWarp(std::string inputImage, std::string outputImage, std::string projFile, std::string inputGCPs, float resolution, std::string imageFormat, bool genTransformImage, unsigned int numThreads, double maxTransformError) 
     {
         
         try
@@ -275,7 +277,7 @@ namespace rsgis{ namespace cmds {
                 projWKTStr = textUtils.readFileToString(projFile);
             }
             
-            warp = new rsgis::reg::RSGISWarpImageUsingTriangulation(inputImage, outputImage, projWKTStr, inputGCPs, resolution, interpolator, imageFormat);
+            warp = new rsgis::reg::RSGISWarpImageUsingTriangulation(inputImage, outputImage, projWKTStr, inputGCPs, resolution, interpolator, imageFormat, numThreads, maxTransformError);
             if(genTransformImage)
             {
                 warp->generateTransformImage();
@@ -297,7 +299,7 @@ namespace rsgis{ namespace cmds {
     }
     
     
-    void excecutePolyWarp(std::string inputImage, std::string outputImage, std::string projFile, std::string inputGCPs, float resolution, int polyOrder, std::string imageFormat, bool genTransformImage) 
+    void excecutePolyWarp(std::string inputImage, std::string outputImage, std::string projFile, std::string inputGCPs, float resolution, int polyOrder, std::string imageFormat, bool genTransformImage, unsigned int numThreads, double maxTransformError) 
     {
         
         try
@@ -313,7 +315,7 @@ namespace rsgis{ namespace cmds {
                 projWKTStr = textUtils.readFileToString(projFile);
             }
             
-            warp = new rsgis::reg::RSGISPolynomialImageWarp(inputImage, outputImage, projWKTStr, inputGCPs, resolution, interpolator, polyOrder, imageFormat);
+            warp = new rsgis::reg::RSGISPolynomialImageWarp(inputImage, outputImage, projWKTStr, inputGCPs, resolution, interpolator, polyOrder, imageFormat, numThreads, maxTransformError);
             if(genTransformImage)
             {
                 warp->generateTransformImage();
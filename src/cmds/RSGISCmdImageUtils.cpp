@@ -871,14 +871,24 @@ namespace rsgis{ namespace cmds {
         }
     }
 
-    void executeImageMosaic(std::string *inputImages, int numDS, std::string outputImage, float background, float skipVal, unsigned int skipBand, unsigned int overlapBehaviour, std::string format, RSGISLibDataType outDataType) 
+    void executeImageMosaic(std::string *inputImages, int numDS, std::string outputImage, float background, float skipVal, unsigned int skipBand, unsigned int overlapBehaviour, std::string format, RSGISLibDataType outDataType, RSGISImageIOOptionsCmds *ioOptions) 
     {
         GDALAllRegister();
         try
         {
-            rsgis::img::RSGISImageMosaic mosaic;
-            // Projection hardcoded to from image (to simplify interface)
-            mosaic.mosaicSkipVals(inputImages, numDS, outputImage, background, skipVal, true, "", skipBand, overlapBehaviour, format, RSGIS_to_GDAL_Type(outDataType));
+            rsgis::img::RSGISImageIOPolicy *ioPolicy = createImageIOPolicy(ioOptions);
+            try
+            {
+                rsgis::img::RSGISImageMosaic mosaic(ioPolicy);
+                // Projection hardcoded to from image (to simplify interface)
+                mosaic.mosaicSkipVals(inputImages, numDS, outputImage, background, skipVal, true, "", skipBand, overlapBehaviour, format, RSGIS_to_GDAL_Type(outDataType));
+            }
+            catch(RSGISImageException &e)
+            {
+                delete ioPolicy;
+                throw e;
+            }
+            delete ioPolicy;
         }
         catch (RSGISImageException& e)
         {
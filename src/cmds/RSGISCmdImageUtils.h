@@ -29,6 +29,7 @@
 
 #include "common/RSGISCommons.h"
 #include "RSGISCmdException.h"
+#include "RSGISCmdCommon.h"
 
 // mark all exported classes/functions with DllExport to have
 // them exported by Visual Studio
@@ -108,7 +109,7 @@ namespace rsgis{ namespace cmds {
         - The minimum value is taken (overlapBehaviour=1)
         - The maximum behaviour is taken (overlapBehaviour=1)
      */
-    DllExport void executeImageMosaic(std::string *inputImages, int numDS, std::string outputImage, float background, float skipVal, unsigned int skipBand, unsigned int overlapBehaviour, std::string format, RSGISLibDataType outDataType);
+    DllExport void executeImageMosaic(std::string *inputImages, int numDS, std::string outputImage, float background, float skipVal, unsigned int skipBand, unsigned int overlapBehaviour, std::string format, RSGISLibDataType outDataType, RSGISImageIOOptionsCmds *ioOptions=NULL);
     
     /** A command to add images to an existing image*/
     DllExport void executeImageInclude(std::string *inputImages, int numDS, std::string baseImage, bool bandsDefined, std::vector<int> bands, float skipVal=0.0, bool useSkipVal=false);
@@ -30,6 +30,10 @@
 
 #include "gdal_priv.h"
 
+#include "img/RSGISImageIOPolicy.h"
+
+#include "RSGISCmdCommon.h"
+
 // mark all exported classes/functions with DllExport to have
 // them exported by Visual Studio
 #undef DllExport
@@ -113,6 +117,36 @@ namespace rsgis{ namespace cmds {
         return rsgisType;
     };
     
+    /** Creates the policy for the options (which the caller must delete) or returns NULL (i.e., the default policy) if no options are given. */
+    inline rsgis::img::RSGISImageIOPolicy* createImageIOPolicy(RSGISImageIOOptionsCmds *ioOptions)
+    {
+        if(ioOptions == NULL)
+        {
+            return NULL;
+        }
+        rsgis::img::RSGISImageIOPolicy *ioPolicy = new rsgis::img::RSGISImageIOPolicy();
+        try
+        {
+            ioPolicy->setCacheMax(ioOptions->cacheMax);
+            ioPolicy->setTiled(ioOptions->tiled);
+            ioPolicy->setBlockSize(ioOptions->blockSize);
+            ioPolicy->setCompression(ioOptions->compression);
+            ioPolicy->setCompressionLevel(ioOptions->compressionLevel);
+            ioPolicy->setNumThreads(ioOptions->numThreads);
+            for(std::vector<std::pair<std::string, std::string> >::iterator iterOpts = ioOptions->creationOptions.begin(); iterOpts != ioOptions->creationOptions.end(); ++iterOpts)
+            {
+                ioPolicy->setCreationOption((*iterOpts).first, (*iterOpts).second);
+            }
+            ioPolicy->setBuildOverviews(ioOptions->buildOverviews, ioOptions->overviewResampling, ioOptions->minOverviewSize);
+        }
+        catch(rsgis::RSGISImageException &e)
+        {
+            delete ioPolicy;
+            throw e;
+        }
+        return ioPolicy;
+    };
+    
 }}
 
 
@@ -1377,7 +1377,7 @@ namespace rsgis{ namespace cmds {
         }
     }
 
-    void executeInterpolateClumpValuesToImage(std::string clumpsImage, std::string selectField, std::string eastingsField, std::string northingsField, std::string methodStr, std::string valueField, std::string outputFile, std::string imageFormat, RSGISLibDataType dataType, unsigned int ratband)
+    void executeInterpolateClumpValuesToImage(std::string clumpsImage, std::string selectField, std::string eastingsField, std::string northingsField, std::string methodStr, std::string valueField, std::string outputFile, std::string imageFormat, RSGISLibDataType dataType, unsigned int ratband, unsigned int numThreads, double searchRadius)
     {
         GDALAllRegister();
         GDALDataset *clumpsDataset;
@@ -1407,6 +1407,14 @@ namespace rsgis{ namespace cmds {
             {
                 interpolator = new rsgis::math::RSGISAllPointsIDWInterpolator(8);
             }
+            else if(methodStr == "idwradius")
+            {
+                if(searchRadius <= 0)
+                {
+                    throw rsgis::RSGISAttributeTableException("The search radius must be greater than zero for the idwradius interpolator.");
+                }
+                interpolator = new rsgis::math::RSGISRadiusIDWInterpolator(8, searchRadius);
+            }
             else if(methodStr == "plane")
             {
                 interpolator = new rsgis::math::RSGISLinearTrendInterpolator();
@@ -1421,7 +1429,7 @@ namespace rsgis{ namespace cmds {
             }
             else
             {
-                std::cerr << "Available Interpolators: \'nearestneighbour\', \'naturalneighbour\', \'naturalnearestneighbour\', \'knearestneighbour\', \'idwall\'\n";
+                std::cerr << "Available Interpolators: \'nearestneighbour\', \'naturalneighbour\', \'naturalnearestneighbour\', \'knearestneighbour\', \'idwall\', \'idwradius\'\n";
                 throw rsgis::RSGISAttributeTableException("The interpolated specified was not recognised.");
             }
 
@@ -1433,7 +1441,7 @@ namespace rsgis{ namespace cmds {
             }
 
             rsgis::rastergis::RSGISInterpolateClumpValues2Image interpClumpVals;
-            interpClumpVals.interpolateImageFromClumps(clumpsDataset, selectField, eastingsField, northingsField, valueField, outputFile, imageFormat, rsgis::cmds::RSGIS_to_GDAL_Type(dataType), interpolator, ratband);
+            interpClumpVals.interpolateImageFromClumps(clumpsDataset, selectField, eastingsField, northingsField, valueField, outputFile, imageFormat, rsgis::cmds::RSGIS_to_GDAL_Type(dataType), interpolator, ratband, numThreads);
 
             delete interpolator;
 
@@ -117,7 +117,7 @@ namespace rsgis{ namespace cmds {
             
             std::cout << "Eliminating Individual Pixels\n";
             rsgis::segment::RSGISEliminateSinglePixels eliminate;
-            eliminate.eliminateBlocks(spectralDataset, clumpsDataset, pixelMaskDataset, outputImage, 0, ignoreZeros, true, "", imageFormat);
+            eliminate.eliminate(spectralDataset, clumpsDataset, pixelMaskDataset, outputImage, 0, ignoreZeros, true, "", imageFormat);
             
             clumpsDataset->GetRasterBand(1)->SetMetadataItem("LAYER_TYPE", "thematic");
             
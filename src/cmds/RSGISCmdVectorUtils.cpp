@@ -33,11 +33,13 @@
 #include "vec/RSGISProcessGeometry.h"
 #include "vec/RSGISGenerateConvexHullGroups.h"
 #include "vec/RSGISVectorUtils.h"
+#include "vec/RSGISVectorFeatureWriter.h"
 #include "vec/RSGISProcessFeatureCopyVector.h"
 #include "vec/RSGISVectorAttributeFindReplace.h"
 #include "vec/RSGISVectorBuffer.h"
 #include "vec/RSGISCalcPolygonArea.h"
 #include "vec/RSGISCopyPolygonsInPolygon.h"
+#include "vec/RSGISVectorOverlayIndex.h"
 #include "vec/RSGISPopulateFeatsElev.h"
 #include "vec/RSGISGetOGRGeometries.h"
 #include "vec/RSGISOGRPolygonReader.h"
@@ -197,7 +199,7 @@ namespace rsgis{ namespace cmds {
             }
             
             processFeature = new rsgis::vec::RSGISProcessFeatureCopyVector();
-            processVector = new rsgis::vec::RSGISProcessVector(processFeature);
+            processVector = new rsgis::vec::RSGISProcessVector(processFeature, true);
             
             processVector->processVectors(inputVecLayer, outputVecLayer, false, false, false);
             
@@ -278,7 +280,7 @@ namespace rsgis{ namespace cmds {
             }
             
             processGeom = new rsgis::vec::RSGISVectorBuffer(bufferDist);
-            processVector = new rsgis::vec::RSGISProcessGeometry(processGeom);
+            processVector = new rsgis::vec::RSGISProcessGeometry(processGeom, true);
             
             processVector->processGeometryPolygonOutput(inputVecLayer, outputVecLayer, true, false);
             
@@ -513,7 +515,7 @@ namespace rsgis{ namespace cmds {
             }
             
             processFeature = new rsgis::vec::RSGISCalcPolygonArea();
-            processVector = new rsgis::vec::RSGISProcessVector(processFeature);
+            processVector = new rsgis::vec::RSGISProcessVector(processFeature, true);
             
             processVector->processVectors(inputVecLayer, outputVecLayer, true, false, false);
             
@@ -538,7 +540,7 @@ namespace rsgis{ namespace cmds {
         
     }
     
-    void executePolygonsInPolygon(std::string inputVector, std::string inputCoverVector, std::string output_DIR, std::string attributeName, bool force) 
+    void executePolygonsInPolygon(std::string inputVector, std::string inputCoverVector, std::string output_DIR, std::string attributeName, bool force, unsigned int numThreads) 
     {
         try
         {
@@ -623,6 +625,11 @@ namespace rsgis{ namespace cmds {
             OGRFeature *feature = inputVecLayer->GetFeature(0);
             OGRwkbGeometryType geometryType = feature->GetGeometryRef()->getGeometryType();
             
+            // Read and index the input features once rather than for each cover feature.
+            rsgis::vec::RSGISVectorOverlayIndex inputIdx;
+            inputIdx.addLayer(inputVecLayer, true);
+            inputIdx.build(numThreads);
+            
             /********************************************
              * Loop through features in input shapefile *
              ********************************************/
@@ -690,7 +697,7 @@ namespace rsgis{ namespace cmds {
                 long unsigned numPolygonsInCover = 0;
                 try
                 {
-                    numPolygonsInCover = copyPolysinPoly.copyPolygonsInPoly(inputVecLayer, outputVecLayer, coverGeometry);
+                    numPolygonsInCover = copyPolysinPoly.copyPolygonsInPoly(&inputIdx, inputVecLayer->GetLayerDefn(), outputVecLayer, coverGeometry, numThreads);
                     GDALClose(outputVecDS);
                 }
                 catch (RSGISVectorException &e)
@@ -863,7 +870,7 @@ namespace rsgis{ namespace cmds {
             }
             
             rsgis::vec::RSGISProcessOGRFeature *processFeature = new rsgis::vec::RSGISPopulateFeatsElev(inputImageDS, imgBand);
-            rsgis::vec::RSGISProcessVector *processVector = new rsgis::vec::RSGISProcessVector(processFeature);
+            rsgis::vec::RSGISProcessVector *processVector = new rsgis::vec::RSGISProcessVector(processFeature, true);
             
             processVector->processVectors(inputVecLayer, outputVecLayer, true, false, false);
             
@@ -984,7 +991,7 @@ namespace rsgis{ namespace cmds {
             }
             
             processFeature = new rsgis::vec::RSGISVectorMaths(variables, numVars, expression, outColumn);
-            processVector = new rsgis::vec::RSGISProcessVector(processFeature);
+            processVector = new rsgis::vec::RSGISProcessVector(processFeature, true);
             processVector->processVectors(inputVecLayer, outputVecLayer, true, true, false);
             
             for(unsigned i = 0; i < numVars; ++i)
@@ -1099,7 +1106,7 @@ namespace rsgis{ namespace cmds {
             }
             
             rsgis::vec::RSGISCopyFeaturesAddFIDCol *copyFeatures = new rsgis::vec::RSGISCopyFeaturesAddFIDCol(1);
-            rsgis::vec::RSGISProcessVector *processVector = new rsgis::vec::RSGISProcessVector(copyFeatures);
+            rsgis::vec::RSGISProcessVector *processVector = new rsgis::vec::RSGISProcessVector(copyFeatures, true);
             processVector->processVectors(inputVecLayer, outputVecLayer, true, true, false);
             
             delete copyFeatures;
@@ -1201,11 +1208,12 @@ namespace rsgis{ namespace cmds {
                 std::string message = std::string("Could not create vector layer ") + SHPFileOutLayer;
                 throw rsgis::vec::RSGISVectorOutputException(message.c_str());
             }
-            OGRFeatureDefn *featDefn = outputVecLayer->GetLayerDefn();
-            OGRFeature *poFeature = new OGRFeature(featDefn);
+            rsgis::vec::RSGISVectorFeatureWriter featWriter(outputVecLayer);
+            OGRFeature *poFeature = featWriter.createFeature();
             OGRPolygon *poly = vecUtils.createOGRPolygon(env);
             poFeature->SetGeometryDirectly(poly);
-            outputVecLayer->CreateFeature(poFeature);
+            featWriter.writeFeature(poFeature);
+            featWriter.flush();
             GDALClose(outputVecDS);
             
             delete env;
@@ -1462,7 +1470,7 @@ namespace rsgis{ namespace cmds {
                 // Iterate through features and calc dist...
                 std::cout << "Calculate Distances\n";
                 rsgis::vec::RSGISCalcMinDist2GeomsUseIdx calcMinDist = rsgis::vec::RSGISCalcMinDist2GeomsUseIdx(outColName, geomsIdx, idxMaxSearch);
-                rsgis::vec::RSGISProcessVector processVector = rsgis::vec::RSGISProcessVector(&calcMinDist);
+                rsgis::vec::RSGISProcessVector processVector = rsgis::vec::RSGISProcessVector(&calcMinDist, true);
                 processVector.processVectors(inputVecLayer, outputVecLayer, true, false, false);
                 
                 maxMinDist = calcMinDist.getMaxMinDist();
@@ -1479,7 +1487,7 @@ namespace rsgis{ namespace cmds {
                 // Iterate through features and calc dist...
                 std::cout << "Calculate Distances\n";
                 rsgis::vec::RSGISCalcMinDist2Geoms calcMinDist = rsgis::vec::RSGISCalcMinDist2Geoms(outColName, ogrGeoms);
-                rsgis::vec::RSGISProcessVector processVector = rsgis::vec::RSGISProcessVector(&calcMinDist);
+                rsgis::vec::RSGISProcessVector processVector = rsgis::vec::RSGISProcessVector(&calcMinDist, true);
                 processVector.processVectors(inputVecLayer, outputVecLayer, true, false, false);
                 
                 maxMinDist = calcMinDist.getMaxMinDist();
@@ -1675,7 +1683,7 @@ namespace rsgis{ namespace cmds {
                 // Iterate through features and calc dist...
                 std::cout << "Calculate Distances\n";
                 rsgis::vec::RSGISCalcMinDist2GeomsUseIdx calcMinDist = rsgis::vec::RSGISCalcMinDist2GeomsUseIdx(outColName, geomsIdx, idxMaxSearch);
-                rsgis::vec::RSGISProcessVector processVector = rsgis::vec::RSGISProcessVector(&calcMinDist);
+                rsgis::vec::RSGISProcessVector processVector = rsgis::vec::RSGISProcessVector(&calcMinDist, true);
                 processVector.processVectors(inputVecLayer, outputVecLayer, true, false, false);
                 
                 maxMinDist = calcMinDist.getMaxMinDist();
@@ -1692,7 +1700,7 @@ namespace rsgis{ namespace cmds {
                 // Iterate through features and calc dist...
                 std::cout << "Calculate Distances\n";
                 rsgis::vec::RSGISCalcMinDist2Geoms calcMinDist = rsgis::vec::RSGISCalcMinDist2Geoms(outColName, ogrGeoms);
-                rsgis::vec::RSGISProcessVector processVector = rsgis::vec::RSGISProcessVector(&calcMinDist);
+                rsgis::vec::RSGISProcessVector processVector = rsgis::vec::RSGISProcessVector(&calcMinDist, true);
                 processVector.processVectors(inputVecLayer, outputVecLayer, true, false, false);
                 
                 maxMinDist = calcMinDist.getMaxMinDist();
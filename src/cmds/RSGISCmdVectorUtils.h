@@ -64,8 +64,8 @@ namespace rsgis{ namespace cmds{
     DllExport void executeFindReplaceText(std::string inputVector, std::string attribute, std::string find, std::string replace);
     /** Function to calculate polygon area */
     DllExport void executeCalcPolyArea(std::string inputVector, std::string outputVector, bool force);
-    /** Split polygons in in vector by polygons in cover vector */
-    DllExport void executePolygonsInPolygon(std::string inputVector, std::string inputCoverVector, std::string output_DIR, std::string attributeName, bool force);
+    /** Split polygons in in vector by polygons in cover vector. The input features are held in memory within a spatial index and tested using numThreads threads. */
+    DllExport void executePolygonsInPolygon(std::string inputVector, std::string inputCoverVector, std::string output_DIR, std::string attributeName, bool force, unsigned int numThreads=1);
     /** Populate the Z field on the vector geometries */
     DllExport void executePopulateGeomZField(std::string inputVector, std::string inputImage, unsigned int imgBand, std::string outputVector, bool force);
     /** Function to calculate a maths functions between  */
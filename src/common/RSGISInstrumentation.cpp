@@ -0,0 +1,491 @@
+/*
+ *  RSGISInstrumentation.cpp
+ *
+ *  RSGIS Common
+ *
+ *	Progress reporting (with cancellation), timers and I/O counters
+ *	which can be read programmatically or written as JSON.
+ *
+ *  Created by agent on 19/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISInstrumentation.h"
+
+#include <cstdlib>
+#include <cstdio>
+#include <thread>
+#include <functional>
+
+namespace rsgis
+{
+    static std::string escapeJSONString(const std::string &str)
+    {
+        std::string outStr;
+        outStr.reserve(str.size());
+        for(std::string::const_iterator iterChar = str.begin(); iterChar != str.end(); ++iterChar)
+        {
+            char c = *iterChar;
+            if((c == '"') || (c == '\\'))
+            {
+                outStr += '\\';
+                outStr += c;
+            }
+            else if(((unsigned char)c) < 0x20)
+            {
+                char buf[8];
+                snprintf(buf, 8, "\\u%04x", (unsigned int)c);
+                outStr += buf;
+            }
+            else
+            {
+                outStr += c;
+            }
+        }
+        return outStr;
+    }
+
+    static double getSecondsBetween(std::chrono::steady_clock::time_point startTime, std::chrono::steady_clock::time_point endTime)
+    {
+        return std::chrono::duration<double>(endTime - startTime).count();
+    }
+
+
+    RSGISJSONProgressMonitor::RSGISJSONProgressMonitor(std::ostream *out) : RSGISProgressMonitor()
+    {
+        this->out = out;
+        this->createdTime = std::chrono::steady_clock::now();
+    }
+
+    void RSGISJSONProgressMonitor::started(const std::string &task, unsigned long long numItems)
+    {
+        std::lock_guard<std::mutex> lock(this->outMutex);
+        (*this->out) << "{\"event\":\"started\",\"task\":\"" << escapeJSONString(task) << "\",\"items\":" << numItems << ",\"time\":" << this->getElapsedTime() << "}" << std::endl;
+    }
+
+    bool RSGISJSONProgressMonitor::update(const std::string &task, int percent)
+    {
+        std::lock_guard<std::mutex> lock(this->outMutex);
+        (*this->out) << "{\"event\":\"progress\",\"task\":\"" << escapeJSONString(task) << "\",\"percent\":" << percent << ",\"time\":" << this->getElapsedTime() << "}" << std::endl;
+        return !this->cancelled;
+    }
+
+    void RSGISJSONProgressMonitor::completed(const std::string &task, double time)
+    {
+        std::lock_guard<std::mutex> lock(this->outMutex);
+        (*this->out) << "{\"event\":\"completed\",\"task\":\"" << escapeJSONString(task) << "\",\"duration\":" << time << ",\"time\":" << this->getElapsedTime() << "}" << std::endl;
+    }
+
+    double RSGISJSONProgressMonitor::getElapsedTime()
+    {
+        return getSecondsBetween(this->createdTime, std::chrono::steady_clock::now());
+    }
+
+
+    RSGISInstrumentation* RSGISInstrumentation::getInstance()
+    {
+        static RSGISInstrumentation instance;
+        return &instance;
+    }
+
+    RSGISInstrumentation::RSGISInstrumentation()
+    {
+        for(int i = 0; i < rsgisNumInstrumentCounters; ++i)
+        {
+            this->counters[i] = 0;
+        }
+        this->monitor = NULL;
+        this->envMonitor = NULL;
+        this->envMonitorFile = NULL;
+        this->traceFile = NULL;
+        this->firstTraceEvent = true;
+        this->createdTime = std::chrono::steady_clock::now();
+
+        const char *progressFileName = std::getenv("RSGIS_PROGRESS_FILE");
+        if((progressFileName != NULL) && (progressFileName[0] != '\0'))
+        {
+            this->envMonitorFile = new std::ofstream(progressFileName, std::ios::out | std::ios::trunc);
+            if(this->envMonitorFile->is_open())
+            {
+                this->envMonitor = new RSGISJSONProgressMonitor(this->envMonitorFile);
+                this->monitor = this->envMonitor;
+            }
+            else
+            {
+                std::cerr << "Could not open the progress file: " << progressFileName << std::endl;
+                delete this->envMonitorFile;
+                this->envMonitorFile = NULL;
+            }
+        }
+
+        const char *traceFileName = std::getenv("RSGIS_TRACE_FILE");
+        if((traceFileName != NULL) && (traceFileName[0] != '\0'))
+        {
+            if(!this->startTrace(traceFileName))
+            {
+                std::cerr << "Could not open the trace file: " << traceFileName << std::endl;
+            }
+        }
+
+        const char *summaryFileName = std::getenv("RSGIS_INSTRUMENTATION_FILE");
+        if(summaryFileName != NULL)
+        {
+            this->summaryFileName = summaryFileName;
+        }
+    }
+
+    void RSGISInstrumentation::recordRasterIO(bool write, unsigned long long numBytes)
+    {
+        RSGISInstrumentation *instrumentation = getInstance();
+        if(write)
+        {
+            ++instrumentation->counters[rsgisRasterWriteCalls];
+            instrumentation->counters[rsgisRasterWriteBytes] += numBytes;
+        }
+        else
+        {
+            ++instrumentation->counters[rsgisRasterReadCalls];
+            instrumentation->counters[rsgisRasterReadBytes] += numBytes;
+        }
+    }
+
+    void RSGISInstrumentation::recordRATValuesIO(bool write, unsigned long long numValues)
+    {
+        RSGISInstrumentation *instrumentation = getInstance();
+        if(write)
+        {
+            ++instrumentation->counters[rsgisRATWriteCalls];
+            instrumentation->counters[rsgisRATWriteValues] += numValues;
+        }
+        else
+        {
+            ++instrumentation->counters[rsgisRATReadCalls];
+            instrumentation->counters[rsgisRATReadValues] += numValues;
+        }
+    }
+
+    const char* RSGISInstrumentation::getCounterName(RSGISInstrumentCounter counter)
+    {
+        switch(counter)
+        {
+            case rsgisRasterReadCalls:
+                return "raster_read_calls";
+            case rsgisRasterReadBytes:
+                return "raster_read_bytes";
+            case rsgisRasterWriteCalls:
+                return "raster_write_calls";
+            case rsgisRasterWriteBytes:
+                return "raster_write_bytes";
+            case rsgisRATReadCalls:
+                return "rat_read_calls";
+            case rsgisRATReadValues:
+                return "rat_read_values";
+            case rsgisRATWriteCalls:
+                return "rat_write_calls";
+            case rsgisRATWriteValues:
+                return "rat_write_values";
+            case rsgisPixelsProcessed:
+                return "pixels_processed";
+            case rsgisRATRowsProcessed:
+                return "rat_rows_processed";
+            case rsgisFeaturesProcessed:
+                return "features_processed";
+            default:
+                return "unknown";
+        }
+    }
+
+    void RSGISInstrumentation::addTiming(const std::string &name, std::chrono::steady_clock::time_point startTime, std::chrono::steady_clock::time_point endTime)
+    {
+        double time = getSecondsBetween(startTime, endTime);
+        std::lock_guard<std::mutex> lock(this->dataMutex);
+        std::map<std::string, RSGISTimingSummary>::iterator iterTiming = this->timings.find(name);
+        if(iterTiming == this->timings.end())
+        {
+            RSGISTimingSummary timing;
+            timing.count = 1;
+            timing.totalTime = time;
+            timing.maxTime = time;
+            this->timings[name] = timing;
+        }
+        else
+        {
+            ++iterTiming->second.count;
+            iterTiming->second.totalTime += time;
+            if(time > iterTiming->second.maxTime)
+            {
+                iterTiming->second.maxTime = time;
+            }
+        }
+
+        if(this->traceFile != NULL)
+        {
+            // Complete ("X") events with times in microseconds.
+            long long startMicroSecs = std::chrono::duration_cast<std::chrono::microseconds>(startTime - this->createdTime).count();
+            long long durMicroSecs = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+            size_t threadID = std::hash<std::thread::id>()(std::this_thread::get_id()) % 1000000;
+            if(!this->firstTraceEvent)
+            {
+                (*this->traceFile) << ",\n";
+            }
+            (*this->traceFile) << "{\"name\":\"" << escapeJSONString(name) << "\",\"cat\":\"rsgis\",\"ph\":\"X\",\"ts\":" << startMicroSecs << ",\"dur\":" << durMicroSecs << ",\"pid\":1,\"tid\":" << threadID << "}";
+            this->traceFile->flush();
+            this->firstTraceEvent = false;
+        }
+    }
+
+    bool RSGISInstrumentation::getTiming(const std::string &name, RSGISTimingSummary *timing)
+    {
+        std::lock_guard<std::mutex> lock(this->dataMutex);
+        std::map<std::string, RSGISTimingSummary>::iterator iterTiming = this->timings.find(name);
+        if(iterTiming == this->timings.end())
+        {
+            return false;
+        }
+        *timing = iterTiming->second;
+        return true;
+    }
+
+    void RSGISInstrumentation::setGauge(const std::string &name, double val)
+    {
+        std::lock_guard<std::mutex> lock(this->dataMutex);
+        this->gauges[name] = val;
+    }
+
+    void RSGISInstrumentation::setGaugeMax(const std::string &name, double val)
+    {
+        std::lock_guard<std::mutex> lock(this->dataMutex);
+        std::map<std::string, double>::iterator iterGauge = this->gauges.find(name);
+        if((iterGauge == this->gauges.end()) || (val > iterGauge->second))
+        {
+            this->gauges[name] = val;
+        }
+    }
+
+    bool RSGISInstrumentation::getGauge(const std::string &name, double *val)
+    {
+        std::lock_guard<std::mutex> lock(this->dataMutex);
+        std::map<std::string, double>::iterator iterGauge = this->gauges.find(name);
+        if(iterGauge == this->gauges.end())
+        {
+            return false;
+        }
+        *val = iterGauge->second;
+        return true;
+    }
+
+    void RSGISInstrumentation::reset()
+    {
+        for(int i = 0; i < rsgisNumInstrumentCounters; ++i)
+        {
+            this->counters[i] = 0;
+        }
+        std::lock_guard<std::mutex> lock(this->dataMutex);
+        this->timings.clear();
+        this->gauges.clear();
+    }
+
+    void RSGISInstrumentation::setProgressMonitor(RSGISProgressMonitor *monitor)
+    {
+        this->monitor = monitor;
+    }
+
+    bool RSGISInstrumentation::startTrace(const std::string &fileName)
+    {
+        this->stopTrace();
+        std::ofstream *outFile = new std::ofstream(fileName.c_str(), std::ios::out | std::ios::trunc);
+        if(!outFile->is_open())
+        {
+            delete outFile;
+            return false;
+        }
+        (*outFile) << "[\n";
+
+        std::lock_guard<std::mutex> lock(this->dataMutex);
+        this->traceFile = outFile;
+        this->firstTraceEvent = true;
+        return true;
+    }
+
+    void RSGISInstrumentation::stopTrace()
+    {
+        std::lock_guard<std::mutex> lock(this->dataMutex);
+        if(this->traceFile != NULL)
+        {
+            (*this->traceFile) << "\n]\n";
+            this->traceFile->close();
+            delete this->traceFile;
+            this->traceFile = NULL;
+        }
+    }
+
+    void RSGISInstrumentation::writeSummaryJSON(std::ostream &out)
+    {
+        out << "{\n  \"counters\": {";
+        for(int i = 0; i < rsgisNumInstrumentCounters; ++i)
+        {
+            if(i > 0)
+            {
+                out << ",";
+            }
+            out << "\n    \"" << getCounterName((RSGISInstrumentCounter)i) << "\": " << this->counters[i];
+        }
+        out << "\n  },\n  \"timings\": {";
+
+        std::lock_guard<std::mutex> lock(this->dataMutex);
+        bool first = true;
+        for(std::map<std::string, RSGISTimingSummary>::iterator iterTiming = this->timings.begin(); iterTiming != this->timings.end(); ++iterTiming)
+        {
+            if(!first)
+            {
+                out << ",";
+            }
+            out << "\n    \"" << escapeJSONString(iterTiming->first) << "\": {\"count\": " << iterTiming->second.count << ", \"total_seconds\": " << iterTiming->second.totalTime << ", \"max_seconds\": " << iterTiming->second.maxTime << "}";
+            first = false;
+        }
+        out << "\n  },\n  \"gauges\": {";
+        first = true;
+        for(std::map<std::string, double>::iterator iterGauge = this->gauges.begin(); iterGauge != this->gauges.end(); ++iterGauge)
+        {
+            if(!first)
+            {
+                out << ",";
+            }
+            out << "\n    \"" << escapeJSONString(iterGauge->first) << "\": " << iterGauge->second;
+            first = false;
+        }
+        out << "\n  }\n}\n";
+    }
+
+    bool RSGISInstrumentation::writeSummaryJSON(const std::string &fileName)
+    {
+        std::ofstream outFile(fileName.c_str(), std::ios::out | std::ios::trunc);
+        if(!outFile.is_open())
+        {
+            return false;
+        }
+        this->writeSummaryJSON(outFile);
+        outFile.close();
+        return true;
+    }
+
+    void RSGISInstrumentation::printSummary()
+    {
+        for(int i = 0; i < rsgisNumInstrumentCounters; ++i)
+        {
+            std::cout << getCounterName((RSGISInstrumentCounter)i) << ": " << this->counters[i] << std::endl;
+        }
+        std::lock_guard<std::mutex> lock(this->dataMutex);
+        for(std::map<std::string, RSGISTimingSummary>::iterator iterTiming = this->timings.begin(); iterTiming != this->timings.end(); ++iterTiming)
+        {
+            std::cout << iterTiming->first << ": " << iterTiming->second.totalTime << " seconds (" << iterTiming->second.count << " calls, max " << iterTiming->second.maxTime << " seconds)" << std::endl;
+        }
+        for(std::map<std::string, double>::iterator iterGauge = this->gauges.begin(); iterGauge != this->gauges.end(); ++iterGauge)
+        {
+            std::cout << iterGauge->first << ": " << iterGauge->second << std::endl;
+        }
+    }
+
+    RSGISInstrumentation::~RSGISInstrumentation()
+    {
+        if(this->summaryFileName != "")
+        {
+            if(!this->writeSummaryJSON(this->summaryFileName))
+            {
+                std::cerr << "Could not write the instrumentation summary: " << this->summaryFileName << std::endl;
+            }
+        }
+        this->stopTrace();
+        if(this->envMonitor != NULL)
+        {
+            if(this->monitor == this->envMonitor)
+            {
+                this->monitor = NULL;
+            }
+            delete this->envMonitor;
+            this->envMonitorFile->close();
+            delete this->envMonitorFile;
+        }
+    }
+
+
+    RSGISScopedTimer::RSGISScopedTimer(const std::string &name)
+    {
+        this->name = name;
+        this->startTime = std::chrono::steady_clock::now();
+    }
+
+    RSGISScopedTimer::~RSGISScopedTimer()
+    {
+        RSGISInstrumentation::getInstance()->addTiming(this->name, this->startTime, std::chrono::steady_clock::now());
+    }
+
+
+    RSGISProgressReporter::RSGISProgressReporter(const std::string &task, RSGISInstrumentCounter itemsCounter)
+    {
+        this->task = task;
+        this->itemsCounter = itemsCounter;
+        this->numItems = 0;
+        this->started = false;
+        this->startTime = std::chrono::steady_clock::now();
+    }
+
+    void RSGISProgressReporter::start(unsigned long long numItems)
+    {
+        this->numItems = numItems;
+        this->started = true;
+        RSGISProgressMonitor *monitor = RSGISInstrumentation::getInstance()->getProgressMonitor();
+        if(monitor != NULL)
+        {
+            monitor->started(this->task, numItems);
+        }
+    }
+
+    bool RSGISProgressReporter::update(int percent)
+    {
+        RSGISProgressMonitor *monitor = RSGISInstrumentation::getInstance()->getProgressMonitor();
+        if(monitor != NULL)
+        {
+            if(!monitor->update(this->task, percent))
+            {
+                return false;
+            }
+            return !monitor->isCancelled();
+        }
+        return true;
+    }
+
+    void RSGISProgressReporter::complete()
+    {
+        RSGISInstrumentation *instrumentation = RSGISInstrumentation::getInstance();
+        if(this->started)
+        {
+            RSGISInstrumentation::addCount(this->itemsCounter, this->numItems);
+        }
+        RSGISProgressMonitor *monitor = instrumentation->getProgressMonitor();
+        if(monitor != NULL)
+        {
+            monitor->completed(this->task, getSecondsBetween(this->startTime, std::chrono::steady_clock::now()));
+        }
+    }
+
+    RSGISProgressReporter::~RSGISProgressReporter()
+    {
+        RSGISInstrumentation::getInstance()->addTiming(this->task, this->startTime, std::chrono::steady_clock::now());
+    }
+
+}
@@ -0,0 +1,221 @@
+/*
+ *  RSGISInstrumentation.h
+ *
+ *  RSGIS Common
+ *
+ *	Progress reporting (with cancellation), timers and I/O counters
+ *	which can be read programmatically or written as JSON.
+ *
+ *  Created by agent on 19/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISInstrumentation_H
+#define RSGISInstrumentation_H
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <map>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_commons_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis
+{
+    /** The counters held by RSGISInstrumentation. */
+    enum RSGISInstrumentCounter
+    {
+        rsgisRasterReadCalls,
+        rsgisRasterReadBytes,
+        rsgisRasterWriteCalls,
+        rsgisRasterWriteBytes,
+        rsgisRATReadCalls,
+        rsgisRATReadValues,
+        rsgisRATWriteCalls,
+        rsgisRATWriteValues,
+        rsgisPixelsProcessed,
+        rsgisRATRowsProcessed,
+        rsgisFeaturesProcessed,
+        rsgisNumInstrumentCounters
+    };
+
+    /**
+     * Receives the progress of long running operations (e.g., RSGISCalcImage), in addition
+     * to the dots written to the console. update is called at each 10 percent; returning false
+     * (or calling cancel, which can be done from another thread) stops the operation at the
+     * next update with an exception.
+     */
+    class DllExport RSGISProgressMonitor
+    {
+    public:
+        RSGISProgressMonitor(){this->cancelled = false;};
+        virtual void started(const std::string &task, unsigned long long numItems)=0;
+        virtual bool update(const std::string &task, int percent)=0;
+        virtual void completed(const std::string &task, double time)=0;
+        void cancel(){this->cancelled = true;};
+        void resetCancel(){this->cancelled = false;};
+        bool isCancelled(){return this->cancelled;};
+        virtual ~RSGISProgressMonitor(){};
+    protected:
+        std::atomic<bool> cancelled;
+    };
+
+    /**
+     * Writes each progress event as a line of JSON (e.g., {"event":"progress","task":"...","percent":10,"time":1.5}),
+     * where time is in seconds since the monitor was created, for batch schedulers to parse.
+     */
+    class DllExport RSGISJSONProgressMonitor : public RSGISProgressMonitor
+    {
+    public:
+        RSGISJSONProgressMonitor(std::ostream *out);
+        virtual void started(const std::string &task, unsigned long long numItems);
+        virtual bool update(const std::string &task, int percent);
+        virtual void completed(const std::string &task, double time);
+        ~RSGISJSONProgressMonitor(){};
+    protected:
+        double getElapsedTime();
+        std::ostream *out;
+        std::mutex outMutex;
+        std::chrono::steady_clock::time_point createdTime;
+    };
+
+    /** The number of times and the time (in seconds) taken by a timed task. */
+    struct DllExport RSGISTimingSummary
+    {
+        unsigned long long count;
+        double totalTime;
+        double maxTime;
+    };
+
+    /**
+     * Holds the counters, timings and gauges (e.g., the GDAL cache size) for the process and
+     * the progress monitor, if one has been set. The counters can be updated from any thread.
+     *
+     * So it can be used without recompiling, the following environment variables are read
+     * when it is first used:
+     *   RSGIS_PROGRESS_FILE - progress events are written to the file as lines of JSON.
+     *   RSGIS_TRACE_FILE - each timed task is written to the file in the Chrome trace event format.
+     *   RSGIS_INSTRUMENTATION_FILE - the summary (see writeSummaryJSON) is written to the file on exit.
+     */
+    class DllExport RSGISInstrumentation
+    {
+    public:
+        static RSGISInstrumentation* getInstance();
+        static void addCount(RSGISInstrumentCounter counter, unsigned long long val)
+        {
+            getInstance()->counters[counter] += val;
+        };
+        /** Counts a call to RasterIO reading or writing numBytes. */
+        static void recordRasterIO(bool write, unsigned long long numBytes);
+        /** Counts a call to ValuesIO on a raster attribute table reading or writing numValues. */
+        static void recordRATValuesIO(bool write, unsigned long long numValues);
+        unsigned long long getCount(RSGISInstrumentCounter counter){return this->counters[counter];};
+        static const char* getCounterName(RSGISInstrumentCounter counter);
+        void addTiming(const std::string &name, std::chrono::steady_clock::time_point startTime, std::chrono::steady_clock::time_point endTime);
+        bool getTiming(const std::string &name, RSGISTimingSummary *timing);
+        void setGauge(const std::string &name, double val);
+        /** Sets the gauge to val if it is greater than the current value. */
+        void setGaugeMax(const std::string &name, double val);
+        bool getGauge(const std::string &name, double *val);
+        /** Resets the counters, timings and gauges. */
+        void reset();
+        /** Sets the progress monitor, which is not deleted; NULL removes it. */
+        void setProgressMonitor(RSGISProgressMonitor *monitor);
+        RSGISProgressMonitor* getProgressMonitor(){return this->monitor;};
+        /** Writes the timed tasks to the file in the Chrome trace event format until stopTrace is called. */
+        bool startTrace(const std::string &fileName);
+        void stopTrace();
+        /** Writes the counters, timings and gauges as a JSON object. */
+        void writeSummaryJSON(std::ostream &out);
+        bool writeSummaryJSON(const std::string &fileName);
+        void printSummary();
+        ~RSGISInstrumentation();
+    protected:
+        RSGISInstrumentation();
+        std::atomic<unsigned long long> counters[rsgisNumInstrumentCounters];
+        std::mutex dataMutex;
+        std::map<std::string, RSGISTimingSummary> timings;
+        std::map<std::string, double> gauges;
+        std::atomic<RSGISProgressMonitor*> monitor;
+        RSGISProgressMonitor *envMonitor;
+        std::ofstream *envMonitorFile;
+        std::ofstream *traceFile;
+        bool firstTraceEvent;
+        std::string summaryFileName;
+        std::chrono::steady_clock::time_point createdTime;
+    private:
+        RSGISInstrumentation(const RSGISInstrumentation &instrumentation);
+        RSGISInstrumentation& operator=(const RSGISInstrumentation &instrumentation);
+    };
+
+    /** Records the time from construction to destruction under name. */
+    class DllExport RSGISScopedTimer
+    {
+    public:
+        RSGISScopedTimer(const std::string &name);
+        ~RSGISScopedTimer();
+    protected:
+        std::string name;
+        std::chrono::steady_clock::time_point startTime;
+    };
+
+    /**
+     * Used by an operation to report its progress to the progress monitor (if one has been
+     * set) and record its time and the number of items (pixels, rows or features) processed.
+     * update returns false if the operation has been cancelled.
+     */
+    class DllExport RSGISProgressReporter
+    {
+    public:
+        RSGISProgressReporter(const std::string &task, RSGISInstrumentCounter itemsCounter=rsgisPixelsProcessed);
+        void start(unsigned long long numItems);
+        bool update(int percent);
+        /** As update but throws an ExceptionType with the message if the operation has been cancelled. */
+        template<class ExceptionType> void updateOrThrow(int percent, const char *message="The calculation was cancelled.")
+        {
+            if(!this->update(percent))
+            {
+                throw ExceptionType(message);
+            }
+        };
+        void complete();
+        ~RSGISProgressReporter();
+    protected:
+        std::string task;
+        RSGISInstrumentCounter itemsCounter;
+        unsigned long long numItems;
+        bool started;
+        std::chrono::steady_clock::time_point startTime;
+    };
+
+}
+
+#endif
@@ -0,0 +1,125 @@
+/*
+ *  RSGISThreadUtils.cpp
+ *
+ *  RSGIS Common
+ *
+ *	Simple utilities for splitting independent units of work
+ *	(e.g., image rows, tie points, tiles) across threads.
+ *
+ *  Created by agent on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISThreadUtils.h"
+
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <exception>
+#include <algorithm>
+
+namespace rsgis
+{
+    
+    unsigned int getNumProcessingThreads(unsigned int numThreads)
+    {
+        if(numThreads == 0)
+        {
+            numThreads = std::thread::hardware_concurrency();
+            if(numThreads == 0)
+            {
+                numThreads = 1;
+            }
+        }
+        return numThreads;
+    }
+    
+    void parallelForRange(size_t begin, size_t end, unsigned int numThreads, size_t grainSize, const std::function<void(size_t, size_t, unsigned int)> &func)
+    {
+        if(end <= begin)
+        {
+            return;
+        }
+        if(grainSize == 0)
+        {
+            grainSize = 1;
+        }
+        
+        numThreads = getNumProcessingThreads(numThreads);
+        size_t numChunks = ((end - begin) + grainSize - 1) / grainSize;
+        if(numChunks < numThreads)
+        {
+            numThreads = numChunks;
+        }
+        
+        if(numThreads <= 1)
+        {
+            for(size_t i = begin; i < end; i += grainSize)
+            {
+                func(i, std::min(i+grainSize, end), 0);
+            }
+            return;
+        }
+        
+        std::atomic<size_t> nextChunk(0);
+        std::atomic<bool> failed(false);
+        std::exception_ptr firstError = nullptr;
+        std::mutex errorLock;
+        
+        auto worker = [&](unsigned int threadIdx)
+        {
+            try
+            {
+                size_t chunk = 0;
+                while((!failed) && ((chunk = nextChunk++) < numChunks))
+                {
+                    size_t chunkStart = begin + (chunk * grainSize);
+                    size_t chunkEnd = std::min(chunkStart + grainSize, end);
+                    func(chunkStart, chunkEnd, threadIdx);
+                }
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock(errorLock);
+                if(!failed)
+                {
+                    firstError = std::current_exception();
+                    failed = true;
+                }
+            }
+        };
+        
+        std::vector<std::thread> threads;
+        threads.reserve(numThreads-1);
+        for(unsigned int t = 1; t < numThreads; ++t)
+        {
+            threads.push_back(std::thread(worker, t));
+        }
+        worker(0);
+        for(std::vector<std::thread>::iterator iterThread = threads.begin(); iterThread != threads.end(); ++iterThread)
+        {
+            (*iterThread).join();
+        }
+        
+        if(firstError != nullptr)
+        {
+            std::rethrow_exception(firstError);
+        }
+    }
+    
+}
@@ -0,0 +1,67 @@
+/*
+ *  RSGISThreadUtils.h
+ *
+ *  RSGIS Common
+ *
+ *	Simple utilities for splitting independent units of work
+ *	(e.g., image rows, tie points, tiles) across threads.
+ *
+ *  Created by agent on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISThreadUtils_H
+#define RSGISThreadUtils_H
+
+#include <iostream>
+#include <string>
+#include <functional>
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_commons_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis
+{
+    /**
+     * Returns the number of threads to use given the number requested by the user.
+     * A value of 0 is interpreted as 'use all the available hardware threads'.
+     */
+    DllExport unsigned int getNumProcessingThreads(unsigned int numThreads);
+    
+    /**
+     * Calls func(start, end, threadIdx) for chunks of the range [begin, end). The chunks
+     * are of size 'grainSize' (the last may be smaller) and are handed out dynamically
+     * so threads which finish early pick up more work. threadIdx is in [0, numThreads)
+     * and can be used to index per-thread buffers. If numThreads is 1 the function is
+     * called on the calling thread. Any exception thrown by func is re-thrown on the 
+     * calling thread once all the threads have stopped.
+     */
+    DllExport void parallelForRange(size_t begin, size_t end, unsigned int numThreads, size_t grainSize, const std::function<void(size_t, size_t, unsigned int)> &func);
+    
+}
+
+#endif
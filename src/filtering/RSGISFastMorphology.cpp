@@ -0,0 +1,436 @@
+/*
+ *  RSGISFastMorphology.cpp
+ *  RSGIS_LIB
+ *
+ *  Created by agent on 19/10/2026.
+ *  Copyright 2026 RSGISLib.
+ * 
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISFastMorphology.h"
+
+namespace rsgis{namespace filter{
+    
+    struct RSGISMorphMaxOp
+    {
+        static float ext(float a, float b){return (a > b)?a:b;};
+        static float ident(){return -std::numeric_limits<float>::infinity();};
+    };
+    
+    struct RSGISMorphMinOp
+    {
+        static float ext(float a, float b){return (a < b)?a:b;};
+        static float ident(){return std::numeric_limits<float>::infinity();};
+    };
+    
+    /*
+     * Max/min over the window [x+xOff, x+xOff+length-1] for each pixel of each row 
+     * (van Herk/Gil-Werman). The prefix and suffix extremums are found within blocks 
+     * of length values so any window is covered by the suffix of one block and the 
+     * prefix of the next. Windows clipped by the image edge are within a block.
+     */
+    template <class Op> static void morphRunExtremum(const float *data, float *output, long width, long height, int xOff, int length, float *prefix, float *suffix)
+    {
+        for(long y = 0; y < height; ++y)
+        {
+            const float *inRow = data + (y * width);
+            float *outRow = output + (y * width);
+            if(length == 1)
+            {
+                for(long x = 0; x < width; ++x)
+                {
+                    long sx = x + xOff;
+                    outRow[x] = ((sx >= 0) && (sx < width))?inRow[sx]:Op::ident();
+                }
+                continue;
+            }
+            
+            for(long k = 0; k < width; ++k)
+            {
+                prefix[k] = ((k % length) == 0)?inRow[k]:Op::ext(prefix[k-1], inRow[k]);
+            }
+            for(long k = width-1; k >= 0; --k)
+            {
+                suffix[k] = ((k == (width-1)) || ((k % length) == (length-1)))?inRow[k]:Op::ext(suffix[k+1], inRow[k]);
+            }
+            
+            for(long x = 0; x < width; ++x)
+            {
+                long s = std::max<long>(x + xOff, 0);
+                long e = std::min<long>(x + xOff + length - 1, width - 1);
+                if(s > e)
+                {
+                    outRow[x] = Op::ident();
+                }
+                else if((s / length) != (e / length))
+                {
+                    outRow[x] = Op::ext(suffix[s], prefix[e]);
+                }
+                else if((s % length) == 0)
+                {
+                    outRow[x] = prefix[e];
+                }
+                else
+                {
+                    outRow[x] = suffix[s];
+                }
+            }
+        }
+    }
+    
+    /*
+     * As morphRunExtremum but over the rows [y+yStart, y+yEnd], processed a row at a 
+     * time so the pixels are accessed in order. The result is combined with output.
+     */
+    template <class Op> static void morphRowsExtremum(const float *data, float *output, long width, long height, int yStart, int yEnd, float *prefix, float *suffix)
+    {
+        long length = (yEnd - yStart) + 1;
+        if(length > 1)
+        {
+            for(long k = 0; k < height; ++k)
+            {
+                float *pRow = prefix + (k * width);
+                const float *inRow = data + (k * width);
+                if((k % length) == 0)
+                {
+                    std::copy(inRow, inRow + width, pRow);
+                }
+                else
+                {
+                    const float *pPrevRow = pRow - width;
+                    for(long x = 0; x < width; ++x)
+                    {
+                        pRow[x] = Op::ext(pPrevRow[x], inRow[x]);
+                    }
+                }
+            }
+            for(long k = height-1; k >= 0; --k)
+            {
+                float *sRow = suffix + (k * width);
+                const float *inRow = data + (k * width);
+                if((k == (height-1)) || ((k % length) == (length-1)))
+                {
+                    std::copy(inRow, inRow + width, sRow);
+                }
+                else
+                {
+                    const float *sNextRow = sRow + width;
+                    for(long x = 0; x < width; ++x)
+                    {
+                        sRow[x] = Op::ext(sNextRow[x], inRow[x]);
+                    }
+                }
+            }
+        }
+        
+        for(long y = 0; y < height; ++y)
+        {
+            float *outRow = output + (y * width);
+            long s = std::max<long>(y + yStart, 0);
+            long e = std::min<long>(y + yEnd, height - 1);
+            if(s > e)
+            {
+                continue;
+            }
+            
+            const float *rowA = NULL;
+            const float *rowB = NULL;
+            if(length == 1)
+            {
+                rowA = data + (s * width);
+            }
+            else if((s / length) != (e / length))
+            {
+                rowA = suffix + (s * width);
+                rowB = prefix + (e * width);
+            }
+            else if((s % length) == 0)
+            {
+                rowA = prefix + (e * width);
+            }
+            else
+            {
+                rowA = suffix + (s * width);
+            }
+            
+            if(rowB == NULL)
+            {
+                for(long x = 0; x < width; ++x)
+                {
+                    outRow[x] = Op::ext(outRow[x], rowA[x]);
+                }
+            }
+            else
+            {
+                for(long x = 0; x < width; ++x)
+                {
+                    outRow[x] = Op::ext(outRow[x], Op::ext(rowA[x], rowB[x]));
+                }
+            }
+        }
+    }
+    
+    
+    RSGISFastMorphology::RSGISFastMorphology(rsgis::math::Matrix *matrixOperator)
+    {
+        if(matrixOperator->n != matrixOperator->m)
+        {
+            throw rsgis::img::RSGISImageCalcException("Morphological operator must be a square matrix.");
+        }
+        if((matrixOperator->n % 2) == 0)
+        {
+            throw rsgis::img::RSGISImageCalcException("Morphological operator must have an odd size.");
+        }
+        
+        int winSize = matrixOperator->n;
+        int winMid = winSize / 2;
+        
+        // Find the horizontal runs within each row of the operator.
+        std::vector<RSGISMorphologySESegment> rowRuns;
+        for(int i = 0; i < winSize; ++i)
+        {
+            int j = 0;
+            while(j < winSize)
+            {
+                if(matrixOperator->matrix[(i*winSize)+j] > 0)
+                {
+                    int runStart = j;
+                    while((j < winSize) && (matrixOperator->matrix[(i*winSize)+j] > 0))
+                    {
+                        ++j;
+                    }
+                    RSGISMorphologySESegment seg;
+                    seg.xOff = runStart - winMid;
+                    seg.length = j - runStart;
+                    seg.yStart = i - winMid;
+                    seg.yEnd = i - winMid;
+                    rowRuns.push_back(seg);
+                }
+                else
+                {
+                    ++j;
+                }
+            }
+        }
+        
+        if(rowRuns.empty())
+        {
+            throw rsgis::img::RSGISImageCalcException("Morphological operator does not have any non-zero values.");
+        }
+        
+        // Merge identical runs on consecutive rows into rectangles (a square operator gives a single rectangle).
+        std::sort(rowRuns.begin(), rowRuns.end(), [](const RSGISMorphologySESegment &a, const RSGISMorphologySESegment &b)
+        {
+            if(a.xOff != b.xOff) return a.xOff < b.xOff;
+            if(a.length != b.length) return a.length < b.length;
+            return a.yStart < b.yStart;
+        });
+        this->radius = 0;
+        for(std::vector<RSGISMorphologySESegment>::iterator iterRun = rowRuns.begin(); iterRun != rowRuns.end(); ++iterRun)
+        {
+            if(!this->segments.empty() && (this->segments.back().xOff == iterRun->xOff) && (this->segments.back().length == iterRun->length) && (this->segments.back().yEnd+1 == iterRun->yStart))
+            {
+                this->segments.back().yEnd = iterRun->yEnd;
+            }
+            else
+            {
+                this->segments.push_back(*iterRun);
+            }
+            this->radius = std::max<unsigned int>(this->radius, abs(iterRun->yStart));
+        }
+    }
+    
+    void RSGISFastMorphology::performMorphology(GDALDataset *inDataset, GDALDataset *outDataset, const std::vector<RSGISMorphologyOp> &ops, RSGISMorphologyCombine combine, unsigned int stripRows)
+    {
+        long width = inDataset->GetRasterXSize();
+        long height = inDataset->GetRasterYSize();
+        int numBands = inDataset->GetRasterCount();
+        
+        if((outDataset->GetRasterXSize() != width) | (outDataset->GetRasterYSize() != height))
+        {
+            throw rsgis::img::RSGISImageCalcException("Input and output images must be the same size.");
+        }
+        if(outDataset->GetRasterCount() != numBands)
+        {
+            throw rsgis::img::RSGISImageCalcException("Input and output images must have the same number of bands.");
+        }
+        if(stripRows == 0)
+        {
+            stripRows = 256;
+        }
+        
+        // Each operation needs the radius of rows either side of the strip.
+        long halo = ((long)this->radius) * ops.size();
+        long nStrips = ((height - 1) / stripRows) + 1;
+        long totalStrips = nStrips * numBands;
+        long feedback = totalStrips/10;
+        long feedbackCounter = 0;
+        long stripCount = 0;
+        
+        std::vector<float> data;
+        std::vector<float> inCopy;
+        std::cout << "Started" << std::flush;
+        for(int b = 0; b < numBands; ++b)
+        {
+            GDALRasterBand *inBand = inDataset->GetRasterBand(b+1);
+            GDALRasterBand *outBand = outDataset->GetRasterBand(b+1);
+            for(long r0 = 0; r0 < height; r0 += stripRows)
+            {
+                if((feedback == 0) || ((stripCount % feedback) == 0))
+                {
+                    std::cout << "." << feedbackCounter << "." << std::flush;
+                    feedbackCounter = feedbackCounter + 10;
+                }
+                ++stripCount;
+                
+                long r1 = std::min<long>(height, r0 + stripRows);
+                long b0 = std::max<long>(0, r0 - halo);
+                long b1 = std::min<long>(height, r1 + halo);
+                long bufHeight = b1 - b0;
+                long coreOff = (r0 - b0) * width;
+                long coreLen = (r1 - r0) * width;
+                
+                data.resize(width * bufHeight);
+                if(inBand->RasterIO(GF_Read, 0, b0, width, bufHeight, data.data(), width, bufHeight, GDT_Float32, 0, 0) != CE_None)
+                {
+                    throw rsgis::img::RSGISImageCalcException("Could not read the input image.");
+                }
+                if(combine != rsgis_morph_output)
+                {
+                    inCopy.assign(data.begin() + coreOff, data.begin() + coreOff + coreLen);
+                }
+                
+                for(std::vector<RSGISMorphologyOp>::const_iterator iterOp = ops.begin(); iterOp != ops.end(); ++iterOp)
+                {
+                    this->applyOperator(data.data(), width, bufHeight, *iterOp);
+                }
+                
+                float *coreData = data.data() + coreOff;
+                if(combine == rsgis_morph_output_minus_input)
+                {
+                    for(long i = 0; i < coreLen; ++i)
+                    {
+                        coreData[i] = coreData[i] - inCopy[i];
+                    }
+                }
+                else if(combine == rsgis_morph_input_minus_output)
+                {
+                    for(long i = 0; i < coreLen; ++i)
+                    {
+                        coreData[i] = inCopy[i] - coreData[i];
+                    }
+                }
+                
+                if(outBand->RasterIO(GF_Write, 0, r0, width, (r1 - r0), coreData, width, (r1 - r0), GDT_Float32, 0, 0) != CE_None)
+                {
+                    throw rsgis::img::RSGISImageCalcException("Could not write the output image.");
+                }
+            }
+        }
+        std::cout << " Complete.\n";
+    }
+    
+    void RSGISFastMorphology::applyOperator(float *data, long width, long height, RSGISMorphologyOp op)
+    {
+        size_t numPxls = ((size_t)width) * height;
+        this->tmpBuf.resize(numPxls);
+        if(op == rsgis_morph_dilate)
+        {
+            this->extremumFilter(data, this->tmpBuf.data(), width, height, true);
+            std::copy(this->tmpBuf.begin(), this->tmpBuf.end(), data);
+        }
+        else if(op == rsgis_morph_erode)
+        {
+            this->extremumFilter(data, this->tmpBuf.data(), width, height, false);
+            std::copy(this->tmpBuf.begin(), this->tmpBuf.end(), data);
+        }
+        else if(op == rsgis_morph_gradient)
+        {
+            this->gradBuf.resize(numPxls);
+            this->extremumFilter(data, this->tmpBuf.data(), width, height, true);
+            this->extremumFilter(data, this->gradBuf.data(), width, height, false);
+            for(size_t i = 0; i < numPxls; ++i)
+            {
+                data[i] = this->tmpBuf[i] - this->gradBuf[i];
+            }
+        }
+        else
+        {
+            throw rsgis::img::RSGISImageCalcException("Morphological operation was not recognised.");
+        }
+    }
+    
+    void RSGISFastMorphology::extremumFilter(const float *data, float *output, long width, long height, bool findMax)
+    {
+        size_t numPxls = ((size_t)width) * height;
+        this->runBuf.resize(numPxls);
+        std::fill(output, output + numPxls, findMax?RSGISMorphMaxOp::ident():RSGISMorphMinOp::ident());
+        
+        // The segments are sorted by run so each run is calculated once for all its rectangles.
+        bool first = true;
+        int runXOff = 0;
+        int runLength = 0;
+        for(std::vector<RSGISMorphologySESegment>::iterator iterSeg = this->segments.begin(); iterSeg != this->segments.end(); ++iterSeg)
+        {
+            if(first || (iterSeg->xOff != runXOff) || (iterSeg->length != runLength))
+            {
+                this->calcRunExtremum(data, this->runBuf.data(), width, height, iterSeg->xOff, iterSeg->length, findMax);
+                runXOff = iterSeg->xOff;
+                runLength = iterSeg->length;
+                first = false;
+            }
+            this->calcRowsExtremum(this->runBuf.data(), output, width, height, iterSeg->yStart, iterSeg->yEnd, findMax);
+        }
+    }
+    
+    void RSGISFastMorphology::calcRunExtremum(const float *data, float *output, long width, long height, int xOff, int length, bool findMax)
+    {
+        this->prefixBuf.resize(width);
+        this->suffixBuf.resize(width);
+        if(findMax)
+        {
+            morphRunExtremum<RSGISMorphMaxOp>(data, output, width, height, xOff, length, this->prefixBuf.data(), this->suffixBuf.data());
+        }
+        else
+        {
+            morphRunExtremum<RSGISMorphMinOp>(data, output, width, height, xOff, length, this->prefixBuf.data(), this->suffixBuf.data());
+        }
+    }
+    
+    void RSGISFastMorphology::calcRowsExtremum(const float *data, float *output, long width, long height, int yStart, int yEnd, bool findMax)
+    {
+        size_t numPxls = ((size_t)width) * height;
+        if(yEnd > yStart)
+        {
+            this->prefixBuf.resize(numPxls);
+            this->suffixBuf.resize(numPxls);
+        }
+        if(findMax)
+        {
+            morphRowsExtremum<RSGISMorphMaxOp>(data, output, width, height, yStart, yEnd, this->prefixBuf.data(), this->suffixBuf.data());
+        }
+        else
+        {
+            morphRowsExtremum<RSGISMorphMinOp>(data, output, width, height, yStart, yEnd, this->prefixBuf.data(), this->suffixBuf.data());
+        }
+    }
+    
+    RSGISFastMorphology::~RSGISFastMorphology()
+    {
+        
+    }
+    
+}}
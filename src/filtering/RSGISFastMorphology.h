@@ -0,0 +1,117 @@
+/*
+ *  RSGISFastMorphology.h
+ *  RSGIS_LIB
+ *
+ *  Created by agent on 19/10/2026.
+ *  Copyright 2026 RSGISLib.
+ * 
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISFastMorphology_H
+#define RSGISFastMorphology_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+#include "gdal_priv.h"
+
+#include "img/RSGISImageCalcException.h"
+
+#include "math/RSGISMatrices.h"
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_filter_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace filter{
+    
+    /** The morphological operations which can be chained within a single pass. */
+    enum RSGISMorphologyOp
+    {
+        rsgis_morph_dilate = 0,
+        rsgis_morph_erode = 1,
+        rsgis_morph_gradient = 2
+    };
+    
+    /** How the result of the operations is combined with the input image. */
+    enum RSGISMorphologyCombine
+    {
+        rsgis_morph_output = 0,
+        rsgis_morph_output_minus_input = 1,
+        rsgis_morph_input_minus_output = 2
+    };
+    
+    /** 
+     * A horizontal run of the structuring element (xOff to xOff+length-1) 
+     * which is repeated on the rows yStart to yEnd (offsets from the centre).
+     */
+    struct DllExport RSGISMorphologySESegment
+    {
+        int xOff;
+        int length;
+        int yStart;
+        int yEnd;
+    };
+    
+    /**
+     * Morphological operators where the structuring element (a square matrix, 
+     * non-zero values within the element) is decomposed into horizontal runs 
+     * which are grouped into rectangles. The max/min over each run and then 
+     * each set of rows is found using the van Herk/Gil-Werman algorithm, 
+     * 3 comparisons per pixel independent of the length, so a square 
+     * element takes 6 comparisons per pixel and a disk ~3 per row of the disk.
+     *
+     * Images are processed in strips of rows with a halo large enough for all
+     * the operations so a sequence of operations (e.g., opening iterations) is 
+     * applied with a single read of the input and write of the output. Pixels 
+     * outside of the image are ignored.
+     */
+    class DllExport RSGISFastMorphology
+    {
+    public:
+        RSGISFastMorphology(rsgis::math::Matrix *matrixOperator);
+        void performMorphology(GDALDataset *inDataset, GDALDataset *outDataset, const std::vector<RSGISMorphologyOp> &ops, RSGISMorphologyCombine combine=rsgis_morph_output, unsigned int stripRows=256);
+        void applyOperator(float *data, long width, long height, RSGISMorphologyOp op);
+        unsigned int getRadius(){return this->radius;};
+        ~RSGISFastMorphology();
+    protected:
+        void extremumFilter(const float *data, float *output, long width, long height, bool findMax);
+        void calcRunExtremum(const float *data, float *output, long width, long height, int xOff, int length, bool findMax);
+        void calcRowsExtremum(const float *data, float *output, long width, long height, int yStart, int yEnd, bool findMax);
+        std::vector<RSGISMorphologySESegment> segments;
+        unsigned int radius;
+        std::vector<float> tmpBuf;
+        std::vector<float> runBuf;
+        std::vector<float> prefixBuf;
+        std::vector<float> suffixBuf;
+        std::vector<float> gradBuf;
+    };
+    
+}}
+
+#endif
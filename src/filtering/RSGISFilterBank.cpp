@@ -84,6 +84,507 @@ namespace rsgis{namespace filter{
 		}
 	}
 	
+    void RSGISFilterBank::executeFiltersSinglePass(GDALDataset **datasets, int numDS, std::string outImageBase, std::string gdalFormat, std::string imgExt, GDALDataType outDataType, bool stackOutput, unsigned int numThreads)
+    {
+        GDALAllRegister();
+        rsgis::img::RSGISImageUtils imgUtils;
+        
+        int numFilters = this->filters->size();
+        if(numFilters == 0)
+        {
+            throw rsgis::RSGISImageException("No filters have been added to the filter bank.");
+        }
+        
+        double *gdalTranslation = new double[6];
+        int **dsOffsets = new int*[numDS];
+        for(int i = 0; i < numDS; i++)
+        {
+            dsOffsets[i] = new int[2];
+        }
+        int width = 0;
+        int height = 0;
+        int xBlockSize = 0;
+        int yBlockSize = 0;
+        int numInBands = 0;
+        
+        GDALRasterBand **inputRasterBands = NULL;
+        int **bandOffsets = NULL;
+        std::vector<GDALDataset*> outDatasets;
+        std::vector<GDALRasterBand*> outBands;
+        float **inputData = NULL;
+        double **outputData = NULL;
+        std::vector<int> winSizes;
+        size_t maxFilterStatsReqs = 0;
+        std::vector< std::vector<RSGISIntegralImage*> > integralImgs;
+        std::vector< std::vector<float***> > threadWinBlocks;
+        std::vector<double*> threadOutVals;
+        std::vector<RSGISWindowStats**> threadWinStats;
+        std::vector<float*> threadCentreVals;
+        // The buffers are freed before an error is rethrown.
+        bool errorOccurred = false;
+        std::string errorMessage = "";
+        
+        try
+        {
+            // Find the largest window - this defines the halo read around each block.
+            int maxWinSize = 0;
+            std::map<int, unsigned int> winSizeIdx;
+            for(int i = 0; i < numFilters; i++)
+            {
+                int winSize = this->filters->at(i)->getWindowSize();
+                if((winSize < 1) | (winSize % 2 == 0))
+                {
+                    throw rsgis::RSGISImageException("Filter window sizes need to be odd numbers.");
+                }
+                if(winSize > maxWinSize)
+                {
+                    maxWinSize = winSize;
+                }
+                if(winSizeIdx.count(winSize) == 0)
+                {
+                    winSizeIdx[winSize] = winSizes.size();
+                    winSizes.push_back(winSize);
+                }
+            }
+            int halo = maxWinSize/2;
+            
+            // Filters which can be calculated from the window statistics use integral images
+            // of the block (O(1) per pixel) rather than the window of pixel values.
+            std::vector<RSGISWindowStatsReq> statsReqs;
+            std::vector<bool> filterUseStats(numFilters, false);
+            std::vector< std::vector<unsigned int> > filterStatsReqIdxs(numFilters);
+            std::vector<bool> winSizeUsed(winSizes.size(), false);
+            for(int i = 0; i < numFilters; i++)
+            {
+                std::vector<RSGISWindowStatsReq> filterReqs;
+                if(this->filters->at(i)->getWindowStatsRequirements(&filterReqs))
+                {
+                    filterUseStats.at(i) = true;
+                    for(std::vector<RSGISWindowStatsReq>::iterator iterReq = filterReqs.begin(); iterReq != filterReqs.end(); ++iterReq)
+                    {
+                        unsigned int reqIdx = statsReqs.size();
+                        for(size_t r = 0; r < statsReqs.size(); r++)
+                        {
+                            if((statsReqs.at(r).transform == (*iterReq).transform) && (statsReqs.at(r).ignoreNoData == (*iterReq).ignoreNoData))
+                            {
+                                reqIdx = r;
+                                break;
+                            }
+                        }
+                        if(reqIdx == statsReqs.size())
+                        {
+                            statsReqs.push_back(*iterReq);
+                        }
+                        filterStatsReqIdxs.at(i).push_back(reqIdx);
+                    }
+                    if(filterReqs.size() > maxFilterStatsReqs)
+                    {
+                        maxFilterStatsReqs = filterReqs.size();
+                    }
+                }
+                else
+                {
+                    winSizeUsed.at(winSizeIdx[this->filters->at(i)->getWindowSize()]) = true;
+                }
+            }
+            
+            imgUtils.getImageOverlap(datasets, numDS, dsOffsets, &width, &height, gdalTranslation, &xBlockSize, &yBlockSize);
+            
+            for(int i = 0; i < numDS; i++)
+            {
+                numInBands += datasets[i]->GetRasterCount();
+            }
+            
+            inputRasterBands = new GDALRasterBand*[numInBands];
+            bandOffsets = new int*[numInBands];
+            int counter = 0;
+            for(int i = 0; i < numDS; i++)
+            {
+                for(int j = 0; j < datasets[i]->GetRasterCount(); j++)
+                {
+                    inputRasterBands[counter] = datasets[i]->GetRasterBand(j+1);
+                    bandOffsets[counter] = new int[2];
+                    bandOffsets[counter][0] = dsOffsets[i][0];
+                    bandOffsets[counter][1] = dsOffsets[i][1];
+                    ++counter;
+                }
+            }
+            
+            // Create the output image(s).
+            GDALDriver *gdalDriver = GetGDALDriverManager()->GetDriverByName(gdalFormat.c_str());
+            if(gdalDriver == NULL)
+            {
+                throw rsgis::RSGISImageException("Driver does not exists..");
+            }
+            
+            int numOutImgs = stackOutput?1:numFilters;
+            int numBandsPerOutImg = stackOutput?(numFilters*numInBands):numInBands;
+            std::string filename = "";
+            for(int i = 0; i < numOutImgs; i++)
+            {
+                if(stackOutput)
+                {
+                    filename = outImageBase + "." + imgExt;
+                }
+                else
+                {
+                    filename = outImageBase + this->filters->at(i)->getFileNameEnding() + "." + imgExt;
+                }
+                GDALDataset *outDS = gdalDriver->Create(filename.c_str(), width, height, numBandsPerOutImg, outDataType, NULL);
+                if(outDS == NULL)
+                {
+                    throw rsgis::RSGISImageException("Output image could not be created. Check filepath.");
+                }
+                outDS->SetGeoTransform(gdalTranslation);
+                outDS->SetProjection(datasets[0]->GetProjectionRef());
+                outDatasets.push_back(outDS);
+            }
+            
+            // Output band for filter f and input band n is at index (f * numInBands) + n
+            for(int f = 0; f < numFilters; f++)
+            {
+                this->filters->at(f)->setNumOutBands(numInBands);
+                for(int n = 0; n < numInBands; n++)
+                {
+                    GDALRasterBand *outBand = NULL;
+                    if(stackOutput)
+                    {
+                        outBand = outDatasets.at(0)->GetRasterBand((f*numInBands)+n+1);
+                        std::string bandName = this->filters->at(f)->getFileNameEnding();
+                        if(numInBands > 1)
+                        {
+                            bandName = bandName + "_b" + std::to_string(n+1);
+                        }
+                        outBand->SetDescription(bandName.c_str());
+                    }
+                    else
+                    {
+                        outBand = outDatasets.at(f)->GetRasterBand(n+1);
+                    }
+                    outBands.push_back(outBand);
+                }
+            }
+            
+            // Strips are a multiple of the block size and at least four times the halo
+            // (and 64 rows) so striped inputs are not processed a row at a time with
+            // the halo re-read for every row, and each strip has rows to split between
+            // the threads.
+            if(yBlockSize < 1)
+            {
+                yBlockSize = 1;
+            }
+            int minNumOfLines = 4 * halo;
+            if(minNumOfLines < 64)
+            {
+                minNumOfLines = 64;
+            }
+            int numOfLines = yBlockSize * ((int)ceil(((double)minNumOfLines)/yBlockSize));
+            if(numOfLines > height)
+            {
+                numOfLines = height;
+            }
+            
+            // Allocate the block buffers. The input buffers include the halo on all sides
+            // with the areas outside of the image set to zero (as calcImageWindowData).
+            int bufWidth = width + (2 * halo);
+            int bufHeight = numOfLines + (2 * halo);
+            size_t numBufPxls = ((size_t)bufWidth) * ((size_t)bufHeight);
+            inputData = new float*[numInBands];
+            for(int n = 0; n < numInBands; n++)
+            {
+                inputData[n] = (float *) CPLMalloc(sizeof(float)*numBufPxls);
+            }
+            
+            size_t numOutPxls = ((size_t)width) * ((size_t)numOfLines);
+            int numOutBands = numFilters * numInBands;
+            outputData = new double*[numOutBands];
+            for(int i = 0; i < numOutBands; i++)
+            {
+                outputData[i] = (double *) CPLMalloc(sizeof(double)*numOutPxls);
+            }
+            
+            numThreads = rsgis::getNumProcessingThreads(numThreads);
+            
+            // Integral images for each of the window statistics required, for each band.
+            integralImgs.resize(statsReqs.size());
+            for(size_t r = 0; r < statsReqs.size(); r++)
+            {
+                for(int n = 0; n < numInBands; n++)
+                {
+                    integralImgs.at(r).push_back(new RSGISIntegralImage());
+                }
+            }
+            
+            // Per-thread window buffers (one for each distinct window size) and output values.
+            threadWinBlocks.resize(numThreads);
+            threadOutVals.resize(numThreads, NULL);
+            threadWinStats.resize(numThreads, NULL);
+            threadCentreVals.resize(numThreads, NULL);
+            for(unsigned int t = 0; t < numThreads; t++)
+            {
+                for(size_t w = 0; w < winSizes.size(); w++)
+                {
+                    float ***winBlock = new float**[numInBands];
+                    for(int n = 0; n < numInBands; n++)
+                    {
+                        winBlock[n] = new float*[winSizes.at(w)];
+                        for(int y = 0; y < winSizes.at(w); y++)
+                        {
+                            winBlock[n][y] = new float[winSizes.at(w)];
+                        }
+                    }
+                    threadWinBlocks.at(t).push_back(winBlock);
+                }
+                threadOutVals.at(t) = new double[numInBands];
+                threadWinStats.at(t) = new RSGISWindowStats*[maxFilterStatsReqs];
+                for(size_t r = 0; r < maxFilterStatsReqs; r++)
+                {
+                    threadWinStats.at(t)[r] = new RSGISWindowStats[numInBands];
+                }
+                threadCentreVals.at(t) = new float[numInBands];
+            }
+            
+            int nYBlocks = ceil(((double)height) / ((double)numOfLines));
+            int feedback = nYBlocks/10;
+            int feedbackCounter = 0;
+            std::cout << "Started (" << numFilters << " filters, " << numThreads << " threads) " << std::flush;
+            
+            for(int i = 0; i < nYBlocks; i++)
+            {
+                if((feedback == 0) || ((i % feedback) == 0))
+                {
+                    std::cout << "." << feedbackCounter << "." << std::flush;
+                    feedbackCounter = feedbackCounter + 10;
+                }
+                
+                int blockRowStart = i * numOfLines;
+                int blockNumRows = numOfLines;
+                if((blockRowStart + blockNumRows) > height)
+                {
+                    blockNumRows = height - blockRowStart;
+                }
+                
+                // Rows of the image (including the halo) which lie within the image.
+                int readRowStart = blockRowStart - halo;
+                int readRowEnd = blockRowStart + blockNumRows + halo;
+                int bufRowOff = 0;
+                if(readRowStart < 0)
+                {
+                    bufRowOff = -readRowStart;
+                    readRowStart = 0;
+                }
+                if(readRowEnd > height)
+                {
+                    readRowEnd = height;
+                }
+                int numReadRows = readRowEnd - readRowStart;
+                
+                for(int n = 0; n < numInBands; n++)
+                {
+                    for(size_t k = 0; k < numBufPxls; k++)
+                    {
+                        inputData[n][k] = 0;
+                    }
+                    float *bufStart = inputData[n] + (((size_t)bufRowOff) * bufWidth) + halo;
+                    if(inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], bandOffsets[n][1]+readRowStart, width, numReadRows, bufStart, width, numReadRows, GDT_Float32, 0, sizeof(float)*bufWidth) != CE_None)
+                    {
+                        throw rsgis::RSGISImageException("Could not read the input image block.");
+                    }
+                }
+                
+                if(!statsReqs.empty())
+                {
+                    // Only the rows of the buffer used by this block are summed.
+                    int numIntImgRows = blockNumRows + (2 * halo);
+                    size_t numIntImgs = statsReqs.size() * numInBands;
+                    rsgis::parallelForRange(0, numIntImgs, numThreads, 1, [&](size_t idxStart, size_t idxEnd, unsigned int threadIdx)
+                    {
+                        for(size_t idx = idxStart; idx < idxEnd; ++idx)
+                        {
+                            size_t r = idx / numInBands;
+                            size_t n = idx % numInBands;
+                            integralImgs.at(r).at(n)->populate(inputData[n], bufWidth, numIntImgRows, statsReqs.at(r).transform, statsReqs.at(r).ignoreNoData);
+                        }
+                    });
+                }
+                
+                rsgis::parallelForRange(0, blockNumRows, numThreads, 1, [&](size_t rowStart, size_t rowEnd, unsigned int threadIdx)
+                {
+                    std::vector<float***> &winBlocks = threadWinBlocks.at(threadIdx);
+                    double *outVals = threadOutVals.at(threadIdx);
+                    RSGISWindowStats **winStats = threadWinStats.at(threadIdx);
+                    float *centreVals = threadCentreVals.at(threadIdx);
+                    for(size_t m = rowStart; m < rowEnd; ++m)
+                    {
+                        // Row m of the block is at row (m + halo) of the buffer.
+                        for(int j = 0; j < width; j++)
+                        {
+                            // Populate the window for each of the window sizes used.
+                            for(size_t w = 0; w < winSizes.size(); w++)
+                            {
+                                if(!winSizeUsed.at(w))
+                                {
+                                    continue;
+                                }
+                                int winSize = winSizes.at(w);
+                                int winHalf = winSize/2;
+                                size_t bufRow = m + halo - winHalf;
+                                size_t bufCol = j + halo - winHalf;
+                                for(int n = 0; n < numInBands; n++)
+                                {
+                                    for(int y = 0; y < winSize; y++)
+                                    {
+                                        float *bufLine = inputData[n] + ((bufRow + y) * bufWidth) + bufCol;
+                                        for(int x = 0; x < winSize; x++)
+                                        {
+                                            winBlocks.at(w)[n][y][x] = bufLine[x];
+                                        }
+                                    }
+                                }
+                            }
+                            
+                            size_t outPxl = (m * width) + j;
+                            size_t centrePxl = ((m + halo) * bufWidth) + j + halo;
+                            for(int n = 0; n < numInBands; n++)
+                            {
+                                centreVals[n] = inputData[n][centrePxl];
+                            }
+                            
+                            for(int f = 0; f < numFilters; f++)
+                            {
+                                RSGISImageFilter *filter = this->filters->at(f);
+                                int winSize = filter->getWindowSize();
+                                if(filterUseStats.at(f))
+                                {
+                                    int winHalf = winSize/2;
+                                    for(size_t r = 0; r < filterStatsReqIdxs.at(f).size(); r++)
+                                    {
+                                        std::vector<RSGISIntegralImage*> &reqIntImgs = integralImgs.at(filterStatsReqIdxs.at(f).at(r));
+                                        for(int n = 0; n < numInBands; n++)
+                                        {
+                                            reqIntImgs.at(n)->getWindowStats(j + halo - winHalf, m + halo - winHalf, winSize, winSize, &winStats[r][n]);
+                                        }
+                                    }
+                                    filter->calcImageValueFromWindowStats(winStats, centreVals, numInBands, outVals);
+                                }
+                                else
+                                {
+                                    filter->calcImageValue(winBlocks.at(winSizeIdx.at(winSize)), numInBands, winSize, outVals);
+                                }
+                                for(int n = 0; n < numInBands; n++)
+                                {
+                                    outputData[(f*numInBands)+n][outPxl] = outVals[n];
+                                }
+                            }
+                        }
+                    }
+                });
+                
+                for(int b = 0; b < numOutBands; b++)
+                {
+                    if(outBands.at(b)->RasterIO(GF_Write, 0, blockRowStart, width, blockNumRows, outputData[b], width, blockNumRows, GDT_Float64, 0, 0) != CE_None)
+                    {
+                        throw rsgis::RSGISImageException("Could not write the output image block.");
+                    }
+                }
+            }
+            std::cout << " Complete.\n";
+        }
+        catch(rsgis::RSGISException &e)
+        {
+            errorOccurred = true;
+            errorMessage = e.what();
+        }
+        
+        for(size_t t = 0; t < threadWinBlocks.size(); t++)
+        {
+            for(size_t w = 0; w < threadWinBlocks.at(t).size(); w++)
+            {
+                float ***winBlock = threadWinBlocks.at(t).at(w);
+                for(int n = 0; n < numInBands; n++)
+                {
+                    for(int y = 0; y < winSizes.at(w); y++)
+                    {
+                        delete[] winBlock[n][y];
+                    }
+                    delete[] winBlock[n];
+                }
+                delete[] winBlock;
+            }
+        }
+        for(size_t t = 0; t < threadOutVals.size(); t++)
+        {
+            delete[] threadOutVals.at(t);
+        }
+        for(size_t t = 0; t < threadWinStats.size(); t++)
+        {
+            if(threadWinStats.at(t) != NULL)
+            {
+                for(size_t r = 0; r < maxFilterStatsReqs; r++)
+                {
+                    delete[] threadWinStats.at(t)[r];
+                }
+                delete[] threadWinStats.at(t);
+            }
+        }
+        for(size_t t = 0; t < threadCentreVals.size(); t++)
+        {
+            delete[] threadCentreVals.at(t);
+        }
+        for(size_t r = 0; r < integralImgs.size(); r++)
+        {
+            for(size_t n = 0; n < integralImgs.at(r).size(); n++)
+            {
+                delete integralImgs.at(r).at(n);
+            }
+        }
+        
+        for(std::vector<GDALDataset*>::iterator iterDS = outDatasets.begin(); iterDS != outDatasets.end(); ++iterDS)
+        {
+            GDALClose(*iterDS);
+        }
+        
+        if(inputData != NULL)
+        {
+            for(int n = 0; n < numInBands; n++)
+            {
+                CPLFree(inputData[n]);
+            }
+            delete[] inputData;
+        }
+        if(outputData != NULL)
+        {
+            for(int i = 0; i < (numFilters * numInBands); i++)
+            {
+                CPLFree(outputData[i]);
+            }
+            delete[] outputData;
+        }
+        if(bandOffsets != NULL)
+        {
+            for(int n = 0; n < numInBands; n++)
+            {
+                delete[] bandOffsets[n];
+            }
+            delete[] bandOffsets;
+        }
+        if(inputRasterBands != NULL)
+        {
+            delete[] inputRasterBands;
+        }
+        for(int i = 0; i < numDS; i++)
+        {
+            delete[] dsOffsets[i];
+        }
+        delete[] dsOffsets;
+        delete[] gdalTranslation;
+        
+        if(errorOccurred)
+        {
+            throw rsgis::RSGISImageException(errorMessage.c_str());
+        }
+    }
+	
 	void RSGISFilterBank::exportFilterBankImages(std::string imagebase)
 	{
 		int size = this->filters->size();
@@ -26,6 +26,8 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <map>
+#include <cmath>
 
 #include "gdal_priv.h"
 
@@ -36,6 +38,9 @@
 #include "filtering/RSGISImageKernelFilter.h"
 
 #include "common/RSGISImageException.h"
+#include "common/RSGISThreadUtils.h"
+
+#include "img/RSGISImageUtils.h"
 
 // mark all exported classes/functions with DllExport to have
 // them exported by Visual Studio
@@ -61,6 +66,16 @@ namespace rsgis{namespace filter{
 			int getNumFilters();
 			void executeFilters(GDALDataset **datasets, int numDS, std::string outImageBase, std::string gdalFormat, std::string imgExt, GDALDataType outDataType);
 			void exectuteFilter(int i, GDALDataset **datasets, int numDS, std::string outImageBase, std::string gdalFormat, GDALDataType outDataType);
+            /**
+             * Applies all the filters in the bank while reading the input image(s) only once. 
+             * The image is processed in blocks of rows, each read with a halo of rows and 
+             * columns sized for the largest filter window, and every filter is applied to
+             * the block in memory. If stackOutput is true a single image (outImageBase.imgExt)
+             * is created with numFilters x numInBands bands (ordered filter by filter), otherwise
+             * one image per filter is created using the same file names as executeFilters. 
+             * The rows within a block are split across numThreads threads (0 = all cores).
+             */
+            void executeFiltersSinglePass(GDALDataset **datasets, int numDS, std::string outImageBase, std::string gdalFormat, std::string imgExt, GDALDataType outDataType, bool stackOutput=false, unsigned int numThreads=1);
 			void exportFilterBankImages(std::string imagebase);
 			~RSGISFilterBank();
 		protected:
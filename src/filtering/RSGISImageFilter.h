@@ -25,10 +25,12 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "common/RSGISImageException.h"
 
 #include "filtering/RSGISImageFilterException.h"
+#include "filtering/RSGISIntegralImage.h"
 #include "img/RSGISImageCalcException.h"
 #include "img/RSGISCalcImage.h"
 #include "img/RSGISCalcImageValue.h"
@@ -73,6 +75,11 @@ namespace rsgis{namespace filter{
 			virtual bool calcImageValueCondition(float ***dataBlock, int numBands, int winSize, double *output)  = 0;
 			virtual void exportAsImage(std::string filename) = 0;
 			virtual std::string getFileNameEnding();
+            virtual int getWindowSize(){return this->size;};
+            /** Returns true if the filter can be calculated from the count, mean and variance of the window (see RSGISIntegralImage), appending the statistics required. */
+            virtual bool getWindowStatsRequirements(std::vector<RSGISWindowStatsReq> *reqs){return false;};
+            /** stats[r][n] are the window statistics for requirement r and band n, centreVals the values of the window centre pixel. */
+            virtual void calcImageValueFromWindowStats(RSGISWindowStats **stats, float *centreVals, int numBands, double *output){throw rsgis::img::RSGISImageCalcException("Not implemented");};
 			~RSGISImageFilter();
 		protected:
 			int size;
@@ -0,0 +1,173 @@
+/*
+ *  RSGISIntegralImage.cpp
+ *  RSGIS_LIB
+ *
+ *  Created by agent on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ * 
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISIntegralImage.h"
+
+namespace rsgis{namespace filter{
+    
+    RSGISIntegralImage::RSGISIntegralImage()
+    {
+        this->transform = rsgis_winval_x;
+        this->ignoreNoData = false;
+        this->tableWidth = 0;
+        this->tableHeight = 0;
+        this->shift = 0;
+    }
+    
+    void RSGISIntegralImage::populate(float *data, unsigned int width, unsigned int height, RSGISWindowValTransform transform, bool ignoreNoData)
+    {
+        this->transform = transform;
+        this->ignoreNoData = ignoreNoData;
+        this->tableWidth = width + 1;
+        this->tableHeight = height + 1;
+        size_t numTablePxls = ((size_t)this->tableWidth) * ((size_t)this->tableHeight);
+        
+        // Tables have an extra row and column of zeros at the top and left.
+        this->sumTable.assign(numTablePxls, 0.0);
+        this->sumSqTable.assign(numTablePxls, 0.0);
+        this->countTable.assign(numTablePxls, 0);
+        this->nanTable.assign(numTablePxls, 0);
+        
+        bool shiftFound = false;
+        this->shift = 0;
+        
+        double val = 0;
+        bool isValid = false;
+        bool isNaN = false;
+        double rowSum = 0;
+        double rowSumSq = 0;
+        unsigned int rowCount = 0;
+        unsigned int rowNaN = 0;
+        size_t pxlIdx = 0;
+        for(unsigned int y = 0; y < height; ++y)
+        {
+            rowSum = 0;
+            rowSumSq = 0;
+            rowCount = 0;
+            rowNaN = 0;
+            for(unsigned int x = 0; x < width; ++x)
+            {
+                pxlIdx = (((size_t)y) * width) + x;
+                val = data[pxlIdx];
+                isValid = true;
+                isNaN = false;
+                
+                if((boost::math::isnan)(val))
+                {
+                    if(ignoreNoData)
+                    {
+                        isValid = false;
+                    }
+                    else
+                    {
+                        isNaN = true;
+                    }
+                }
+                else if(ignoreNoData && (val == 0))
+                {
+                    isValid = false;
+                }
+                
+                if(isValid && !isNaN)
+                {
+                    if(transform == rsgis_winval_sqrt)
+                    {
+                        val = sqrt(val);
+                    }
+                    else if(transform == rsgis_winval_ln)
+                    {
+                        val = log(val);
+                    }
+                    
+                    if(!(boost::math::isfinite)(val))
+                    {
+                        isNaN = true;
+                    }
+                }
+                
+                if(isNaN)
+                {
+                    ++rowNaN;
+                }
+                else if(isValid)
+                {
+                    if(!shiftFound)
+                    {
+                        this->shift = val;
+                        shiftFound = true;
+                    }
+                    val = val - this->shift;
+                    rowSum += val;
+                    rowSumSq += (val * val);
+                    ++rowCount;
+                }
+                
+                this->sumTable[this->idx(x+1, y+1)] = this->sumTable[this->idx(x+1, y)] + rowSum;
+                this->sumSqTable[this->idx(x+1, y+1)] = this->sumSqTable[this->idx(x+1, y)] + rowSumSq;
+                this->countTable[this->idx(x+1, y+1)] = this->countTable[this->idx(x+1, y)] + rowCount;
+                this->nanTable[this->idx(x+1, y+1)] = this->nanTable[this->idx(x+1, y)] + rowNaN;
+            }
+        }
+    }
+    
+    void RSGISIntegralImage::getWindowStats(unsigned int x, unsigned int y, unsigned int winXSize, unsigned int winYSize, RSGISWindowStats *stats)
+    {
+        if(((x + winXSize) >= this->tableWidth) | ((y + winYSize) >= this->tableHeight))
+        {
+            throw RSGISImageFilterException("Window is not within the integral image.");
+        }
+        
+        size_t tl = this->idx(x, y);
+        size_t tr = this->idx(x+winXSize, y);
+        size_t bl = this->idx(x, y+winYSize);
+        size_t br = this->idx(x+winXSize, y+winYSize);
+        
+        unsigned int numNaN = this->nanTable[br] - this->nanTable[tr] - this->nanTable[bl] + this->nanTable[tl];
+        unsigned int count = this->countTable[br] - this->countTable[tr] - this->countTable[bl] + this->countTable[tl];
+        stats->n = count;
+        
+        if((numNaN > 0) | (count == 0))
+        {
+            stats->mean = std::numeric_limits<double>::quiet_NaN();
+            stats->var = std::numeric_limits<double>::quiet_NaN();
+        }
+        else
+        {
+            double sum = this->sumTable[br] - this->sumTable[tr] - this->sumTable[bl] + this->sumTable[tl];
+            double sumSq = this->sumSqTable[br] - this->sumSqTable[tr] - this->sumSqTable[bl] + this->sumSqTable[tl];
+            double shiftedMean = sum / count;
+            stats->mean = shiftedMean + this->shift;
+            stats->var = (sumSq / count) - (shiftedMean * shiftedMean);
+            if(stats->var < 0)
+            {
+                // Can only be negative due to rounding.
+                stats->var = 0;
+            }
+        }
+    }
+    
+    RSGISIntegralImage::~RSGISIntegralImage()
+    {
+        
+    }
+    
+}}
@@ -0,0 +1,110 @@
+/*
+ *  RSGISIntegralImage.h
+ *  RSGIS_LIB
+ *
+ *  Created by agent on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ * 
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISIntegralImage_H
+#define RSGISIntegralImage_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <limits>
+
+#include "filtering/RSGISImageFilterException.h"
+
+#include <boost/math/special_functions/fpclassify.hpp>
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_filter_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace filter{
+    
+    /** The transform applied to the pixel values before they are summed. */
+    enum RSGISWindowValTransform
+    {
+        rsgis_winval_x = 0,
+        rsgis_winval_sqrt = 1,
+        rsgis_winval_ln = 2
+    };
+    
+    /** The count, mean and variance of the (transformed) values within a window. */
+    struct DllExport RSGISWindowStats
+    {
+        double n;
+        double mean;
+        double var;
+    };
+    
+    /** The transform and no data handling of a set of window statistics required by a filter. */
+    struct DllExport RSGISWindowStatsReq
+    {
+        RSGISWindowValTransform transform;
+        bool ignoreNoData;
+    };
+    
+    /**
+     * Summed-area tables of the count, sum and sum of squares of the (transformed) 
+     * values of a block of image data, providing the count, mean and variance
+     * within any rectangular window of the block in O(1).
+     *
+     * If ignoreNoData is true, pixels with a value of 0 or NaN are not counted 
+     * (as the SAR texture filters). Otherwise all pixels are counted and any window
+     * containing a NaN has a NaN mean and variance (as the per-pixel filters). The
+     * values are summed relative to a shift (the first valid value) to limit the loss
+     * of precision when the variance is calculated from the sums.
+     */
+    class DllExport RSGISIntegralImage
+    {
+    public:
+        RSGISIntegralImage();
+        void populate(float *data, unsigned int width, unsigned int height, RSGISWindowValTransform transform, bool ignoreNoData);
+        /** Window is defined by its top left pixel (x, y) and size - it must lie within the block. */
+        void getWindowStats(unsigned int x, unsigned int y, unsigned int winXSize, unsigned int winYSize, RSGISWindowStats *stats);
+        RSGISWindowValTransform getTransform(){return this->transform;};
+        bool getIgnoreNoData(){return this->ignoreNoData;};
+        ~RSGISIntegralImage();
+    protected:
+        inline size_t idx(unsigned int x, unsigned int y){return (((size_t)y) * this->tableWidth) + x;};
+        RSGISWindowValTransform transform;
+        bool ignoreNoData;
+        unsigned int tableWidth;
+        unsigned int tableHeight;
+        double shift;
+        std::vector<double> sumTable;
+        std::vector<double> sumSqTable;
+        std::vector<unsigned int> countTable;
+        std::vector<unsigned int> nanTable;
+    };
+    
+}}
+
+#endif
@@ -30,6 +30,9 @@
 #include "img/RSGISImageBandException.h"
 #include "img/RSGISCalcImage.h"
 #include "img/RSGISCalcImageValue.h"
+#include "img/RSGISImageUtils.h"
+
+#include "filtering/RSGISFastMorphology.h"
 
 #include "math/RSGISMatrices.h"
 
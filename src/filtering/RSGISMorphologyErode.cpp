@@ -31,17 +31,18 @@ namespace rsgis{namespace filter{
 
 	void RSGISImageMorphologyErode::erodeImage(GDALDataset **datasets, std::string outputImage, rsgis::math::Matrix *matrixOperator, std::string format, GDALDataType outDataType)
 	{
-        if(matrixOperator->n != matrixOperator->m)
+        try
         {
-            throw rsgis::img::RSGISImageCalcException("Morphological operator must be a square matrix.");
-        }
-        
-		int numBands = datasets[0]->GetRasterCount();
-		RSGISMorphologyErode *erodeImage = new RSGISMorphologyErode(numBands, matrixOperator);
-		rsgis::img::RSGISCalcImage calcImg = rsgis::img::RSGISCalcImage(erodeImage, "", true);
-        try 
-        {
-            calcImg.calcImageWindowData(datasets, 1, outputImage, matrixOperator->n, format, outDataType);
+            RSGISFastMorphology fastMorph(matrixOperator);
+            
+            rsgis::img::RSGISImageUtils imgUtils;
+            GDALDataset *outDataset = imgUtils.createCopy(datasets[0], outputImage, format, outDataType);
+            
+            std::vector<RSGISMorphologyOp> ops;
+            ops.push_back(rsgis_morph_erode);
+            fastMorph.performMorphology(datasets[0], outDataset, ops);
+            
+            GDALClose(outDataset);
         }
         catch(rsgis::img::RSGISImageCalcException &e)
         {
@@ -51,7 +52,10 @@ namespace rsgis{namespace filter{
         {
             throw e;
         }
-        delete erodeImage;
+        catch(RSGISImageException &e)
+        {
+            throw rsgis::img::RSGISImageCalcException(e.what());
+        }
 	}
     
     void RSGISImageMorphologyErode::erodeImageAll(GDALDataset **datasets, std::string outputImage, rsgis::math::Matrix *matrixOperator, std::string format, GDALDataType outDataType)
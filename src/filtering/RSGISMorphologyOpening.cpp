@@ -34,55 +34,22 @@ namespace rsgis{namespace filter{
     {
         try 
         {
-            if(matrixOperator->n != matrixOperator->m)
-            {
-                throw rsgis::img::RSGISImageCalcException("Morphological operator must be a square matrix.");
-            }
+            RSGISFastMorphology fastMorph(matrixOperator);
             
             rsgis::img::RSGISImageUtils imgUtils;
-            GDALDataset *outDataset = NULL;
-            GDALDataset *tmpDataset = NULL;
-            GDALDataset **tmpGDALDataArray = new GDALDataset*[1];
-            
-            outDataset = imgUtils.createCopy(dataset, outputImage, format, outDataType);
-            imgUtils.zerosFloatGDALDataset(outDataset);
-            
-            if(useMemory)
-            {
-                tmpDataset = imgUtils.createCopy(dataset, tempImage, "MEM", outDataType);
-            }
-            else
-            {
-                tmpDataset = imgUtils.createCopy(dataset, tempImage, format, outDataType);
-            }
-            imgUtils.zerosFloatGDALDataset(tmpDataset);
-            
+            GDALDataset *outDataset = imgUtils.createCopy(dataset, outputImage, format, outDataType);
             
-            rsgis::img::RSGISCalcImageValue *imgErode = new RSGISMorphologyErode(dataset->GetRasterCount(), matrixOperator);
-            rsgis::img::RSGISCalcImage calcImageErode(imgErode);
-            rsgis::img::RSGISCalcImageValue *imgDilate = new RSGISMorphologyDilate(dataset->GetRasterCount(), matrixOperator);
-            rsgis::img::RSGISCalcImage calcImageDilate(imgDilate);
-            
-            tmpGDALDataArray[0] = dataset;
+            // All the operations are applied within a single pass (strips with a halo)
+            // so the temporary image is no longer required.
+            std::vector<RSGISMorphologyOp> ops;
             for(unsigned int i = 0; i < numIterations; ++i)
             {
-                if(i > 0)
-                {
-                    tmpGDALDataArray[0] = outDataset;
-                }
-                
-                calcImageErode.calcImageWindowData(tmpGDALDataArray, 1, tmpDataset, matrixOperator->n);
-                tmpGDALDataArray[0] = tmpDataset;
-                calcImageDilate.calcImageWindowData(tmpGDALDataArray, 1, outDataset, matrixOperator->n);
+                ops.push_back(rsgis_morph_erode);
+                ops.push_back(rsgis_morph_dilate);
             }
-            
-            delete imgErode;
-            delete imgDilate;
-            
-            delete[] tmpGDALDataArray;
+            fastMorph.performMorphology(dataset, outDataset, ops);
             
             GDALClose(outDataset);
-            GDALClose(tmpDataset);
         } 
         catch (rsgis::img::RSGISImageCalcException &e) 
         {
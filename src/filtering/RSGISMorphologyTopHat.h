@@ -34,6 +34,7 @@
 
 #include "filtering/RSGISMorphologyErode.h"
 #include "filtering/RSGISMorphologyDilate.h"
+#include "filtering/RSGISFastMorphology.h"
 
 #include "math/RSGISMatrices.h"
 
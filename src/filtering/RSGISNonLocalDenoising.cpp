@@ -22,17 +22,19 @@
 
 #include "RSGISNonLocalDenoising.h"
 
+
 namespace rsgis{namespace filter{
     
     RSGISApplyNonLocalDenoising::RSGISApplyNonLocalDenoising()
     {
+        this->patchHalf = 0;
+        this->searchHalf = 0;
+        this->invHParSq = 0;
     }
     
-    void RSGISApplyNonLocalDenoising::ApplyFilter(GDALDataset **inputImageDS, int numDS, std::string outputImage, unsigned int filterWindowSize, unsigned int searchWindowSize, double aPar, double hPar, std::string gdalFormat, GDALDataType gdalDataType)
+    void RSGISApplyNonLocalDenoising::ApplyFilter(GDALDataset **inputImageDS, int numDS, std::string outputImage, unsigned int filterWindowSize, unsigned int searchWindowSize, double aPar, double hPar, std::string gdalFormat, GDALDataType gdalDataType, unsigned int numThreads)
 	{
-        
         rsgis::img::RSGISImageUtils imgUtils;
-        rsgis::math::RSGISVectors vectorUtils;
         
 		double *gdalTranslation = new double[6];
 		int **dsOffsets = new int*[numDS];
@@ -44,22 +46,11 @@ namespace rsgis{namespace filter{
 		int height = 0;
 		int width = 0;
 		unsigned int numInBands = 0;
-        unsigned int numOutBands;
         int xBlockSize = 0;
         int yBlockSize = 0;
-        size_t numPxlsInSearchWindow = 0;
 		
-		float **inputDataSearchWindow = NULL;
+		float **inputData = NULL;
 		float **outputData = NULL;
-
-        unsigned int searchWindowWidth = searchWindowSize;
-        unsigned int searchWindowHeight = searchWindowSize;
-        unsigned int searchWindowOverlap = 0;
-        
-        double invHParSq = -1.0/hPar*hPar;
-        
-        double *swPixelValues = NULL; // Pixel values for search window.
-        double *swPixelWeights = NULL; // Pixel weights for search window.
 		
 		GDALRasterBand **inputRasterBands = NULL;
 		GDALRasterBand **outputRasterBands = NULL;
@@ -69,7 +60,7 @@ namespace rsgis{namespace filter{
 		
 		try
 		{
-			if(filterWindowSize % 2 == 0)
+			if((filterWindowSize < 3) | (filterWindowSize % 2 == 0))
 			{
 				throw rsgis::img::RSGISImageCalcException("Window size needs to be an odd number (min = 3).");
 			}
@@ -77,8 +68,14 @@ namespace rsgis{namespace filter{
 			{
 				throw rsgis::img::RSGISImageCalcException("Search window size needs to at least twice the filter window size");
 			}
-			unsigned int filterWinPix = floor((float)filterWindowSize / 2); // Number of pixels each side of middle pixel
-			unsigned int windowMid = floor(((float)filterWindowSize)/2.0); // Pixel at centre of block
+            if(hPar <= 0)
+            {
+                throw rsgis::img::RSGISImageCalcException("The h parameter must be greater than zero.");
+            }
+            this->patchHalf = filterWindowSize / 2;
+            this->searchHalf = searchWindowSize / 2;
+            this->invHParSq = 1.0/(hPar*hPar);
+            unsigned int halo = this->patchHalf + this->searchHalf;
             
             std::cout << "Search window Size: " << searchWindowSize << std::endl;
             std::cout << "Filter window Size: " << filterWindowSize << std::endl;
@@ -92,23 +89,19 @@ namespace rsgis{namespace filter{
 				numInBands += inputImageDS[i]->GetRasterCount();
 			}
             
-            numOutBands = numInBands;
-            
 			// Create new Image
 			gdalDriver = GetGDALDriverManager()->GetDriverByName(gdalFormat.c_str());
 			if(gdalDriver == NULL)
 			{
 				throw rsgis::img::RSGISImageBandException("Driver does not exists..");
 			}
-			std::cout << "New image width = " << width << " height = " << height << " bands = " << numOutBands << std::endl;
+			std::cout << "New image width = " << width << " height = " << height << " bands = " << numInBands << std::endl;
             
-			outputImageDS = gdalDriver->Create(outputImage.c_str(), width, height, numOutBands, gdalDataType, NULL);
-			
+			outputImageDS = gdalDriver->Create(outputImage.c_str(), width, height, numInBands, gdalDataType, NULL);
 			if(outputImageDS == NULL)
 			{
 				throw rsgis::img::RSGISImageBandException("Output image could not be created. Check filepath.");
 			}
-			
             outputImageDS->SetGeoTransform(gdalTranslation);
             outputImageDS->SetProjection(inputImageDS[0]->GetProjectionRef());
             
@@ -129,383 +122,347 @@ namespace rsgis{namespace filter{
 			}
 			
 			//Get Image Output Bands
-			outputRasterBands = new GDALRasterBand*[numOutBands];
-			for(int i = 0; i < numOutBands; i++)
+			outputRasterBands = new GDALRasterBand*[numInBands];
+			for(unsigned int i = 0; i < numInBands; i++)
 			{
 				outputRasterBands[i] = outputImageDS->GetRasterBand(i+1);
 			}
             
-            // Subset window as multiple of block size.
-            int outXBlockSize = 0;
-            int outYBlockSize = 0;
-            inputRasterBands[0]->GetBlockSize (&outXBlockSize, &outYBlockSize);
-            
-            std::cout << "outXBlockSize = " << outXBlockSize << ", outYBlockSize = " << outYBlockSize << std::endl;
-            
-            // Set search window height and width so multiples of block size
-            if(searchWindowWidth > outXBlockSize)
+            // Strips are a multiple of the block size and at least four times the halo 
+            // so the overhead of reading the halo is limited.
+            if(yBlockSize < 1)
             {
-                searchWindowWidth =  floor((float)searchWindowWidth / outXBlockSize) + outXBlockSize;
+                yBlockSize = 1;
             }
-            if(searchWindowHeight > outYBlockSize)
+            unsigned int numOfLines = yBlockSize * ((unsigned int)ceil(((double)(4*halo))/yBlockSize));
+            if(numOfLines > ((unsigned int)height))
             {
-                searchWindowHeight = floor((float)searchWindowHeight / outYBlockSize) + outYBlockSize;
+                numOfLines = height;
             }
-            searchWindowOverlap = filterWindowSize*2;
-            if(searchWindowOverlap < outYBlockSize)
+            unsigned int tileWidth = 256;
+            if(tileWidth > ((unsigned int)width))
             {
-                searchWindowOverlap = outYBlockSize;
+                tileWidth = width;
             }
             
-			// Allocate memory
-            numPxlsInSearchWindow = searchWindowWidth*searchWindowHeight;
-            inputDataSearchWindow = new float*[numInBands];
-			for(int i = 0; i < numInBands; i++)
+			// Allocate memory - the input strip includes the halo on all sides.
+            unsigned int bufWidth = width + (2 * halo);
+            unsigned int bufHeight = numOfLines + (2 * halo);
+            size_t numBufPxls = ((size_t)bufWidth) * ((size_t)bufHeight);
+            inputData = new float*[numInBands];
+			for(unsigned int i = 0; i < numInBands; i++)
 			{
-                inputDataSearchWindow[i] = (float *) CPLMalloc(sizeof(float)*numPxlsInSearchWindow);
-                for(int k = 0; k < numPxlsInSearchWindow; k++)
-                {
-                    inputDataSearchWindow[i][k] = 0;
-                }
+                inputData[i] = (float *) CPLMalloc(sizeof(float)*numBufPxls);
 			}
-			
-			outputData = new float*[numOutBands];
-			for(int i = 0; i < numOutBands; i++)
+			outputData = new float*[numInBands];
+			for(unsigned int i = 0; i < numInBands; i++)
 			{
-				outputData[i] = (float *) CPLMalloc(sizeof(float)*numPxlsInSearchWindow);
+				outputData[i] = (float *) CPLMalloc(sizeof(float)*((size_t)width)*numOfLines);
 			}
-			
-            // Set up GSL vector for data to be filtered.
-            gsl_vector *inDataVector =  gsl_vector_alloc(filterWindowSize*filterWindowSize);
-            gsl_vector *inSearchBlockVector =  gsl_vector_alloc(filterWindowSize*filterWindowSize);
             
-            //gsl_matrix *gaussKernel = gsl_matrix_alloc(filterWindowSize*filterWindowSize,filterWindowSize*filterWindowSize);
+            numThreads = rsgis::getNumProcessingThreads(numThreads);
+            std::vector< std::vector<double> > threadDiffs(numThreads);
+            std::vector< std::vector<double> > threadColSums(numThreads);
+            std::vector< std::vector<double> > threadSumWeights(numThreads);
+            std::vector< std::vector<double> > threadSumWeightedVals(numThreads);
             
-            swPixelValues = new double[numPxlsInSearchWindow];
-            swPixelWeights = new double[numPxlsInSearchWindow];
-            
-            // Initialise top corner at common overlap.
-            unsigned int startSearchX = bandOffsets[0][0];
-            unsigned int startSearchY = bandOffsets[0][1];
-            
-            unsigned int maxSearchX = width - searchWindowWidth;
-            unsigned int maxSearchY = height - searchWindowHeight;
-            unsigned int searchWinOffsetX = 0; // Offset for start pixel in search window
-            //unsigned int searchWinOffsetY = 0; // Offset for end pixel in search window
-            
-            std::cout << "height = " << height << ", searchWindowHeight = " << searchWindowHeight << std::endl;
-            std::cout << "width = " << width << ", searchWindowWidth = " << searchWindowWidth << std::endl;
-            
-            //unsigned int feedback = height*width / 10.0;
-			//int feedbackCounter = 0;
-			std::cout << "Started" << std::flush;
+            unsigned int numTiles = ceil(((double)width) / tileWidth);
+            unsigned int numStrips = ceil(((double)height) / numOfLines);
+            unsigned int feedback = numStrips/10;
+			unsigned int feedbackCounter = 0;
+			std::cout << "Started (" << numThreads << " threads) " << std::flush;
 			
-            while (startSearchY < maxSearchY)
+            for(unsigned int s = 0; s < numStrips; ++s)
             {
-                std::cout << "startSearchY = " << startSearchY << ", maxSearchY = " << maxSearchY << std::endl;
+                if((feedback == 0) || ((s % feedback) == 0))
+                {
+                    std::cout << "." << feedbackCounter << "." << std::flush;
+                    feedbackCounter = feedbackCounter + 10;
+                }
                 
-                startSearchX = 0; // Reset X
-                std::cout << "startSearchX = " << startSearchX << ", maxSearchX = " << maxSearchX << std::endl;
-                while (startSearchX < maxSearchX)
+                int stripStartRow = s * numOfLines;
+                int stripNumRows = numOfLines;
+                if((stripStartRow + stripNumRows) > height)
                 {
-                    
-                    // Read search window into memory
-                    for(int n = 0; n < numOutBands; n++)
+                    stripNumRows = height - stripStartRow;
+                }
+                
+                // Read the rows of the strip and halo within the image, the areas of the
+                // halo outside of the image are filled by replicating the image edges.
+                int readRowStart = stripStartRow - halo;
+                int readRowEnd = stripStartRow + stripNumRows + halo;
+                unsigned int bufRowOff = 0;
+                if(readRowStart < 0)
+                {
+                    bufRowOff = -readRowStart;
+                    readRowStart = 0;
+                }
+                if(readRowEnd > height)
+                {
+                    readRowEnd = height;
+                }
+                int numReadRows = readRowEnd - readRowStart;
+                unsigned int numUsedBufRows = stripNumRows + (2 * halo);
+                
+                for(unsigned int n = 0; n < numInBands; n++)
+                {
+                    float *bufData = inputData[n];
+                    if(inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], bandOffsets[n][1]+readRowStart, width, numReadRows, bufData + (((size_t)bufRowOff) * bufWidth) + halo, width, numReadRows, GDT_Float32, 0, sizeof(float)*bufWidth) != CE_None)
                     {
-                        inputRasterBands[n]->RasterIO(GF_Read, startSearchX, startSearchY, searchWindowWidth, searchWindowHeight, inputDataSearchWindow[n], searchWindowWidth, searchWindowHeight, GDT_Float32, 0, 0);
+                        throw rsgis::img::RSGISImageBandException("Could not read the input image strip.");
                     }
-                    
-                    // Loop through pixels in search window
-                    unsigned int cPxl = 0;
-                    for(unsigned int i = 0; i < searchWindowHeight; ++i)
+                    for(unsigned int y = 0; y < bufRowOff; ++y)
                     {
-                        searchWinOffsetX = 0; // Reset x offset
-                        for(unsigned int j = 0; j < searchWindowWidth; ++j)
+                        std::copy(bufData + (((size_t)bufRowOff) * bufWidth), bufData + (((size_t)bufRowOff+1) * bufWidth), bufData + (((size_t)y) * bufWidth));
+                    }
+                    unsigned int lastRow = bufRowOff + numReadRows - 1;
+                    for(unsigned int y = lastRow+1; y < numUsedBufRows; ++y)
+                    {
+                        std::copy(bufData + (((size_t)lastRow) * bufWidth), bufData + (((size_t)lastRow+1) * bufWidth), bufData + (((size_t)y) * bufWidth));
+                    }
+                    for(unsigned int y = 0; y < numUsedBufRows; ++y)
+                    {
+                        float *bufLine = bufData + (((size_t)y) * bufWidth);
+                        std::fill(bufLine, bufLine + halo, bufLine[halo]);
+                        std::fill(bufLine + halo + width, bufLine + bufWidth, bufLine[halo + width - 1]);
+                    }
+                }
+                
+                rsgis::parallelForRange(0, ((size_t)numTiles) * numInBands, numThreads, 1, [&](size_t idxStart, size_t idxEnd, unsigned int threadIdx)
+                {
+                    for(size_t idx = idxStart; idx < idxEnd; ++idx)
+                    {
+                        unsigned int n = idx / numTiles;
+                        unsigned int tileStartCol = (idx % numTiles) * tileWidth;
+                        unsigned int tileNumCols = tileWidth;
+                        if((tileStartCol + tileNumCols) > ((unsigned int)width))
                         {
-                            // Get data block
-                            int startDataBlockX = j - filterWinPix;
-                            int startDataBlockY = i - filterWinPix;
-                            int endDataBlockX = j + filterWinPix;
-                            int endDataBlockY = i + filterWinPix;
-                            
-                            if (startDataBlockX < 0)
-                            {
-                                startDataBlockX = 0;
-                                endDataBlockX = filterWindowSize;
-                            }
-                            if (startDataBlockY < 0)
-                            {
-                                startDataBlockY = 0;
-                                endDataBlockY = filterWindowSize;
-                            }
-                            if (endDataBlockX >= searchWindowWidth)
-                            {
-                                startDataBlockX = searchWindowWidth-filterWinPix;
-                                endDataBlockX = searchWindowWidth;
-                            }
-                            if (endDataBlockY >= searchWindowHeight)
-                            {
-                                startDataBlockY = searchWindowHeight-filterWinPix;
-                                endDataBlockY = searchWindowHeight;
-                            }
-                            
-                            for(int n = 0; n < numOutBands; n++)
-                            {
-                                
-                                // Get vector for data block
-                                unsigned int pixVecNum = 0;
-                                for(unsigned int y = startDataBlockY;y < endDataBlockY; ++y)
-                                {
-                                    for(unsigned int x = startDataBlockX; x < endDataBlockX; ++x)
-                                    {
-                                        double pixVal = inputDataSearchWindow[n][(y*searchWindowWidth)+x];
-                                        gsl_vector_set(inDataVector, pixVecNum, pixVal);
-                                        ++pixVecNum;
-                                    }
-                                }
-                                
-                                // Calculate pixel values and weights for all blocks in search window
-                                unsigned int swValNum = 0;
-                                for(unsigned int searchWinY = 0; searchWinY < searchWindowHeight; ++searchWinY)
-                                {
-                                    for(unsigned int searchWinX = 0; searchWinX < searchWindowWidth; ++searchWinX)
-                                    {
-                                        // Get data block
-                                        int startSearchBlockX = j - filterWinPix;
-                                        int startSearchBlockY = i - filterWinPix;
-                                        int endSearchBlockX = j + filterWinPix;
-                                        int endSearchBlockY = i + filterWinPix;
-                                        
-                                        if (startSearchBlockX < 0)
-                                        {
-                                            startSearchBlockX = 0;
-                                            endSearchBlockX = filterWindowSize;
-                                        }
-                                        if (startSearchBlockY < 0)
-                                        {
-                                            startSearchBlockY = 0;
-                                            endSearchBlockY = filterWindowSize;
-                                        }
-                                        if (endSearchBlockX >= searchWindowWidth)
-                                        {
-                                            startSearchBlockX = searchWindowWidth-filterWinPix;
-                                            endSearchBlockX = searchWindowWidth;
-                                        }
-                                        if (endSearchBlockY >= searchWindowHeight)
-                                        {
-                                            startSearchBlockY = searchWindowHeight-filterWinPix;
-                                            endSearchBlockY = searchWindowHeight;
-                                        }
-                                                                                    
-                                        // Add to GSL vector
-                                        unsigned int pixVecNum = 0;
-                                        for(unsigned int y = startSearchBlockY;y < endSearchBlockY; ++y)
-                                        {
-                                            for(unsigned int x = startSearchBlockX; x < endSearchBlockX; ++x)
-                                            {
-                                                double pixVal = inputDataSearchWindow[n][(y*searchWindowWidth)+x];
-                                                double pixelDiff = pixVal - gsl_vector_get(inDataVector, pixVecNum);
-                                                gsl_vector_set(inSearchBlockVector, pixVecNum, pixelDiff);
-                                                
-                                                if((x == windowMid) && (y == windowMid))
-                                                {
-                                                    // Add centre pixel value to vector.
-                                                    swPixelValues[swValNum] = pixVal;
-                                                }
-                                                
-                                                ++pixVecNum;
-                                            }
-                                        }
-                                        
-                                        // Calculate weights
-                                        // v(Ni) . Gauss . v(Nj)
-                                        double inBlockSearchBlockGDiff = vectorUtils.dotProductVectorVectorGSL(inSearchBlockVector, inSearchBlockVector);
-                                        double swPixWeight = exp(invHParSq * inBlockSearchBlockGDiff);
-                                        
-                                        swPixelWeights[swValNum] = swPixWeight;
-                                        ++swValNum;
-
-                                    }
-                                }
-                                
-                                // Estimate denoised pixel values
-                                
-                                // Calculate sum of weights
-                                double sumWeights = 0;
-                                for(unsigned int w=0; w < numPxlsInSearchWindow; ++w)
-                                {
-                                    sumWeights+=swPixelWeights[w];
-                                }
-                                
-                                // Calculate weighted mean
-                                double denoisedPixVal = 0;
-                                double weightPixVal = 0;
-                                
-                                for(unsigned int w=0; w < numPxlsInSearchWindow; ++w)
-                                {
-                                    weightPixVal = (1. / sumWeights) * swPixelWeights[w] * swPixelValues[w];
-                                    denoisedPixVal+= weightPixVal;
-                                }
- 
-                                // Save filterd pixel value to output column
-                                outputData[n][cPxl] = denoisedPixVal;
-                                
-                            }
-                            if(cPxl % 100 == 0){std::cout << cPxl << std::endl;}
-                            ++cPxl;
+                            tileNumCols = width - tileStartCol;
                         }
+                        this->filterTile(inputData[n], bufWidth, halo, tileStartCol, tileNumCols, stripNumRows, stripStartRow, width, height, outputData[n], &threadDiffs.at(threadIdx), &threadColSums.at(threadIdx), &threadSumWeights.at(threadIdx), &threadSumWeightedVals.at(threadIdx));
                     }
-                    
-                    for(int n = 0; n < numOutBands; n++)
+                });
+                
+                for(unsigned int n = 0; n < numInBands; n++)
+                {
+                    if(outputRasterBands[n]->RasterIO(GF_Write, 0, stripStartRow, width, stripNumRows, outputData[n], width, stripNumRows, GDT_Float32, 0, 0) != CE_None)
                     {
-                        outputRasterBands[n]->RasterIO(GF_Write, startSearchX, startSearchY, searchWindowWidth, searchWindowHeight, outputData[n], searchWindowWidth, searchWindowHeight, GDT_Float32, 0, 0);
+                        throw rsgis::img::RSGISImageBandException("Could not write the output image strip.");
                     }
-                    startSearchX+=searchWindowWidth;
                 }
-                startSearchY+=searchWindowWidth;
             }
-
             std::cout << " Complete.\n";
 		}
-		catch(rsgis::img::RSGISImageCalcException& e)
+		catch(rsgis::RSGISImageException& e)
 		{
-			if(gdalTranslation != NULL)
-			{
-				delete[] gdalTranslation;
-			}
-			
-			if(dsOffsets != NULL)
-			{
-				for(int i = 0; i < numDS; i++)
-				{
-					delete dsOffsets[i];
-				}
-				delete[] dsOffsets;
-			}
-			
-			if(bandOffsets != NULL)
-			{
-				for(int i = 0; i < numInBands; i++)
-				{
-					delete bandOffsets[i];
-				}
-				delete[] bandOffsets;
-			}
-            
-            if(inputDataSearchWindow != NULL)
-			{
-				for(int i = 0; i < numInBands; i++)
-				{
-					delete[] inputDataSearchWindow[i];
-				}
-				delete[] inputDataSearchWindow;
-			}
-			
-			if(outputData != NULL)
-			{
-				for(int i = 0; i < numOutBands; i++)
-				{
-					delete outputData[i];
-				}
-				delete outputData;
-			}
+            if(outputImageDS != NULL)
+            {
+                GDALClose(outputImageDS);
+            }
             
-			throw e;
-		}
-		catch(rsgis::img::RSGISImageBandException& e)
-		{
-			if(gdalTranslation != NULL)
-			{
-				delete[] gdalTranslation;
-			}
-			
-			if(dsOffsets != NULL)
-			{
-				for(int i = 0; i < numDS; i++)
-				{
-					delete dsOffsets[i];
-				}
-				delete[] dsOffsets;
-			}
+			delete[] gdalTranslation;
+            for(int i = 0; i < numDS; i++)
+            {
+                delete[] dsOffsets[i];
+            }
+            delete[] dsOffsets;
 			
 			if(bandOffsets != NULL)
 			{
-				for(int i = 0; i < numInBands; i++)
+				for(unsigned int i = 0; i < numInBands; i++)
 				{
-					delete bandOffsets[i];
+					delete[] bandOffsets[i];
 				}
 				delete[] bandOffsets;
 			}
+            if(inputRasterBands != NULL)
+            {
+                delete[] inputRasterBands;
+            }
+            if(outputRasterBands != NULL)
+            {
+                delete[] outputRasterBands;
+            }
             
-            if(inputDataSearchWindow != NULL)
+            if(inputData != NULL)
 			{
-				for(int i = 0; i < numInBands; i++)
+				for(unsigned int i = 0; i < numInBands; i++)
 				{
-					delete[] inputDataSearchWindow[i];
+					CPLFree(inputData[i]);
 				}
-				delete[] inputDataSearchWindow;
+				delete[] inputData;
 			}
 			
 			if(outputData != NULL)
 			{
-				for(int i = 0; i < numOutBands; i++)
+				for(unsigned int i = 0; i < numInBands; i++)
 				{
-					delete outputData[i];
+					CPLFree(outputData[i]);
 				}
-				delete outputData;
+				delete[] outputData;
 			}
-			
+            
 			throw e;
 		}
 		
-		if(gdalTranslation != NULL)
-		{
-			delete[] gdalTranslation;
-		}
-		
-		if(dsOffsets != NULL)
-		{
-			for(int i = 0; i < numDS; i++)
-			{
-				delete dsOffsets[i];
-			}
-			delete[] dsOffsets;
-		}
+        GDALClose(outputImageDS);
+        
+		delete[] gdalTranslation;
+		for(int i = 0; i < numDS; i++)
+        {
+            delete[] dsOffsets[i];
+        }
+        delete[] dsOffsets;
 		
-		if(bandOffsets != NULL)
-		{
-			for(int i = 0; i < numInBands; i++)
-			{
-				delete bandOffsets[i];
-			}
-			delete[] bandOffsets;
-		}
+		for(unsigned int i = 0; i < numInBands; i++)
+        {
+            delete[] bandOffsets[i];
+        }
+        delete[] bandOffsets;
+        delete[] inputRasterBands;
+        delete[] outputRasterBands;
         
-        if(inputDataSearchWindow != NULL)
+        for(unsigned int i = 0; i < numInBands; i++)
         {
-            for(int i = 0; i < numInBands; i++)
+            CPLFree(inputData[i]);
+        }
+        delete[] inputData;
+        
+        for(unsigned int i = 0; i < numInBands; i++)
+        {
+            CPLFree(outputData[i]);
+        }
+        delete[] outputData;
+	}
+    
+    void RSGISApplyNonLocalDenoising::filterTile(float *inData, unsigned int bufWidth, unsigned int halo, unsigned int tileStartCol, unsigned int tileWidth, unsigned int numRows, unsigned int imgStartRow, unsigned int imgWidth, unsigned int imgHeight, float *outData, std::vector<double> *diffs, std::vector<double> *colSums, std::vector<double> *sumWeights, std::vector<double> *sumWeightedVals)
+    {
+        /*
+         * For each offset (dx, dy) within the search window the squared difference between 
+         * pixel p and p+(dx, dy) is calculated for every pixel of the tile extended by the 
+         * patch half width. The patch sums are then calculated with running sums down the 
+         * columns and along the rows, giving the patch distance for all pixels in O(1).
+         *
+         * Buffer (bx, by) for strip pixel (x, y) is (x + halo, y + halo).
+         */
+        unsigned int patchSize = (2 * this->patchHalf) + 1;
+        unsigned int extWidth = tileWidth + (2 * this->patchHalf);
+        unsigned int extHeight = numRows + (2 * this->patchHalf);
+        size_t numTilePxls = ((size_t)tileWidth) * numRows;
+        
+        diffs->resize(((size_t)extWidth) * extHeight);
+        colSums->resize(((size_t)extWidth) * numRows);
+        sumWeights->assign(numTilePxls, 0.0);
+        sumWeightedVals->assign(numTilePxls, 0.0);
+        
+        double *diffsData = diffs->data();
+        double *colSumsData = colSums->data();
+        double *sumWeightsData = sumWeights->data();
+        double *sumWeightedValsData = sumWeightedVals->data();
+        
+        int searchHalf = this->searchHalf;
+        for(int dy = -searchHalf; dy <= searchHalf; ++dy)
+        {
+            // Rows of the tile for which p+(dx, dy) is within the image.
+            int validRowStart = std::max(0, -(((int)imgStartRow) + dy));
+            int validRowEnd = std::min(((int)numRows), ((int)imgHeight) - (((int)imgStartRow) + dy));
+            if(validRowStart >= validRowEnd)
             {
-                delete[] inputDataSearchWindow[i];
+                continue;
+            }
+            
+            for(int dx = -searchHalf; dx <= searchHalf; ++dx)
+            {
+                int validColStart = std::max(0, -(((int)tileStartCol) + dx));
+                int validColEnd = std::min(((int)tileWidth), ((int)imgWidth) - (((int)tileStartCol) + dx));
+                if(validColStart >= validColEnd)
+                {
+                    continue;
+                }
+                
+                // Squared differences for the extended tile.
+                for(unsigned int ey = 0; ey < extHeight; ++ey)
+                {
+                    size_t bufRow = ey + halo - this->patchHalf;
+                    const float *pLine = inData + (bufRow * bufWidth) + tileStartCol + halo - this->patchHalf;
+                    const float *qLine = inData + ((bufRow + dy) * bufWidth) + tileStartCol + halo - this->patchHalf + dx;
+                    double *diffLine = diffsData + (((size_t)ey) * extWidth);
+                    for(unsigned int ex = 0; ex < extWidth; ++ex)
+                    {
+                        double diff = ((double)pLine[ex]) - ((double)qLine[ex]);
+                        diffLine[ex] = diff * diff;
+                    }
+                }
+                
+                // Sums down the columns of the patch height.
+                double *colSumLine = colSumsData;
+                for(unsigned int ex = 0; ex < extWidth; ++ex)
+                {
+                    colSumLine[ex] = 0;
+                }
+                for(unsigned int k = 0; k < patchSize; ++k)
+                {
+                    double *diffLine = diffsData + (((size_t)k) * extWidth);
+                    for(unsigned int ex = 0; ex < extWidth; ++ex)
+                    {
+                        colSumLine[ex] += diffLine[ex];
+                    }
+                }
+                for(unsigned int y = 1; y < numRows; ++y)
+                {
+                    const double *prevLine = colSumsData + (((size_t)y-1) * extWidth);
+                    const double *addLine = diffsData + (((size_t)y + patchSize - 1) * extWidth);
+                    const double *subLine = diffsData + (((size_t)y - 1) * extWidth);
+                    colSumLine = colSumsData + (((size_t)y) * extWidth);
+                    for(unsigned int ex = 0; ex < extWidth; ++ex)
+                    {
+                        colSumLine[ex] = prevLine[ex] + addLine[ex] - subLine[ex];
+                    }
+                }
+                
+                // Sums along the rows giving the patch distance and the weights.
+                for(int y = validRowStart; y < validRowEnd; ++y)
+                {
+                    const double *colSumRow = colSumsData + (((size_t)y) * extWidth);
+                    const float *qLine = inData + ((((size_t)y) + halo + dy) * bufWidth) + tileStartCol + halo + dx;
+                    double *weightLine = sumWeightsData + (((size_t)y) * tileWidth);
+                    double *valLine = sumWeightedValsData + (((size_t)y) * tileWidth);
+                    
+                    double patchDist = 0;
+                    for(int k = 0; k < ((int)patchSize); ++k)
+                    {
+                        patchDist += colSumRow[validColStart + k];
+                    }
+                    for(int x = validColStart; x < validColEnd; ++x)
+                    {
+                        if(x > validColStart)
+                        {
+                            patchDist += colSumRow[x + patchSize - 1] - colSumRow[x - 1];
+                        }
+                        // Clamp small negative values from rounding of the running sums.
+                        double weight = exp(-std::max(patchDist, 0.0) * this->invHParSq);
+                        weightLine[x] += weight;
+                        valLine[x] += weight * qLine[x];
+                    }
+                }
             }
-            delete[] inputDataSearchWindow;
         }
         
-		if(outputData != NULL)
-		{
-			for(int i = 0; i < numOutBands; i++)
-			{
-				delete outputData[i];
-			}
-			delete outputData;
-		}
-		
-	}
-	
+        for(unsigned int y = 0; y < numRows; ++y)
+        {
+            float *outLine = outData + (((size_t)y) * imgWidth) + tileStartCol;
+            const double *weightLine = sumWeightsData + (((size_t)y) * tileWidth);
+            const double *valLine = sumWeightedValsData + (((size_t)y) * tileWidth);
+            for(unsigned int x = 0; x < tileWidth; ++x)
+            {
+                outLine[x] = valLine[x] / weightLine[x];
+            }
+        }
+    }
 	
 	RSGISApplyNonLocalDenoising::~RSGISApplyNonLocalDenoising()
 	{
 		
 	}
     
-    
 }}
@@ -24,20 +24,17 @@
 #define RSGISNonLocalDenoising_H
 
 #include <iostream>
-
-#include <gsl/gsl_vector.h>
-#include <gsl/gsl_matrix.h>
+#include <vector>
+#include <cmath>
+#include <algorithm>
 
 #include "gdal_priv.h"
 
 #include "common/RSGISImageException.h"
+#include "common/RSGISThreadUtils.h"
 
-#include "math/RSGISMatrices.h"
-#include "math/RSGISVectors.h"
-
-#include "img/RSGISImageCalcException.h"
 #include "img/RSGISImageCalcException.h"
-#include "img/RSGISCalcImageValue.h"
+#include "img/RSGISImageBandException.h"
 #include "img/RSGISImageUtils.h"
 
 // mark all exported classes/functions with DllExport to have
@@ -62,16 +59,29 @@ namespace rsgis{namespace filter{
          
             Buades, A., Coll, B. & Morel, J.M., A non-local algorithm for image denoising. 2005.
             IEEE Computer Society Conference on Computer Vision and Pattern Recognition.
+        
+         The weights are calculated from the sum of squared differences between the
+         patches (filterWindowSize x filterWindowSize) as exp(-ssd/h^2). For each offset
+         within the search window the squared differences are summed over the patches
+         using running box sums (the integral image formulation of Darbon et al., 2008)
+         so the patch comparison is O(1) per pixel and offset. The image is processed in
+         strips of rows, with a halo, split into tiles which are filtered in parallel.
 
          */
         
     public: 
         RSGISApplyNonLocalDenoising();
-        void ApplyFilter(GDALDataset **inputImageDS, int numDS, std::string outputImage, unsigned int filterWindowSize, unsigned int searchWindowSize, double aPar=2.0, double hPar=2.0, std::string gdalFormat="ENVI", GDALDataType gdalDataType=GDT_Float32);
+        /**
+         * aPar (the std dev. of the Gaussian patch kernel) is not used as the patch 
+         * differences are equally weighted to allow the sums to be calculated incrementally.
+         */
+        void ApplyFilter(GDALDataset **inputImageDS, int numDS, std::string outputImage, unsigned int filterWindowSize, unsigned int searchWindowSize, double aPar=2.0, double hPar=2.0, std::string gdalFormat="ENVI", GDALDataType gdalDataType=GDT_Float32, unsigned int numThreads=1);
         ~RSGISApplyNonLocalDenoising();
     protected:
-        unsigned int searchWindowSize; // Window size of search space
-        GDALDataset **inputImageDS; // GDAL dataset for input image
+        void filterTile(float *inData, unsigned int bufWidth, unsigned int halo, unsigned int tileStartCol, unsigned int tileWidth, unsigned int numRows, unsigned int imgStartRow, unsigned int imgWidth, unsigned int imgHeight, float *outData, std::vector<double> *diffs, std::vector<double> *colSums, std::vector<double> *sumWeights, std::vector<double> *sumWeightedVals);
+        unsigned int patchHalf; // Number of pixels each side of the centre of the patch
+        unsigned int searchHalf; // Number of pixels each side of the centre of the search window
+        double invHParSq;
     };
 }}
 
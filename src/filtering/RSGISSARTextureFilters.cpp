@@ -80,6 +80,32 @@ namespace rsgis{namespace filter{
         }
 	}
 
+    bool RSGISNormVarPowerFilter::getWindowStatsRequirements(std::vector<RSGISWindowStatsReq> *reqs)
+    {
+        RSGISWindowStatsReq req;
+        req.transform = rsgis_winval_x;
+        req.ignoreNoData = true;
+        reqs->push_back(req);
+        return true;
+    }
+
+    void RSGISNormVarPowerFilter::calcImageValueFromWindowStats(RSGISWindowStats **stats, float *centreVals, int numBands, double *output)
+    {
+        for(int i = 0; i < numBands; i++)
+        {
+            // Check for data at the centre of the block (skip if no data to preserve scene edges)
+            // and that there were more than three data values.
+            if((centreVals[i] == 0) | ((boost::math::isnan)(centreVals[i])) | (stats[0][i].n <= 3))
+            {
+                output[i] = 0;
+            }
+            else
+            {
+                // mean(I^2)/mean(I)^2 - 1 = var(I)/mean(I)^2
+                output[i] = stats[0][i].var / (stats[0][i].mean * stats[0][i].mean);
+            }
+        }
+    }
 
     RSGISNormVarAmplitudeFilter::RSGISNormVarAmplitudeFilter(int numberOutBands, int size, std::string filenameEnding) : RSGISImageFilter(numberOutBands, size, filenameEnding){}
 
@@ -136,6 +162,32 @@ namespace rsgis{namespace filter{
         }
 	}
 
+    bool RSGISNormVarAmplitudeFilter::getWindowStatsRequirements(std::vector<RSGISWindowStatsReq> *reqs)
+    {
+        RSGISWindowStatsReq req;
+        req.transform = rsgis_winval_sqrt;
+        req.ignoreNoData = true;
+        reqs->push_back(req);
+        return true;
+    }
+
+    void RSGISNormVarAmplitudeFilter::calcImageValueFromWindowStats(RSGISWindowStats **stats, float *centreVals, int numBands, double *output)
+    {
+        for(int i = 0; i < numBands; i++)
+        {
+            // Check for data at the centre of the block (skip if no data to preserve scene edges)
+            // and that there were more than three data values.
+            if((centreVals[i] == 0) | ((boost::math::isnan)(centreVals[i])) | (stats[0][i].n <= 3))
+            {
+                output[i] = 0;
+            }
+            else
+            {
+                // mean(I)/mean(A)^2 - 1 = var(A)/mean(A)^2 where A = sqrt(I)
+                output[i] = stats[0][i].var / (stats[0][i].mean * stats[0][i].mean);
+            }
+        }
+    }
 
     RSGISNormVarLnPowerFilter::RSGISNormVarLnPowerFilter(int numberOutBands, int size, std::string filenameEnding) : RSGISImageFilter(numberOutBands, size, filenameEnding){}
 
@@ -192,6 +244,33 @@ namespace rsgis{namespace filter{
         }
 	}
 
+    bool RSGISNormVarLnPowerFilter::getWindowStatsRequirements(std::vector<RSGISWindowStatsReq> *reqs)
+    {
+        RSGISWindowStatsReq req;
+        req.transform = rsgis_winval_ln;
+        req.ignoreNoData = true;
+        reqs->push_back(req);
+        return true;
+    }
+
+    void RSGISNormVarLnPowerFilter::calcImageValueFromWindowStats(RSGISWindowStats **stats, float *centreVals, int numBands, double *output)
+    {
+        for(int i = 0; i < numBands; i++)
+        {
+            // Check for data at the centre of the block (skip if no data to preserve scene edges)
+            // and that there were more than three data values.
+            if((centreVals[i] == 0) | ((boost::math::isnan)(centreVals[i])) | (stats[0][i].n <= 3))
+            {
+                output[i] = 0;
+            }
+            else
+            {
+                // mean(ln(I)^2)/mean(ln(I))^2 - 1 = var(ln(I))/mean(ln(I))^2
+                output[i] = stats[0][i].var / (stats[0][i].mean * stats[0][i].mean);
+            }
+        }
+    }
+
     RSGISNormLnFilter::RSGISNormLnFilter(int numberOutBands, int size, std::string filenameEnding) : RSGISImageFilter(numberOutBands, size, filenameEnding){}
 
     void RSGISNormLnFilter::calcImageValue(float ***dataBlock, int numBands, int winSize, double *output) 
@@ -247,6 +326,35 @@ namespace rsgis{namespace filter{
         }
 	}
 
+    bool RSGISNormLnFilter::getWindowStatsRequirements(std::vector<RSGISWindowStatsReq> *reqs)
+    {
+        RSGISWindowStatsReq req;
+        req.transform = rsgis_winval_x;
+        req.ignoreNoData = true;
+        reqs->push_back(req);
+        req.transform = rsgis_winval_ln;
+        req.ignoreNoData = true;
+        reqs->push_back(req);
+        return true;
+    }
+
+    void RSGISNormLnFilter::calcImageValueFromWindowStats(RSGISWindowStats **stats, float *centreVals, int numBands, double *output)
+    {
+        for(int i = 0; i < numBands; i++)
+        {
+            // Check for data at the centre of the block (skip if no data to preserve scene edges)
+            // and that there were more than three data values.
+            if((centreVals[i] == 0) | ((boost::math::isnan)(centreVals[i])) | (stats[0][i].n <= 3))
+            {
+                output[i] = 0;
+            }
+            else
+            {
+                output[i] = stats[1][i].mean - log(stats[0][i].mean);
+            }
+        }
+    }
+
     RSGISTextureVar::RSGISTextureVar(int numberOutBands, int size, std::string filenameEnding) : RSGISImageFilter(numberOutBands, size, filenameEnding){}
 
     void RSGISTextureVar::calcImageValue(float ***dataBlock, int numBands, int winSize, double *output) 
@@ -314,4 +422,32 @@ namespace rsgis{namespace filter{
         }
 	}
 
+    bool RSGISTextureVar::getWindowStatsRequirements(std::vector<RSGISWindowStatsReq> *reqs)
+    {
+        RSGISWindowStatsReq req;
+        req.transform = rsgis_winval_x;
+        req.ignoreNoData = true;
+        reqs->push_back(req);
+        return true;
+    }
+
+    void RSGISTextureVar::calcImageValueFromWindowStats(RSGISWindowStats **stats, float *centreVals, int numBands, double *output)
+    {
+        for(int i = 0; i < numBands; i++)
+        {
+            // Check for data at the centre of the block (skip if no data to preserve scene edges)
+            // and that there were more than three data values.
+            if((centreVals[i] == 0) | ((boost::math::isnan)(centreVals[i])) | (stats[0][i].n <= 3))
+            {
+                output[i] = 0;
+            }
+            else
+            {
+                unsigned int numVal = stats[0][i].n;
+                double stDev = sqrt(stats[0][i].var);
+                output[i] = (pow((stDev / stats[0][i].mean),2)-(1/numVal))/(1+(1/numVal));
+            }
+        }
+    }
+
 }}
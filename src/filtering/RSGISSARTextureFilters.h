@@ -24,6 +24,7 @@
 #define RSGISSARTextureFilters_H
 
 #include <iostream>
+#include <vector>
 
 #include "common/RSGISImageException.h"
 
@@ -65,6 +66,8 @@ namespace rsgis{namespace filter{
         virtual void calcImageValue(float ***dataBlock, int numBands, int winSize, double *output);
         virtual bool calcImageValueCondition(float ***dataBlock, int numBands, int winSize, double *output) {throw RSGISImageFilterException("Not implemented for NVarPower filter!");};;
         virtual void exportAsImage(std::string filename){throw RSGISImageFilterException("No image to output!");};
+        virtual bool getWindowStatsRequirements(std::vector<RSGISWindowStatsReq> *reqs);
+        virtual void calcImageValueFromWindowStats(RSGISWindowStats **stats, float *centreVals, int numBands, double *output);
         ~RSGISNormVarPowerFilter(){};
     };
 
@@ -84,6 +87,8 @@ namespace rsgis{namespace filter{
         virtual void calcImageValue(float ***dataBlock, int numBands, int winSize, double *output);
         virtual bool calcImageValueCondition(float ***dataBlock, int numBands, int winSize, double *output) {throw RSGISImageFilterException("Not implemented for NVarAmplitude filter!");};;
         virtual void exportAsImage(std::string filename){throw RSGISImageFilterException("No image to output!");};
+        virtual bool getWindowStatsRequirements(std::vector<RSGISWindowStatsReq> *reqs);
+        virtual void calcImageValueFromWindowStats(RSGISWindowStats **stats, float *centreVals, int numBands, double *output);
         ~RSGISNormVarAmplitudeFilter(){};
     };
 
@@ -103,6 +108,8 @@ namespace rsgis{namespace filter{
         virtual void calcImageValue(float ***dataBlock, int numBands, int winSize, double *output);
         virtual bool calcImageValueCondition(float ***dataBlock, int numBands, int winSize, double *output) {throw RSGISImageFilterException("Not implemented for NVarLogPower filter!");};;
         virtual void exportAsImage(std::string filename){throw RSGISImageFilterException("No image to output!");};
+        virtual bool getWindowStatsRequirements(std::vector<RSGISWindowStatsReq> *reqs);
+        virtual void calcImageValueFromWindowStats(RSGISWindowStats **stats, float *centreVals, int numBands, double *output);
         ~RSGISNormVarLnPowerFilter(){};
     };
 
@@ -122,6 +129,8 @@ namespace rsgis{namespace filter{
         virtual void calcImageValue(float ***dataBlock, int numBands, int winSize, double *output);
         virtual bool calcImageValueCondition(float ***dataBlock, int numBands, int winSize, double *output) {throw RSGISImageFilterException("Not implemented for NVarLogPower filter!");};;
         virtual void exportAsImage(std::string filename){throw RSGISImageFilterException("No image to output!");};
+        virtual bool getWindowStatsRequirements(std::vector<RSGISWindowStatsReq> *reqs);
+        virtual void calcImageValueFromWindowStats(RSGISWindowStats **stats, float *centreVals, int numBands, double *output);
         ~RSGISNormLnFilter(){};
     };
 
@@ -143,6 +152,8 @@ namespace rsgis{namespace filter{
         virtual void calcImageValue(float ***dataBlock, int numBands, int winSize, double *output);
         virtual bool calcImageValueCondition(float ***dataBlock, int numBands, int winSize, double *output) {throw RSGISImageFilterException("Not implemented for NVarLogPower filter!");};;
         virtual void exportAsImage(std::string filename){throw RSGISImageFilterException("No image to output!");};
+        virtual bool getWindowStatsRequirements(std::vector<RSGISWindowStatsReq> *reqs);
+        virtual void calcImageValueFromWindowStats(RSGISWindowStats **stats, float *centreVals, int numBands, double *output);
         ~RSGISTextureVar(){};
     };
 }}
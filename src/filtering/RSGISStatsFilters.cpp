@@ -52,6 +52,23 @@ namespace rsgis{namespace filter{
 		}
 	}
 
+	bool RSGISMeanFilter::getWindowStatsRequirements(std::vector<RSGISWindowStatsReq> *reqs)
+	{
+		RSGISWindowStatsReq req;
+		req.transform = rsgis_winval_x;
+		req.ignoreNoData = false;
+		reqs->push_back(req);
+		return true;
+	}
+
+	void RSGISMeanFilter::calcImageValueFromWindowStats(RSGISWindowStats **stats, float *centreVals, int numBands, double *output)
+	{
+		for(int i = 0; i < numBands; i++)
+		{
+			output[i] = stats[0][i].mean;
+		}
+	}
+
 	bool RSGISMeanFilter::calcImageValueCondition(float ***dataBlock, int numBands, int winSize, double *output) 
 	{
 		throw rsgis::img::RSGISImageCalcException("Not implemented yet");
@@ -272,6 +289,23 @@ namespace rsgis{namespace filter{
 		}
 	}
 
+	bool RSGISStdDevFilter::getWindowStatsRequirements(std::vector<RSGISWindowStatsReq> *reqs)
+	{
+		RSGISWindowStatsReq req;
+		req.transform = rsgis_winval_x;
+		req.ignoreNoData = false;
+		reqs->push_back(req);
+		return true;
+	}
+
+	void RSGISStdDevFilter::calcImageValueFromWindowStats(RSGISWindowStats **stats, float *centreVals, int numBands, double *output)
+	{
+		for(int i = 0; i < numBands; i++)
+		{
+			output[i] = sqrt(stats[0][i].var);
+		}
+	}
+
 	bool RSGISStdDevFilter::calcImageValueCondition(float ***dataBlock, int numBands, int winSize, double *output) 
 	{
 		throw rsgis::img::RSGISImageCalcException("Not implemented yet");
@@ -330,6 +364,23 @@ namespace rsgis{namespace filter{
 		}
 	}
 
+	bool RSGISCoeffOfVarFilter::getWindowStatsRequirements(std::vector<RSGISWindowStatsReq> *reqs)
+	{
+		RSGISWindowStatsReq req;
+		req.transform = rsgis_winval_x;
+		req.ignoreNoData = false;
+		reqs->push_back(req);
+		return true;
+	}
+
+	void RSGISCoeffOfVarFilter::calcImageValueFromWindowStats(RSGISWindowStats **stats, float *centreVals, int numBands, double *output)
+	{
+		for(int i = 0; i < numBands; i++)
+		{
+			output[i] = sqrt(stats[0][i].var) / stats[0][i].mean;
+		}
+	}
+
 	bool RSGISCoeffOfVarFilter::calcImageValueCondition(float ***dataBlock, int numBands, int winSize, double *output) 
 	{
 		throw rsgis::img::RSGISImageCalcException("Not implemented yet");
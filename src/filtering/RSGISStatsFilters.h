@@ -58,6 +58,8 @@ namespace rsgis{namespace filter{
 			virtual void calcImageValue(float ***dataBlock, int numBands, int winSize, double *output);
 			virtual bool calcImageValueCondition(float ***dataBlock, int numBands, int winSize, double *output);
 			virtual void exportAsImage(std::string filename);
+			virtual bool getWindowStatsRequirements(std::vector<RSGISWindowStatsReq> *reqs);
+			virtual void calcImageValueFromWindowStats(RSGISWindowStats **stats, float *centreVals, int numBands, double *output);
 			~RSGISMeanFilter();
 		};
 
@@ -98,6 +100,8 @@ namespace rsgis{namespace filter{
 			virtual void calcImageValue(float ***dataBlock, int numBands, int winSize, double *output);
 			virtual bool calcImageValueCondition(float ***dataBlock, int numBands, int winSize, double *output);
 			virtual void exportAsImage(std::string filename);
+			virtual bool getWindowStatsRequirements(std::vector<RSGISWindowStatsReq> *reqs);
+			virtual void calcImageValueFromWindowStats(RSGISWindowStats **stats, float *centreVals, int numBands, double *output);
 			~RSGISStdDevFilter();
 		};
 
@@ -114,6 +118,8 @@ namespace rsgis{namespace filter{
 			virtual void calcImageValue(float ***dataBlock, int numBands, int winSize, double *output);
 			virtual bool calcImageValueCondition(float ***dataBlock, int numBands, int winSize, double *output);
 			virtual void exportAsImage(std::string filename);
+			virtual bool getWindowStatsRequirements(std::vector<RSGISWindowStatsReq> *reqs);
+			virtual void calcImageValueFromWindowStats(RSGISWindowStats **stats, float *centreVals, int numBands, double *output);
 			~RSGISCoeffOfVarFilter();
 		};
 
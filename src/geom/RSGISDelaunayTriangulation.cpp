@@ -26,57 +26,26 @@ namespace rsgis{namespace geom{
 	
 	RSGISDelaunayTriangulation::RSGISDelaunayTriangulation(RSGIS2DPoint *a, RSGIS2DPoint *b, RSGIS2DPoint *c)
 	{
-		this->triangleList = new std::list<RSGISTriangle*>();
-		RSGISTriangle *tri = new RSGISTriangle(a, b, c);
-		triangleList->push_back(tri);
-		this->bbox = new geos::geom::Envelope();
-		this->bbox->expandToInclude(tri->getBBox());
-		this->aOuter = a;
-		this->bOuter = b;
-		this->cOuter = c;
+		this->initTriangulation(a, b, c);
 	}
 	
 	RSGISDelaunayTriangulation::RSGISDelaunayTriangulation(RSGISTriangle *tri)
 	{
-		this->triangleList = new std::list<RSGISTriangle*>();
-		triangleList->push_back(tri);
-		this->bbox = new geos::geom::Envelope();
-		this->bbox->expandToInclude(tri->getBBox());
-		this->aOuter = tri->getPointA();
-		this->bOuter = tri->getPointB();
-		this->cOuter = tri->getPointC();
+		this->initTriangulation(tri->getPointA(), tri->getPointB(), tri->getPointC());
+		// The triangle does not own its vertices, which are now owned by this class.
+		delete tri;
 	}
 	
 	RSGISDelaunayTriangulation::RSGISDelaunayTriangulation(std::list<RSGIS2DPoint*> *data)
 	{
 		RSGISGeometry geomUtils;
 		RSGISTriangle *tri = geomUtils.findBoundingTriangle(data);
+		this->initTriangulation(tri->getPointA(), tri->getPointB(), tri->getPointC());
+		delete tri;
 		
-		this->triangleList = new std::list<RSGISTriangle*>();
-		triangleList->push_back(tri);
-		
-		this->bbox = new geos::geom::Envelope();
-		this->bbox->expandToInclude(tri->getBBox());
-		this->aOuter = tri->getPointA();
-		this->bOuter = tri->getPointB();
-		this->cOuter = tri->getPointC();
-				
-		int i = 0;
-		int feedback = data->size()/10;
-		int feedbackCounter = 0;
-		
+		std::vector<RSGIS2DPoint*> pts(data->begin(), data->end());
 		std::cout << "Started" << std::flush;
-		std::list<RSGIS2DPoint*>::iterator iterData;
-		for(iterData = data->begin(); iterData != data->end(); ++iterData)
-		{
-			if((i % feedback) == 0)
-			{
-				std::cout << ".." << feedbackCounter << ".." << std::flush;
-				feedbackCounter = feedbackCounter + 10;
-			}
-			this->addVertex(*iterData);
-			++i;
-		}
+		this->insertPoints(&pts);
 		std::cout << " Complete.\n";
 		this->finaliseTriangulation();
 	}
@@ -85,341 +54,434 @@ namespace rsgis{namespace geom{
 	{
 		RSGISGeometry geomUtils;
 		RSGISTriangle *tri = geomUtils.findBoundingTriangle(data);
+		this->initTriangulation(tri->getPointA(), tri->getPointB(), tri->getPointC());
+		delete tri;
 		
+		std::vector<RSGIS2DPoint*> pts(data->begin(), data->end());
+		std::cout << "Started" << std::flush;
+		this->insertPoints(&pts);
+		std::cout << " Complete.\n";
+		this->finaliseTriangulation();
+	}
+	
+	void RSGISDelaunayTriangulation::initTriangulation(RSGIS2DPoint *a, RSGIS2DPoint *b, RSGIS2DPoint *c)
+	{
+		this->aOuter = a;
+		this->bOuter = b;
+		this->cOuter = c;
 		this->triangleList = new std::list<RSGISTriangle*>();
-		triangleList->push_back(tri);
+		this->listDirty = true;
+		this->visitStamp = 0;
+		this->lastTri = 0;
+		this->walkSeed = 1;
 		
-		this->bbox = new geos::geom::Envelope();
-		this->bbox->expandToInclude(tri->getBBox());
-		this->aOuter = tri->getPointA();
-		this->bOuter = tri->getPointB();
-		this->cOuter = tri->getPointC();
+		this->vertices.push_back(a);
+		this->vertices.push_back(b);
+		this->vertices.push_back(c);
+		for(int i = 0; i < 3; ++i)
+		{
+			this->vertX.push_back(this->vertices.at(i)->getX());
+			this->vertY.push_back(this->vertices.at(i)->getY());
+			this->excludedVertices.push_back(false);
+		}
 		
-		int i = 0;
-		int feedback = data->size()/10;
-		int feedbackCounter = 0;
+		RSGISDelaunayTri tri;
+		tri.v[0] = 0;
+		tri.v[1] = 1;
+		tri.v[2] = 2;
+		// Triangles are stored counter-clockwise.
+		if(RSGISDelaunayTriangulation::orient(vertX[0], vertY[0], vertX[1], vertY[1], vertX[2], vertY[2]) < 0)
+		{
+			tri.v[1] = 2;
+			tri.v[2] = 1;
+		}
+		tri.n[0] = -1;
+		tri.n[1] = -1;
+		tri.n[2] = -1;
+		tri.alive = true;
+		this->triangles.push_back(tri);
+		this->triVisited.push_back(0);
 		
-		std::cout << "Started" << std::flush;
-		std::vector<RSGIS2DPoint*>::iterator iterData;
-		for(iterData = data->begin(); iterData != data->end(); ++iterData)
+		this->bbox = new geos::geom::Envelope();
+		for(int i = 0; i < 3; ++i)
 		{
-			if((data->size() > 10) && ((i % feedback) == 0))
-			{
-				std::cout << ".." << feedbackCounter << ".." << std::flush;
-				feedbackCounter = feedbackCounter + 10;
-			}
-			this->addVertex(*iterData);
-			++i;
+			this->bbox->expandToInclude(vertX[i], vertY[i]);
 		}
-		std::cout << " Complete.\n";
-		this->finaliseTriangulation();
 	}
 	
 	void RSGISDelaunayTriangulation::createDelaunayTriangulation(std::list<RSGIS2DPoint*> *data)
 	{
-		rsgis::math::RSGISMathsUtils mathsUtils;
-		int i = 0;
-		int feedback = data->size()/10;
-		int feedbackCounter = 0;
-		
 		std::cout << "Started (" << data->size() << " nodes)" << std::flush;
-		std::list<RSGIS2DPoint*>::iterator iterData;
-		for(iterData = data->begin(); iterData != data->end(); ++iterData)
+		std::vector<RSGIS2DPoint*> pts(data->begin(), data->end());
+		this->insertPoints(&pts);
+		std::cout << " Complete.\n";
+	}
+	
+	void RSGISDelaunayTriangulation::insertPoints(std::vector<RSGIS2DPoint*> *pts)
+	{
+		if(pts->empty())
+		{
+			return;
+		}
+		
+		// Insert the points in the order of a Hilbert curve so each point is close to the last.
+		double minX = pts->front()->getX();
+		double maxX = minX;
+		double minY = pts->front()->getY();
+		double maxY = minY;
+		std::vector< std::pair<unsigned long long, RSGIS2DPoint*> > order;
+		order.reserve(pts->size());
+		for(std::vector<RSGIS2DPoint*>::iterator iterPts = pts->begin(); iterPts != pts->end(); ++iterPts)
 		{
-			if((data->size() > 10) && ((i % feedback) == 0))
+			minX = std::min(minX, (*iterPts)->getX());
+			maxX = std::max(maxX, (*iterPts)->getX());
+			minY = std::min(minY, (*iterPts)->getY());
+			maxY = std::max(maxY, (*iterPts)->getY());
+		}
+		double scale = std::max(maxX - minX, maxY - minY);
+		scale = (scale > 0)?(65535.0 / scale):0;
+		for(std::vector<RSGIS2DPoint*>::iterator iterPts = pts->begin(); iterPts != pts->end(); ++iterPts)
+		{
+			unsigned int x = (unsigned int)(((*iterPts)->getX() - minX) * scale);
+			unsigned int y = (unsigned int)(((*iterPts)->getY() - minY) * scale);
+			order.push_back(std::pair<unsigned long long, RSGIS2DPoint*>(RSGISDelaunayTriangulation::hilbertIndex(x, y), *iterPts));
+		}
+		std::stable_sort(order.begin(), order.end(), [](const std::pair<unsigned long long, RSGIS2DPoint*> &a, const std::pair<unsigned long long, RSGIS2DPoint*> &b){return a.first < b.first;});
+		
+		this->vertices.reserve(this->vertices.size() + pts->size());
+		this->triangles.reserve(this->triangles.size() + (2 * pts->size()));
+		
+		size_t numPts = order.size();
+		size_t feedback = numPts/10;
+		int feedbackCounter = 0;
+		for(size_t i = 0; i < numPts; ++i)
+		{
+			if((numPts > 10) && ((i % feedback) == 0))
 			{
 				std::cout << ".." << feedbackCounter << ".." << std::flush;
 				feedbackCounter = feedbackCounter + 10;
 			}
-			this->addVertex(*iterData);
-			++i;
+			this->addVertex(order.at(i).second);
 		}
-		std::cout << " Complete.\n";
 	}
 	
 	void RSGISDelaunayTriangulation::addVertex(RSGIS2DPoint *pt)
 	{
-		RSGISGeometry geomUtils;
-		try
+		double x = pt->getX();
+		double y = pt->getY();
+		
+		long startTri = this->locateTriangle(x, y);
+		if(startTri < 0)
 		{
-			std::list<RSGISTriangle*>::iterator iterTriangles;
-			
-			std::list<RSGISTriangle*> *tmpTriangles = new std::list<RSGISTriangle*>();
-			
-			RSGISTriangle *tri = NULL;
-			bool foundTri = false;
-			bool duplicate = false;
-			
-			iterTriangles = triangleList->begin();
-			for(iterTriangles = triangleList->begin(); iterTriangles != triangleList->end(); )
+			// Outside of the bounding triangle.
+			return;
+		}
+		
+		// Find the cavity of triangles whose circumcircle contains the point. A 
+		// neighbour is also included if the point is not strictly in front of the 
+		// shared edge so the cavity is always star-shaped from the point.
+		++this->visitStamp;
+		this->cavity.clear();
+		this->cavity.push_back(startTri);
+		this->triVisited.at(startTri) = this->visitStamp;
+		for(size_t c = 0; c < this->cavity.size(); ++c)
+		{
+			RSGISDelaunayTri &tri = this->triangles[this->cavity[c]];
+			for(int i = 0; i < 3; ++i)
 			{
-				tri = *iterTriangles;
-				
-				if((pt->distance(tri->getPointA()) < 0.1) | 
-				   (pt->distance(tri->getPointB()) < 0.1) | 
-				   (pt->distance(tri->getPointC()) < 0.1))
-				{
-					foundTri = false;
-					duplicate = true;
-					break;
-				}
-				else if(tri->containedCircle(pt))
+				size_t vIdx = tri.v[i];
+				double dx = this->vertX[vIdx] - x;
+				double dy = this->vertY[vIdx] - y;
+				if(((dx*dx)+(dy*dy)) < 0.01)
 				{
-					foundTri = true;
-					tmpTriangles->push_back(tri);
-					triangleList->erase(iterTriangles++);
+					// The nearest vertex is always on the cavity boundary, so this is a duplicate.
+					return;
 				}
-				else 
-				{
-					++iterTriangles;
-				}
-			}
-						
-			if(foundTri)
-			{
-				std::list<RSGIS2DPoint*> *pts = this->getPtsClockwise(tmpTriangles, pt);
-				std::list<RSGIS2DPoint*>::iterator iterPTS;
-
-				bool first = true;
-				RSGIS2DPoint *tmpPt = NULL;
-				for(iterPTS = pts->begin(); iterPTS != pts->end(); ++iterPTS)
-				{
-					if(first)
-					{
-						first = false;
-						tmpPt = *iterPTS;
-					}
-					else
-					{
-						try
-						{
-							if(!geomUtils.straightLine(tmpPt, *iterPTS, pt))
-							{
-								triangleList->push_back(new RSGISTriangle(tmpPt, *iterPTS, pt));
-							}
-							tmpPt = *iterPTS;
-						}
-						catch(RSGISGeometryException &e)
-						{
-							throw e;
-						}
-					}
-				}
-				try
+				
+				long nb = tri.n[i];
+				if((nb >= 0) && (this->triVisited[nb] != this->visitStamp))
 				{
-					if(!geomUtils.straightLine(pts->front(), pts->back(), pt))
+					size_t e1 = tri.v[(i+1)%3];
+					size_t e2 = tri.v[(i+2)%3];
+					if(this->insideCircumcircle(nb, x, y) || (RSGISDelaunayTriangulation::orient(vertX[e1], vertY[e1], vertX[e2], vertY[e2], x, y) <= 0))
 					{
-						triangleList->push_back(new RSGISTriangle(pts->front(),  pts->back(), pt));
+						this->triVisited[nb] = this->visitStamp;
+						this->cavity.push_back(nb);
 					}
 				}
-				catch(RSGISGeometryException &e)
-				{
-					throw e;
-				}
-				delete pts;
 			}
-			else if(duplicate)
+		}
+		
+		// Collect the boundary of the cavity before the triangles are reused.
+		std::vector<RSGISDelaunayTri> boundary;
+		for(std::vector<size_t>::iterator iterCavity = this->cavity.begin(); iterCavity != this->cavity.end(); ++iterCavity)
+		{
+			RSGISDelaunayTri &tri = this->triangles[*iterCavity];
+			for(int i = 0; i < 3; ++i)
 			{
-				for(iterTriangles = tmpTriangles->begin(); iterTriangles != tmpTriangles->end(); )
+				long nb = tri.n[i];
+				if((nb < 0) || (this->triVisited[nb] != this->visitStamp))
 				{
-					triangleList->push_back(*iterTriangles);
-					tmpTriangles->erase(iterTriangles++);
+					RSGISDelaunayTri edge;
+					edge.v[0] = tri.v[(i+1)%3];
+					edge.v[1] = tri.v[(i+2)%3];
+					edge.n[0] = nb;
+					edge.n[1] = -1;
+					edge.n[2] = -1;
+					boundary.push_back(edge);
 				}
 			}
-			else
-			{
-				//throw RSGISGeometryException("Cannot find triangle for inserted point");
-			}
+		}
+		
+		size_t ptIdx = this->vertices.size();
+		this->vertices.push_back(pt);
+		this->vertX.push_back(x);
+		this->vertY.push_back(y);
+		this->excludedVertices.push_back(false);
+		
+		for(std::vector<size_t>::iterator iterCavity = this->cavity.begin(); iterCavity != this->cavity.end(); ++iterCavity)
+		{
+			this->triangles[*iterCavity].alive = false;
+			this->freeTriangles.push_back(*iterCavity);
+		}
+		
+		// Join each boundary edge to the new vertex.
+		this->edgeStarts.clear();
+		std::vector<size_t> newTris;
+		newTris.reserve(boundary.size());
+		for(std::vector<RSGISDelaunayTri>::iterator iterEdges = boundary.begin(); iterEdges != boundary.end(); ++iterEdges)
+		{
+			size_t tIdx = this->allocTriangle();
+			RSGISDelaunayTri &tri = this->triangles[tIdx];
+			tri.v[0] = (*iterEdges).v[0];
+			tri.v[1] = (*iterEdges).v[1];
+			tri.v[2] = ptIdx;
+			tri.n[0] = -1;
+			tri.n[1] = -1;
+			tri.n[2] = (*iterEdges).n[0];
+			tri.alive = true;
 			
-			for(iterTriangles = tmpTriangles->begin(); iterTriangles != tmpTriangles->end(); )
+			long nb = (*iterEdges).n[0];
+			if(nb >= 0)
 			{
-				delete *iterTriangles;
-				tmpTriangles->erase(iterTriangles++);
+				// Matched on the vertices as the cavity triangle indexes are being reused.
+				RSGISDelaunayTri &nbTri = this->triangles[nb];
+				for(int i = 0; i < 3; ++i)
+				{
+					if((nbTri.v[(i+1)%3] == tri.v[1]) && (nbTri.v[(i+2)%3] == tri.v[0]))
+					{
+						nbTri.n[i] = tIdx;
+					}
+				}
 			}
-			delete tmpTriangles;
+			this->edgeStarts[tri.v[0]] = tIdx;
+			newTris.push_back(tIdx);
 		}
-		catch(RSGISGeometryException &e)
+		
+		for(std::vector<size_t>::iterator iterTris = newTris.begin(); iterTris != newTris.end(); ++iterTris)
 		{
-			throw e;
+			RSGISDelaunayTri &tri = this->triangles[*iterTris];
+			std::unordered_map<size_t, size_t>::iterator iterNext = this->edgeStarts.find(tri.v[1]);
+			if(iterNext == this->edgeStarts.end())
+			{
+				throw RSGISGeometryException("The Delaunay cavity boundary is not closed.");
+			}
+			tri.n[0] = iterNext->second;
+			this->triangles[iterNext->second].n[1] = *iterTris;
 		}
+		
+		this->lastTri = newTris.back();
+		this->listDirty = true;
 	}
 	
-	void RSGISDelaunayTriangulation::finaliseTriangulation(std::list<RSGIS2DPoint*> *data)
+	long RSGISDelaunayTriangulation::locateTriangle(double x, double y)
 	{
-		std::list<RSGISTriangle*>::iterator iterTriangles;
-		std::list<RSGIS2DPoint*>::iterator iterPts;
-		RSGISTriangle *tri = NULL;
-		RSGIS2DPoint *pt = NULL;
-		geos::geom::Envelope *env = new geos::geom::Envelope();
-		bool found = false;
-		
-		for(iterTriangles = triangleList->begin(); iterTriangles != triangleList->end(); ++iterTriangles)
+		long tIdx = this->lastTri;
+		if((tIdx < 0) || (!this->triangles.at(tIdx).alive))
 		{
-			tri = *iterTriangles;
-			found = false;
-			
-			for(iterPts = data->begin(); iterPts != data->end(); iterPts++)
+			tIdx = -1;
+			for(size_t i = 0; i < this->triangles.size(); ++i)
 			{
-				pt = *iterPts;
-				if(tri->getPointA() == pt || 
-				   tri->getPointB() == pt ||
-				   tri->getPointC() == pt)
+				if(this->triangles[i].alive)
 				{
-					found = true;
+					tIdx = i;
 					break;
 				}
-				
-			}
-			
-			if(found)
-			{
-				delete tri;
-				triangleList->erase(iterTriangles);
 			}
-			else if(tri->getPointA() == this->aOuter || 
-			   tri->getPointB() == this->aOuter ||
-			   tri->getPointC() == this->aOuter)
+			if(tIdx < 0)
 			{
-				delete tri;
-				triangleList->erase(iterTriangles);
+				return -1;
 			}
-			else if(tri->getPointA() == this->bOuter || 
-					tri->getPointB() == this->bOuter ||
-					tri->getPointC() == this->bOuter)
+		}
+		
+		// Walk towards the point, starting the edge tests at a varying edge so the walk cannot cycle.
+		size_t maxSteps = this->triangles.size() + 3;
+		for(size_t step = 0; step < maxSteps; ++step)
+		{
+			RSGISDelaunayTri &tri = this->triangles[tIdx];
+			this->walkSeed = (this->walkSeed * 1103515245 + 12345) & 0x7FFFFFFF;
+			int start = this->walkSeed % 3;
+			bool moved = false;
+			for(int k = 0; k < 3; ++k)
 			{
-				delete tri;
-				triangleList->erase(iterTriangles);
+				int i = (start + k) % 3;
+				size_t e1 = tri.v[(i+1)%3];
+				size_t e2 = tri.v[(i+2)%3];
+				if(RSGISDelaunayTriangulation::orient(vertX[e1], vertY[e1], vertX[e2], vertY[e2], x, y) < 0)
+				{
+					if(tri.n[i] < 0)
+					{
+						return -1;
+					}
+					tIdx = tri.n[i];
+					moved = true;
+					break;
+				}
 			}
-			else if(tri->getPointA() == this->cOuter || 
-					tri->getPointB() == this->cOuter ||
-					tri->getPointC() == this->cOuter)
+			if(!moved)
 			{
-				delete tri;
-				triangleList->erase(iterTriangles);
+				return tIdx;
 			}
-			else
+		}
+		
+		// The walk failed (which should not happen), so search every triangle.
+		for(size_t t = 0; t < this->triangles.size(); ++t)
+		{
+			RSGISDelaunayTri &tri = this->triangles[t];
+			if(tri.alive &&
+			   (RSGISDelaunayTriangulation::orient(vertX[tri.v[0]], vertY[tri.v[0]], vertX[tri.v[1]], vertY[tri.v[1]], x, y) >= 0) &&
+			   (RSGISDelaunayTriangulation::orient(vertX[tri.v[1]], vertY[tri.v[1]], vertX[tri.v[2]], vertY[tri.v[2]], x, y) >= 0) &&
+			   (RSGISDelaunayTriangulation::orient(vertX[tri.v[2]], vertY[tri.v[2]], vertX[tri.v[0]], vertY[tri.v[0]], x, y) >= 0))
 			{
-				env->expandToInclude(tri->getBBox());
+				return t;
 			}
 		}
-		delete bbox;
-		bbox = env;
+		return -1;
 	}
 	
-	void RSGISDelaunayTriangulation::finaliseTriangulation()
+	bool RSGISDelaunayTriangulation::insideCircumcircle(size_t tri, double x, double y)
 	{
-		std::list<RSGISTriangle*>::iterator iterTriangles;
-		RSGISTriangle *tri = NULL;
-		geos::geom::Envelope *env = new geos::geom::Envelope();
+		// Computed relative to the point to reduce the rounding error.
+		const RSGISDelaunayTri &t = this->triangles[tri];
+		double adx = vertX[t.v[0]] - x;
+		double ady = vertY[t.v[0]] - y;
+		double bdx = vertX[t.v[1]] - x;
+		double bdy = vertY[t.v[1]] - y;
+		double cdx = vertX[t.v[2]] - x;
+		double cdy = vertY[t.v[2]] - y;
 		
-		for(iterTriangles = triangleList->begin(); iterTriangles != triangleList->end(); )
+		double det = ((adx*adx) + (ady*ady)) * ((bdx*cdy) - (cdx*bdy)) 
+		           + ((bdx*bdx) + (bdy*bdy)) * ((cdx*ady) - (adx*cdy)) 
+		           + ((cdx*cdx) + (cdy*cdy)) * ((adx*bdy) - (bdx*ady));
+		return det > 0;
+	}
+	
+	double RSGISDelaunayTriangulation::orient(double ax, double ay, double bx, double by, double cx, double cy)
+	{
+		return ((bx - ax) * (cy - ay)) - ((by - ay) * (cx - ax));
+	}
+	
+	unsigned long long RSGISDelaunayTriangulation::hilbertIndex(unsigned int x, unsigned int y)
+	{
+		unsigned long long d = 0;
+		for(unsigned int s = 1 << 15; s > 0; s = s >> 1)
 		{
-			tri = *iterTriangles;
-			if(tri->getPointA() == this->aOuter || 
-			   tri->getPointB() == this->aOuter ||
-			   tri->getPointC() == this->aOuter)
+			unsigned int rx = ((x & s) > 0)?1:0;
+			unsigned int ry = ((y & s) > 0)?1:0;
+			d += ((unsigned long long)s) * ((unsigned long long)s) * ((3 * rx) ^ ry);
+			if(ry == 0)
 			{
-				delete tri;
-				triangleList->erase(iterTriangles++);
-			}
-			else if(tri->getPointA() == this->bOuter || 
-					tri->getPointB() == this->bOuter ||
-					tri->getPointC() == this->bOuter)
-			{
-				delete tri;
-				triangleList->erase(iterTriangles++);
+				if(rx == 1)
+				{
+					x = s - 1 - x;
+					y = s - 1 - y;
+				}
+				unsigned int t = x;
+				x = y;
+				y = t;
 			}
-			else if(tri->getPointA() == this->cOuter || 
-					tri->getPointB() == this->cOuter ||
-					tri->getPointC() == this->cOuter)
+		}
+		return d;
+	}
+	
+	size_t RSGISDelaunayTriangulation::allocTriangle()
+	{
+		if(!this->freeTriangles.empty())
+		{
+			size_t tIdx = this->freeTriangles.back();
+			this->freeTriangles.pop_back();
+			return tIdx;
+		}
+		RSGISDelaunayTri tri;
+		tri.alive = false;
+		this->triangles.push_back(tri);
+		this->triVisited.push_back(0);
+		return this->triangles.size() - 1;
+	}
+	
+	void RSGISDelaunayTriangulation::finaliseTriangulation(std::list<RSGIS2DPoint*> *data)
+	{
+		std::unordered_map<RSGIS2DPoint*, bool> dataPts;
+		for(std::list<RSGIS2DPoint*>::iterator iterPts = data->begin(); iterPts != data->end(); ++iterPts)
+		{
+			dataPts[*iterPts] = true;
+		}
+		for(size_t i = 3; i < this->vertices.size(); ++i)
+		{
+			if(dataPts.count(this->vertices[i]) > 0)
 			{
-				delete tri;
-				triangleList->erase(iterTriangles++);
+				this->excludedVertices[i] = true;
 			}
-			else
+		}
+		this->finaliseTriangulation();
+	}
+	
+	void RSGISDelaunayTriangulation::finaliseTriangulation()
+	{
+		this->excludedVertices[0] = true;
+		this->excludedVertices[1] = true;
+		this->excludedVertices[2] = true;
+		
+		geos::geom::Envelope *env = new geos::geom::Envelope();
+		for(std::vector<RSGISDelaunayTri>::iterator iterTris = this->triangles.begin(); iterTris != this->triangles.end(); ++iterTris)
+		{
+			if((*iterTris).alive && !(excludedVertices[(*iterTris).v[0]] || excludedVertices[(*iterTris).v[1]] || excludedVertices[(*iterTris).v[2]]))
 			{
-				env->expandToInclude(tri->getBBox());
-				++iterTriangles;
+				for(int i = 0; i < 3; ++i)
+				{
+					env->expandToInclude(vertX[(*iterTris).v[i]], vertY[(*iterTris).v[i]]);
+				}
 			}
 		}
 		delete bbox;
 		bbox = env;
+		this->listDirty = true;
 	}
 	
 	std::list<RSGISTriangle*>* RSGISDelaunayTriangulation::getTriangulation()
 	{
-		return triangleList;
-	}
-	
-	std::list<RSGIS2DPoint*>* RSGISDelaunayTriangulation::getPtsClockwise(std::list<RSGISTriangle*> *tris, RSGIS2DPoint *pt)
-	{
-		RSGISGeometry geomUtils;
-		std::list<RSGIS2DPoint*> *pts = new std::list<RSGIS2DPoint*>();
-		std::list<RSGISTriangle*>::iterator iterTriangles;	
-		std::list<RSGIS2DPoint*>::iterator iterPTS;
-		RSGISTriangle *tri = NULL;
-		RSGIS2DPoint *tmpPt = NULL;
-		
-		double angleBaseListPt = 0;
-		double angleBaseIterPt = 0;
-		bool ptAdded = false;
-		
-		for(iterTriangles = tris->begin(); iterTriangles != tris->end(); ++iterTriangles)
+		if(this->listDirty)
 		{
-			tri = *iterTriangles;
-			for(int i = 0; i < 3; i++)
+			this->clearTriangleList();
+			for(std::vector<RSGISDelaunayTri>::iterator iterTris = this->triangles.begin(); iterTris != this->triangles.end(); ++iterTris)
 			{
-				if(i == 0)
+				if((*iterTris).alive && !(excludedVertices[(*iterTris).v[0]] || excludedVertices[(*iterTris).v[1]] || excludedVertices[(*iterTris).v[2]]))
 				{
-					// vertex a
-					tmpPt = tri->getPointA();
-				}
-				else if(i == 1)
-				{
-					// vertex b
-					tmpPt = tri->getPointB();
-				}
-				else if(i == 2)
-				{
-					// vertex c
-					tmpPt = tri->getPointC();
-				}
-				
-				if(pts->size() == 0)
-				{
-					pts->push_back(tmpPt);
-				}
-				else
-				{
-					angleBaseListPt = geomUtils.calcAngle(pt, tmpPt);
-					ptAdded = false;
-					for(iterPTS = pts->begin(); iterPTS != pts->end(); iterPTS++)
-					{
-						if(*iterPTS == tmpPt)
-						{
-							ptAdded = true;
-							break;
-						}
-						else
-						{
-							angleBaseIterPt = geomUtils.calcAngle(pt, *iterPTS);
-							if(angleBaseListPt < angleBaseIterPt)
-							{
-								pts->insert(iterPTS, tmpPt);
-								ptAdded = true;
-								break;
-							}
-						}
-					}
-					if(!ptAdded)
-					{
-						pts->push_back(tmpPt);
-					}
+					triangleList->push_back(new RSGISTriangle(vertices[(*iterTris).v[0]], vertices[(*iterTris).v[1]], vertices[(*iterTris).v[2]]));
 				}
 			}
-			
+			this->listDirty = false;
 		}
-		return pts;
+		return triangleList;
+	}
+	
+	void RSGISDelaunayTriangulation::clearTriangleList()
+	{
+		for(std::list<RSGISTriangle*>::iterator iterTriangles = triangleList->begin(); iterTriangles != triangleList->end(); ++iterTriangles)
+		{
+			delete *iterTriangles;
+		}
+		triangleList->clear();
 	}
 	
 	void RSGISDelaunayTriangulation::plotTriangulationAsEdges(std::string filename)
@@ -427,6 +489,7 @@ namespace rsgis{namespace geom{
 		std::list<geos::geom::LineSegment> *lines = new std::list<geos::geom::LineSegment>();
 		std::list<RSGISTriangle*>::iterator iterTriangles;
 		RSGISTriangle *tri = NULL;
+		this->getTriangulation();
 		for(iterTriangles = triangleList->begin(); iterTriangles != triangleList->end(); ++iterTriangles)
 		{
 			tri = *iterTriangles;
@@ -441,12 +504,7 @@ namespace rsgis{namespace geom{
 	
 	RSGISDelaunayTriangulation::~RSGISDelaunayTriangulation()
 	{
-		std::list<RSGISTriangle*>::iterator iterTriangles;
-		for(iterTriangles = triangleList->begin(); iterTriangles != triangleList->end(); )
-		{
-			delete *iterTriangles;
-			triangleList->erase(iterTriangles++);
-		}
+		this->clearTriangleList();
 		delete triangleList;
 		delete bbox;
 		delete aOuter;
@@ -454,4 +512,3 @@ namespace rsgis{namespace geom{
 		delete cOuter;
 	}
 }}
-
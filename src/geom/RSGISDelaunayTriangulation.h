@@ -26,6 +26,9 @@
 #include <string>
 #include <iostream>
 #include <list>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
 
 #include "geom/RSGIS2DPoint.h"
 #include "geom/RSGISGeometryException.h"
@@ -51,6 +54,27 @@
 
 namespace rsgis{namespace geom{
 	
+	/**
+	 * A triangle within the RSGISDelaunayTriangulation. The vertices are 
+	 * indexes into the vertex list, in counter-clockwise order, and n[i] is 
+	 * the triangle across the edge opposite vertex v[i] (-1 if none).
+	 */
+	struct DllExport RSGISDelaunayTri
+	{
+		size_t v[3];
+		long n[3];
+		bool alive;
+	};
+	
+	/**
+	 * Incremental (Bowyer-Watson) Delaunay triangulation. The triangles are held
+	 * in a contiguous array with their neighbours so the triangle containing a 
+	 * new vertex is found by walking from the last triangle created and only the
+	 * triangles whose circumcircle contains the vertex are visited. Bulk inserts
+	 * are sorted along a Hilbert curve so the walks are short, giving an expected 
+	 * O(n log n) triangulation. The list of RSGISTriangle objects returned by 
+	 * getTriangulation() is built on request and owned by this class.
+	 */
 	class DllExport RSGISDelaunayTriangulation
 		{
 		public:
@@ -67,18 +91,42 @@ namespace rsgis{namespace geom{
 			 *                   
 			 */
 			RSGISDelaunayTriangulation(RSGIS2DPoint *a, RSGIS2DPoint *b, RSGIS2DPoint *c);
+			/** Takes ownership of the triangle and its vertices. */
 			RSGISDelaunayTriangulation(RSGISTriangle *tri);
 			RSGISDelaunayTriangulation(std::list<RSGIS2DPoint*> *data);
 			RSGISDelaunayTriangulation(std::vector<RSGIS2DPoint*> *data);
 			void createDelaunayTriangulation(std::list<RSGIS2DPoint*> *data);
+			/** Inserts a vertex; vertices outside the bounding triangle or within 0.1 of an existing vertex are ignored. */
 			void addVertex(RSGIS2DPoint *pt);
+			/** Removes the triangles connected to the bounding triangle or to any of the points in data. */
 			void finaliseTriangulation(std::list<RSGIS2DPoint*> *data);
+			/** Removes the triangles connected to the bounding triangle. */
 			void finaliseTriangulation();
 			std::list<RSGISTriangle*>* getTriangulation();
 			void plotTriangulationAsEdges(std::string filename);
 			~RSGISDelaunayTriangulation();
 		protected:
-			std::list<RSGIS2DPoint*>* getPtsClockwise(std::list<RSGISTriangle*> *tris, RSGIS2DPoint *pt);
+			void initTriangulation(RSGIS2DPoint *a, RSGIS2DPoint *b, RSGIS2DPoint *c);
+			void insertPoints(std::vector<RSGIS2DPoint*> *pts);
+			long locateTriangle(double x, double y);
+			bool insideCircumcircle(size_t tri, double x, double y);
+			size_t allocTriangle();
+			void clearTriangleList();
+			static double orient(double ax, double ay, double bx, double by, double cx, double cy);
+			static unsigned long long hilbertIndex(unsigned int x, unsigned int y);
+			std::vector<RSGIS2DPoint*> vertices;
+			std::vector<double> vertX;
+			std::vector<double> vertY;
+			std::vector<bool> excludedVertices;
+			std::vector<RSGISDelaunayTri> triangles;
+			std::vector<size_t> freeTriangles;
+			std::vector<unsigned long> triVisited;
+			unsigned long visitStamp;
+			long lastTri;
+			unsigned long walkSeed;
+			std::vector<size_t> cavity;
+			std::unordered_map<size_t, size_t> edgeStarts;
+			bool listDirty;
 			std::list<RSGISTriangle*> *triangleList;
             geos::geom::Envelope *bbox;
 			RSGIS2DPoint *aOuter;
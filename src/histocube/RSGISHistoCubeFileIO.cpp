@@ -627,11 +627,12 @@ namespace rsgis {namespace histocube{
         
         try
         {
-            if(sRow >= eRow)
+            if(sRow > eRow)
             {
                 throw rsgis::RSGISHistoCubeException("The start row must be before the end row.");
             }
-            unsigned int nRows = eRow - sRow;
+            // The end row is inclusive.
+            unsigned int nRows = (eRow - sRow) + 1;
             
             std::string cubeLayerName = HC_DATASETNAME_DATA + "/" + name;
             H5::DataSet cubeLayerDataset = hcH5File->openDataSet( cubeLayerName );
@@ -657,6 +658,11 @@ namespace rsgis {namespace histocube{
                 throw rsgis::RSGISHistoCubeException("Data layer is not a full number of rows.");
             }
             
+            if(dataLen < (nRows * cubeLayerDIMS[1]))
+            {
+                throw rsgis::RSGISHistoCubeException("Data layer is smaller than the number of rows requested.");
+            }
+            
             // Set up dataspace for the 'data' array to read the data into
             hsize_t dataDims[2];
             dataDims[0] = nRows;
@@ -724,11 +730,12 @@ namespace rsgis {namespace histocube{
         
         try
         {
-            if(sRow >= eRow)
+            if(sRow > eRow)
             {
                 throw rsgis::RSGISHistoCubeException("The start row must be before the end row.");
             }
-            unsigned int nRows = eRow - sRow;
+            // The end row is inclusive.
+            unsigned int nRows = (eRow - sRow) + 1;
             
             std::string cubeLayerName = HC_DATASETNAME_DATA + "/" + name;
             H5::DataSet cubeLayerDataset = hcH5File->openDataSet( cubeLayerName );
@@ -754,6 +761,11 @@ namespace rsgis {namespace histocube{
                 throw rsgis::RSGISHistoCubeException("Data layer is not a full number of rows.");
             }
             
+            if(dataLen < (nRows * cubeLayerDIMS[1]))
+            {
+                throw rsgis::RSGISHistoCubeException("Data layer is smaller than the number of rows requested.");
+            }
+            
             // Set up dataspace for the 'data' array to read the data into
             hsize_t dataDims[2];
             dataDims[0] = nRows;
@@ -807,6 +819,43 @@ namespace rsgis {namespace histocube{
         }
     }
     
+    unsigned int RSGISHistoCubeFile::getChunkRows(std::string name)
+    {
+        if(!this->fileOpen)
+        {
+            throw rsgis::RSGISHistoCubeException("File was not open.");
+        }
+        
+        unsigned int chunkRows = 0;
+        try
+        {
+            std::string cubeLayerName = HC_DATASETNAME_DATA + "/" + name;
+            H5::DataSet cubeLayerDataset = hcH5File->openDataSet( cubeLayerName );
+            H5::DSetCreatPropList cubeLayerProps = cubeLayerDataset.getCreatePlist();
+            
+            if(cubeLayerProps.getLayout() == H5D_CHUNKED)
+            {
+                hsize_t chunkDims[2];
+                if(cubeLayerProps.getChunk(2, chunkDims) == 2)
+                {
+                    chunkRows = chunkDims[0];
+                }
+            }
+            cubeLayerProps.close();
+            cubeLayerDataset.close();
+        }
+        catch( H5::Exception &e )
+        {
+            throw rsgis::RSGISHistoCubeException(e.getCDetailMsg());
+        }
+        
+        if(chunkRows == 0)
+        {
+            chunkRows = HC_COMPRESS_CHUNK;
+        }
+        return chunkRows;
+    }
+    
     std::vector<RSGISHistCubeLayerMeta*>* RSGISHistoCubeFile::getCubeLayersList()
     {
         return this->cubeLayers;
@@ -115,6 +115,7 @@ namespace rsgis {namespace histocube{
         virtual void setHistoRow(std::string name, unsigned int row, unsigned int *data, unsigned int dataLen);
         virtual void getHistoRows(std::string name, unsigned int sRow, unsigned int eRow, unsigned int *data, unsigned int dataLen);
         virtual void setHistoRows(std::string name, unsigned int sRow, unsigned int eRow, unsigned int *data, unsigned int dataLen);
+        virtual unsigned int getChunkRows(std::string name);
         virtual std::vector<RSGISHistCubeLayerMeta*>* getCubeLayersList();
         virtual unsigned long getNumFeatures();
         virtual void closeFile();
@@ -32,14 +32,14 @@ namespace rsgis {namespace histocube{
         
     }
     
-    long RSGISHistoCubeUtils::getBinsIndex(int val, std::vector<int> bins)
+    long RSGISHistoCubeUtils::getBinsIndex(int val, const std::vector<int> &bins)
     {
         long idx = -1;
         try
         {
             long cIdx = 0;
             bool found = false;
-            for(std::vector<int>::iterator iterVal = bins.begin(); iterVal != bins.end(); ++iterVal)
+            for(std::vector<int>::const_iterator iterVal = bins.begin(); iterVal != bins.end(); ++iterVal)
             {
                 if((*iterVal) == val)
                 {
@@ -82,6 +82,48 @@ namespace rsgis {namespace histocube{
         
     }
     
+    
+    RSGISHistoCubeBinLUT::RSGISHistoCubeBinLUT(const std::vector<int> &bins)
+    {
+        this->directLUT = false;
+        this->minVal = 0;
+        this->maxVal = -1;
+        if(bins.empty())
+        {
+            return;
+        }
+        
+        this->minVal = *std::min_element(bins.begin(), bins.end());
+        this->maxVal = *std::max_element(bins.begin(), bins.end());
+        long range = (((long)this->maxVal) - this->minVal) + 1;
+        
+        // Direct look up unless the bins are very sparse over their range.
+        if(range <= std::max<long>(HC_MAX_DIRECT_BIN_LUT, bins.size() * 4))
+        {
+            this->directLUT = true;
+            this->lut.assign(range, -1);
+            // Iterate backwards so the first bin with a value is used (as getBinsIndex).
+            for(long i = bins.size()-1; i >= 0; --i)
+            {
+                this->lut[((long)bins[i]) - this->minVal] = i;
+            }
+        }
+        else
+        {
+            this->sortedBins.reserve(bins.size());
+            for(size_t i = 0; i < bins.size(); ++i)
+            {
+                this->sortedBins.push_back(std::pair<int, long>(bins[i], i));
+            }
+            std::sort(this->sortedBins.begin(), this->sortedBins.end());
+        }
+    }
+    
+    RSGISHistoCubeBinLUT::~RSGISHistoCubeBinLUT()
+    {
+        
+    }
+    
 }}
 
 
@@ -51,15 +51,53 @@
 
 namespace rsgis {namespace histocube{
     
+    static const long HC_MAX_DIRECT_BIN_LUT( 4194304 ); // 4194304
+    
     
     class DllExport RSGISHistoCubeUtils
     {
     public:
         RSGISHistoCubeUtils();
-        long getBinsIndex(int val, std::vector<int> bins);
+        long getBinsIndex(int val, const std::vector<int> &bins);
         ~RSGISHistoCubeUtils();
     };
     
+    /**
+     * Look up of the bin index for a value, built once for a layer so the bins 
+     * do not need to be searched for every pixel. Where the range of the bin values
+     * is small enough a direct look up table is used otherwise a binary search of the 
+     * sorted bin values. Gives the same result as RSGISHistoCubeUtils::getBinsIndex.
+     */
+    class DllExport RSGISHistoCubeBinLUT
+    {
+    public:
+        RSGISHistoCubeBinLUT(const std::vector<int> &bins);
+        long getBinIdx(int val) const
+        {
+            if(this->directLUT)
+            {
+                if((val < this->minVal) | (val > this->maxVal))
+                {
+                    return -1;
+                }
+                return this->lut[((long)val) - this->minVal];
+            }
+            std::vector< std::pair<int, long> >::const_iterator iterBin = std::lower_bound(this->sortedBins.begin(), this->sortedBins.end(), std::pair<int, long>(val, -1));
+            if((iterBin != this->sortedBins.end()) && (iterBin->first == val))
+            {
+                return iterBin->second;
+            }
+            return -1;
+        };
+        ~RSGISHistoCubeBinLUT();
+    protected:
+        bool directLUT;
+        int minVal;
+        int maxVal;
+        std::vector<long> lut;
+        std::vector< std::pair<int, long> > sortedBins;
+    };
+    
 }}
 
 #endif
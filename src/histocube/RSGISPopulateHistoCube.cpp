@@ -26,18 +26,79 @@
 namespace rsgis {namespace histocube{
     
     
-    RSGISPopHistoCubeLayerFromImgBand::RSGISPopHistoCubeLayerFromImgBand(RSGISHistoCubeFile *hcFile, std::string layerName, unsigned int bandIdx, unsigned int maxRow, float scale, float offset, std::vector<int> bins) : rsgis::img::RSGISCalcImageValue(0)
+    RSGISHistoCubeLayerUpdates::RSGISHistoCubeLayerUpdates(RSGISHistoCubeFile *hcFile, std::string layerName, unsigned int numRows, unsigned int numBins, size_t maxUpdates, std::mutex *fileMutex)
     {
         this->hcFile = hcFile;
         this->layerName = layerName;
+        this->numRows = numRows;
+        this->numBins = numBins;
+        this->maxUpdates = maxUpdates;
+        this->fileMutex = fileMutex;
+        
+        if(this->fileMutex != NULL)
+        {
+            std::lock_guard<std::mutex> lock(*this->fileMutex);
+            this->chunkRows = hcFile->getChunkRows(layerName);
+        }
+        else
+        {
+            this->chunkRows = hcFile->getChunkRows(layerName);
+        }
+        this->updates.reserve(std::min<size_t>(maxUpdates, 65536));
+    }
+    
+    void RSGISHistoCubeLayerUpdates::flushUpdates()
+    {
+        if(this->updates.empty())
+        {
+            return;
+        }
+        
+        // Sorting groups the updates by row and therefore by chunk.
+        std::sort(this->updates.begin(), this->updates.end());
+        
+        std::unique_lock<std::mutex> lock;
+        if(this->fileMutex != NULL)
+        {
+            lock = std::unique_lock<std::mutex>(*this->fileMutex);
+        }
+        
+        unsigned long chunkElems = ((unsigned long)this->chunkRows) * this->numBins;
+        std::vector<unsigned long>::iterator iterUpdate = this->updates.begin();
+        while(iterUpdate != this->updates.end())
+        {
+            unsigned long chunkIdx = (*iterUpdate) / chunkElems;
+            unsigned int sRow = chunkIdx * this->chunkRows;
+            unsigned int eRow = std::min<unsigned long>(((unsigned long)sRow) + this->chunkRows, this->numRows) - 1;
+            unsigned long chunkStart = ((unsigned long)sRow) * this->numBins;
+            unsigned int chunkLen = ((eRow - sRow) + 1) * this->numBins;
+            
+            this->chunkData.resize(chunkLen);
+            this->hcFile->getHistoRows(this->layerName, sRow, eRow, this->chunkData.data(), chunkLen);
+            for(; (iterUpdate != this->updates.end()) && (((*iterUpdate) / chunkElems) == chunkIdx); ++iterUpdate)
+            {
+                this->chunkData[(*iterUpdate) - chunkStart] += 1;
+            }
+            this->hcFile->setHistoRows(this->layerName, sRow, eRow, this->chunkData.data(), chunkLen);
+        }
+        this->updates.clear();
+    }
+    
+    RSGISHistoCubeLayerUpdates::~RSGISHistoCubeLayerUpdates()
+    {
+        
+    }
+    
+    
+    
+    RSGISPopHistoCubeLayerFromImgBand::RSGISPopHistoCubeLayerFromImgBand(RSGISHistoCubeFile *hcFile, std::string layerName, unsigned int bandIdx, unsigned int maxRow, float scale, float offset, std::vector<int> bins, std::mutex *fileMutex) : rsgis::img::RSGISCalcImageValue(0)
+    {
         this->bandIdx = bandIdx;
         this->maxRow = maxRow;
         this->scale = scale;
         this->offset = offset;
-        this->bins = bins;
-        this->hcUtils = RSGISHistoCubeUtils();
-        this->dataArrLen = bins.size();
-        this->dataArr = new unsigned int[this->dataArrLen];
+        this->binLUT = new RSGISHistoCubeBinLUT(bins);
+        this->layerUpdates = new RSGISHistoCubeLayerUpdates(hcFile, layerName, maxRow+1, bins.size(), HC_MAX_BUFFERED_UPDATES, fileMutex);
     }
     
     void RSGISPopHistoCubeLayerFromImgBand::calcImageValue(long *intBandValues, unsigned int numIntVals, float *floatBandValues, unsigned int numfloatVals) 
@@ -49,25 +110,33 @@ namespace rsgis {namespace histocube{
                 unsigned int row = intBandValues[0];
                 float bandVal = (floatBandValues[bandIdx] * scale) + offset;
                 int bandValInt = floor(bandVal + 0.5);
-                long idx = this->hcUtils.getBinsIndex(bandValInt, this->bins);
+                long idx = this->binLUT->getBinIdx(bandValInt);
                 
-                if((idx >= 0) | (idx < this->dataArrLen))
+                if(idx >= 0)
                 {
-                    this->hcFile->getHistoRow(this->layerName, row, this->dataArr, this->dataArrLen);
-                    this->dataArr[idx] = this->dataArr[idx] + 1;
-                    this->hcFile->setHistoRow(this->layerName, row, this->dataArr, this->dataArrLen);
+                    this->layerUpdates->addUpdate(row, idx);
                 }
             }
         }
+        catch(rsgis::RSGISHistoCubeException &e)
+        {
+            throw rsgis::img::RSGISImageCalcException(e.what());
+        }
         catch(rsgis::img::RSGISImageCalcException &e)
         {
             throw e;
         }
     }
     
+    void RSGISPopHistoCubeLayerFromImgBand::flushUpdates()
+    {
+        this->layerUpdates->flushUpdates();
+    }
+    
     RSGISPopHistoCubeLayerFromImgBand::~RSGISPopHistoCubeLayerFromImgBand()
     {
-        delete[] this->dataArr;
+        delete this->layerUpdates;
+        delete this->binLUT;
     }
     
     
@@ -78,12 +147,12 @@ namespace rsgis {namespace histocube{
         this->rowLen = bins.size();
         if((this->dataArrLen % this->rowLen) != 0)
         {
-            rsgis::RSGISHistoCubeException("The data array did not a multiple of the number of bins.");
+            throw rsgis::RSGISHistoCubeException("The data array did not a multiple of the number of bins.");
         }
         
-        if((this->dataArrLen / this->rowLen) != maxRow)
+        if((this->dataArrLen / this->rowLen) != (((unsigned long)maxRow)+1))
         {
-            rsgis::RSGISHistoCubeException("The data array is not the same length as the number of rows.");
+            throw rsgis::RSGISHistoCubeException("The data array is not the same length as the number of rows.");
         }
         
         this->dataArr = dataArr;
@@ -93,7 +162,7 @@ namespace rsgis {namespace histocube{
         this->scale = scale;
         this->offset = offset;
         this->bins = bins;
-        this->hcUtils = RSGISHistoCubeUtils();
+        this->binLUT = new RSGISHistoCubeBinLUT(bins);
     }
     
     void RSGISPopHistoCubeLayerFromImgBandInMem::calcImageValue(long *intBandValues, unsigned int numIntVals, float *floatBandValues, unsigned int numfloatVals) 
@@ -105,19 +174,12 @@ namespace rsgis {namespace histocube{
                 unsigned int row = intBandValues[0];
                 float bandVal = (floatBandValues[bandIdx] * scale) + offset;
                 int bandValInt = floor(bandVal + 0.5);
-                long binIdx = this->hcUtils.getBinsIndex(bandValInt, this->bins);
+                long binIdx = this->binLUT->getBinIdx(bandValInt);
                 
-                if((binIdx >= 0) | (binIdx < this->rowLen))
+                if(binIdx >= 0)
                 {
-                    if(row == 0)
-                    {
-                        this->dataArr[binIdx] = this->dataArr[binIdx] + 1;
-                    }
-                    else
-                    {
-                        unsigned long arrBinIdx = (row * this->rowLen) + binIdx;
-                        this->dataArr[arrBinIdx] = this->dataArr[arrBinIdx] + 1;
-                    }
+                    unsigned long arrBinIdx = (((unsigned long)row) * this->rowLen) + binIdx;
+                    this->dataArr[arrBinIdx] = this->dataArr[arrBinIdx] + 1;
                 }
             }
         }
@@ -129,7 +191,7 @@ namespace rsgis {namespace histocube{
     
     RSGISPopHistoCubeLayerFromImgBandInMem::~RSGISPopHistoCubeLayerFromImgBandInMem()
     {
-
+        delete this->binLUT;
     }
     
     
@@ -42,6 +42,8 @@
 #include <string>
 #include <iostream>
 #include <vector>
+#include <algorithm>
+#include <mutex>
 #include <math.h>
 
 #include "common/RSGISHistoCubeException.h"
@@ -54,11 +56,50 @@
 
 namespace rsgis {namespace histocube{
     
+    static const size_t HC_MAX_BUFFERED_UPDATES( 8388608 ); // 8388608
     
+    /**
+     * Buffers increments to the histograms of a cube layer in memory. When flushed 
+     * the increments are sorted and grouped by HDF5 chunk so each chunk which has 
+     * been updated is read, modified and written once. If a mutex is provided 
+     * it is locked while the file is accessed so a number of layers can be 
+     * accumulated in parallel.
+     */
+    class DllExport RSGISHistoCubeLayerUpdates
+    {
+    public:
+        RSGISHistoCubeLayerUpdates(RSGISHistoCubeFile *hcFile, std::string layerName, unsigned int numRows, unsigned int numBins, size_t maxUpdates=HC_MAX_BUFFERED_UPDATES, std::mutex *fileMutex=NULL);
+        void addUpdate(unsigned int row, unsigned int binIdx)
+        {
+            this->updates.push_back((((unsigned long)row) * this->numBins) + binIdx);
+            if(this->updates.size() >= this->maxUpdates)
+            {
+                this->flushUpdates();
+            }
+        };
+        void flushUpdates();
+        ~RSGISHistoCubeLayerUpdates();
+    protected:
+        RSGISHistoCubeFile *hcFile;
+        std::string layerName;
+        unsigned int numRows;
+        unsigned int numBins;
+        unsigned int chunkRows;
+        size_t maxUpdates;
+        std::mutex *fileMutex;
+        std::vector<unsigned long> updates;
+        std::vector<unsigned int> chunkData;
+    };
+    
+    /**
+     * Populates a cube layer from an image band, the updates are buffered and 
+     * written in chunks; flushUpdates() must be called once the image has been 
+     * processed.
+     */
     class DllExport RSGISPopHistoCubeLayerFromImgBand : public rsgis::img::RSGISCalcImageValue
     {
     public:
-        RSGISPopHistoCubeLayerFromImgBand(RSGISHistoCubeFile *hcFile, std::string layerName, unsigned int bandIdx, unsigned int maxRow, float scale, float offset, std::vector<int> bins);
+        RSGISPopHistoCubeLayerFromImgBand(RSGISHistoCubeFile *hcFile, std::string layerName, unsigned int bandIdx, unsigned int maxRow, float scale, float offset, std::vector<int> bins, std::mutex *fileMutex=NULL);
         void calcImageValue(float *bandValues, int numBands, double *output) {throw rsgis::img::RSGISImageCalcException("Not implemented");};
         void calcImageValue(float *bandValues, int numBands) {throw rsgis::img::RSGISImageCalcException("No implemented");};
         void calcImageValue(long *intBandValues, unsigned int numIntVals, float *floatBandValues, unsigned int numfloatVals);
@@ -69,18 +110,15 @@ namespace rsgis {namespace histocube{
         void calcImageValue(float ***dataBlock, int numBands, int winSize, double *output) {throw rsgis::img::RSGISImageCalcException("No implemented");};
         void calcImageValue(float ***dataBlock, int numBands, int winSize, double *output, geos::geom::Envelope extent) {throw rsgis::img::RSGISImageCalcException("No implemented");};
         bool calcImageValueCondition(float ***dataBlock, int numBands, int winSize, double *output) {throw rsgis::img::RSGISImageCalcException("No implemented");};
+        void flushUpdates();
         ~RSGISPopHistoCubeLayerFromImgBand();
     protected:
-        RSGISHistoCubeFile *hcFile;
-        std::string layerName;
         unsigned int bandIdx;
         unsigned int maxRow;
         float scale;
         float offset;
-        std::vector<int> bins;
-        RSGISHistoCubeUtils hcUtils;
-        unsigned int *dataArr;
-        unsigned int dataArrLen;
+        RSGISHistoCubeBinLUT *binLUT;
+        RSGISHistoCubeLayerUpdates *layerUpdates;
     };
     
     class DllExport RSGISPopHistoCubeLayerFromImgBandInMem : public rsgis::img::RSGISCalcImageValue
@@ -105,7 +143,7 @@ namespace rsgis {namespace histocube{
         float scale;
         float offset;
         std::vector<int> bins;
-        RSGISHistoCubeUtils hcUtils;
+        RSGISHistoCubeBinLUT *binLUT;
         unsigned int *dataArr;
         unsigned long dataArrLen;
         unsigned int rowLen;
@@ -0,0 +1,97 @@
+/*
+ *  RSGISBitPackedImage.h
+ *  RSGIS_LIB
+ *
+ *  Created by agent on 19/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISBitPackedImage_H
+#define RSGISBitPackedImage_H
+
+#include <iostream>
+#include <string>
+
+#include "common/RSGISImageException.h"
+
+namespace rsgis{namespace img{
+
+    /**
+     * An in-memory single band image of small unsigned values (e.g., flags or class
+     * codes) using 1, 2, 4, 8 or 16 bits per pixel. All the values are initialised to 0.
+     * Each row starts on a new 64 bit word so different threads can set the values
+     * of different rows at the same time.
+     */
+    class RSGISBitPackedImage
+    {
+    public:
+        RSGISBitPackedImage(unsigned int width, unsigned int height, unsigned int bitsPerPxl)
+        {
+            if((bitsPerPxl != 1) && (bitsPerPxl != 2) && (bitsPerPxl != 4) && (bitsPerPxl != 8) && (bitsPerPxl != 16))
+            {
+                throw RSGISImageException("The number of bits per pixel must be 1, 2, 4, 8 or 16.");
+            }
+            this->width = width;
+            this->height = height;
+            this->bitsPerPxl = bitsPerPxl;
+            this->pxlsPerWord = 64 / bitsPerPxl;
+            this->valMask = (1ULL << bitsPerPxl) - 1;
+            this->rowWords = (((size_t)width) + this->pxlsPerWord - 1) / this->pxlsPerWord;
+            size_t numWords = this->rowWords * height;
+            this->data = new unsigned long long[numWords];
+            for(size_t i = 0; i < numWords; ++i)
+            {
+                this->data[i] = 0;
+            }
+        };
+        unsigned int getWidth(){return this->width;};
+        unsigned int getHeight(){return this->height;};
+        unsigned int getBitsPerPxl(){return this->bitsPerPxl;};
+        /** The maximum value which can be stored. */
+        unsigned int getMaxValue(){return (unsigned int)this->valMask;};
+        inline unsigned int getValue(unsigned int x, unsigned int y) const
+        {
+            size_t wordIdx = (((size_t)y) * this->rowWords) + (x / this->pxlsPerWord);
+            unsigned int shift = (x % this->pxlsPerWord) * this->bitsPerPxl;
+            return (unsigned int)((this->data[wordIdx] >> shift) & this->valMask);
+        };
+        /** Sets the value of the pixel; only the lowest bitsPerPxl bits of val are kept. */
+        inline void setValue(unsigned int x, unsigned int y, unsigned int val)
+        {
+            size_t wordIdx = (((size_t)y) * this->rowWords) + (x / this->pxlsPerWord);
+            unsigned int shift = (x % this->pxlsPerWord) * this->bitsPerPxl;
+            this->data[wordIdx] = (this->data[wordIdx] & ~(this->valMask << shift)) | ((((unsigned long long)val) & this->valMask) << shift);
+        };
+        ~RSGISBitPackedImage()
+        {
+            delete[] this->data;
+        };
+    private:
+        RSGISBitPackedImage(const RSGISBitPackedImage &img);
+        RSGISBitPackedImage& operator=(const RSGISBitPackedImage &img);
+        unsigned int width;
+        unsigned int height;
+        unsigned int bitsPerPxl;
+        unsigned int pxlsPerWord;
+        unsigned long long valMask;
+        size_t rowWords;
+        unsigned long long *data;
+    };
+
+}}
+
+#endif
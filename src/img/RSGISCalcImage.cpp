@@ -24,17 +24,28 @@
 
 namespace rsgis{namespace img{
 	
-	RSGISCalcImage::RSGISCalcImage(RSGISCalcImageValue *valueCalc, std::string proj, bool useImageProj)
+    /** Records the size of the GDAL block cache (GDAL does not report the cache hits). */
+    static void recordGDALCacheUsage()
+    {
+        rsgis::RSGISInstrumentation *instrumentation = rsgis::RSGISInstrumentation::getInstance();
+        instrumentation->setGaugeMax("gdal_cache_used_bytes_max", (double)GDALGetCacheUsed64());
+        instrumentation->setGauge("gdal_cache_max_bytes", (double)GDALGetCacheMax64());
+    }
+    
+	RSGISCalcImage::RSGISCalcImage(RSGISCalcImageValue *valueCalc, std::string proj, bool useImageProj, RSGISImageIOPolicy *ioPolicy)
 	{
 		this->calc = valueCalc;
 		this->numOutBands = valueCalc->getNumOutBands();
 		this->proj = proj;
 		this->useImageProj = useImageProj;
+		this->ioPolicy = (ioPolicy == NULL)?RSGISImageIOPolicy::getDefaultPolicy():ioPolicy;
 	}
     
     
     void RSGISCalcImage::calcImage(GDALDataset **datasets, int numDS, std::string outputImage, bool setOutNames, std::string *bandNames, std::string gdalFormat, GDALDataType gdalDataType)
     {
+        rsgis::RSGISProgressReporter progress("RSGISCalcImage::calcImage");
+        RSGISImageIOScope ioScope(this->ioPolicy);
         GDALAllRegister();
 		RSGISImageUtils imgUtils;
 		double *gdalTranslation = new double[6];
@@ -79,7 +90,7 @@ namespace rsgis{namespace img{
 			}
 			std::cout << "New image width = " << width << " height = " << height << " bands = " << this->numOutBands << std::endl;
 			
-			outputImageDS = gdalDriver->Create(outputImage.c_str(), width, height, this->numOutBands, gdalDataType, NULL);
+			outputImageDS = this->ioPolicy->createImage(gdalDriver, outputImage, width, height, this->numOutBands, gdalDataType);
 			
 			if(outputImageDS == NULL)
 			{
@@ -152,13 +163,14 @@ namespace rsgis{namespace img{
 			int feedback = height/10.0;
 			int feedbackCounter = 0;
 			std::cout << "Started " << std::flush;
+			progress.start(((unsigned long long)width) * height);
 			// Loop images to process data
 			for(int i = 0; i < nYBlocks; i++)
 			{
 				for(int n = 0; n < numInBands; n++)
 				{
                     rowOffset = bandOffsets[n][1] + (yBlockSize * i);
-					inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, yBlockSize, inputData[n], width, yBlockSize, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, yBlockSize, inputData[n], width, yBlockSize, GDT_Float32, 0, 0);
 				}
                 
                 for(int m = 0; m < yBlockSize; ++m)
@@ -166,6 +178,7 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && (((i*yBlockSize)+m) % feedback) == 0)
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -190,7 +203,7 @@ namespace rsgis{namespace img{
 				for(int n = 0; n < this->numOutBands; n++)
 				{
                     rowOffset = yBlockSize * i;
-					outputRasterBands[n]->RasterIO(GF_Write, 0, rowOffset, width, yBlockSize, outputData[n], width, yBlockSize, GDT_Float64, 0, 0);
+					instrumentedRasterIO(outputRasterBands[n], GF_Write, 0, rowOffset, width, yBlockSize, outputData[n], width, yBlockSize, GDT_Float64, 0, 0);
 				}
 			}
             
@@ -199,7 +212,7 @@ namespace rsgis{namespace img{
                 for(int n = 0; n < numInBands; n++)
 				{
                     rowOffset = bandOffsets[n][1] + (yBlockSize * nYBlocks);
-					inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputData[n], width, remainRows, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputData[n], width, remainRows, GDT_Float32, 0, 0);
 				}
                                 
                 for(int m = 0; m < remainRows; ++m)
@@ -207,6 +220,7 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && ((((nYBlocks*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -230,10 +244,12 @@ namespace rsgis{namespace img{
 				for(int n = 0; n < this->numOutBands; n++)
 				{
                     rowOffset = (yBlockSize * nYBlocks);
-					outputRasterBands[n]->RasterIO(GF_Write, 0, rowOffset, width, remainRows, outputData[n], width, remainRows, GDT_Float64, 0, 0);
+					instrumentedRasterIO(outputRasterBands[n], GF_Write, 0, rowOffset, width, remainRows, outputData[n], width, remainRows, GDT_Float64, 0, 0);
 				}
             }
 			std::cout << " Complete.\n";
+			recordGDALCacheUsage();
+			progress.complete();
 		}
 		catch(RSGISImageCalcException& e)
 		{
@@ -388,6 +404,7 @@ namespace rsgis{namespace img{
 			throw e;
 		}
 		
+		this->ioPolicy->finaliseImage(outputImageDS);
 		GDALClose(outputImageDS);
 		
 		if(gdalTranslation != NULL)
@@ -468,6 +485,8 @@ namespace rsgis{namespace img{
     
     void RSGISCalcImage::calcImage(GDALDataset **datasets, int numDS, std::string outputImage, std::string outputRefIntImage, std::string gdalFormat, GDALDataType gdalDataType)
     {
+        rsgis::RSGISProgressReporter progress("RSGISCalcImage::calcImage");
+        RSGISImageIOScope ioScope(this->ioPolicy);
         GDALAllRegister();
         RSGISImageUtils imgUtils;
         double *gdalTranslation = new double[6];
@@ -516,7 +535,7 @@ namespace rsgis{namespace img{
             }
             std::cout << "New image width = " << width << " height = " << height << " bands = " << this->numOutBands << std::endl;
             
-            outputImageDS = gdalDriver->Create(outputImage.c_str(), width, height, this->numOutBands, gdalDataType, NULL);
+            outputImageDS = this->ioPolicy->createImage(gdalDriver, outputImage, width, height, this->numOutBands, gdalDataType);
             if(outputImageDS == NULL)
             {
                 throw RSGISImageBandException("Output image could not be created. Check filepath.");
@@ -531,7 +550,7 @@ namespace rsgis{namespace img{
                 outputImageDS->SetProjection(proj.c_str());
             }
             
-            outputRefImageDS = gdalDriver->Create(outputRefIntImage.c_str(), width, height, 1, GDT_UInt32, NULL);
+            outputRefImageDS = this->ioPolicy->createImage(gdalDriver, outputRefIntImage, width, height, 1, GDT_UInt32);
             if(outputRefImageDS == NULL)
             {
                 throw RSGISImageBandException("Output reference image could not be created. Check filepath.");
@@ -602,13 +621,14 @@ namespace rsgis{namespace img{
             int feedback = height/10.0;
             int feedbackCounter = 0;
             std::cout << "Started " << std::flush;
+            progress.start(((unsigned long long)width) * height);
             // Loop images to process data
             for(int i = 0; i < nYBlocks; i++)
             {
                 for(int n = 0; n < numInBands; n++)
                 {
                     rowOffset = bandOffsets[n][1] + (yBlockSize * i);
-                    inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, yBlockSize, inputData[n], width, yBlockSize, GDT_Float32, 0, 0);
+                    instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, yBlockSize, inputData[n], width, yBlockSize, GDT_Float32, 0, 0);
                 }
                 
                 for(int m = 0; m < yBlockSize; ++m)
@@ -616,6 +636,7 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && (((i*yBlockSize)+m) % feedback) == 0)
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -640,9 +661,9 @@ namespace rsgis{namespace img{
                 rowOffset = yBlockSize * i;
                 for(int n = 0; n < this->numOutBands; n++)
                 {
-                    outputRasterBands[n]->RasterIO(GF_Write, 0, rowOffset, width, yBlockSize, outputData[n], width, yBlockSize, GDT_Float64, 0, 0);
+                    instrumentedRasterIO(outputRasterBands[n], GF_Write, 0, rowOffset, width, yBlockSize, outputData[n], width, yBlockSize, GDT_Float64, 0, 0);
                 }
-                outputRefRasterBand->RasterIO(GF_Write, 0, rowOffset, width, yBlockSize, outputRefData, width, yBlockSize, GDT_Float64, 0, 0);
+                instrumentedRasterIO(outputRefRasterBand, GF_Write, 0, rowOffset, width, yBlockSize, outputRefData, width, yBlockSize, GDT_Float64, 0, 0);
             }
             
             if(remainRows > 0)
@@ -650,7 +671,7 @@ namespace rsgis{namespace img{
                 for(int n = 0; n < numInBands; n++)
                 {
                     rowOffset = bandOffsets[n][1] + (yBlockSize * nYBlocks);
-                    inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputData[n], width, remainRows, GDT_Float32, 0, 0);
+                    instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputData[n], width, remainRows, GDT_Float32, 0, 0);
                 }
                 
                 for(int m = 0; m < remainRows; ++m)
@@ -658,6 +679,7 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && ((((nYBlocks*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -681,11 +703,13 @@ namespace rsgis{namespace img{
                 for(int n = 0; n < this->numOutBands; n++)
                 {
                     rowOffset = (yBlockSize * nYBlocks);
-                    outputRasterBands[n]->RasterIO(GF_Write, 0, rowOffset, width, remainRows, outputData[n], width, remainRows, GDT_Float64, 0, 0);
+                    instrumentedRasterIO(outputRasterBands[n], GF_Write, 0, rowOffset, width, remainRows, outputData[n], width, remainRows, GDT_Float64, 0, 0);
                 }
-                outputRefRasterBand->RasterIO(GF_Write, 0, rowOffset, width, remainRows, outputRefData, width, remainRows, GDT_Float64, 0, 0);
+                instrumentedRasterIO(outputRefRasterBand, GF_Write, 0, rowOffset, width, remainRows, outputRefData, width, remainRows, GDT_Float64, 0, 0);
             }
             std::cout << " Complete.\n";
+            recordGDALCacheUsage();
+            progress.complete();
         }
         catch(RSGISImageCalcException& e)
         {
@@ -850,7 +874,9 @@ namespace rsgis{namespace img{
             throw e;
         }
         
+        this->ioPolicy->finaliseImage(outputImageDS);
         GDALClose(outputImageDS);
+        this->ioPolicy->finaliseImage(outputRefImageDS);
         GDALClose(outputRefImageDS);
         
         if(gdalTranslation != NULL)
@@ -939,6 +965,8 @@ namespace rsgis{namespace img{
     
     void RSGISCalcImage::calcImage(GDALDataset **datasets, int numDS, GDALDataset *outputImageDS)
 	{
+		rsgis::RSGISProgressReporter progress("RSGISCalcImage::calcImage");
+		RSGISImageIOScope ioScope(this->ioPolicy);
 		GDALAllRegister();
 		RSGISImageUtils imgUtils;
 		double *gdalTranslation = new double[6];
@@ -1042,13 +1070,14 @@ namespace rsgis{namespace img{
 			int feedback = height/10;
 			int feedbackCounter = 0;
 			std::cout << "Started " << std::flush;
+			progress.start(((unsigned long long)width) * height);
 			// Loop images to process data
 			for(int i = 0; i < nYBlocks; i++)
 			{
 				for(int n = 0; n < numInBands; n++)
 				{
                     rowOffset = bandOffsets[n][1] + (yBlockSize * i);
-					inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, yBlockSize, inputData[n], width, yBlockSize, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, yBlockSize, inputData[n], width, yBlockSize, GDT_Float32, 0, 0);
 				}
                 
                 for(int m = 0; m < yBlockSize; ++m)
@@ -1056,6 +1085,7 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && ((((i*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -1080,7 +1110,7 @@ namespace rsgis{namespace img{
 				for(int n = 0; n < this->numOutBands; n++)
 				{
                     rowOffset = yBlockSize * i;
-					outputRasterBands[n]->RasterIO(GF_Write, 0, rowOffset, width, yBlockSize, outputData[n], width, yBlockSize, GDT_Float64, 0, 0);
+					instrumentedRasterIO(outputRasterBands[n], GF_Write, 0, rowOffset, width, yBlockSize, outputData[n], width, yBlockSize, GDT_Float64, 0, 0);
 				}
 			}
             
@@ -1089,7 +1119,7 @@ namespace rsgis{namespace img{
                 for(int n = 0; n < numInBands; n++)
 				{
                     rowOffset = bandOffsets[n][1] + (yBlockSize * nYBlocks);
-					inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputData[n], width, remainRows, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputData[n], width, remainRows, GDT_Float32, 0, 0);
 				}
                 
                 for(int m = 0; m < remainRows; ++m)
@@ -1097,6 +1127,7 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && ((((nYBlocks*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -1120,10 +1151,12 @@ namespace rsgis{namespace img{
 				for(int n = 0; n < this->numOutBands; n++)
 				{
                     rowOffset = (yBlockSize * nYBlocks);
-					outputRasterBands[n]->RasterIO(GF_Write, 0, rowOffset, width, remainRows, outputData[n], width, remainRows, GDT_Float64, 0, 0);
+					instrumentedRasterIO(outputRasterBands[n], GF_Write, 0, rowOffset, width, remainRows, outputData[n], width, remainRows, GDT_Float64, 0, 0);
 				}
             }
 			std::cout << " Complete.\n";
+			recordGDALCacheUsage();
+			progress.complete();
 		}
 		catch(RSGISImageCalcException& e)
 		{			
@@ -1354,6 +1387,8 @@ namespace rsgis{namespace img{
     
     void RSGISCalcImage::calcImagePartialOutput(GDALDataset **datasets, int numDS, GDALDataset *outputImageDS)
     {
+        rsgis::RSGISProgressReporter progress("RSGISCalcImage::calcImagePartialOutput");
+        RSGISImageIOScope ioScope(this->ioPolicy);
         GDALAllRegister();
         RSGISImageUtils imgUtils;
         double *gdalTranslation = new double[6];
@@ -1455,13 +1490,14 @@ namespace rsgis{namespace img{
             int feedback = height/10;
             int feedbackCounter = 0;
             std::cout << "Started " << std::flush;
+            progress.start(((unsigned long long)width) * height);
             // Loop images to process data
             for(int i = 0; i < nYBlocks; i++)
             {
                 for(int n = 0; n < numInBands; n++)
                 {
                     rowOffset = bandOffsets[n][1] + (yBlockSize * i);
-                    inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, yBlockSize, inputData[n], width, yBlockSize, GDT_Float32, 0, 0);
+                    instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, yBlockSize, inputData[n], width, yBlockSize, GDT_Float32, 0, 0);
                 }
                 
                 for(int m = 0; m < yBlockSize; ++m)
@@ -1469,6 +1505,7 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && ((((i*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -1493,7 +1530,7 @@ namespace rsgis{namespace img{
                 for(int n = 0; n < this->numOutBands; n++)
                 {
                     rowOffset = outYOffset + (yBlockSize * i);
-                    outputRasterBands[n]->RasterIO(GF_Write, outXOffset, rowOffset, width, yBlockSize, outputData[n], width, yBlockSize, GDT_Float64, 0, 0);
+                    instrumentedRasterIO(outputRasterBands[n], GF_Write, outXOffset, rowOffset, width, yBlockSize, outputData[n], width, yBlockSize, GDT_Float64, 0, 0);
                 }
             }
             
@@ -1502,7 +1539,7 @@ namespace rsgis{namespace img{
                 for(int n = 0; n < numInBands; n++)
                 {
                     rowOffset = bandOffsets[n][1] + (yBlockSize * nYBlocks);
-                    inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputData[n], width, remainRows, GDT_Float32, 0, 0);
+                    instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputData[n], width, remainRows, GDT_Float32, 0, 0);
                 }
                 
                 for(int m = 0; m < remainRows; ++m)
@@ -1510,6 +1547,7 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && ((((nYBlocks*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -1533,10 +1571,12 @@ namespace rsgis{namespace img{
                 for(int n = 0; n < this->numOutBands; n++)
                 {
                     rowOffset = outYOffset + (yBlockSize * nYBlocks);
-                    outputRasterBands[n]->RasterIO(GF_Write, outXOffset, rowOffset, width, remainRows, outputData[n], width, remainRows, GDT_Float64, 0, 0);
+                    instrumentedRasterIO(outputRasterBands[n], GF_Write, outXOffset, rowOffset, width, remainRows, outputData[n], width, remainRows, GDT_Float64, 0, 0);
                 }
             }
             std::cout << " Complete.\n";
+            recordGDALCacheUsage();
+            progress.complete();
         }
         catch(RSGISImageCalcException& e)
         {
@@ -1767,6 +1807,8 @@ namespace rsgis{namespace img{
     
     void RSGISCalcImage::calcImage(GDALDataset **datasets, int numIntDS, int numFloatDS, std::string outputImage, bool setOutNames, std::string *bandNames , std::string gdalFormat, GDALDataType gdalDataType)
     {
+        rsgis::RSGISProgressReporter progress("RSGISCalcImage::calcImage");
+        RSGISImageIOScope ioScope(this->ioPolicy);
         GDALAllRegister();
 		RSGISImageUtils imgUtils;
         int numDS = numIntDS + numFloatDS;
@@ -1825,7 +1867,7 @@ namespace rsgis{namespace img{
 			}
 			std::cout << "New image width = " << width << " height = " << height << " bands = " << this->numOutBands << std::endl;
 			
-			outputImageDS = gdalDriver->Create(outputImage.c_str(), width, height, this->numOutBands, gdalDataType, NULL);
+			outputImageDS = this->ioPolicy->createImage(gdalDriver, outputImage, width, height, this->numOutBands, gdalDataType);
 			
 			if(outputImageDS == NULL)
 			{
@@ -1922,19 +1964,20 @@ namespace rsgis{namespace img{
 			int feedback = height/10;
 			int feedbackCounter = 0;
 			std::cout << "Started " << std::flush;
+			progress.start(((unsigned long long)width) * height);
 			// Loop images to process data
 			for(int i = 0; i < nYBlocks; i++)
 			{
 				for(int n = 0; n < numIntBands; n++)
 				{
                     rowOffset = bandIntOffsets[n][1] + (yBlockSize * i);
-					inputRasterIntBands[n]->RasterIO(GF_Read, bandIntOffsets[n][0], rowOffset, width, yBlockSize, inputIntData[n], width, yBlockSize, GDT_UInt32, 0, 0);
+					instrumentedRasterIO(inputRasterIntBands[n], GF_Read, bandIntOffsets[n][0], rowOffset, width, yBlockSize, inputIntData[n], width, yBlockSize, GDT_UInt32, 0, 0);
 				}
                 
                 for(int n = 0; n < numFloatBands; n++)
 				{
                     rowOffset = bandFloatOffsets[n][1] + (yBlockSize * i);
-					inputRasterFloatBands[n]->RasterIO(GF_Read, bandFloatOffsets[n][0], rowOffset, width, yBlockSize, inputFloatData[n], width, yBlockSize, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterFloatBands[n], GF_Read, bandFloatOffsets[n][0], rowOffset, width, yBlockSize, inputFloatData[n], width, yBlockSize, GDT_Float32, 0, 0);
 				}
                 
                 for(int m = 0; m < yBlockSize; ++m)
@@ -1942,6 +1985,7 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && ((((i*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -1970,7 +2014,7 @@ namespace rsgis{namespace img{
                 for(int n = 0; n < this->numOutBands; n++)
 				{
                     rowOffset = yBlockSize * i;
-					outputRasterBands[n]->RasterIO(GF_Write, 0, rowOffset, width, yBlockSize, outputData[n], width, yBlockSize, GDT_Float64, 0, 0);
+					instrumentedRasterIO(outputRasterBands[n], GF_Write, 0, rowOffset, width, yBlockSize, outputData[n], width, yBlockSize, GDT_Float64, 0, 0);
 				}
 			}
             
@@ -1979,13 +2023,13 @@ namespace rsgis{namespace img{
                 for(int n = 0; n < numIntBands; n++)
 				{
                     rowOffset = bandIntOffsets[n][1] + (yBlockSize * nYBlocks);
-					inputRasterIntBands[n]->RasterIO(GF_Read, bandIntOffsets[n][0], rowOffset, width, remainRows, inputIntData[n], width, remainRows, GDT_UInt32, 0, 0);
+					instrumentedRasterIO(inputRasterIntBands[n], GF_Read, bandIntOffsets[n][0], rowOffset, width, remainRows, inputIntData[n], width, remainRows, GDT_UInt32, 0, 0);
 				}
                 
                 for(int n = 0; n < numFloatBands; n++)
 				{
                     rowOffset = bandFloatOffsets[n][1] + (yBlockSize * nYBlocks);
-					inputRasterFloatBands[n]->RasterIO(GF_Read, bandFloatOffsets[n][0], rowOffset, width, remainRows, inputFloatData[n], width, remainRows, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterFloatBands[n], GF_Read, bandFloatOffsets[n][0], rowOffset, width, remainRows, inputFloatData[n], width, remainRows, GDT_Float32, 0, 0);
 				}
                 
                 for(int m = 0; m < remainRows; ++m)
@@ -1993,6 +2037,7 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && ((((nYBlocks*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -2019,11 +2064,13 @@ namespace rsgis{namespace img{
                     for(int n = 0; n < this->numOutBands; n++)
                     {
                         rowOffset = (yBlockSize * nYBlocks);
-                        outputRasterBands[n]->RasterIO(GF_Write, 0, rowOffset, width, remainRows, outputData[n], width, remainRows, GDT_Float64, 0, 0);
+                        instrumentedRasterIO(outputRasterBands[n], GF_Write, 0, rowOffset, width, remainRows, outputData[n], width, remainRows, GDT_Float64, 0, 0);
                     }
                 }
             }
 			std::cout << " Complete.\n";
+			recordGDALCacheUsage();
+			progress.complete();
 		}
 		catch(RSGISImageCalcException& e)
 		{
@@ -2248,6 +2295,7 @@ namespace rsgis{namespace img{
 			throw e;
 		}
         
+        this->ioPolicy->finaliseImage(outputImageDS);
         GDALClose(outputImageDS);
         
 		if(gdalTranslation != NULL)
@@ -2361,6 +2409,8 @@ namespace rsgis{namespace img{
     
     void RSGISCalcImage::calcImage(GDALDataset **datasets, int numIntDS, int numFloatDS, std::string outputImage, std::string outputRefIntImage, std::string gdalFormat, GDALDataType gdalDataType)
     {
+        rsgis::RSGISProgressReporter progress("RSGISCalcImage::calcImage");
+        RSGISImageIOScope ioScope(this->ioPolicy);
         GDALAllRegister();
         RSGISImageUtils imgUtils;
         int numDS = numIntDS + numFloatDS;
@@ -2423,7 +2473,7 @@ namespace rsgis{namespace img{
             }
             std::cout << "New image width = " << width << " height = " << height << " bands = " << this->numOutBands << std::endl;
             
-            outputImageDS = gdalDriver->Create(outputImage.c_str(), width, height, this->numOutBands, gdalDataType, NULL);
+            outputImageDS = this->ioPolicy->createImage(gdalDriver, outputImage, width, height, this->numOutBands, gdalDataType);
             if(outputImageDS == NULL)
             {
                 throw RSGISImageBandException("Output image could not be created. Check filepath.");
@@ -2438,7 +2488,7 @@ namespace rsgis{namespace img{
                 outputImageDS->SetProjection(proj.c_str());
             }
             
-            outputRefImageDS = gdalDriver->Create(outputRefIntImage.c_str(), width, height, 1, GDT_UInt32, NULL);
+            outputRefImageDS = this->ioPolicy->createImage(gdalDriver, outputRefIntImage, width, height, 1, GDT_UInt32);
             if(outputRefImageDS == NULL)
             {
                 throw RSGISImageBandException("Output reference image could not be created. Check filepath.");
@@ -2533,19 +2583,20 @@ namespace rsgis{namespace img{
             int feedback = height/10;
             int feedbackCounter = 0;
             std::cout << "Started " << std::flush;
+            progress.start(((unsigned long long)width) * height);
             // Loop images to process data
             for(int i = 0; i < nYBlocks; i++)
             {
                 for(int n = 0; n < numIntBands; n++)
                 {
                     rowOffset = bandIntOffsets[n][1] + (yBlockSize * i);
-                    inputRasterIntBands[n]->RasterIO(GF_Read, bandIntOffsets[n][0], rowOffset, width, yBlockSize, inputIntData[n], width, yBlockSize, GDT_UInt32, 0, 0);
+                    instrumentedRasterIO(inputRasterIntBands[n], GF_Read, bandIntOffsets[n][0], rowOffset, width, yBlockSize, inputIntData[n], width, yBlockSize, GDT_UInt32, 0, 0);
                 }
                 
                 for(int n = 0; n < numFloatBands; n++)
                 {
                     rowOffset = bandFloatOffsets[n][1] + (yBlockSize * i);
-                    inputRasterFloatBands[n]->RasterIO(GF_Read, bandFloatOffsets[n][0], rowOffset, width, yBlockSize, inputFloatData[n], width, yBlockSize, GDT_Float32, 0, 0);
+                    instrumentedRasterIO(inputRasterFloatBands[n], GF_Read, bandFloatOffsets[n][0], rowOffset, width, yBlockSize, inputFloatData[n], width, yBlockSize, GDT_Float32, 0, 0);
                 }
                 
                 for(int m = 0; m < yBlockSize; ++m)
@@ -2553,6 +2604,7 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && ((((i*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -2582,9 +2634,9 @@ namespace rsgis{namespace img{
                 for(int n = 0; n < this->numOutBands; n++)
                 {
                     rowOffset = yBlockSize * i;
-                    outputRasterBands[n]->RasterIO(GF_Write, 0, rowOffset, width, yBlockSize, outputData[n], width, yBlockSize, GDT_Float64, 0, 0);
+                    instrumentedRasterIO(outputRasterBands[n], GF_Write, 0, rowOffset, width, yBlockSize, outputData[n], width, yBlockSize, GDT_Float64, 0, 0);
                 }
-                outputRefRasterBand->RasterIO(GF_Write, 0, rowOffset, width, yBlockSize, outputRefData, width, yBlockSize, GDT_Float64, 0, 0);
+                instrumentedRasterIO(outputRefRasterBand, GF_Write, 0, rowOffset, width, yBlockSize, outputRefData, width, yBlockSize, GDT_Float64, 0, 0);
             }
             
             if(remainRows > 0)
@@ -2592,13 +2644,13 @@ namespace rsgis{namespace img{
                 for(int n = 0; n < numIntBands; n++)
                 {
                     rowOffset = bandIntOffsets[n][1] + (yBlockSize * nYBlocks);
-                    inputRasterIntBands[n]->RasterIO(GF_Read, bandIntOffsets[n][0], rowOffset, width, remainRows, inputIntData[n], width, remainRows, GDT_UInt32, 0, 0);
+                    instrumentedRasterIO(inputRasterIntBands[n], GF_Read, bandIntOffsets[n][0], rowOffset, width, remainRows, inputIntData[n], width, remainRows, GDT_UInt32, 0, 0);
                 }
                 
                 for(int n = 0; n < numFloatBands; n++)
                 {
                     rowOffset = bandFloatOffsets[n][1] + (yBlockSize * nYBlocks);
-                    inputRasterFloatBands[n]->RasterIO(GF_Read, bandFloatOffsets[n][0], rowOffset, width, remainRows, inputFloatData[n], width, remainRows, GDT_Float32, 0, 0);
+                    instrumentedRasterIO(inputRasterFloatBands[n], GF_Read, bandFloatOffsets[n][0], rowOffset, width, remainRows, inputFloatData[n], width, remainRows, GDT_Float32, 0, 0);
                 }
                 
                 for(int m = 0; m < remainRows; ++m)
@@ -2606,6 +2658,7 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && ((((nYBlocks*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -2633,12 +2686,14 @@ namespace rsgis{namespace img{
                     for(int n = 0; n < this->numOutBands; n++)
                     {
                         rowOffset = (yBlockSize * nYBlocks);
-                        outputRasterBands[n]->RasterIO(GF_Write, 0, rowOffset, width, remainRows, outputData[n], width, remainRows, GDT_Float64, 0, 0);
+                        instrumentedRasterIO(outputRasterBands[n], GF_Write, 0, rowOffset, width, remainRows, outputData[n], width, remainRows, GDT_Float64, 0, 0);
                     }
-                    outputRefRasterBand->RasterIO(GF_Write, 0, rowOffset, width, remainRows, outputRefData, width, remainRows, GDT_Float64, 0, 0);
+                    instrumentedRasterIO(outputRefRasterBand, GF_Write, 0, rowOffset, width, remainRows, outputRefData, width, remainRows, GDT_Float64, 0, 0);
                 }
             }
             std::cout << " Complete.\n";
+            recordGDALCacheUsage();
+            progress.complete();
         }
         catch(RSGISImageCalcException& e)
         {
@@ -2863,6 +2918,7 @@ namespace rsgis{namespace img{
             throw e;
         }
         
+        this->ioPolicy->finaliseImage(outputImageDS);
         GDALClose(outputImageDS);
         
         if(gdalTranslation != NULL)
@@ -2980,6 +3036,8 @@ namespace rsgis{namespace img{
     
     void RSGISCalcImage::calcImage(GDALDataset **datasets, int numIntDS, int numFloatDS, geos::geom::Envelope *env, bool quiet)
     {
+        rsgis::RSGISProgressReporter progress("RSGISCalcImage::calcImage");
+        RSGISImageIOScope ioScope(this->ioPolicy);
         GDALAllRegister();
 		RSGISImageUtils imgUtils;
         int numDS = numIntDS + numFloatDS;
@@ -3086,6 +3144,7 @@ namespace rsgis{namespace img{
             if(!quiet)
             {
                 std::cout << "Started " << std::flush;
+                progress.start(((unsigned long long)width) * height);
             }
 			// Loop images to process data
 			for(int i = 0; i < nYBlocks; i++)
@@ -3093,13 +3152,13 @@ namespace rsgis{namespace img{
 				for(int n = 0; n < numIntBands; n++)
 				{
                     rowOffset = bandIntOffsets[n][1] + (yBlockSize * i);
-					inputRasterIntBands[n]->RasterIO(GF_Read, bandIntOffsets[n][0], rowOffset, width, yBlockSize, inputIntData[n], width, yBlockSize, GDT_UInt32, 0, 0);
+					instrumentedRasterIO(inputRasterIntBands[n], GF_Read, bandIntOffsets[n][0], rowOffset, width, yBlockSize, inputIntData[n], width, yBlockSize, GDT_UInt32, 0, 0);
 				}
                 
                 for(int n = 0; n < numFloatBands; n++)
 				{
                     rowOffset = bandFloatOffsets[n][1] + (yBlockSize * i);
-					inputRasterFloatBands[n]->RasterIO(GF_Read, bandFloatOffsets[n][0], rowOffset, width, yBlockSize, inputFloatData[n], width, yBlockSize, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterFloatBands[n], GF_Read, bandFloatOffsets[n][0], rowOffset, width, yBlockSize, inputFloatData[n], width, yBlockSize, GDT_Float32, 0, 0);
 				}
                 
                 for(int m = 0; m < yBlockSize; ++m)
@@ -3107,6 +3166,7 @@ namespace rsgis{namespace img{
                     if((!quiet) && (feedback != 0) && ((((i*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -3133,14 +3193,14 @@ namespace rsgis{namespace img{
                 for(int n = 0; n < numIntBands; n++)
 				{
                     rowOffset = bandIntOffsets[n][1] + (yBlockSize * nYBlocks);
-					inputRasterIntBands[n]->RasterIO(GF_Read, bandIntOffsets[n][0], rowOffset, width, remainRows, inputIntData[n], width, remainRows, GDT_UInt32, 0, 0);
+					instrumentedRasterIO(inputRasterIntBands[n], GF_Read, bandIntOffsets[n][0], rowOffset, width, remainRows, inputIntData[n], width, remainRows, GDT_UInt32, 0, 0);
 				}
                 
                 
                 for(int n = 0; n < numFloatBands; n++)
 				{
                     rowOffset = bandFloatOffsets[n][1] + (yBlockSize * nYBlocks);
-					inputRasterFloatBands[n]->RasterIO(GF_Read, bandFloatOffsets[n][0], rowOffset, width, remainRows, inputFloatData[n], width, remainRows, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterFloatBands[n], GF_Read, bandFloatOffsets[n][0], rowOffset, width, remainRows, inputFloatData[n], width, remainRows, GDT_Float32, 0, 0);
 				}
                 
                 for(int m = 0; m < remainRows; ++m)
@@ -3148,6 +3208,7 @@ namespace rsgis{namespace img{
                     if((!quiet) && (feedback != 0) && ((((nYBlocks*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -3170,6 +3231,8 @@ namespace rsgis{namespace img{
             if(!quiet)
             {
                 std::cout << " Complete.\n";
+                recordGDALCacheUsage();
+                progress.complete();
             }
 		}
 		catch(RSGISImageCalcException& e)
@@ -3437,6 +3500,8 @@ namespace rsgis{namespace img{
 	
     void RSGISCalcImage::calcImage(GDALDataset **datasets, int numIntDS, int numFloatDS, GDALDataset *outputImageDS)
     {
+        rsgis::RSGISProgressReporter progress("RSGISCalcImage::calcImage");
+        RSGISImageIOScope ioScope(this->ioPolicy);
         GDALAllRegister();
 		RSGISImageUtils imgUtils;
         int numDS = numIntDS + numFloatDS;
@@ -3576,6 +3641,7 @@ namespace rsgis{namespace img{
 			int feedback = height/10;
 			int feedbackCounter = 0;
 			std::cout << "Started " << std::flush;
+			progress.start(((unsigned long long)width) * height);
             std::cout.precision(20);
 			// Loop images to process data
 			for(int i = 0; i < nYBlocks; i++)
@@ -3583,13 +3649,13 @@ namespace rsgis{namespace img{
 				for(int n = 0; n < numIntBands; n++)
 				{
                     rowOffset = bandIntOffsets[n][1] + (yBlockSize * i);
-					inputRasterIntBands[n]->RasterIO(GF_Read, bandIntOffsets[n][0], rowOffset, width, yBlockSize, inputIntData[n], width, yBlockSize, GDT_UInt32, 0, 0);
+					instrumentedRasterIO(inputRasterIntBands[n], GF_Read, bandIntOffsets[n][0], rowOffset, width, yBlockSize, inputIntData[n], width, yBlockSize, GDT_UInt32, 0, 0);
 				}
                 
                 for(int n = 0; n < numFloatBands; n++)
 				{
                     rowOffset = bandFloatOffsets[n][1] + (yBlockSize * i);
-					inputRasterFloatBands[n]->RasterIO(GF_Read, bandFloatOffsets[n][0], rowOffset, width, yBlockSize, inputFloatData[n], width, yBlockSize, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterFloatBands[n], GF_Read, bandFloatOffsets[n][0], rowOffset, width, yBlockSize, inputFloatData[n], width, yBlockSize, GDT_Float32, 0, 0);
 				}
                 
                 for(int m = 0; m < yBlockSize; ++m)
@@ -3597,6 +3663,7 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && ((((i*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -3625,7 +3692,7 @@ namespace rsgis{namespace img{
                 for(int n = 0; n < this->numOutBands; n++)
 				{
                     rowOffset = yBlockSize * i;
-					outputRasterBands[n]->RasterIO(GF_Write, 0, rowOffset, width, yBlockSize, outputData[n], width, yBlockSize, GDT_Float64, 0, 0);
+					instrumentedRasterIO(outputRasterBands[n], GF_Write, 0, rowOffset, width, yBlockSize, outputData[n], width, yBlockSize, GDT_Float64, 0, 0);
 				}
 			}
             
@@ -3634,13 +3701,13 @@ namespace rsgis{namespace img{
                 for(int n = 0; n < numIntBands; n++)
 				{
                     rowOffset = bandIntOffsets[n][1] + (yBlockSize * nYBlocks);
-					inputRasterIntBands[n]->RasterIO(GF_Read, bandIntOffsets[n][0], rowOffset, width, remainRows, inputIntData[n], width, remainRows, GDT_UInt32, 0, 0);
+					instrumentedRasterIO(inputRasterIntBands[n], GF_Read, bandIntOffsets[n][0], rowOffset, width, remainRows, inputIntData[n], width, remainRows, GDT_UInt32, 0, 0);
 				}
                 
                 for(int n = 0; n < numFloatBands; n++)
 				{
                     rowOffset = bandFloatOffsets[n][1] + (yBlockSize * nYBlocks);
-					inputRasterFloatBands[n]->RasterIO(GF_Read, bandFloatOffsets[n][0], rowOffset, width, remainRows, inputFloatData[n], width, remainRows, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterFloatBands[n], GF_Read, bandFloatOffsets[n][0], rowOffset, width, remainRows, inputFloatData[n], width, remainRows, GDT_Float32, 0, 0);
 				}
                 
                 for(int m = 0; m < remainRows; ++m)
@@ -3648,6 +3715,7 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && ((((nYBlocks*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -3674,11 +3742,13 @@ namespace rsgis{namespace img{
                     for(int n = 0; n < this->numOutBands; n++)
                     {
                         rowOffset = (yBlockSize * nYBlocks);
-                        outputRasterBands[n]->RasterIO(GF_Write, 0, rowOffset, width, remainRows, outputData[n], width, remainRows, GDT_Float64, 0, 0);
+                        instrumentedRasterIO(outputRasterBands[n], GF_Write, 0, rowOffset, width, remainRows, outputData[n], width, remainRows, GDT_Float64, 0, 0);
                     }
                 }
             }
 			std::cout << " Complete.\n";
+			recordGDALCacheUsage();
+			progress.complete();
 		}
 		catch(RSGISImageCalcException& e)
 		{
@@ -4013,6 +4083,8 @@ namespace rsgis{namespace img{
     
 	void RSGISCalcImage::calcImage(GDALDataset **datasets, int numDS)
 	{
+		rsgis::RSGISProgressReporter progress("RSGISCalcImage::calcImage");
+		RSGISImageIOScope ioScope(this->ioPolicy);
 		GDALAllRegister();
 		RSGISImageUtils imgUtils;
 		double *gdalTranslation = new double[6];
@@ -4075,13 +4147,14 @@ namespace rsgis{namespace img{
 			int feedback = height/10;
 			int feedbackCounter = 0;
 			std::cout << "Started " << std::flush;
+			progress.start(((unsigned long long)width) * height);
 			// Loop images to process data
 			for(int i = 0; i < nYBlocks; i++)
 			{
 				for(int n = 0; n < numInBands; n++)
 				{
                     rowOffset = bandOffsets[n][1] + (yBlockSize * i);
-					inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, yBlockSize, inputData[n], width, yBlockSize, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, yBlockSize, inputData[n], width, yBlockSize, GDT_Float32, 0, 0);
 				}
                 
                 for(int m = 0; m < yBlockSize; ++m)
@@ -4089,6 +4162,7 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && ((((i*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -4109,7 +4183,7 @@ namespace rsgis{namespace img{
                 for(int n = 0; n < numInBands; n++)
 				{
                     rowOffset = bandOffsets[n][1] + (yBlockSize * nYBlocks);
-					inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputData[n], width, remainRows, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputData[n], width, remainRows, GDT_Float32, 0, 0);
 				}
                 
                 for(int m = 0; m < remainRows; ++m)
@@ -4117,6 +4191,7 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && ((((nYBlocks*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -4132,6 +4207,8 @@ namespace rsgis{namespace img{
                 }
             }
 			std::cout << " Complete.\n";
+			recordGDALCacheUsage();
+			progress.complete();
 		}
 		catch(RSGISImageCalcException& e)
 		{
@@ -4290,6 +4367,7 @@ namespace rsgis{namespace img{
     
     void RSGISCalcImage::calcImageBand(GDALDataset **datasets, int numDS, std::string outputImageBase, std::string gdalFormat)
 	{
+        RSGISImageIOScope ioScope(this->ioPolicy);
 		GDALAllRegister();
 		RSGISImageUtils imgUtils;
         rsgis::math::RSGISMathsUtils mathUtils;
@@ -4340,7 +4418,7 @@ namespace rsgis{namespace img{
                 
                 std::cout << "New image width = " << width << " height = " << height << " bands = " << this->numOutBands << std::endl;
 				
-				outputImageDS = gdalDriver->Create(outputImageFileName.c_str(), width, height, this->numOutBands, GDT_Float32, NULL);
+				outputImageDS = this->ioPolicy->createImage(gdalDriver, outputImageFileName, width, height, this->numOutBands, GDT_Float32);
 				
                 if(outputImageDS == NULL)
                 {
@@ -4402,7 +4480,7 @@ namespace rsgis{namespace img{
                         feedbackCounter = feedbackCounter + 10;
                     }
 
-                    inputRasterBands[cImgBand]->RasterIO(GF_Read, bandOffsets[cImgBand][0], (bandOffsets[cImgBand][1]+i), width, 1, inputData, width, 1, GDT_Float32, 0, 0);
+                    instrumentedRasterIO(inputRasterBands[cImgBand], GF_Read, bandOffsets[cImgBand][0], (bandOffsets[cImgBand][1]+i), width, 1, inputData, width, 1, GDT_Float32, 0, 0);
                     
                     for(int j = 0; j < width; j++)
                     {
@@ -4419,11 +4497,12 @@ namespace rsgis{namespace img{
                     
                     for(int n = 0; n < this->numOutBands; n++)
                     {
-                        outputRasterBands[n]->RasterIO(GF_Write, 0, i, width, 1, outputData[n], width, 1, GDT_Float64, 0, 0);
+                        instrumentedRasterIO(outputRasterBands[n], GF_Write, 0, i, width, 1, outputData[n], width, 1, GDT_Float64, 0, 0);
                     }
                 }
                 std::cout << " Complete.\n";
                 
+                this->ioPolicy->finaliseImage(outputImageDS);
                 GDALClose(outputImageDS);
                 
                 delete[] inputData;
@@ -4538,6 +4617,8 @@ namespace rsgis{namespace img{
     
     void RSGISCalcImage::calcImageInEnv(GDALDataset **datasets, int numDS, std::string outputImage, geos::geom::Envelope *env, bool setOutNames, std::string *bandNames, std::string gdalFormat, GDALDataType gdalDataType)
     {
+        rsgis::RSGISProgressReporter progress("RSGISCalcImage::calcImageInEnv");
+        RSGISImageIOScope ioScope(this->ioPolicy);
         GDALAllRegister();
 		RSGISImageUtils imgUtils;
 		double *gdalTranslation = new double[6];
@@ -4582,7 +4663,7 @@ namespace rsgis{namespace img{
 			}
 			std::cout << "New image width = " << width << " height = " << height << " bands = " << this->numOutBands << std::endl;
 			
-			outputImageDS = gdalDriver->Create(outputImage.c_str(), width, height, this->numOutBands, gdalDataType, NULL);
+			outputImageDS = this->ioPolicy->createImage(gdalDriver, outputImage, width, height, this->numOutBands, gdalDataType);
 			
 			if(outputImageDS == NULL)
 			{
@@ -4655,13 +4736,14 @@ namespace rsgis{namespace img{
 			int feedback = height/10.0;
 			int feedbackCounter = 0;
 			std::cout << "Started " << std::flush;
+			progress.start(((unsigned long long)width) * height);
 			// Loop images to process data
 			for(int i = 0; i < nYBlocks; i++)
 			{
 				for(int n = 0; n < numInBands; n++)
 				{
                     rowOffset = bandOffsets[n][1] + (yBlockSize * i);
-					inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, yBlockSize, inputData[n], width, yBlockSize, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, yBlockSize, inputData[n], width, yBlockSize, GDT_Float32, 0, 0);
 				}
                 
                 for(int m = 0; m < yBlockSize; ++m)
@@ -4669,6 +4751,7 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && (((i*yBlockSize)+m) % feedback) == 0)
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -4693,7 +4776,7 @@ namespace rsgis{namespace img{
 				for(int n = 0; n < this->numOutBands; n++)
 				{
                     rowOffset = yBlockSize * i;
-					outputRasterBands[n]->RasterIO(GF_Write, 0, rowOffset, width, yBlockSize, outputData[n], width, yBlockSize, GDT_Float64, 0, 0);
+					instrumentedRasterIO(outputRasterBands[n], GF_Write, 0, rowOffset, width, yBlockSize, outputData[n], width, yBlockSize, GDT_Float64, 0, 0);
 				}
 			}
             
@@ -4702,7 +4785,7 @@ namespace rsgis{namespace img{
                 for(int n = 0; n < numInBands; n++)
 				{
                     rowOffset = bandOffsets[n][1] + (yBlockSize * nYBlocks);
-					inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputData[n], width, remainRows, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputData[n], width, remainRows, GDT_Float32, 0, 0);
 				}
                 
                 for(int m = 0; m < remainRows; ++m)
@@ -4710,6 +4793,7 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && ((((nYBlocks*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -4733,10 +4817,12 @@ namespace rsgis{namespace img{
 				for(int n = 0; n < this->numOutBands; n++)
 				{
                     rowOffset = (yBlockSize * nYBlocks);
-					outputRasterBands[n]->RasterIO(GF_Write, 0, rowOffset, width, remainRows, outputData[n], width, remainRows, GDT_Float64, 0, 0);
+					instrumentedRasterIO(outputRasterBands[n], GF_Write, 0, rowOffset, width, remainRows, outputData[n], width, remainRows, GDT_Float64, 0, 0);
 				}
             }
 			std::cout << " Complete.\n";
+			recordGDALCacheUsage();
+			progress.complete();
 		}
 		catch(RSGISImageCalcException& e)
 		{
@@ -4891,6 +4977,7 @@ namespace rsgis{namespace img{
 			throw e;
 		}
 		
+		this->ioPolicy->finaliseImage(outputImageDS);
 		GDALClose(outputImageDS);
 		
 		if(gdalTranslation != NULL)
@@ -4969,6 +5056,8 @@ namespace rsgis{namespace img{
     
     void RSGISCalcImage::calcImageInEnv(GDALDataset **datasets, int numDS, geos::geom::Envelope *env, bool quiet)
     {
+        rsgis::RSGISProgressReporter progress("RSGISCalcImage::calcImageInEnv");
+        RSGISImageIOScope ioScope(this->ioPolicy);
         GDALAllRegister();
 		RSGISImageUtils imgUtils;
 		double *gdalTranslation = new double[6];
@@ -5034,6 +5123,7 @@ namespace rsgis{namespace img{
             if(!quiet)
             {
                 std::cout << "Started " << std::flush;
+                progress.start(((unsigned long long)width) * height);
             }
 			// Loop images to process data
 			for(int i = 0; i < nYBlocks; i++)
@@ -5041,7 +5131,7 @@ namespace rsgis{namespace img{
 				for(int n = 0; n < numInBands; n++)
 				{
                     rowOffset = bandOffsets[n][1] + (yBlockSize * i);
-					inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, yBlockSize, inputData[n], width, yBlockSize, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, yBlockSize, inputData[n], width, yBlockSize, GDT_Float32, 0, 0);
 				}
                 
                 for(int m = 0; m < yBlockSize; ++m)
@@ -5049,6 +5139,7 @@ namespace rsgis{namespace img{
                     if((!quiet) && (feedback != 0) && (((i*yBlockSize)+m) % feedback) == 0)
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -5071,7 +5162,7 @@ namespace rsgis{namespace img{
                 for(int n = 0; n < numInBands; n++)
 				{
                     rowOffset = bandOffsets[n][1] + (yBlockSize * nYBlocks);
-					inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputData[n], width, remainRows, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputData[n], width, remainRows, GDT_Float32, 0, 0);
 				}
                 
                 for(int m = 0; m < remainRows; ++m)
@@ -5079,6 +5170,7 @@ namespace rsgis{namespace img{
                     if((!quiet) && (feedback != 0) && ((((nYBlocks*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -5096,6 +5188,8 @@ namespace rsgis{namespace img{
             if(!quiet)
             {
                 std::cout << " Complete.\n";
+                recordGDALCacheUsage();
+                progress.complete();
             }
 		}
 		catch(RSGISImageCalcException& e)
@@ -5262,6 +5356,8 @@ namespace rsgis{namespace img{
     
     void RSGISCalcImage::calcImageInEnv(GDALDataset **datasets, int numIntDS, int numFloatDS, geos::geom::Envelope *env, bool quiet)
     {
+        rsgis::RSGISProgressReporter progress("RSGISCalcImage::calcImageInEnv");
+        RSGISImageIOScope ioScope(this->ioPolicy);
         GDALAllRegister();
         RSGISImageUtils imgUtils;
         int numDS = numIntDS + numFloatDS;
@@ -5361,6 +5457,7 @@ namespace rsgis{namespace img{
             if(!quiet)
             {
                 std::cout << "Started " << std::flush;
+                progress.start(((unsigned long long)width) * height);
             }
             // Loop images to process data
             for(int i = 0; i < nYBlocks; i++)
@@ -5368,13 +5465,13 @@ namespace rsgis{namespace img{
                 for(int n = 0; n < numIntBands; n++)
                 {
                     rowOffset = bandIntOffsets[n][1] + (yBlockSize * i);
-                    inputRasterIntBands[n]->RasterIO(GF_Read, bandIntOffsets[n][0], rowOffset, width, yBlockSize, inputIntData[n], width, yBlockSize, GDT_UInt32, 0, 0);
+                    instrumentedRasterIO(inputRasterIntBands[n], GF_Read, bandIntOffsets[n][0], rowOffset, width, yBlockSize, inputIntData[n], width, yBlockSize, GDT_UInt32, 0, 0);
                 }
                 
                 for(int n = 0; n < numFloatBands; n++)
                 {
                     rowOffset = bandFloatOffsets[n][1] + (yBlockSize * i);
-                    inputRasterFloatBands[n]->RasterIO(GF_Read, bandFloatOffsets[n][0], rowOffset, width, yBlockSize, inputFloatData[n], width, yBlockSize, GDT_Float32, 0, 0);
+                    instrumentedRasterIO(inputRasterFloatBands[n], GF_Read, bandFloatOffsets[n][0], rowOffset, width, yBlockSize, inputFloatData[n], width, yBlockSize, GDT_Float32, 0, 0);
                 }
                 
                 for(int m = 0; m < yBlockSize; ++m)
@@ -5382,6 +5479,7 @@ namespace rsgis{namespace img{
                     if((!quiet) && (feedback != 0) && ((((i*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -5408,14 +5506,14 @@ namespace rsgis{namespace img{
                 for(int n = 0; n < numIntBands; n++)
                 {
                     rowOffset = bandIntOffsets[n][1] + (yBlockSize * nYBlocks);
-                    inputRasterIntBands[n]->RasterIO(GF_Read, bandIntOffsets[n][0], rowOffset, width, remainRows, inputIntData[n], width, remainRows, GDT_UInt32, 0, 0);
+                    instrumentedRasterIO(inputRasterIntBands[n], GF_Read, bandIntOffsets[n][0], rowOffset, width, remainRows, inputIntData[n], width, remainRows, GDT_UInt32, 0, 0);
                 }
                 
                 
                 for(int n = 0; n < numFloatBands; n++)
                 {
                     rowOffset = bandFloatOffsets[n][1] + (yBlockSize * nYBlocks);
-                    inputRasterFloatBands[n]->RasterIO(GF_Read, bandFloatOffsets[n][0], rowOffset, width, remainRows, inputFloatData[n], width, remainRows, GDT_Float32, 0, 0);
+                    instrumentedRasterIO(inputRasterFloatBands[n], GF_Read, bandFloatOffsets[n][0], rowOffset, width, remainRows, inputFloatData[n], width, remainRows, GDT_Float32, 0, 0);
                 }
                 
                 for(int m = 0; m < remainRows; ++m)
@@ -5423,6 +5521,7 @@ namespace rsgis{namespace img{
                     if((!quiet) && (feedback != 0) && ((((nYBlocks*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -5445,6 +5544,8 @@ namespace rsgis{namespace img{
             if(!quiet)
             {
                 std::cout << " Complete.\n";
+                recordGDALCacheUsage();
+                progress.complete();
             }
         }
         catch(RSGISImageCalcException& e)
@@ -5712,6 +5813,8 @@ namespace rsgis{namespace img{
     
     void RSGISCalcImage::calcImagePosPxl(GDALDataset **datasets, int numDS)
 	{
+		rsgis::RSGISProgressReporter progress("RSGISCalcImage::calcImagePosPxl");
+		RSGISImageIOScope ioScope(this->ioPolicy);
 		GDALAllRegister();
 		RSGISImageUtils imgUtils;
 		double *gdalTranslation = new double[6];
@@ -5777,13 +5880,14 @@ namespace rsgis{namespace img{
             unsigned int yPxl = 0;
             geos::geom::Envelope extent;
 			std::cout << "Started " << std::flush;
+			progress.start(((unsigned long long)width) * height);
 			// Loop images to process data
 			for(int i = 0; i < nYBlocks; i++)
 			{
 				for(int n = 0; n < numInBands; n++)
 				{
                     rowOffset = bandOffsets[n][1] + (yBlockSize * i);
-					inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, yBlockSize, inputData[n], width, yBlockSize, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, yBlockSize, inputData[n], width, yBlockSize, GDT_Float32, 0, 0);
 				}
                 
                 for(int m = 0; m < yBlockSize; ++m)
@@ -5791,6 +5895,7 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && ((((i*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -5816,7 +5921,7 @@ namespace rsgis{namespace img{
                 for(int n = 0; n < numInBands; n++)
 				{
                     rowOffset = bandOffsets[n][1] + (yBlockSize * nYBlocks);
-					inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputData[n], width, remainRows, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputData[n], width, remainRows, GDT_Float32, 0, 0);
 				}
                 
                 for(int m = 0; m < remainRows; ++m)
@@ -5824,6 +5929,7 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && ((((nYBlocks*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -5844,6 +5950,8 @@ namespace rsgis{namespace img{
                 }
             }
 			std::cout << " Complete.\n";
+			recordGDALCacheUsage();
+			progress.complete();
 		}
 		catch(RSGISImageCalcException& e)
 		{
@@ -6002,6 +6110,8 @@ namespace rsgis{namespace img{
     
     void RSGISCalcImage::calcImagePosPxl(GDALDataset **datasets, int numIntDS, int numFloatDS)
     {
+        rsgis::RSGISProgressReporter progress("RSGISCalcImage::calcImagePosPxl");
+        RSGISImageIOScope ioScope(this->ioPolicy);
         GDALAllRegister();
         RSGISImageUtils imgUtils;
         int numDS = numIntDS + numFloatDS;
@@ -6103,19 +6213,20 @@ namespace rsgis{namespace img{
             int feedback = height/10;
             int feedbackCounter = 0;
             std::cout << "Started " << std::flush;
+            progress.start(((unsigned long long)width) * height);
             // Loop images to process data
             for(int i = 0; i < nYBlocks; i++)
             {
                 for(int n = 0; n < numIntBands; n++)
                 {
                     rowOffset = bandIntOffsets[n][1] + (yBlockSize * i);
-                    inputRasterIntBands[n]->RasterIO(GF_Read, bandIntOffsets[n][0], rowOffset, width, yBlockSize, inputIntData[n], width, yBlockSize, GDT_UInt32, 0, 0);
+                    instrumentedRasterIO(inputRasterIntBands[n], GF_Read, bandIntOffsets[n][0], rowOffset, width, yBlockSize, inputIntData[n], width, yBlockSize, GDT_UInt32, 0, 0);
                 }
                 
                 for(int n = 0; n < numFloatBands; n++)
                 {
                     rowOffset = bandFloatOffsets[n][1] + (yBlockSize * i);
-                    inputRasterFloatBands[n]->RasterIO(GF_Read, bandFloatOffsets[n][0], rowOffset, width, yBlockSize, inputFloatData[n], width, yBlockSize, GDT_Float32, 0, 0);
+                    instrumentedRasterIO(inputRasterFloatBands[n], GF_Read, bandFloatOffsets[n][0], rowOffset, width, yBlockSize, inputFloatData[n], width, yBlockSize, GDT_Float32, 0, 0);
                 }
                 
                 for(int m = 0; m < yBlockSize; ++m)
@@ -6123,6 +6234,7 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && ((((i*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -6154,14 +6266,14 @@ namespace rsgis{namespace img{
                 for(int n = 0; n < numIntBands; n++)
                 {
                     rowOffset = bandIntOffsets[n][1] + (yBlockSize * nYBlocks);
-                    inputRasterIntBands[n]->RasterIO(GF_Read, bandIntOffsets[n][0], rowOffset, width, remainRows, inputIntData[n], width, remainRows, GDT_UInt32, 0, 0);
+                    instrumentedRasterIO(inputRasterIntBands[n], GF_Read, bandIntOffsets[n][0], rowOffset, width, remainRows, inputIntData[n], width, remainRows, GDT_UInt32, 0, 0);
                 }
                 
                 
                 for(int n = 0; n < numFloatBands; n++)
                 {
                     rowOffset = bandFloatOffsets[n][1] + (yBlockSize * nYBlocks);
-                    inputRasterFloatBands[n]->RasterIO(GF_Read, bandFloatOffsets[n][0], rowOffset, width, remainRows, inputFloatData[n], width, remainRows, GDT_Float32, 0, 0);
+                    instrumentedRasterIO(inputRasterFloatBands[n], GF_Read, bandFloatOffsets[n][0], rowOffset, width, remainRows, inputFloatData[n], width, remainRows, GDT_Float32, 0, 0);
                 }
                 
                 for(int m = 0; m < remainRows; ++m)
@@ -6169,6 +6281,7 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && ((((nYBlocks*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -6194,6 +6307,8 @@ namespace rsgis{namespace img{
                 }
             }
             std::cout << " Complete.\n";
+            recordGDALCacheUsage();
+            progress.complete();
         }
         catch(RSGISImageCalcException& e)
         {
@@ -6460,6 +6575,8 @@ namespace rsgis{namespace img{
     
     void RSGISCalcImage::calcImageExtent(GDALDataset **datasets, int numDS, geos::geom::Envelope *env, bool quiet)
 	{
+		rsgis::RSGISProgressReporter progress("RSGISCalcImage::calcImageExtent");
+		RSGISImageIOScope ioScope(this->ioPolicy);
 		GDALAllRegister();
 		RSGISImageUtils imgUtils;
 		double *gdalTranslation = new double[6];
@@ -6541,6 +6658,7 @@ namespace rsgis{namespace img{
             if(!quiet)
             {
                 std::cout << "Started " << std::flush;
+                progress.start(((unsigned long long)width) * height);
             }
 			// Loop images to process data
 			for(int i = 0; i < height; i++)
@@ -6548,12 +6666,13 @@ namespace rsgis{namespace img{
 				if((!quiet) && (feedback != 0) && ((i % feedback) == 0))
 				{
                     std::cout << "." << feedbackCounter << "." << std::flush;
+                    progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                     feedbackCounter = feedbackCounter + 10;
 				}
 				
 				for(int n = 0; n < numInBands; n++)
 				{
-					inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], (bandOffsets[n][1]+i), width, 1, inputData[n], width, 1, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], (bandOffsets[n][1]+i), width, 1, inputData[n], width, 1, GDT_Float32, 0, 0);
 				}
 
                 for(int j = 0; j < width; j++)
@@ -6575,6 +6694,8 @@ namespace rsgis{namespace img{
             if(!quiet)
             {
                 std::cout << " Complete.\n";
+                recordGDALCacheUsage();
+                progress.complete();
             }
 		}
 		catch(RSGISImageCalcException& e)
@@ -6740,6 +6861,8 @@ namespace rsgis{namespace img{
     
     void RSGISCalcImage::calcImageExtent(GDALDataset **datasets, int numIntDS, int numFloatDS)
     {
+        rsgis::RSGISProgressReporter progress("RSGISCalcImage::calcImageExtent");
+        RSGISImageIOScope ioScope(this->ioPolicy);
         GDALAllRegister();
 		RSGISImageUtils imgUtils;
         int numDS = numIntDS + numFloatDS;
@@ -6857,19 +6980,20 @@ namespace rsgis{namespace img{
 			int feedback = height/10;
 			int feedbackCounter = 0;
 			std::cout << "Started " << std::flush;
+			progress.start(((unsigned long long)width) * height);
 			// Loop images to process data
 			for(int i = 0; i < nYBlocks; i++)
 			{
 				for(int n = 0; n < numIntBands; n++)
 				{
                     rowOffset = bandIntOffsets[n][1] + (yBlockSize * i);
-					inputRasterIntBands[n]->RasterIO(GF_Read, bandIntOffsets[n][0], rowOffset, width, yBlockSize, inputIntData[n], width, yBlockSize, GDT_UInt32, 0, 0);
+					instrumentedRasterIO(inputRasterIntBands[n], GF_Read, bandIntOffsets[n][0], rowOffset, width, yBlockSize, inputIntData[n], width, yBlockSize, GDT_UInt32, 0, 0);
 				}
                 
                 for(int n = 0; n < numFloatBands; n++)
 				{
                     rowOffset = bandFloatOffsets[n][1] + (yBlockSize * i);
-					inputRasterFloatBands[n]->RasterIO(GF_Read, bandFloatOffsets[n][0], rowOffset, width, yBlockSize, inputFloatData[n], width, yBlockSize, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterFloatBands[n], GF_Read, bandFloatOffsets[n][0], rowOffset, width, yBlockSize, inputFloatData[n], width, yBlockSize, GDT_Float32, 0, 0);
 				}
                 
                 for(int m = 0; m < yBlockSize; ++m)
@@ -6877,6 +7001,7 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && ((((i*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -6908,14 +7033,14 @@ namespace rsgis{namespace img{
                 for(int n = 0; n < numIntBands; n++)
 				{
                     rowOffset = bandIntOffsets[n][1] + (yBlockSize * nYBlocks);
-					inputRasterIntBands[n]->RasterIO(GF_Read, bandIntOffsets[n][0], rowOffset, width, remainRows, inputIntData[n], width, remainRows, GDT_UInt32, 0, 0);
+					instrumentedRasterIO(inputRasterIntBands[n], GF_Read, bandIntOffsets[n][0], rowOffset, width, remainRows, inputIntData[n], width, remainRows, GDT_UInt32, 0, 0);
 				}
                 
                 
                 for(int n = 0; n < numFloatBands; n++)
 				{
                     rowOffset = bandFloatOffsets[n][1] + (yBlockSize * nYBlocks);
-					inputRasterFloatBands[n]->RasterIO(GF_Read, bandFloatOffsets[n][0], rowOffset, width, remainRows, inputFloatData[n], width, remainRows, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterFloatBands[n], GF_Read, bandFloatOffsets[n][0], rowOffset, width, remainRows, inputFloatData[n], width, remainRows, GDT_Float32, 0, 0);
 				}
                 
                 for(int m = 0; m < remainRows; ++m)
@@ -6923,6 +7048,7 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && ((((nYBlocks*yBlockSize)+m) % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
@@ -6948,6 +7074,8 @@ namespace rsgis{namespace img{
                 }
             }
 			std::cout << " Complete.\n";
+			recordGDALCacheUsage();
+			progress.complete();
 		}
 		catch(RSGISImageCalcException& e)
 		{
@@ -7214,6 +7342,8 @@ namespace rsgis{namespace img{
 	
 	void RSGISCalcImage::calcImageExtent(GDALDataset **datasets, int numDS, std::string outputImage, std::string gdalFormat, GDALDataType gdalDataType)
 	{
+		rsgis::RSGISProgressReporter progress("RSGISCalcImage::calcImageExtent");
+		RSGISImageIOScope ioScope(this->ioPolicy);
 		GDALAllRegister();
 		RSGISImageUtils imgUtils;
 		double *gdalTranslation = new double[6];
@@ -7260,7 +7390,7 @@ namespace rsgis{namespace img{
 				throw RSGISImageBandException(gdalFormat + std::string(" driver does not exists.."));
 			}
 
-			outputImageDS = gdalDriver->Create(outputImage.c_str(), width, height, this->numOutBands, gdalDataType, NULL);
+			outputImageDS = this->ioPolicy->createImage(gdalDriver, outputImage, width, height, this->numOutBands, gdalDataType);
 			
 			if(outputImageDS == NULL)
 			{
@@ -7327,18 +7457,20 @@ namespace rsgis{namespace img{
 			int feedback = height/10;
 			int feedbackCounter = 0;
 			std::cout << "Started " << std::flush;
+			progress.start(((unsigned long long)width) * height);
 			// Loop images to process data
 			for(int i = 0; i < height; i++)
 			{
 				if((feedback != 0) && ((i % feedback) == 0))
 				{
 					std::cout << "." << feedbackCounter << "." << std::flush;
+					progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
 					feedbackCounter = feedbackCounter + 10;
 				}
 				
 				for(int n = 0; n < numInBands; n++)
 				{
-					inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], (bandOffsets[n][1]+i), width, 1, inputData[n], width, 1, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], (bandOffsets[n][1]+i), width, 1, inputData[n], width, 1, GDT_Float32, 0, 0);
 				}
 				
 				for(int j = 0; j < width; j++)
@@ -7365,10 +7497,12 @@ namespace rsgis{namespace img{
 				
 				for(int n = 0; n < this->numOutBands; n++)
 				{
-					outputRasterBands[n]->RasterIO(GF_Write, 0, i, width, 1, outputData[n], width, 1, GDT_Float64, 0, 0);
+					instrumentedRasterIO(outputRasterBands[n], GF_Write, 0, i, width, 1, outputData[n], width, 1, GDT_Float64, 0, 0);
 				}
 			}
 			std::cout << " Complete.\n";
+			recordGDALCacheUsage();
+			progress.complete();
 		}
 		catch(RSGISImageCalcException& e)
 		{			
@@ -7523,6 +7657,7 @@ namespace rsgis{namespace img{
 			throw e;
 		}
 		
+		this->ioPolicy->finaliseImage(outputImageDS);
 		GDALClose(outputImageDS);
 		
 		if(gdalTranslation != NULL)
@@ -7601,6 +7736,8 @@ namespace rsgis{namespace img{
 	
     void RSGISCalcImage::calcImageWindowData(GDALDataset **datasets, int numDS, int windowSize)
 	{
+		rsgis::RSGISProgressReporter progress("RSGISCalcImage::calcImageWindowData");
+		RSGISImageIOScope ioScope(this->ioPolicy);
 		GDALAllRegister();
 		RSGISImageUtils imgUtils;
 		double *gdalTranslation = new double[6];
@@ -7725,6 +7862,7 @@ namespace rsgis{namespace img{
             int feedback = height/10.0;
 			int feedbackCounter = 0;
 			std::cout << "Started " << std::flush;
+			progress.start(((unsigned long long)width) * height);
 			
             if(nYBlocks > 0)
             {
@@ -7745,7 +7883,7 @@ namespace rsgis{namespace img{
                         for(int n = 0; n < numInBands; n++)
                         {
                             rowOffset = bandOffsets[n][1] + (numOfLines * i);
-                            inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataMain[n], width, numOfLines, GDT_Float32, 0, 0);
+                            instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataMain[n], width, numOfLines, GDT_Float32, 0, 0);
                         }
                         // Read Lower Block
                         for(int n = 0; n < numInBands; n++)
@@ -7755,7 +7893,7 @@ namespace rsgis{namespace img{
                                 if(remainRows > 0)
                                 {
                                     rowOffset = bandOffsets[n][1] + (numOfLines * (i+1));
-                                    inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputDataLower[n], width, remainRows, GDT_Float32, 0, 0);
+                                    instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputDataLower[n], width, remainRows, GDT_Float32, 0, 0);
                                     for(int k = (remainRows*width); k < numPxlsInBlock; k++)
                                     {
                                         inputDataLower[n][k] = 0;
@@ -7772,7 +7910,7 @@ namespace rsgis{namespace img{
                             else
                             {
                                 rowOffset = bandOffsets[n][1] + (numOfLines * (i+1));
-                                inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataLower[n], width, numOfLines, GDT_Float32, 0, 0);
+                                instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataLower[n], width, numOfLines, GDT_Float32, 0, 0);
                             }
                         }
                     }
@@ -7802,7 +7940,7 @@ namespace rsgis{namespace img{
                             if(remainRows > 0)
                             {
                                 rowOffset = bandOffsets[n][1] + (numOfLines * (i+1));
-                                inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputDataLower[n], width, remainRows, GDT_Float32, 0, 0);
+                                instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputDataLower[n], width, remainRows, GDT_Float32, 0, 0);
                                 for(int k = (remainRows*width); k < numPxlsInBlock; k++)
                                 {
                                     inputDataLower[n][k] = 0;
@@ -7841,7 +7979,7 @@ namespace rsgis{namespace img{
                         for(int n = 0; n < numInBands; n++)
                         {
                             rowOffset = bandOffsets[n][1] + (numOfLines * (i+1));
-                            inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataLower[n], width, numOfLines, GDT_Float32, 0, 0);
+                            instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataLower[n], width, numOfLines, GDT_Float32, 0, 0);
                         }
                     }
                     
@@ -7851,6 +7989,7 @@ namespace rsgis{namespace img{
                         if((feedback != 0) && (line % feedback) == 0)
                         {
                             std::cout << "." << feedbackCounter << "." << std::flush;
+                            progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                             feedbackCounter = feedbackCounter + 10;
                         }
                         
@@ -8071,6 +8210,7 @@ namespace rsgis{namespace img{
                         if((feedback != 0) && (line % feedback) == 0)
                         {
                             std::cout << "." << feedbackCounter << "." << std::flush;
+                            progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                             feedbackCounter = feedbackCounter + 10;
                         }
                         
@@ -8262,6 +8402,8 @@ namespace rsgis{namespace img{
             
             
             std::cout << " Complete.\n";
+            recordGDALCacheUsage();
+            progress.complete();
 		}
 		catch(RSGISImageCalcException& e)
 		{
@@ -8479,6 +8621,8 @@ namespace rsgis{namespace img{
     
     void RSGISCalcImage::calcImageWindowData(GDALDataset **datasets, int numDS, std::string outputImage, int windowSize, std::string gdalFormat, GDALDataType gdalDataType)
 	{
+		rsgis::RSGISProgressReporter progress("RSGISCalcImage::calcImageWindowData");
+		RSGISImageIOScope ioScope(this->ioPolicy);
 		GDALAllRegister();
 		RSGISImageUtils imgUtils;
 		double *gdalTranslation = new double[6];
@@ -8535,7 +8679,7 @@ namespace rsgis{namespace img{
 				throw RSGISImageBandException("Driver does not exists..");
 			}
             
-			outputImageDS = gdalDriver->Create(outputImage.c_str(), width, height, this->numOutBands, gdalDataType, NULL);
+			outputImageDS = this->ioPolicy->createImage(gdalDriver, outputImage, width, height, this->numOutBands, gdalDataType);
 			
 			if(outputImageDS == NULL)
 			{
@@ -8651,6 +8795,7 @@ namespace rsgis{namespace img{
             int feedback = height/10.0;
 			int feedbackCounter = 0;
 			std::cout << "Started " << std::flush;
+			progress.start(((unsigned long long)width) * height);
 			
             if(nYBlocks > 0)
             {
@@ -8671,7 +8816,7 @@ namespace rsgis{namespace img{
                         for(int n = 0; n < numInBands; n++)
                         {
                             rowOffset = bandOffsets[n][1] + (numOfLines * i);
-                            inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataMain[n], width, numOfLines, GDT_Float32, 0, 0);
+                            instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataMain[n], width, numOfLines, GDT_Float32, 0, 0);
                         }
                         // Read Lower Block
                         for(int n = 0; n < numInBands; n++)
@@ -8681,7 +8826,7 @@ namespace rsgis{namespace img{
                                 if(remainRows > 0)
                                 {
                                     rowOffset = bandOffsets[n][1] + (numOfLines * (i+1));
-                                    inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputDataLower[n], width, remainRows, GDT_Float32, 0, 0);
+                                    instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputDataLower[n], width, remainRows, GDT_Float32, 0, 0);
                                     for(int k = (remainRows*width); k < numPxlsInBlock; k++)
                                     {
                                         inputDataLower[n][k] = 0;
@@ -8698,7 +8843,7 @@ namespace rsgis{namespace img{
                             else
                             {
                                 rowOffset = bandOffsets[n][1] + (numOfLines * (i+1));
-                                inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataLower[n], width, numOfLines, GDT_Float32, 0, 0);
+                                instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataLower[n], width, numOfLines, GDT_Float32, 0, 0);
                             }
                         }
                     }
@@ -8728,7 +8873,7 @@ namespace rsgis{namespace img{
                             if(remainRows > 0)
                             {
                                 rowOffset = bandOffsets[n][1] + (numOfLines * (i+1));
-                                inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputDataLower[n], width, remainRows, GDT_Float32, 0, 0);
+                                instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputDataLower[n], width, remainRows, GDT_Float32, 0, 0);
                                 for(int k = (remainRows*width); k < numPxlsInBlock; k++)
                                 {
                                     inputDataLower[n][k] = 0;
@@ -8767,7 +8912,7 @@ namespace rsgis{namespace img{
                         for(int n = 0; n < numInBands; n++)
                         {
                             rowOffset = bandOffsets[n][1] + (numOfLines * (i+1));
-                            inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataLower[n], width, numOfLines, GDT_Float32, 0, 0);
+                            instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataLower[n], width, numOfLines, GDT_Float32, 0, 0);
                         }
                     }
                     
@@ -8777,6 +8922,7 @@ namespace rsgis{namespace img{
                         if((feedback != 0) && (line % feedback) == 0)
                         {
                             std::cout << "." << feedbackCounter << "." << std::flush;
+                            progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                             feedbackCounter = feedbackCounter + 10;
                         }
                         
@@ -8967,7 +9113,7 @@ namespace rsgis{namespace img{
                     
                     for(int n = 0; n < this->numOutBands; n++)
                     {
-                        outputRasterBands[n]->RasterIO(GF_Write, 0, (numOfLines * i), width, numOfLines, outputData[n], width, numOfLines, GDT_Float64, 0, 0);
+                        instrumentedRasterIO(outputRasterBands[n], GF_Write, 0, (numOfLines * i), width, numOfLines, outputData[n], width, numOfLines, GDT_Float64, 0, 0);
                     }
                 }
                                 
@@ -9006,6 +9152,7 @@ namespace rsgis{namespace img{
                         if((feedback != 0) && (line % feedback) == 0)
                         {
                             std::cout << "." << feedbackCounter << "." << std::flush;
+                            progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                             feedbackCounter = feedbackCounter + 10;
                         }
                         
@@ -9195,7 +9342,7 @@ namespace rsgis{namespace img{
                     
                     for(int n = 0; n < this->numOutBands; n++)
                     {
-                        outputRasterBands[n]->RasterIO(GF_Write, 0, (nYBlocks*numOfLines), width, remainRows, outputData[n], width, remainRows, GDT_Float64, 0, 0);
+                        instrumentedRasterIO(outputRasterBands[n], GF_Write, 0, (nYBlocks*numOfLines), width, remainRows, outputData[n], width, remainRows, GDT_Float64, 0, 0);
                     }
                 }
                 
@@ -9207,6 +9354,8 @@ namespace rsgis{namespace img{
             
 
             std::cout << " Complete.\n";
+            recordGDALCacheUsage();
+            progress.complete();
 		}
 		catch(RSGISImageCalcException& e)
 		{
@@ -9448,11 +9597,14 @@ namespace rsgis{namespace img{
 			delete[] outDataColumn;
 		}
 		
+		this->ioPolicy->finaliseImage(outputImageDS);
 		GDALClose(outputImageDS);
 	}
     
     void RSGISCalcImage::calcImageWindowData(GDALDataset **datasets, int numDS, std::string outputImage, std::string outputRefIntImage, int windowSize, std::string gdalFormat, GDALDataType gdalDataType)
     {
+        rsgis::RSGISProgressReporter progress("RSGISCalcImage::calcImageWindowData");
+        RSGISImageIOScope ioScope(this->ioPolicy);
         GDALAllRegister();
         RSGISImageUtils imgUtils;
         double *gdalTranslation = new double[6];
@@ -9513,7 +9665,7 @@ namespace rsgis{namespace img{
                 throw RSGISImageBandException("Driver does not exists..");
             }
             
-            outputImageDS = gdalDriver->Create(outputImage.c_str(), width, height, this->numOutBands, gdalDataType, NULL);
+            outputImageDS = this->ioPolicy->createImage(gdalDriver, outputImage, width, height, this->numOutBands, gdalDataType);
             if(outputImageDS == NULL)
             {
                 throw RSGISImageBandException("Output image could not be created. Check filepath.");
@@ -9528,7 +9680,7 @@ namespace rsgis{namespace img{
                 outputImageDS->SetProjection(proj.c_str());
             }
             
-            outputRefImageDS = gdalDriver->Create(outputRefIntImage.c_str(), width, height, 1, GDT_UInt32, NULL);
+            outputRefImageDS = this->ioPolicy->createImage(gdalDriver, outputRefIntImage, width, height, 1, GDT_UInt32);
             if(outputRefImageDS == NULL)
             {
                 throw RSGISImageBandException("Output reference image could not be created. Check filepath.");
@@ -9645,6 +9797,7 @@ namespace rsgis{namespace img{
             int feedback = height/10.0;
             int feedbackCounter = 0;
             std::cout << "Started " << std::flush;
+            progress.start(((unsigned long long)width) * height);
             
             if(nYBlocks > 0)
             {
@@ -9665,7 +9818,7 @@ namespace rsgis{namespace img{
                         for(int n = 0; n < numInBands; n++)
                         {
                             rowOffset = bandOffsets[n][1] + (numOfLines * i);
-                            inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataMain[n], width, numOfLines, GDT_Float32, 0, 0);
+                            instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataMain[n], width, numOfLines, GDT_Float32, 0, 0);
                         }
                         // Read Lower Block
                         for(int n = 0; n < numInBands; n++)
@@ -9675,7 +9828,7 @@ namespace rsgis{namespace img{
                                 if(remainRows > 0)
                                 {
                                     rowOffset = bandOffsets[n][1] + (numOfLines * (i+1));
-                                    inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputDataLower[n], width, remainRows, GDT_Float32, 0, 0);
+                                    instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputDataLower[n], width, remainRows, GDT_Float32, 0, 0);
                                     for(int k = (remainRows*width); k < numPxlsInBlock; k++)
                                     {
                                         inputDataLower[n][k] = 0;
@@ -9692,7 +9845,7 @@ namespace rsgis{namespace img{
                             else
                             {
                                 rowOffset = bandOffsets[n][1] + (numOfLines * (i+1));
-                                inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataLower[n], width, numOfLines, GDT_Float32, 0, 0);
+                                instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataLower[n], width, numOfLines, GDT_Float32, 0, 0);
                             }
                         }
                     }
@@ -9722,7 +9875,7 @@ namespace rsgis{namespace img{
                             if(remainRows > 0)
                             {
                                 rowOffset = bandOffsets[n][1] + (numOfLines * (i+1));
-                                inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputDataLower[n], width, remainRows, GDT_Float32, 0, 0);
+                                instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputDataLower[n], width, remainRows, GDT_Float32, 0, 0);
                                 for(int k = (remainRows*width); k < numPxlsInBlock; k++)
                                 {
                                     inputDataLower[n][k] = 0;
@@ -9761,7 +9914,7 @@ namespace rsgis{namespace img{
                         for(int n = 0; n < numInBands; n++)
                         {
                             rowOffset = bandOffsets[n][1] + (numOfLines * (i+1));
-                            inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataLower[n], width, numOfLines, GDT_Float32, 0, 0);
+                            instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataLower[n], width, numOfLines, GDT_Float32, 0, 0);
                         }
                     }
                     
@@ -9771,6 +9924,7 @@ namespace rsgis{namespace img{
                         if((feedback != 0) && (line % feedback) == 0)
                         {
                             std::cout << "." << feedbackCounter << "." << std::flush;
+                            progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                             feedbackCounter = feedbackCounter + 10;
                         }
                         
@@ -9962,9 +10116,9 @@ namespace rsgis{namespace img{
                     
                     for(int n = 0; n < this->numOutBands; n++)
                     {
-                        outputRasterBands[n]->RasterIO(GF_Write, 0, (numOfLines * i), width, numOfLines, outputData[n], width, numOfLines, GDT_Float64, 0, 0);
+                        instrumentedRasterIO(outputRasterBands[n], GF_Write, 0, (numOfLines * i), width, numOfLines, outputData[n], width, numOfLines, GDT_Float64, 0, 0);
                     }
-                    outputRefRasterBand->RasterIO(GF_Write, 0, (numOfLines * i), width, numOfLines, outputRefData, width, numOfLines, GDT_Float64, 0, 0);
+                    instrumentedRasterIO(outputRefRasterBand, GF_Write, 0, (numOfLines * i), width, numOfLines, outputRefData, width, numOfLines, GDT_Float64, 0, 0);
                 }
                 
                 if(remainRows > 0)
@@ -10002,6 +10156,7 @@ namespace rsgis{namespace img{
                         if((feedback != 0) && (line % feedback) == 0)
                         {
                             std::cout << "." << feedbackCounter << "." << std::flush;
+                            progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                             feedbackCounter = feedbackCounter + 10;
                         }
                         
@@ -10192,9 +10347,9 @@ namespace rsgis{namespace img{
                     
                     for(int n = 0; n < this->numOutBands; n++)
                     {
-                        outputRasterBands[n]->RasterIO(GF_Write, 0, (nYBlocks*numOfLines), width, remainRows, outputData[n], width, remainRows, GDT_Float64, 0, 0);
+                        instrumentedRasterIO(outputRasterBands[n], GF_Write, 0, (nYBlocks*numOfLines), width, remainRows, outputData[n], width, remainRows, GDT_Float64, 0, 0);
                     }
-                    outputRefRasterBand->RasterIO(GF_Write, 0, (nYBlocks*numOfLines), width, remainRows, outputRefData, width, remainRows, GDT_Float64, 0, 0);
+                    instrumentedRasterIO(outputRefRasterBand, GF_Write, 0, (nYBlocks*numOfLines), width, remainRows, outputRefData, width, remainRows, GDT_Float64, 0, 0);
                 }
             }
             else
@@ -10204,6 +10359,8 @@ namespace rsgis{namespace img{
             
             
             std::cout << " Complete.\n";
+            recordGDALCacheUsage();
+            progress.complete();
         }
         catch(RSGISImageCalcException& e)
         {
@@ -10460,13 +10617,17 @@ namespace rsgis{namespace img{
             delete[] outDataColumn;
         }
         
+        this->ioPolicy->finaliseImage(outputImageDS);
         GDALClose(outputImageDS);
+        this->ioPolicy->finaliseImage(outputRefImageDS);
         GDALClose(outputRefImageDS);
     }
     
     
     void RSGISCalcImage::calcImageWindowData(GDALDataset **datasets, int numDS, GDALDataset *outputImageDS, int windowSize, bool passPxlXY)
 	{
+		rsgis::RSGISProgressReporter progress("RSGISCalcImage::calcImageWindowData");
+		RSGISImageIOScope ioScope(this->ioPolicy);
 		if(outputImageDS == NULL)
         {
             throw RSGISImageBandException("Output image is not valid.");
@@ -10637,6 +10798,7 @@ namespace rsgis{namespace img{
             int feedback = height/10.0;
 			int feedbackCounter = 0;
 			std::cout << "Started " << std::flush;
+			progress.start(((unsigned long long)width) * height);
 			
             if(nYBlocks > 0)
             {
@@ -10657,7 +10819,7 @@ namespace rsgis{namespace img{
                         for(int n = 0; n < numInBands; n++)
                         {
                             rowOffset = bandOffsets[n][1] + (numOfLines * i);
-                            inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataMain[n], width, numOfLines, GDT_Float32, 0, 0);
+                            instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataMain[n], width, numOfLines, GDT_Float32, 0, 0);
                         }
                         // Read Lower Block
                         for(int n = 0; n < numInBands; n++)
@@ -10667,7 +10829,7 @@ namespace rsgis{namespace img{
                                 if(remainRows > 0)
                                 {
                                     rowOffset = bandOffsets[n][1] + (numOfLines * (i+1));
-                                    inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputDataLower[n], width, remainRows, GDT_Float32, 0, 0);
+                                    instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputDataLower[n], width, remainRows, GDT_Float32, 0, 0);
                                     for(int k = (remainRows*width); k < numPxlsInBlock; k++)
                                     {
                                         inputDataLower[n][k] = 0;
@@ -10684,7 +10846,7 @@ namespace rsgis{namespace img{
                             else
                             {
                                 rowOffset = bandOffsets[n][1] + (numOfLines * (i+1));
-                                inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataLower[n], width, numOfLines, GDT_Float32, 0, 0);
+                                instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataLower[n], width, numOfLines, GDT_Float32, 0, 0);
                             }
                         }
                     }
@@ -10714,7 +10876,7 @@ namespace rsgis{namespace img{
                             if(remainRows > 0)
                             {
                                 rowOffset = bandOffsets[n][1] + (numOfLines * (i+1));
-                                inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputDataLower[n], width, remainRows, GDT_Float32, 0, 0);
+                                instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputDataLower[n], width, remainRows, GDT_Float32, 0, 0);
                                 for(int k = (remainRows*width); k < numPxlsInBlock; k++)
                                 {
                                     inputDataLower[n][k] = 0;
@@ -10753,7 +10915,7 @@ namespace rsgis{namespace img{
                         for(int n = 0; n < numInBands; n++)
                         {
                             rowOffset = bandOffsets[n][1] + (numOfLines * (i+1));
-                            inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataLower[n], width, numOfLines, GDT_Float32, 0, 0);
+                            instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataLower[n], width, numOfLines, GDT_Float32, 0, 0);
                         }
                     }
                     
@@ -10763,6 +10925,7 @@ namespace rsgis{namespace img{
                         if((feedback != 0) && (line % feedback) == 0)
                         {
                             std::cout << "." << feedbackCounter << "." << std::flush;
+                            progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                             feedbackCounter = feedbackCounter + 10;
                         }
                         
@@ -10963,7 +11126,7 @@ namespace rsgis{namespace img{
                     
                     for(int n = 0; n < this->numOutBands; n++)
                     {
-                        outputRasterBands[n]->RasterIO(GF_Write, 0, (numOfLines * i), width, numOfLines, outputData[n], width, numOfLines, GDT_Float64, 0, 0);
+                        instrumentedRasterIO(outputRasterBands[n], GF_Write, 0, (numOfLines * i), width, numOfLines, outputData[n], width, numOfLines, GDT_Float64, 0, 0);
                     }
                 }
                 
@@ -11003,6 +11166,7 @@ namespace rsgis{namespace img{
                         if((feedback != 0) && (line % feedback) == 0)
                         {
                             std::cout << "." << feedbackCounter << "." << std::flush;
+                            progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                             feedbackCounter = feedbackCounter + 10;
                         }
                         
@@ -11203,7 +11367,7 @@ namespace rsgis{namespace img{
                     
                     for(int n = 0; n < this->numOutBands; n++)
                     {
-                        outputRasterBands[n]->RasterIO(GF_Write, 0, (nYBlocks*numOfLines), width, remainRows, outputData[n], width, remainRows, GDT_Float64, 0, 0);
+                        instrumentedRasterIO(outputRasterBands[n], GF_Write, 0, (nYBlocks*numOfLines), width, remainRows, outputData[n], width, remainRows, GDT_Float64, 0, 0);
                     }
                 }
                 
@@ -11213,6 +11377,8 @@ namespace rsgis{namespace img{
                 
             }
             std::cout << " Complete.\n";
+            recordGDALCacheUsage();
+            progress.complete();
 		}
 		catch(RSGISImageCalcException& e)
 		{
@@ -11458,6 +11624,8 @@ namespace rsgis{namespace img{
     /* Keeps returning a window of data based upon the supplied windowSize until all finished provides the extent on the central pixel (as envelope) at each iteration */
 	void RSGISCalcImage::calcImageWindowDataExtent(GDALDataset **datasets, int numDS, std::string outputImage, int windowSize, std::string gdalFormat, GDALDataType gdalDataType)
 	{
+        rsgis::RSGISProgressReporter progress("RSGISCalcImage::calcImageWindowDataExtent");
+        RSGISImageIOScope ioScope(this->ioPolicy);
         GDALAllRegister();
         RSGISImageUtils imgUtils;
         double *gdalTranslation = new double[6];
@@ -11514,7 +11682,7 @@ namespace rsgis{namespace img{
                 throw RSGISImageBandException("Driver does not exists..");
             }
             
-            outputImageDS = gdalDriver->Create(outputImage.c_str(), width, height, this->numOutBands, gdalDataType, NULL);
+            outputImageDS = this->ioPolicy->createImage(gdalDriver, outputImage, width, height, this->numOutBands, gdalDataType);
             
             if(outputImageDS == NULL)
             {
@@ -11646,6 +11814,7 @@ namespace rsgis{namespace img{
             int feedback = height/10.0;
             int feedbackCounter = 0;
             std::cout << "Started " << std::flush;
+            progress.start(((unsigned long long)width) * height);
             
             if(nYBlocks > 0)
             {
@@ -11666,7 +11835,7 @@ namespace rsgis{namespace img{
                         for(int n = 0; n < numInBands; n++)
                         {
                             rowOffset = bandOffsets[n][1] + (numOfLines * i);
-                            inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataMain[n], width, numOfLines, GDT_Float32, 0, 0);
+                            instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataMain[n], width, numOfLines, GDT_Float32, 0, 0);
                         }
                         // Read Lower Block
                         for(int n = 0; n < numInBands; n++)
@@ -11676,7 +11845,7 @@ namespace rsgis{namespace img{
                                 if(remainRows > 0)
                                 {
                                     rowOffset = bandOffsets[n][1] + (numOfLines * (i+1));
-                                    inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputDataLower[n], width, remainRows, GDT_Float32, 0, 0);
+                                    instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputDataLower[n], width, remainRows, GDT_Float32, 0, 0);
                                     for(int k = (remainRows*width); k < numPxlsInBlock; k++)
                                     {
                                         inputDataLower[n][k] = 0;
@@ -11693,7 +11862,7 @@ namespace rsgis{namespace img{
                             else
                             {
                                 rowOffset = bandOffsets[n][1] + (numOfLines * (i+1));
-                                inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataLower[n], width, numOfLines, GDT_Float32, 0, 0);
+                                instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataLower[n], width, numOfLines, GDT_Float32, 0, 0);
                             }
                         }
                     }
@@ -11723,7 +11892,7 @@ namespace rsgis{namespace img{
                             if(remainRows > 0)
                             {
                                 rowOffset = bandOffsets[n][1] + (numOfLines * (i+1));
-                                inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputDataLower[n], width, remainRows, GDT_Float32, 0, 0);
+                                instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputDataLower[n], width, remainRows, GDT_Float32, 0, 0);
                                 for(int k = (remainRows*width); k < numPxlsInBlock; k++)
                                 {
                                     inputDataLower[n][k] = 0;
@@ -11762,7 +11931,7 @@ namespace rsgis{namespace img{
                         for(int n = 0; n < numInBands; n++)
                         {
                             rowOffset = bandOffsets[n][1] + (numOfLines * (i+1));
-                            inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataLower[n], width, numOfLines, GDT_Float32, 0, 0);
+                            instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], rowOffset, width, numOfLines, inputDataLower[n], width, numOfLines, GDT_Float32, 0, 0);
                         }
                     }
                     
@@ -11772,6 +11941,7 @@ namespace rsgis{namespace img{
                         if((feedback != 0) && (line % feedback) == 0)
                         {
                             std::cout << "." << feedbackCounter << "." << std::flush;
+                            progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                             feedbackCounter = feedbackCounter + 10;
                         }
                         
@@ -11965,7 +12135,7 @@ namespace rsgis{namespace img{
                     
                     for(int n = 0; n < this->numOutBands; n++)
                     {
-                        outputRasterBands[n]->RasterIO(GF_Write, 0, (numOfLines * i), width, numOfLines, outputData[n], width, numOfLines, GDT_Float64, 0, 0);
+                        instrumentedRasterIO(outputRasterBands[n], GF_Write, 0, (numOfLines * i), width, numOfLines, outputData[n], width, numOfLines, GDT_Float64, 0, 0);
                     }
                 }
                 
@@ -12004,6 +12174,7 @@ namespace rsgis{namespace img{
                         if((feedback != 0) && (line % feedback) == 0)
                         {
                             std::cout << "." << feedbackCounter << "." << std::flush;
+                            progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
                             feedbackCounter = feedbackCounter + 10;
                         }
                         
@@ -12198,7 +12369,7 @@ namespace rsgis{namespace img{
                     
                     for(int n = 0; n < this->numOutBands; n++)
                     {
-                        outputRasterBands[n]->RasterIO(GF_Write, 0, (nYBlocks*numOfLines), width, remainRows, outputData[n], width, remainRows, GDT_Float64, 0, 0);
+                        instrumentedRasterIO(outputRasterBands[n], GF_Write, 0, (nYBlocks*numOfLines), width, remainRows, outputData[n], width, remainRows, GDT_Float64, 0, 0);
                     }
                 }
                 
@@ -12208,6 +12379,8 @@ namespace rsgis{namespace img{
                 
             }
             std::cout << " Complete.\n";
+            recordGDALCacheUsage();
+            progress.complete();
         }
         catch(RSGISImageCalcException& e)
         {
@@ -12449,11 +12622,14 @@ namespace rsgis{namespace img{
             delete[] outDataColumn;
         }
         
+        this->ioPolicy->finaliseImage(outputImageDS);
         GDALClose(outputImageDS);
     }
 	
 	void RSGISCalcImage::calcImageWithinPolygon(GDALDataset **datasets, int numDS, std::string outputImage, geos::geom::Envelope *env, geos::geom::Polygon *poly, float nodata, pixelInPolyOption pixelPolyOption, std::string gdalFormat,  GDALDataType gdalDataType)
 	{
+		rsgis::RSGISProgressReporter progress("RSGISCalcImage::calcImageWithinPolygon");
+		RSGISImageIOScope ioScope(this->ioPolicy);
 		GDALAllRegister();
 		RSGISImageUtils imgUtils;
 		double *gdalTranslation = new double[6];
@@ -12502,7 +12678,7 @@ namespace rsgis{namespace img{
 				throw RSGISImageBandException("ENVI driver does not exists..");
 			}
 
-			outputImageDS = gdalDriver->Create(outputImage.c_str(), width, height, this->numOutBands, gdalDataType, NULL);
+			outputImageDS = this->ioPolicy->createImage(gdalDriver, outputImage, width, height, this->numOutBands, gdalDataType);
 			
 			if(outputImageDS == NULL)
 			{
@@ -12570,6 +12746,7 @@ namespace rsgis{namespace img{
 			if(height > 100)
 			{
 				std::cout << "Started " << std::flush;
+				progress.start(((unsigned long long)width) * height);
 			}
             // Loop images to process data
 			for(int i = 0; i < height; i++)
@@ -12577,12 +12754,13 @@ namespace rsgis{namespace img{
 				if((feedback != 0) && ((i % feedback) == 0))
 				{
 					std::cout << "." << feedbackCounter << "." << std::flush;
+					progress.updateOrThrow<RSGISImageCalcException>(feedbackCounter);
 					feedbackCounter = feedbackCounter + 10;
 				}
 				
 				for(int n = 0; n < numInBands; n++)
 				{
-					inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], (bandOffsets[n][1]+i), width, 1, inputData[n], width, 1, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], (bandOffsets[n][1]+i), width, 1, inputData[n], width, 1, GDT_Float32, 0, 0);
 				}
 				
 				for(int j = 0; j < width; j++)
@@ -12719,12 +12897,14 @@ namespace rsgis{namespace img{
 				
 				for(int n = 0; n < this->numOutBands; n++)
 				{
-					outputRasterBands[n]->RasterIO(GF_Write, 0, i, width, 1, outputData[n], width, 1, GDT_Float64, 0, 0);
+					instrumentedRasterIO(outputRasterBands[n], GF_Write, 0, i, width, 1, outputData[n], width, 1, GDT_Float64, 0, 0);
 				}
 			}
 			if (height > 100) 
 			{
 				std::cout << " Complete.\n";
+				recordGDALCacheUsage();
+				progress.complete();
 			}
 		}
 		catch(RSGISImageCalcException& e)
@@ -12880,6 +13060,7 @@ namespace rsgis{namespace img{
 			throw e;
 		}
 		
+		this->ioPolicy->finaliseImage(outputImageDS);
 		GDALClose(outputImageDS);
 		
 		if(gdalTranslation != NULL)
@@ -13079,11 +13260,11 @@ namespace rsgis{namespace img{
 				
 				for(int n = 0; n < numInBands; n++)
 				{
-					inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], (bandOffsets[n][1]+i), width, 1, inputData[n], width, 1, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], (bandOffsets[n][1]+i), width, 1, inputData[n], width, 1, GDT_Float32, 0, 0);
 				}
 				for(int n = 0; n < this->numOutBands; n++)
 				{
-					outputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], (bandOffsets[n][1]+i), width, 1, outputData[n], width, 1, GDT_Float64, 0, 0);
+					instrumentedRasterIO(outputRasterBands[n], GF_Read, bandOffsets[n][0], (bandOffsets[n][1]+i), width, 1, outputData[n], width, 1, GDT_Float64, 0, 0);
 				}
 				
 				
@@ -13220,7 +13401,7 @@ namespace rsgis{namespace img{
 				
 				for(int n = 0; n < this->numOutBands; n++)
 				{
-					outputRasterBands[n]->RasterIO(GF_Write, bandOffsets[n][0], (bandOffsets[n][1]+i), width, 1, outputData[n], width, 1, GDT_Float64, 0, 0);
+					instrumentedRasterIO(outputRasterBands[n], GF_Write, bandOffsets[n][0], (bandOffsets[n][1]+i), width, 1, outputData[n], width, 1, GDT_Float64, 0, 0);
 				}
 			}
 			if (height > 100) 
@@ -13573,7 +13754,7 @@ namespace rsgis{namespace img{
 			{				
 				for(int n = 0; n < numInBands; n++)
 				{
-					inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], (bandOffsets[n][1]+i), width, 1, inputData[n], width, 1, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], (bandOffsets[n][1]+i), width, 1, inputData[n], width, 1, GDT_Float32, 0, 0);
 				}
 				
 				for(int j = 0; j < width; j++)
@@ -13957,7 +14138,7 @@ namespace rsgis{namespace img{
             bool readSuccess = true;
             for(int n = 0; n < numInBands; n++)
             {
-                readSuccess = inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], (bandOffsets[n][1]), width, height, inputData[n], width, height, GDT_Float32, 0, 0);
+                readSuccess = instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[n][0], (bandOffsets[n][1]), width, height, inputData[n], width, height, GDT_Float32, 0, 0);
             }
 
             // Loop images to process data
@@ -14362,16 +14543,16 @@ namespace rsgis{namespace img{
 					feedbackCounter = feedbackCounter + 10;
 				}
 				counter = 0;
-				inputMaskBand[0]->RasterIO(GF_Read, bandOffsets[counter][0], (bandOffsets[counter][1]+i), width, 1, inputMask[0], width, 1, GDT_Float32, 0, 0);
+				instrumentedRasterIO(inputMaskBand[0], GF_Read, bandOffsets[counter][0], (bandOffsets[counter][1]+i), width, 1, inputMask[0], width, 1, GDT_Float32, 0, 0);
 				counter++;
 				for(int n = 0; n < numInBands; n++)
 				{
-					inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[counter][0], (bandOffsets[counter][1]+i), width, 1, inputData[n], width, 1, GDT_Float32, 0, 0);
+					instrumentedRasterIO(inputRasterBands[n], GF_Read, bandOffsets[counter][0], (bandOffsets[counter][1]+i), width, 1, inputData[n], width, 1, GDT_Float32, 0, 0);
 					counter++;
 				}
 				for(int n = 0; n < this->numOutBands; n++)
 				{
-					outputRasterBands[n]->RasterIO(GF_Read, bandOffsets[counter][0], (bandOffsets[counter][1]+i), width, 1, outputData[n], width, 1, GDT_Float32, 0, 0);
+					instrumentedRasterIO(outputRasterBands[n], GF_Read, bandOffsets[counter][0], (bandOffsets[counter][1]+i), width, 1, outputData[n], width, 1, GDT_Float32, 0, 0);
 					counter++;
 				}
 				
@@ -14407,7 +14588,7 @@ namespace rsgis{namespace img{
 				
 				for(int n = 0; n < this->numOutBands; n++)
 				{
-					outputRasterBands[n]->RasterIO(GF_Write, bandOffsets[numInBands+1+n][0], (bandOffsets[numInBands+1+n][1]+i), width, 1, outputData[n], width, 1, GDT_Float32, 0, 0);
+					instrumentedRasterIO(outputRasterBands[n], GF_Write, bandOffsets[numInBands+1+n][0], (bandOffsets[numInBands+1+n][1]+i), width, 1, outputData[n], width, 1, GDT_Float32, 0, 0);
 				}
 			}
 			if (height > 100) 
@@ -14656,6 +14837,8 @@ namespace rsgis{namespace img{
 	
     void RSGISCalcImage::calcImageBorderPixels(GDALDataset *dataset, bool returnInt)
     {
+        rsgis::RSGISProgressReporter progress("RSGISCalcImage::calcImageBorderPixels");
+        RSGISImageIOScope ioScope(this->ioPolicy);
         GDALAllRegister();
         
         try
@@ -14696,12 +14879,12 @@ namespace rsgis{namespace img{
                 {
                     if(returnInt)
                     {
-                        gdalBands[b]->RasterIO(GF_Read, x, 0, 1, 1, &tmpVal, 1, 1, GDT_Int32, 0, 0);
+                        instrumentedRasterIO(gdalBands[b], GF_Read, x, 0, 1, 1, &tmpVal, 1, 1, GDT_Int32, 0, 0);
                         pxlIntVals[b] = tmpVal;
                     }
                     else
                     {
-                        gdalBands[b]->RasterIO(GF_Read, x, 0, 1, 1, &pxlFloatVals[b], 1, 1, GDT_Float32, 0, 0);
+                        instrumentedRasterIO(gdalBands[b], GF_Read, x, 0, 1, 1, &pxlFloatVals[b], 1, 1, GDT_Float32, 0, 0);
                     }
                 }
                 this->calc->calcImageValue(pxlIntVals, numIntVals, pxlFloatVals, numfloatVals);
@@ -14711,12 +14894,12 @@ namespace rsgis{namespace img{
                 {
                     if(returnInt)
                     {
-                        gdalBands[b]->RasterIO(GF_Read, x, (imgHeight-1), 1, 1, &tmpVal, 1, 1, GDT_Int32, 0, 0);
+                        instrumentedRasterIO(gdalBands[b], GF_Read, x, (imgHeight-1), 1, 1, &tmpVal, 1, 1, GDT_Int32, 0, 0);
                         pxlIntVals[b] = tmpVal;
                     }
                     else
                     {
-                        gdalBands[b]->RasterIO(GF_Read, x, (imgHeight-1), 1, 1, &pxlFloatVals[b], 1, 1, GDT_Float32, 0, 0);
+                        instrumentedRasterIO(gdalBands[b], GF_Read, x, (imgHeight-1), 1, 1, &pxlFloatVals[b], 1, 1, GDT_Float32, 0, 0);
                     }
                 }
                 this->calc->calcImageValue(pxlIntVals, numIntVals, pxlFloatVals, numfloatVals);
@@ -14731,11 +14914,11 @@ namespace rsgis{namespace img{
                 {
                     if(returnInt)
                     {
-                        gdalBands[b]->RasterIO(GF_Read, 0, y, 1, 1, &pxlIntVals[b], 1, 1, GDT_Int32, 0, 0);
+                        instrumentedRasterIO(gdalBands[b], GF_Read, 0, y, 1, 1, &pxlIntVals[b], 1, 1, GDT_Int32, 0, 0);
                     }
                     else
                     {
-                        gdalBands[b]->RasterIO(GF_Read, 0, y, 1, 1, &pxlFloatVals[b], 1, 1, GDT_Float32, 0, 0);
+                        instrumentedRasterIO(gdalBands[b], GF_Read, 0, y, 1, 1, &pxlFloatVals[b], 1, 1, GDT_Float32, 0, 0);
                     }
                 }
                 this->calc->calcImageValue(pxlIntVals, numIntVals, pxlFloatVals, numfloatVals);
@@ -14745,11 +14928,11 @@ namespace rsgis{namespace img{
                 {
                     if(returnInt)
                     {
-                        gdalBands[b]->RasterIO(GF_Read, (imgWidth-1), y, 1, 1, &pxlIntVals[b], 1, 1, GDT_Int32, 0, 0);
+                        instrumentedRasterIO(gdalBands[b], GF_Read, (imgWidth-1), y, 1, 1, &pxlIntVals[b], 1, 1, GDT_Int32, 0, 0);
                     }
                     else
                     {
-                        gdalBands[b]->RasterIO(GF_Read, (imgWidth-1), y, 1, 1, &pxlFloatVals[b], 1, 1, GDT_Float32, 0, 0);
+                        instrumentedRasterIO(gdalBands[b], GF_Read, (imgWidth-1), y, 1, 1, &pxlFloatVals[b], 1, 1, GDT_Float32, 0, 0);
                     }
                 }
                 this->calc->calcImageValue(pxlIntVals, numIntVals, pxlFloatVals, numfloatVals);
@@ -14780,13 +14963,16 @@ namespace rsgis{namespace img{
     
     
     
-    RSGISCalcImageMultiImgRes::RSGISCalcImageMultiImgRes(RSGISCalcValuesFromMultiResInputs *valueCalcSum)
+    RSGISCalcImageMultiImgRes::RSGISCalcImageMultiImgRes(RSGISCalcValuesFromMultiResInputs *valueCalcSum, RSGISImageIOPolicy *ioPolicy)
     {
         this->valueCalcSum = valueCalcSum;
+        this->ioPolicy = (ioPolicy == NULL)?RSGISImageIOPolicy::getDefaultPolicy():ioPolicy;
     }
     
     void RSGISCalcImageMultiImgRes::calcImageHighResForLowRegions(GDALDataset *refDataset, GDALDataset *statsDataset, unsigned int statsImgBand, std::string outputImage, std::string gdalFormat, GDALDataType gdalDataType, bool useNoDataVal, unsigned int xIOGrid, unsigned int yIOGrid, bool setOutNames, std::string *bandNames)
     {
+        rsgis::RSGISProgressReporter progress("RSGISCalcImageMultiImgRes::calcImageHighResForLowRegions");
+        RSGISImageIOScope ioScope(this->ioPolicy);
         try
         {
             if( (statsImgBand == 0) || (statsImgBand > statsDataset->GetRasterCount()) )
@@ -14928,7 +15114,7 @@ namespace rsgis{namespace img{
             }
             std::cout << "New image width = " << refPxlWidth << " height = " << refPxlHeight << " bands = " << numOutImgBands << std::endl;
             
-            GDALDataset *outputImageDS = gdalDriver->Create(outputImage.c_str(), refPxlWidth, refPxlHeight, numOutImgBands, gdalDataType, NULL);
+            GDALDataset *outputImageDS = this->ioPolicy->createImage(gdalDriver, outputImage, refPxlWidth, refPxlHeight, numOutImgBands, gdalDataType);
             
             if(outputImageDS == NULL)
             {
@@ -14996,6 +15182,7 @@ namespace rsgis{namespace img{
             long blockCounter = 0;
             int feedbackCounter = 0;
             std::cout << "Started " << std::flush;
+            progress.start(((unsigned long long)refPxlWidth) * refPxlHeight);
             for(long i = 0; i < nYBlocks; i++)
             {
                 colOffsetStats = 0;
@@ -15005,11 +15192,12 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && ((blockCounter % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
                     // Read Block
-                    if(statsBand->RasterIO(GF_Read, colOffsetStats, rowOffsetStats, xIOGridStats, yIOGridStats, statsDataArr, xIOGridStats, yIOGridStats, GDT_Float32, 0, 0))
+                    if(instrumentedRasterIO(statsBand, GF_Read, colOffsetStats, rowOffsetStats, xIOGridStats, yIOGridStats, statsDataArr, xIOGridStats, yIOGridStats, GDT_Float32, 0, 0))
                     {
                         throw RSGISImageException("Failed to read image data from stats band.");
                     }
@@ -15043,7 +15231,7 @@ namespace rsgis{namespace img{
                     // Write Block
                     for(unsigned int n = 0; n < numOutImgBands; ++n)
                     {
-                        if(outBands[n]->RasterIO(GF_Write, colOffsetRef, rowOffsetRef, xIOGrid, yIOGrid, refDataArrOuts[n], xIOGrid, yIOGrid, GDT_Float64, 0, 0))
+                        if(instrumentedRasterIO(outBands[n], GF_Write, colOffsetRef, rowOffsetRef, xIOGrid, yIOGrid, refDataArrOuts[n], xIOGrid, yIOGrid, GDT_Float64, 0, 0))
                         {
                             throw RSGISImageException("Failed to write image data to output image.");
                         }
@@ -15059,11 +15247,12 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && ((blockCounter % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
                     // Read Block
-                    if(statsBand->RasterIO(GF_Read, colOffsetStats, rowOffsetStats, remainColsStats, yIOGridStats, statsDataArr, remainColsStats, yIOGridStats, GDT_Float32, 0, 0))
+                    if(instrumentedRasterIO(statsBand, GF_Read, colOffsetStats, rowOffsetStats, remainColsStats, yIOGridStats, statsDataArr, remainColsStats, yIOGridStats, GDT_Float32, 0, 0))
                     {
                         throw RSGISImageException("Failed to read image data from stats band.");
                     }
@@ -15097,7 +15286,7 @@ namespace rsgis{namespace img{
                     // Write Block
                     for(unsigned int n = 0; n < numOutImgBands; ++n)
                     {
-                        if(outBands[n]->RasterIO(GF_Write, colOffsetRef, rowOffsetRef, remainCols, yIOGrid, refDataArrOuts[n], remainCols, yIOGrid, GDT_Float64, 0, 0))
+                        if(instrumentedRasterIO(outBands[n], GF_Write, colOffsetRef, rowOffsetRef, remainCols, yIOGrid, refDataArrOuts[n], remainCols, yIOGrid, GDT_Float64, 0, 0))
                         {
                             throw RSGISImageException("Failed to write image data to output image.");
                         }
@@ -15121,11 +15310,12 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && ((blockCounter % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
                     // Read Block
-                    if(statsBand->RasterIO(GF_Read, colOffsetStats, rowOffsetStats, xIOGridStats, remainRowsStats, statsDataArr, xIOGridStats, remainRowsStats, GDT_Float32, 0, 0))
+                    if(instrumentedRasterIO(statsBand, GF_Read, colOffsetStats, rowOffsetStats, xIOGridStats, remainRowsStats, statsDataArr, xIOGridStats, remainRowsStats, GDT_Float32, 0, 0))
                     {
                         throw RSGISImageException("Failed to read image data from stats band.");
                     }
@@ -15159,7 +15349,7 @@ namespace rsgis{namespace img{
                     // Write Block
                     for(unsigned int n = 0; n < numOutImgBands; ++n)
                     {
-                        if(outBands[n]->RasterIO(GF_Write, colOffsetRef, rowOffsetRef, xIOGrid, remainRows, refDataArrOuts[n], xIOGrid, remainRows, GDT_Float64, 0, 0))
+                        if(instrumentedRasterIO(outBands[n], GF_Write, colOffsetRef, rowOffsetRef, xIOGrid, remainRows, refDataArrOuts[n], xIOGrid, remainRows, GDT_Float64, 0, 0))
                         {
                             throw RSGISImageException("Failed to write image data to output image.");
                         }
@@ -15175,11 +15365,12 @@ namespace rsgis{namespace img{
                     if((feedback != 0) && ((blockCounter % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        progress.updateOrThrow<RSGISImageException>(feedbackCounter);
                         feedbackCounter = feedbackCounter + 10;
                     }
                     
                     // Read Block
-                    if(statsBand->RasterIO(GF_Read, colOffsetStats, rowOffsetStats, remainColsStats, remainRowsStats, statsDataArr, remainColsStats, remainRowsStats, GDT_Float32, 0, 0))
+                    if(instrumentedRasterIO(statsBand, GF_Read, colOffsetStats, rowOffsetStats, remainColsStats, remainRowsStats, statsDataArr, remainColsStats, remainRowsStats, GDT_Float32, 0, 0))
                     {
                         throw RSGISImageException("Failed to read image data from stats band.");
                     }
@@ -15213,7 +15404,7 @@ namespace rsgis{namespace img{
                     // Write Block
                     for(unsigned int n = 0; n < numOutImgBands; ++n)
                     {
-                        if(outBands[n]->RasterIO(GF_Write, colOffsetRef, rowOffsetRef, remainCols, remainRows, refDataArrOuts[n], remainCols, remainRows, GDT_Float64, 0, 0))
+                        if(instrumentedRasterIO(outBands[n], GF_Write, colOffsetRef, rowOffsetRef, remainCols, remainRows, refDataArrOuts[n], remainCols, remainRows, GDT_Float64, 0, 0))
                         {
                             throw RSGISImageException("Failed to write image data to output image.");
                         }
@@ -15227,7 +15418,10 @@ namespace rsgis{namespace img{
                 rowOffsetRef += remainRows;
             }
             std::cout << " Complete.\n";
+            recordGDALCacheUsage();
+            progress.complete();
             
+            this->ioPolicy->finaliseImage(outputImageDS);
             GDALClose(outputImageDS);
             
             for(unsigned int i = 0; i < numOutImgBands; ++i)
@@ -37,10 +37,14 @@
 #include "geos/geom/CoordinateArraySequence.h"
 #include "geos/geom/PrecisionModel.h"
 
+#include "common/RSGISInstrumentation.h"
+
 #include "img/RSGISPixelInPoly.h"
 #include "img/RSGISImageCalcException.h"
 #include "img/RSGISCalcImageValue.h"
 #include "img/RSGISImageUtils.h"
+#include "img/RSGISImageIOPolicy.h"
+#include "img/RSGISInstrumentedRasterIO.h"
 
 #include "math/RSGISMathsUtils.h"
 
@@ -64,7 +68,7 @@ namespace rsgis
 		class DllExport RSGISCalcImage
 			{
 			public:
-				RSGISCalcImage(RSGISCalcImageValue *valueCalc, std::string proj="", bool useImageProj=true);
+				RSGISCalcImage(RSGISCalcImageValue *valueCalc, std::string proj="", bool useImageProj=true, RSGISImageIOPolicy *ioPolicy=NULL);
 				void calcImage(GDALDataset **datasets, int numDS, std::string outputImage, bool setOutNames = false, std::string *bandNames = NULL, std::string gdalFormat="KEA", GDALDataType gdalDataType=GDT_Float32);
                 void calcImage(GDALDataset **datasets, int numDS, std::string outputImage, std::string outputRefIntImage, std::string gdalFormat="KEA", GDALDataType gdalDataType=GDT_Float32);
 				void calcImage(GDALDataset **datasets, int numDS, GDALDataset *outputImageDS);
@@ -100,17 +104,19 @@ namespace rsgis
 				int numOutBands;
 				std::string proj;
 				bool useImageProj;
+				RSGISImageIOPolicy *ioPolicy;
 			};
         
         
         class DllExport RSGISCalcImageMultiImgRes
         {
         public:
-            RSGISCalcImageMultiImgRes(RSGISCalcValuesFromMultiResInputs *valueCalcSum);
+            RSGISCalcImageMultiImgRes(RSGISCalcValuesFromMultiResInputs *valueCalcSum, RSGISImageIOPolicy *ioPolicy=NULL);
             void calcImageHighResForLowRegions(GDALDataset *refDataset, GDALDataset *statsDataset, unsigned int statsImgBand, std::string outputImage, std::string gdalFormat="KEA", GDALDataType gdalDataType=GDT_Float32, bool useNoDataVal=true, unsigned int xIOGrid=16, unsigned int yIOGrid=16, bool setOutNames = false, std::string *bandNames = NULL);
             virtual ~RSGISCalcImageMultiImgRes();
         protected:
             RSGISCalcValuesFromMultiResInputs *valueCalcSum;
+            RSGISImageIOPolicy *ioPolicy;
         };
         
         
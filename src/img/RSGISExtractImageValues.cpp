@@ -199,61 +199,39 @@ namespace rsgis{namespace img{
 
             if(nRows > nSamples)
             {
-                unsigned int blockSize = 1000;
-                unsigned int nFullBlocks = (int)floor(((double)nRows)/((double)blockSize));
-                unsigned int remain = nRows - (blockSize*nFullBlocks);
-                float *dataBlock = new float[nRows*nCols];
-
-                float propSamples = ((float)nSamples) / ((float)nRows);
+                // The rows to be kept are selected up front so each block is read once
+                // and blocks without a selected row are not read at all.
+                std::vector<unsigned long> sampleIdxs;
+                RSGISStratifiedRandomSampler::sampleIndexes(nRows, nSamples, seed, &sampleIdxs);
 
-                unsigned int samplesPerBlock = (unsigned int)(ceil(((float)blockSize) * propSamples));
-                unsigned int samples4Remain = (unsigned int)(ceil(((float)remain) * propSamples));
-                unsigned int totalSamples = (samplesPerBlock * nFullBlocks) + samples4Remain;
+                unsigned int blockSize = 1000;
+                float *dataBlock = new float[((size_t)blockSize)*nCols];
 
                 rsgis::utils::RSGISExportColumnData2HDF exportCols2HDF;
                 exportCols2HDF.createFile(outputH5, nCols, std::string("Sampled Pixels Extracted"), H5::PredType::IEEE_F32LE);
-                float *row = new float[nCols];
 
-                boost::mt19937 randomGen;
-                randomGen.seed(seed);
-                boost::uniform_int<> randomDist(0, blockSize);
-                boost::variate_generator<boost::mt19937&, boost::uniform_int<> > randomVal(randomGen, randomDist);
-
-                unsigned int ranIdx = 0;
-                unsigned int nRowsOff = 0;
-                for(unsigned int i = 0; i < nFullBlocks; ++i)
+                std::vector<unsigned long>::iterator iterIdxs = sampleIdxs.begin();
+                unsigned int nBlockRows = 0;
+                for(unsigned int nRowsOff = 0; (nRowsOff < nRows) && (iterIdxs != sampleIdxs.end()); nRowsOff += blockSize)
                 {
-                    readHDFCol.getDataRows(dataBlock, nCols, blockSize, H5::PredType::NATIVE_FLOAT, nRowsOff, blockSize);
-
-                    for(unsigned int j = 0; j < samplesPerBlock; ++j)
+                    nBlockRows = blockSize;
+                    if((nRowsOff + nBlockRows) > nRows)
                     {
-                        ranIdx = randomVal();
-                        for(unsigned int n = 0; n < nCols; ++n)
-                        {
-                            row[n] = dataBlock[(ranIdx*nCols)+n];
-                        }
-                        exportCols2HDF.addDataRow(row, H5::PredType::NATIVE_FLOAT);
+                        nBlockRows = nRows - nRowsOff;
+                    }
+                    if((*iterIdxs) >= (nRowsOff + nBlockRows))
+                    {
+                        continue;
                     }
-                    nRowsOff += blockSize;
-                }
-                if(remain > 0)
-                {
-                    boost::uniform_int<> randomDist(0, remain);
-                    boost::variate_generator<boost::mt19937&, boost::uniform_int<> > randomVal(randomGen, randomDist);
 
-                    readHDFCol.getDataRows(dataBlock, nCols, blockSize, H5::PredType::NATIVE_FLOAT, nRowsOff, remain);
-                    for(unsigned int j = 0; j < samples4Remain; ++j)
+                    readHDFCol.getDataRows(dataBlock, nCols, blockSize, H5::PredType::NATIVE_FLOAT, nRowsOff, nBlockRows);
+                    while((iterIdxs != sampleIdxs.end()) && ((*iterIdxs) < (nRowsOff + nBlockRows)))
                     {
-                        ranIdx = randomVal();
-                        for(unsigned int n = 0; n < nCols; ++n)
-                        {
-                            row[n] = dataBlock[(ranIdx*nCols)+n];
-                        }
-                        exportCols2HDF.addDataRow(row, H5::PredType::NATIVE_FLOAT);
+                        exportCols2HDF.addDataRow(&dataBlock[((*iterIdxs)-nRowsOff)*nCols], H5::PredType::NATIVE_FLOAT);
+                        ++iterIdxs;
                     }
                 }
                 exportCols2HDF.close();
-                delete[] row;
                 delete[] dataBlock;
             }
             else
@@ -283,115 +261,44 @@ namespace rsgis{namespace img{
 
             if(nRows > nSamples)
             {
-                unsigned int blockSize = 1000;
-                unsigned int nFullBlocks = (int)floor(((double)nRows)/((double)blockSize));
-                unsigned int remain = nRows - (blockSize*nFullBlocks);
-                float *dataBlock = new float[nRows*nCols];
-
-                float propSamples = ((float)nSamples) / ((float)nRows);
+                std::vector<unsigned long> sampleIdxs;
+                RSGISStratifiedRandomSampler::sampleIndexes(nRows, nSamples, seed, &sampleIdxs);
 
-                unsigned int samplesPerBlock = (unsigned int)(ceil(((float)blockSize) * propSamples));
-                unsigned int samples4Remain = (unsigned int)(ceil(((float)remain) * propSamples));
-                //unsigned int totalSamples = (samplesPerBlock * nFullBlocks) + samples4Remain;
+                unsigned int blockSize = 1000;
+                float *dataBlock = new float[((size_t)blockSize)*nCols];
 
                 rsgis::utils::RSGISExportColumnData2HDF exportCols2HDF_P1;
                 exportCols2HDF_P1.createFile(outputP1H5, nCols, std::string("Sampled Pixels Extracted"), H5::PredType::IEEE_F32LE);
                 rsgis::utils::RSGISExportColumnData2HDF exportCols2HDF_P2;
                 exportCols2HDF_P2.createFile(outputP2H5, nCols, std::string("Sampled Pixels Extracted"), H5::PredType::IEEE_F32LE);
-                float *row = new float[nCols];
-                unsigned int *ranIdxes = new unsigned int[samplesPerBlock];
-
-                boost::mt19937 randomGen;
-                randomGen.seed(seed);
-                boost::uniform_int<> randomDist(0, blockSize);
-                boost::variate_generator<boost::mt19937&, boost::uniform_int<> > randomVal(randomGen, randomDist);
 
-                bool found = false;
-                unsigned int ranIdx = 0;
-                unsigned int nRowsOff = 0;
-                for(unsigned int i = 0; i < nFullBlocks; ++i)
+                std::vector<unsigned long>::iterator iterIdxs = sampleIdxs.begin();
+                unsigned int nBlockRows = 0;
+                for(unsigned int nRowsOff = 0; nRowsOff < nRows; nRowsOff += blockSize)
                 {
-                    readHDFCol.getDataRows(dataBlock, nCols, blockSize, H5::PredType::NATIVE_FLOAT, nRowsOff, blockSize);
-
-                    for(unsigned int j = 0; j < samplesPerBlock; ++j)
+                    nBlockRows = blockSize;
+                    if((nRowsOff + nBlockRows) > nRows)
                     {
-                        ranIdx = randomVal();
-                        for(unsigned int n = 0; n < nCols; ++n)
-                        {
-                            row[n] = dataBlock[(ranIdx*nCols)+n];
-                        }
-                        exportCols2HDF_P1.addDataRow(row, H5::PredType::NATIVE_FLOAT);
-                        ranIdxes[j] = ranIdx;
+                        nBlockRows = nRows - nRowsOff;
                     }
 
-                    for(unsigned int j = 0; j < blockSize; ++j)
+                    readHDFCol.getDataRows(dataBlock, nCols, blockSize, H5::PredType::NATIVE_FLOAT, nRowsOff, nBlockRows);
+                    for(unsigned int j = 0; j < nBlockRows; ++j)
                     {
-                        found = false;
-                        for(unsigned int k = 0; k < samplesPerBlock; ++k)
+                        if((iterIdxs != sampleIdxs.end()) && ((*iterIdxs) == (nRowsOff + j)))
                         {
-                            if(ranIdxes[k] == j)
-                            {
-                                found = true;
-                                break;
-                            }
+                            exportCols2HDF_P1.addDataRow(&dataBlock[((size_t)j)*nCols], H5::PredType::NATIVE_FLOAT);
+                            ++iterIdxs;
                         }
-
-                        if(!found)
+                        else
                         {
-                            for(unsigned int n = 0; n < nCols; ++n)
-                            {
-                                row[n] = dataBlock[(j*nCols)+n];
-                            }
-                            exportCols2HDF_P2.addDataRow(row, H5::PredType::NATIVE_FLOAT);
-                        }
-                    }
-
-                    nRowsOff += blockSize;
-                }
-                if(remain > 0)
-                {
-                    boost::uniform_int<> randomDist(0, remain);
-                    boost::variate_generator<boost::mt19937&, boost::uniform_int<> > randomVal(randomGen, randomDist);
-
-                    readHDFCol.getDataRows(dataBlock, nCols, blockSize, H5::PredType::NATIVE_FLOAT, nRowsOff, remain);
-                    for(unsigned int j = 0; j < samples4Remain; ++j)
-                    {
-                        ranIdx = randomVal();
-                        for(unsigned int n = 0; n < nCols; ++n)
-                        {
-                            row[n] = dataBlock[(ranIdx*nCols)+n];
-                        }
-                        exportCols2HDF_P1.addDataRow(row, H5::PredType::NATIVE_FLOAT);
-                        ranIdxes[j] = ranIdx;
-                    }
-
-                    for(unsigned int j = 0; j < remain; ++j)
-                    {
-                        found = false;
-                        for(unsigned int k = 0; k < samples4Remain; ++k)
-                        {
-                            if(ranIdxes[k] == j)
-                            {
-                                found = true;
-                                break;
-                            }
-                        }
-
-                        if(!found)
-                        {
-                            for(unsigned int n = 0; n < nCols; ++n)
-                            {
-                                row[n] = dataBlock[(j*nCols)+n];
-                            }
-                            exportCols2HDF_P2.addDataRow(row, H5::PredType::NATIVE_FLOAT);
+                            exportCols2HDF_P2.addDataRow(&dataBlock[((size_t)j)*nCols], H5::PredType::NATIVE_FLOAT);
                         }
                     }
                 }
                 exportCols2HDF_P1.close();
                 exportCols2HDF_P2.close();
-                delete[] row;
                 delete[] dataBlock;
-                delete[] ranIdxes;
             }
             else
             {
@@ -603,7 +510,12 @@ namespace rsgis{namespace img{
             OGRFeature *poFeature = new OGRFeature(featDefn);
             OGRPoint *pt = new OGRPoint(centre.x, centre.y, 0.0);
             poFeature->SetGeometryDirectly(pt);
-            vecLayer->CreateFeature(poFeature);
+            if(vecLayer->CreateFeature(poFeature) != OGRERR_NONE)
+            {
+                OGRFeature::DestroyFeature(poFeature);
+                throw RSGISImageCalcException("Failed to write the point to the vector layer.");
+            }
+            OGRFeature::DestroyFeature(poFeature);
         }
     }
 
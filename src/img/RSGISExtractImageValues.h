@@ -34,6 +34,7 @@
 #include "img/RSGISImageCalcException.h"
 #include "img/RSGISCalcImageValue.h"
 #include "img/RSGISCalcImage.h"
+#include "img/RSGISStratifiedRandomSampler.h"
 
 #include "utils/RSGISExportData2HDF.h"
 
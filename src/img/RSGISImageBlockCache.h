@@ -0,0 +1,228 @@
+/*
+ *  RSGISImageBlockCache.h
+ *  RSGIS_LIB
+ *
+ *  Created by agent on 19/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISImageBlockCache_H
+#define RSGISImageBlockCache_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <list>
+
+#include "gdal_priv.h"
+
+#include "common/RSGISImageException.h"
+
+/** The width and height (in pixels) of the blocks held by RSGISImageBlockCache. */
+#define RSGIS_IMG_BLOCK_CACHE_BLOCK_SIZE 256
+/** The default maximum number of blocks held in memory by RSGISImageBlockCache. */
+#define RSGIS_IMG_BLOCK_CACHE_MAX_BLOCKS 1024
+
+namespace rsgis{namespace img{
+
+    /**
+     * Holds square blocks of an image in memory so pixels can be read and edited in
+     * any order without a RasterIO call per pixel. A block is read (all bands) when
+     * first accessed and, once more than maxNumBlocks are held, the least recently
+     * used block is released, being written back first if it has been edited.
+     * flush() writes all the edited blocks, which must be called before the dataset
+     * is closed. T must match dataType (e.g., unsigned int and GDT_UInt32).
+     */
+    template <typename T>
+    class RSGISImageBlockCache
+    {
+    public:
+        RSGISImageBlockCache(GDALDataset *dataset, GDALDataType dataType, unsigned int blockSize=RSGIS_IMG_BLOCK_CACHE_BLOCK_SIZE, size_t maxNumBlocks=RSGIS_IMG_BLOCK_CACHE_MAX_BLOCKS)
+        {
+            this->dataset = dataset;
+            this->dataType = dataType;
+            this->width = dataset->GetRasterXSize();
+            this->height = dataset->GetRasterYSize();
+            this->numBands = dataset->GetRasterCount();
+            this->blockSize = blockSize;
+            if(this->blockSize == 0)
+            {
+                this->blockSize = RSGIS_IMG_BLOCK_CACHE_BLOCK_SIZE;
+            }
+            this->maxNumBlocks = maxNumBlocks;
+            if(this->maxNumBlocks == 0)
+            {
+                this->maxNumBlocks = 1;
+            }
+            this->nXBlocks = (this->width + this->blockSize - 1) / this->blockSize;
+            this->nYBlocks = (this->height + this->blockSize - 1) / this->blockSize;
+
+            size_t numBlocks = ((size_t)this->nXBlocks) * this->nYBlocks;
+            this->blocks.assign(numBlocks, NULL);
+            this->dirty.assign(numBlocks, false);
+            this->lruPos.resize(numBlocks);
+            this->lastBlockIdx = numBlocks;
+            this->lastBlock = NULL;
+        };
+        unsigned int getWidth(){return this->width;};
+        unsigned int getHeight(){return this->height;};
+        unsigned int getNumBands(){return this->numBands;};
+        /** Returns the value of the pixel for the band (indexed from 0). */
+        inline T getValue(unsigned int x, unsigned int y, unsigned int band=0)
+        {
+            T *block = this->getBlockForPixel(x, y);
+            return block[this->getIndexInBlock(x, y, band)];
+        };
+        /** Sets the value of the pixel for the band (indexed from 0). */
+        inline void setValue(unsigned int x, unsigned int y, T val, unsigned int band=0)
+        {
+            T *block = this->getBlockForPixel(x, y);
+            block[this->getIndexInBlock(x, y, band)] = val;
+            this->dirty.at(this->lastBlockIdx) = true;
+        };
+        /** Writes all the edited blocks to the dataset; the blocks are kept in memory. */
+        void flush()
+        {
+            for(size_t i = 0; i < this->blocks.size(); ++i)
+            {
+                if((this->blocks.at(i) != NULL) && this->dirty.at(i))
+                {
+                    this->writeBlock(i);
+                }
+            }
+        };
+        /** Releases the blocks without writing them; call flush() first to keep the edits. */
+        ~RSGISImageBlockCache()
+        {
+            for(size_t i = 0; i < this->blocks.size(); ++i)
+            {
+                if(this->blocks.at(i) != NULL)
+                {
+                    delete[] this->blocks.at(i);
+                }
+            }
+        };
+    private:
+        inline size_t getIndexInBlock(unsigned int x, unsigned int y, unsigned int band)
+        {
+            unsigned int bX = x / this->blockSize;
+            unsigned int bY = y / this->blockSize;
+            unsigned int blockWidth = this->getBlockWidth(bX);
+            unsigned int blockHeight = this->getBlockHeight(bY);
+            return (((size_t)band) * blockWidth * blockHeight) + (((size_t)(y - (bY * this->blockSize))) * blockWidth) + (x - (bX * this->blockSize));
+        };
+        inline unsigned int getBlockWidth(unsigned int bX)
+        {
+            return ((bX + 1) * this->blockSize <= this->width)?this->blockSize:(this->width - (bX * this->blockSize));
+        };
+        inline unsigned int getBlockHeight(unsigned int bY)
+        {
+            return ((bY + 1) * this->blockSize <= this->height)?this->blockSize:(this->height - (bY * this->blockSize));
+        };
+        inline T* getBlockForPixel(unsigned int x, unsigned int y)
+        {
+            if((x >= this->width) || (y >= this->height))
+            {
+                throw RSGISImageException("The pixel requested from the block cache is outside of the image.");
+            }
+            size_t blockIdx = (((size_t)(y / this->blockSize)) * this->nXBlocks) + (x / this->blockSize);
+            if(blockIdx != this->lastBlockIdx)
+            {
+                this->lastBlock = this->getBlock(blockIdx);
+                this->lastBlockIdx = blockIdx;
+            }
+            return this->lastBlock;
+        };
+        T* getBlock(size_t blockIdx)
+        {
+            T *block = this->blocks.at(blockIdx);
+            if(block != NULL)
+            {
+                // Move to the front of the least recently used list.
+                this->lru.splice(this->lru.begin(), this->lru, this->lruPos.at(blockIdx));
+                return block;
+            }
+
+            if(this->lru.size() >= this->maxNumBlocks)
+            {
+                size_t releaseIdx = this->lru.back();
+                if(this->dirty.at(releaseIdx))
+                {
+                    this->writeBlock(releaseIdx);
+                }
+                delete[] this->blocks.at(releaseIdx);
+                this->blocks.at(releaseIdx) = NULL;
+                this->lru.pop_back();
+            }
+
+            unsigned int bX = blockIdx % this->nXBlocks;
+            unsigned int bY = blockIdx / this->nXBlocks;
+            unsigned int blockWidth = this->getBlockWidth(bX);
+            unsigned int blockHeight = this->getBlockHeight(bY);
+            size_t numBandPxls = ((size_t)blockWidth) * blockHeight;
+            block = new T[numBandPxls * this->numBands];
+            for(unsigned int n = 0; n < this->numBands; ++n)
+            {
+                if(this->dataset->GetRasterBand(n+1)->RasterIO(GF_Read, bX * this->blockSize, bY * this->blockSize, blockWidth, blockHeight, &block[n * numBandPxls], blockWidth, blockHeight, this->dataType, 0, 0) != CE_None)
+                {
+                    delete[] block;
+                    throw RSGISImageException("Failed to read a block of the image into the block cache.");
+                }
+            }
+            this->blocks.at(blockIdx) = block;
+            this->dirty.at(blockIdx) = false;
+            this->lru.push_front(blockIdx);
+            this->lruPos.at(blockIdx) = this->lru.begin();
+            return block;
+        };
+        void writeBlock(size_t blockIdx)
+        {
+            unsigned int bX = blockIdx % this->nXBlocks;
+            unsigned int bY = blockIdx / this->nXBlocks;
+            unsigned int blockWidth = this->getBlockWidth(bX);
+            unsigned int blockHeight = this->getBlockHeight(bY);
+            size_t numBandPxls = ((size_t)blockWidth) * blockHeight;
+            T *block = this->blocks.at(blockIdx);
+            for(unsigned int n = 0; n < this->numBands; ++n)
+            {
+                if(this->dataset->GetRasterBand(n+1)->RasterIO(GF_Write, bX * this->blockSize, bY * this->blockSize, blockWidth, blockHeight, &block[n * numBandPxls], blockWidth, blockHeight, this->dataType, 0, 0) != CE_None)
+                {
+                    throw RSGISImageException("Failed to write a block from the block cache to the image.");
+                }
+            }
+            this->dirty.at(blockIdx) = false;
+        };
+        GDALDataset *dataset;
+        GDALDataType dataType;
+        unsigned int width;
+        unsigned int height;
+        unsigned int numBands;
+        unsigned int blockSize;
+        size_t maxNumBlocks;
+        unsigned int nXBlocks;
+        unsigned int nYBlocks;
+        std::vector<T*> blocks;
+        std::vector<bool> dirty;
+        std::list<size_t> lru;
+        std::vector<std::list<size_t>::iterator> lruPos;
+        size_t lastBlockIdx;
+        T *lastBlock;
+    };
+
+}}
+
+#endif
@@ -0,0 +1,252 @@
+/*
+ *  RSGISImageIOPolicy.cpp
+ *  RSGIS_LIB
+ *
+ *  Created by agent on 19/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISImageIOPolicy.h"
+
+namespace rsgis{namespace img{
+
+    RSGISImageIOPolicy::RSGISImageIOPolicy()
+    {
+        this->cacheMax = 0;
+        this->tiled = true;
+        this->blockSize = RSGIS_IO_DEFAULT_BLOCK_SIZE;
+        this->compression = "";
+        this->compressionLevel = -1;
+        this->numThreads = 1;
+        this->buildOverviews = false;
+        this->overviewResampling = "AVERAGE";
+        this->minOverviewSize = 256;
+    }
+
+    RSGISImageIOPolicy* RSGISImageIOPolicy::getDefaultPolicy()
+    {
+        static RSGISImageIOPolicy defaultPolicy;
+        return &defaultPolicy;
+    }
+
+    void RSGISImageIOPolicy::setBlockSize(unsigned int blockSize)
+    {
+        if((blockSize == 0) || ((blockSize % 16) != 0))
+        {
+            throw RSGISImageException("The block size must be a multiple of 16.");
+        }
+        this->blockSize = blockSize;
+    }
+
+    void RSGISImageIOPolicy::setCreationOption(std::string name, std::string value)
+    {
+        for(std::vector<std::pair<std::string, std::string> >::iterator iterOpts = this->creationOptions.begin(); iterOpts != this->creationOptions.end(); ++iterOpts)
+        {
+            if(EQUAL((*iterOpts).first.c_str(), name.c_str()))
+            {
+                (*iterOpts).second = value;
+                return;
+            }
+        }
+        this->creationOptions.push_back(std::pair<std::string, std::string>(name, value));
+    }
+
+    void RSGISImageIOPolicy::setBuildOverviews(bool buildOverviews, std::string resampling, unsigned int minOverviewSize)
+    {
+        this->buildOverviews = buildOverviews;
+        this->overviewResampling = resampling;
+        this->minOverviewSize = (minOverviewSize == 0)?1:minOverviewSize;
+    }
+
+    char** RSGISImageIOPolicy::getCreationOptions(GDALDriver *gdalDriver)
+    {
+        char **options = NULL;
+        if(gdalDriver == NULL)
+        {
+            return options;
+        }
+
+        std::string blockSizeStr = CPLSPrintf("%u", this->blockSize);
+        std::string driverName = gdalDriver->GetDescription();
+        if(driverName == "GTiff")
+        {
+            std::string gtiffCompress = (this->compression == "")?"LZW":this->compression;
+            if(this->tiled)
+            {
+                options = this->setDefaultOption(gdalDriver, options, "TILED", "YES");
+                options = this->setDefaultOption(gdalDriver, options, "BLOCKXSIZE", blockSizeStr);
+                options = this->setDefaultOption(gdalDriver, options, "BLOCKYSIZE", blockSizeStr);
+            }
+            options = this->setDefaultOption(gdalDriver, options, "COMPRESS", gtiffCompress);
+            if(this->compressionLevel >= 0)
+            {
+                std::string levelStr = CPLSPrintf("%d", this->compressionLevel);
+                if(EQUAL(gtiffCompress.c_str(), "ZSTD"))
+                {
+                    options = this->setDefaultOption(gdalDriver, options, "ZSTD_LEVEL", levelStr);
+                }
+                else if(EQUAL(gtiffCompress.c_str(), "DEFLATE"))
+                {
+                    options = this->setDefaultOption(gdalDriver, options, "ZLEVEL", levelStr);
+                }
+            }
+            options = this->setDefaultOption(gdalDriver, options, "BIGTIFF", "IF_SAFER");
+            if(this->numThreads != 1)
+            {
+                options = this->setDefaultOption(gdalDriver, options, "NUM_THREADS", (this->numThreads == 0)?std::string("ALL_CPUS"):std::string(CPLSPrintf("%u", this->numThreads)));
+            }
+        }
+        else if(driverName == "KEA")
+        {
+            options = this->setDefaultOption(gdalDriver, options, "IMAGEBLOCKSIZE", blockSizeStr);
+            int deflate = 1;
+            if(EQUAL(this->compression.c_str(), "NONE"))
+            {
+                deflate = 0;
+            }
+            else if(this->compressionLevel >= 0)
+            {
+                deflate = this->compressionLevel;
+            }
+            options = this->setDefaultOption(gdalDriver, options, "DEFLATE", CPLSPrintf("%d", deflate));
+        }
+        else if(driverName == "HFA")
+        {
+            options = this->setDefaultOption(gdalDriver, options, "BLOCKSIZE", blockSizeStr);
+            if((this->compression != "") && (!EQUAL(this->compression.c_str(), "NONE")))
+            {
+                options = this->setDefaultOption(gdalDriver, options, "COMPRESSED", "YES");
+            }
+        }
+
+        // Options set by the user replace the defaults.
+        for(std::vector<std::pair<std::string, std::string> >::iterator iterOpts = this->creationOptions.begin(); iterOpts != this->creationOptions.end(); ++iterOpts)
+        {
+            options = CSLSetNameValue(options, (*iterOpts).first.c_str(), (*iterOpts).second.c_str());
+        }
+        return options;
+    }
+
+    GDALDataset* RSGISImageIOPolicy::createImage(GDALDriver *gdalDriver, std::string imageFile, int xSize, int ySize, int numBands, GDALDataType dataType)
+    {
+        char **options = this->getCreationOptions(gdalDriver);
+        GDALDataset *dataset = gdalDriver->Create(imageFile.c_str(), xSize, ySize, numBands, dataType, options);
+        CSLDestroy(options);
+        return dataset;
+    }
+
+    void RSGISImageIOPolicy::finaliseImage(GDALDataset *dataset)
+    {
+        if((!this->buildOverviews) || (dataset == NULL))
+        {
+            return;
+        }
+
+        int minSize = (dataset->GetRasterXSize() < dataset->GetRasterYSize())?dataset->GetRasterXSize():dataset->GetRasterYSize();
+        std::vector<int> overviewLevels;
+        for(int level = 2; (minSize / level) >= ((int)this->minOverviewSize); level *= 2)
+        {
+            overviewLevels.push_back(level);
+        }
+        if(overviewLevels.empty())
+        {
+            return;
+        }
+
+        std::cout << "Building Overviews\n";
+        CPLErr err = dataset->BuildOverviews(this->overviewResampling.c_str(), overviewLevels.size(), &overviewLevels[0], 0, NULL, GDALDummyProgress, NULL);
+        if(err != CE_None)
+        {
+            // The image has been written so carry on without the overviews.
+            std::cerr << "Warning: Failed to build the overviews for \"" << dataset->GetDescription() << "\"\n";
+        }
+    }
+
+    bool RSGISImageIOPolicy::driverHasCreationOption(GDALDriver *gdalDriver, std::string name)
+    {
+        const char *optionList = gdalDriver->GetMetadataItem(GDAL_DMD_CREATIONOPTIONLIST, "");
+        if(optionList == NULL)
+        {
+            return false;
+        }
+        std::string optionName = std::string("name='") + name + std::string("'");
+        std::string optionNameDQ = std::string("name=\"") + name + std::string("\"");
+        std::string optionListStr = optionList;
+        return (optionListStr.find(optionName) != std::string::npos) || (optionListStr.find(optionNameDQ) != std::string::npos);
+    }
+
+    char** RSGISImageIOPolicy::setDefaultOption(GDALDriver *gdalDriver, char **options, std::string name, std::string value)
+    {
+        if(this->driverHasCreationOption(gdalDriver, name))
+        {
+            options = CSLSetNameValue(options, name.c_str(), value.c_str());
+        }
+        return options;
+    }
+
+    RSGISImageIOPolicy::~RSGISImageIOPolicy()
+    {
+
+    }
+
+
+    RSGISImageIOScope::RSGISImageIOScope(RSGISImageIOPolicy *ioPolicy)
+    {
+        this->cacheChanged = false;
+        this->prevCacheMax = 0;
+        this->numThreadsChanged = false;
+        this->hadPrevNumThreads = false;
+        this->prevNumThreads = "";
+        if(ioPolicy == NULL)
+        {
+            return;
+        }
+
+        if(ioPolicy->getCacheMax() > 0)
+        {
+            this->prevCacheMax = GDALGetCacheMax64();
+            GDALSetCacheMax64(ioPolicy->getCacheMax());
+            this->cacheChanged = true;
+        }
+
+        if(ioPolicy->getNumThreads() != 1)
+        {
+            const char *prevVal = CPLGetThreadLocalConfigOption("GDAL_NUM_THREADS", NULL);
+            if(prevVal != NULL)
+            {
+                this->hadPrevNumThreads = true;
+                this->prevNumThreads = prevVal;
+            }
+            std::string numThreadsStr = (ioPolicy->getNumThreads() == 0)?std::string("ALL_CPUS"):std::string(CPLSPrintf("%u", ioPolicy->getNumThreads()));
+            CPLSetThreadLocalConfigOption("GDAL_NUM_THREADS", numThreadsStr.c_str());
+            this->numThreadsChanged = true;
+        }
+    }
+
+    RSGISImageIOScope::~RSGISImageIOScope()
+    {
+        if(this->cacheChanged)
+        {
+            GDALSetCacheMax64(this->prevCacheMax);
+        }
+        if(this->numThreadsChanged)
+        {
+            CPLSetThreadLocalConfigOption("GDAL_NUM_THREADS", this->hadPrevNumThreads?this->prevNumThreads.c_str():NULL);
+        }
+    }
+
+}}
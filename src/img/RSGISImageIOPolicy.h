@@ -0,0 +1,136 @@
+/*
+ *  RSGISImageIOPolicy.h
+ *  RSGIS_LIB
+ *
+ *  Created by agent on 19/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISImageIOPolicy_H
+#define RSGISImageIOPolicy_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include "gdal_priv.h"
+#include "cpl_string.h"
+#include "cpl_conv.h"
+
+#include "common/RSGISImageException.h"
+
+/** The default block size (in pixels) of the images created. */
+#define RSGIS_IO_DEFAULT_BLOCK_SIZE 256
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_img_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace img{
+
+    /**
+     * How output images are created and the GDAL cache used while an operation
+     * runs. The default creation options depend on the driver:
+     *   GTiff - tiled (TILED, BLOCKXSIZE, BLOCKYSIZE), LZW compression and BIGTIFF=IF_SAFER.
+     *   KEA - IMAGEBLOCKSIZE of the block size and DEFLATE level 1.
+     *   HFA - BLOCKSIZE of the block size, compressed if a compression is set.
+     * Other drivers (e.g., ENVI) are given no default options. Defaults the driver
+     * does not list are not used and options set with setCreationOption override
+     * the defaults.
+     *
+     * The overviews are built (if requested) once the output has been written.
+     * getDefaultPolicy() is used by the engines where a policy is not given and
+     * can be changed for the process.
+     */
+    class DllExport RSGISImageIOPolicy
+    {
+    public:
+        RSGISImageIOPolicy();
+        static RSGISImageIOPolicy* getDefaultPolicy();
+        /** The GDAL block cache size in bytes while the operation runs; 0 leaves the GDAL setting (e.g., GDAL_CACHEMAX). */
+        void setCacheMax(long long cacheMax){this->cacheMax = cacheMax;};
+        long long getCacheMax(){return this->cacheMax;};
+        void setTiled(bool tiled){this->tiled = tiled;};
+        bool getTiled(){return this->tiled;};
+        /** Must be a multiple of 16. */
+        void setBlockSize(unsigned int blockSize);
+        unsigned int getBlockSize(){return this->blockSize;};
+        /** e.g., LZW, DEFLATE, ZSTD or NONE; an empty string uses the default for the driver. */
+        void setCompression(std::string compression){this->compression = compression;};
+        std::string getCompression(){return this->compression;};
+        /** The compression level (e.g., 1-9 for DEFLATE); -1 uses the default for the driver. */
+        void setCompressionLevel(int compressionLevel){this->compressionLevel = compressionLevel;};
+        int getCompressionLevel(){return this->compressionLevel;};
+        /** The number of threads used by GDAL to compress and decompress blocks; 0 uses all the CPUs. */
+        void setNumThreads(unsigned int numThreads){this->numThreads = numThreads;};
+        unsigned int getNumThreads(){return this->numThreads;};
+        void setCreationOption(std::string name, std::string value);
+        void clearCreationOptions(){this->creationOptions.clear();};
+        /** Overviews are built with factors of 2, 4, 8... until the overview would be smaller than minOverviewSize pixels. */
+        void setBuildOverviews(bool buildOverviews, std::string resampling="AVERAGE", unsigned int minOverviewSize=256);
+        bool getBuildOverviews(){return this->buildOverviews;};
+        /** The creation options for the driver, which must be freed with CSLDestroy. */
+        char** getCreationOptions(GDALDriver *gdalDriver);
+        GDALDataset* createImage(GDALDriver *gdalDriver, std::string imageFile, int xSize, int ySize, int numBands, GDALDataType dataType);
+        /** Builds the overviews of the dataset if they have been requested (the dataset can be NULL); a failure is reported but not thrown. */
+        void finaliseImage(GDALDataset *dataset);
+        ~RSGISImageIOPolicy();
+    protected:
+        bool driverHasCreationOption(GDALDriver *gdalDriver, std::string name);
+        char** setDefaultOption(GDALDriver *gdalDriver, char **options, std::string name, std::string value);
+        long long cacheMax;
+        bool tiled;
+        unsigned int blockSize;
+        std::string compression;
+        int compressionLevel;
+        unsigned int numThreads;
+        std::vector<std::pair<std::string, std::string> > creationOptions;
+        bool buildOverviews;
+        std::string overviewResampling;
+        unsigned int minOverviewSize;
+    };
+
+    /**
+     * Applies the cache size and number of threads of a policy until it is destroyed
+     * (i.e., for the operation) and then restores the previous values.
+     */
+    class DllExport RSGISImageIOScope
+    {
+    public:
+        RSGISImageIOScope(RSGISImageIOPolicy *ioPolicy);
+        ~RSGISImageIOScope();
+    protected:
+        bool cacheChanged;
+        GIntBig prevCacheMax;
+        bool numThreadsChanged;
+        bool hadPrevNumThreads;
+        std::string prevNumThreads;
+    };
+
+}}
+
+#endif
@@ -767,7 +767,7 @@ namespace rsgis{namespace img{
         
     }
     
-    void RSGISPopulateImageFromInterpolator::populateImage(rsgis::math::RSGIS2DInterpolator *interpolator, GDALDataset *image)
+    void RSGISPopulateImageFromInterpolator::populateImage(rsgis::math::RSGIS2DInterpolator *interpolator, GDALDataset *image, unsigned int numThreads)
     {
         try
         {
@@ -787,70 +787,61 @@ namespace rsgis{namespace img{
             int bufferSize = yBlockSize * width;
             imgData = (float *) CPLMalloc(sizeof(float)*(bufferSize));
             
-            int nYBlocks = floor(((double)height) / ((double)yBlockSize));
-            int remainRows = height - (nYBlocks * yBlockSize);
-            int rowOffset = 0;
-            
             double tlX = gdalTransform[0];
             double tlY = gdalTransform[3];
             double xRes = gdalTransform[1];
             double yRes = gdalTransform[5];
             
-            double cX = 0.0;
-            double cY = 0.0;
-            
+            // The interpolators which are not thread safe are run on a single thread.
+            if(!interpolator->isThreadSafe())
+            {
+                numThreads = 1;
+            }
+            numThreads = rsgis::getNumProcessingThreads(numThreads);
+            interpolator->initThreads(numThreads);
+            std::vector< std::vector<float> > tileVals(numThreads, std::vector<float>(RSGIS_INTERP_TILE_SIZE * RSGIS_INTERP_TILE_SIZE));
             
-			int feedback = height/10.0;
-			int feedbackCounter = 0;
-			std::cout << "Started" << std::flush;
-            cY = tlY;
-            for(int i = 0; i < nYBlocks; ++i)
-			{
-                for(int m = 0; m < yBlockSize; ++m)
+            // Each block of rows is split into tiles which are interpolated together so
+            // neighbouring pixels can share the search for the data points.
+            int nXTiles = ceil(((double)width) / RSGIS_INTERP_TILE_SIZE);
+            int feedbackCounter = 0;
+            std::cout << "Started" << std::flush;
+            for(int rowOffset = 0; rowOffset < height; rowOffset += yBlockSize)
+            {
+                int nRows = std::min(yBlockSize, height - rowOffset);
+                while((feedbackCounter <= 90) && ((((double)rowOffset) / height) * 100) >= feedbackCounter)
                 {
-                    if((feedback != 0) && (((i*yBlockSize)+m) % feedback) == 0)
-                    {
-                        std::cout << "." << feedbackCounter << "." << std::flush;
-                        feedbackCounter = feedbackCounter + 10;
-                    }
-                    cX = tlX;
-                    for(int j = 0; j < width; ++j)
-                    {
-                        imgData[(m*width)+j] = interpolator->getValue(cX, cY);
-                        cX += xRes;
-                    }
-                    cY += yRes;
+                    std::cout << "." << feedbackCounter << "." << std::flush;
+                    feedbackCounter = feedbackCounter + 10;
                 }
-				
-				rowOffset = yBlockSize * i;
-                outputRasterBand->RasterIO(GF_Write, 0, rowOffset, width, yBlockSize, imgData, width, yBlockSize, GDT_Float32, 0, 0);
-			}
-            
-            if(remainRows > 0)
-            {
-                for(int m = 0; m < remainRows; ++m)
+                
+                int nYTiles = ceil(((double)nRows) / RSGIS_INTERP_TILE_SIZE);
+                rsgis::parallelForRange(0, nXTiles * nYTiles, numThreads, 1, [&](size_t tileStart, size_t tileEnd, unsigned int threadIdx)
                 {
-                    if((feedback != 0) && ((((nYBlocks*yBlockSize)+m) % feedback) == 0))
+                    float *vals = tileVals.at(threadIdx).data();
+                    for(size_t t = tileStart; t < tileEnd; ++t)
                     {
-                        std::cout << "." << feedbackCounter << "." << std::flush;
-                        feedbackCounter = feedbackCounter + 10;
+                        int xOff = (t % nXTiles) * RSGIS_INTERP_TILE_SIZE;
+                        int yOff = (t / nXTiles) * RSGIS_INTERP_TILE_SIZE;
+                        int nX = std::min(RSGIS_INTERP_TILE_SIZE, width - xOff);
+                        int nY = std::min(RSGIS_INTERP_TILE_SIZE, nRows - yOff);
+                        interpolator->getThreadValues(threadIdx, tlX + (xOff * xRes), tlY + ((rowOffset + yOff) * yRes), xRes, yRes, nX, nY, vals);
+                        for(int m = 0; m < nY; ++m)
+                        {
+                            for(int j = 0; j < nX; ++j)
+                            {
+                                imgData[((yOff + m) * width) + xOff + j] = vals[(m * nX) + j];
+                            }
+                        }
                     }
-                    cX = tlX;
-                    for(int j = 0; j < width; ++j)
-                    {
-                        imgData[(m*width)+j] = interpolator->getValue(cX, cY);
-                        cX += xRes;
-                    }
-                    cY += yRes;
-                }
-				
-				rowOffset = (yBlockSize * nYBlocks);
-                outputRasterBand->RasterIO(GF_Write, 0, rowOffset, width, remainRows, imgData, width, remainRows, GDT_Float32, 0, 0);
+                });
+                
+                outputRasterBand->RasterIO(GF_Write, 0, rowOffset, width, nRows, imgData, width, nRows, GDT_Float32, 0, 0);
             }
 			std::cout << " Complete.\n";
                         
             delete[] gdalTransform;
-            delete[] imgData;
+            CPLFree(imgData);
             
         }
         catch(rsgis::math::RSGISInterpolationException &e)
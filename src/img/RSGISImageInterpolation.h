@@ -25,11 +25,14 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include <algorithm>
 
 #include "gdal_priv.h"
 
 #include "common/RSGISFileException.h"
 #include "common/RSGISImageException.h"
+#include "common/RSGISThreadUtils.h"
 
 #include "img/RSGISImageInterpolator.h"
 
@@ -48,6 +51,9 @@
     #define DllExport
 #endif
 
+/** The width and height, in pixels, of the tiles interpolated together by RSGISPopulateImageFromInterpolator. */
+#define RSGIS_INTERP_TILE_SIZE 32
+
 namespace rsgis{namespace img{
 	
 	class DllExport RSGISImageInterpolation
@@ -77,7 +83,8 @@ namespace rsgis{namespace img{
     {
     public:
         RSGISPopulateImageFromInterpolator();
-        void populateImage(rsgis::math::RSGIS2DInterpolator *interpolator, GDALDataset *image);
+        /** Populates the first band of the image using the interpolator, using numThreads threads (0 for all) if the interpolator is thread safe. */
+        void populateImage(rsgis::math::RSGIS2DInterpolator *interpolator, GDALDataset *image, unsigned int numThreads=1);
         ~RSGISPopulateImageFromInterpolator();
     };
     
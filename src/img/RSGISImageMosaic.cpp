@@ -32,13 +32,14 @@
 
 namespace rsgis{namespace img{
 
-	RSGISImageMosaic::RSGISImageMosaic()
+	RSGISImageMosaic::RSGISImageMosaic(RSGISImageIOPolicy *ioPolicy)
 	{
-
+		this->ioPolicy = (ioPolicy == NULL)?RSGISImageIOPolicy::getDefaultPolicy():ioPolicy;
 	}
 
 	void RSGISImageMosaic::mosaic(std::string *inputImages, int numDS, std::string outputImage, float background, bool projFromImage, std::string proj, std::string format, GDALDataType imgDataType)
 	{
+		RSGISImageIOScope ioScope(this->ioPolicy);
 		RSGISImageUtils imgUtils;
         rsgis::math::RSGISMathsUtils mathsUtils;
         GDALAllRegister();
@@ -103,7 +104,7 @@ namespace rsgis{namespace img{
             // Create blank image
 			std::cout << "Create new image [" << width << "," << height << "] with projection: \n" << projection << std::endl;
 
-			outputDataset = imgUtils.createBlankImage(outputImage, transformation, width, height, numberBands, projection, background, bandnames, format, imgDataType);
+			outputDataset = imgUtils.createBlankImage(outputImage, transformation, width, height, numberBands, projection, background, bandnames, format, imgDataType, this->ioPolicy);
 
 			// COPY IMAGE DATA INTO THE BLANK IMAGE
 
@@ -249,11 +250,13 @@ namespace rsgis{namespace img{
 		{
 			delete[] imgTransform;
 		}
+		this->ioPolicy->finaliseImage(outputDataset);
 		GDALClose(outputDataset);
 	}
 
 	void RSGISImageMosaic::mosaicSkipVals(std::string *inputImages, int numDS, std::string outputImage, float background, float skipVal, bool projFromImage, std::string proj, unsigned int skipBand, unsigned int overlapBehaviour, std::string format, GDALDataType imgDataType)
 	{
+		RSGISImageIOScope ioScope(this->ioPolicy);
 		RSGISImageUtils imgUtils;
 		rsgis::math::RSGISMathsUtils mathsUtils;
 
@@ -321,7 +324,7 @@ namespace rsgis{namespace img{
             // Create blank image
 			std::cout << "Create new image [" << width << "," << height << "] with projection: \n" << projection << std::endl;
 
-			outputDataset = imgUtils.createBlankImage(outputImage, transformation, width, height, numberBands, projection, background, bandnames, format, imgDataType);
+			outputDataset = imgUtils.createBlankImage(outputImage, transformation, width, height, numberBands, projection, background, bandnames, format, imgDataType, this->ioPolicy);
 
 			// COPY IMAGE DATA INTO THE BLANK IMAGE
 
@@ -625,11 +628,13 @@ namespace rsgis{namespace img{
 		{
 			delete[] imgTransform;
 		}
+		this->ioPolicy->finaliseImage(outputDataset);
 		GDALClose(outputDataset);
 	}
 
 	void RSGISImageMosaic::mosaicSkipThresh(std::string *inputImages, int numDS, std::string outputImage, float background, float skipLowerThresh, float skipUpperThresh, bool projFromImage, std::string proj, unsigned int threshBand, unsigned int overlapBehaviour, std::string format, GDALDataType imgDataType)
 	{
+		RSGISImageIOScope ioScope(this->ioPolicy);
 		RSGISImageUtils imgUtils;
         rsgis::math::RSGISMathsUtils mathsUtils;
         GDALAllRegister();
@@ -696,7 +701,7 @@ namespace rsgis{namespace img{
             // Create blank image
 			std::cout << "Create new image [" << width << "," << height << "] with projection: \n" << projection << std::endl;
 
-			outputDataset = imgUtils.createBlankImage(outputImage, transformation, width, height, numberBands, projection, background, bandnames, format, imgDataType);
+			outputDataset = imgUtils.createBlankImage(outputImage, transformation, width, height, numberBands, projection, background, bandnames, format, imgDataType, this->ioPolicy);
 
 			// COPY IMAGE DATA INTO THE BLANK IMAGE
 
@@ -1000,6 +1005,7 @@ namespace rsgis{namespace img{
 		{
 			delete[] imgTransform;
 		}
+		this->ioPolicy->finaliseImage(outputDataset);
 		GDALClose(outputDataset);
 	}
 
@@ -36,6 +36,7 @@
 #include "img/RSGISImageCalcException.h"
 #include "img/RSGISCalcImageValue.h"
 #include "img/RSGISImageUtils.h"
+#include "img/RSGISImageIOPolicy.h"
 #include "img/RSGISCalcImage.h"
 
 // mark all exported classes/functions with DllExport to have
@@ -77,7 +78,7 @@ namespace rsgis{namespace img{
      */
     {
     public:
-        RSGISImageMosaic();
+        RSGISImageMosaic(RSGISImageIOPolicy *ioPolicy=NULL);
         void mosaic(std::string *inputImages, int numDS, std::string outputImage, float background, bool projFromImage, std::string proj, std::string format="ENVI", GDALDataType imgDataType=GDT_Float32);
         void mosaicSkipVals(std::string *inputImages, int numDS, std::string outputImage, float background, float skipVal, bool projFromImage, std::string proj, unsigned int skipBand = 0, unsigned int overlapBehaviour = 0, std::string format="ENVI", GDALDataType imgDataType=GDT_Float32);
         void mosaicSkipThresh(std::string *inputImages, int numDS, std::string outputImage, float background, float skipLowerThresh, float skipUpperThresh, bool projFromImage, std::string proj, unsigned int threshBand = 0, unsigned int overlapBehaviour = 0, std::string format="ENVI", GDALDataType imgDataType=GDT_Float32);
@@ -86,6 +87,8 @@ namespace rsgis{namespace img{
         void includeDatasetsIgnoreOverlap(GDALDataset *baseImage, std::string *inputImages, int numDS, int numOverlapPxls);
         void orderInImagesValidData(std::vector<std::string> images, std::vector<std::string> *orderedImages, float noDataValue);
         ~RSGISImageMosaic();
+    protected:
+        RSGISImageIOPolicy *ioPolicy;
     };
     
     class DllExport RSGISCountValidPixels : public RSGISCalcImageValue
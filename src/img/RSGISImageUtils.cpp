@@ -3422,7 +3422,7 @@ namespace rsgis{namespace img{
 		return outputImage;
 	}
     
-    GDALDataset* RSGISImageUtils::createBlankImage(std::string imageFile, double *transformation, int xSize, int ySize, int numBands, std::string projection, float value, std::vector<std::string> bandNames, std::string gdalFormat, GDALDataType imgDataType)
+    GDALDataset* RSGISImageUtils::createBlankImage(std::string imageFile, double *transformation, int xSize, int ySize, int numBands, std::string projection, float value, std::vector<std::string> bandNames, std::string gdalFormat, GDALDataType imgDataType, RSGISImageIOPolicy *ioPolicy)
 	{
 		GDALAllRegister();
 		GDALDriver *poDriver = NULL;
@@ -3457,9 +3457,12 @@ namespace rsgis{namespace img{
 				throw RSGISImageException("Image driver is not available.");
 			}
 			
-			// Create new file.
-			// Set unsupported options to NULL
-			outputImage = poDriver->Create(imageFile.c_str(), xSize, ySize, numBands, imgDataType, NULL);
+			// Create new file with the creation options of the I/O policy.
+			if(ioPolicy == NULL)
+			{
+				ioPolicy = RSGISImageIOPolicy::getDefaultPolicy();
+			}
+			outputImage = ioPolicy->createImage(poDriver, imageFile, xSize, ySize, numBands, imgDataType);
 			
 			if(outputImage == NULL)
 			{
@@ -34,6 +34,7 @@
 #include "ogrsf_frmts.h"
 
 #include "img/RSGISImageBandException.h"
+#include "img/RSGISImageIOPolicy.h"
 
 #include "math/RSGISMathsUtils.h"
 
@@ -166,7 +167,7 @@ namespace rsgis
                 bool doImageSpatAndExtMatch(GDALDataset **datasets, int numDS);
                 void exportImageToTextCol(GDALDataset *image, int band, std::string outputText);
 				GDALDataset* createBlankImage(std::string imageFile, double *transformation, int xSize, int ySize, int numBands, std::string projection, float value, std::string gdalFormat="ENVI", GDALDataType imgDataType=GDT_Float32);
-                GDALDataset* createBlankImage(std::string imageFile, double *transformation, int xSize, int ySize, int numBands, std::string projection, float value, std::vector<std::string> bandNames, std::string gdalFormat="ENVI", GDALDataType imgDataType=GDT_Float32);
+                GDALDataset* createBlankImage(std::string imageFile, double *transformation, int xSize, int ySize, int numBands, std::string projection, float value, std::vector<std::string> bandNames, std::string gdalFormat="ENVI", GDALDataType imgDataType=GDT_Float32, RSGISImageIOPolicy *ioPolicy=NULL);
 				GDALDataset* createBlankImage(std::string imageFile, geos::geom::Envelope extent, double resolution, int numBands, std::string projection, float value, std::string gdalFormat="ENVI", GDALDataType imgDataType=GDT_Float32);
 				void exportImageBands(std::string imageFile, std::string outputFilebase, std::string format);
 				void exportImageStack(std::string *inputImages, std::string *outputImages, std::string outputFormat, int numImages) ;
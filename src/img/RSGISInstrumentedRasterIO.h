@@ -0,0 +1,46 @@
+/*
+ *  RSGISInstrumentedRasterIO.h
+ *  RSGIS_LIB
+ *
+ *  Created by agent on 19/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISInstrumentedRasterIO_H
+#define RSGISInstrumentedRasterIO_H
+
+#include "gdal_priv.h"
+
+#include "common/RSGISInstrumentation.h"
+
+namespace rsgis{namespace img{
+
+    /**
+     * Calls RasterIO on the band and records the call and the number of bytes in the
+     * buffer (bufXSize x bufYSize values of bufType) with RSGISInstrumentation.
+     * The result of RasterIO is returned.
+     */
+    inline CPLErr instrumentedRasterIO(GDALRasterBand *band, GDALRWFlag rwFlag, int xOff, int yOff, int xSize, int ySize, void *data, int bufXSize, int bufYSize, GDALDataType bufType, GSpacing pixelSpace, GSpacing lineSpace)
+    {
+        CPLErr err = band->RasterIO(rwFlag, xOff, yOff, xSize, ySize, data, bufXSize, bufYSize, bufType, pixelSpace, lineSpace);
+        rsgis::RSGISInstrumentation::recordRasterIO((rwFlag == GF_Write), ((unsigned long long)bufXSize) * bufYSize * (GDALGetDataTypeSize(bufType)/8));
+        return err;
+    }
+
+}}
+
+#endif
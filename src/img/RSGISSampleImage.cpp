@@ -70,160 +70,57 @@ namespace rsgis{namespace img{
     
     void RSGISSampleImage::randomSampleImageMask(GDALDataset *inputImage, unsigned int imgBand, GDALDataset *outputImage, std::vector<int> maskVals, unsigned long numSamples)
     {
-        try
-        {
-            RSGISImageUtils imgUtils;
-            unsigned int imgPxlXSize = inputImage->GetRasterXSize()-1;
-            unsigned int imgPxlYSize = inputImage->GetRasterYSize()-1;
-            unsigned int maxVal = imgPxlXSize;
-            if(imgPxlYSize > maxVal)
-            {
-                maxVal = imgPxlYSize;
-            }
-            bool foundAllSamples = false;
-            
-            unsigned int *maskValCounts = new unsigned int[maskVals.size()];
-            for(int i = 0; i < maskVals.size(); ++i)
-            {
-                maskValCounts[i] = 0;
-            }
-            
-            boost::mt19937 rng (NULL);
-            
-            boost::uniform_int<> pxlRange( 0, maxVal );
-            
-            boost::variate_generator< boost::mt19937, boost::uniform_int<> > pxlGen(rng, pxlRange);
-            
-            unsigned int xPxl = 0;
-            unsigned int yPxl = 0;
-            
-            double pxlVal = 0.0;
-            
-            while(!foundAllSamples)
-            {
-                xPxl = pxlGen();
-                while(xPxl >= imgPxlXSize)
-                {
-                    xPxl = pxlGen();
-                }
-                
-                yPxl = pxlGen();
-                while(yPxl >= imgPxlYSize)
-                {
-                    yPxl = pxlGen();
-                }
-                                
-                pxlVal = imgUtils.getPixelValue(inputImage, imgBand, xPxl, yPxl);
-                
-                for(int i = 0; i < maskVals.size(); ++i)
-                {
-                    if(maskVals.at(i) == pxlVal)
-                    {
-                        if(maskValCounts[i] <= numSamples)
-                        {
-                            imgUtils.setPixelValue(outputImage, imgBand, xPxl, yPxl, pxlVal);
-                            maskValCounts[i] += 1;
-                        }
-                        break;
-                    }
-                }
-                
-                foundAllSamples = true;
-                for(int i = 0; i < maskVals.size(); ++i)
-                {
-                    if(maskValCounts[i] <= numSamples)
-                    {
-                        foundAllSamples = false;
-                        break;
-                    }
-                }
-            }
-        }
-        catch (RSGISImageCalcException &e)
-        {
-            throw RSGISImageException(e.what());
-        }
-        catch (RSGISImageException &e)
-        {
-            throw e;
-        }
-        catch (RSGISException &e)
-        {
-            throw RSGISImageException(e.what());
-        }
-        catch (std::exception &e)
-        {
-            throw RSGISImageException(e.what());
-        }
+        this->sampleImageMask(inputImage, imgBand, outputImage, maskVals, numSamples, 0);
     }
     
-    
     void RSGISSampleImage::randomSampleImageMaskSmallPxlCount(GDALDataset *inputImage, unsigned int imgBand, GDALDataset *outputImage, std::vector<int> maskVals, unsigned long numSamples, int rndSeed)
+    {
+        this->sampleImageMask(inputImage, imgBand, outputImage, maskVals, numSamples, rndSeed);
+    }
+    
+    void RSGISSampleImage::sampleImageMask(GDALDataset *inputImage, unsigned int imgBand, GDALDataset *outputImage, std::vector<int> maskVals, unsigned long numSamples, int rndSeed)
     {
         try
         {
-            RSGISImageUtils imgUtils;
-            
-            unsigned int numMskVals = maskVals.size();
-            std::vector<std::pair<long, long> > *maskPxlLocs = new std::vector<std::pair<long, long> >[numMskVals];
-            
-            RSGISGetPxlLocAsVec getPxlLoc = RSGISGetPxlLocAsVec(maskVals, maskPxlLocs, imgBand);
-            RSGISCalcImage calcImg = RSGISCalcImage(&getPxlLoc, "", true);
-            calcImg.calcImagePosPxl(&inputImage, 1, 0);
+            if(maskVals.empty())
+            {
+                throw RSGISImageException("No mask values were provided.");
+            }
             
-            unsigned int maxNPxls = 0;
-            for(int i = 0; i < maskVals.size(); ++i)
+            long minMaskVal = *std::min_element(maskVals.begin(), maskVals.end());
+            long maxMaskVal = *std::max_element(maskVals.begin(), maskVals.end());
+            std::vector<long> pxlValStrata(maxMaskVal - minMaskVal + 1, -1);
+            for(size_t i = 0; i < maskVals.size(); ++i)
             {
-                if(i == 0)
-                {
-                    maxNPxls = maskPxlLocs[i].size();
-                }
-                else if(maskPxlLocs[i].size() > maxNPxls)
+                if(pxlValStrata.at(maskVals.at(i) - minMaskVal) < 0)
                 {
-                    maxNPxls = maskPxlLocs[i].size();
+                    pxlValStrata.at(maskVals.at(i) - minMaskVal) = i;
                 }
             }
             
-            std::cout << "Max Number of Pixels within a class is " << maxNPxls << std::endl;
-
-            boost::mt19937 rng (rndSeed);
-            boost::uniform_int<> pxlRange( 0, maxNPxls );
-            boost::variate_generator< boost::mt19937, boost::uniform_int<> > pxlGen(rng, pxlRange);
-            
-            unsigned int xPxl = 0;
-            unsigned int yPxl = 0;
+            RSGISStratifiedRandomSampler sampler = RSGISStratifiedRandomSampler(maskVals.size(), numSamples, rndSeed);
+            sampler.samplePixels(inputImage, imgBand, &pxlValStrata, minMaskVal);
             
-            unsigned int pxlIdx = 0;
-            bool foundSamples = false;
-            unsigned int samplesCount = 0;
+            RSGISImageBlockCache<int> outCache(outputImage, GDT_Int32);
             for(unsigned int i = 0; i < maskVals.size(); ++i)
             {
-                foundSamples = false;
-                samplesCount = 0;
-                if(!maskPxlLocs[i].empty())
-                {
-                    for(unsigned long j = 0; j < numSamples; ++j)
-                    {
-                        pxlIdx = pxlGen();
-                        while(pxlIdx >= maskPxlLocs[i].size())
-                        {
-                            pxlIdx = pxlGen();
-                        }
-                        
-                        xPxl = maskPxlLocs[i].at(pxlIdx).first;
-                        yPxl = maskPxlLocs[i].at(pxlIdx).second;
-                        
-                        imgUtils.setPixelValue(outputImage, imgBand, xPxl, yPxl, maskVals.at(i));
-                    }
-                }
-                else
+                if(sampler.getNumPxls(i) == 0)
                 {
                     std::cerr << "No samples with mask value " << maskVals.at(i) << std::endl;
-                    delete[] maskPxlLocs;
                     throw RSGISImageException("There weren't any pixels within the mask");
                 }
+                else if(!sampler.foundAllSamples(i))
+                {
+                    std::cerr << "WARNING: Only " << sampler.getNumPxls(i) << " pixels have mask value " << maskVals.at(i) << ", all of which have been selected.\n";
+                }
+                
+                std::vector<RSGISSamplePxl> *samples = sampler.getSamples(i);
+                for(std::vector<RSGISSamplePxl>::iterator iterPxls = samples->begin(); iterPxls != samples->end(); ++iterPxls)
+                {
+                    outCache.setValue((*iterPxls).xPxl, (*iterPxls).yPxl, maskVals.at(i), imgBand-1);
+                }
             }
-            delete[] maskPxlLocs;
+            outCache.flush();
         }
         catch (RSGISImageCalcException &e)
         {
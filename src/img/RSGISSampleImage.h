@@ -25,6 +25,8 @@
 
 #include <iostream>
 #include <fstream>
+#include <vector>
+#include <algorithm>
 
 #include "boost/random.hpp"
 #include "boost/generator_iterator.hpp"
@@ -34,6 +36,8 @@
 #include "img/RSGISCalcImageValue.h"
 #include "img/RSGISImageBandException.h"
 #include "img/RSGISImageCalcException.h"
+#include "img/RSGISImageBlockCache.h"
+#include "img/RSGISStratifiedRandomSampler.h"
 
 #include "utils/RSGISExportData2HDF.h"
 #include "math/RSGISMathsUtils.h"
@@ -62,6 +66,8 @@ namespace rsgis{namespace img{
         void subSampleImage(GDALDataset *inputImage, std::string outputFile, unsigned int sample, float noData, bool useNoData);
         void randomSampleImageMask(GDALDataset *inputImage, unsigned int imgBand, GDALDataset *outputImage, std::vector<int> maskVals, unsigned long numSamples);
         void randomSampleImageMaskSmallPxlCount(GDALDataset *inputImage, unsigned int imgBand, GDALDataset *outputImage, std::vector<int> maskVals, unsigned long numSamples, int rndSeed);
+        /** Selects numSamples pixels for each mask value, reading the input image once, and writes them to the output image. */
+        void sampleImageMask(GDALDataset *inputImage, unsigned int imgBand, GDALDataset *outputImage, std::vector<int> maskVals, unsigned long numSamples, int rndSeed);
         ~RSGISSampleImage();
     };
     
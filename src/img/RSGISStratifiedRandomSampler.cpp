@@ -0,0 +1,150 @@
+/*
+ *  RSGISStratifiedRandomSampler.cpp
+ *  RSGIS_LIB
+ *
+ *  Created by agent on 19/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISStratifiedRandomSampler.h"
+
+namespace rsgis{namespace img{
+
+    RSGISStratifiedRandomSampler::RSGISStratifiedRandomSampler(std::vector<unsigned long> numSamples, unsigned long seed): rng(seed)
+    {
+        for(std::vector<unsigned long>::iterator iterSamples = numSamples.begin(); iterSamples != numSamples.end(); ++iterSamples)
+        {
+            this->strata.push_back(new RSGISReservoirSample<RSGISSamplePxl>(*iterSamples, &this->rng));
+        }
+    }
+
+    RSGISStratifiedRandomSampler::RSGISStratifiedRandomSampler(unsigned int numStrata, unsigned long numSamplesPerStratum, unsigned long seed): rng(seed)
+    {
+        for(unsigned int i = 0; i < numStrata; ++i)
+        {
+            this->strata.push_back(new RSGISReservoirSample<RSGISSamplePxl>(numSamplesPerStratum, &this->rng));
+        }
+    }
+
+    void RSGISStratifiedRandomSampler::samplePixels(GDALDataset *image, unsigned int imgBand, std::vector<long> *pxlValStrata, long minPxlVal)
+    {
+        if((imgBand == 0) || (imgBand > ((unsigned int)image->GetRasterCount())))
+        {
+            throw RSGISImageException("The band specified for sampling is not within the image.");
+        }
+
+        unsigned int width = image->GetRasterXSize();
+        unsigned int height = image->GetRasterYSize();
+        GDALRasterBand *band = image->GetRasterBand(imgBand);
+
+        int xBlockSize = 0;
+        int yBlockSize = 0;
+        band->GetBlockSize(&xBlockSize, &yBlockSize);
+        if(yBlockSize < 1)
+        {
+            yBlockSize = 1;
+        }
+        unsigned int nStripRows = yBlockSize;
+
+        // Pixel values are read as doubles so all integer images (including
+        // 32 bit unsigned clumps) are represented exactly.
+        double *stripData = new double[((size_t)width) * nStripRows];
+        long tableSize = pxlValStrata->size();
+        long tableIdx = 0;
+        long stratum = 0;
+        long pxlVal = 0;
+        unsigned int numStrata = this->strata.size();
+
+        unsigned int numRows = 0;
+        size_t pxlIdx = 0;
+        int feedback = height/10;
+        if(feedback == 0)
+        {
+            feedback = 1;
+        }
+        int feedbackCounter = 0;
+        std::cout << "Started" << std::flush;
+        for(unsigned int yOff = 0; yOff < height; yOff += nStripRows)
+        {
+            numRows = nStripRows;
+            if((yOff + numRows) > height)
+            {
+                numRows = height - yOff;
+            }
+            if(band->RasterIO(GF_Read, 0, yOff, width, numRows, stripData, width, numRows, GDT_Float64, 0, 0) != CE_None)
+            {
+                delete[] stripData;
+                throw RSGISImageException("Failed to read the image being sampled.");
+            }
+
+            pxlIdx = 0;
+            for(unsigned int i = 0; i < numRows; ++i)
+            {
+                if(((yOff + i) % feedback) == 0)
+                {
+                    std::cout << "." << feedbackCounter << "." << std::flush;
+                    feedbackCounter = feedbackCounter + 10;
+                }
+                for(unsigned int j = 0; j < width; ++j, ++pxlIdx)
+                {
+                    pxlVal = (long)stripData[pxlIdx];
+                    tableIdx = pxlVal - minPxlVal;
+                    if((tableIdx >= 0) && (tableIdx < tableSize))
+                    {
+                        stratum = (*pxlValStrata)[tableIdx];
+                        if((stratum >= 0) && (stratum < numStrata))
+                        {
+                            this->addPixel(stratum, j, yOff + i, pxlVal);
+                        }
+                    }
+                }
+            }
+        }
+        std::cout << " Complete.\n";
+
+        delete[] stripData;
+    }
+
+    std::vector<RSGISSamplePxl>* RSGISStratifiedRandomSampler::getSamples(unsigned int stratum)
+    {
+        std::vector<RSGISSamplePxl> *samples = this->strata.at(stratum)->getItems();
+        std::sort(samples->begin(), samples->end(), compareSamplePxlPos);
+        return samples;
+    }
+
+    void RSGISStratifiedRandomSampler::sampleIndexes(unsigned long numItems, unsigned long numSamples, unsigned long seed, std::vector<unsigned long> *idxs)
+    {
+        std::mt19937_64 rng(seed);
+        RSGISReservoirSample<unsigned long> reservoir(numSamples, &rng);
+        for(unsigned long i = 0; i < numItems; ++i)
+        {
+            reservoir.add(i);
+        }
+        idxs->clear();
+        idxs->insert(idxs->end(), reservoir.getItems()->begin(), reservoir.getItems()->end());
+        std::sort(idxs->begin(), idxs->end());
+    }
+
+    RSGISStratifiedRandomSampler::~RSGISStratifiedRandomSampler()
+    {
+        for(std::vector<RSGISReservoirSample<RSGISSamplePxl>*>::iterator iterStrata = this->strata.begin(); iterStrata != this->strata.end(); ++iterStrata)
+        {
+            delete *iterStrata;
+        }
+    }
+
+}}
@@ -0,0 +1,191 @@
+/*
+ *  RSGISStratifiedRandomSampler.h
+ *  RSGIS_LIB
+ *
+ *  Created by agent on 19/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISStratifiedRandomSampler_H
+#define RSGISStratifiedRandomSampler_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <limits>
+#include <math.h>
+
+#include "gdal_priv.h"
+
+#include "common/RSGISImageException.h"
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_img_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace img{
+
+    /**
+     * Keeps a uniform random sample, without replacement, of up to sampleSize items
+     * from a stream of items of unknown length (reservoir sampling, Algorithm L).
+     * Once the reservoir is full the random generator is only used when an item is
+     * to be accepted, so adding an item is normally just a comparison.
+     */
+    template <typename T>
+    class RSGISReservoirSample
+    {
+    public:
+        RSGISReservoirSample(unsigned long sampleSize, std::mt19937_64 *rng)
+        {
+            this->sampleSize = sampleSize;
+            this->rng = rng;
+            this->numItems = 0;
+            this->nextItem = 0;
+            this->w = 1;
+            this->items.reserve(sampleSize);
+        };
+        inline void add(const T &item)
+        {
+            ++this->numItems;
+            if(this->items.size() < this->sampleSize)
+            {
+                this->items.push_back(item);
+                if(this->items.size() == this->sampleSize)
+                {
+                    this->w = exp(log(this->getRandom())/this->sampleSize);
+                    this->findNextItem();
+                }
+            }
+            else if((this->sampleSize > 0) && (this->numItems == this->nextItem))
+            {
+                std::uniform_int_distribution<unsigned long> idxDist(0, this->sampleSize-1);
+                this->items.at(idxDist(*this->rng)) = item;
+                this->w = this->w * exp(log(this->getRandom())/this->sampleSize);
+                this->findNextItem();
+            }
+        };
+        /** The number of items which have been added. */
+        unsigned long getNumItems(){return this->numItems;};
+        unsigned long getSampleSize(){return this->sampleSize;};
+        /** True once as many items as the sample size have been added. */
+        bool isFull(){return this->items.size() == this->sampleSize;};
+        std::vector<T>* getItems(){return &this->items;};
+    private:
+        inline double getRandom()
+        {
+            // Uniform in the open interval (0, 1).
+            double val = 0;
+            while(val == 0)
+            {
+                val = std::generate_canonical<double, std::numeric_limits<double>::digits>(*this->rng);
+            }
+            return val;
+        };
+        inline void findNextItem()
+        {
+            double skip = 0;
+            if(this->w < 1)
+            {
+                skip = floor(log(this->getRandom())/log(1-this->w));
+            }
+            if((skip != skip) || (skip >= ((double)(std::numeric_limits<unsigned long>::max() - this->numItems - 1))))
+            {
+                this->nextItem = std::numeric_limits<unsigned long>::max();
+            }
+            else
+            {
+                this->nextItem = this->numItems + ((unsigned long)skip) + 1;
+            }
+        };
+        unsigned long sampleSize;
+        std::mt19937_64 *rng;
+        unsigned long numItems;
+        unsigned long nextItem;
+        double w;
+        std::vector<T> items;
+    };
+
+    struct DllExport RSGISSamplePxl
+    {
+        unsigned int xPxl;
+        unsigned int yPxl;
+        long pxlVal;
+    };
+
+    inline bool compareSamplePxlPos(const RSGISSamplePxl &first, const RSGISSamplePxl &second)
+    {
+        if(first.yPxl == second.yPxl)
+        {
+            return first.xPxl < second.xPxl;
+        }
+        return first.yPxl < second.yPxl;
+    };
+
+    /**
+     * Selects a stratified random sample of pixels while reading the image once,
+     * strip by strip, with a reservoir per stratum so the sample size of each stratum
+     * is met exactly (or all the pixels are returned where a stratum has fewer) however
+     * rare the stratum is or however much of the image is no data. Which stratum a
+     * pixel belongs to is defined by a look up table indexed by the pixel value (less
+     * minPxlVal), where a negative stratum or a value outside of the table means the
+     * pixel is not sampled. A std::mt19937_64 generator is used so the sample is
+     * repeatable for a seed.
+     */
+    class DllExport RSGISStratifiedRandomSampler
+    {
+    public:
+        RSGISStratifiedRandomSampler(std::vector<unsigned long> numSamples, unsigned long seed);
+        RSGISStratifiedRandomSampler(unsigned int numStrata, unsigned long numSamplesPerStratum, unsigned long seed);
+        void samplePixels(GDALDataset *image, unsigned int imgBand, std::vector<long> *pxlValStrata, long minPxlVal=0);
+        /** Adds a pixel to the stream for the stratum, for callers which are reading the pixels themselves. */
+        inline void addPixel(unsigned int stratum, unsigned int xPxl, unsigned int yPxl, long pxlVal)
+        {
+            RSGISSamplePxl pxl;
+            pxl.xPxl = xPxl;
+            pxl.yPxl = yPxl;
+            pxl.pxlVal = pxlVal;
+            this->strata.at(stratum)->add(pxl);
+        };
+        unsigned int getNumStrata(){return this->strata.size();};
+        /** The number of pixels within the stratum which were read. */
+        unsigned long getNumPxls(unsigned int stratum){return this->strata.at(stratum)->getNumItems();};
+        /** Whether the stratum had enough pixels to provide all the samples requested. */
+        bool foundAllSamples(unsigned int stratum){return this->strata.at(stratum)->isFull();};
+        /** Returns the sampled pixels for the stratum ordered by row and then column. */
+        std::vector<RSGISSamplePxl>* getSamples(unsigned int stratum);
+        /** Selects numSamples (or numItems if fewer) of the indexes 0 to numItems-1 without replacement, in ascending order. */
+        static void sampleIndexes(unsigned long numItems, unsigned long numSamples, unsigned long seed, std::vector<unsigned long> *idxs);
+        ~RSGISStratifiedRandomSampler();
+    protected:
+        std::mt19937_64 rng;
+        std::vector<RSGISReservoirSample<RSGISSamplePxl>*> strata;
+    };
+
+}}
+
+#endif
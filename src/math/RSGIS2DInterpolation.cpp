@@ -27,6 +27,193 @@
 namespace rsgis {namespace math{
     
     
+    void RSGIS2DPointKDTree::build(std::vector<RSGISInterpolatorDataPoint> *pts)
+    {
+        this->nodes.assign(pts->begin(), pts->end());
+        this->splitAxis.assign(this->nodes.size(), 0);
+        this->buildNode(0, this->nodes.size());
+    }
+    
+    void RSGIS2DPointKDTree::buildNode(size_t begin, size_t end)
+    {
+        // Small ranges are left as leaves and searched exhaustively.
+        if((end - begin) <= RSGIS_KDTREE_LEAF_SIZE)
+        {
+            return;
+        }
+        
+        double minX = this->nodes[begin].x;
+        double maxX = minX;
+        double minY = this->nodes[begin].y;
+        double maxY = minY;
+        for(size_t i = begin+1; i < end; ++i)
+        {
+            minX = std::min(minX, this->nodes[i].x);
+            maxX = std::max(maxX, this->nodes[i].x);
+            minY = std::min(minY, this->nodes[i].y);
+            maxY = std::max(maxY, this->nodes[i].y);
+        }
+        
+        size_t mid = begin + ((end - begin) / 2);
+        if((maxX - minX) >= (maxY - minY))
+        {
+            std::nth_element(this->nodes.begin()+begin, this->nodes.begin()+mid, this->nodes.begin()+end, [](const RSGISInterpolatorDataPoint &a, const RSGISInterpolatorDataPoint &b){return a.x < b.x;});
+            this->splitAxis[mid] = 0;
+        }
+        else
+        {
+            std::nth_element(this->nodes.begin()+begin, this->nodes.begin()+mid, this->nodes.begin()+end, [](const RSGISInterpolatorDataPoint &a, const RSGISInterpolatorDataPoint &b){return a.y < b.y;});
+            this->splitAxis[mid] = 1;
+        }
+        this->buildNode(begin, mid);
+        this->buildNode(mid+1, end);
+    }
+    
+    void RSGIS2DPointKDTree::findKNN(double x, double y, unsigned int k, std::vector<std::pair<double, size_t> > *knn) const
+    {
+        knn->clear();
+        if((k == 0) || this->nodes.empty())
+        {
+            return;
+        }
+        this->searchKNN(0, this->nodes.size(), x, y, k, knn);
+        std::sort_heap(knn->begin(), knn->end());
+    }
+    
+    void RSGIS2DPointKDTree::findKNN(double x, double y, unsigned int k, const std::vector<size_t> &idxs, std::vector<std::pair<double, size_t> > *knn) const
+    {
+        knn->clear();
+        if(k == 0)
+        {
+            return;
+        }
+        double dX = 0.0;
+        double dY = 0.0;
+        for(std::vector<size_t>::const_iterator iterIdxs = idxs.begin(); iterIdxs != idxs.end(); ++iterIdxs)
+        {
+            dX = x - this->nodes[*iterIdxs].x;
+            dY = y - this->nodes[*iterIdxs].y;
+            RSGIS2DPointKDTree::addKNNCandidate((dX*dX)+(dY*dY), *iterIdxs, k, knn);
+        }
+        std::sort_heap(knn->begin(), knn->end());
+    }
+    
+    void RSGIS2DPointKDTree::findInRadius(double x, double y, double radius, std::vector<size_t> *idxs) const
+    {
+        idxs->clear();
+        if(!this->nodes.empty())
+        {
+            this->searchRadius(0, this->nodes.size(), x, y, radius, radius*radius, idxs);
+        }
+    }
+    
+    void RSGIS2DPointKDTree::searchKNN(size_t begin, size_t end, double x, double y, unsigned int k, std::vector<std::pair<double, size_t> > *heap) const
+    {
+        double dX = 0.0;
+        double dY = 0.0;
+        if((end - begin) <= RSGIS_KDTREE_LEAF_SIZE)
+        {
+            for(size_t i = begin; i < end; ++i)
+            {
+                dX = x - this->nodes[i].x;
+                dY = y - this->nodes[i].y;
+                RSGIS2DPointKDTree::addKNNCandidate((dX*dX)+(dY*dY), i, k, heap);
+            }
+            return;
+        }
+        
+        size_t mid = begin + ((end - begin) / 2);
+        dX = x - this->nodes[mid].x;
+        dY = y - this->nodes[mid].y;
+        RSGIS2DPointKDTree::addKNNCandidate((dX*dX)+(dY*dY), mid, k, heap);
+        
+        double diff = (this->splitAxis[mid] == 0)?dX:dY;
+        if(diff < 0)
+        {
+            this->searchKNN(begin, mid, x, y, k, heap);
+            if((heap->size() < k) || ((diff*diff) < heap->front().first))
+            {
+                this->searchKNN(mid+1, end, x, y, k, heap);
+            }
+        }
+        else
+        {
+            this->searchKNN(mid+1, end, x, y, k, heap);
+            if((heap->size() < k) || ((diff*diff) < heap->front().first))
+            {
+                this->searchKNN(begin, mid, x, y, k, heap);
+            }
+        }
+    }
+    
+    void RSGIS2DPointKDTree::searchRadius(size_t begin, size_t end, double x, double y, double radius, double radiusSq, std::vector<size_t> *idxs) const
+    {
+        double dX = 0.0;
+        double dY = 0.0;
+        if((end - begin) <= RSGIS_KDTREE_LEAF_SIZE)
+        {
+            for(size_t i = begin; i < end; ++i)
+            {
+                dX = x - this->nodes[i].x;
+                dY = y - this->nodes[i].y;
+                if(((dX*dX)+(dY*dY)) <= radiusSq)
+                {
+                    idxs->push_back(i);
+                }
+            }
+            return;
+        }
+        
+        size_t mid = begin + ((end - begin) / 2);
+        dX = x - this->nodes[mid].x;
+        dY = y - this->nodes[mid].y;
+        if(((dX*dX)+(dY*dY)) <= radiusSq)
+        {
+            idxs->push_back(mid);
+        }
+        
+        double diff = (this->splitAxis[mid] == 0)?dX:dY;
+        if(diff <= radius)
+        {
+            this->searchRadius(begin, mid, x, y, radius, radiusSq, idxs);
+        }
+        if(diff >= -radius)
+        {
+            this->searchRadius(mid+1, end, x, y, radius, radiusSq, idxs);
+        }
+    }
+    
+    void RSGIS2DPointKDTree::addKNNCandidate(double distSq, size_t idx, unsigned int k, std::vector<std::pair<double, size_t> > *heap)
+    {
+        // heap is a max-heap on distance so the front is the furthest of the current k.
+        if(heap->size() < k)
+        {
+            heap->push_back(std::pair<double, size_t>(distSq, idx));
+            std::push_heap(heap->begin(), heap->end());
+        }
+        else if(distSq < heap->front().first)
+        {
+            std::pop_heap(heap->begin(), heap->end());
+            heap->back() = std::pair<double, size_t>(distSq, idx);
+            std::push_heap(heap->begin(), heap->end());
+        }
+    }
+    
+    
+    
+    void RSGIS2DInterpolator::getValues(double tlX, double tlY, double xRes, double yRes, unsigned int nX, unsigned int nY, float *vals)
+    {
+        for(unsigned int y = 0; y < nY; ++y)
+        {
+            for(unsigned int x = 0; x < nX; ++x)
+            {
+                vals[(y*nX)+x] = this->getValue(tlX + (x * xRes), tlY + (y * yRes));
+            }
+        }
+    }
+    
+    
+    
     RSGISSearchKNN2DInterpolator::RSGISSearchKNN2DInterpolator(unsigned int k): RSGIS2DInterpolator()
     {
         this->k = k;
@@ -41,7 +228,7 @@ namespace rsgis {namespace math{
                 throw RSGISInterpolationException("There are less than \'k\' points in the data points list.");
             }
             
-            this->dataPTS = pts;
+            this->kdTree.build(pts);
         }
         catch(RSGISInterpolationException &e)
         {
@@ -50,49 +237,66 @@ namespace rsgis {namespace math{
         initialised = true;
     }
     
+    double RSGISSearchKNN2DInterpolator::getValue(double eastings, double northings)
+    {
+        double outValue = std::numeric_limits<float>::signaling_NaN();
+        if(initialised)
+        {
+            std::vector<std::pair<double, size_t> > knn;
+            knn.reserve(this->k);
+            this->kdTree.findKNN(eastings, northings, this->k, &knn);
+            outValue = this->interpolateKNN(eastings, northings, &knn);
+        }
+        return outValue;
+    }
     
-    std::list<std::pair<double,RSGISInterpolatorDataPoint> >* RSGISSearchKNN2DInterpolator::findKNN(double eastings, double northings)
+    void RSGISSearchKNN2DInterpolator::getValues(double tlX, double tlY, double xRes, double yRes, unsigned int nX, unsigned int nY, float *vals)
     {
-        std::list<std::pair<double,RSGISInterpolatorDataPoint> > *knn = new std::list<std::pair<double,RSGISInterpolatorDataPoint> >();
-        try
+        if(!initialised)
+        {
+            RSGIS2DInterpolator::getValues(tlX, tlY, xRes, yRes, nX, nY, vals);
+            return;
+        }
+        
+        // The k nearest points to any location in the block are within dK + (2 * h) of 
+        // the block centre, where dK is the distance to the kth nearest point of the 
+        // centre and h is half the block diagonal, so only those points are searched.
+        double cX = tlX + ((xRes * (nX-1)) / 2);
+        double cY = tlY + ((yRes * (nY-1)) / 2);
+        double halfDiag = sqrt(((xRes * (nX-1)) * (xRes * (nX-1))) + ((yRes * (nY-1)) * (yRes * (nY-1)))) / 2;
+        
+        std::vector<std::pair<double, size_t> > knn;
+        knn.reserve(this->k);
+        this->kdTree.findKNN(cX, cY, this->k, &knn);
+        
+        std::vector<size_t> candidates;
+        bool useCandidates = false;
+        if(!knn.empty())
+        {
+            this->kdTree.findInRadius(cX, cY, sqrt(knn.back().first) + (2 * halfDiag), &candidates);
+            // Dense candidate sets are slower than searching the tree.
+            useCandidates = candidates.size() <= ((8 * this->k) + 64);
+        }
+        
+        double eastings = 0.0;
+        double northings = 0.0;
+        for(unsigned int y = 0; y < nY; ++y)
         {
-            double dist = 0.0;
-            for(std::vector<RSGISInterpolatorDataPoint>::iterator iterPts = dataPTS->begin(); iterPts != dataPTS->end(); ++iterPts)
+            northings = tlY + (y * yRes);
+            for(unsigned int x = 0; x < nX; ++x)
             {
-                dist = sqrt(pow((eastings-(*iterPts).x),2) + pow((northings-(*iterPts).y),2));
-                
-                if(knn->empty())
+                eastings = tlX + (x * xRes);
+                if(useCandidates)
                 {
-                    knn->push_back(std::pair<double,RSGISInterpolatorDataPoint>(dist, *iterPts));
+                    this->kdTree.findKNN(eastings, northings, this->k, candidates, &knn);
                 }
                 else
                 {
-                    for(std::list<std::pair<double,RSGISInterpolatorDataPoint> >::iterator iterK = knn->begin(); iterK != knn->end(); ++iterK)
-                    {
-                        if((*iterK).first > dist)
-                        {
-                            knn->insert(iterK, std::pair<double,RSGISInterpolatorDataPoint>(dist, *iterPts));
-                            break;
-                        }
-                    }
-                }
-
-                if(knn->size() < k)
-                {
-                    knn->push_back(std::pair<double,RSGISInterpolatorDataPoint>(dist, *iterPts));
-                }
-                else if(knn->size() > k)
-                {
-                    knn->pop_back();
+                    this->kdTree.findKNN(eastings, northings, this->k, &knn);
                 }
+                vals[(y*nX)+x] = this->interpolateKNN(eastings, northings, &knn);
             }
         }
-        catch(RSGISInterpolationException &e)
-        {
-            delete knn;
-            throw e;
-        }
-        return knn;
     }
     
     
@@ -134,16 +338,29 @@ namespace rsgis {namespace math{
                 throw RSGISInterpolationException("Data points sit on a line and therefore cannot triangulate.");
             }
             
+            this->clearThreadTriangulations();
+            if(dt != NULL)
+            {
+                delete dt;
+            }
+            if(values != NULL)
+            {
+                delete values;
+            }
             dt = new DelaunayTriangulation();
             values = new PointValueMap();
             
+            std::vector<CGALPoint> cgalPts;
+            cgalPts.reserve(pts->size());
             for(std::vector<RSGISInterpolatorDataPoint>::iterator iterPts = pts->begin(); iterPts != pts->end(); ++iterPts)
             {
                 K::Point_2 cgalPt((*iterPts).x,(*iterPts).y);
-                dt->insert(cgalPt);
+                cgalPts.push_back(cgalPt);
                 CGALCoordType value = (*iterPts).value;
                 values->insert(std::make_pair(cgalPt, value));
             }
+            // Inserting the points together allows CGAL to spatially sort them first.
+            dt->insert(cgalPts.begin(), cgalPts.end());
         }
         catch(RSGISInterpolationException &e)
         {
@@ -152,16 +369,97 @@ namespace rsgis {namespace math{
         initialised = true;
     }
     
+    double RSGIS2DTriagulatorInterpolator::getValue(double eastings, double northings)
+    {
+        return this->getThreadValue(0, eastings, northings);
+    }
     
+    void RSGIS2DTriagulatorInterpolator::getValues(double tlX, double tlY, double xRes, double yRes, unsigned int nX, unsigned int nY, float *vals)
+    {
+        this->getThreadValues(0, tlX, tlY, xRes, yRes, nX, nY, vals);
+    }
     
+    void RSGIS2DTriagulatorInterpolator::initThreads(unsigned int numThreads)
+    {
+        if(!initialised)
+        {
+            throw RSGISInterpolationException("Interpolated needs to be initialised before the threads are.");
+        }
+        // Thread 0 uses the original triangulation.
+        for(unsigned int i = this->threadDTs.size() + 1; i < numThreads; ++i)
+        {
+            this->threadDTs.push_back(new DelaunayTriangulation(*this->dt));
+        }
+    }
     
-    double RSGISNearestNeighbour2DInterpolator::getValue(double eastings, double northings)
+    double RSGIS2DTriagulatorInterpolator::getThreadValue(unsigned int threadIdx, double eastings, double northings)
+    {
+        Face_handle face = Face_handle();
+        return this->getValueFromFace(this->getThreadTriangulation(threadIdx), eastings, northings, &face);
+    }
+    
+    void RSGIS2DTriagulatorInterpolator::getThreadValues(unsigned int threadIdx, double tlX, double tlY, double xRes, double yRes, unsigned int nX, unsigned int nY, float *vals)
+    {
+        DelaunayTriangulation *threadDT = this->getThreadTriangulation(threadIdx);
+        // Alternate the direction of each row so consecutive locations are always adjacent.
+        Face_handle face = Face_handle();
+        unsigned int x = 0;
+        for(unsigned int y = 0; y < nY; ++y)
+        {
+            for(unsigned int i = 0; i < nX; ++i)
+            {
+                x = ((y % 2) == 0)?i:(nX - 1 - i);
+                vals[(y*nX)+x] = this->getValueFromFace(threadDT, tlX + (x * xRes), tlY + (y * yRes), &face);
+            }
+        }
+    }
+    
+    DelaunayTriangulation* RSGIS2DTriagulatorInterpolator::getThreadTriangulation(unsigned int threadIdx)
+    {
+        if(threadIdx == 0)
+        {
+            return this->dt;
+        }
+        else if(threadIdx > this->threadDTs.size())
+        {
+            throw RSGISInterpolationException("The thread index is not within the number of threads initialised.");
+        }
+        return this->threadDTs[threadIdx-1];
+    }
+    
+    void RSGIS2DTriagulatorInterpolator::clearThreadTriangulations()
+    {
+        for(std::vector<DelaunayTriangulation*>::iterator iterDTs = this->threadDTs.begin(); iterDTs != this->threadDTs.end(); ++iterDTs)
+        {
+            delete (*iterDTs);
+        }
+        this->threadDTs.clear();
+    }
+    
+    RSGIS2DTriagulatorInterpolator::~RSGIS2DTriagulatorInterpolator()
+    {
+        this->clearThreadTriangulations();
+        if(this->dt != NULL)
+        {
+            delete this->dt;
+        }
+        if(this->values != NULL)
+        {
+            delete this->values;
+        }
+    }
+    
+    
+    
+    
+    double RSGISNearestNeighbour2DInterpolator::getValueFromFace(DelaunayTriangulation *threadDT, double eastings, double northings, Face_handle *face)
     {
         double outValue = std::numeric_limits<double>::signaling_NaN();
 		if(initialised)
 		{
             CGALPoint p(eastings, northings);
-            Vertex_handle vh = dt->nearest_vertex(p);
+            Vertex_handle vh = threadDT->nearest_vertex(p, *face);
+            *face = vh->face();
             CGALPoint nearestPt = vh->point();
             PointValueMap::iterator iterVal = values->find(nearestPt);
             outValue = (*iterVal).second;
@@ -176,7 +474,7 @@ namespace rsgis {namespace math{
     
     
     
-    double RSGISNaturalNeighbor2DInterpolator::getValue(double eastings, double northings)
+    double RSGISNaturalNeighbor2DInterpolator::getValueFromFace(DelaunayTriangulation *threadDT, double eastings, double northings, Face_handle *face)
     {
         float outValue = std::numeric_limits<float>::signaling_NaN();
         if(initialised)
@@ -184,11 +482,12 @@ namespace rsgis {namespace math{
             try
             {
                 K::Point_2 p(eastings, northings);
+                *face = threadDT->locate(p, *face);
                 CoordinateVector coords;
-                CGAL::Triple<std::back_insert_iterator<CoordinateVector>, K::FT, bool> result = CGAL::natural_neighbor_coordinates_2(*dt, p, std::back_inserter(coords));
+                CGAL::Triple<std::back_insert_iterator<CoordinateVector>, K::FT, bool> result = CGAL::natural_neighbor_coordinates_2(*threadDT, p, std::back_inserter(coords), *face);
                 if(!result.third)
                 {
-                    Vertex_handle vh = dt->nearest_vertex(p);
+                    Vertex_handle vh = threadDT->nearest_vertex(p, *face);
                     CGALPoint nearestPt = vh->point();
                     PointValueMap::iterator iterVal = values->find(nearestPt);
                     outValue = (*iterVal).second;
@@ -213,7 +512,7 @@ namespace rsgis {namespace math{
     
     
     
-    double RSGISNaturalNearestNeighbor2DInterpolator::getValue(double eastings, double northings)
+    double RSGISNaturalNearestNeighbor2DInterpolator::getValueFromFace(DelaunayTriangulation *threadDT, double eastings, double northings, Face_handle *face)
     {
         float outValue = std::numeric_limits<float>::signaling_NaN();
         if(initialised)
@@ -221,8 +520,9 @@ namespace rsgis {namespace math{
             try
             {
                 K::Point_2 p(eastings, northings);
+                *face = threadDT->locate(p, *face);
                 CoordinateVector coords;
-                CGAL::Triple<std::back_insert_iterator<CoordinateVector>, K::FT, bool> result = CGAL::natural_neighbor_coordinates_2(*dt, p, std::back_inserter(coords));
+                CGAL::Triple<std::back_insert_iterator<CoordinateVector>, K::FT, bool> result = CGAL::natural_neighbor_coordinates_2(*threadDT, p, std::back_inserter(coords), *face);
                 if(!result.third)
                 {
                     outValue = std::numeric_limits<float>::signaling_NaN();
@@ -247,29 +547,15 @@ namespace rsgis {namespace math{
     
     
     
-    double RSGISKNearestNeighbour2DInterpolator::getValue(double eastings, double northings)
+    double RSGISKNearestNeighbour2DInterpolator::interpolateKNN(double eastings, double northings, std::vector<std::pair<double, size_t> > *knn)
     {
-        float outValue = std::numeric_limits<float>::signaling_NaN();
-        if(initialised)
+        if(knn->size() != this->k)
         {
-            try
-            {
-                std::list<std::pair<double,RSGISInterpolatorDataPoint> > *knn = this->findKNN(eastings, northings);
-                if(knn->size() != this->k)
-                {
-                    std::cout << "this->k = " << this->k << std::endl;
-                    std::cout << "knn->size() = " << knn->size() << std::endl;
-                    throw RSGISInterpolationException("Insufficient number of K points where identified.");
-                }
-                outValue = knn->front().second.value;
-                delete knn;
-            }
-            catch(RSGISInterpolationException &e)
-            {
-                throw e;
-            }
+            std::cout << "this->k = " << this->k << std::endl;
+            std::cout << "knn->size() = " << knn->size() << std::endl;
+            throw RSGISInterpolationException("Insufficient number of K points where identified.");
         }
-        return outValue;
+        return this->kdTree.getPoint(knn->front().second).value;
     }
     
     
@@ -287,33 +573,126 @@ namespace rsgis {namespace math{
         float outValue = std::numeric_limits<float>::signaling_NaN();
         if(initialised)
         {
-            try
+            double totalWeight = 0.0;
+            double weightedSum = 0.0;
+            double weight = 0.0;
+            double distSq = 0.0;
+            double halfP = ((double)this->p) / 2.0;
+            for(std::vector<RSGISInterpolatorDataPoint>::iterator iterPts = pts->begin(); iterPts != pts->end(); ++iterPts)
             {
-                double totalWeight = 0.0;
-                double weight = 0.0;
-                for(std::vector<RSGISInterpolatorDataPoint>::iterator iterPts = pts->begin(); iterPts != pts->end(); ++iterPts)
+                distSq = ((eastings - (*iterPts).x) * (eastings - (*iterPts).x)) + ((northings - (*iterPts).y) * (northings - (*iterPts).y));
+                if(distSq == 0)
                 {
-                    weight = 1 / pow(sqrt(pow((eastings - (*iterPts).x), 2) + pow((northings - (*iterPts).y), 2)),(double)this->p);
-                    totalWeight += weight;
+                    return (*iterPts).value;
                 }
-                
-                
-                outValue = 0.0;
-                
-                for(std::vector<RSGISInterpolatorDataPoint>::iterator iterPts = pts->begin(); iterPts != pts->end(); ++iterPts)
+                weight = 1 / pow(distSq, halfP);
+                totalWeight += weight;
+                weightedSum += ((*iterPts).value * weight);
+            }
+            outValue = weightedSum / totalWeight;
+        }
+        return outValue;
+    }
+    
+    
+    
+    void RSGISRadiusIDWInterpolator::initInterpolator(std::vector<RSGISInterpolatorDataPoint> *pts)
+    {
+        if(pts->empty())
+        {
+            throw RSGISInterpolationException("There are no data points to interpolate.");
+        }
+        if(this->radius <= 0)
+        {
+            throw RSGISInterpolationException("The IDW search radius must be greater than zero.");
+        }
+        this->kdTree.build(pts);
+        this->initialised = true;
+    }
+    
+    double RSGISRadiusIDWInterpolator::getValue(double eastings, double northings)
+    {
+        double outValue = std::numeric_limits<float>::signaling_NaN();
+        if(initialised)
+        {
+            std::vector<size_t> idxs;
+            this->kdTree.findInRadius(eastings, northings, this->radius, &idxs);
+            outValue = this->calcIDW(eastings, northings, idxs);
+        }
+        return outValue;
+    }
+    
+    void RSGISRadiusIDWInterpolator::getValues(double tlX, double tlY, double xRes, double yRes, unsigned int nX, unsigned int nY, float *vals)
+    {
+        if(!initialised)
+        {
+            RSGIS2DInterpolator::getValues(tlX, tlY, xRes, yRes, nX, nY, vals);
+            return;
+        }
+        
+        // Every point within the radius of a location in the block is within the 
+        // radius plus half the block diagonal of the block centre.
+        double cX = tlX + ((xRes * (nX-1)) / 2);
+        double cY = tlY + ((yRes * (nY-1)) / 2);
+        double halfDiag = sqrt(((xRes * (nX-1)) * (xRes * (nX-1))) + ((yRes * (nY-1)) * (yRes * (nY-1)))) / 2;
+        std::vector<size_t> candidates;
+        this->kdTree.findInRadius(cX, cY, this->radius + halfDiag, &candidates);
+        
+        double radiusSq = this->radius * this->radius;
+        std::vector<size_t> idxs;
+        idxs.reserve(candidates.size());
+        double eastings = 0.0;
+        double northings = 0.0;
+        double dX = 0.0;
+        double dY = 0.0;
+        for(unsigned int y = 0; y < nY; ++y)
+        {
+            northings = tlY + (y * yRes);
+            for(unsigned int x = 0; x < nX; ++x)
+            {
+                eastings = tlX + (x * xRes);
+                idxs.clear();
+                for(std::vector<size_t>::iterator iterIdxs = candidates.begin(); iterIdxs != candidates.end(); ++iterIdxs)
                 {
-                    weight = 1 / pow(sqrt(pow((eastings - (*iterPts).x), 2) + pow((northings - (*iterPts).y), 2)),(double)this->p);
-                    
-                    outValue += ((*iterPts).value * weight) / totalWeight;
+                    dX = eastings - this->kdTree.getPoint(*iterIdxs).x;
+                    dY = northings - this->kdTree.getPoint(*iterIdxs).y;
+                    if(((dX*dX)+(dY*dY)) <= radiusSq)
+                    {
+                        idxs.push_back(*iterIdxs);
+                    }
                 }
-                
+                vals[(y*nX)+x] = this->calcIDW(eastings, northings, idxs);
             }
-            catch(RSGISInterpolationException &e)
+        }
+    }
+    
+    double RSGISRadiusIDWInterpolator::calcIDW(double eastings, double northings, const std::vector<size_t> &idxs)
+    {
+        if(idxs.empty())
+        {
+            std::vector<std::pair<double, size_t> > knn;
+            this->kdTree.findKNN(eastings, northings, 1, &knn);
+            return this->kdTree.getPoint(knn.front().second).value;
+        }
+        
+        double totalWeight = 0.0;
+        double weightedSum = 0.0;
+        double weight = 0.0;
+        double distSq = 0.0;
+        double halfP = ((double)this->p) / 2.0;
+        for(std::vector<size_t>::const_iterator iterIdxs = idxs.begin(); iterIdxs != idxs.end(); ++iterIdxs)
+        {
+            const RSGISInterpolatorDataPoint &pt = this->kdTree.getPoint(*iterIdxs);
+            distSq = ((eastings - pt.x) * (eastings - pt.x)) + ((northings - pt.y) * (northings - pt.y));
+            if(distSq == 0)
             {
-                throw e;
+                return pt.value;
             }
+            weight = 1 / pow(distSq, halfP);
+            totalWeight += weight;
+            weightedSum += (pt.value * weight);
         }
-        return outValue;
+        return weightedSum / totalWeight;
     }
     
    
@@ -470,15 +849,37 @@ namespace rsgis {namespace math{
     }
     
     double RSGISCombine2DInterpolators::getValue(double eastings, double northings)
+    {
+        return this->getThreadValue(0, eastings, northings);
+    }
+    
+    void RSGISCombine2DInterpolators::initThreads(unsigned int numThreads)
+    {
+        this->interp1->initThreads(numThreads);
+        this->interp2->initThreads(numThreads);
+    }
+    
+    void RSGISCombine2DInterpolators::getThreadValues(unsigned int threadIdx, double tlX, double tlY, double xRes, double yRes, unsigned int nX, unsigned int nY, float *vals)
+    {
+        for(unsigned int y = 0; y < nY; ++y)
+        {
+            for(unsigned int x = 0; x < nX; ++x)
+            {
+                vals[(y*nX)+x] = this->getThreadValue(threadIdx, tlX + (x * xRes), tlY + (y * yRes));
+            }
+        }
+    }
+    
+    double RSGISCombine2DInterpolators::getThreadValue(unsigned int threadIdx, double eastings, double northings)
     {
         double outVal = 0.0;
         try
         {
-            outVal = this->interp1->getValue(eastings, northings);
+            outVal = this->interp1->getThreadValue(threadIdx, eastings, northings);
             
             if((outVal > upperThres) | (outVal < lowerThres))
             {
-                outVal = this->interp2->getValue(eastings, northings);
+                outVal = this->interp2->getThreadValue(threadIdx, eastings, northings);
             }
             
         }
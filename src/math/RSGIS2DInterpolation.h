@@ -28,6 +28,10 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
+#include <vector>
+#include <list>
+#include <limits>
+#include <algorithm>
 
 #include "RSGISMathsUtils.h"
 
@@ -53,6 +57,9 @@
     #define DllExport
 #endif
 
+/** The maximum number of points within a leaf of the RSGIS2DPointKDTree. */
+#define RSGIS_KDTREE_LEAF_SIZE 8
+
 typedef CGAL::Exact_predicates_inexact_constructions_kernel K;
 typedef K::FT                                         CGALCoordType;
 typedef K::Vector_2                                   CGALVector;
@@ -61,6 +68,7 @@ typedef K::Point_2                                    CGALPoint;
 typedef CGAL::Delaunay_triangulation_2<K>             DelaunayTriangulation;
 typedef CGAL::Interpolation_traits_2<K>               InterpTraits;
 typedef CGAL::Delaunay_triangulation_2<K>::Vertex_handle    Vertex_handle;
+typedef CGAL::Delaunay_triangulation_2<K>::Face_handle      Face_handle;
 
 typedef std::vector< std::pair<CGALPoint, CGALCoordType> >   CoordinateVector;
 typedef std::map<CGALPoint, CGALCoordType, K::Less_xy_2>     PointValueMap;
@@ -88,12 +96,59 @@ namespace rsgis {namespace math{
         double value;
     };
     
+    /**
+     * A static 2D k-d tree of interpolation data points. The points are copied and
+     * reordered into a balanced tree (split at the median of the widest axis) held
+     * within a single array, so the queries do not allocate beyond their outputs and
+     * can be run from multiple threads at once. Indexes refer to the tree order.
+     */
+    class DllExport RSGIS2DPointKDTree
+    {
+    public:
+        RSGIS2DPointKDTree(){};
+        void build(std::vector<RSGISInterpolatorDataPoint> *pts);
+        size_t getNumPoints() const {return this->nodes.size();};
+        const RSGISInterpolatorDataPoint& getPoint(size_t idx) const {return this->nodes[idx];};
+        /** Finds the k nearest points as (squared distance, index) pairs ordered nearest first. */
+        void findKNN(double x, double y, unsigned int k, std::vector<std::pair<double, size_t> > *knn) const;
+        /** As findKNN but only considering the points with the indexes listed in idxs. */
+        void findKNN(double x, double y, unsigned int k, const std::vector<size_t> &idxs, std::vector<std::pair<double, size_t> > *knn) const;
+        /** Finds the indexes of all the points within radius of (x, y). */
+        void findInRadius(double x, double y, double radius, std::vector<size_t> *idxs) const;
+        ~RSGIS2DPointKDTree(){};
+    protected:
+        void buildNode(size_t begin, size_t end);
+        void searchKNN(size_t begin, size_t end, double x, double y, unsigned int k, std::vector<std::pair<double, size_t> > *heap) const;
+        void searchRadius(size_t begin, size_t end, double x, double y, double radius, double radiusSq, std::vector<size_t> *idxs) const;
+        static void addKNNCandidate(double distSq, size_t idx, unsigned int k, std::vector<std::pair<double, size_t> > *heap);
+        std::vector<RSGISInterpolatorDataPoint> nodes;
+        std::vector<unsigned char> splitAxis;
+    };
+    
     class DllExport RSGIS2DInterpolator
 	{
 	public:
 		RSGIS2DInterpolator(){};
 		virtual void initInterpolator(std::vector<RSGISInterpolatorDataPoint> *pts) = 0;
 		virtual double getValue(double eastings, double northings) = 0;
+        /**
+         * Populates vals (nX x nY values, row major) for the locations tlX + (x * xRes),
+         * tlY + (y * yRes). Interpolators can override this to share the search
+         * between neighbouring locations.
+         */
+        virtual void getValues(double tlX, double tlY, double xRes, double yRes, unsigned int nX, unsigned int nY, float *vals);
+        /**
+         * Prepares the interpolator for getThreadValue and getThreadValues to be
+         * called with thread indexes from 0 to numThreads-1. Must be called after
+         * initInterpolator.
+         */
+        virtual void initThreads(unsigned int numThreads){};
+        /** As getValue, using the state held for the thread index. */
+        virtual double getThreadValue(unsigned int threadIdx, double eastings, double northings){return this->getValue(eastings, northings);};
+        /** As getValues, using the state held for the thread index. */
+        virtual void getThreadValues(unsigned int threadIdx, double tlX, double tlY, double xRes, double yRes, unsigned int nX, unsigned int nY, float *vals){this->getValues(tlX, tlY, xRes, yRes, nX, nY, vals);};
+        /** Returns true if getThreadValue and getThreadValues can be called from multiple threads at once, each with a different thread index. */
+        virtual bool isThreadSafe(){return false;};
 		virtual ~RSGIS2DInterpolator(){};
 	protected:
 		bool initialised;
@@ -104,23 +159,48 @@ namespace rsgis {namespace math{
 	public:
 		RSGISSearchKNN2DInterpolator(unsigned int k);
 		virtual void initInterpolator(std::vector<RSGISInterpolatorDataPoint> *pts);
-        virtual double getValue(double eastings, double northings) = 0;
+        virtual double getValue(double eastings, double northings);
+        virtual void getValues(double tlX, double tlY, double xRes, double yRes, unsigned int nX, unsigned int nY, float *vals);
+        virtual bool isThreadSafe(){return true;};
 		virtual ~RSGISSearchKNN2DInterpolator(){};
 	protected:
-        virtual std::list<std::pair<double,RSGISInterpolatorDataPoint> >* findKNN(double eastings, double northings);
+        /** Calculates the value from the k nearest points, as returned by RSGIS2DPointKDTree::findKNN. */
+        virtual double interpolateKNN(double eastings, double northings, std::vector<std::pair<double, size_t> > *knn) = 0;
 		unsigned int k;
-        std::vector<RSGISInterpolatorDataPoint> *dataPTS;
+        RSGIS2DPointKDTree kdTree;
 	};
     
+    /**
+     * Interpolators using a CGAL Delaunay triangulation of the data points. CGAL 
+     * point location uses the random number generator held by the triangulation 
+     * and the natural neighbour search marks the faces in conflict, so a query 
+     * modifies the triangulation. initThreads() therefore gives each thread its 
+     * own copy of the triangulation (thread 0 uses the original) and the copies 
+     * can be queried at the same time. getValues() visits the locations in a 
+     * serpentine order, starting the location of each within the triangulation 
+     * from the face found for the previous one, rather than walking from the 
+     * start of the triangulation for every location.
+     */
     class DllExport RSGIS2DTriagulatorInterpolator: public RSGIS2DInterpolator
 	{
 	public:
-		RSGIS2DTriagulatorInterpolator():RSGIS2DInterpolator(){};
+		RSGIS2DTriagulatorInterpolator():RSGIS2DInterpolator(){this->dt = NULL; this->values = NULL;};
 		virtual void initInterpolator(std::vector<RSGISInterpolatorDataPoint> *pts);
-		virtual double getValue(double eastings, double northings) = 0;
-		virtual ~RSGIS2DTriagulatorInterpolator(){};
+		virtual double getValue(double eastings, double northings);
+        virtual void getValues(double tlX, double tlY, double xRes, double yRes, unsigned int nX, unsigned int nY, float *vals);
+        virtual void initThreads(unsigned int numThreads);
+        virtual double getThreadValue(unsigned int threadIdx, double eastings, double northings);
+        virtual void getThreadValues(unsigned int threadIdx, double tlX, double tlY, double xRes, double yRes, unsigned int nX, unsigned int nY, float *vals);
+        virtual bool isThreadSafe(){return true;};
+		virtual ~RSGIS2DTriagulatorInterpolator();
 	protected:
+        DelaunayTriangulation* getThreadTriangulation(unsigned int threadIdx);
+        void clearThreadTriangulations();
+        /** Calculates the value at the location within the triangulation; face is used as the hint for locating the point and updated to the face found. */
+        virtual double getValueFromFace(DelaunayTriangulation *threadDT, double eastings, double northings, Face_handle *face) = 0;
 		DelaunayTriangulation *dt;
+        /** The copies of dt used by threads 1 to n-1. */
+        std::vector<DelaunayTriangulation*> threadDTs;
         PointValueMap *values;
 	};
     
@@ -128,24 +208,27 @@ namespace rsgis {namespace math{
 	{
 	public:
 		RSGISNearestNeighbour2DInterpolator():RSGIS2DTriagulatorInterpolator(){};
-		double getValue(double eastings, double northings);
 		~RSGISNearestNeighbour2DInterpolator(){};
+    protected:
+		double getValueFromFace(DelaunayTriangulation *threadDT, double eastings, double northings, Face_handle *face);
 	};
     
     class DllExport RSGISNaturalNeighbor2DInterpolator :public RSGIS2DTriagulatorInterpolator
 	{
 	public:
 		RSGISNaturalNeighbor2DInterpolator():RSGIS2DTriagulatorInterpolator(){};
-		double getValue(double eastings, double northings);
 		~RSGISNaturalNeighbor2DInterpolator(){};
+    protected:
+		double getValueFromFace(DelaunayTriangulation *threadDT, double eastings, double northings, Face_handle *face);
 	};
     
     class DllExport RSGISNaturalNearestNeighbor2DInterpolator :public RSGIS2DTriagulatorInterpolator
 	{
 	public:
 		RSGISNaturalNearestNeighbor2DInterpolator():RSGIS2DTriagulatorInterpolator(){};
-		double getValue(double eastings, double northings);
 		~RSGISNaturalNearestNeighbor2DInterpolator(){};
+    protected:
+		double getValueFromFace(DelaunayTriangulation *threadDT, double eastings, double northings, Face_handle *face);
 	};
     
     
@@ -153,8 +236,9 @@ namespace rsgis {namespace math{
 	{
 	public:
 		RSGISKNearestNeighbour2DInterpolator(unsigned int k):RSGISSearchKNN2DInterpolator(k){};
-		double getValue(double eastings, double northings);
 		~RSGISKNearestNeighbour2DInterpolator(){};
+    protected:
+        double interpolateKNN(double eastings, double northings, std::vector<std::pair<double, size_t> > *knn);
 	};
     
     
@@ -164,18 +248,41 @@ namespace rsgis {namespace math{
 		RSGISAllPointsIDWInterpolator(float p):RSGIS2DInterpolator(){this->p = p;};
         void initInterpolator(std::vector<RSGISInterpolatorDataPoint> *pts);
 		double getValue(double eastings, double northings);
+        bool isThreadSafe(){return true;};
 		~RSGISAllPointsIDWInterpolator(){};
     protected:
         std::vector<RSGISInterpolatorDataPoint> *pts;
         float p;
 	};
     
+    /**
+     * Inverse distance weighting using only the points within radius of the location,
+     * found using a k-d tree. Where there are no points within the radius the value 
+     * of the nearest point is used.
+     */
+    class DllExport RSGISRadiusIDWInterpolator : public RSGIS2DInterpolator
+	{
+	public:
+		RSGISRadiusIDWInterpolator(float p, double radius):RSGIS2DInterpolator(){this->p = p; this->radius = radius;};
+        void initInterpolator(std::vector<RSGISInterpolatorDataPoint> *pts);
+		double getValue(double eastings, double northings);
+        void getValues(double tlX, double tlY, double xRes, double yRes, unsigned int nX, unsigned int nY, float *vals);
+        bool isThreadSafe(){return true;};
+		~RSGISRadiusIDWInterpolator(){};
+    protected:
+        double calcIDW(double eastings, double northings, const std::vector<size_t> &idxs);
+        RSGIS2DPointKDTree kdTree;
+        float p;
+        double radius;
+	};
+    
     class DllExport RSGISLinearTrendInterpolator : public RSGIS2DInterpolator
 	{
 	public:
 		RSGISLinearTrendInterpolator():RSGIS2DInterpolator(){};
         void initInterpolator(std::vector<RSGISInterpolatorDataPoint> *pts);
 		double getValue(double eastings, double northings);
+        bool isThreadSafe(){return true;};
 		~RSGISLinearTrendInterpolator(){};
     protected:
         double a;
@@ -194,6 +301,10 @@ namespace rsgis {namespace math{
         };
         void initInterpolator(std::vector<RSGISInterpolatorDataPoint> *pts);
 		double getValue(double eastings, double northings);
+        void initThreads(unsigned int numThreads);
+        double getThreadValue(unsigned int threadIdx, double eastings, double northings);
+        void getThreadValues(unsigned int threadIdx, double tlX, double tlY, double xRes, double yRes, unsigned int nX, unsigned int nY, float *vals);
+        bool isThreadSafe(){return this->interp1->isThreadSafe() && this->interp2->isThreadSafe();};
 		~RSGISCombine2DInterpolators()
         {
             delete interp1;
@@ -30,6 +30,179 @@ namespace rsgis{namespace math{
 		
 	}
 	
+	void RSGISFFTWUtils::fft1D(std::complex<double> *data, unsigned int n, bool inverse)
+	{
+		if((n == 0) | ((n & (n-1)) != 0))
+		{
+			throw RSGISMathException("The length of the FFT must be a power of 2.");
+		}
+		
+		// Bit reversal permutation
+		unsigned int j = 0;
+		for(unsigned int i = 1; i < n; ++i)
+		{
+			unsigned int bit = n >> 1;
+			while(j & bit)
+			{
+				j ^= bit;
+				bit >>= 1;
+			}
+			j |= bit;
+			if(i < j)
+			{
+				std::swap(data[i], data[j]);
+			}
+		}
+		
+		// Butterflies
+		double sign = inverse?1.0:-1.0;
+		for(unsigned int len = 2; len <= n; len <<= 1)
+		{
+			double angle = sign * 2 * M_PI / len;
+			std::complex<double> wLen(cos(angle), sin(angle));
+			unsigned int halfLen = len >> 1;
+			for(unsigned int i = 0; i < n; i += len)
+			{
+				std::complex<double> w(1, 0);
+				for(unsigned int k = 0; k < halfLen; ++k)
+				{
+					std::complex<double> u = data[i+k];
+					std::complex<double> v = data[i+k+halfLen] * w;
+					data[i+k] = u + v;
+					data[i+k+halfLen] = u - v;
+					w *= wLen;
+				}
+			}
+		}
+		
+		if(inverse)
+		{
+			for(unsigned int i = 0; i < n; ++i)
+			{
+				data[i] /= n;
+			}
+		}
+	}
+	
+	void RSGISFFTWUtils::fft2D(std::complex<double> *data, unsigned int width, unsigned int height, bool inverse)
+	{
+		for(unsigned int y = 0; y < height; ++y)
+		{
+			this->fft1D(&data[y*width], width, inverse);
+		}
+		
+		std::complex<double> *column = new std::complex<double>[height];
+		for(unsigned int x = 0; x < width; ++x)
+		{
+			for(unsigned int y = 0; y < height; ++y)
+			{
+				column[y] = data[(y*width)+x];
+			}
+			this->fft1D(column, height, inverse);
+			for(unsigned int y = 0; y < height; ++y)
+			{
+				data[(y*width)+x] = column[y];
+			}
+		}
+		delete[] column;
+	}
+	
+	double* RSGISFFTWUtils::phaseCorrelation(float *reference, float *floating, unsigned int width, unsigned int height)
+	{
+		unsigned long numVals = ((unsigned long)width)*height;
+		std::complex<double> *refFFT = new std::complex<double>[numVals];
+		std::complex<double> *floatFFT = new std::complex<double>[numVals];
+		for(unsigned long i = 0; i < numVals; ++i)
+		{
+			refFFT[i] = std::complex<double>(reference[i], 0);
+			floatFFT[i] = std::complex<double>(floating[i], 0);
+		}
+		
+		try
+		{
+			this->fft2D(refFFT, width, height, false);
+			this->fft2D(floatFFT, width, height, false);
+		}
+		catch(RSGISMathException &e)
+		{
+			delete[] refFFT;
+			delete[] floatFFT;
+			throw e;
+		}
+		
+		// Normalised cross power spectrum (stored in refFFT)
+		double mag = 0;
+		for(unsigned long i = 0; i < numVals; ++i)
+		{
+			refFFT[i] *= std::conj(floatFFT[i]);
+			mag = std::abs(refFFT[i]);
+			if(mag > 1e-12)
+			{
+				refFFT[i] /= mag;
+			}
+			else
+			{
+				refFFT[i] = std::complex<double>(0, 0);
+			}
+		}
+		delete[] floatFFT;
+		
+		this->fft2D(refFFT, width, height, true);
+		
+		double *surface = new double[numVals];
+		for(unsigned long i = 0; i < numVals; ++i)
+		{
+			surface[i] = refFFT[i].real();
+		}
+		delete[] refFFT;
+		
+		return surface;
+	}
+	
+	double RSGISFFTWUtils::findCorrelationPeak(double *surface, unsigned int width, unsigned int height, unsigned int maxShiftX, unsigned int maxShiftY, int *shiftX, int *shiftY)
+	{
+		bool first = true;
+		double peakVal = 0;
+		*shiftX = 0;
+		*shiftY = 0;
+		int maxX = maxShiftX;
+		int maxY = maxShiftY;
+		for(int dy = -maxY; dy <= maxY; ++dy)
+		{
+			unsigned int y = (dy < 0)?(height+dy):dy;
+			if(y >= height)
+			{
+				continue;
+			}
+			for(int dx = -maxX; dx <= maxX; ++dx)
+			{
+				unsigned int x = (dx < 0)?(width+dx):dx;
+				if(x >= width)
+				{
+					continue;
+				}
+				if(first || (surface[(y*width)+x] > peakVal))
+				{
+					peakVal = surface[(y*width)+x];
+					*shiftX = dx;
+					*shiftY = dy;
+					first = false;
+				}
+			}
+		}
+		return peakVal;
+	}
+	
+	unsigned int RSGISFFTWUtils::nextPowerOf2(unsigned int val)
+	{
+		unsigned int pow2 = 1;
+		while(pow2 < val)
+		{
+			pow2 <<= 1;
+		}
+		return pow2;
+	}
+	
 	RSGISFFTWUtils::~RSGISFFTWUtils()
 	{
 		
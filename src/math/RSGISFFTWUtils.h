@@ -24,10 +24,12 @@
 #define RSGISFFTWUtils_H
 
 #include <complex>
+#include <utility>
 //#include <fftw3.h>
 #include <math.h>
 #include "RSGISMatrices.h"
 #include "RSGISMatricesException.h"
+#include "RSGISMathException.h"
 
 // mark all exported classes/functions with DllExport to have
 // them exported by Visual Studio
@@ -44,11 +46,28 @@
 
 namespace rsgis{namespace math{
 	    
+	/**
+	 * Fast Fourier transforms (radix-2, so the lengths must be powers of 2)
+	 * and the phase correlation of image windows, which provides the shift
+	 * between two windows from a single pair of 2D transforms.
+	 */
 	class DllExport RSGISFFTWUtils
 		{
 		public:
 			RSGISFFTWUtils();
-
+			/** In-place transform of n values; the inverse transform is scaled by 1/n. */
+			void fft1D(std::complex<double> *data, unsigned int n, bool inverse);
+			/** In-place transform of a row-major grid of width x height values. */
+			void fft2D(std::complex<double> *data, unsigned int width, unsigned int height, bool inverse);
+			/**
+			 * Returns (caller to delete[]) the phase correlation surface of two row-major
+			 * width x height windows. The peak is at (dx,dy) where reference(x,y) matches
+			 * floating(x-dx,y-dy), with negative shifts wrapped to the end of each axis.
+			 */
+			double* phaseCorrelation(float *reference, float *floating, unsigned int width, unsigned int height);
+			/** Finds the peak of a correlation surface for shifts within +/- maxShiftX and maxShiftY, returning the peak value. */
+			double findCorrelationPeak(double *surface, unsigned int width, unsigned int height, unsigned int maxShiftX, unsigned int maxShiftY, int *shiftX, int *shiftY);
+			static unsigned int nextPowerOf2(unsigned int val);
 			~RSGISFFTWUtils();
 		};
 }}
@@ -0,0 +1,149 @@
+/*
+ *  RSGISStreamingHistogram.cpp
+ *  RSGIS_LIB
+ *
+ *  Created by agent on 19/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISStreamingHistogram.h"
+
+namespace rsgis{namespace math{
+
+    RSGISStreamingHistogram::RSGISStreamingHistogram(double binWidth, size_t maxNumBins)
+    {
+        if(binWidth <= 0)
+        {
+            throw RSGISMathException("The histogram bin width must be greater than zero.");
+        }
+        this->initBinWidth = binWidth;
+        this->binWidth = binWidth;
+        this->maxNumBins = maxNumBins;
+        if(this->maxNumBins < 2)
+        {
+            this->maxNumBins = 2;
+        }
+        this->minBinIdx = 0;
+        this->numValues = 0;
+    }
+
+    void RSGISStreamingHistogram::merge(RSGISStreamingHistogram *hist)
+    {
+        if(hist->initBinWidth != this->initBinWidth)
+        {
+            throw RSGISMathException("Histograms can only be merged if they were created with the same bin width.");
+        }
+
+        while(this->binWidth < hist->binWidth)
+        {
+            this->doubleBinWidth();
+        }
+
+        double binPos = 0;
+        for(size_t i = 0; i < hist->bins.size(); ++i)
+        {
+            if(hist->bins[i] > 0)
+            {
+                // The centre of the bin is within the same bin of this histogram
+                // as the bin widths are the initial width multiplied by powers of 2.
+                binPos = this->extendToValue((hist->minBinIdx + ((double)i) + 0.5) * hist->binWidth);
+                this->bins[((size_t)(binPos - this->minBinIdx))] += hist->bins[i];
+                this->numValues += hist->bins[i];
+            }
+        }
+    }
+
+    double RSGISStreamingHistogram::calcPercentile(float percentile)
+    {
+        if(this->numValues == 0)
+        {
+            throw RSGISMathException("A percentile cannot be calculated from an empty histogram.");
+        }
+
+        unsigned long percentileValCount = floor(((double)this->numValues) * (percentile / 100));
+        if(percentileValCount == 0)
+        {
+            return (this->minBinIdx + 0.5) * this->binWidth;
+        }
+
+        unsigned long valCount = 0;
+        for(size_t i = 0; i < this->bins.size(); ++i)
+        {
+            valCount += this->bins[i];
+            if(valCount >= percentileValCount)
+            {
+                return (this->minBinIdx + ((double)i) + 0.5) * this->binWidth;
+            }
+        }
+        throw RSGISMathException("Could not find the percentile bin within the histogram.");
+    }
+
+    double RSGISStreamingHistogram::extendToValue(double val)
+    {
+        while(true)
+        {
+            double binPos = floor(val / this->binWidth);
+            if(this->bins.empty())
+            {
+                this->minBinIdx = binPos;
+                this->bins.assign(1, 0);
+                return binPos;
+            }
+
+            double maxBinIdx = this->minBinIdx + ((double)this->bins.size()) - 1;
+            double newMinBinIdx = (binPos < this->minBinIdx)?binPos:this->minBinIdx;
+            double newMaxBinIdx = (binPos > maxBinIdx)?binPos:maxBinIdx;
+            if(((newMaxBinIdx - newMinBinIdx) + 1) <= ((double)this->maxNumBins))
+            {
+                if(newMinBinIdx < this->minBinIdx)
+                {
+                    this->bins.insert(this->bins.begin(), ((size_t)(this->minBinIdx - newMinBinIdx)), 0);
+                    this->minBinIdx = newMinBinIdx;
+                }
+                if(newMaxBinIdx > maxBinIdx)
+                {
+                    this->bins.resize(((size_t)(newMaxBinIdx - this->minBinIdx)) + 1, 0);
+                }
+                return binPos;
+            }
+            this->doubleBinWidth();
+        }
+    }
+
+    void RSGISStreamingHistogram::doubleBinWidth()
+    {
+        if(!this->bins.empty())
+        {
+            double newMinBinIdx = floor(this->minBinIdx / 2);
+            double newMaxBinIdx = floor((this->minBinIdx + ((double)this->bins.size()) - 1) / 2);
+            std::vector<unsigned long> newBins(((size_t)(newMaxBinIdx - newMinBinIdx)) + 1, 0);
+            for(size_t i = 0; i < this->bins.size(); ++i)
+            {
+                newBins[((size_t)(floor((this->minBinIdx + ((double)i)) / 2) - newMinBinIdx))] += this->bins[i];
+            }
+            this->bins.swap(newBins);
+            this->minBinIdx = newMinBinIdx;
+        }
+        this->binWidth = this->binWidth * 2;
+    }
+
+    RSGISStreamingHistogram::~RSGISStreamingHistogram()
+    {
+
+    }
+
+}}
@@ -0,0 +1,98 @@
+/*
+ *  RSGISStreamingHistogram.h
+ *  RSGIS_LIB
+ *
+ *  Created by agent on 19/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISStreamingHistogram_H
+#define RSGISStreamingHistogram_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <math.h>
+
+#include "math/RSGISMathException.h"
+
+/** The default maximum number of bins held by RSGISStreamingHistogram before the bins are merged. */
+#define RSGIS_STREAMING_HIST_MAX_BINS 1048576
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_maths_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace math{
+
+    /**
+     * A histogram for calculating percentiles in a single pass over values where the
+     * range is not known in advance. Bins have a fixed width and are aligned to zero
+     * (bin i covers [i*binWidth, (i+1)*binWidth)), the range held growing with the
+     * values added. If the range would need more than maxNumBins bins then the bin
+     * width is doubled, merging pairs of bins, so the memory used is bounded. Histograms
+     * with the same initial bin width can be merged, so a histogram can be built per
+     * thread and combined at the end. Values which are not finite are ignored.
+     */
+    class DllExport RSGISStreamingHistogram
+    {
+    public:
+        RSGISStreamingHistogram(double binWidth, size_t maxNumBins=RSGIS_STREAMING_HIST_MAX_BINS);
+        inline void addValue(double val)
+        {
+            if((val != val) || (fabs(val) == HUGE_VAL))
+            {
+                return;
+            }
+            double binPos = floor(val / this->binWidth);
+            if(this->bins.empty() || (binPos < this->minBinIdx) || (binPos >= (this->minBinIdx + ((double)this->bins.size()))))
+            {
+                binPos = this->extendToValue(val);
+            }
+            ++this->bins[((size_t)(binPos - this->minBinIdx))];
+            ++this->numValues;
+        };
+        /** Adds the counts of another histogram, which must have been created with the same bin width. */
+        void merge(RSGISStreamingHistogram *hist);
+        /** Returns the centre of the bin containing the percentile (0-100), as RSGISMathsUtils::calcPercentile. */
+        double calcPercentile(float percentile);
+        unsigned long getNumValues(){return this->numValues;};
+        double getBinWidth(){return this->binWidth;};
+        ~RSGISStreamingHistogram();
+    protected:
+        double extendToValue(double val);
+        void doubleBinWidth();
+        double initBinWidth;
+        double binWidth;
+        size_t maxNumBins;
+        double minBinIdx;
+        std::vector<unsigned long> bins;
+        unsigned long numValues;
+    };
+
+}}
+
+#endif
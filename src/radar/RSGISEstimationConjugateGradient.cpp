@@ -956,6 +956,7 @@ namespace rsgis {namespace radar
 			// START ITERATING
 			for(int itt = 0; itt < ittmax;itt++)
 			{
+				this->numIterations++;
 				// Zero matrices
 				gsl_vector_set_zero(aux1);
 				gsl_vector_set_zero(aux2);
@@ -1253,6 +1254,7 @@ namespace rsgis {namespace radar
 			// START ITTERATING
 			for(int itt = 0; itt < ittmax;itt++)
 			{
+				this->numIterations++;
 				// Set up equations and Frechet derivative operator
 				dielectric = gsl_vector_get(estimatedPar, 0);
 				density = gsl_vector_get(estimatedPar, 1);
@@ -1657,6 +1659,7 @@ namespace rsgis {namespace radar
 			// START ITTERATING
 			for(int itt = 0; itt < ittmax;itt++)
 			{
+				this->numIterations++;
 				// Set up equations and Frechet derivative operator
 				dielectric = gsl_vector_get(estimatedPar, 0);
 				density = gsl_vector_get(estimatedPar, 1);
@@ -2064,6 +2067,7 @@ namespace rsgis {namespace radar
 			// START ITTERATING
 			for(int itt = 0; itt < ittmax;itt++)
 			{
+				this->numIterations++;
 				// Zero matrices
 				gsl_vector_set_zero(aux1);
 				gsl_vector_set_zero(aux2);
@@ -2276,6 +2280,7 @@ namespace rsgis {namespace radar
 			// START ITTERATING
 			for(int itt = 0; itt < ittmax;itt++)
 			{
+				this->numIterations++;
 				// Zero matrices
 				gsl_vector_set_zero(aux1);
 				gsl_vector_set_zero(aux2);
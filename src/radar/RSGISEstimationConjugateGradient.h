@@ -248,6 +248,8 @@ namespace rsgis {namespace radar{
 		gsl_vector* getAPrioriPar(){return this->aPrioriPar;};
 		virtual estOptimizerType getOptimiserType(){return conjugateGradient;}; 
 		virtual void printOptimiser(){std::cout << "Conjugate gradient - 2 Var 2 Data, with Restarts" << std::endl;};
+		virtual unsigned long getNumIterations(){return this->conjGradOpt->getNumIterations();};
+		virtual void resetNumIterations(){this->conjGradOpt->resetNumIterations();};
 		~RSGISEstimationConjugateGradient2Var2DataWithRestarts();
 	private:
 		rsgis::math::RSGISMathTwoVariableFunction *functionA;
@@ -283,6 +285,8 @@ namespace rsgis {namespace radar{
 		gsl_vector* getAPrioriPar(){return this->aPrioriPar;};
 		virtual estOptimizerType getOptimiserType(){return conjugateGradient;}; 
 		virtual void printOptimiser(){std::cout << "Conjugate gradient - 2 Var 3 Data, with Restarts" << std::endl;};
+		virtual unsigned long getNumIterations(){return this->conjGradOpt->getNumIterations();};
+		virtual void resetNumIterations(){this->conjGradOpt->resetNumIterations();};
 		~RSGISEstimationConjugateGradient2Var3DataWithRestarts();
 	private:
 		rsgis::math::RSGISMathTwoVariableFunction *functionA;
@@ -319,6 +323,8 @@ namespace rsgis {namespace radar{
 		gsl_vector* getAPrioriPar(){return this->aPrioriPar;};
 		virtual estOptimizerType getOptimiserType(){return conjugateGradient;}; 
 		virtual void printOptimiser(){std::cout << "Conjugate gradient - 3 Var 3 Data, with Restarts" << std::endl;};
+		virtual unsigned long getNumIterations(){return this->conjGradOpt->getNumIterations();};
+		virtual void resetNumIterations(){this->conjGradOpt->resetNumIterations();};
 		~RSGISEstimationConjugateGradient3Var3DataWithRestarts();
 	private:
 		double *minMaxIntervalA;
@@ -352,6 +358,8 @@ namespace rsgis {namespace radar{
 		gsl_vector* getAPrioriPar(){return this->aPrioriPar;};
 		virtual estOptimizerType getOptimiserType(){return conjugateGradient;}; 
 		virtual void printOptimiser(){std::cout << "Conjugate gradient - 3 Var 4 Data, with Restarts" << std::endl;};
+		virtual unsigned long getNumIterations(){return this->conjGradOpt->getNumIterations();};
+		virtual void resetNumIterations(){this->conjGradOpt->resetNumIterations();};
 		~RSGISEstimationConjugateGradient3Var4DataWithRestarts();
 	private:
 		double *minMaxIntervalA;
@@ -452,6 +452,7 @@ namespace rsgis {namespace radar{
 		gsl_vector_free(testPar);
 		gsl_vector_free(testOut);
 		delete leastSquares;
+		this->numIterations += optimiser->getNumIterations();
 		delete optimiser;
 		
 		// Exit
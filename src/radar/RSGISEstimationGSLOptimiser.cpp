@@ -131,6 +131,7 @@ namespace rsgis { namespace radar {
 		
 		for(unsigned int i = 0; i < ittMax; i++)
 		{
+			this->numIterations++;
 			status = gsl_multimin_fdfminimizer_iterate(s);
 			status = gsl_multimin_test_gradient(s->gradient, 1e-3);
 		}
@@ -193,6 +194,7 @@ namespace rsgis { namespace radar {
 		
 		for(unsigned int i = 0; i < ittMax; i++)
 		{
+			this->numIterations++;
 			status = gsl_multimin_fminimizer_iterate(s);
 		}
 		gsl_vector_set(outParError, 0, gsl_vector_get(s->x, 0));
@@ -0,0 +1,748 @@
+/*
+ *  RSGISEstimationLUTInversion.cpp
+ *  RSGIS_LIB
+ *
+ *  Created by agent on 19/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISEstimationLUTInversion.h"
+
+namespace rsgis {namespace radar{
+
+	RSGISEstimationForwardModelLUT::RSGISEstimationForwardModelLUT(std::vector<rsgis::math::RSGISMathTwoVariableFunction*> *functions, double *minMaxIntervalA, double *minMaxIntervalB)
+	{
+		if((functions == NULL) || functions->empty())
+		{
+			throw RSGISException("At least one forward model function must be provided.");
+		}
+		this->numPar = 2;
+		this->numData = functions->size();
+
+		std::vector<double> aVals;
+		std::vector<double> bVals;
+		this->getGridValues(minMaxIntervalA, &aVals);
+		this->getGridValues(minMaxIntervalB, &bVals);
+
+		size_t numGridEntries = aVals.size() * bVals.size();
+		double *pars = new double[numGridEntries * this->numPar];
+		double *data = new double[numGridEntries * this->numData];
+		size_t n = 0;
+		for(size_t a = 0; a < aVals.size(); ++a)
+		{
+			for(size_t b = 0; b < bVals.size(); ++b)
+			{
+				bool finite = true;
+				for(unsigned int f = 0; f < this->numData; ++f)
+				{
+					double val = functions->at(f)->calcFunction(aVals[a], bVals[b]);
+					if((val != val) || (fabs(val) == std::numeric_limits<double>::infinity()))
+					{
+						finite = false;
+					}
+					data[(n * this->numData) + f] = val;
+				}
+				if(finite)
+				{
+					pars[n * this->numPar] = aVals[a];
+					pars[(n * this->numPar) + 1] = bVals[b];
+					++n;
+				}
+			}
+		}
+		this->buildLUT(pars, data, n);
+	}
+
+	RSGISEstimationForwardModelLUT::RSGISEstimationForwardModelLUT(std::vector<rsgis::math::RSGISMathThreeVariableFunction*> *functions, double *minMaxIntervalA, double *minMaxIntervalB, double *minMaxIntervalC)
+	{
+		if((functions == NULL) || functions->empty())
+		{
+			throw RSGISException("At least one forward model function must be provided.");
+		}
+		this->numPar = 3;
+		this->numData = functions->size();
+
+		std::vector<double> aVals;
+		std::vector<double> bVals;
+		std::vector<double> cVals;
+		this->getGridValues(minMaxIntervalA, &aVals);
+		this->getGridValues(minMaxIntervalB, &bVals);
+		this->getGridValues(minMaxIntervalC, &cVals);
+
+		size_t numGridEntries = aVals.size() * bVals.size() * cVals.size();
+		double *pars = new double[numGridEntries * this->numPar];
+		double *data = new double[numGridEntries * this->numData];
+		size_t n = 0;
+		for(size_t a = 0; a < aVals.size(); ++a)
+		{
+			for(size_t b = 0; b < bVals.size(); ++b)
+			{
+				for(size_t c = 0; c < cVals.size(); ++c)
+				{
+					bool finite = true;
+					for(unsigned int f = 0; f < this->numData; ++f)
+					{
+						double val = functions->at(f)->calcFunction(aVals[a], bVals[b], cVals[c]);
+						if((val != val) || (fabs(val) == std::numeric_limits<double>::infinity()))
+						{
+							finite = false;
+						}
+						data[(n * this->numData) + f] = val;
+					}
+					if(finite)
+					{
+						pars[n * this->numPar] = aVals[a];
+						pars[(n * this->numPar) + 1] = bVals[b];
+						pars[(n * this->numPar) + 2] = cVals[c];
+						++n;
+					}
+				}
+			}
+		}
+		this->buildLUT(pars, data, n);
+	}
+
+	size_t RSGISEstimationForwardModelLUT::findNearest(const double *data, double *sqError) const
+	{
+		size_t bestPos = this->numEntries;
+		double bestDist = std::numeric_limits<double>::infinity();
+		this->searchTree(data, 0, this->numEntries, &bestPos, &bestDist);
+		if(bestPos == this->numEntries)
+		{
+			*sqError = std::numeric_limits<double>::quiet_NaN();
+		}
+		else
+		{
+			*sqError = bestDist;
+		}
+		return bestPos;
+	}
+
+	void RSGISEstimationForwardModelLUT::getGridValues(double *minMaxInterval, std::vector<double> *vals)
+	{
+		if(minMaxInterval == NULL)
+		{
+			throw RSGISException("The range of each parameter must be provided.");
+		}
+		if(!(minMaxInterval[2] > 0))
+		{
+			throw RSGISException("The step of each parameter must be greater than zero.");
+		}
+		// Stepped as for the exhaustive search so the grid values are the same.
+		double val = minMaxInterval[0];
+		while(val < minMaxInterval[1])
+		{
+			vals->push_back(val);
+			val = val + minMaxInterval[2];
+		}
+		if(vals->empty())
+		{
+			throw RSGISException("The maximum of each parameter must be greater than the minimum.");
+		}
+	}
+
+	void RSGISEstimationForwardModelLUT::buildLUT(double *pars, double *data, size_t numGridEntries)
+	{
+		if(numGridEntries == 0)
+		{
+			delete[] pars;
+			delete[] data;
+			throw RSGISException("The forward model was not finite for any of the parameter values.");
+		}
+		this->numEntries = numGridEntries;
+
+		size_t *perm = new size_t[this->numEntries];
+		for(size_t i = 0; i < this->numEntries; ++i)
+		{
+			perm[i] = i;
+		}
+		this->splitDims = new unsigned char[this->numEntries];
+		this->buildTree(perm, data, 0, this->numEntries);
+
+		// Store the entries in the tree order so the search reads them in sequence.
+		this->parVals = new double[this->numEntries * this->numPar];
+		this->dataVals = new double[this->numEntries * this->numData];
+		this->entryIdxs = new size_t[this->numEntries];
+		for(size_t i = 0; i < this->numEntries; ++i)
+		{
+			for(unsigned int j = 0; j < this->numPar; ++j)
+			{
+				this->parVals[(i * this->numPar) + j] = pars[(perm[i] * this->numPar) + j];
+			}
+			for(unsigned int j = 0; j < this->numData; ++j)
+			{
+				this->dataVals[(i * this->numData) + j] = data[(perm[i] * this->numData) + j];
+			}
+			this->entryIdxs[i] = perm[i];
+		}
+		delete[] perm;
+		delete[] pars;
+		delete[] data;
+	}
+
+	void RSGISEstimationForwardModelLUT::buildTree(size_t *perm, double *data, size_t start, size_t end)
+	{
+		if((end - start) < 2)
+		{
+			if(end > start)
+			{
+				this->splitDims[start] = 0;
+			}
+			return;
+		}
+
+		// Split on the dimension with the largest range.
+		unsigned int dim = 0;
+		double maxRange = -1;
+		for(unsigned int d = 0; d < this->numData; ++d)
+		{
+			double minVal = data[(perm[start] * this->numData) + d];
+			double maxVal = minVal;
+			for(size_t i = start + 1; i < end; ++i)
+			{
+				double val = data[(perm[i] * this->numData) + d];
+				if(val < minVal)
+				{
+					minVal = val;
+				}
+				else if(val > maxVal)
+				{
+					maxVal = val;
+				}
+			}
+			if((maxVal - minVal) > maxRange)
+			{
+				maxRange = maxVal - minVal;
+				dim = d;
+			}
+		}
+
+		unsigned int numData = this->numData;
+		size_t mid = start + ((end - start) / 2);
+		std::nth_element(perm + start, perm + mid, perm + end, [data, numData, dim](size_t first, size_t second)
+		{
+			return data[(first * numData) + dim] < data[(second * numData) + dim];
+		});
+		this->splitDims[mid] = dim;
+
+		this->buildTree(perm, data, start, mid);
+		this->buildTree(perm, data, mid + 1, end);
+	}
+
+	void RSGISEstimationForwardModelLUT::searchTree(const double *data, size_t start, size_t end, size_t *bestPos, double *bestDist) const
+	{
+		if(start >= end)
+		{
+			return;
+		}
+		size_t mid = start + ((end - start) / 2);
+		const double *entryData = &this->dataVals[mid * this->numData];
+
+		// Summed in the same order as RSGISFunction2Var2DataLeastSquares.
+		double dist = 0;
+		for(unsigned int d = 0; d < this->numData; ++d)
+		{
+			double diff = data[d] - entryData[d];
+			dist = dist + (diff * diff);
+		}
+		if((dist < *bestDist) || ((dist == *bestDist) && (*bestPos < this->numEntries) && (this->entryIdxs[mid] < this->entryIdxs[*bestPos])))
+		{
+			*bestDist = dist;
+			*bestPos = mid;
+		}
+
+		// Entries with the same distance can be either side of the split so the
+		// far side is only skipped where it must be further away.
+		double splitDiff = data[this->splitDims[mid]] - entryData[this->splitDims[mid]];
+		if(splitDiff < 0)
+		{
+			this->searchTree(data, start, mid, bestPos, bestDist);
+			if((splitDiff * splitDiff) <= *bestDist)
+			{
+				this->searchTree(data, mid + 1, end, bestPos, bestDist);
+			}
+		}
+		else
+		{
+			this->searchTree(data, mid + 1, end, bestPos, bestDist);
+			if((splitDiff * splitDiff) <= *bestDist)
+			{
+				this->searchTree(data, start, mid, bestPos, bestDist);
+			}
+		}
+	}
+
+	RSGISEstimationForwardModelLUT::~RSGISEstimationForwardModelLUT()
+	{
+		delete[] this->parVals;
+		delete[] this->dataVals;
+		delete[] this->entryIdxs;
+		delete[] this->splitDims;
+	}
+
+
+	RSGISEstimationLUTInversion::RSGISEstimationLUTInversion(RSGISEstimationForwardModelLUT *lut, RSGISEstimationOptimiser *refineOptimiser)
+	{
+		this->lut = lut;
+		this->refineOptimiser = refineOptimiser;
+		this->data = new double[lut->getNumData()];
+		this->lutPar = gsl_vector_alloc(lut->getNumPar());
+	}
+
+	int RSGISEstimationLUTInversion::minimise(gsl_vector *inData, gsl_vector *initialPar, gsl_vector *outParError)
+	{
+		unsigned int numPar = this->lut->getNumPar();
+		if(inData->size < this->lut->getNumData())
+		{
+			throw RSGISException("There are fewer data values than the look up table was created with.");
+		}
+		for(unsigned int i = 0; i < this->lut->getNumData(); ++i)
+		{
+			this->data[i] = gsl_vector_get(inData, i);
+		}
+
+		double sqError = 0;
+		size_t idx = this->lut->findNearest(this->data, &sqError);
+		if(idx == this->lut->getNumEntries())
+		{
+			for(unsigned int j = 0; j < numPar + 1; ++j)
+			{
+				gsl_vector_set(outParError, j, std::numeric_limits<double>::quiet_NaN());
+			}
+			return 0;
+		}
+		const double *par = this->lut->getPar(idx);
+
+		int status = 0;
+		if(this->refineOptimiser != NULL)
+		{
+			for(unsigned int j = 0; j < numPar; ++j)
+			{
+				gsl_vector_set(this->lutPar, j, par[j]);
+			}
+			status = this->refineOptimiser->minimise(inData, this->lutPar, outParError);
+
+			bool refined = true;
+			for(unsigned int j = 0; j < numPar; ++j)
+			{
+				if(gsl_vector_get(outParError, j) != gsl_vector_get(outParError, j))
+				{
+					refined = false;
+				}
+			}
+			if(refined)
+			{
+				return status;
+			}
+		}
+
+		for(unsigned int j = 0; j < numPar; ++j)
+		{
+			gsl_vector_set(outParError, j, par[j]);
+		}
+		gsl_vector_set(outParError, numPar, sqError);
+		return status;
+	}
+
+	void RSGISEstimationLUTInversion::modifyAPriori(gsl_vector *newAPrioriPar)
+	{
+		if(this->refineOptimiser != NULL)
+		{
+			this->refineOptimiser->modifyAPriori(newAPrioriPar);
+		}
+	}
+
+	gsl_vector* RSGISEstimationLUTInversion::getAPrioriPar()
+	{
+		if(this->refineOptimiser == NULL)
+		{
+			throw RSGISException("Not available for this optimiser");
+		}
+		return this->refineOptimiser->getAPrioriPar();
+	}
+
+	void RSGISEstimationLUTInversion::printOptimiser()
+	{
+		std::cout << "Look up table - " << this->lut->getNumPar() << " Var " << this->lut->getNumData() << " Data (" << this->lut->getNumEntries() << " entries)" << std::endl;
+		if(this->refineOptimiser != NULL)
+		{
+			std::cout << "Refined using: ";
+			this->refineOptimiser->printOptimiser();
+		}
+	}
+
+	unsigned long RSGISEstimationLUTInversion::getNumIterations()
+	{
+		if(this->refineOptimiser == NULL)
+		{
+			return 0;
+		}
+		return this->refineOptimiser->getNumIterations();
+	}
+
+	void RSGISEstimationLUTInversion::resetNumIterations()
+	{
+		if(this->refineOptimiser != NULL)
+		{
+			this->refineOptimiser->resetNumIterations();
+		}
+	}
+
+	RSGISEstimationLUTInversion::~RSGISEstimationLUTInversion()
+	{
+		delete[] this->data;
+		gsl_vector_free(this->lutPar);
+	}
+
+
+	RSGISEstimationLUTInversionImage::RSGISEstimationLUTInversionImage(RSGISEstimationForwardModelLUT *lut, std::vector<RSGISEstimationOptimiser*> *refineOptimisers, unsigned int numThreads)
+	{
+		this->lut = lut;
+		this->numThreads = rsgis::getNumProcessingThreads(numThreads);
+		if(refineOptimisers != NULL)
+		{
+			if(refineOptimisers->empty())
+			{
+				throw RSGISException("An optimiser must be provided for each thread to refine the look up table inversion.");
+			}
+			if(refineOptimisers->size() < this->numThreads)
+			{
+				this->numThreads = refineOptimisers->size();
+			}
+		}
+		for(unsigned int t = 0; t < this->numThreads; ++t)
+		{
+			this->inversions.push_back(new RSGISEstimationLUTInversion(lut, ((refineOptimisers != NULL)?refineOptimisers->at(t):NULL)));
+		}
+	}
+
+	void RSGISEstimationLUTInversionImage::invertImage(GDALDataset *inDataset, GDALDataset *outDataset)
+	{
+		unsigned int numData = this->lut->getNumData();
+		unsigned int numOutBands = this->lut->getNumPar() + 1;
+		unsigned int width = inDataset->GetRasterXSize();
+		unsigned int height = inDataset->GetRasterYSize();
+		if(((unsigned int)inDataset->GetRasterCount()) < numData)
+		{
+			throw RSGISImageException("The input image must have a band for each data value of the look up table.");
+		}
+		if((((unsigned int)outDataset->GetRasterXSize()) != width) || (((unsigned int)outDataset->GetRasterYSize()) != height) || (((unsigned int)outDataset->GetRasterCount()) < numOutBands))
+		{
+			throw RSGISImageException("The output image must be the same size as the input image and have a band for each parameter and the error.");
+		}
+
+		int xBlockSize = 0;
+		int yBlockSize = 0;
+		inDataset->GetRasterBand(1)->GetBlockSize(&xBlockSize, &yBlockSize);
+		if(yBlockSize < 1)
+		{
+			yBlockSize = 1;
+		}
+		unsigned int stripRows = ((RSGIS_LUT_INVERSION_MIN_STRIP_ROWS + yBlockSize - 1) / yBlockSize) * yBlockSize;
+		size_t numStrips = (height + stripRows - 1) / stripRows;
+		size_t maxStripPxls = ((size_t)width) * stripRows;
+
+		// Each thread has its own input handle and buffers, while the outputs are held
+		// for each strip within a group of numThreads strips so they can be written in
+		// order, by this thread, once the group has been inverted.
+		std::vector<GDALDataset*> threadDatasets;
+		std::vector<float*> threadInData;
+		std::vector<gsl_vector*> threadPxlData;
+		std::vector<gsl_vector*> threadParError;
+		std::vector<float*> stripOutData;
+		bool openFailed = false;
+		for(unsigned int t = 0; t < this->numThreads; ++t)
+		{
+			if(this->numThreads == 1)
+			{
+				threadDatasets.push_back(inDataset);
+			}
+			else if(openFailed)
+			{
+				threadDatasets.push_back(NULL);
+			}
+			else
+			{
+				GDALDataset *tDataset = (GDALDataset *) GDALOpen(inDataset->GetDescription(), GA_ReadOnly);
+				if(tDataset == NULL)
+				{
+					openFailed = true;
+				}
+				threadDatasets.push_back(tDataset);
+			}
+			threadInData.push_back(new float[maxStripPxls * numData]);
+			threadPxlData.push_back(gsl_vector_alloc(numData));
+			threadParError.push_back(gsl_vector_alloc(numOutBands));
+			stripOutData.push_back(new float[maxStripPxls * numOutBands]);
+		}
+
+		auto freeThreadData = [&]()
+		{
+			for(unsigned int t = 0; t < this->numThreads; ++t)
+			{
+				if((this->numThreads > 1) && (threadDatasets[t] != NULL))
+				{
+					GDALClose(threadDatasets[t]);
+				}
+				delete[] threadInData[t];
+				gsl_vector_free(threadPxlData[t]);
+				gsl_vector_free(threadParError[t]);
+				delete[] stripOutData[t];
+			}
+		};
+
+		try
+		{
+			if(openFailed)
+			{
+				std::string message = std::string("Could not open image ") + std::string(inDataset->GetDescription()) + std::string(" for each thread.");
+				throw RSGISImageException(message.c_str());
+			}
+
+			size_t feedbackStep = (numStrips + 9) / 10;
+			if(feedbackStep == 0)
+			{
+				feedbackStep = 1;
+			}
+			int feedbackCounter = 0;
+			std::cout << "Started" << std::flush;
+			for(size_t groupStart = 0; groupStart < numStrips; groupStart += this->numThreads)
+			{
+				size_t groupEnd = groupStart + this->numThreads;
+				if(groupEnd > numStrips)
+				{
+					groupEnd = numStrips;
+				}
+
+				rsgis::parallelForRange(groupStart, groupEnd, this->numThreads, 1, [&](size_t stripStart, size_t stripEnd, unsigned int threadIdx)
+				{
+					GDALDataset *tDataset = threadDatasets.at(threadIdx);
+					float *inData = threadInData.at(threadIdx);
+					gsl_vector *pxlData = threadPxlData.at(threadIdx);
+					gsl_vector *parError = threadParError.at(threadIdx);
+					RSGISEstimationLUTInversion *inversion = this->inversions.at(threadIdx);
+					for(size_t s = stripStart; s < stripEnd; ++s)
+					{
+						unsigned int yOff = s * stripRows;
+						unsigned int numRows = stripRows;
+						if((yOff + numRows) > height)
+						{
+							numRows = height - yOff;
+						}
+						size_t stripPxls = ((size_t)width) * numRows;
+						float *outData = stripOutData.at(s - groupStart);
+
+						for(unsigned int i = 0; i < numData; ++i)
+						{
+							if(tDataset->GetRasterBand(i+1)->RasterIO(GF_Read, 0, yOff, width, numRows, &inData[i * stripPxls], width, numRows, GDT_Float32, 0, 0) != CE_None)
+							{
+								throw RSGISImageException("Failed to read a strip of the input image.");
+							}
+						}
+
+						for(size_t p = 0; p < stripPxls; ++p)
+						{
+							if(this->isNoData(&inData[p], stripPxls))
+							{
+								for(unsigned int j = 0; j < numOutBands; ++j)
+								{
+									outData[(j * stripPxls) + p] = 0;
+								}
+								continue;
+							}
+							for(unsigned int i = 0; i < numData; ++i)
+							{
+								gsl_vector_set(pxlData, i, inData[(i * stripPxls) + p]);
+							}
+							inversion->minimise(pxlData, NULL, parError);
+							for(unsigned int j = 0; j < numOutBands; ++j)
+							{
+								double val = gsl_vector_get(parError, j);
+								if(val != val)
+								{
+									// Write the error as 9999 where there is no solution, as RSGISEstimationAlgorithmSingleSpecies.
+									val = (j == (numOutBands - 1))?9999:0;
+								}
+								outData[(j * stripPxls) + p] = val;
+							}
+						}
+					}
+				});
+
+				for(size_t s = groupStart; s < groupEnd; ++s)
+				{
+					if((s % feedbackStep) == 0)
+					{
+						std::cout << "." << feedbackCounter << "." << std::flush;
+						feedbackCounter = feedbackCounter + 10;
+					}
+					unsigned int yOff = s * stripRows;
+					unsigned int numRows = stripRows;
+					if((yOff + numRows) > height)
+					{
+						numRows = height - yOff;
+					}
+					size_t stripPxls = ((size_t)width) * numRows;
+					for(unsigned int j = 0; j < numOutBands; ++j)
+					{
+						if(outDataset->GetRasterBand(j+1)->RasterIO(GF_Write, 0, yOff, width, numRows, &stripOutData[s - groupStart][j * stripPxls], width, numRows, GDT_Float32, 0, 0) != CE_None)
+						{
+							throw RSGISImageException("Failed to write a strip of the output image.");
+						}
+					}
+				}
+			}
+			std::cout << " Complete.\n";
+		}
+		catch(std::exception &e)
+		{
+			freeThreadData();
+			throw;
+		}
+		freeThreadData();
+	}
+
+	RSGISLUTInversionAccuracy RSGISEstimationLUTInversionImage::compareToOptimiser(GDALDataset *inDataset, RSGISEstimationOptimiser *optimiser, gsl_vector *initialPar, unsigned long numSamples, unsigned long seed)
+	{
+		unsigned int numData = this->lut->getNumData();
+		unsigned int numPar = this->lut->getNumPar();
+		unsigned int width = inDataset->GetRasterXSize();
+		unsigned int height = inDataset->GetRasterYSize();
+		if(((unsigned int)inDataset->GetRasterCount()) < numData)
+		{
+			throw RSGISImageException("The input image must have a band for each data value of the look up table.");
+		}
+
+		std::vector<unsigned long> idxs;
+		rsgis::img::RSGISStratifiedRandomSampler::sampleIndexes(((unsigned long)width) * height, numSamples, seed, &idxs);
+
+		RSGISLUTInversionAccuracy accuracy;
+		accuracy.numSamples = 0;
+		accuracy.meanAbsDiff.assign(numPar, 0);
+		accuracy.rmse.assign(numPar, 0);
+		accuracy.maxAbsDiff.assign(numPar, 0);
+		accuracy.meanLUTError = 0;
+		accuracy.meanOptimiserError = 0;
+		accuracy.lutTime = 0;
+		accuracy.optimiserTime = 0;
+
+		float *pxlVals = new float[numData];
+		gsl_vector *pxlData = gsl_vector_alloc(numData);
+		gsl_vector *lutParError = gsl_vector_alloc(numPar + 1);
+		gsl_vector *optParError = gsl_vector_alloc(numPar + 1);
+		try
+		{
+			for(std::vector<unsigned long>::iterator iterIdx = idxs.begin(); iterIdx != idxs.end(); ++iterIdx)
+			{
+				unsigned int xPxl = (*iterIdx) % width;
+				unsigned int yPxl = (*iterIdx) / width;
+				for(unsigned int i = 0; i < numData; ++i)
+				{
+					if(inDataset->GetRasterBand(i+1)->RasterIO(GF_Read, xPxl, yPxl, 1, 1, &pxlVals[i], 1, 1, GDT_Float32, 0, 0) != CE_None)
+					{
+						throw RSGISImageException("Failed to read a sample pixel from the input image.");
+					}
+				}
+				if(this->isNoData(pxlVals, 1))
+				{
+					continue;
+				}
+				for(unsigned int i = 0; i < numData; ++i)
+				{
+					gsl_vector_set(pxlData, i, pxlVals[i]);
+				}
+
+				std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+				this->inversions.at(0)->minimise(pxlData, initialPar, lutParError);
+				std::chrono::steady_clock::time_point lutEndTime = std::chrono::steady_clock::now();
+				optimiser->minimise(pxlData, initialPar, optParError);
+				std::chrono::steady_clock::time_point optEndTime = std::chrono::steady_clock::now();
+
+				bool valid = true;
+				for(unsigned int j = 0; j < numPar + 1; ++j)
+				{
+					if((gsl_vector_get(lutParError, j) != gsl_vector_get(lutParError, j)) || (gsl_vector_get(optParError, j) != gsl_vector_get(optParError, j)))
+					{
+						valid = false;
+					}
+				}
+				if(!valid)
+				{
+					continue;
+				}
+
+				accuracy.lutTime += std::chrono::duration<double>(lutEndTime - startTime).count();
+				accuracy.optimiserTime += std::chrono::duration<double>(optEndTime - lutEndTime).count();
+				for(unsigned int j = 0; j < numPar; ++j)
+				{
+					double diff = fabs(gsl_vector_get(lutParError, j) - gsl_vector_get(optParError, j));
+					accuracy.meanAbsDiff[j] += diff;
+					accuracy.rmse[j] += diff * diff;
+					if(diff > accuracy.maxAbsDiff[j])
+					{
+						accuracy.maxAbsDiff[j] = diff;
+					}
+				}
+				accuracy.meanLUTError += gsl_vector_get(lutParError, numPar);
+				accuracy.meanOptimiserError += gsl_vector_get(optParError, numPar);
+				++accuracy.numSamples;
+			}
+		}
+		catch(RSGISException &e)
+		{
+			delete[] pxlVals;
+			gsl_vector_free(pxlData);
+			gsl_vector_free(lutParError);
+			gsl_vector_free(optParError);
+			throw;
+		}
+		delete[] pxlVals;
+		gsl_vector_free(pxlData);
+		gsl_vector_free(lutParError);
+		gsl_vector_free(optParError);
+
+		if(accuracy.numSamples > 0)
+		{
+			for(unsigned int j = 0; j < numPar; ++j)
+			{
+				accuracy.meanAbsDiff[j] = accuracy.meanAbsDiff[j] / accuracy.numSamples;
+				accuracy.rmse[j] = sqrt(accuracy.rmse[j] / accuracy.numSamples);
+			}
+			accuracy.meanLUTError = accuracy.meanLUTError / accuracy.numSamples;
+			accuracy.meanOptimiserError = accuracy.meanOptimiserError / accuracy.numSamples;
+		}
+
+		std::cout << "Compared the look up table inversion to the optimiser for " << accuracy.numSamples << " pixels:\n";
+		for(unsigned int j = 0; j < numPar; ++j)
+		{
+			std::cout << "\tParameter " << j+1 << ": mean abs. difference = " << accuracy.meanAbsDiff[j] << ", RMSE = " << accuracy.rmse[j] << ", max abs. difference = " << accuracy.maxAbsDiff[j] << std::endl;
+		}
+		std::cout << "\tMean error: look up table = " << accuracy.meanLUTError << ", optimiser = " << accuracy.meanOptimiserError << std::endl;
+		std::cout << "\tTime (s): look up table = " << accuracy.lutTime << ", optimiser = " << accuracy.optimiserTime << std::endl;
+
+		return accuracy;
+	}
+
+	RSGISEstimationLUTInversionImage::~RSGISEstimationLUTInversionImage()
+	{
+		for(std::vector<RSGISEstimationLUTInversion*>::iterator iterInv = this->inversions.begin(); iterInv != this->inversions.end(); ++iterInv)
+		{
+			delete *iterInv;
+		}
+	}
+
+}}
@@ -0,0 +1,183 @@
+/*
+ *  RSGISEstimationLUTInversion.h
+ *  RSGIS_LIB
+ *
+ *  Created by agent on 19/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISEstimationLUTInversion_H
+#define RSGISEstimationLUTInversion_H
+
+#include <math.h>
+#include <limits>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+
+#include "gdal_priv.h"
+
+#include "common/RSGISException.h"
+#include "common/RSGISImageException.h"
+#include "common/RSGISThreadUtils.h"
+#include "math/RSGISMathFunction.h"
+#include "img/RSGISStratifiedRandomSampler.h"
+#include "radar/RSGISEstimationOptimiser.h"
+
+/** The minimum number of rows read and inverted at a time by RSGISEstimationLUTInversionImage. */
+#define RSGIS_LUT_INVERSION_MIN_STRIP_ROWS 64
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_radar_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis {namespace radar{
+
+	/**
+	 * A look up table of the forward model (e.g., HH and HV backscatter) evaluated over a
+	 * regular grid of the parameters (e.g., height, density and moisture). Each parameter
+	 * range is given as {min, max, step} and stepped as for the exhaustive search
+	 * (min, min+step, ... while less than max). Grid points where the forward model is
+	 * not finite are left out.
+	 *
+	 * The entries are held in a k-d tree over the data values so the entry with the smallest
+	 * sum of squared differences to the data, the least squares error minimised by
+	 * RSGISEstimationExhaustiveSearch2Var2Data, is found without checking every entry. Where
+	 * entries have the same error the first in the grid order is returned, so the result
+	 * is the same as the exhaustive search over the same grid. The table is not changed
+	 * by findNearest so can be shared between threads.
+	 */
+	class DllExport RSGISEstimationForwardModelLUT
+	{
+	public:
+		RSGISEstimationForwardModelLUT(std::vector<rsgis::math::RSGISMathTwoVariableFunction*> *functions, double *minMaxIntervalA, double *minMaxIntervalB);
+		RSGISEstimationForwardModelLUT(std::vector<rsgis::math::RSGISMathThreeVariableFunction*> *functions, double *minMaxIntervalA, double *minMaxIntervalB, double *minMaxIntervalC);
+		unsigned int getNumPar(){return this->numPar;};
+		unsigned int getNumData(){return this->numData;};
+		size_t getNumEntries(){return this->numEntries;};
+		/** Returns the index of the entry nearest the data (numData values) and its squared error, or getNumEntries() if the data are not finite. */
+		size_t findNearest(const double *data, double *sqError) const;
+		/** The parameters (numPar values) of an entry. */
+		inline const double* getPar(size_t idx) const {return &this->parVals[idx * this->numPar];};
+		~RSGISEstimationForwardModelLUT();
+	protected:
+		void getGridValues(double *minMaxInterval, std::vector<double> *vals);
+		void buildLUT(double *pars, double *data, size_t numGridEntries);
+		void buildTree(size_t *perm, double *data, size_t start, size_t end);
+		void searchTree(const double *data, size_t start, size_t end, size_t *bestPos, double *bestDist) const;
+		unsigned int numPar;
+		unsigned int numData;
+		size_t numEntries;
+		double *parVals;
+		double *dataVals;
+		size_t *entryIdxs;
+		unsigned char *splitDims;
+	private:
+		RSGISEstimationForwardModelLUT(const RSGISEstimationForwardModelLUT &lut);
+		RSGISEstimationForwardModelLUT& operator=(const RSGISEstimationForwardModelLUT &lut);
+	};
+
+	/**
+	 * Inverts the data using a RSGISEstimationForwardModelLUT, returning the parameters of
+	 * the nearest entry and the squared error (so initialPar is not used). If a refine
+	 * optimiser is given it is run from the look up table parameters rather than initialPar
+	 * (a warm start) and its result returned, unless it does not give a parameter which is a number.
+	 * An instance must only be used by one thread at a time but the table can be shared.
+	 */
+	class DllExport RSGISEstimationLUTInversion : public RSGISEstimationOptimiser
+	{
+	public:
+		RSGISEstimationLUTInversion(RSGISEstimationForwardModelLUT *lut, RSGISEstimationOptimiser *refineOptimiser=NULL);
+		int minimise(gsl_vector *inData, gsl_vector *initialPar, gsl_vector *outParError);
+		virtual void modifyAPriori(gsl_vector *newAPrioriPar);
+		virtual gsl_vector* getAPrioriPar();
+		virtual estOptimizerType getOptimiserType(){return lookupTable;};
+		virtual void printOptimiser();
+		virtual unsigned long getNumIterations();
+		virtual void resetNumIterations();
+		~RSGISEstimationLUTInversion();
+	private:
+		RSGISEstimationForwardModelLUT *lut;
+		RSGISEstimationOptimiser *refineOptimiser;
+		double *data;
+		gsl_vector *lutPar;
+	};
+
+	/** The differences between the look up table inversion and a full optimisation over a sample of pixels. */
+	struct DllExport RSGISLUTInversionAccuracy
+	{
+		unsigned long numSamples;
+		std::vector<double> meanAbsDiff;
+		std::vector<double> rmse;
+		std::vector<double> maxAbsDiff;
+		double meanLUTError;
+		double meanOptimiserError;
+		/** Time taken in seconds. */
+		double lutTime;
+		double optimiserTime;
+	};
+
+	/**
+	 * Inverts an image with a band for each data value (in dB) of the look up table, reading
+	 * and inverting strips of rows in parallel, each thread with its own input image handle,
+	 * and writing the strips in order. The output image has a band for each parameter followed
+	 * by the error. Pixels where a band value is not a number or less than -100 (the image
+	 * border) are given 0 for each output, as in RSGISEstimationAlgorithmSingleSpecies.
+	 *
+	 * If refineOptimisers is not NULL the look up table is used to warm start the optimiser of
+	 * the thread (see RSGISEstimationLUTInversion); the optimisers are not thread safe so one
+	 * must be given for each thread, the number of threads being limited to the number given.
+	 */
+	class DllExport RSGISEstimationLUTInversionImage
+	{
+	public:
+		RSGISEstimationLUTInversionImage(RSGISEstimationForwardModelLUT *lut, std::vector<RSGISEstimationOptimiser*> *refineOptimisers=NULL, unsigned int numThreads=1);
+		void invertImage(GDALDataset *inDataset, GDALDataset *outDataset);
+		/** Compares the inversion with the full optimisation for a random sample of numSamples pixels, printing a summary. */
+		RSGISLUTInversionAccuracy compareToOptimiser(GDALDataset *inDataset, RSGISEstimationOptimiser *optimiser, gsl_vector *initialPar, unsigned long numSamples, unsigned long seed);
+		~RSGISEstimationLUTInversionImage();
+	protected:
+		inline bool isNoData(float *vals, size_t stride)
+		{
+			for(unsigned int i = 0; i < this->lut->getNumData(); ++i)
+			{
+				if((vals[i * stride] != vals[i * stride]) || (vals[i * stride] < -100))
+				{
+					return true;
+				}
+			}
+			return false;
+		};
+		RSGISEstimationForwardModelLUT *lut;
+		unsigned int numThreads;
+		std::vector<RSGISEstimationLUTInversion*> inversions;
+	};
+}}
+
+#endif
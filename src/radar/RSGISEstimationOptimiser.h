@@ -46,6 +46,7 @@ namespace rsgis {namespace radar{
 		threasholdAccepting,
 		exhaustiveSearch,
 		assignAP,
+		lookupTable,
         noOptimiser,
 		unknown
 	};
@@ -53,13 +54,18 @@ namespace rsgis {namespace radar{
 	class DllExport RSGISEstimationOptimiser
 	{
 	public:
-		RSGISEstimationOptimiser(){};
+		RSGISEstimationOptimiser(){this->numIterations = 0;};
 		virtual int minimise(gsl_vector *inData, gsl_vector *initialPar, gsl_vector *outParError) = 0;
 		virtual estOptimizerType getOptimiserType() = 0;
 		virtual void modifyAPriori(gsl_vector *newAPrioriPar) = 0;
 		virtual gsl_vector* getAPrioriPar(){throw RSGISException("Not available for this optimiser");};
 		virtual void printOptimiser() = 0;
+		/** The number of iterations of the iterative optimisers since created or reset, used to measure how quickly they converge. */
+		virtual unsigned long getNumIterations(){return this->numIterations;};
+		virtual void resetNumIterations(){this->numIterations = 0;};
 		virtual ~RSGISEstimationOptimiser(){};
+	protected:
+		unsigned long numIterations;
 	};
 }}
 
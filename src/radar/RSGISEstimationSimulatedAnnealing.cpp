@@ -192,6 +192,7 @@ namespace rsgis {namespace radar{
                 }
                 for(unsigned int m = 0; m < this->runsStep; m++)
                 {
+                    this->numIterations++;
                     bool withinLimits = true;
                     // Loop through parameters
                     for(unsigned int j = 0; j < this->nPar; j++)
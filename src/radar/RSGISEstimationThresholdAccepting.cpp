@@ -143,6 +143,7 @@ namespace rsgis {namespace radar{
 				
 				for(unsigned int m = 0; m < runsStep; m++)
 				{
+					this->numIterations++;
 					// Loop through parameters
 					for(unsigned int j = 0; j < nPar; j++)
 					{
@@ -409,6 +410,7 @@ namespace rsgis {namespace radar{
 				
 				for(unsigned int m = 0; m < runsStep; m++)
 				{
+					this->numIterations++;
 					// Loop through parameters
 					for(unsigned int j = 0; j < nPar; j++)
 					{
@@ -676,6 +678,7 @@ namespace rsgis {namespace radar{
 				
 				for(unsigned int m = 0; m < runsStep; m++)
 				{
+					this->numIterations++;
 					// Loop through parameters
 					for(unsigned int j = 0; j < nPar; j++)
 					{
@@ -954,6 +957,7 @@ namespace rsgis {namespace radar{
 				
 				for(unsigned int m = 0; m < runsStep; m++)
 				{
+					this->numIterations++;
 					// Loop through parameters
 					for(unsigned int j = 0; j < nPar; j++)
 					{
@@ -1243,6 +1247,7 @@ namespace rsgis {namespace radar{
 				
 				for(unsigned int m = 0; m < runsStep; m++)
 				{
+					this->numIterations++;
 					// Loop through parameters
 					for(unsigned int j = 0; j < nPar; j++)
 					{						
@@ -1534,6 +1539,7 @@ namespace rsgis {namespace radar{
 				
 				for(unsigned int m = 0; m < runsStep; m++)
 				{
+					this->numIterations++;
 					// Loop through parameters
 					for(unsigned int j = 0; j < nPar; j++)
 					{						
@@ -0,0 +1,209 @@
+/*
+ *  RSGISEstimationWarmStart.cpp
+ *  RSGIS_LIB
+ *
+ *  Created by agent on 19/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISEstimationWarmStart.h"
+
+namespace rsgis {namespace radar{
+
+	RSGISEstimationWarmStart::RSGISEstimationWarmStart(RSGISEstimationOptimiser *optimiser, unsigned int numPar, double cacheStep, size_t maxCacheSize, double restartError)
+	{
+		if(optimiser == NULL)
+		{
+			throw RSGISException("An optimiser must be provided.");
+		}
+		if(numPar == 0)
+		{
+			throw RSGISException("The number of parameters must be greater than zero.");
+		}
+		this->optimiser = optimiser;
+		this->numPar = numPar;
+		this->cacheStep = cacheStep;
+		this->maxCacheSize = maxCacheSize;
+		this->restartError = restartError;
+		this->seedPar = gsl_vector_alloc(numPar);
+		this->restartParError = gsl_vector_alloc(numPar + 1);
+		this->haveSeed = false;
+		this->numMinimisations = 0;
+		this->numSolved = 0;
+		this->numCacheHits = 0;
+		this->numRestarts = 0;
+	}
+
+	int RSGISEstimationWarmStart::minimise(gsl_vector *inData, gsl_vector *initialPar, gsl_vector *outParError)
+	{
+		++this->numMinimisations;
+
+		// Look for a solution to the same (quantised) data.
+		bool useCache = (this->cacheStep > 0);
+		if(useCache)
+		{
+			this->key.resize(inData->size);
+			for(size_t i = 0; i < inData->size; ++i)
+			{
+				double val = floor(gsl_vector_get(inData, i) / this->cacheStep);
+				if((val != val) || (fabs(val) > ((double)std::numeric_limits<long long>::max())))
+				{
+					useCache = false;
+					break;
+				}
+				this->key[i] = (long long)val;
+			}
+			// Solutions found with a different a priori are not reused.
+			this->key.insert(this->key.end(), this->aPrioriKey.begin(), this->aPrioriKey.end());
+		}
+		if(useCache)
+		{
+			std::map<std::vector<long long>, std::vector<double> >::iterator iterCache = this->cache.find(this->key);
+			if(iterCache != this->cache.end())
+			{
+				for(unsigned int j = 0; j < this->numPar + 1; ++j)
+				{
+					gsl_vector_set(outParError, j, iterCache->second[j]);
+				}
+				for(unsigned int j = 0; j < this->numPar; ++j)
+				{
+					gsl_vector_set(this->seedPar, j, iterCache->second[j]);
+				}
+				this->haveSeed = true;
+				++this->numCacheHits;
+				return 0;
+			}
+		}
+
+		int status = 0;
+		if(this->haveSeed)
+		{
+			status = this->optimiser->minimise(inData, this->seedPar, outParError);
+			if((!this->isSolution(outParError)) || (gsl_vector_get(outParError, this->numPar) > this->restartError))
+			{
+				// The warm start may have led to a local minimum so also try from the initial parameters.
+				++this->numRestarts;
+				int restartStatus = this->optimiser->minimise(inData, initialPar, this->restartParError);
+				if(this->isSolution(this->restartParError) && ((!this->isSolution(outParError)) || (gsl_vector_get(this->restartParError, this->numPar) < gsl_vector_get(outParError, this->numPar))))
+				{
+					for(unsigned int j = 0; j < this->numPar + 1; ++j)
+					{
+						gsl_vector_set(outParError, j, gsl_vector_get(this->restartParError, j));
+					}
+					status = restartStatus;
+				}
+			}
+		}
+		else
+		{
+			status = this->optimiser->minimise(inData, initialPar, outParError);
+		}
+		++this->numSolved;
+
+		if(this->isSolution(outParError))
+		{
+			for(unsigned int j = 0; j < this->numPar; ++j)
+			{
+				gsl_vector_set(this->seedPar, j, gsl_vector_get(outParError, j));
+			}
+			this->haveSeed = true;
+
+			if(useCache && (this->cache.size() < this->maxCacheSize))
+			{
+				std::vector<double> parError(this->numPar + 1, 0);
+				for(unsigned int j = 0; j < this->numPar + 1; ++j)
+				{
+					parError[j] = gsl_vector_get(outParError, j);
+				}
+				this->cache[this->key] = parError;
+			}
+		}
+		return status;
+	}
+
+	void RSGISEstimationWarmStart::setSeed(gsl_vector *seedPar)
+	{
+		for(unsigned int j = 0; j < this->numPar; ++j)
+		{
+			gsl_vector_set(this->seedPar, j, gsl_vector_get(seedPar, j));
+		}
+		this->haveSeed = true;
+	}
+
+	void RSGISEstimationWarmStart::modifyAPriori(gsl_vector *newAPrioriPar)
+	{
+		this->optimiser->modifyAPriori(newAPrioriPar);
+		// The exact values of the prior (rather than quantised) are added to the cache key.
+		this->aPrioriKey.resize(newAPrioriPar->size);
+		for(size_t i = 0; i < newAPrioriPar->size; ++i)
+		{
+			double val = gsl_vector_get(newAPrioriPar, i);
+			long long bits = 0;
+			memcpy(&bits, &val, sizeof(double));
+			this->aPrioriKey[i] = bits;
+		}
+	}
+
+	void RSGISEstimationWarmStart::printOptimiser()
+	{
+		std::cout << "Warm started (cache step = " << this->cacheStep << "): ";
+		this->optimiser->printOptimiser();
+	}
+
+	void RSGISEstimationWarmStart::resetStats()
+	{
+		this->numMinimisations = 0;
+		this->numSolved = 0;
+		this->numCacheHits = 0;
+		this->numRestarts = 0;
+		this->optimiser->resetNumIterations();
+	}
+
+	void RSGISEstimationWarmStart::printStats()
+	{
+		unsigned long numIterations = this->optimiser->getNumIterations();
+		std::cout << "Minimisations: " << this->numMinimisations << std::endl;
+		std::cout << "\tSolved: " << this->numSolved << " (" << this->numRestarts << " restarted from the initial parameters)" << std::endl;
+		std::cout << "\tFrom the cache: " << this->numCacheHits << " (" << this->cache.size() << " solutions cached)" << std::endl;
+		std::cout << "\tIterations: " << numIterations;
+		if(this->numMinimisations > 0)
+		{
+			std::cout << " (mean of " << ((double)numIterations) / this->numMinimisations << " per minimisation)";
+		}
+		std::cout << std::endl;
+	}
+
+	bool RSGISEstimationWarmStart::isSolution(gsl_vector *parError)
+	{
+		for(unsigned int j = 0; j < this->numPar + 1; ++j)
+		{
+			double val = gsl_vector_get(parError, j);
+			if((val != val) || (fabs(val) == std::numeric_limits<double>::infinity()))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	RSGISEstimationWarmStart::~RSGISEstimationWarmStart()
+	{
+		gsl_vector_free(this->seedPar);
+		gsl_vector_free(this->restartParError);
+	}
+
+}}
@@ -0,0 +1,115 @@
+/*
+ *  RSGISEstimationWarmStart.h
+ *  RSGIS_LIB
+ *
+ *  Created by agent on 19/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISEstimationWarmStart_H
+#define RSGISEstimationWarmStart_H
+
+#include <math.h>
+#include <limits>
+#include <iostream>
+#include <vector>
+#include <map>
+#include <string.h>
+#include <gsl/gsl_vector.h>
+
+#include "common/RSGISException.h"
+#include "radar/RSGISEstimationOptimiser.h"
+
+/** The default maximum number of solutions held by RSGISEstimationWarmStart. */
+#define RSGIS_WARM_START_MAX_CACHE 1000000
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_radar_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis {namespace radar{
+
+	/**
+	 * Wraps an optimiser so each minimisation starts from the last solution found (e.g.,
+	 * the neighbouring pixel, or the parent object where setSeed is called), rather than
+	 * initialPar, as neighbouring pixels and objects normally have similar parameters. If the
+	 * error of a warm started solution is greater than restartError the optimiser is run
+	 * again from initialPar and the better solution kept.
+	 *
+	 * Solutions are also cached using the data quantised to cacheStep (e.g., 0.01 dB), so
+	 * data the same within the quantisation are not solved again. A cacheStep of 0 turns the
+	 * cache off. The a priori parameters (set with modifyAPriori) are part of the cache key,
+	 * so a solution is only reused for the same prior.
+	 *
+	 * As this can be used anywhere an optimiser is (e.g., RSGISEstimationAlgorithmSingleSpecies
+	 * or RSGISObjectBasedEstimation), the numbers of solutions, cache hits and iterations are
+	 * kept so the speed up can be reported with printStats. An instance is not thread safe.
+	 */
+	class DllExport RSGISEstimationWarmStart : public RSGISEstimationOptimiser
+	{
+	public:
+		RSGISEstimationWarmStart(RSGISEstimationOptimiser *optimiser, unsigned int numPar, double cacheStep=0.01, size_t maxCacheSize=RSGIS_WARM_START_MAX_CACHE, double restartError=std::numeric_limits<double>::infinity());
+		int minimise(gsl_vector *inData, gsl_vector *initialPar, gsl_vector *outParError);
+		/** Sets the parameters the next minimisation will start from (e.g., the solution for the parent object). */
+		void setSeed(gsl_vector *seedPar);
+		/** The next minimisation will start from initialPar. */
+		void clearSeed(){this->haveSeed = false;};
+		virtual void modifyAPriori(gsl_vector *newAPrioriPar);
+		virtual gsl_vector* getAPrioriPar(){return this->optimiser->getAPrioriPar();};
+		virtual estOptimizerType getOptimiserType(){return this->optimiser->getOptimiserType();};
+		virtual void printOptimiser();
+		virtual unsigned long getNumIterations(){return this->optimiser->getNumIterations();};
+		virtual void resetNumIterations(){this->optimiser->resetNumIterations();};
+		unsigned long getNumMinimisations(){return this->numMinimisations;};
+		unsigned long getNumSolved(){return this->numSolved;};
+		unsigned long getNumCacheHits(){return this->numCacheHits;};
+		unsigned long getNumRestarts(){return this->numRestarts;};
+		/** Resets the counts of minimisations, solutions, cache hits, restarts and iterations. */
+		void resetStats();
+		/** Prints the counts and the mean number of iterations for each minimisation. */
+		void printStats();
+		~RSGISEstimationWarmStart();
+	private:
+		bool isSolution(gsl_vector *parError);
+		RSGISEstimationOptimiser *optimiser;
+		unsigned int numPar;
+		double cacheStep;
+		size_t maxCacheSize;
+		double restartError;
+		gsl_vector *seedPar;
+		gsl_vector *restartParError;
+		bool haveSeed;
+		std::map<std::vector<long long>, std::vector<double> > cache;
+		std::vector<long long> key;
+		std::vector<long long> aPrioriKey;
+		unsigned long numMinimisations;
+		unsigned long numSolved;
+		unsigned long numCacheHits;
+		unsigned long numRestarts;
+	};
+}}
+
+#endif
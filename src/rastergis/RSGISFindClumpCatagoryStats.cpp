@@ -55,7 +55,6 @@ namespace rsgis{namespace rastergis{
             
             // Get Attribute table
             GDALRasterAttributeTable *attTableClumps = clumpsDS->GetRasterBand(ratBandClumps)->GetDefaultRAT();
-            GDALRasterAttributeTable *attTableCats = catsDS->GetRasterBand(ratBandCats)->GetDefaultRAT();
             
             // Make sure it is long enough and extend if required.
             int numRows = attTableClumps->GetRowCount();
@@ -111,6 +110,14 @@ namespace rsgis{namespace rastergis{
             calcImageCatCounts.calcImage(datasets, 2, 0);
             delete calcCatsCounts;
             
+            // Read the class names once rather than looking up the column for each category.
+            std::vector<std::string> classNames;
+            if(copyClassName)
+            {
+                RSGISRATColumnIO catsRATIO(catsDS, ratBandCats);
+                catsRATIO.readColumn(classNameField, &classNames);
+            }
+            
             std::map<size_t,CategoryField> *cats = new std::map<size_t,CategoryField>();
             for(size_t i = 0; i < numCatVals; ++i)
             {
@@ -124,7 +131,11 @@ namespace rsgis{namespace rastergis{
                     
                     if(copyClassName)
                     {
-                        catField.className = attUtils.readStringColumnVal(attTableCats, classNameField, catField.category);
+                        if(catField.category >= classNames.size())
+                        {
+                            throw rsgis::RSGISAttributeTableException("Row is not within the RAT.");
+                        }
+                        catField.className = classNames[catField.category];
                     }
                     
                     cats->insert(std::pair<size_t,CategoryField>(catField.category, catField));
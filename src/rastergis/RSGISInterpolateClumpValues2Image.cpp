@@ -29,7 +29,7 @@ namespace rsgis{namespace rastergis{
         
     }
     
-    void RSGISInterpolateClumpValues2Image::interpolateImageFromClumps(GDALDataset *clumpsDataset, std::string selectField, std::string eastingsField, std::string northingsField, std::string valueField, std::string outputFile, std::string imageFormat, GDALDataType dataType, rsgis::math::RSGIS2DInterpolator *interpolator, unsigned int ratband)
+    void RSGISInterpolateClumpValues2Image::interpolateImageFromClumps(GDALDataset *clumpsDataset, std::string selectField, std::string eastingsField, std::string northingsField, std::string valueField, std::string outputFile, std::string imageFormat, GDALDataType dataType, rsgis::math::RSGIS2DInterpolator *interpolator, unsigned int ratband, unsigned int numThreads)
     {
         try
         {
@@ -111,7 +111,7 @@ namespace rsgis{namespace rastergis{
             GDALDataset *outputDS = imgUtils.createCopy(clumpsDataset, 1, outputFile, imageFormat, dataType);
             
             rsgis::img::RSGISPopulateImageFromInterpolator popImg;
-            popImg.populateImage(interpolator, outputDS);
+            popImg.populateImage(interpolator, outputDS, numThreads);
             
             GDALClose(outputDS);
             delete pts;
@@ -66,7 +66,7 @@ namespace rsgis{namespace rastergis{
     {
     public:
         RSGISInterpolateClumpValues2Image();
-        void interpolateImageFromClumps(GDALDataset *clumpsDataset, std::string selectField, std::string eastingsField, std::string northingsField, std::string valueField, std::string outputFile, std::string imageFormat, GDALDataType dataType, rsgis::math::RSGIS2DInterpolator *interpolator, unsigned int ratband=1);
+        void interpolateImageFromClumps(GDALDataset *clumpsDataset, std::string selectField, std::string eastingsField, std::string northingsField, std::string valueField, std::string outputFile, std::string imageFormat, GDALDataType dataType, rsgis::math::RSGIS2DInterpolator *interpolator, unsigned int ratband=1, unsigned int numThreads=1);
         ~RSGISInterpolateClumpValues2Image();
     };
     
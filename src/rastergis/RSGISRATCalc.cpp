@@ -32,6 +32,7 @@ namespace rsgis{namespace rastergis{
     
     void RSGISRATCalc::calcRATValues(GDALRasterAttributeTable *gdalRAT, std::vector<unsigned int> inRealColIdx, std::vector<unsigned int> inIntColIdx, std::vector<unsigned int> inStrColIdx, std::vector<unsigned int> outRealColIdx, std::vector<unsigned int> outIntColIdx, std::vector<unsigned int> outStrColIdx)
     {
+        rsgis::RSGISProgressReporter progress("RSGISRATCalc::calcRATValues", rsgis::rsgisRATRowsProcessed);
         try
         {
             unsigned int numInRealCols = inRealColIdx.size();
@@ -160,8 +161,11 @@ namespace rsgis{namespace rastergis{
             
             int feedback = nRows/10.0;
             int feedbackCounter = 0;
+            // If cancelled the loops are left so the buffers are freed before throwing.
+            bool cancelled = false;
             
             std::cout << "Started " << std::flush;
+            progress.start(nRows);
             size_t startRow = 0;
             size_t rowID = 0;
             for(int i = 0; i < nBlocks; i++)
@@ -169,17 +173,17 @@ namespace rsgis{namespace rastergis{
                 // Read blocks
                 for(unsigned int n = 0; n < numInRealCols; ++n)
                 {
-                    gdalRAT->ValuesIO(GF_Read, inRealColIdx[n], startRow, RAT_BLOCK_LENGTH, inRealData[n]);
+                    instrumentedRATValuesIO(gdalRAT, GF_Read, inRealColIdx[n], startRow, RAT_BLOCK_LENGTH, inRealData[n]);
                 }
                 
                 for(unsigned int n = 0; n < numInIntCols; ++n)
                 {
-                    gdalRAT->ValuesIO(GF_Read, inIntColIdx[n], startRow, RAT_BLOCK_LENGTH, inIntData[n]);
+                    instrumentedRATValuesIO(gdalRAT, GF_Read, inIntColIdx[n], startRow, RAT_BLOCK_LENGTH, inIntData[n]);
                 }
                 
                 for(unsigned int n = 0; n < numInStrCols; ++n)
                 {
-                    gdalRAT->ValuesIO(GF_Read, inStrColIdx[n], startRow, RAT_BLOCK_LENGTH, inStrData[n]);
+                    instrumentedRATValuesIO(gdalRAT, GF_Read, inStrColIdx[n], startRow, RAT_BLOCK_LENGTH, inStrData[n]);
                 }
                 
                 // Loop through block
@@ -189,6 +193,11 @@ namespace rsgis{namespace rastergis{
                     if((feedback != 0) && ((rowID % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        if(!progress.update(feedbackCounter))
+                        {
+                            cancelled = true;
+                            break;
+                        }
                         feedbackCounter = feedbackCounter + 10;
                     }
                     for(unsigned int n = 0; n < numInRealCols; ++n)
@@ -227,11 +236,15 @@ namespace rsgis{namespace rastergis{
                     
                     ++rowID;
                 }
+                if(cancelled)
+                {
+                    break;
+                }
                 
                 //Write blocks
                 for(unsigned int n = 0; n < numOutRealCols; ++n)
                 {
-                    gdalRAT->ValuesIO(GF_Write, outRealColIdx[n], startRow, RAT_BLOCK_LENGTH, outRealData[n]);
+                    instrumentedRATValuesIO(gdalRAT, GF_Write, outRealColIdx[n], startRow, RAT_BLOCK_LENGTH, outRealData[n]);
                     for(int j = 0; j < RAT_BLOCK_LENGTH; ++j)
                     {
                         outRealData[n][j] = 0.0;
@@ -240,7 +253,7 @@ namespace rsgis{namespace rastergis{
                 
                 for(unsigned int n = 0; n < numOutIntCols; ++n)
                 {
-                    gdalRAT->ValuesIO(GF_Write, outIntColIdx[n], startRow, RAT_BLOCK_LENGTH, outIntData[n]);
+                    instrumentedRATValuesIO(gdalRAT, GF_Write, outIntColIdx[n], startRow, RAT_BLOCK_LENGTH, outIntData[n]);
                     for(int j = 0; j < RAT_BLOCK_LENGTH; ++j)
                     {
                         outIntData[n][j] = 0.0;
@@ -249,7 +262,7 @@ namespace rsgis{namespace rastergis{
                 
                 for(unsigned int n = 0; n < numOutStrCols; ++n)
                 {
-                    gdalRAT->ValuesIO(GF_Write, outStrColIdx[n], startRow, RAT_BLOCK_LENGTH, outStrData[n]);
+                    instrumentedRATValuesIO(gdalRAT, GF_Write, outStrColIdx[n], startRow, RAT_BLOCK_LENGTH, outStrData[n]);
                     for(int j = 0; j < RAT_BLOCK_LENGTH; ++j)
                     {
                         outStrData[n][j] = "";
@@ -258,22 +271,22 @@ namespace rsgis{namespace rastergis{
                 
                 startRow += RAT_BLOCK_LENGTH;
             }
-            if(remainRows > 0)
+            if((remainRows > 0) && (!cancelled))
             {
                 // Read blocks
                 for(unsigned int n = 0; n < numInRealCols; ++n)
                 {
-                    gdalRAT->ValuesIO(GF_Read, inRealColIdx[n], startRow, remainRows, inRealData[n]);
+                    instrumentedRATValuesIO(gdalRAT, GF_Read, inRealColIdx[n], startRow, remainRows, inRealData[n]);
                 }
                 
                 for(unsigned int n = 0; n < numInIntCols; ++n)
                 {
-                    gdalRAT->ValuesIO(GF_Read, inIntColIdx[n], startRow, remainRows, inIntData[n]);
+                    instrumentedRATValuesIO(gdalRAT, GF_Read, inIntColIdx[n], startRow, remainRows, inIntData[n]);
                 }
                 
                 for(unsigned int n = 0; n < numInStrCols; ++n)
                 {
-                    gdalRAT->ValuesIO(GF_Read, inStrColIdx[n], startRow, remainRows, inStrData[n]);
+                    instrumentedRATValuesIO(gdalRAT, GF_Read, inStrColIdx[n], startRow, remainRows, inStrData[n]);
                 }
                 
                 // Loop through block
@@ -283,6 +296,11 @@ namespace rsgis{namespace rastergis{
                     if((feedback != 0) && ((rowID % feedback) == 0))
                     {
                         std::cout << "." << feedbackCounter << "." << std::flush;
+                        if(!progress.update(feedbackCounter))
+                        {
+                            cancelled = true;
+                            break;
+                        }
                         feedbackCounter = feedbackCounter + 10;
                     }
                     for(unsigned int n = 0; n < numInRealCols; ++n)
@@ -323,22 +341,29 @@ namespace rsgis{namespace rastergis{
                 }
                 
                 // Write blocks
-                for(unsigned int n = 0; n < numOutRealCols; ++n)
+                if(!cancelled)
                 {
-                    gdalRAT->ValuesIO(GF_Write, outRealColIdx[n], startRow, remainRows, outRealData[n]);
-                }
+                    for(unsigned int n = 0; n < numOutRealCols; ++n)
+                    {
+                        instrumentedRATValuesIO(gdalRAT, GF_Write, outRealColIdx[n], startRow, remainRows, outRealData[n]);
+                    }
                 
-                for(unsigned int n = 0; n < numOutIntCols; ++n)
-                {
-                    gdalRAT->ValuesIO(GF_Write, outIntColIdx[n], startRow, remainRows, outIntData[n]);
-                }
+                    for(unsigned int n = 0; n < numOutIntCols; ++n)
+                    {
+                        instrumentedRATValuesIO(gdalRAT, GF_Write, outIntColIdx[n], startRow, remainRows, outIntData[n]);
+                    }
                 
-                for(unsigned int n = 0; n < numOutStrCols; ++n)
-                {
-                    gdalRAT->ValuesIO(GF_Write, outStrColIdx[n], startRow, remainRows, outStrData[n]);
+                    for(unsigned int n = 0; n < numOutStrCols; ++n)
+                    {
+                        instrumentedRATValuesIO(gdalRAT, GF_Write, outStrColIdx[n], startRow, remainRows, outStrData[n]);
+                    }
                 }
             }
-            std::cout << ".Completed\n";
+            if(!cancelled)
+            {
+                std::cout << ".Completed\n";
+                progress.complete();
+            }
             
             // Clean out and release memory...
             if(numInRealCols > 0)
@@ -412,7 +437,12 @@ namespace rsgis{namespace rastergis{
             if(numOutStrCols > 0)
             {
                 delete[] sCalcOutVals;
-            }            
+            }
+            
+            if(cancelled)
+            {
+                throw RSGISAttributeTableException("The calculation was cancelled.");
+            }
         }
         catch (RSGISAttributeTableException &e)
         {
@@ -30,6 +30,7 @@
 #include "gdal_priv.h"
 
 #include "common/RSGISAttributeTableException.h"
+#include "common/RSGISInstrumentation.h"
 
 #include "rastergis/RSGISRasterAttUtils.h"
 #include "rastergis/RSGISRATCalcValue.h"
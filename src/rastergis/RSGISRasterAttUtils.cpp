@@ -555,164 +555,63 @@ namespace rsgis{namespace rastergis{
             }
 
             std::cout << "Find field column indexes and created columns were required.\n";
-            bool foundClassIdx = false;
-            int classIdx = 0;
-            bool inRedFound = false;
-            int inRedIdx = 0;
-            bool inGreenFound = false;
-            int inGreenIdx = 0;
-            bool inBlueFound = false;
-            int inBlueIdx = 0;
-            bool inAlphaFound = false;
-            int inAlphaIdx = 0;
-
-            bool outRedFound = false;
-            int outRedIdx = 0;
-            bool outGreenFound = false;
-            int outGreenIdx = 0;
-            bool outBlueFound = false;
-            int outBlueIdx = 0;
-            bool outAlphaFound = false;
-            int outAlphaIdx = 0;
-
-
-            if(gdalAttIn->GetRowCount() == 0)
+            // The classes table is only read from.
+            RSGISRATColumnIO classesIO(const_cast<GDALRasterAttributeTable*>(gdalAttClasses));
+            if(!classesIO.hasColumn("Red"))
             {
-                rsgis::RSGISAttributeTableException("There are no columns in the input attribute table.");
+                throw rsgis::RSGISAttributeTableException("A \'Red\' column was not within the input classes table.");
             }
-            else
+            if(!classesIO.hasColumn("Green"))
             {
-                for(int i = 0; i < gdalAttClasses->GetColumnCount(); ++i)
-                {
-                    if(!inRedFound && (std::string(gdalAttClasses->GetNameOfCol(i)) == "Red"))
-                    {
-                        inRedIdx = i;
-                        inRedFound = true;
-                    }
-                    else if(!inGreenFound && (std::string(gdalAttClasses->GetNameOfCol(i)) == "Green"))
-                    {
-                        inGreenIdx = i;
-                        inGreenFound = true;
-                    }
-                    else if(!inBlueFound && (std::string(gdalAttClasses->GetNameOfCol(i)) == "Blue"))
-                    {
-                        inBlueIdx = i;
-                        inBlueFound = true;
-                    }
-                    else if(!inAlphaFound && (std::string(gdalAttClasses->GetNameOfCol(i)) == "Alpha"))
-                    {
-                        inAlphaIdx = i;
-                        inAlphaFound = true;
-                    }
-                }
-
-                if(!inRedFound)
-                {
-                    throw rsgis::RSGISAttributeTableException("A \'Red\' column was not within the input classes table.");
-                }
-
-                if(!inGreenFound)
-                {
-                    throw rsgis::RSGISAttributeTableException("A \'Green\' column was not within the input classes table.");
-                }
-
-                if(!inBlueFound)
-                {
-                    throw rsgis::RSGISAttributeTableException("A \'Blue\' column was not within the input classes table.");
-                }
-
-                if(!inAlphaFound)
-                {
-                    throw rsgis::RSGISAttributeTableException("A \'Alpha\' column was not within the input classes table.");
-                }
-
-
-                for(int i = 0; i < gdalAttClumps->GetColumnCount(); ++i)
-                {
-                    if(!foundClassIdx && (std::string(gdalAttClumps->GetNameOfCol(i)) == classField))
-                    {
-                        classIdx = i;
-                        foundClassIdx = true;
-                    }
-                    else if(!outRedFound && (std::string(gdalAttClumps->GetNameOfCol(i)) == "Red"))
-                    {
-                        outRedIdx = i;
-                        outRedFound = true;
-                    }
-                    else if(!outGreenFound && (std::string(gdalAttClumps->GetNameOfCol(i)) == "Green"))
-                    {
-                        outGreenIdx = i;
-                        outGreenFound = true;
-                    }
-                    else if(!outBlueFound && (std::string(gdalAttClumps->GetNameOfCol(i)) == "Blue"))
-                    {
-                        outBlueIdx = i;
-                        outBlueFound = true;
-                    }
-                    else if(!outAlphaFound && (std::string(gdalAttClumps->GetNameOfCol(i)) == "Alpha"))
-                    {
-                        outAlphaIdx = i;
-                        outAlphaFound = true;
-                    }
-                }
-
-                if(!foundClassIdx)
-                {
-                    throw rsgis::RSGISAttributeTableException("The class field column was not within the category table.");
-                }
-
-                if(!outRedFound)
-                {
-                    gdalAttClumps->CreateColumn("Red", GFT_Integer, GFU_Red);
-                    outRedFound = true;
-                    outRedIdx = gdalAttClumps->GetColumnCount()-1;
-                }
-
-                if(!outGreenFound)
-                {
-                    gdalAttClumps->CreateColumn("Green", GFT_Integer, GFU_Green);
-                    outGreenFound = true;
-                    outGreenIdx = gdalAttClumps->GetColumnCount()-1;
-                }
-
-                if(!outBlueFound)
-                {
-                    gdalAttClumps->CreateColumn("Blue", GFT_Integer, GFU_Blue);
-                    outBlueFound = true;
-                    outBlueIdx = gdalAttClumps->GetColumnCount()-1;
-                }
-
-                if(!outAlphaFound)
-                {
-                    gdalAttClumps->CreateColumn("Alpha", GFT_Integer, GFU_Alpha);
-                    outAlphaFound = true;
-                    outAlphaIdx = gdalAttClumps->GetColumnCount()-1;
-                }
-
-
+                throw rsgis::RSGISAttributeTableException("A \'Green\' column was not within the input classes table.");
+            }
+            if(!classesIO.hasColumn("Blue"))
+            {
+                throw rsgis::RSGISAttributeTableException("A \'Blue\' column was not within the input classes table.");
+            }
+            if(!classesIO.hasColumn("Alpha"))
+            {
+                throw rsgis::RSGISAttributeTableException("A \'Alpha\' column was not within the input classes table.");
+            }
+            std::vector<int> inRedVals;
+            std::vector<int> inGreenVals;
+            std::vector<int> inBlueVals;
+            std::vector<int> inAlphaVals;
+            classesIO.readColumn("Red", &inRedVals);
+            classesIO.readColumn("Green", &inGreenVals);
+            classesIO.readColumn("Blue", &inBlueVals);
+            classesIO.readColumn("Alpha", &inAlphaVals);
+            size_t numClasses = inRedVals.size();
 
+            RSGISRATColumnIO clumpsIO(gdalAttClumps);
+            if(!clumpsIO.hasColumn(classField))
+            {
+                throw rsgis::RSGISAttributeTableException("The class field column was not within the category table.");
             }
+            RSGISRATChunkIterator clumpsIter(&clumpsIO);
+            unsigned int classCol = clumpsIter.addColumn(classField, GFT_Integer, true, false);
+            unsigned int redCol = clumpsIter.addColumn("Red", GFT_Integer, true, true, GFU_Red);
+            unsigned int greenCol = clumpsIter.addColumn("Green", GFT_Integer, true, true, GFU_Green);
+            unsigned int blueCol = clumpsIter.addColumn("Blue", GFT_Integer, true, true, GFU_Blue);
+            unsigned int alphaCol = clumpsIter.addColumn("Alpha", GFT_Integer, true, true, GFU_Alpha);
 
-            int classID = 0;
-            int redVal = 0;
-            int greenVal = 0;
-            int blueVal = 0;
-            int alphaVal = 0;
             std::cout << "Copying the colours across\n";
-            for(int i = 0; i < gdalAttClumps->GetRowCount(); ++i)
+            while(clumpsIter.next())
             {
-                classID = gdalAttClumps->GetValueAsInt(i, classIdx);
-                if(classID >= 0)
+                RSGISRATSpan<int> classIDs = clumpsIter.getIntColumn(classCol);
+                RSGISRATSpan<int> redVals = clumpsIter.getIntColumn(redCol);
+                RSGISRATSpan<int> greenVals = clumpsIter.getIntColumn(greenCol);
+                RSGISRATSpan<int> blueVals = clumpsIter.getIntColumn(blueCol);
+                RSGISRATSpan<int> alphaVals = clumpsIter.getIntColumn(alphaCol);
+                for(size_t i = 0; i < classIDs.size(); ++i)
                 {
-                    redVal = gdalAttClasses->GetValueAsInt(classID, inRedIdx);
-                    greenVal = gdalAttClasses->GetValueAsInt(classID, inGreenIdx);
-                    blueVal = gdalAttClasses->GetValueAsInt(classID, inBlueIdx);
-                    alphaVal = gdalAttClasses->GetValueAsInt(classID, inAlphaIdx);
-
-                    gdalAttClumps->SetValue(i, outRedIdx, redVal);
-                    gdalAttClumps->SetValue(i, outGreenIdx, greenVal);
-                    gdalAttClumps->SetValue(i, outBlueIdx, blueVal);
-                    gdalAttClumps->SetValue(i, outAlphaIdx, alphaVal);
+                    if((classIDs[i] >= 0) && (((size_t)classIDs[i]) < numClasses))
+                    {
+                        redVals[i] = inRedVals[classIDs[i]];
+                        greenVals[i] = inGreenVals[classIDs[i]];
+                        blueVals[i] = inBlueVals[classIDs[i]];
+                        alphaVals[i] = inAlphaVals[classIDs[i]];
+                    }
                 }
             }
 
@@ -1006,76 +905,34 @@ namespace rsgis{namespace rastergis{
 
 
             std::cout << "Find field column indexes in RAT.\n";
-            bool foundInClassIdx = false;
-            int colInClassIdx = 0;
-            bool foundOutClassIdx = false;
-            int colOutClassIdx = 0;
-
-            if(gdalAttIn->GetRowCount() == 0)
+            RSGISRATColumnIO ratIO(gdalAttIn);
+            if(!ratIO.hasColumn(classInField))
             {
-                rsgis::RSGISAttributeTableException("There are no columns in the input attribute table.");
+                std::string message = std::string("Column ") + classInField + std::string(" is not within the input attribute table.");
+                throw rsgis::RSGISAttributeTableException(message);
             }
-            else
+            RSGISRATChunkIterator ratIter(&ratIO, true);
+            unsigned int inClassCol = ratIter.addColumn(classInField, GFT_Integer, true, false);
+            unsigned int outClassCol = ratIter.addColumn(classOutField, GFT_Integer, false, true);
+
+            std::cout << "Translating class IDs.\n";
+            while(ratIter.next())
             {
-                for(int i = 0; i < gdalAttIn->GetColumnCount(); ++i)
+                RSGISRATSpan<int> inClassIDs = ratIter.getIntColumn(inClassCol);
+                RSGISRATSpan<int> outClassIDs = ratIter.getIntColumn(outClassCol);
+                for(size_t i = 0; i < inClassIDs.size(); ++i)
                 {
-                    if(!foundInClassIdx && (std::string(gdalAttIn->GetNameOfCol(i)) == classInField))
+                    std::map<size_t, size_t>::iterator iterClass = classPairs.find((size_t)inClassIDs[i]);
+                    if(iterClass == classPairs.end())
                     {
-                        colInClassIdx = i;
-                        foundInClassIdx = true;
+                        outClassIDs[i] = -1;
                     }
-                    else if(!foundOutClassIdx && (std::string(gdalAttIn->GetNameOfCol(i)) == classOutField))
+                    else
                     {
-                        colOutClassIdx = i;
-                        foundOutClassIdx = true;
+                        outClassIDs[i] = (int)(*iterClass).second;
                     }
                 }
-
-                if(!foundInClassIdx)
-                {
-                    std::string message = std::string("Column ") + classInField + std::string(" is not within the input attribute table.");
-                    throw rsgis::RSGISAttributeTableException(message);
-                }
-
-                if(!foundOutClassIdx)
-                {
-                    gdalAttIn->CreateColumn(classOutField.c_str(), GFT_Integer, GFU_Generic);
-                    foundOutClassIdx = true;
-                    colOutClassIdx = gdalAttIn->GetColumnCount()-1;
-                }
-            }
-
-            std::cout << "Translating class IDs.\n";
-            size_t numRows = gdalAttIn->GetRowCount();
-            size_t inClassID = 0;
-            int outClassID = 0;
-            unsigned int feedbackStep = numRows/10;
-            unsigned int feedback = 0;
-            std::cout << "Started." << std::flush;
-            for(int i = 0; i < numRows; ++i)
-            {
-                if((numRows > 20) && (i % feedbackStep == 0))
-                {
-                    std::cout << "." << feedback << "." << std::flush;
-                    feedback += 10;
-                }
-
-                inClassID = gdalAttIn->GetValueAsInt(i, colInClassIdx);
-
-                std::map<size_t, size_t>::iterator iterClass = classPairs.find(inClassID);
-                if(iterClass == classPairs.end())
-                {
-                    outClassID = -1;
-                }
-                else
-                {
-                    outClassID = (int)(*iterClass).second;
-                }
-
-                gdalAttIn->SetValue(i, colOutClassIdx, outClassID);
-
             }
-            std::cout << ".Completed\n";
 
             std::cout << "Adding RAT to output file.\n";
             inImage->GetRasterBand(1)->SetDefaultRAT(gdalAttIn);
@@ -1533,73 +1390,14 @@ namespace rsgis{namespace rastergis{
         double *outData = NULL;
         try
         {
-            int columnIndex = this->findColumnIndex(attTable, colName);
-
-            // Iterate through blocks
-            size_t nRows = attTable->GetRowCount();
+            RSGISRATColumnIO ratIO(attTable);
+            unsigned int columnIndex = ratIO.getColumnIndex(colName);
+            size_t nRows = ratIO.getNumRows();
             *colLen = nRows;
-            unsigned int nBlocks = floor(((double) nRows) / ((double) RAT_BLOCK_LENGTH));
-            unsigned int remainRows = nRows - (nBlocks * RAT_BLOCK_LENGTH );
 
+            // Read straight into the output array, a chunk at a time.
             outData = new double[nRows];
-
-            double *blockData = new double[RAT_BLOCK_LENGTH];
-
-            int feedback = nRows/10.0;
-            int feedbackCounter = 0;
-
-            // Don't show progress if less rows than block length
-            if(nRows < RAT_BLOCK_LENGTH)
-            {
-                feedback = 0;
-            }
-
-            if(feedback != 0){std::cout << "Started " << std::flush;}
-
-            int rowOffset = 0;
-            for(int i = 0; i < nBlocks; i++)
-            {
-                rowOffset =  RAT_BLOCK_LENGTH * i;
-
-                // Read block
-                attTable->ValuesIO(GF_Read, columnIndex, rowOffset, RAT_BLOCK_LENGTH, blockData);
-
-                // Loop through block
-
-                for(int m = 0; m < RAT_BLOCK_LENGTH; ++m)
-                {
-                    // Show progress
-                    if((feedback != 0) && (((i*RAT_BLOCK_LENGTH)+m) % feedback) == 0)
-                    {
-                        std::cout << "." << feedbackCounter << "." << std::flush;
-                        feedbackCounter = feedbackCounter + 10;
-                    }
-                    outData[(i*RAT_BLOCK_LENGTH)+m] = blockData[m];
-                }
-
-            }
-            if(remainRows > 0)
-            {
-                rowOffset =  RAT_BLOCK_LENGTH * nBlocks;
-
-                // Read block
-                attTable->ValuesIO(GF_Read, columnIndex, rowOffset, remainRows, blockData);
-
-                // Loop through block
-
-                for(int m = 0; m < remainRows; ++m)
-                {
-                    // Show progress
-                    if((feedback != 0) && (((nBlocks*RAT_BLOCK_LENGTH)+m) % feedback) == 0)
-                    {
-                        std::cout << "." << feedbackCounter << "." << std::flush;
-                        feedbackCounter = feedbackCounter + 10;
-                    }
-                    outData[(nBlocks*RAT_BLOCK_LENGTH)+m] = blockData[m];
-                }
-            }
-            if(feedback != 0){std::cout << ".Completed\n";}
-            delete[] blockData;
+            ratIO.readRows(columnIndex, 0, nRows, outData);
         }
         catch (RSGISAttributeTableException &e)
         {
@@ -1622,73 +1420,14 @@ namespace rsgis{namespace rastergis{
         int *outData = NULL;
         try
         {
-            int columnIndex = this->findColumnIndex(attTable, colName);
-
-            // Iterate through blocks
-            size_t nRows = attTable->GetRowCount();
+            RSGISRATColumnIO ratIO(attTable);
+            unsigned int columnIndex = ratIO.getColumnIndex(colName);
+            size_t nRows = ratIO.getNumRows();
             *colLen = nRows;
-            unsigned int nBlocks = floor(((double) nRows) / ((double) RAT_BLOCK_LENGTH));
-            unsigned int remainRows = nRows - (nBlocks * RAT_BLOCK_LENGTH );
 
+            // Read straight into the output array, a chunk at a time.
             outData = new int[nRows];
-
-            int *blockData = new int[RAT_BLOCK_LENGTH];
-
-            int feedback = nRows/10.0;
-            int feedbackCounter = 0;
-
-            // Don't show progress if less rows than block length
-            if(nRows < RAT_BLOCK_LENGTH)
-            {
-                feedback = 0;
-            }
-
-            if(feedback != 0){std::cout << "Started " << std::flush;}
-
-            int rowOffset = 0;
-            for(int i = 0; i < nBlocks; i++)
-            {
-                rowOffset =  RAT_BLOCK_LENGTH * i;
-
-                // Read block
-                attTable->ValuesIO(GF_Read, columnIndex, rowOffset, RAT_BLOCK_LENGTH, blockData);
-
-                // Loop through block
-
-                for(int m = 0; m < RAT_BLOCK_LENGTH; ++m)
-                {
-                    // Show progress
-                    if((feedback != 0) && (((i*RAT_BLOCK_LENGTH)+m) % feedback) == 0)
-                    {
-                        std::cout << "." << feedbackCounter << "." << std::flush;
-                        feedbackCounter = feedbackCounter + 10;
-                    }
-                    outData[(i*RAT_BLOCK_LENGTH)+m] = blockData[m];
-                }
-
-            }
-            if(remainRows > 0)
-            {
-                rowOffset =  RAT_BLOCK_LENGTH * nBlocks;
-
-                // Read block
-                attTable->ValuesIO(GF_Read, columnIndex, rowOffset, remainRows, blockData);
-
-                // Loop through block
-
-                for(int m = 0; m < remainRows; ++m)
-                {
-                    // Show progress
-                    if((feedback != 0) && (((nBlocks*RAT_BLOCK_LENGTH)+m) % feedback) == 0)
-                    {
-                        std::cout << "." << feedbackCounter << "." << std::flush;
-                        feedbackCounter = feedbackCounter + 10;
-                    }
-                    outData[(nBlocks*RAT_BLOCK_LENGTH)+m] = blockData[m];
-                }
-            }
-            if(feedback != 0){std::cout << ".Completed\n";}
-            delete[] blockData;
+            ratIO.readRows(columnIndex, 0, nRows, outData);
         }
         catch (RSGISAttributeTableException &e)
         {
@@ -1799,73 +1538,14 @@ namespace rsgis{namespace rastergis{
         std::string *outData = NULL;
         try
         {
-            int columnIndex = this->findColumnIndex(attTable, colName);
-            
-            // Iterate through blocks
-            size_t nRows = attTable->GetRowCount();
+            RSGISRATColumnIO ratIO(attTable);
+            unsigned int columnIndex = ratIO.getColumnIndex(colName);
+            size_t nRows = ratIO.getNumRows();
             *colLen = nRows;
-            unsigned int nBlocks = floor(((double) nRows) / ((double) RAT_BLOCK_LENGTH));
-            unsigned int remainRows = nRows - (nBlocks * RAT_BLOCK_LENGTH );
-            
+
+            // Read straight into the output array, a chunk at a time.
             outData = new std::string[nRows];
-            
-            char **blockData = new char*[RAT_BLOCK_LENGTH];
-            
-            int feedback = nRows/10.0;
-            int feedbackCounter = 0;
-            
-            // Don't show progress if less rows than block length
-            if(nRows < RAT_BLOCK_LENGTH)
-            {
-                feedback = 0;
-            }
-            
-            if(feedback != 0){std::cout << "Started " << std::flush;}
-            
-            int rowOffset = 0;
-            for(int i = 0; i < nBlocks; i++)
-            {
-                rowOffset =  RAT_BLOCK_LENGTH * i;
-                
-                // Read block
-                attTable->ValuesIO(GF_Read, columnIndex, rowOffset, RAT_BLOCK_LENGTH, blockData);
-                
-                // Loop through block
-                
-                for(int m = 0; m < RAT_BLOCK_LENGTH; ++m)
-                {
-                    // Show progress
-                    if((feedback != 0) && (((i*RAT_BLOCK_LENGTH)+m) % feedback) == 0)
-                    {
-                        std::cout << "." << feedbackCounter << "." << std::flush;
-                        feedbackCounter = feedbackCounter + 10;
-                    }
-                    outData[(i*RAT_BLOCK_LENGTH)+m] = std::string(blockData[m]);
-                }
-                
-            }
-            if(remainRows > 0)
-            {
-                rowOffset =  RAT_BLOCK_LENGTH * nBlocks;
-                
-                // Read block
-                attTable->ValuesIO(GF_Read, columnIndex, rowOffset, remainRows, blockData);
-                
-                // Loop through block
-                
-                for(int m = 0; m < remainRows; ++m)
-                {
-                    // Show progress
-                    if((feedback != 0) && (((nBlocks*RAT_BLOCK_LENGTH)+m) % feedback) == 0)
-                    {
-                        std::cout << "." << feedbackCounter << "." << std::flush;
-                        feedbackCounter = feedbackCounter + 10;
-                    }
-                    outData[(nBlocks*RAT_BLOCK_LENGTH)+m] = std::string(blockData[m]);
-                }
-            }
-            if(feedback != 0){std::cout << ".Completed\n";}
-            delete[] blockData;
+            ratIO.readRows(columnIndex, 0, nRows, outData);
         }
         catch (RSGISAttributeTableException &e)
         {
@@ -1891,72 +1571,8 @@ namespace rsgis{namespace rastergis{
         std::vector<double> *outData = new std::vector<double>();
         try
         {
-            int columnIndex = this->findColumnIndex(attTable, colName);
-            
-            // Iterate through blocks
-            size_t nRows = attTable->GetRowCount();
-            unsigned int nBlocks = floor(((double) nRows) / ((double) RAT_BLOCK_LENGTH));
-            unsigned int remainRows = nRows - (nBlocks * RAT_BLOCK_LENGTH );
-            
-            outData->reserve(nRows);
-            
-            double *blockData = new double[RAT_BLOCK_LENGTH];
-            
-            int feedback = nRows/10.0;
-            int feedbackCounter = 0;
-            
-            // Don't show progress if less rows than block length
-            if(nRows < RAT_BLOCK_LENGTH)
-            {
-                feedback = 0;
-            }
-            
-            if(feedback != 0){std::cout << "Started " << std::flush;}
-            
-            int rowOffset = 0;
-            for(int i = 0; i < nBlocks; i++)
-            {
-                rowOffset =  RAT_BLOCK_LENGTH * i;
-                
-                // Read block
-                attTable->ValuesIO(GF_Read, columnIndex, rowOffset, RAT_BLOCK_LENGTH, blockData);
-                
-                // Loop through block
-                
-                for(int m = 0; m < RAT_BLOCK_LENGTH; ++m)
-                {
-                    // Show progress
-                    if((feedback != 0) && (((i*RAT_BLOCK_LENGTH)+m) % feedback) == 0)
-                    {
-                        std::cout << "." << feedbackCounter << "." << std::flush;
-                        feedbackCounter = feedbackCounter + 10;
-                    }
-                    outData->push_back(blockData[m]);
-                }
-                
-            }
-            if(remainRows > 0)
-            {
-                rowOffset =  RAT_BLOCK_LENGTH * nBlocks;
-                
-                // Read block
-                attTable->ValuesIO(GF_Read, columnIndex, rowOffset, remainRows, blockData);
-                
-                // Loop through block
-                
-                for(int m = 0; m < remainRows; ++m)
-                {
-                    // Show progress
-                    if((feedback != 0) && (((nBlocks*RAT_BLOCK_LENGTH)+m) % feedback) == 0)
-                    {
-                        std::cout << "." << feedbackCounter << "." << std::flush;
-                        feedbackCounter = feedbackCounter + 10;
-                    }
-                    outData->push_back(blockData[m]);
-                }
-            }
-            if(feedback != 0){std::cout << ".Completed\n";}
-            delete[] blockData;
+            RSGISRATColumnIO ratIO(attTable);
+            ratIO.readColumn(colName, outData);
         }
         catch (RSGISAttributeTableException &e)
         {
@@ -1979,72 +1595,8 @@ namespace rsgis{namespace rastergis{
         std::vector<int> *outData = new std::vector<int>();
         try
         {
-            int columnIndex = this->findColumnIndex(attTable, colName);
-            
-            // Iterate through blocks
-            size_t nRows = attTable->GetRowCount();
-            unsigned int nBlocks = floor(((double) nRows) / ((double) RAT_BLOCK_LENGTH));
-            unsigned int remainRows = nRows - (nBlocks * RAT_BLOCK_LENGTH );
-            
-            outData->reserve(nRows);
-            
-            int *blockData = new int[RAT_BLOCK_LENGTH];
-            
-            int feedback = nRows/10.0;
-            int feedbackCounter = 0;
-            
-            // Don't show progress if less rows than block length
-            if(nRows < RAT_BLOCK_LENGTH)
-            {
-                feedback = 0;
-            }
-            
-            if(feedback != 0){std::cout << "Started " << std::flush;}
-            
-            int rowOffset = 0;
-            for(int i = 0; i < nBlocks; i++)
-            {
-                rowOffset =  RAT_BLOCK_LENGTH * i;
-                
-                // Read block
-                attTable->ValuesIO(GF_Read, columnIndex, rowOffset, RAT_BLOCK_LENGTH, blockData);
-                
-                // Loop through block
-                
-                for(int m = 0; m < RAT_BLOCK_LENGTH; ++m)
-                {
-                    // Show progress
-                    if((feedback != 0) && (((i*RAT_BLOCK_LENGTH)+m) % feedback) == 0)
-                    {
-                        std::cout << "." << feedbackCounter << "." << std::flush;
-                        feedbackCounter = feedbackCounter + 10;
-                    }
-                    outData->push_back(blockData[m]);
-                }
-                
-            }
-            if(remainRows > 0)
-            {
-                rowOffset =  RAT_BLOCK_LENGTH * nBlocks;
-                
-                // Read block
-                attTable->ValuesIO(GF_Read, columnIndex, rowOffset, remainRows, blockData);
-                
-                // Loop through block
-                
-                for(int m = 0; m < remainRows; ++m)
-                {
-                    // Show progress
-                    if((feedback != 0) && (((nBlocks*RAT_BLOCK_LENGTH)+m) % feedback) == 0)
-                    {
-                        std::cout << "." << feedbackCounter << "." << std::flush;
-                        feedbackCounter = feedbackCounter + 10;
-                    }
-                    outData->push_back(blockData[m]);
-                }
-            }
-            if(feedback != 0){std::cout << ".Completed\n";}
-            delete[] blockData;
+            RSGISRATColumnIO ratIO(attTable);
+            ratIO.readColumn(colName, outData);
         }
         catch (RSGISAttributeTableException &e)
         {
@@ -2067,72 +1619,8 @@ namespace rsgis{namespace rastergis{
         std::vector<std::string> *outData = new std::vector<std::string>();
         try
         {
-            int columnIndex = this->findColumnIndex(attTable, colName);
-            
-            // Iterate through blocks
-            size_t nRows = attTable->GetRowCount();
-            unsigned int nBlocks = floor(((double) nRows) / ((double) RAT_BLOCK_LENGTH));
-            unsigned int remainRows = nRows - (nBlocks * RAT_BLOCK_LENGTH );
-            
-            outData->reserve(nRows);
-            
-            char **blockData = new char*[RAT_BLOCK_LENGTH];
-            
-            int feedback = nRows/10.0;
-            int feedbackCounter = 0;
-            
-            // Don't show progress if less rows than block length
-            if(nRows < RAT_BLOCK_LENGTH)
-            {
-                feedback = 0;
-            }
-            
-            if(feedback != 0){std::cout << "Started " << std::flush;}
-            
-            int rowOffset = 0;
-            for(int i = 0; i < nBlocks; i++)
-            {
-                rowOffset =  RAT_BLOCK_LENGTH * i;
-                
-                // Read block
-                attTable->ValuesIO(GF_Read, columnIndex, rowOffset, RAT_BLOCK_LENGTH, blockData);
-                
-                // Loop through block
-                
-                for(int m = 0; m < RAT_BLOCK_LENGTH; ++m)
-                {
-                    // Show progress
-                    if((feedback != 0) && (((i*RAT_BLOCK_LENGTH)+m) % feedback) == 0)
-                    {
-                        std::cout << "." << feedbackCounter << "." << std::flush;
-                        feedbackCounter = feedbackCounter + 10;
-                    }
-                    outData->push_back(std::string(blockData[m]));
-                }
-                
-            }
-            if(remainRows > 0)
-            {
-                rowOffset =  RAT_BLOCK_LENGTH * nBlocks;
-                
-                // Read block
-                attTable->ValuesIO(GF_Read, columnIndex, rowOffset, remainRows, blockData);
-                
-                // Loop through block
-                
-                for(int m = 0; m < remainRows; ++m)
-                {
-                    // Show progress
-                    if((feedback != 0) && (((nBlocks*RAT_BLOCK_LENGTH)+m) % feedback) == 0)
-                    {
-                        std::cout << "." << feedbackCounter << "." << std::flush;
-                        feedbackCounter = feedbackCounter + 10;
-                    }
-                    outData->push_back(std::string(blockData[m]));
-                }
-            }
-            if(feedback != 0){std::cout << ".Completed\n";}
-            delete[] blockData;
+            RSGISRATColumnIO ratIO(attTable);
+            ratIO.readColumn(colName, outData);
         }
         catch (RSGISAttributeTableException &e)
         {
@@ -2220,101 +1708,33 @@ namespace rsgis{namespace rastergis{
     {
         try
         {
-            // Iterate through blocks
-            size_t nRows = attTable->GetRowCount();
+            RSGISRATColumnIO ratIO(attTable);
+            ratIO.writeColumn(colName, strDataVal, colLen);
+        }
+        catch (RSGISAttributeTableException &e)
+        {
+            throw e;
+        }
+        catch (rsgis::RSGISException &e)
+        {
+            throw RSGISAttributeTableException(e.what());
+        }
+        catch (std::exception &e)
+        {
+            throw RSGISAttributeTableException(e.what());
+        }
+    }
+    
+    std::vector<RSGISRATCol>* RSGISRasterAttUtils::getRatColumnsList(GDALRasterAttributeTable *gdalATT)
+    {
+        std::vector<RSGISRATCol> *ratCols = new std::vector<RSGISRATCol>();
+        try
+        {
+            unsigned int numCols = gdalATT->GetColumnCount();
+            ratCols->reserve(numCols);
             
-            if(nRows != colLen)
-            {
-                throw RSGISAttributeTableException("The column length provided and the length of the RAT are not equal...");
-            }
-            
-            unsigned int columnIndex = this->findColumnIndexOrCreate(attTable, colName, GFT_String);
-            
-            unsigned int nBlocks = floor(((double) nRows) / ((double) RAT_BLOCK_LENGTH));
-            unsigned int remainRows = nRows - (nBlocks * RAT_BLOCK_LENGTH );
-            
-            char **blockData = new char*[RAT_BLOCK_LENGTH];
-            
-            int feedback = nRows/10.0;
-            int feedbackCounter = 0;
-            
-            // Don't show progress if less rows than block length
-            if(nRows < RAT_BLOCK_LENGTH)
-            {
-                feedback = 0;
-            }
-            
-            if(feedback != 0){std::cout << "Started " << std::flush;}
-            
-            int rowOffset = 0;
-            for(int i = 0; i < nBlocks; i++)
-            {
-                rowOffset =  RAT_BLOCK_LENGTH * i;
-                
-                // Loop through block
-                
-                for(int m = 0; m < RAT_BLOCK_LENGTH; ++m)
-                {
-                    // Show progress
-                    if((feedback != 0) && (((i*RAT_BLOCK_LENGTH)+m) % feedback) == 0)
-                    {
-                        std::cout << "." << feedbackCounter << "." << std::flush;
-                        feedbackCounter = feedbackCounter + 10;
-                    }
-                    blockData[m] = const_cast<char*>(strDataVal[(i*RAT_BLOCK_LENGTH)+m].c_str());
-                }
-                
-                // Write block
-                attTable->ValuesIO(GF_Write, columnIndex, rowOffset, RAT_BLOCK_LENGTH, blockData);
-                
-            }
-            if(remainRows > 0)
-            {
-                rowOffset =  RAT_BLOCK_LENGTH * nBlocks;
-                
-                // Loop through block
-                for(int m = 0; m < remainRows; ++m)
-                {
-                    // Show progress
-                    if((feedback != 0) && (((nBlocks*RAT_BLOCK_LENGTH)+m) % feedback) == 0)
-                    {
-                        std::cout << "." << feedbackCounter << "." << std::flush;
-                        feedbackCounter = feedbackCounter + 10;
-                    }
-                    blockData[m] = const_cast<char*>(strDataVal[(nBlocks*RAT_BLOCK_LENGTH)+m].c_str());
-                }
-                
-                // Read block
-                attTable->ValuesIO(GF_Write, columnIndex, rowOffset, remainRows, blockData);
-            }
-            if(feedback != 0){std::cout << ".Completed\n";}
-            delete[] blockData;
-            
-        }
-        catch (RSGISAttributeTableException &e)
-        {
-            throw e;
-        }
-        catch (rsgis::RSGISException &e)
-        {
-            throw RSGISAttributeTableException(e.what());
-        }
-        catch (std::exception &e)
-        {
-            throw RSGISAttributeTableException(e.what());
-        }
-    }
-    
-    std::vector<RSGISRATCol>* RSGISRasterAttUtils::getRatColumnsList(GDALRasterAttributeTable *gdalATT)
-    {
-        std::vector<RSGISRATCol> *ratCols = new std::vector<RSGISRATCol>();
-        try
-        {
-            unsigned int numCols = gdalATT->GetColumnCount();
-            ratCols->reserve(numCols);
-            
-            RSGISRATCol colDetails = RSGISRATCol();
-            for(unsigned int i = 0; i < numCols; ++i)
+            RSGISRATCol colDetails = RSGISRATCol();
+            for(unsigned int i = 0; i < numCols; ++i)
             {
                 colDetails = RSGISRATCol();
                 
@@ -2399,76 +1819,8 @@ namespace rsgis{namespace rastergis{
     {
         try
         {
-            // Iterate through blocks
-            size_t nRows = attTable->GetRowCount();
-            
-            if(nRows != colLen)
-            {
-                throw RSGISAttributeTableException("The column length provided and the length of the RAT are not equal...");
-            }
-            
-            unsigned int columnIndex = this->findColumnIndexOrCreate(attTable, colName, GFT_Integer);
-            
-            unsigned int nBlocks = floor(((double) nRows) / ((double) RAT_BLOCK_LENGTH));
-            unsigned int remainRows = nRows - (nBlocks * RAT_BLOCK_LENGTH );
-            
-            int *blockData = new int[RAT_BLOCK_LENGTH];
-            
-            int feedback = nRows/10.0;
-            int feedbackCounter = 0;
-            
-            // Don't show progress if less rows than block length
-            if(nRows < RAT_BLOCK_LENGTH)
-            {
-                feedback = 0;
-            }
-            
-            if(feedback != 0){std::cout << "Started " << std::flush;}
-            
-            int rowOffset = 0;
-            for(int i = 0; i < nBlocks; i++)
-            {
-                rowOffset =  RAT_BLOCK_LENGTH * i;
-                
-                // Loop through block
-                
-                for(int m = 0; m < RAT_BLOCK_LENGTH; ++m)
-                {
-                    // Show progress
-                    if((feedback != 0) && (((i*RAT_BLOCK_LENGTH)+m) % feedback) == 0)
-                    {
-                        std::cout << "." << feedbackCounter << "." << std::flush;
-                        feedbackCounter = feedbackCounter + 10;
-                    }
-                    blockData[m] = intDataVal[(i*RAT_BLOCK_LENGTH)+m];
-                }
-                
-                // Write block
-                attTable->ValuesIO(GF_Write, columnIndex, rowOffset, RAT_BLOCK_LENGTH, blockData);
-                
-            }
-            if(remainRows > 0)
-            {
-                rowOffset =  RAT_BLOCK_LENGTH * nBlocks;
-                
-                // Loop through block
-                for(int m = 0; m < remainRows; ++m)
-                {
-                    // Show progress
-                    if((feedback != 0) && (((nBlocks*RAT_BLOCK_LENGTH)+m) % feedback) == 0)
-                    {
-                        std::cout << "." << feedbackCounter << "." << std::flush;
-                        feedbackCounter = feedbackCounter + 10;
-                    }
-                    blockData[m] = intDataVal[(nBlocks*RAT_BLOCK_LENGTH)+m];
-                }
-                
-                // Read block
-                attTable->ValuesIO(GF_Write, columnIndex, rowOffset, remainRows, blockData);
-            }
-            if(feedback != 0){std::cout << ".Completed\n";}
-            delete[] blockData;
-            
+            RSGISRATColumnIO ratIO(attTable);
+            ratIO.writeColumn(colName, intDataVal, colLen);
         }
         catch (RSGISAttributeTableException &e)
         {
@@ -2489,76 +1841,8 @@ namespace rsgis{namespace rastergis{
     {
         try
         {
-            // Iterate through blocks
-            size_t nRows = attTable->GetRowCount();
-            
-            if(nRows != colLen)
-            {
-                throw RSGISAttributeTableException("The column length provided and the length of the RAT are not equal...");
-            }
-            
-            unsigned int columnIndex = this->findColumnIndexOrCreate(attTable, colName, GFT_Real);
-            
-            unsigned int nBlocks = floor(((double) nRows) / ((double) RAT_BLOCK_LENGTH));
-            unsigned int remainRows = nRows - (nBlocks * RAT_BLOCK_LENGTH );
-            
-            double *blockData = new double[RAT_BLOCK_LENGTH];
-            
-            int feedback = nRows/10.0;
-            int feedbackCounter = 0;
-            
-            // Don't show progress if less rows than block length
-            if(nRows < RAT_BLOCK_LENGTH)
-            {
-                feedback = 0;
-            }
-            
-            if(feedback != 0){std::cout << "Started " << std::flush;}
-            
-            int rowOffset = 0;
-            for(int i = 0; i < nBlocks; i++)
-            {
-                rowOffset =  RAT_BLOCK_LENGTH * i;
-                
-                // Loop through block
-                
-                for(int m = 0; m < RAT_BLOCK_LENGTH; ++m)
-                {
-                    // Show progress
-                    if((feedback != 0) && (((i*RAT_BLOCK_LENGTH)+m) % feedback) == 0)
-                    {
-                        std::cout << "." << feedbackCounter << "." << std::flush;
-                        feedbackCounter = feedbackCounter + 10;
-                    }
-                    blockData[m] = realDataVal[(i*RAT_BLOCK_LENGTH)+m];
-                }
-                
-                // Write block
-                attTable->ValuesIO(GF_Write, columnIndex, rowOffset, RAT_BLOCK_LENGTH, blockData);
-                
-            }
-            if(remainRows > 0)
-            {
-                rowOffset =  RAT_BLOCK_LENGTH * nBlocks;
-                
-                // Loop through block
-                for(int m = 0; m < remainRows; ++m)
-                {
-                    // Show progress
-                    if((feedback != 0) && (((nBlocks*RAT_BLOCK_LENGTH)+m) % feedback) == 0)
-                    {
-                        std::cout << "." << feedbackCounter << "." << std::flush;
-                        feedbackCounter = feedbackCounter + 10;
-                    }
-                    blockData[m] = realDataVal[(nBlocks*RAT_BLOCK_LENGTH)+m];
-                }
-                
-                // Read block
-                attTable->ValuesIO(GF_Write, columnIndex, rowOffset, remainRows, blockData);
-            }
-            if(feedback != 0){std::cout << ".Completed\n";}
-            delete[] blockData;
-            
+            RSGISRATColumnIO ratIO(attTable);
+            ratIO.writeColumn(colName, realDataVal, colLen);
         }
         catch (RSGISAttributeTableException &e)
         {
@@ -2598,6 +1882,665 @@ namespace rsgis{namespace rastergis{
     }
     
     
+    RSGISRATColumnIO::RSGISRATColumnIO(GDALRasterAttributeTable *attTable, size_t chunkLen)
+    {
+        if(attTable == NULL)
+        {
+            throw RSGISAttributeTableException("The attribute table is NULL.");
+        }
+        if(chunkLen == 0)
+        {
+            throw RSGISAttributeTableException("The chunk length must be greater than zero.");
+        }
+        this->attTable = attTable;
+        this->chunkLen = chunkLen;
+        this->showProgress = false;
+        this->keaAtt = NULL;
+        this->initColumnIndexes();
+    }
+    
+    RSGISRATColumnIO::RSGISRATColumnIO(GDALDataset *dataset, unsigned int ratBand, size_t chunkLen)
+    {
+        if(chunkLen == 0)
+        {
+            throw RSGISAttributeTableException("The chunk length must be greater than zero.");
+        }
+        GDALRasterBand *band = dataset->GetRasterBand(ratBand);
+        if(band == NULL)
+        {
+            throw RSGISAttributeTableException("The RAT band is not within the image.");
+        }
+        this->attTable = band->GetDefaultRAT();
+        if(this->attTable == NULL)
+        {
+            throw RSGISAttributeTableException("The image does not have an attribute table.");
+        }
+        this->chunkLen = chunkLen;
+        this->showProgress = false;
+        this->keaAtt = NULL;
+        
+        if((dataset->GetDriver() != NULL) && (std::string(dataset->GetDriver()->GetDescription()) == "KEA"))
+        {
+            void *internalData = dataset->GetInternalHandle("");
+            if(internalData != NULL)
+            {
+                try
+                {
+                    kealib::KEAImageIO *keaImgIO = static_cast<kealib::KEAImageIO*>(internalData);
+                    this->keaAtt = keaImgIO->getAttributeTable(kealib::kea_att_file, ratBand);
+                }
+                catch(kealib::KEAException &e)
+                {
+                    // Just use GDAL to access the RAT.
+                    this->keaAtt = NULL;
+                }
+            }
+            
+            if(this->keaAtt != NULL)
+            {
+                // Read whole KEA chunks where possible.
+                size_t keaChunkSize = this->keaAtt->getChunkSize();
+                if((keaChunkSize > 0) && ((this->chunkLen % keaChunkSize) != 0))
+                {
+                    this->chunkLen = ((this->chunkLen / keaChunkSize) + 1) * keaChunkSize;
+                }
+            }
+        }
+        
+        this->initColumnIndexes();
+    }
+    
+    void RSGISRATColumnIO::initColumnIndexes()
+    {
+        this->colIdxs.clear();
+        int numColumns = this->attTable->GetColumnCount();
+        for(int i = 0; i < numColumns; ++i)
+        {
+            // The first column with the name is used, as with RSGISRasterAttUtils::findColumnIndex.
+            this->colIdxs.insert(std::pair<std::string, unsigned int>(std::string(this->attTable->GetNameOfCol(i)), i));
+        }
+    }
+    
+    bool RSGISRATColumnIO::hasColumn(std::string colName)
+    {
+        if(this->colIdxs.count(colName) > 0)
+        {
+            return true;
+        }
+        
+        // The column could have been added since the names were mapped.
+        if(this->colIdxs.size() != ((size_t)this->attTable->GetColumnCount()))
+        {
+            this->initColumnIndexes();
+        }
+        return this->colIdxs.count(colName) > 0;
+    }
+    
+    unsigned int RSGISRATColumnIO::getColumnIndex(std::string colName)
+    {
+        if(!this->hasColumn(colName))
+        {
+            std::string message = std::string("The column ") + colName + std::string(" could not be found.");
+            throw RSGISAttributeTableException(message);
+        }
+        return this->colIdxs[colName];
+    }
+    
+    unsigned int RSGISRATColumnIO::getColumnIndexOrCreate(std::string colName, GDALRATFieldType dType, GDALRATFieldUsage dUsage)
+    {
+        if(this->hasColumn(colName))
+        {
+            return this->colIdxs[colName];
+        }
+        
+        if(this->attTable->CreateColumn(colName.c_str(), dType, dUsage) != CE_None)
+        {
+            std::string message = std::string("The column ") + colName + std::string(" could not be created.");
+            throw RSGISAttributeTableException(message);
+        }
+        unsigned int colIdx = this->attTable->GetColumnCount()-1;
+        this->colIdxs[colName] = colIdx;
+        return colIdx;
+    }
+    
+    void RSGISRATColumnIO::checkRows(size_t startRow, size_t numRows)
+    {
+        if((startRow + numRows) > ((size_t)this->attTable->GetRowCount()))
+        {
+            throw RSGISAttributeTableException("The rows are not within the RAT.");
+        }
+    }
+    
+    bool RSGISRATColumnIO::getKEAField(unsigned int colIdx, kealib::KEAFieldDataType dataType, size_t *keaColIdx)
+    {
+        if(this->keaAtt == NULL)
+        {
+            return false;
+        }
+        // Rows added through GDAL may not yet be seen by this table.
+        if(this->keaAtt->getSize() != ((size_t)this->attTable->GetRowCount()))
+        {
+            return false;
+        }
+        std::string colName = std::string(this->attTable->GetNameOfCol(colIdx));
+        if(!this->keaAtt->hasField(colName))
+        {
+            return false;
+        }
+        kealib::KEAATTField field = this->keaAtt->getField(colName);
+        if(field.dataType != dataType)
+        {
+            return false;
+        }
+        *keaColIdx = field.idx;
+        return true;
+    }
+    
+    void RSGISRATColumnIO::readRows(unsigned int colIdx, size_t startRow, size_t numRows, double *data)
+    {
+        this->checkRows(startRow, numRows);
+        try
+        {
+            size_t keaColIdx = 0;
+            bool useKEA = this->getKEAField(colIdx, kealib::kea_att_float, &keaColIdx);
+            for(size_t offset = 0; offset < numRows; offset += this->chunkLen)
+            {
+                size_t len = std::min(this->chunkLen, numRows - offset);
+                if(useKEA)
+                {
+                    this->keaAtt->getFloatFields(startRow + offset, len, keaColIdx, &data[offset]);
+                }
+                else if(this->attTable->ValuesIO(GF_Read, colIdx, startRow + offset, len, &data[offset]) != CE_None)
+                {
+                    throw RSGISAttributeTableException("Failed to read the column from the RAT.");
+                }
+                rsgis::RSGISInstrumentation::recordRATValuesIO(false, len);
+            }
+        }
+        catch(kealib::KEAException &e)
+        {
+            throw RSGISAttributeTableException(e.what());
+        }
+    }
+    
+    void RSGISRATColumnIO::readRows(unsigned int colIdx, size_t startRow, size_t numRows, int *data)
+    {
+        this->checkRows(startRow, numRows);
+        try
+        {
+            size_t keaColIdx = 0;
+            bool useKEA = this->getKEAField(colIdx, kealib::kea_att_int, &keaColIdx);
+            for(size_t offset = 0; offset < numRows; offset += this->chunkLen)
+            {
+                size_t len = std::min(this->chunkLen, numRows - offset);
+                if(useKEA)
+                {
+                    this->keaIntBuffer.resize(len);
+                    this->keaAtt->getIntFields(startRow + offset, len, keaColIdx, &this->keaIntBuffer[0]);
+                    for(size_t i = 0; i < len; ++i)
+                    {
+                        data[offset+i] = (int)this->keaIntBuffer[i];
+                    }
+                }
+                else if(this->attTable->ValuesIO(GF_Read, colIdx, startRow + offset, len, &data[offset]) != CE_None)
+                {
+                    throw RSGISAttributeTableException("Failed to read the column from the RAT.");
+                }
+                rsgis::RSGISInstrumentation::recordRATValuesIO(false, len);
+            }
+        }
+        catch(kealib::KEAException &e)
+        {
+            throw RSGISAttributeTableException(e.what());
+        }
+    }
+    
+    void RSGISRATColumnIO::readRows(unsigned int colIdx, size_t startRow, size_t numRows, std::string *data)
+    {
+        this->checkRows(startRow, numRows);
+        char **strData = NULL;
+        try
+        {
+            size_t keaColIdx = 0;
+            bool useKEA = this->getKEAField(colIdx, kealib::kea_att_string, &keaColIdx);
+            if(!useKEA)
+            {
+                strData = new char*[std::min(this->chunkLen, numRows)];
+            }
+            for(size_t offset = 0; offset < numRows; offset += this->chunkLen)
+            {
+                size_t len = std::min(this->chunkLen, numRows - offset);
+                if(useKEA)
+                {
+                    this->keaStrBuffer.clear();
+                    this->keaAtt->getStringFields(startRow + offset, len, keaColIdx, &this->keaStrBuffer);
+                    if(this->keaStrBuffer.size() != len)
+                    {
+                        throw RSGISAttributeTableException("Failed to read the column from the KEA RAT.");
+                    }
+                    for(size_t i = 0; i < len; ++i)
+                    {
+                        data[offset+i].swap(this->keaStrBuffer[i]);
+                    }
+                }
+                else
+                {
+                    if(this->attTable->ValuesIO(GF_Read, colIdx, startRow + offset, len, strData) != CE_None)
+                    {
+                        throw RSGISAttributeTableException("Failed to read the column from the RAT.");
+                    }
+                    // GDAL returns copies of the strings which need to be freed.
+                    for(size_t i = 0; i < len; ++i)
+                    {
+                        if(strData[i] != NULL)
+                        {
+                            data[offset+i] = strData[i];
+                            CPLFree(strData[i]);
+                        }
+                        else
+                        {
+                            data[offset+i] = "";
+                        }
+                    }
+                }
+                rsgis::RSGISInstrumentation::recordRATValuesIO(false, len);
+            }
+        }
+        catch(kealib::KEAException &e)
+        {
+            if(strData != NULL)
+            {
+                delete[] strData;
+            }
+            throw RSGISAttributeTableException(e.what());
+        }
+        catch(RSGISAttributeTableException &e)
+        {
+            if(strData != NULL)
+            {
+                delete[] strData;
+            }
+            throw e;
+        }
+        if(strData != NULL)
+        {
+            delete[] strData;
+        }
+    }
+    
+    void RSGISRATColumnIO::writeRows(unsigned int colIdx, size_t startRow, size_t numRows, double *data)
+    {
+        this->checkRows(startRow, numRows);
+        for(size_t offset = 0; offset < numRows; offset += this->chunkLen)
+        {
+            size_t len = std::min(this->chunkLen, numRows - offset);
+            if(this->attTable->ValuesIO(GF_Write, colIdx, startRow + offset, len, &data[offset]) != CE_None)
+            {
+                throw RSGISAttributeTableException("Failed to write the column to the RAT.");
+            }
+            rsgis::RSGISInstrumentation::recordRATValuesIO(true, len);
+        }
+    }
+    
+    void RSGISRATColumnIO::writeRows(unsigned int colIdx, size_t startRow, size_t numRows, int *data)
+    {
+        this->checkRows(startRow, numRows);
+        for(size_t offset = 0; offset < numRows; offset += this->chunkLen)
+        {
+            size_t len = std::min(this->chunkLen, numRows - offset);
+            if(this->attTable->ValuesIO(GF_Write, colIdx, startRow + offset, len, &data[offset]) != CE_None)
+            {
+                throw RSGISAttributeTableException("Failed to write the column to the RAT.");
+            }
+            rsgis::RSGISInstrumentation::recordRATValuesIO(true, len);
+        }
+    }
+    
+    void RSGISRATColumnIO::writeRows(unsigned int colIdx, size_t startRow, size_t numRows, std::string *data)
+    {
+        this->checkRows(startRow, numRows);
+        if(numRows == 0)
+        {
+            return;
+        }
+        // GDAL copies the strings so they can be passed without copying them here.
+        char **strData = new char*[std::min(this->chunkLen, numRows)];
+        for(size_t offset = 0; offset < numRows; offset += this->chunkLen)
+        {
+            size_t len = std::min(this->chunkLen, numRows - offset);
+            for(size_t i = 0; i < len; ++i)
+            {
+                strData[i] = const_cast<char*>(data[offset+i].c_str());
+            }
+            if(this->attTable->ValuesIO(GF_Write, colIdx, startRow + offset, len, strData) != CE_None)
+            {
+                delete[] strData;
+                throw RSGISAttributeTableException("Failed to write the column to the RAT.");
+            }
+            rsgis::RSGISInstrumentation::recordRATValuesIO(true, len);
+        }
+        delete[] strData;
+    }
+    
+    void RSGISRATColumnIO::readColumn(std::string colName, std::vector<double> *data)
+    {
+        unsigned int colIdx = this->getColumnIndex(colName);
+        size_t numRows = this->getNumRows();
+        data->resize(numRows);
+        bool feedback = this->showProgress && (numRows > this->chunkLen);
+        int lastProgress = -1;
+        if(feedback){RSGISRATStatsTextProgress(0.0, "", &lastProgress);}
+        for(size_t startRow = 0; startRow < numRows; startRow += this->chunkLen)
+        {
+            size_t numChunkRows = std::min(this->chunkLen, numRows - startRow);
+            this->readRows(colIdx, startRow, numChunkRows, &(*data)[startRow]);
+            if(feedback){RSGISRATStatsTextProgress(((double)(startRow + numChunkRows))/((double)numRows), "", &lastProgress);}
+        }
+    }
+    
+    void RSGISRATColumnIO::readColumn(std::string colName, std::vector<int> *data)
+    {
+        unsigned int colIdx = this->getColumnIndex(colName);
+        size_t numRows = this->getNumRows();
+        data->resize(numRows);
+        bool feedback = this->showProgress && (numRows > this->chunkLen);
+        int lastProgress = -1;
+        if(feedback){RSGISRATStatsTextProgress(0.0, "", &lastProgress);}
+        for(size_t startRow = 0; startRow < numRows; startRow += this->chunkLen)
+        {
+            size_t numChunkRows = std::min(this->chunkLen, numRows - startRow);
+            this->readRows(colIdx, startRow, numChunkRows, &(*data)[startRow]);
+            if(feedback){RSGISRATStatsTextProgress(((double)(startRow + numChunkRows))/((double)numRows), "", &lastProgress);}
+        }
+    }
+    
+    void RSGISRATColumnIO::readColumn(std::string colName, std::vector<std::string> *data)
+    {
+        unsigned int colIdx = this->getColumnIndex(colName);
+        size_t numRows = this->getNumRows();
+        data->resize(numRows);
+        bool feedback = this->showProgress && (numRows > this->chunkLen);
+        int lastProgress = -1;
+        if(feedback){RSGISRATStatsTextProgress(0.0, "", &lastProgress);}
+        for(size_t startRow = 0; startRow < numRows; startRow += this->chunkLen)
+        {
+            size_t numChunkRows = std::min(this->chunkLen, numRows - startRow);
+            this->readRows(colIdx, startRow, numChunkRows, &(*data)[startRow]);
+            if(feedback){RSGISRATStatsTextProgress(((double)(startRow + numChunkRows))/((double)numRows), "", &lastProgress);}
+        }
+    }
+    
+    void RSGISRATColumnIO::writeColumn(std::string colName, double *data, size_t colLen, GDALRATFieldUsage dUsage)
+    {
+        size_t numRows = this->getNumRows();
+        if(numRows != colLen)
+        {
+            throw RSGISAttributeTableException("The column length provided and the length of the RAT are not equal...");
+        }
+        unsigned int colIdx = this->getColumnIndexOrCreate(colName, GFT_Real, dUsage);
+        bool feedback = this->showProgress && (numRows > this->chunkLen);
+        int lastProgress = -1;
+        if(feedback){RSGISRATStatsTextProgress(0.0, "", &lastProgress);}
+        for(size_t startRow = 0; startRow < numRows; startRow += this->chunkLen)
+        {
+            size_t numChunkRows = std::min(this->chunkLen, numRows - startRow);
+            this->writeRows(colIdx, startRow, numChunkRows, &data[startRow]);
+            if(feedback){RSGISRATStatsTextProgress(((double)(startRow + numChunkRows))/((double)numRows), "", &lastProgress);}
+        }
+    }
+    
+    void RSGISRATColumnIO::writeColumn(std::string colName, int *data, size_t colLen, GDALRATFieldUsage dUsage)
+    {
+        size_t numRows = this->getNumRows();
+        if(numRows != colLen)
+        {
+            throw RSGISAttributeTableException("The column length provided and the length of the RAT are not equal...");
+        }
+        unsigned int colIdx = this->getColumnIndexOrCreate(colName, GFT_Integer, dUsage);
+        bool feedback = this->showProgress && (numRows > this->chunkLen);
+        int lastProgress = -1;
+        if(feedback){RSGISRATStatsTextProgress(0.0, "", &lastProgress);}
+        for(size_t startRow = 0; startRow < numRows; startRow += this->chunkLen)
+        {
+            size_t numChunkRows = std::min(this->chunkLen, numRows - startRow);
+            this->writeRows(colIdx, startRow, numChunkRows, &data[startRow]);
+            if(feedback){RSGISRATStatsTextProgress(((double)(startRow + numChunkRows))/((double)numRows), "", &lastProgress);}
+        }
+    }
+    
+    void RSGISRATColumnIO::writeColumn(std::string colName, std::string *data, size_t colLen, GDALRATFieldUsage dUsage)
+    {
+        size_t numRows = this->getNumRows();
+        if(numRows != colLen)
+        {
+            throw RSGISAttributeTableException("The column length provided and the length of the RAT are not equal...");
+        }
+        unsigned int colIdx = this->getColumnIndexOrCreate(colName, GFT_String, dUsage);
+        bool feedback = this->showProgress && (numRows > this->chunkLen);
+        int lastProgress = -1;
+        if(feedback){RSGISRATStatsTextProgress(0.0, "", &lastProgress);}
+        for(size_t startRow = 0; startRow < numRows; startRow += this->chunkLen)
+        {
+            size_t numChunkRows = std::min(this->chunkLen, numRows - startRow);
+            this->writeRows(colIdx, startRow, numChunkRows, &data[startRow]);
+            if(feedback){RSGISRATStatsTextProgress(((double)(startRow + numChunkRows))/((double)numRows), "", &lastProgress);}
+        }
+    }
+    
+    RSGISRATColumnIO::~RSGISRATColumnIO()
+    {
+        if(this->keaAtt != NULL)
+        {
+            delete this->keaAtt;
+        }
+    }
+    
+    
+    RSGISRATChunkIterator::RSGISRATChunkIterator(RSGISRATColumnIO *ratIO, bool showProgress)
+    {
+        this->ratIO = ratIO;
+        this->numRows = ratIO->getNumRows();
+        this->startRow = 0;
+        this->numChunkRows = 0;
+        this->started = false;
+        this->showProgress = showProgress;
+        this->lastProgress = -1;
+    }
+    
+    unsigned int RSGISRATChunkIterator::addColumn(std::string colName, GDALRATFieldType dType, bool read, bool write, GDALRATFieldUsage dUsage)
+    {
+        if(this->started)
+        {
+            throw RSGISAttributeTableException("Columns need to be added before iterating through the RAT.");
+        }
+        if((dType != GFT_Real) && (dType != GFT_Integer) && (dType != GFT_String))
+        {
+            throw RSGISAttributeTableException("The column type is not supported.");
+        }
+        
+        RSGISRATChunkColumn column;
+        if(write)
+        {
+            column.colIdx = this->ratIO->getColumnIndexOrCreate(colName, dType, dUsage);
+        }
+        else
+        {
+            column.colIdx = this->ratIO->getColumnIndex(colName);
+        }
+        column.type = dType;
+        column.read = read;
+        column.write = write;
+        column.realData = NULL;
+        column.intData = NULL;
+        column.strData = NULL;
+        
+        size_t bufferLen = std::max(std::min(this->ratIO->getChunkLength(), this->numRows), ((size_t)1));
+        if(dType == GFT_Real)
+        {
+            column.realData = new double[bufferLen];
+        }
+        else if(dType == GFT_Integer)
+        {
+            column.intData = new int[bufferLen];
+        }
+        else
+        {
+            column.strData = new std::string[bufferLen];
+        }
+        this->columns.push_back(column);
+        return this->columns.size()-1;
+    }
+    
+    bool RSGISRATChunkIterator::next()
+    {
+        if(this->started)
+        {
+            this->writeChunk();
+            this->startRow += this->numChunkRows;
+            if(this->showProgress && (this->numChunkRows > 0))
+            {
+                RSGISRATStatsTextProgress(((double)this->startRow)/((double)this->numRows), "", &this->lastProgress);
+            }
+        }
+        else
+        {
+            this->started = true;
+            this->startRow = 0;
+            if(this->showProgress && (this->numRows > 0))
+            {
+                RSGISRATStatsTextProgress(0.0, "", &this->lastProgress);
+            }
+        }
+        
+        if(this->startRow >= this->numRows)
+        {
+            this->numChunkRows = 0;
+            return false;
+        }
+        
+        this->numChunkRows = std::min(this->ratIO->getChunkLength(), this->numRows - this->startRow);
+        for(std::vector<RSGISRATChunkColumn>::iterator iterCols = this->columns.begin(); iterCols != this->columns.end(); ++iterCols)
+        {
+            if((*iterCols).type == GFT_Real)
+            {
+                if((*iterCols).read)
+                {
+                    this->ratIO->readRows((*iterCols).colIdx, this->startRow, this->numChunkRows, (*iterCols).realData);
+                }
+                else
+                {
+                    std::fill((*iterCols).realData, (*iterCols).realData+this->numChunkRows, 0.0);
+                }
+            }
+            else if((*iterCols).type == GFT_Integer)
+            {
+                if((*iterCols).read)
+                {
+                    this->ratIO->readRows((*iterCols).colIdx, this->startRow, this->numChunkRows, (*iterCols).intData);
+                }
+                else
+                {
+                    std::fill((*iterCols).intData, (*iterCols).intData+this->numChunkRows, 0);
+                }
+            }
+            else
+            {
+                if((*iterCols).read)
+                {
+                    this->ratIO->readRows((*iterCols).colIdx, this->startRow, this->numChunkRows, (*iterCols).strData);
+                }
+                else
+                {
+                    std::fill((*iterCols).strData, (*iterCols).strData+this->numChunkRows, std::string(""));
+                }
+            }
+        }
+        return true;
+    }
+    
+    void RSGISRATChunkIterator::reset()
+    {
+        this->numRows = this->ratIO->getNumRows();
+        this->startRow = 0;
+        this->numChunkRows = 0;
+        this->started = false;
+        this->lastProgress = -1;
+    }
+    
+    RSGISRATSpan<double> RSGISRATChunkIterator::getRealColumn(unsigned int idx)
+    {
+        if((idx >= this->columns.size()) || (this->columns[idx].type != GFT_Real))
+        {
+            throw RSGISAttributeTableException("The column is not a real column within the iterator.");
+        }
+        return RSGISRATSpan<double>(this->columns[idx].realData, this->startRow, this->numChunkRows);
+    }
+    
+    RSGISRATSpan<int> RSGISRATChunkIterator::getIntColumn(unsigned int idx)
+    {
+        if((idx >= this->columns.size()) || (this->columns[idx].type != GFT_Integer))
+        {
+            throw RSGISAttributeTableException("The column is not an integer column within the iterator.");
+        }
+        return RSGISRATSpan<int>(this->columns[idx].intData, this->startRow, this->numChunkRows);
+    }
+    
+    RSGISRATSpan<std::string> RSGISRATChunkIterator::getStrColumn(unsigned int idx)
+    {
+        if((idx >= this->columns.size()) || (this->columns[idx].type != GFT_String))
+        {
+            throw RSGISAttributeTableException("The column is not a string column within the iterator.");
+        }
+        return RSGISRATSpan<std::string>(this->columns[idx].strData, this->startRow, this->numChunkRows);
+    }
+    
+    void RSGISRATChunkIterator::writeChunk()
+    {
+        if(this->numChunkRows == 0)
+        {
+            return;
+        }
+        for(std::vector<RSGISRATChunkColumn>::iterator iterCols = this->columns.begin(); iterCols != this->columns.end(); ++iterCols)
+        {
+            if(!(*iterCols).write)
+            {
+                continue;
+            }
+            if((*iterCols).type == GFT_Real)
+            {
+                this->ratIO->writeRows((*iterCols).colIdx, this->startRow, this->numChunkRows, (*iterCols).realData);
+            }
+            else if((*iterCols).type == GFT_Integer)
+            {
+                this->ratIO->writeRows((*iterCols).colIdx, this->startRow, this->numChunkRows, (*iterCols).intData);
+            }
+            else
+            {
+                this->ratIO->writeRows((*iterCols).colIdx, this->startRow, this->numChunkRows, (*iterCols).strData);
+            }
+        }
+    }
+    
+    RSGISRATChunkIterator::~RSGISRATChunkIterator()
+    {
+        for(std::vector<RSGISRATChunkColumn>::iterator iterCols = this->columns.begin(); iterCols != this->columns.end(); ++iterCols)
+        {
+            if((*iterCols).realData != NULL)
+            {
+                delete[] (*iterCols).realData;
+            }
+            if((*iterCols).intData != NULL)
+            {
+                delete[] (*iterCols).intData;
+            }
+            if((*iterCols).strData != NULL)
+            {
+                delete[] (*iterCols).strData;
+            }
+        }
+    }
+    
+    
     
     
     
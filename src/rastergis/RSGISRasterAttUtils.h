@@ -31,6 +31,7 @@
 #include <map>
 #include <vector>
 #include <math.h>
+#include <algorithm>
 
 #include "gdal_priv.h"
 #include "gdal_rat.h"
@@ -196,6 +197,140 @@ namespace rsgis{namespace rastergis{
         ~RSGISRasterAttUtils();
     };
     
+    /**
+     * A run of rows of a column held in memory (i.e., a chunk of the RAT) where
+     * data[0] is the value for startRow.
+     */
+    template <class T>
+    struct RSGISRATSpan
+    {
+        RSGISRATSpan(): data(NULL), startRow(0), length(0){};
+        RSGISRATSpan(T *data, size_t startRow, size_t length): data(data), startRow(startRow), length(length){};
+        T& operator[](size_t i){return data[i];};
+        const T& operator[](size_t i) const{return data[i];};
+        T* begin(){return data;};
+        T* end(){return data+length;};
+        size_t size() const{return length;};
+        T *data;
+        size_t startRow;
+        size_t length;
+    };
+    
+    /**
+     * Calls ValuesIO on the RAT and records the call and the number of values
+     * with RSGISInstrumentation. The result of ValuesIO is returned.
+     */
+    template<class T> inline CPLErr instrumentedRATValuesIO(GDALRasterAttributeTable *attTable, GDALRWFlag rwFlag, int colIdx, int startRow, int length, T *data)
+    {
+        CPLErr err = attTable->ValuesIO(rwFlag, colIdx, startRow, length, data);
+        rsgis::RSGISInstrumentation::recordRATValuesIO((rwFlag == GF_Write), length);
+        return err;
+    }
+    
+    /**
+     * Columnar access to a RAT. The column names are mapped to indexes once and
+     * the values are read and written in chunks (of chunkLen rows) with ValuesIO
+     * rather than row by row.
+     *
+     * Where constructed with a KEA dataset, real, integer and string columns are
+     * read directly through libkea, which avoids the char* copies GDAL makes of
+     * strings. Writes always go through GDAL so its view of the RAT stays in step.
+     */
+    class DllExport RSGISRATColumnIO
+    {
+    public:
+        RSGISRATColumnIO(GDALRasterAttributeTable *attTable, size_t chunkLen=RAT_BLOCK_LENGTH);
+        RSGISRATColumnIO(GDALDataset *dataset, unsigned int ratBand, size_t chunkLen=RAT_BLOCK_LENGTH);
+        GDALRasterAttributeTable* getRAT(){return this->attTable;};
+        size_t getNumRows(){return this->attTable->GetRowCount();};
+        size_t getChunkLength(){return this->chunkLen;};
+        bool usingKEA(){return this->keaAtt != NULL;};
+        /** Prints the progress of whole column reads and writes of more than one chunk. */
+        void setShowProgress(bool showProgress){this->showProgress = showProgress;};
+        bool hasColumn(std::string colName);
+        unsigned int getColumnIndex(std::string colName);
+        unsigned int getColumnIndexOrCreate(std::string colName, GDALRATFieldType dType, GDALRATFieldUsage dUsage=GFU_Generic);
+        GDALRATFieldType getColumnType(unsigned int colIdx){return this->attTable->GetTypeOfCol(colIdx);};
+        void readRows(unsigned int colIdx, size_t startRow, size_t numRows, double *data);
+        void readRows(unsigned int colIdx, size_t startRow, size_t numRows, int *data);
+        void readRows(unsigned int colIdx, size_t startRow, size_t numRows, std::string *data);
+        void writeRows(unsigned int colIdx, size_t startRow, size_t numRows, double *data);
+        void writeRows(unsigned int colIdx, size_t startRow, size_t numRows, int *data);
+        void writeRows(unsigned int colIdx, size_t startRow, size_t numRows, std::string *data);
+        /** Reads the whole column, chunk by chunk, into data (which is resized to the number of rows). */
+        void readColumn(std::string colName, std::vector<double> *data);
+        void readColumn(std::string colName, std::vector<int> *data);
+        void readColumn(std::string colName, std::vector<std::string> *data);
+        /** Writes the whole column, chunk by chunk, creating it if it does not exist. */
+        void writeColumn(std::string colName, double *data, size_t colLen, GDALRATFieldUsage dUsage=GFU_Generic);
+        void writeColumn(std::string colName, int *data, size_t colLen, GDALRATFieldUsage dUsage=GFU_Generic);
+        void writeColumn(std::string colName, std::string *data, size_t colLen, GDALRATFieldUsage dUsage=GFU_Generic);
+        ~RSGISRATColumnIO();
+    protected:
+        void initColumnIndexes();
+        bool getKEAField(unsigned int colIdx, kealib::KEAFieldDataType dataType, size_t *keaColIdx);
+        void checkRows(size_t startRow, size_t numRows);
+        GDALRasterAttributeTable *attTable;
+        size_t chunkLen;
+        bool showProgress;
+        std::map<std::string, unsigned int> colIdxs;
+        kealib::KEAAttributeTable *keaAtt;
+        std::vector<int64_t> keaIntBuffer;
+        std::vector<std::string> keaStrBuffer;
+    };
+    
+    /**
+     * Iterates through a RAT a chunk at a time so only a chunk of each column
+     * is held in memory. Columns are added for reading and/or writing and then
+     * next() is called until it returns false; each call writes the columns of
+     * the current chunk before reading the next.
+     *
+     *    RSGISRATChunkIterator ratIter(&ratIO);
+     *    unsigned int inCol = ratIter.addColumn("Class", GFT_Integer, true, false);
+     *    unsigned int outCol = ratIter.addColumn("Area", GFT_Real, false, true);
+     *    while(ratIter.next())
+     *    {
+     *        RSGISRATSpan<int> classVals = ratIter.getIntColumn(inCol);
+     *        ...
+     *    }
+     */
+    class DllExport RSGISRATChunkIterator
+    {
+    public:
+        RSGISRATChunkIterator(RSGISRATColumnIO *ratIO, bool showProgress=false);
+        /** Columns which are read must exist; columns which are only written are created if required and start each chunk as 0 (or ""). */
+        unsigned int addColumn(std::string colName, GDALRATFieldType dType, bool read, bool write, GDALRATFieldUsage dUsage=GFU_Generic);
+        bool next();
+        /** Restarts the iteration from the first row. */
+        void reset();
+        size_t getStartRow(){return this->startRow;};
+        size_t getNumChunkRows(){return this->numChunkRows;};
+        RSGISRATSpan<double> getRealColumn(unsigned int idx);
+        RSGISRATSpan<int> getIntColumn(unsigned int idx);
+        RSGISRATSpan<std::string> getStrColumn(unsigned int idx);
+        ~RSGISRATChunkIterator();
+    protected:
+        struct RSGISRATChunkColumn
+        {
+            unsigned int colIdx;
+            GDALRATFieldType type;
+            bool read;
+            bool write;
+            double *realData;
+            int *intData;
+            std::string *strData;
+        };
+        void writeChunk();
+        RSGISRATColumnIO *ratIO;
+        std::vector<RSGISRATChunkColumn> columns;
+        size_t numRows;
+        size_t startRow;
+        size_t numChunkRows;
+        bool started;
+        bool showProgress;
+        int lastProgress;
+    };
+    
     
     class DllExport RSGISCalcImgMinMax : public rsgis::img::RSGISCalcImageValue
     {
@@ -26,7 +26,7 @@
 
 namespace rsgis{namespace reg{
 
-	RSGISBasicImageRegistration::RSGISBasicImageRegistration(GDALDataset *reference, GDALDataset *floating, unsigned int gap, float metricThreshold, unsigned int windowSize, unsigned int searchArea, RSGISImageSimilarityMetric *metric, float stdDevRefThreshold, float stdDevFloatThreshold, unsigned int subPixelResolution):RSGISImageRegistration(reference, floating), tiePoints(NULL), gap(1), metricThreshold(0), initExecuted(false), windowSize(0), searchArea(0), metric(NULL), stdDevRefThreshold(0), stdDevFloatThreshold(0), subPixelResolution(0)
+	RSGISBasicImageRegistration::RSGISBasicImageRegistration(GDALDataset *reference, GDALDataset *floating, unsigned int gap, float metricThreshold, unsigned int windowSize, unsigned int searchArea, RSGISImageSimilarityMetric *metric, float stdDevRefThreshold, float stdDevFloatThreshold, unsigned int subPixelResolution, unsigned int numThreads):RSGISImageRegistration(reference, floating), tiePoints(NULL), gap(1), metricThreshold(0), initExecuted(false), windowSize(0), searchArea(0), metric(NULL), stdDevRefThreshold(0), stdDevFloatThreshold(0), subPixelResolution(0), numThreads(1)
 	{
 		tiePoints = new std::list<TiePoint*>();
 		this->gap = gap;
@@ -37,6 +37,7 @@ namespace rsgis{namespace reg{
 		this->stdDevRefThreshold = stdDevRefThreshold;
 		this->stdDevFloatThreshold = stdDevFloatThreshold;
 		this->subPixelResolution = subPixelResolution;
+		this->numThreads = rsgis::getNumProcessingThreads(numThreads);
 	}
 		
 	void RSGISBasicImageRegistration::initRegistration()
@@ -120,33 +121,46 @@ namespace rsgis{namespace reg{
 			throw RSGISRegistrationException("The algorithm needs to be initialised before being executed.");
 		}
 		
-		unsigned int counter = 0;
-		unsigned int feedback = 0;
-		unsigned int feedbackVal = 0;
-		bool giveFeedback = false;
-		if(tiePoints->size() > 10)
+		// Each tie point is searched for independently so they are shared between the threads.
+		std::vector<TiePoint*> tiePtsVec(tiePoints->begin(), tiePoints->end());
+		this->openThreadDatasets(numThreads);
+		
+		// Process the tie points in 10 blocks so feedback can be given between them.
+		size_t numTiePts = tiePtsVec.size();
+		size_t feedback = numTiePts/10;
+		if(feedback == 0)
 		{
-			feedback = tiePoints->size()/10;
-			giveFeedback = true;
+			feedback = numTiePts;
 		}
+		unsigned int feedbackVal = 0;
 		
-		std::cout << "Started ." << std::flush;
-		
-		float xShift = 0;
-		float yShift = 0;
+		std::cout << "Started (" << numThreads << " threads) ." << std::flush;
 		
-		std::list<TiePoint*>::iterator iterTiePts;
-		for(iterTiePts = tiePoints->begin(); iterTiePts != tiePoints->end(); ++iterTiePts)
+		try
 		{
-			if(giveFeedback && ((counter % feedback) == 0))
+			for(size_t blockStart = 0; blockStart < numTiePts; blockStart += feedback)
 			{
 				std::cout << "." << feedbackVal << "." << std::flush;
 				feedbackVal += 10;
+				
+				size_t blockEnd = std::min(blockStart + feedback, numTiePts);
+				rsgis::parallelForRange(blockStart, blockEnd, numThreads, 1, [&](size_t ptStart, size_t ptEnd, unsigned int threadIdx)
+				{
+					float xShift = 0;
+					float yShift = 0;
+					for(size_t i = ptStart; i < ptEnd; ++i)
+					{
+						this->findTiePointLocation(tiePtsVec[i], windowSize, searchArea, metric, metricThreshold, subPixelResolution, &xShift, &yShift, threadIdx);
+					}
+				});
 			}
-			
-			this->findTiePointLocation(*iterTiePts, windowSize, searchArea, metric, metricThreshold, subPixelResolution, &xShift, &yShift);            
-			++counter;
 		}
+		catch(std::exception &e)
+		{
+			this->closeThreadDatasets();
+			throw;
+		}
+		this->closeThreadDatasets();
 		std::cout << ". Complete\n";
 	}
 	
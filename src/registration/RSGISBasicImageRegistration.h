@@ -30,6 +30,7 @@
 #include <string>
 #include <math.h>
 #include <list>
+#include <vector>
 
 #include "gdal_priv.h"
 #include "ogrsf_frmts.h"
@@ -38,6 +39,8 @@
 
 #include "registration/RSGISImageRegistration.h"
 
+#include "common/RSGISThreadUtils.h"
+
 #include "boost/math/special_functions/fpclassify.hpp"
 
 // mark all exported classes/functions with DllExport to have
@@ -58,7 +61,7 @@ namespace rsgis{namespace reg{
 	class DllExport RSGISBasicImageRegistration : public RSGISImageRegistration
 	{
 	public:
-		RSGISBasicImageRegistration(GDALDataset *reference, GDALDataset *floating, unsigned int gap, float metricThreshold, unsigned int windowSize, unsigned int searchArea, RSGISImageSimilarityMetric *metric, float stdDevRefThreshold, float stdDevFloatThreshold, unsigned int subPixelResolution);
+		RSGISBasicImageRegistration(GDALDataset *reference, GDALDataset *floating, unsigned int gap, float metricThreshold, unsigned int windowSize, unsigned int searchArea, RSGISImageSimilarityMetric *metric, float stdDevRefThreshold, float stdDevFloatThreshold, unsigned int subPixelResolution, unsigned int numThreads=1);
 		void initRegistration();
 		void executeRegistration();
 		void finaliseRegistration();
@@ -78,6 +81,7 @@ namespace rsgis{namespace reg{
 		float stdDevRefThreshold;
 		float stdDevFloatThreshold;
 		unsigned int subPixelResolution;
+		unsigned int numThreads;
 	};
 }}
 
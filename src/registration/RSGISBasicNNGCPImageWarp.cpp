@@ -28,7 +28,7 @@
 namespace rsgis{namespace reg{
 	
 	
-	RSGISBasicNNGCPImageWarp::RSGISBasicNNGCPImageWarp(std::string inputImage, std::string outputImage, std::string outProjWKT, std::string gcpFilePath, float outImgRes, RSGISWarpImageInterpolator *interpolator, std::string gdalFormat) : RSGISWarpImage(inputImage, outputImage, outProjWKT, gcpFilePath, outImgRes, interpolator, gdalFormat), pointIndex(NULL)
+	RSGISBasicNNGCPImageWarp::RSGISBasicNNGCPImageWarp(std::string inputImage, std::string outputImage, std::string outProjWKT, std::string gcpFilePath, float outImgRes, RSGISWarpImageInterpolator *interpolator, std::string gdalFormat, unsigned int numThreads, double maxTransformError) : RSGISWarpImage(inputImage, outputImage, outProjWKT, gcpFilePath, outImgRes, interpolator, gdalFormat, numThreads, maxTransformError), pointIndex(NULL)
 	{
 		
 	}
@@ -104,7 +104,7 @@ namespace rsgis{namespace reg{
 		return env;
 	}
 	
-	void RSGISBasicNNGCPImageWarp::findNearestPixel(double eastings, double northings, unsigned int *x, unsigned int *y, float inImgRes)
+	void RSGISBasicNNGCPImageWarp::findPixelLocation(double eastings, double northings, double *x, double *y, float inImgRes)
 	{
 		RSGISGCPImg2MapNode *pxl = new RSGISGCPImg2MapNode(eastings, northings, 0, 0);
 		
@@ -145,11 +145,13 @@ namespace rsgis{namespace reg{
             double pxlDistX = xDistance/inImgRes;
             double pxlDistY = yDistance/inImgRes;
             
-            *x = floor((closestGCP->imgX()-pxlDistX)+0.5);
-            *y = floor((closestGCP->imgY()+pxlDistY)+0.5);
+            *x = closestGCP->imgX()-pxlDistX;
+            *y = closestGCP->imgY()+pxlDistY;
         }
         else 
         {
+            delete pxl;
+            delete searchEnv;
             throw RSGISImageWarpException("Tie point could not be founded within search radius.");
         }
 		
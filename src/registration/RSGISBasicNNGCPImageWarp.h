@@ -58,12 +58,12 @@ namespace rsgis{namespace reg{
 	class DllExport RSGISBasicNNGCPImageWarp : public RSGISWarpImage
 	{
 	public:
-		RSGISBasicNNGCPImageWarp(std::string inputImage, std::string outputImage, std::string outProjWKT, std::string gcpFilePath, float outImgRes, RSGISWarpImageInterpolator *interpolator, std::string gdalFormat);
+		RSGISBasicNNGCPImageWarp(std::string inputImage, std::string outputImage, std::string outProjWKT, std::string gcpFilePath, float outImgRes, RSGISWarpImageInterpolator *interpolator, std::string gdalFormat, unsigned int numThreads=1, double maxTransformError=0);
 		void initWarp();
 		~RSGISBasicNNGCPImageWarp();
 	protected:
 		geos::geom::Envelope* newImageExtent(unsigned int width, unsigned int height);
-		void findNearestPixel(double eastings, double northings, unsigned int *x, unsigned int *y, float inImgRes);
+		void findPixelLocation(double eastings, double northings, double *x, double *y, float inImgRes);
         geos::index::quadtree::Quadtree *pointIndex;
 	};
 	
@@ -28,10 +28,12 @@
 namespace rsgis{namespace reg{
 
 		
-	RSGISImageRegistration::RSGISImageRegistration(GDALDataset *reference, GDALDataset *floating): referenceIMG(NULL), floatingIMG(NULL), overlap(NULL), overlapDefined(false)
+	RSGISImageRegistration::RSGISImageRegistration(GDALDataset *reference, GDALDataset *floating): referenceIMG(NULL), floatingIMG(NULL), overlap(NULL), overlapDefined(false), useFFTCoarseShift(false), refGeoTransform(NULL), floatGeoTransform(NULL), refSizeX(0), refSizeY(0), floatSizeX(0), floatSizeY(0)
 	{
 		this->referenceIMG = reference;
 		this->floatingIMG = floating;
+		this->refGeoTransform = new double[6];
+		this->floatGeoTransform = new double[6];
 	}
 	
 	void RSGISImageRegistration::runCompleteRegistration()
@@ -83,6 +85,15 @@ namespace rsgis{namespace reg{
 			overlap->numRefBands = referenceIMG->GetRasterCount();
 			overlap->numFloatBands = floatingIMG->GetRasterCount();
 			
+			// Keep the image transformations so the overlap for a shift can be
+			// found without accessing the datasets (which may be in use by other threads).
+			referenceIMG->GetGeoTransform(this->refGeoTransform);
+			floatingIMG->GetGeoTransform(this->floatGeoTransform);
+			this->refSizeX = referenceIMG->GetRasterXSize();
+			this->refSizeY = referenceIMG->GetRasterYSize();
+			this->floatSizeX = floatingIMG->GetRasterXSize();
+			this->floatSizeY = floatingIMG->GetRasterYSize();
+			
 			delete[] overlapTransform;
 			delete[] dsOffsets[0];
 			delete[] dsOffsets[1];
@@ -114,7 +125,7 @@ namespace rsgis{namespace reg{
 
 	}
 	
-	float RSGISImageRegistration::findTiePointLocation(TiePoint *tiePt, unsigned int windowSize, unsigned int searchArea, RSGISImageSimilarityMetric *metric, float metricThreshold, unsigned int subPixelResolution, float *moveInX, float *moveInY)
+	float RSGISImageRegistration::findTiePointLocation(TiePoint *tiePt, unsigned int windowSize, unsigned int searchArea, RSGISImageSimilarityMetric *metric, float metricThreshold, unsigned int subPixelResolution, float *moveInX, float *moveInY, unsigned int threadIdx)
 	{
 		float distanceMoved = 0;
 		
@@ -123,17 +134,8 @@ namespace rsgis{namespace reg{
 			throw RSGISRegistrationException("The overlap needs to be defined before tie location can be defined.");
 		}
 		
-		rsgis::img::RSGISImageUtils imgUtils;
 		try 
 		{
-			// Setup overlapping region variables.
-			int **dsOffsets = new int*[2];
-			dsOffsets[0] = new int[2];
-			dsOffsets[1] = new int[2];
-			int overlapWidth = 0;
-			int overlapHeight = 0;
-			double *overlapTransform = new double[6];
-			
 			double windowXWidth = (((double)windowSize)*overlap->xRes);
 			double windowYHeight = (((double)windowSize)*overlap->yRes);
 			
@@ -150,117 +152,19 @@ namespace rsgis{namespace reg{
 				imageSimilarity[i] = new float[numSearchPoints];
 			}
 			
-			int xShiftStart = searchArea * (-1);
-			int yShiftStart = searchArea * (-1);
-			int xShiftEnd = searchArea;
-			int yShiftEnd = searchArea;
-			
-			float **refDataBlock = NULL;
-			float **floatDataBlock = NULL;
-			unsigned int numRefDataVals = 0;
-			unsigned int numFloatDataVals = 0;
-			
-			bool first = true;
 			double currentMetricVal = 0;
-			double metricVal = 0;
-			int currentShiftX = 0;
-			int currentShiftY = 0;
-			
-			unsigned int xIdx = 0;
-			unsigned int yIdx = 0;
 			unsigned int currentXIdx = 0;
 			unsigned int currentYIdx = 0;
-            
-            // Set up variables to hold remainder from image overlap
-            float remainderX = 0;
-            float remainderY = 0;
+			int currentShiftX = 0;
+			int currentShiftY = 0;
             // Remainder for heighest metric
             float currentRemainderX = 0;
             float currentRemainderY = 0;
-            
-            
 			
-            // Move floating window over search space
-			for(int yShift = yShiftStart; yShift <= yShiftEnd; ++yShift)
+			if(this->calcSearchAreaSimilarity(this->getThreadReferenceDataset(threadIdx), this->getThreadFloatingDataset(threadIdx), tiePt, env, searchArea, metric, imageSimilarity, &currentXIdx, &currentYIdx, &currentMetricVal, &currentRemainderX, &currentRemainderY))
 			{
-				xIdx = 0;
-				for(int xShift = xShiftStart; xShift <= xShiftEnd; ++xShift)
-				{
-					try
-					{
-						this->getImageOverlapWithFloatShift((((float)xShift)+tiePt->xShift), (((float)yShift)+tiePt->yShift), dsOffsets, &overlapWidth, &overlapHeight, overlapTransform, env, &remainderX, &remainderY);
-						
-						if((overlapWidth > 0) & (overlapHeight > 0))
-						{
-							numRefDataVals = 0;
-							numFloatDataVals = 0;
-							
-							refDataBlock = imgUtils.getImageDataBlock(referenceIMG, dsOffsets[0], overlapWidth, overlapHeight, &numRefDataVals);
-							floatDataBlock = imgUtils.getImageDataBlock(floatingIMG, dsOffsets[1], overlapWidth, overlapHeight, &numFloatDataVals);
-							
-							if(numRefDataVals != numFloatDataVals)
-							{
-								throw RSGISRegistrationException("The number of data values read from the images does not match.");
-							}
-							
-							metricVal = metric->calcValue(refDataBlock, floatDataBlock, numRefDataVals, overlap->numRefBands);
-							
-							imageSimilarity[yIdx][xIdx] = metricVal;
-							
-							if(!((boost::math::isnan)(metricVal)))
-							{
-								if(first)
-								{
-									currentMetricVal = metricVal;
-									currentShiftX = xShift;
-									currentShiftY = yShift;
-									currentXIdx = xIdx;
-									currentYIdx = yIdx;
-                                    currentRemainderX = remainderX;
-                                    currentRemainderY = remainderY;
-									first = false;
-								}
-								else if(metric->findMin() & (metricVal < currentMetricVal))
-								{
-									currentMetricVal = metricVal;
-									currentShiftX = xShift;
-									currentShiftY = yShift;
-									currentXIdx = xIdx;
-									currentYIdx = yIdx;
-                                    currentRemainderX = remainderX;
-                                    currentRemainderY = remainderY;
-								}
-								else if(!metric->findMin() & (metricVal > currentMetricVal))
-								{
-									currentMetricVal = metricVal;
-									currentShiftX = xShift;
-									currentShiftY = yShift;
-									currentXIdx = xIdx;
-									currentYIdx = yIdx;
-                                    currentRemainderX = remainderX;
-                                    currentRemainderY = remainderY;
-								}
-							}
-							
-							for(unsigned int i = 0; i < overlap->numRefBands; ++i)
-							{
-								delete[] refDataBlock[i];
-								delete[] floatDataBlock[i];
-							}
-							delete[] refDataBlock;
-							delete[] floatDataBlock;
-						}
-					}
-					catch (RSGISRegistrationException &e) 
-					{
-						// ignore
-						std::cerr << "Tie Point = [" << tiePt->xRef << "," << tiePt->yRef << "]\n";
-						std::cerr << "Shift = [" << (xShift+tiePt->xShift) << "," << (yShift+tiePt->yShift) << "]\n";
-						std::cerr << "WARNING: " << e.what() << std::endl;
-					}
-					xIdx++;
-				}
-				++yIdx;
+				currentShiftX = ((int)currentXIdx) - ((int)searchArea);
+				currentShiftY = ((int)currentYIdx) - ((int)searchArea);
 			}
 			
 			float subPixelXShift = 0;
@@ -394,10 +298,12 @@ namespace rsgis{namespace reg{
 			}
 			
 			
-			delete[] overlapTransform;
-			delete[] dsOffsets[0];
-			delete[] dsOffsets[1];
-			delete[] dsOffsets;
+			for(unsigned int i = 0; i < numSearchPoints; ++i)
+			{
+				delete[] imageSimilarity[i];
+			}
+			delete[] imageSimilarity;
+			delete env;
 		}
 		catch (rsgis::img::RSGISImageBandException &e) 
 		{
@@ -411,7 +317,7 @@ namespace rsgis{namespace reg{
 		return distanceMoved;
 	}
     
-    float RSGISImageRegistration::findTiePointLocation(TiePoint *tiePt, unsigned int windowSize, unsigned int searchArea, RSGISImageSimilarityMetric *metric, unsigned int subPixelResolution, float *moveInX, float *moveInY)
+    float RSGISImageRegistration::findTiePointLocation(TiePoint *tiePt, unsigned int windowSize, unsigned int searchArea, RSGISImageSimilarityMetric *metric, unsigned int subPixelResolution, float *moveInX, float *moveInY, unsigned int threadIdx)
 	{
 		float distanceMoved = 0;
 		
@@ -420,17 +326,8 @@ namespace rsgis{namespace reg{
 			throw RSGISRegistrationException("The overlap needs to be defined before tie location can be defined.");
 		}
 		
-		rsgis::img::RSGISImageUtils imgUtils;
 		try
 		{
-			// Setup overlapping region variables.
-			int **dsOffsets = new int*[2];
-			dsOffsets[0] = new int[2];
-			dsOffsets[1] = new int[2];
-			int overlapWidth = 0;
-			int overlapHeight = 0;
-			double *overlapTransform = new double[6];
-			
 			double windowXWidth = (((double)windowSize)*overlap->xRes);
 			double windowYHeight = (((double)windowSize)*overlap->yRes);
 			
@@ -447,114 +344,19 @@ namespace rsgis{namespace reg{
 				imageSimilarity[i] = new float[numSearchPoints];
 			}
 			
-			int xShiftStart = searchArea * (-1);
-			int yShiftStart = searchArea * (-1);
-			int xShiftEnd = searchArea;
-			int yShiftEnd = searchArea;
-			
-			float **refDataBlock = NULL;
-			float **floatDataBlock = NULL;
-			unsigned int numRefDataVals = 0;
-			unsigned int numFloatDataVals = 0;
-			
-			bool first = true;
 			double currentMetricVal = 0;
-			double metricVal = 0;
-			int currentShiftX = 0;
-			int currentShiftY = 0;
-			
-			unsigned int xIdx = 0;
-			unsigned int yIdx = 0;
 			unsigned int currentXIdx = 0;
 			unsigned int currentYIdx = 0;
-            
-            // Set up variables to hold remainder from image overlap
-            float remainderX = 0;
-            float remainderY = 0;
+			int currentShiftX = 0;
+			int currentShiftY = 0;
             // Remainder for heighest metric
             float currentRemainderX = 0;
             float currentRemainderY = 0;
 			
-			for(int yShift = yShiftStart; yShift <= yShiftEnd; ++yShift)
+			if(this->calcSearchAreaSimilarity(this->getThreadReferenceDataset(threadIdx), this->getThreadFloatingDataset(threadIdx), tiePt, env, searchArea, metric, imageSimilarity, &currentXIdx, &currentYIdx, &currentMetricVal, &currentRemainderX, &currentRemainderY))
 			{
-				xIdx = 0;
-				for(int xShift = xShiftStart; xShift <= xShiftEnd; ++xShift)
-				{
-					try
-					{
-						this->getImageOverlapWithFloatShift((((float)xShift)+tiePt->xShift), (((float)yShift)+tiePt->yShift), dsOffsets, &overlapWidth, &overlapHeight, overlapTransform, env, &remainderX, &remainderY);
-						
-						if((overlapWidth > 0) & (overlapHeight > 0))
-						{
-							numRefDataVals = 0;
-							numFloatDataVals = 0;
-							
-							refDataBlock = imgUtils.getImageDataBlock(referenceIMG, dsOffsets[0], overlapWidth, overlapHeight, &numRefDataVals);
-							floatDataBlock = imgUtils.getImageDataBlock(floatingIMG, dsOffsets[1], overlapWidth, overlapHeight, &numFloatDataVals);
-							
-							if(numRefDataVals != numFloatDataVals)
-							{
-								throw RSGISRegistrationException("The number of data values read from the images does not match.");
-							}
-							
-							metricVal = metric->calcValue(refDataBlock, floatDataBlock, numRefDataVals, overlap->numRefBands);
-							
-							imageSimilarity[yIdx][xIdx] = metricVal;
-							
-							if(!((boost::math::isnan)(metricVal)))
-							{
-								if(first)
-								{
-									currentMetricVal = metricVal;
-									currentShiftX = xShift;
-									currentShiftY = yShift;
-									currentXIdx = xIdx;
-									currentYIdx = yIdx;
-                                    currentRemainderX = remainderX;
-                                    currentRemainderY = remainderY;
-									first = false;
-								}
-								else if(metric->findMin() & (metricVal < currentMetricVal))
-								{
-									currentMetricVal = metricVal;
-									currentShiftX = xShift;
-									currentShiftY = yShift;
-									currentXIdx = xIdx;
-									currentYIdx = yIdx;
-                                    currentRemainderX = remainderX;
-                                    currentRemainderY = remainderY;
-								}
-								else if(!metric->findMin() & (metricVal > currentMetricVal))
-								{
-									currentMetricVal = metricVal;
-									currentShiftX = xShift;
-									currentShiftY = yShift;
-									currentXIdx = xIdx;
-									currentYIdx = yIdx;
-                                    currentRemainderX = remainderX;
-                                    currentRemainderY = remainderY;
-								}
-							}
-							
-							for(unsigned int i = 0; i < overlap->numRefBands; ++i)
-							{
-								delete[] refDataBlock[i];
-								delete[] floatDataBlock[i];
-							}
-							delete[] refDataBlock;
-							delete[] floatDataBlock;
-						}
-					}
-					catch (RSGISRegistrationException &e)
-					{
-						// ignore
-						std::cerr << "Tie Point = [" << tiePt->xRef << "," << tiePt->yRef << "]\n";
-						std::cerr << "Shift = [" << (xShift+tiePt->xShift) << "," << (yShift+tiePt->yShift) << "]\n";
-						std::cerr << "WARNING: " << e.what() << std::endl;
-					}
-					xIdx++;
-				}
-				++yIdx;
+				currentShiftX = ((int)currentXIdx) - ((int)searchArea);
+				currentShiftY = ((int)currentYIdx) - ((int)searchArea);
 			}
 			
 			float subPixelXShift = 0;
@@ -671,10 +473,12 @@ namespace rsgis{namespace reg{
             tiePt->yShift += finalYShift;
             tiePt->metricVal = currentMetricVal;
 			
-			delete[] overlapTransform;
-			delete[] dsOffsets[0];
-			delete[] dsOffsets[1];
-			delete[] dsOffsets;
+			for(unsigned int i = 0; i < numSearchPoints; ++i)
+			{
+				delete[] imageSimilarity[i];
+			}
+			delete[] imageSimilarity;
+			delete env;
 		}
 		catch (rsgis::img::RSGISImageBandException &e)
 		{
@@ -688,6 +492,472 @@ namespace rsgis{namespace reg{
 		return distanceMoved;
 	}
 	
+	bool RSGISImageRegistration::calcSearchAreaSimilarity(GDALDataset *refDataset, GDALDataset *floatDataset, TiePoint *tiePt, geos::geom::Envelope *env, unsigned int searchArea, RSGISImageSimilarityMetric *metric, float **imageSimilarity, unsigned int *bestXIdx, unsigned int *bestYIdx, double *bestMetricVal, float *bestRemainderX, float *bestRemainderY)
+	{
+		unsigned int numSearchPoints = (searchArea*2)+1;
+		int shiftStart = searchArea * (-1);
+		
+		*bestXIdx = 0;
+		*bestYIdx = 0;
+		*bestMetricVal = 0;
+		*bestRemainderX = 0;
+		*bestRemainderY = 0;
+		
+		int **dsOffsets = new int*[2];
+		dsOffsets[0] = new int[2];
+		dsOffsets[1] = new int[2];
+		int overlapWidth = 0;
+		int overlapHeight = 0;
+		double *overlapTransform = new double[6];
+		float remainderX = 0;
+		float remainderY = 0;
+		
+		// Find the region of each image compared for each shift and the
+		// extent of those regions so they can be read in a single pass.
+		SearchShift *shifts = new SearchShift[numSearchPoints*numSearchPoints];
+		bool anyValid = false;
+		int refMinX = 0;
+		int refMinY = 0;
+		int refMaxX = 0;
+		int refMaxY = 0;
+		int floatMinX = 0;
+		int floatMinY = 0;
+		int floatMaxX = 0;
+		int floatMaxY = 0;
+		unsigned long maxNumVals = 0;
+		unsigned int idx = 0;
+		for(unsigned int yIdx = 0; yIdx < numSearchPoints; ++yIdx)
+		{
+			int yShift = shiftStart + ((int)yIdx);
+			for(unsigned int xIdx = 0; xIdx < numSearchPoints; ++xIdx)
+			{
+				int xShift = shiftStart + ((int)xIdx);
+				idx = (yIdx * numSearchPoints) + xIdx;
+				shifts[idx].valid = false;
+				shifts[idx].evaluated = false;
+				imageSimilarity[yIdx][xIdx] = std::numeric_limits<float>::quiet_NaN();
+				try
+				{
+					this->getImageOverlapWithFloatShift((((float)xShift)+tiePt->xShift), (((float)yShift)+tiePt->yShift), dsOffsets, &overlapWidth, &overlapHeight, overlapTransform, env, &remainderX, &remainderY);
+					
+					if((overlapWidth > 0) & (overlapHeight > 0))
+					{
+						shifts[idx].valid = true;
+						shifts[idx].refOffX = dsOffsets[0][0];
+						shifts[idx].refOffY = dsOffsets[0][1];
+						shifts[idx].floatOffX = dsOffsets[1][0];
+						shifts[idx].floatOffY = dsOffsets[1][1];
+						shifts[idx].width = overlapWidth;
+						shifts[idx].height = overlapHeight;
+						shifts[idx].remainderX = remainderX;
+						shifts[idx].remainderY = remainderY;
+						
+						if(!anyValid)
+						{
+							refMinX = dsOffsets[0][0];
+							refMinY = dsOffsets[0][1];
+							refMaxX = dsOffsets[0][0] + overlapWidth;
+							refMaxY = dsOffsets[0][1] + overlapHeight;
+							floatMinX = dsOffsets[1][0];
+							floatMinY = dsOffsets[1][1];
+							floatMaxX = dsOffsets[1][0] + overlapWidth;
+							floatMaxY = dsOffsets[1][1] + overlapHeight;
+							anyValid = true;
+						}
+						else
+						{
+							refMinX = std::min(refMinX, dsOffsets[0][0]);
+							refMinY = std::min(refMinY, dsOffsets[0][1]);
+							refMaxX = std::max(refMaxX, dsOffsets[0][0] + overlapWidth);
+							refMaxY = std::max(refMaxY, dsOffsets[0][1] + overlapHeight);
+							floatMinX = std::min(floatMinX, dsOffsets[1][0]);
+							floatMinY = std::min(floatMinY, dsOffsets[1][1]);
+							floatMaxX = std::max(floatMaxX, dsOffsets[1][0] + overlapWidth);
+							floatMaxY = std::max(floatMaxY, dsOffsets[1][1] + overlapHeight);
+						}
+						if((((unsigned long)overlapWidth)*overlapHeight) > maxNumVals)
+						{
+							maxNumVals = ((unsigned long)overlapWidth)*overlapHeight;
+						}
+					}
+				}
+				catch (RSGISRegistrationException &e)
+				{
+					// ignore
+					std::cerr << "Tie Point = [" << tiePt->xRef << "," << tiePt->yRef << "]\n";
+					std::cerr << "Shift = [" << (xShift+tiePt->xShift) << "," << (yShift+tiePt->yShift) << "]\n";
+					std::cerr << "WARNING: " << e.what() << std::endl;
+				}
+			}
+		}
+		
+		delete[] overlapTransform;
+		delete[] dsOffsets[0];
+		delete[] dsOffsets[1];
+		delete[] dsOffsets;
+		
+		if(!anyValid)
+		{
+			delete[] shifts;
+			return false;
+		}
+		
+		ImageWindow *refWindow = NULL;
+		ImageWindow *floatWindow = NULL;
+		float **refDataBlock = NULL;
+		float **floatDataBlock = NULL;
+		bool first = true;
+		try
+		{
+			refWindow = this->readImageWindow(refDataset, refMinX, refMinY, (refMaxX-refMinX), (refMaxY-refMinY), overlap->numRefBands);
+			floatWindow = this->readImageWindow(floatDataset, floatMinX, floatMinY, (floatMaxX-floatMinX), (floatMaxY-floatMinY), overlap->numRefBands);
+			
+			refDataBlock = new float*[overlap->numRefBands];
+			floatDataBlock = new float*[overlap->numRefBands];
+			for(unsigned int i = 0; i < overlap->numRefBands; ++i)
+			{
+				refDataBlock[i] = new float[maxNumVals];
+				floatDataBlock[i] = new float[maxNumVals];
+			}
+			
+			// Either calculate the metric for every shift or, when a coarse shift can be
+			// estimated, for the neighbourhood of the best shift until it stops moving.
+			int neighbourhood = (searchArea == 1)?1:2;
+			int coarseXShift = 0;
+			int coarseYShift = 0;
+			bool localSearch = false;
+			if(this->useFFTCoarseShift & (((int)searchArea) > neighbourhood))
+			{
+				localSearch = this->estimateCoarseShift(&shifts[(searchArea * numSearchPoints) + searchArea], refWindow, floatWindow, searchArea, &coarseXShift, &coarseYShift);
+			}
+			int centreXIdx = coarseXShift + ((int)searchArea);
+			int centreYIdx = coarseYShift + ((int)searchArea);
+			
+			bool searchComplete = false;
+			while(!searchComplete)
+			{
+				int xIdxStart = 0;
+				int xIdxEnd = numSearchPoints-1;
+				int yIdxStart = 0;
+				int yIdxEnd = numSearchPoints-1;
+				if(localSearch)
+				{
+					xIdxStart = std::max(0, centreXIdx-neighbourhood);
+					xIdxEnd = std::min(((int)numSearchPoints)-1, centreXIdx+neighbourhood);
+					yIdxStart = std::max(0, centreYIdx-neighbourhood);
+					yIdxEnd = std::min(((int)numSearchPoints)-1, centreYIdx+neighbourhood);
+				}
+				
+				for(int yIdx = yIdxStart; yIdx <= yIdxEnd; ++yIdx)
+				{
+					for(int xIdx = xIdxStart; xIdx <= xIdxEnd; ++xIdx)
+					{
+						SearchShift *shift = &shifts[(yIdx * numSearchPoints) + xIdx];
+						if(shift->valid & (!shift->evaluated))
+						{
+							this->copyImageWindowBlock(refWindow, shift->refOffX, shift->refOffY, shift->width, shift->height, refDataBlock);
+							this->copyImageWindowBlock(floatWindow, shift->floatOffX, shift->floatOffY, shift->width, shift->height, floatDataBlock);
+							imageSimilarity[yIdx][xIdx] = metric->calcValue(refDataBlock, floatDataBlock, (shift->width*shift->height), overlap->numRefBands);
+							shift->evaluated = true;
+						}
+					}
+				}
+				
+				// Find the best shift, in the same order as the search area is scanned.
+				first = true;
+				double metricVal = 0;
+				for(unsigned int yIdx = 0; yIdx < numSearchPoints; ++yIdx)
+				{
+					for(unsigned int xIdx = 0; xIdx < numSearchPoints; ++xIdx)
+					{
+						SearchShift *shift = &shifts[(yIdx * numSearchPoints) + xIdx];
+						metricVal = imageSimilarity[yIdx][xIdx];
+						if(shift->evaluated && (!((boost::math::isnan)(metricVal))))
+						{
+							if(first || (metric->findMin() & (metricVal < *bestMetricVal)) || (!metric->findMin() & (metricVal > *bestMetricVal)))
+							{
+								*bestMetricVal = metricVal;
+								*bestXIdx = xIdx;
+								*bestYIdx = yIdx;
+								*bestRemainderX = shift->remainderX;
+								*bestRemainderY = shift->remainderY;
+								first = false;
+							}
+						}
+					}
+				}
+				
+				searchComplete = true;
+				if(localSearch && (!first) && ((((int)*bestXIdx) != centreXIdx) | (((int)*bestYIdx) != centreYIdx)))
+				{
+					centreXIdx = *bestXIdx;
+					centreYIdx = *bestYIdx;
+					searchComplete = false;
+				}
+			}
+		}
+		catch (RSGISRegistrationException &e)
+		{
+			if(refDataBlock != NULL)
+			{
+				for(unsigned int i = 0; i < overlap->numRefBands; ++i)
+				{
+					delete[] refDataBlock[i];
+					delete[] floatDataBlock[i];
+				}
+				delete[] refDataBlock;
+				delete[] floatDataBlock;
+			}
+			this->deleteImageWindow(refWindow);
+			this->deleteImageWindow(floatWindow);
+			delete[] shifts;
+			throw e;
+		}
+		
+		for(unsigned int i = 0; i < overlap->numRefBands; ++i)
+		{
+			delete[] refDataBlock[i];
+			delete[] floatDataBlock[i];
+		}
+		delete[] refDataBlock;
+		delete[] floatDataBlock;
+		this->deleteImageWindow(refWindow);
+		this->deleteImageWindow(floatWindow);
+		delete[] shifts;
+		
+		return !first;
+	}
+	
+	bool RSGISImageRegistration::estimateCoarseShift(SearchShift *centre, ImageWindow *refWindow, ImageWindow *floatWindow, unsigned int searchArea, int *xShift, int *yShift)
+	{
+		*xShift = 0;
+		*yShift = 0;
+		if(!centre->valid)
+		{
+			return false;
+		}
+		
+		// The reference window (without a shift) is placed in the centre of a frame
+		// and correlated with the floating image covering the whole search area.
+		int border = searchArea;
+		unsigned int frameWidth = rsgis::math::RSGISFFTWUtils::nextPowerOf2(centre->width + (2*border));
+		unsigned int frameHeight = rsgis::math::RSGISFFTWUtils::nextPowerOf2(centre->height + (2*border));
+		unsigned long numFrameVals = ((unsigned long)frameWidth)*frameHeight;
+		float *refFrame = new float[numFrameVals];
+		float *floatFrame = new float[numFrameVals];
+		
+		// Fill each frame with the mean of the bands.
+		double refSum = 0;
+		unsigned long refCount = 0;
+		double floatSum = 0;
+		unsigned long floatCount = 0;
+		for(unsigned long i = 0; i < numFrameVals; ++i)
+		{
+			refFrame[i] = std::numeric_limits<float>::quiet_NaN();
+			floatFrame[i] = std::numeric_limits<float>::quiet_NaN();
+		}
+		int imgX = 0;
+		int imgY = 0;
+		for(int y = 0; y < (centre->height + (2*border)); ++y)
+		{
+			for(int x = 0; x < (centre->width + (2*border)); ++x)
+			{
+				unsigned long frameIdx = (((unsigned long)y)*frameWidth)+x;
+				if((x >= border) & (x < (centre->width+border)) & (y >= border) & (y < (centre->height+border)))
+				{
+					imgX = centre->refOffX + (x - border) - refWindow->xOff;
+					imgY = centre->refOffY + (y - border) - refWindow->yOff;
+					if((imgX >= 0) & (imgX < refWindow->width) & (imgY >= 0) & (imgY < refWindow->height))
+					{
+						refFrame[frameIdx] = 0;
+						for(unsigned int n = 0; n < refWindow->numBands; ++n)
+						{
+							refFrame[frameIdx] += refWindow->data[n][(imgY*refWindow->width)+imgX];
+						}
+						refFrame[frameIdx] /= refWindow->numBands;
+						refSum += refFrame[frameIdx];
+						++refCount;
+					}
+				}
+				
+				imgX = centre->floatOffX + (x - border) - floatWindow->xOff;
+				imgY = centre->floatOffY + (y - border) - floatWindow->yOff;
+				if((imgX >= 0) & (imgX < floatWindow->width) & (imgY >= 0) & (imgY < floatWindow->height))
+				{
+					floatFrame[frameIdx] = 0;
+					for(unsigned int n = 0; n < floatWindow->numBands; ++n)
+					{
+						floatFrame[frameIdx] += floatWindow->data[n][(imgY*floatWindow->width)+imgX];
+					}
+					floatFrame[frameIdx] /= floatWindow->numBands;
+					floatSum += floatFrame[frameIdx];
+					++floatCount;
+				}
+			}
+		}
+		
+		if((refCount == 0) | (floatCount == 0))
+		{
+			delete[] refFrame;
+			delete[] floatFrame;
+			return false;
+		}
+		
+		// Remove the mean so the padding does not contribute to the correlation.
+		float refMean = refSum / refCount;
+		float floatMean = floatSum / floatCount;
+		for(unsigned long i = 0; i < numFrameVals; ++i)
+		{
+			refFrame[i] = (boost::math::isnan)(refFrame[i])?0:(refFrame[i] - refMean);
+			floatFrame[i] = (boost::math::isnan)(floatFrame[i])?0:(floatFrame[i] - floatMean);
+		}
+		
+		rsgis::math::RSGISFFTWUtils fftUtils;
+		double *surface = fftUtils.phaseCorrelation(refFrame, floatFrame, frameWidth, frameHeight);
+		fftUtils.findCorrelationPeak(surface, frameWidth, frameHeight, searchArea, searchArea, xShift, yShift);
+		
+		delete[] surface;
+		delete[] refFrame;
+		delete[] floatFrame;
+		
+		return true;
+	}
+	
+	RSGISImageRegistration::ImageWindow* RSGISImageRegistration::readImageWindow(GDALDataset *dataset, int xOff, int yOff, int width, int height, unsigned int numBands)
+	{
+		if(((unsigned int)dataset->GetRasterCount()) < numBands)
+		{
+			throw RSGISRegistrationException("The image does not have enough image bands.");
+		}
+		
+		ImageWindow *window = new ImageWindow();
+		window->xOff = xOff;
+		window->yOff = yOff;
+		window->width = width;
+		window->height = height;
+		window->numBands = numBands;
+		window->data = new float*[numBands];
+		
+		// Only read the part of the window within the image, the rest is zero.
+		int readXOff = std::max(xOff, 0);
+		int readYOff = std::max(yOff, 0);
+		int readXEnd = std::min(xOff+width, dataset->GetRasterXSize());
+		int readYEnd = std::min(yOff+height, dataset->GetRasterYSize());
+		
+		unsigned long numVals = ((unsigned long)width)*height;
+		for(unsigned int n = 0; n < numBands; ++n)
+		{
+			window->data[n] = new float[numVals];
+			for(unsigned long i = 0; i < numVals; ++i)
+			{
+				window->data[n][i] = 0;
+			}
+			
+			if((readXEnd > readXOff) & (readYEnd > readYOff))
+			{
+				float *dataStart = &window->data[n][(((unsigned long)(readYOff-yOff))*width)+(readXOff-xOff)];
+				if(dataset->GetRasterBand(n+1)->RasterIO(GF_Read, readXOff, readYOff, (readXEnd-readXOff), (readYEnd-readYOff), dataStart, (readXEnd-readXOff), (readYEnd-readYOff), GDT_Float32, 0, (sizeof(float)*width)) != CE_None)
+				{
+					this->deleteImageWindow(window);
+					throw RSGISRegistrationException("Could not read the image data for the tie point search area.");
+				}
+			}
+		}
+		
+		return window;
+	}
+	
+	void RSGISImageRegistration::copyImageWindowBlock(ImageWindow *window, int xOff, int yOff, int width, int height, float **dataBlock)
+	{
+		// Same layout as RSGISImageUtils::getImageDataBlock
+		unsigned long outIdx = 0;
+		unsigned long inIdx = 0;
+		for(int y = 0; y < height; ++y)
+		{
+			inIdx = (((unsigned long)(yOff - window->yOff + y))*window->width) + (xOff - window->xOff);
+			for(unsigned int n = 0; n < window->numBands; ++n)
+			{
+				std::copy(&window->data[n][inIdx], &window->data[n][inIdx+width], &dataBlock[n][outIdx]);
+			}
+			outIdx += width;
+		}
+	}
+	
+	void RSGISImageRegistration::deleteImageWindow(ImageWindow *window)
+	{
+		if(window != NULL)
+		{
+			for(unsigned int n = 0; n < window->numBands; ++n)
+			{
+				delete[] window->data[n];
+			}
+			delete[] window->data;
+			delete window;
+		}
+	}
+	
+	void RSGISImageRegistration::openThreadDatasets(unsigned int numThreads)
+	{
+		this->closeThreadDatasets();
+		
+		// The first thread uses the datasets provided to the constructor.
+		this->threadRefIMGs.push_back(referenceIMG);
+		this->threadFloatIMGs.push_back(floatingIMG);
+		GDALDataset *dataset = NULL;
+		for(unsigned int i = 1; i < numThreads; ++i)
+		{
+			dataset = (GDALDataset *) GDALOpen(referenceIMG->GetDescription(), GA_ReadOnly);
+			if(dataset == NULL)
+			{
+				this->closeThreadDatasets();
+				std::string message = std::string("Could not open image ") + referenceIMG->GetDescription() + std::string(" for each thread.");
+				throw RSGISRegistrationException(message.c_str());
+			}
+			this->threadRefIMGs.push_back(dataset);
+			
+			dataset = (GDALDataset *) GDALOpen(floatingIMG->GetDescription(), GA_ReadOnly);
+			if(dataset == NULL)
+			{
+				this->closeThreadDatasets();
+				std::string message = std::string("Could not open image ") + floatingIMG->GetDescription() + std::string(" for each thread.");
+				throw RSGISRegistrationException(message.c_str());
+			}
+			this->threadFloatIMGs.push_back(dataset);
+		}
+	}
+	
+	void RSGISImageRegistration::closeThreadDatasets()
+	{
+		for(size_t i = 1; i < this->threadRefIMGs.size(); ++i)
+		{
+			GDALClose(this->threadRefIMGs.at(i));
+		}
+		for(size_t i = 1; i < this->threadFloatIMGs.size(); ++i)
+		{
+			GDALClose(this->threadFloatIMGs.at(i));
+		}
+		this->threadRefIMGs.clear();
+		this->threadFloatIMGs.clear();
+	}
+	
+	GDALDataset* RSGISImageRegistration::getThreadReferenceDataset(unsigned int threadIdx)
+	{
+		if(threadIdx < this->threadRefIMGs.size())
+		{
+			return this->threadRefIMGs.at(threadIdx);
+		}
+		return referenceIMG;
+	}
+	
+	GDALDataset* RSGISImageRegistration::getThreadFloatingDataset(unsigned int threadIdx)
+	{
+		if(threadIdx < this->threadFloatIMGs.size())
+		{
+			return this->threadFloatIMGs.at(threadIdx);
+		}
+		return floatingIMG;
+	}
+	
 	float RSGISImageRegistration::findExtreme(bool findMin, gsl_vector *coefficients, unsigned int order, float minRange, float maxRange, unsigned int resolution, float *extremeVal)
 	{
 		double division = ((float)1)/((float)resolution);
@@ -1036,13 +1306,15 @@ namespace rsgis{namespace reg{
 		try 
 		{
 			// Find transformations
-			referenceIMG->GetGeoTransform(refTransform);
-			int refSizeX = referenceIMG->GetRasterXSize();
-			int refSizeY = referenceIMG->GetRasterYSize();
-			
-			floatingIMG->GetGeoTransform(floatTransform);
-			int floatSizeX = floatingIMG->GetRasterXSize();
-			int floatSizeY = floatingIMG->GetRasterYSize();
+			for(int i = 0; i < 6; ++i)
+			{
+				refTransform[i] = this->refGeoTransform[i];
+				floatTransform[i] = this->floatGeoTransform[i];
+			}
+			int refSizeX = this->refSizeX;
+			int refSizeY = this->refSizeY;
+			int floatSizeX = this->floatSizeX;
+			int floatSizeY = this->floatSizeY;
 			
 			// Apply Shift
 			floatTransform[0] += (((float)xShift)*overlap->xRes);
@@ -1485,10 +1757,13 @@ namespace rsgis{namespace reg{
 	
 	RSGISImageRegistration::~RSGISImageRegistration()
 	{
+		this->closeThreadDatasets();
 		if(overlap != NULL)
 		{
 			delete overlap;
 		}
+		delete[] this->refGeoTransform;
+		delete[] this->floatGeoTransform;
 	}
 	
 
@@ -30,6 +30,9 @@
 #include <string>
 #include <math.h>
 #include <list>
+#include <vector>
+#include <limits>
+#include <algorithm>
 
 #include "gdal_priv.h"
 #include "ogrsf_frmts.h"
@@ -42,6 +45,7 @@
 #include "img/RSGISImageUtils.h"
 
 #include "math/RSGISPolyFit.h"
+#include "math/RSGISFFTWUtils.h"
 
 #include "boost/math/special_functions/fpclassify.hpp"
 
@@ -138,6 +142,12 @@ namespace rsgis{namespace reg{
 		
 		RSGISImageRegistration(GDALDataset *reference, GDALDataset *floating);
 		void runCompleteRegistration();
+		/**
+		 * When set the shift of each tie point is first estimated using phase correlation
+		 * and the similarity metric is then only calculated for the shifts around the
+		 * best match (rather than the whole search area) before sub-pixel refinement.
+		 */
+		void setCoarseShiftEstimation(bool useFFT){this->useFFTCoarseShift = useFFT;};
 		virtual void initRegistration()=0;
 		virtual void executeRegistration()=0;
 		virtual void finaliseRegistration()=0;
@@ -147,10 +157,48 @@ namespace rsgis{namespace reg{
         virtual void exportTiePointsRSGISMapOffs(std::string filepath)=0;
 		virtual ~RSGISImageRegistration();
 	protected:
+		/** A region of an image read into memory, one row-major array per band. */
+		struct DllExport ImageWindow
+		{
+			int xOff;
+			int yOff;
+			int width;
+			int height;
+			unsigned int numBands;
+			float **data;
+		};
+		
+		/** The region of each image compared for a shift within the search area. */
+		struct DllExport SearchShift
+		{
+			bool valid;
+			bool evaluated;
+			int refOffX;
+			int refOffY;
+			int floatOffX;
+			int floatOffY;
+			int width;
+			int height;
+			float remainderX;
+			float remainderY;
+		};
+		
+
 		void findOverlap();
 		void defineFirstTiePoint(unsigned int *startXOff, unsigned int *startYOff, unsigned int numXPts, unsigned int numYPts, unsigned int gap);
-		float findTiePointLocation(TiePoint *tiePt, unsigned int windowSize, unsigned int searchArea, RSGISImageSimilarityMetric *metric, float metricThreshold, unsigned int subPixelResolution, float *moveInX, float *moveInY);
-        float findTiePointLocation(TiePoint *tiePt, unsigned int windowSize, unsigned int searchArea, RSGISImageSimilarityMetric *metric, unsigned int subPixelResolution, float *moveInX, float *moveInY);
+		/** Finds the shift of the tie point; threadIdx selects the datasets opened by openThreadDatasets. */
+		float findTiePointLocation(TiePoint *tiePt, unsigned int windowSize, unsigned int searchArea, RSGISImageSimilarityMetric *metric, float metricThreshold, unsigned int subPixelResolution, float *moveInX, float *moveInY, unsigned int threadIdx=0);
+        float findTiePointLocation(TiePoint *tiePt, unsigned int windowSize, unsigned int searchArea, RSGISImageSimilarityMetric *metric, unsigned int subPixelResolution, float *moveInX, float *moveInY, unsigned int threadIdx=0);
+		bool calcSearchAreaSimilarity(GDALDataset *refDataset, GDALDataset *floatDataset, TiePoint *tiePt, geos::geom::Envelope *env, unsigned int searchArea, RSGISImageSimilarityMetric *metric, float **imageSimilarity, unsigned int *bestXIdx, unsigned int *bestYIdx, double *bestMetricVal, float *bestRemainderX, float *bestRemainderY);
+		bool estimateCoarseShift(SearchShift *centre, ImageWindow *refWindow, ImageWindow *floatWindow, unsigned int searchArea, int *xShift, int *yShift);
+		ImageWindow* readImageWindow(GDALDataset *dataset, int xOff, int yOff, int width, int height, unsigned int numBands);
+		void copyImageWindowBlock(ImageWindow *window, int xOff, int yOff, int width, int height, float **dataBlock);
+		void deleteImageWindow(ImageWindow *window);
+		/** Opens a read-only handle on each image for every thread, as GDAL datasets cannot be shared between threads. */
+		void openThreadDatasets(unsigned int numThreads);
+		void closeThreadDatasets();
+		GDALDataset* getThreadReferenceDataset(unsigned int threadIdx);
+		GDALDataset* getThreadFloatingDataset(unsigned int threadIdx);
 		float findExtreme(bool findMin, gsl_vector *coefficients, unsigned int order, float minRange, float maxRange, unsigned int resolution, float *extremeVal);
         void getImageOverlapFloat(GDALDataset **datasets, int numDS,  float **dsOffsets, int *width, int *height, double *gdalTransform);
 		void getImageOverlapWithFloatShift(float xShift, float yShift, int **dsOffsets, int *width, int *height, double *gdalTransform, geos::geom::Envelope *env, float *remainderX, float *remainderY);
@@ -164,6 +212,15 @@ namespace rsgis{namespace reg{
 		GDALDataset *floatingIMG;
 		OverlapRegion* overlap;
 		bool overlapDefined;
+		bool useFFTCoarseShift;
+		double *refGeoTransform;
+		double *floatGeoTransform;
+		int refSizeX;
+		int refSizeY;
+		int floatSizeX;
+		int floatSizeY;
+		std::vector<GDALDataset*> threadRefIMGs;
+		std::vector<GDALDataset*> threadFloatIMGs;
 	};
 }}
 
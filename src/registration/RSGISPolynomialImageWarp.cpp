@@ -28,7 +28,7 @@
 namespace rsgis{namespace reg{
 	
 	
-	RSGISPolynomialImageWarp::RSGISPolynomialImageWarp(std::string inputImage, std::string outputImage, std::string outProjWKT, std::string gcpFilePath, float outImgRes, RSGISWarpImageInterpolator *interpolator, unsigned int polyOrder, std::string gdalFormat) : RSGISWarpImage(inputImage, outputImage, outProjWKT, gcpFilePath, outImgRes, interpolator, gdalFormat)
+	RSGISPolynomialImageWarp::RSGISPolynomialImageWarp(std::string inputImage, std::string outputImage, std::string outProjWKT, std::string gcpFilePath, float outImgRes, RSGISWarpImageInterpolator *interpolator, unsigned int polyOrder, std::string gdalFormat, unsigned int numThreads, double maxTransformError) : RSGISWarpImage(inputImage, outputImage, outProjWKT, gcpFilePath, outImgRes, interpolator, gdalFormat, numThreads, maxTransformError)
 	{
 		this->polyOrder = polyOrder;
         std::cout << "polyOrder = " << polyOrder << std::endl;
@@ -223,7 +223,7 @@ namespace rsgis{namespace reg{
 		return env;
 	}
 	
-	void RSGISPolynomialImageWarp::findNearestPixel(double eastings, double northings, unsigned int *x, unsigned int *y, float inImgRes)
+	void RSGISPolynomialImageWarp::findPixelLocation(double eastings, double northings, double *x, double *y, float inImgRes)
 	{
 		
         /* Return nearest pixel based on input easting and northing.
@@ -256,9 +256,15 @@ namespace rsgis{namespace reg{
         pY = pY + (gsl_vector_get(aY, offset) * pow(eastings, this->polyOrder));
         pY = pY + (gsl_vector_get(aY, offset+1) * pow(northings, this->polyOrder));
     
-        *x = ceil(pX);
-		*y = ceil(pY);
+        *x = pX;
+		*y = pY;
 	}
+    
+    void RSGISPolynomialImageWarp::pixelLocationToPixel(double x, double y, long *xPxl, long *yPxl)
+    {
+        *xPxl = ceil(x);
+        *yPxl = ceil(y);
+    }
 		
 	RSGISPolynomialImageWarp::~RSGISPolynomialImageWarp()
 	{
@@ -62,12 +62,13 @@ namespace rsgis{namespace reg{
 	class DllExport RSGISPolynomialImageWarp : public RSGISWarpImage
 	{
 	public:
-		RSGISPolynomialImageWarp(std::string inputImage, std::string outputImage, std::string outProjWKT, std::string gcpFilePath, float outImgRes, RSGISWarpImageInterpolator *interpolator, unsigned int polyOrder = 2, std::string gdalFormat = "ENVI");
+		RSGISPolynomialImageWarp(std::string inputImage, std::string outputImage, std::string outProjWKT, std::string gcpFilePath, float outImgRes, RSGISWarpImageInterpolator *interpolator, unsigned int polyOrder = 2, std::string gdalFormat = "ENVI", unsigned int numThreads=1, double maxTransformError=0);
 		void initWarp();
 		~RSGISPolynomialImageWarp();
 	protected:
 		geos::geom::Envelope* newImageExtent(unsigned int width, unsigned int height);
-		void findNearestPixel(double eastings, double northings, unsigned int *x, unsigned int *y, float inImgRes);
+		void findPixelLocation(double eastings, double northings, double *x, double *y, float inImgRes);
+        void pixelLocationToPixel(double x, double y, long *xPxl, long *yPxl);
         int polyOrder; // Polynominal order
         gsl_vector *aX;
         gsl_vector *aY;
@@ -27,7 +27,7 @@
 
 namespace rsgis{namespace reg{
 	
-	RSGISSingleConnectLayerImageRegistration::RSGISSingleConnectLayerImageRegistration(GDALDataset *reference, GDALDataset *floating, unsigned int gap, float metricThreshold, unsigned int windowSize, unsigned int searchArea, RSGISImageSimilarityMetric *metric, float stdDevRefThreshold, float stdDevFloatThreshold, unsigned int subPixelResolution, float distanceThreshold, unsigned int maxNumIterations, float moveChangeThreshold, float pSmoothness):RSGISImageRegistration(reference, floating), tiePoints(NULL), gap(1), metricThreshold(0), initExecuted(false), windowSize(0), searchArea(0), metric(NULL), stdDevRefThreshold(0), stdDevFloatThreshold(0), subPixelResolution(0), distanceThreshold(0), maxNumIterations(10), moveChangeThreshold(0), pSmoothness(0)
+	RSGISSingleConnectLayerImageRegistration::RSGISSingleConnectLayerImageRegistration(GDALDataset *reference, GDALDataset *floating, unsigned int gap, float metricThreshold, unsigned int windowSize, unsigned int searchArea, RSGISImageSimilarityMetric *metric, float stdDevRefThreshold, float stdDevFloatThreshold, unsigned int subPixelResolution, float distanceThreshold, unsigned int maxNumIterations, float moveChangeThreshold, float pSmoothness, unsigned int numThreads):RSGISImageRegistration(reference, floating), tiePoints(NULL), gap(1), metricThreshold(0), initExecuted(false), windowSize(0), searchArea(0), metric(NULL), stdDevRefThreshold(0), stdDevFloatThreshold(0), subPixelResolution(0), distanceThreshold(0), maxNumIterations(10), moveChangeThreshold(0), pSmoothness(0), numThreads(1)
 	{
 		tiePoints = new std::list<TiePointInSingleLayer*>();
 		this->gap = gap;
@@ -42,6 +42,7 @@ namespace rsgis{namespace reg{
 		this->maxNumIterations = maxNumIterations;
 		this->moveChangeThreshold = moveChangeThreshold;
 		this->pSmoothness = pSmoothness;
+		this->numThreads = rsgis::getNumProcessingThreads(numThreads);
 	}
 	
 	void RSGISSingleConnectLayerImageRegistration::initRegistration()
@@ -165,72 +166,126 @@ namespace rsgis{namespace reg{
 		double totalMovement = 0;
 		double averageMovement = 0;
 		
-		double distance = 0;
-		double invDist = 0;
-		float xShiftDiff = 0;
-		float yShiftDiff = 0;
 		bool first = true;
 		float prevAverage = 0;
 		
 		std::list<TiePointInSingleLayer*>::iterator iterTiePts;
-		std::list<TiePoint*>::iterator iterNrTiePts;
-            
+		
+		// With multiple threads every tie point is searched for (in parallel) before the shifts
+		// are propagated to the neighbouring tie points, rather than propagating each shift
+		// as soon as it is found, as the searches would otherwise depend on one another.
+		std::vector<TiePointInSingleLayer*> tiePtsVec(tiePoints->begin(), tiePoints->end());
+		std::vector<float> xShifts;
+		std::vector<float> yShifts;
+		std::vector<float> distances;
+		if(numThreads > 1)
+		{
+			xShifts.resize(tiePtsVec.size());
+			yShifts.resize(tiePtsVec.size());
+			distances.resize(tiePtsVec.size());
+			this->openThreadDatasets(numThreads);
+		}
         
-		for(unsigned int i = 0; i < maxNumIterations; ++i)
+		try
 		{
-			std::cout << "Started (Iteration " << i << ")." << std::flush;
-			totalMovement = 0;
-			counter = 0;
-			feedbackVal = 0;
-			for(iterTiePts = tiePoints->begin(); iterTiePts != tiePoints->end(); ++iterTiePts)
+			for(unsigned int i = 0; i < maxNumIterations; ++i)
 			{
-				if(giveFeedback && ((counter % feedback) == 0))
+				std::cout << "Started (Iteration " << i << ")." << std::flush;
+				totalMovement = 0;
+				counter = 0;
+				feedbackVal = 0;
+				if(numThreads > 1)
 				{
-					std::cout << "." << feedbackVal << "." << std::flush;
-					feedbackVal += 10;
+					size_t blockSize = giveFeedback?feedback:tiePtsVec.size();
+					for(size_t blockStart = 0; blockStart < tiePtsVec.size(); blockStart += blockSize)
+					{
+						if(giveFeedback)
+						{
+							std::cout << "." << feedbackVal << "." << std::flush;
+							feedbackVal += 10;
+						}
+						size_t blockEnd = std::min(blockStart + blockSize, tiePtsVec.size());
+						rsgis::parallelForRange(blockStart, blockEnd, numThreads, 1, [&](size_t ptStart, size_t ptEnd, unsigned int threadIdx)
+						{
+							for(size_t n = ptStart; n < ptEnd; ++n)
+							{
+								distances[n] = this->findTiePointLocation(tiePtsVec[n]->tiePt, windowSize, searchArea, metric, metricThreshold, subPixelResolution, &xShifts[n], &yShifts[n], threadIdx);
+							}
+						});
+					}
+					
+					for(size_t n = 0; n < tiePtsVec.size(); ++n)
+					{
+						totalMovement += distances[n];
+						this->propagateShift(tiePtsVec[n], xShifts[n], yShifts[n]);
+					}
 				}
-                totalMovement += this->findTiePointLocation((*iterTiePts)->tiePt, windowSize, searchArea, metric, metricThreshold, subPixelResolution, &xShift, &yShift);
-
-                for(iterNrTiePts = (*iterTiePts)->nrTiePts->begin(); iterNrTiePts != (*iterTiePts)->nrTiePts->end(); ++iterNrTiePts)
-                {
-					distance = (*iterTiePts)->tiePt->floatDistance((*iterNrTiePts));
-					if(distance < 1)
+				else
+				{
+					for(iterTiePts = tiePoints->begin(); iterTiePts != tiePoints->end(); ++iterTiePts)
 					{
-						invDist = 1;
+						if(giveFeedback && ((counter % feedback) == 0))
+						{
+							std::cout << "." << feedbackVal << "." << std::flush;
+							feedbackVal += 10;
+						}
+						totalMovement += this->findTiePointLocation((*iterTiePts)->tiePt, windowSize, searchArea, metric, metricThreshold, subPixelResolution, &xShift, &yShift);
+						this->propagateShift((*iterTiePts), xShift, yShift);
+						++counter;
 					}
-					else
+				}
+				averageMovement = totalMovement/tiePoints->size();
+				std::cout << ". Complete - Movement = "<< averageMovement << std::endl;
+				if(first)
+				{
+					prevAverage = averageMovement;
+					first = false;
+				}
+				else
+				{
+					float moveDiff = sqrt(((averageMovement - prevAverage)*(averageMovement - prevAverage)));
+					if(moveDiff < moveChangeThreshold)
 					{
-						invDist = 1/(distance*pSmoothness);
+						break;
 					}
-					
-					xShiftDiff = xShift - (*iterNrTiePts)->xShift;
-					yShiftDiff = yShift - (*iterNrTiePts)->yShift;
-					
-					(*iterNrTiePts)->xShift += invDist*xShiftDiff;
-					(*iterNrTiePts)->yShift += invDist*yShiftDiff;
+					prevAverage = averageMovement;
 				}
-				++counter;
 			}
-			averageMovement = totalMovement/tiePoints->size();
-			std::cout << ". Complete - Movement = "<< averageMovement << std::endl;
-			if(first)
+		}
+		catch(std::exception &e)
+		{
+			this->closeThreadDatasets();
+			throw;
+		}
+		this->closeThreadDatasets();
+	}
+	
+	void RSGISSingleConnectLayerImageRegistration::propagateShift(TiePointInSingleLayer *tiePt, float xShift, float yShift)
+	{
+		double distance = 0;
+		double invDist = 0;
+		float xShiftDiff = 0;
+		float yShiftDiff = 0;
+		
+		std::list<TiePoint*>::iterator iterNrTiePts;
+		for(iterNrTiePts = tiePt->nrTiePts->begin(); iterNrTiePts != tiePt->nrTiePts->end(); ++iterNrTiePts)
+		{
+			distance = tiePt->tiePt->floatDistance((*iterNrTiePts));
+			if(distance < 1)
 			{
-				prevAverage = averageMovement;
-				first = false;
+				invDist = 1;
 			}
 			else
 			{
-				float moveDiff = sqrt(((averageMovement - prevAverage)*(averageMovement - prevAverage)));
-				if(moveDiff < moveChangeThreshold)
-				{
-					break;
-				}
-				prevAverage = averageMovement;
+				invDist = 1/(distance*pSmoothness);
 			}
+			
+			xShiftDiff = xShift - (*iterNrTiePts)->xShift;
+			yShiftDiff = yShift - (*iterNrTiePts)->yShift;
+			
+			(*iterNrTiePts)->xShift += invDist*xShiftDiff;
+			(*iterNrTiePts)->yShift += invDist*yShiftDiff;
 		}
-		
-		
-		
 	}
 	
 	void RSGISSingleConnectLayerImageRegistration::finaliseRegistration()
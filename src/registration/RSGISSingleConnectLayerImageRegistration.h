@@ -30,6 +30,7 @@
 #include <string>
 #include <math.h>
 #include <list>
+#include <vector>
 
 #include "gdal_priv.h"
 #include "ogrsf_frmts.h"
@@ -38,6 +39,8 @@
 
 #include "registration/RSGISImageRegistration.h"
 
+#include "common/RSGISThreadUtils.h"
+
 // mark all exported classes/functions with DllExport to have
 // them exported by Visual Studio
 #undef DllExport
@@ -63,7 +66,7 @@ namespace rsgis{namespace reg{
 			std::list<TiePoint*> *nrTiePts;
 		};
 		
-		RSGISSingleConnectLayerImageRegistration(GDALDataset *reference, GDALDataset *floating, unsigned int gap, float metricThreshold, unsigned int windowSize, unsigned int searchArea, RSGISImageSimilarityMetric *metric, float stdDevRefThreshold, float stdDevFloatThreshold, unsigned int subPixelResolution, float distanceThreshold, unsigned int maxNumIterations, float moveChangeThreshold, float pSmoothness);
+		RSGISSingleConnectLayerImageRegistration(GDALDataset *reference, GDALDataset *floating, unsigned int gap, float metricThreshold, unsigned int windowSize, unsigned int searchArea, RSGISImageSimilarityMetric *metric, float stdDevRefThreshold, float stdDevFloatThreshold, unsigned int subPixelResolution, float distanceThreshold, unsigned int maxNumIterations, float moveChangeThreshold, float pSmoothness, unsigned int numThreads=1);
 		void initRegistration();
 		void executeRegistration();
 		void finaliseRegistration();
@@ -73,6 +76,7 @@ namespace rsgis{namespace reg{
         void exportTiePointsRSGISMapOffs(std::string filepath);
 		~RSGISSingleConnectLayerImageRegistration();
 	private:
+		void propagateShift(TiePointInSingleLayer *tiePt, float xShift, float yShift);
 		std::list<TiePointInSingleLayer*> *tiePoints;
 		unsigned int gap;
 		float metricThreshold;
@@ -87,6 +91,7 @@ namespace rsgis{namespace reg{
 		unsigned int maxNumIterations;
 		float moveChangeThreshold;
 		float pSmoothness;
+		unsigned int numThreads;
 	};
 }}
 
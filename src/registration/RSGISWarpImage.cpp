@@ -26,7 +26,7 @@
 
 namespace rsgis{namespace reg{
 	
-	RSGISWarpImage::RSGISWarpImage(std::string inputImage, std::string outputImage, std::string outProjWKT, std::string gcpFilePath, float outImgRes, RSGISWarpImageInterpolator *interpolator, std::string gdalFormat):inputImage(""), outputImage(""), outProjWKT(""), gcpFilePath(""), outImgRes(0), interpolator(NULL), gdalFormat("ENVI")
+	RSGISWarpImage::RSGISWarpImage(std::string inputImage, std::string outputImage, std::string outProjWKT, std::string gcpFilePath, float outImgRes, RSGISWarpImageInterpolator *interpolator, std::string gdalFormat, unsigned int numThreads, double maxTransformError):inputImage(""), outputImage(""), outProjWKT(""), gcpFilePath(""), outImgRes(0), interpolator(NULL), gdalFormat("ENVI"), numThreads(1), maxTransformError(0)
 	{
 		this->inputImage = inputImage;
 		this->outputImage = outputImage;
@@ -35,6 +35,8 @@ namespace rsgis{namespace reg{
 		this->outImgRes = outImgRes;
 		this->interpolator = interpolator;
         this->gdalFormat = gdalFormat;
+        this->numThreads = rsgis::getNumProcessingThreads(numThreads);
+        this->maxTransformError = maxTransformError;
 		gcps = new std::vector<RSGISGCPImg2MapNode*>();
 	}
 	
@@ -206,11 +208,9 @@ namespace rsgis{namespace reg{
 	
 	void RSGISWarpImage::populateOutputImage()
 	{
-        rsgis::img::RSGISImageUtils imgUtils;
-		
 		GDALDataset *inputImageDS = NULL;
 		GDALDataset *outputImageDS = NULL;
-
+        std::vector<GDALDataset*> threadInputDS;
 		
 		try 
 		{
@@ -236,26 +236,37 @@ namespace rsgis{namespace reg{
 			
 			double *gdalTransformation= new double[6];
 			inputImageDS->GetGeoTransform(gdalTransformation);
-			
-			//double inTLX = gdalTransformation[0];
-			//double inTLY = gdalTransformation[3];
-			//double inBRX = inTLX + (inputImageDS->GetRasterXSize() * gdalTransformation[1]);
-			//double inBRY = inTLY + (inputImageDS->GetRasterYSize() * gdalTransformation[5]);
 			float inImgRes = gdalTransformation[1];
 			
 			outputImageDS->GetGeoTransform(gdalTransformation);
-            
 			double outTLX = gdalTransformation[0];
 			double outTLY = gdalTransformation[3];
-			//double outBRX = outTLX + (outputImageDS->GetRasterXSize() * gdalTransformation[1]);
-			//double outBRY = outTLY + (outputImageDS->GetRasterYSize() * gdalTransformation[5]);
-
 			delete[] gdalTransformation;
             
             unsigned int inWidth = inputImageDS->GetRasterXSize();
 			unsigned int inHeight = inputImageDS->GetRasterYSize();
 			unsigned int outWidth = outputImageDS->GetRasterXSize();
 			unsigned int outHeight = outputImageDS->GetRasterYSize();
+            
+            unsigned int numThreads = this->numThreads;
+            if((numThreads > 1) && (!this->isThreadSafe()))
+            {
+                std::cout << "The transform cannot be used from multiple threads so a single thread will be used.\n";
+                numThreads = 1;
+            }
+            
+            // Each thread reads the input image through its own dataset.
+            threadInputDS.push_back(inputImageDS);
+            for(unsigned int i = 1; i < numThreads; ++i)
+            {
+                GDALDataset *threadDS = (GDALDataset *) GDALOpen(this->inputImage.c_str(), GA_ReadOnly);
+                if(threadDS == NULL)
+                {
+                    std::string message = std::string("Could not open image ") + this->inputImage;
+                    throw RSGISImageException(message.c_str());
+                }
+                threadInputDS.push_back(threadDS);
+            }
 			
 			//Get Image Output Bands
 			GDALRasterBand **outputRasterBands = new GDALRasterBand*[numBands];
@@ -264,77 +275,46 @@ namespace rsgis{namespace reg{
 				outputRasterBands[i] = outputImageDS->GetRasterBand(i+1);
 			}
 			
-			// Allocate memory			
+			// Allocate memory for a row of tiles
 			float **outputData = new float*[numBands];
 			for(unsigned int i = 0; i < numBands; i++)
 			{
-				outputData[i] = (float *) CPLMalloc(sizeof(float)*outWidth);
+				outputData[i] = (float *) CPLMalloc(sizeof(float)*outWidth*RSGIS_WARP_TILE_SIZE);
 			}
-			float *outDataColumn = new float[numBands];
 			
 			double startEastings = outTLX - (this->outImgRes+(this->outImgRes/2));
 			double startNorthings = outTLY + (this->outImgRes+(this->outImgRes/2));
-			double currentEastings = startEastings;
-			double currentNorthings = startNorthings;
-			
-			unsigned int xPxl = 0;
-			unsigned int yPxl = 0;
+            
+            unsigned int numTileRows = (outHeight + RSGIS_WARP_TILE_SIZE - 1) / RSGIS_WARP_TILE_SIZE;
+            unsigned int numTileCols = (outWidth + RSGIS_WARP_TILE_SIZE - 1) / RSGIS_WARP_TILE_SIZE;
 			
-			int feedback = outHeight/10;
+			int feedback = numTileRows/10;
 			int feedbackCounter = 0;
 			std::cout << "Started ." << std::flush;
-
-			for(unsigned int i = 0; i < outHeight; ++i)
+			for(unsigned int i = 0; i < numTileRows; ++i)
 			{
-				if((outHeight > 10) && ((i % feedback) == 0))
+				if((numTileRows > 10) && ((i % feedback) == 0))
 				{
 					std::cout << "." << feedbackCounter << "." << std::flush;
 					feedbackCounter = feedbackCounter + 10;
 				}
-				currentEastings = startEastings;
-				for(unsigned int j = 0; j < outWidth; ++j)
-				{
-					try 
-					{
-						this->findNearestPixel(currentEastings, currentNorthings, &xPxl, &yPxl, inImgRes);
-                        
-                        // Check xPxl and yPxl are within input image.
-						if((xPxl < inWidth) && (yPxl < inHeight))
-                        {
-                            this->interpolator->calcValue(inputImageDS, outDataColumn, numBands, currentEastings, currentNorthings, xPxl, yPxl, inImgRes, outImgRes);
-                        }
-                        else
-                        {
-                            for(unsigned int n = 0; n < numBands; n++)
-                            {
-                                outDataColumn[n] = 0;
-                            }
-                        }
-                        
-					}
-					catch (RSGISImageWarpException) 
-					{
-						// ignore... - set output as NaN
-						for(unsigned int n = 0; n < numBands; n++)
-						{
-							outDataColumn[n] = std::numeric_limits<double>::signaling_NaN();//NAN;
-						}
-					}
-					
-					for(unsigned int n = 0; n < numBands; n++)
-					{
-						outputData[n][j] = outDataColumn[n];
-					}
-					
-					currentEastings += this->outImgRes;
-				}
+                unsigned int tileYOff = i * RSGIS_WARP_TILE_SIZE;
+                unsigned int tileHeight = std::min<unsigned int>(RSGIS_WARP_TILE_SIZE, outHeight - tileYOff);
+                
+                rsgis::parallelForRange(0, numTileCols, numThreads, 1, [&](size_t startTile, size_t endTile, unsigned int threadIdx)
+                {
+                    for(size_t j = startTile; j < endTile; ++j)
+                    {
+                        unsigned int tileXOff = j * RSGIS_WARP_TILE_SIZE;
+                        unsigned int tileWidth = std::min<unsigned int>(RSGIS_WARP_TILE_SIZE, outWidth - tileXOff);
+                        this->warpImageTile(threadInputDS.at(threadIdx), numBands, inWidth, inHeight, inImgRes, startEastings, startNorthings, tileXOff, tileYOff, tileWidth, tileHeight, outputData, outWidth, tileYOff);
+                    }
+                });
 				
 				for(unsigned int n = 0; n < numBands; n++)
 				{
-					outputRasterBands[n]->RasterIO(GF_Write, 0, i, outWidth, 1, outputData[n], outWidth, 1, GDT_Float32, 0, 0);
+					outputRasterBands[n]->RasterIO(GF_Write, 0, tileYOff, outWidth, tileHeight, outputData[n], outWidth, tileHeight, GDT_Float32, 0, 0);
 				}
-				
-				currentNorthings -= this->outImgRes;
 			}
 			std::cout << ". Complete\n";
 			
@@ -345,31 +325,356 @@ namespace rsgis{namespace reg{
 				CPLFree(outputData[i]);
 			}
 			delete[] outputData;
-			delete[] outDataColumn;
 			
+            for(unsigned int i = 1; i < threadInputDS.size(); ++i)
+            {
+                GDALClose(threadInputDS.at(i));
+            }
 			GDALClose(inputImageDS);
 			GDALClose(outputImageDS);
 		}
 		catch (RSGISImageWarpException &e) 
 		{
+            for(unsigned int i = 1; i < threadInputDS.size(); ++i)
+            {
+                GDALClose(threadInputDS.at(i));
+            }
 			GDALClose(inputImageDS);
 			GDALClose(outputImageDS);
 			throw e;
 		}
 		catch (rsgis::img::RSGISImageBandException &e) 
 		{
+            for(unsigned int i = 1; i < threadInputDS.size(); ++i)
+            {
+                GDALClose(threadInputDS.at(i));
+            }
 			GDALClose(inputImageDS);
 			GDALClose(outputImageDS);
 			throw RSGISImageWarpException(e.what());
 		}
 		catch (RSGISImageException &e) 
 		{
+            for(unsigned int i = 1; i < threadInputDS.size(); ++i)
+            {
+                GDALClose(threadInputDS.at(i));
+            }
 			GDALClose(inputImageDS);
 			GDALClose(outputImageDS);
 			throw RSGISImageWarpException(e.what());
 		} 
 	}
     
+    void RSGISWarpImage::warpImageTile(GDALDataset *inputImageDS, unsigned int numBands, unsigned int inWidth, unsigned int inHeight, float inImgRes, double startEastings, double startNorthings, unsigned int tileXOff, unsigned int tileYOff, unsigned int tileWidth, unsigned int tileHeight, float **outputData, unsigned int outDataWidth, unsigned int outDataYOff)
+    {
+        size_t numTilePxls = ((size_t)tileWidth) * tileHeight;
+        double *xLocs = new double[numTilePxls];
+        double *yLocs = new double[numTilePxls];
+        bool *valid = new bool[numTilePxls];
+        long *xPxls = new long[numTilePxls];
+        long *yPxls = new long[numTilePxls];
+        
+        this->findTilePixelLocations(startEastings, startNorthings, tileXOff, tileYOff, tileWidth, tileHeight, inImgRes, xLocs, yLocs, valid);
+        
+        // Find the window of the input image covering the pixels used by the tile.
+        long minX = 0;
+        long maxX = 0;
+        long minY = 0;
+        long maxY = 0;
+        bool first = true;
+        for(size_t i = 0; i < numTilePxls; ++i)
+        {
+            if(valid[i])
+            {
+                this->pixelLocationToPixel(xLocs[i], yLocs[i], &xPxls[i], &yPxls[i]);
+                if((xPxls[i] >= 0) && (xPxls[i] < ((long)inWidth)) && (yPxls[i] >= 0) && (yPxls[i] < ((long)inHeight)))
+                {
+                    if(first)
+                    {
+                        minX = xPxls[i];
+                        maxX = xPxls[i];
+                        minY = yPxls[i];
+                        maxY = yPxls[i];
+                        first = false;
+                    }
+                    else
+                    {
+                        minX = std::min(minX, xPxls[i]);
+                        maxX = std::max(maxX, xPxls[i]);
+                        minY = std::min(minY, yPxls[i]);
+                        maxY = std::max(maxY, yPxls[i]);
+                    }
+                }
+            }
+        }
+        
+        float **winData = NULL;
+        unsigned int winWidth = 0;
+        unsigned int winHeight = 0;
+        if(!first)
+        {
+            long border = this->interpolator->getWindowBorder();
+            minX = std::max<long>(minX - border, 0);
+            maxX = std::min<long>(maxX + border, ((long)inWidth) - 1);
+            minY = std::max<long>(minY - border, 0);
+            maxY = std::min<long>(maxY + border, ((long)inHeight) - 1);
+            winWidth = (maxX - minX) + 1;
+            winHeight = (maxY - minY) + 1;
+            
+            // A tile mapping to a very large window (e.g., a strongly rotated or scattered
+            // transform) is read pixel by pixel rather than as a single block.
+            size_t maxWinPxls = RSGIS_WARP_MAX_WINDOW_SCALE * std::max<size_t>(numTilePxls, RSGIS_WARP_TILE_SIZE * RSGIS_WARP_TILE_SIZE);
+            if((((size_t)winWidth) * winHeight) <= maxWinPxls)
+            {
+                winData = new float*[numBands];
+                for(unsigned int n = 0; n < numBands; ++n)
+                {
+                    winData[n] = new float[((size_t)winWidth) * winHeight];
+                    inputImageDS->GetRasterBand(n+1)->RasterIO(GF_Read, minX, minY, winWidth, winHeight, winData[n], winWidth, winHeight, GDT_Float32, 0, 0);
+                }
+            }
+        }
+        
+        float *outDataColumn = new float[numBands];
+        double currentEastings = 0;
+        double currentNorthings = 0;
+        size_t idx = 0;
+        size_t outIdx = 0;
+        for(unsigned int y = 0; y < tileHeight; ++y)
+        {
+            currentNorthings = startNorthings - (((double)(tileYOff + y)) * this->outImgRes);
+            for(unsigned int x = 0; x < tileWidth; ++x)
+            {
+                currentEastings = startEastings + (((double)(tileXOff + x)) * this->outImgRes);
+                idx = (((size_t)y) * tileWidth) + x;
+                try
+                {
+                    if(!valid[idx])
+                    {
+                        throw RSGISImageWarpException("The pixel location could not be found.");
+                    }
+                    
+                    // Check xPxl and yPxl are within input image.
+                    if((xPxls[idx] >= 0) && (xPxls[idx] < ((long)inWidth)) && (yPxls[idx] >= 0) && (yPxls[idx] < ((long)inHeight)))
+                    {
+                        if(winData != NULL)
+                        {
+                            this->interpolator->calcValue(winData, winWidth, winHeight, outDataColumn, numBands, currentEastings, currentNorthings, (xPxls[idx] - minX), (yPxls[idx] - minY), inImgRes, this->outImgRes);
+                        }
+                        else
+                        {
+                            this->interpolator->calcValue(inputImageDS, outDataColumn, numBands, currentEastings, currentNorthings, xPxls[idx], yPxls[idx], inImgRes, this->outImgRes);
+                        }
+                    }
+                    else
+                    {
+                        for(unsigned int n = 0; n < numBands; n++)
+                        {
+                            outDataColumn[n] = 0;
+                        }
+                    }
+                }
+                catch (RSGISImageWarpException &e)
+                {
+                    // ignore... - set output as NaN
+                    for(unsigned int n = 0; n < numBands; n++)
+                    {
+                        outDataColumn[n] = std::numeric_limits<double>::signaling_NaN();//NAN;
+                    }
+                }
+                
+                outIdx = (((size_t)(tileYOff + y - outDataYOff)) * outDataWidth) + tileXOff + x;
+                for(unsigned int n = 0; n < numBands; n++)
+                {
+                    outputData[n][outIdx] = outDataColumn[n];
+                }
+            }
+        }
+        
+        delete[] outDataColumn;
+        if(winData != NULL)
+        {
+            for(unsigned int n = 0; n < numBands; ++n)
+            {
+                delete[] winData[n];
+            }
+            delete[] winData;
+        }
+        delete[] xLocs;
+        delete[] yLocs;
+        delete[] valid;
+        delete[] xPxls;
+        delete[] yPxls;
+    }
+    
+    void RSGISWarpImage::findTilePixelLocations(double startEastings, double startNorthings, unsigned int tileXOff, unsigned int tileYOff, unsigned int tileWidth, unsigned int tileHeight, float inImgRes, double *xLocs, double *yLocs, bool *valid)
+    {
+        auto findLocation = [&](unsigned int x, unsigned int y)
+        {
+            size_t idx = (((size_t)y) * tileWidth) + x;
+            double eastings = startEastings + (((double)(tileXOff + x)) * this->outImgRes);
+            double northings = startNorthings - (((double)(tileYOff + y)) * this->outImgRes);
+            try
+            {
+                this->findPixelLocation(eastings, northings, &xLocs[idx], &yLocs[idx], inImgRes);
+                valid[idx] = true;
+            }
+            catch (RSGISImageWarpException &e)
+            {
+                valid[idx] = false;
+            }
+        };
+        
+        if(this->maxTransformError <= 0)
+        {
+            for(unsigned int y = 0; y < tileHeight; ++y)
+            {
+                for(unsigned int x = 0; x < tileWidth; ++x)
+                {
+                    findLocation(x, y);
+                }
+            }
+            return;
+        }
+        
+        // Grid nodes, including the last row and column of the tile.
+        std::vector<unsigned int> gridX;
+        for(unsigned int x = 0; x < tileWidth; x += RSGIS_WARP_APPROX_GRID_SPACING)
+        {
+            gridX.push_back(x);
+        }
+        if(gridX.back() != (tileWidth-1))
+        {
+            gridX.push_back(tileWidth-1);
+        }
+        std::vector<unsigned int> gridY;
+        for(unsigned int y = 0; y < tileHeight; y += RSGIS_WARP_APPROX_GRID_SPACING)
+        {
+            gridY.push_back(y);
+        }
+        if(gridY.back() != (tileHeight-1))
+        {
+            gridY.push_back(tileHeight-1);
+        }
+        
+        for(std::vector<unsigned int>::iterator iterY = gridY.begin(); iterY != gridY.end(); ++iterY)
+        {
+            for(std::vector<unsigned int>::iterator iterX = gridX.begin(); iterX != gridX.end(); ++iterX)
+            {
+                findLocation(*iterX, *iterY);
+            }
+        }
+        
+        if((gridX.size() < 2) || (gridY.size() < 2))
+        {
+            // A single row or column of pixels; find every location.
+            for(unsigned int y = 0; y < tileHeight; ++y)
+            {
+                for(unsigned int x = 0; x < tileWidth; ++x)
+                {
+                    findLocation(x, y);
+                }
+            }
+            return;
+        }
+        
+        // Cells which cannot be approximated are found exactly once all the approximated
+        // cells have been populated so the exact locations take precedence on shared edges.
+        std::vector<std::pair<unsigned int, unsigned int> > exactCells;
+        for(unsigned int i = 0; i < (gridY.size()-1); ++i)
+        {
+            unsigned int y0 = gridY.at(i);
+            unsigned int y1 = gridY.at(i+1);
+            for(unsigned int j = 0; j < (gridX.size()-1); ++j)
+            {
+                unsigned int x0 = gridX.at(j);
+                unsigned int x1 = gridX.at(j+1);
+                
+                size_t idxTL = (((size_t)y0) * tileWidth) + x0;
+                size_t idxTR = (((size_t)y0) * tileWidth) + x1;
+                size_t idxBL = (((size_t)y1) * tileWidth) + x0;
+                size_t idxBR = (((size_t)y1) * tileWidth) + x1;
+                
+                bool approx = valid[idxTL] && valid[idxTR] && valid[idxBL] && valid[idxBR];
+                unsigned int cX = (x0 + x1) / 2;
+                unsigned int cY = (y0 + y1) / 2;
+                size_t idxC = (((size_t)cY) * tileWidth) + cX;
+                if(approx)
+                {
+                    findLocation(cX, cY);
+                    approx = valid[idxC];
+                }
+                
+                double fX = 0;
+                double fY = 0;
+                double estX = 0;
+                double estY = 0;
+                if(approx)
+                {
+                    fX = ((double)(cX - x0)) / ((double)(x1 - x0));
+                    fY = ((double)(cY - y0)) / ((double)(y1 - y0));
+                    estX = ((1-fX)*(1-fY)*xLocs[idxTL]) + (fX*(1-fY)*xLocs[idxTR]) + ((1-fX)*fY*xLocs[idxBL]) + (fX*fY*xLocs[idxBR]);
+                    estY = ((1-fX)*(1-fY)*yLocs[idxTL]) + (fX*(1-fY)*yLocs[idxTR]) + ((1-fX)*fY*yLocs[idxBL]) + (fX*fY*yLocs[idxBR]);
+                    approx = (fabs(estX - xLocs[idxC]) <= this->maxTransformError) && (fabs(estY - yLocs[idxC]) <= this->maxTransformError);
+                }
+                
+                if(approx)
+                {
+                    size_t idx = 0;
+                    for(unsigned int y = y0; y <= y1; ++y)
+                    {
+                        fY = ((double)(y - y0)) / ((double)(y1 - y0));
+                        for(unsigned int x = x0; x <= x1; ++x)
+                        {
+                            idx = (((size_t)y) * tileWidth) + x;
+                            if(idx == idxC)
+                            {
+                                continue;
+                            }
+                            fX = ((double)(x - x0)) / ((double)(x1 - x0));
+                            xLocs[idx] = ((1-fX)*(1-fY)*xLocs[idxTL]) + (fX*(1-fY)*xLocs[idxTR]) + ((1-fX)*fY*xLocs[idxBL]) + (fX*fY*xLocs[idxBR]);
+                            yLocs[idx] = ((1-fX)*(1-fY)*yLocs[idxTL]) + (fX*(1-fY)*yLocs[idxTR]) + ((1-fX)*fY*yLocs[idxBL]) + (fX*fY*yLocs[idxBR]);
+                            valid[idx] = true;
+                        }
+                    }
+                }
+                else
+                {
+                    exactCells.push_back(std::pair<unsigned int, unsigned int>(i, j));
+                }
+            }
+        }
+        
+        for(std::vector<std::pair<unsigned int, unsigned int> >::iterator iterCells = exactCells.begin(); iterCells != exactCells.end(); ++iterCells)
+        {
+            for(unsigned int y = gridY.at((*iterCells).first); y <= gridY.at((*iterCells).first+1); ++y)
+            {
+                for(unsigned int x = gridX.at((*iterCells).second); x <= gridX.at((*iterCells).second+1); ++x)
+                {
+                    findLocation(x, y);
+                }
+            }
+        }
+    }
+    
+    void RSGISWarpImage::pixelLocationToPixel(double x, double y, long *xPxl, long *yPxl)
+    {
+        *xPxl = floor(x+0.5);
+        *yPxl = floor(y+0.5);
+    }
+    
+    void RSGISWarpImage::findNearestPixel(double eastings, double northings, unsigned int *x, unsigned int *y, float inImgRes)
+    {
+        double xLoc = 0;
+        double yLoc = 0;
+        long xPxl = 0;
+        long yPxl = 0;
+        this->findPixelLocation(eastings, northings, &xLoc, &yLoc, inImgRes);
+        this->pixelLocationToPixel(xLoc, yLoc, &xPxl, &yPxl);
+        *x = xPxl;
+        *y = yPxl;
+    }
+    
     void RSGISWarpImage::populateTransformImage()
 	{
 		rsgis::img::RSGISImageUtils imgUtils;
@@ -30,6 +30,9 @@
 #include <string>
 #include <math.h>
 #include <list>
+#include <vector>
+#include <limits>
+#include <algorithm>
 
 #include "gdal_priv.h"
 #include "ogrsf_frmts.h"
@@ -37,6 +40,7 @@
 #include "geos/geom/Envelope.h"
 
 #include "common/RSGISImageException.h"
+#include "common/RSGISThreadUtils.h"
 
 #include "utils/RSGISTextUtils.h"
 
@@ -62,12 +66,36 @@
     #define DllExport
 #endif
 
+/** The width and height (in output pixels) of the tiles the output image is warped in. */
+#define RSGIS_WARP_TILE_SIZE 64
+/** The spacing (in output pixels) of the grid the transform is evaluated on when it is approximated. */
+#define RSGIS_WARP_APPROX_GRID_SPACING 16
+/** A source window larger than this multiple of the tile area is not read as a block. */
+#define RSGIS_WARP_MAX_WINDOW_SCALE 16
+
 namespace rsgis{namespace reg{
     
+    /**
+     * Warps an image using the GCPs. The output image is populated in tiles of
+     * RSGIS_WARP_TILE_SIZE pixels: the input pixel location for each output pixel
+     * in the tile is found, the window of the input image covering those locations
+     * is read once and the interpolator applied to the window in memory. Tiles
+     * within a row of tiles are processed in parallel (numThreads), unless the
+     * transform is not thread safe.
+     *
+     * If maxTransformError is greater than 0 the transform is only evaluated on a
+     * grid (every RSGIS_WARP_APPROX_GRID_SPACING pixels) and the locations between
+     * the grid nodes are bilinearly interpolated, as with GDAL's approximate
+     * transformer. Each grid cell is checked against the exact transform at its
+     * centre and where the error is above maxTransformError (in input pixels) the
+     * transform is evaluated for every pixel within the cell. This is intended for
+     * smooth transforms (e.g., polynomial); a location which cannot be found inside
+     * an approximated cell is interpolated from the cell corners.
+     */
 	class DllExport RSGISWarpImage
 	{
 	public:
-		RSGISWarpImage(std::string inputImage, std::string outputImage, std::string outProjWKT, std::string gcpFilePath, float outImgRes, RSGISWarpImageInterpolator *interpolator, std::string gdalFormat);
+		RSGISWarpImage(std::string inputImage, std::string outputImage, std::string outProjWKT, std::string gcpFilePath, float outImgRes, RSGISWarpImageInterpolator *interpolator, std::string gdalFormat, unsigned int numThreads=1, double maxTransformError=0);
 		void performWarp();
         void generateTransformImage();
 		void readGCPFile();
@@ -79,7 +107,17 @@ namespace rsgis{namespace reg{
 		virtual ~RSGISWarpImage();
 	protected:
 		virtual geos::geom::Envelope* newImageExtent(unsigned int width, unsigned int height) = 0;
-		virtual void findNearestPixel(double eastings, double northings, unsigned int *x, unsigned int *y, float inImgRes) = 0;
+        /** Finds the (sub-pixel) location within the input image for the position; throws an RSGISImageWarpException if it cannot be found. */
+        virtual void findPixelLocation(double eastings, double northings, double *x, double *y, float inImgRes) = 0;
+        /** Converts a location from findPixelLocation to the nearest input pixel. */
+        virtual void pixelLocationToPixel(double x, double y, long *xPxl, long *yPxl);
+        /** Returns true if findPixelLocation can be called from multiple threads at once. */
+        virtual bool isThreadSafe(){return true;};
+		void findNearestPixel(double eastings, double northings, unsigned int *x, unsigned int *y, float inImgRes);
+        /** Populates the input image locations for the tile; valid is false where the location could not be found. */
+        void findTilePixelLocations(double startEastings, double startNorthings, unsigned int tileXOff, unsigned int tileYOff, unsigned int tileWidth, unsigned int tileHeight, float inImgRes, double *xLocs, double *yLocs, bool *valid);
+        /** Populates the tile within outputData, which holds rows from outDataYOff of the output image, from the input image. */
+        void warpImageTile(GDALDataset *inputImageDS, unsigned int numBands, unsigned int inWidth, unsigned int inHeight, float inImgRes, double startEastings, double startNorthings, unsigned int tileXOff, unsigned int tileYOff, unsigned int tileWidth, unsigned int tileHeight, float **outputData, unsigned int outDataWidth, unsigned int outDataYOff);
         std::string inputImage;
 		std::string outputImage;
 		std::string outProjWKT;
@@ -88,6 +126,8 @@ namespace rsgis{namespace reg{
 		float outImgRes;
 		RSGISWarpImageInterpolator *interpolator;
         std::string gdalFormat;
+        unsigned int numThreads;
+        double maxTransformError;
 	};
 	
 }}
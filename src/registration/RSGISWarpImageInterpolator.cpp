@@ -57,6 +57,20 @@ namespace rsgis{namespace reg{
         delete[] dataVals;
         delete[] dsOffsets;
 	}
+    
+    void RSGISWarpImageNNInterpolator::calcValue(float **winData, unsigned int winWidth, unsigned int winHeight, float *outValues, unsigned int numOutVals, double eastings, double northings, unsigned int xPxl, unsigned int yPxl, float inImgRes, float outImgRes)
+    {
+        if((xPxl >= winWidth) || (yPxl >= winHeight))
+        {
+            throw RSGISImageWarpException("The pixel is outside of the window read from the input image.");
+        }
+        
+        size_t idx = (((size_t)yPxl) * winWidth) + xPxl;
+        for(unsigned int i = 0; i < numOutVals; ++i)
+		{
+			outValues[i] = winData[i][idx];
+		}
+    }
 
 }}
 
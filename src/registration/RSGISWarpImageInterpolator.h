@@ -57,6 +57,15 @@ namespace rsgis{namespace reg{
 	{
 	public:
 		virtual void calcValue(GDALDataset *image, float *outValues, unsigned int numOutVals, double eastings, double northings, unsigned int xPxl, unsigned int yPxl, float inImgRes, float outImgRes) = 0;
+        /**
+         * Calculates the value from a window of the input image which has been read into
+         * memory (one array per band, winWidth x winHeight). xPxl and yPxl are relative
+         * to the window, which includes getWindowBorder() pixels around the pixel where
+         * they are within the image.
+         */
+        virtual void calcValue(float **winData, unsigned int winWidth, unsigned int winHeight, float *outValues, unsigned int numOutVals, double eastings, double northings, unsigned int xPxl, unsigned int yPxl, float inImgRes, float outImgRes) = 0;
+        /** The number of pixels around the nearest pixel used to calculate the value. */
+        virtual unsigned int getWindowBorder() = 0;
 		virtual ~RSGISWarpImageInterpolator(){};
 	};
 		
@@ -65,6 +74,8 @@ namespace rsgis{namespace reg{
 	public:
 		RSGISWarpImageNNInterpolator(){};
 		void calcValue(GDALDataset *image, float *outValues, unsigned int numOutVals, double eastings, double northings, unsigned int xPxl, unsigned int yPxl, float inImgRes, float outImgRes);
+        void calcValue(float **winData, unsigned int winWidth, unsigned int winHeight, float *outValues, unsigned int numOutVals, double eastings, double northings, unsigned int xPxl, unsigned int yPxl, float inImgRes, float outImgRes);
+        unsigned int getWindowBorder(){return 0;};
 		~RSGISWarpImageNNInterpolator(){};
 	};
 	
@@ -26,7 +26,7 @@
 
 namespace rsgis{namespace reg{
 
-	RSGISWarpImageUsingTriangulation::RSGISWarpImageUsingTriangulation(std::string inputImage, std::string outputImage, std::string outProjWKT, std::string gcpFilePath, float outImgRes, RSGISWarpImageInterpolator *interpolator, std::string gdalFormat) : RSGISWarpImage(inputImage, outputImage, outProjWKT, gcpFilePath, outImgRes, interpolator, gdalFormat), dt(NULL), values(NULL)
+	RSGISWarpImageUsingTriangulation::RSGISWarpImageUsingTriangulation(std::string inputImage, std::string outputImage, std::string outProjWKT, std::string gcpFilePath, float outImgRes, RSGISWarpImageInterpolator *interpolator, std::string gdalFormat, unsigned int numThreads, double maxTransformError) : RSGISWarpImage(inputImage, outputImage, outProjWKT, gcpFilePath, outImgRes, interpolator, gdalFormat, numThreads, maxTransformError), dt(NULL), values(NULL)
 	{
         
 	}
@@ -113,7 +113,7 @@ namespace rsgis{namespace reg{
 		return env;
 	}
 	
-	void RSGISWarpImageUsingTriangulation::findNearestPixel(double eastings, double northings, unsigned int *x, unsigned int *y, float inImgRes)
+	void RSGISWarpImageUsingTriangulation::findPixelLocation(double eastings, double northings, double *x, double *y, float inImgRes)
 	{
 		CGALPoint p(eastings, northings);
         Vertex_handle vh = dt->nearest_vertex(p);
@@ -149,9 +149,9 @@ namespace rsgis{namespace reg{
 		double planeC = 0;
 		
 		this->fitPlane2XPoints(normTriPts, &planeA, &planeB, &planeC);
-		*x = floor(planeC+0.5);
+		*x = planeC;
 		this->fitPlane2YPoints(normTriPts, &planeA, &planeB, &planeC);
-		*y = floor(planeC+0.5);
+		*y = planeC;
 		
         std::list<RSGISGCPImg2MapNode*>::iterator iterGCPs;
 		for(iterGCPs = normTriPts->begin(); iterGCPs != normTriPts->end(); )
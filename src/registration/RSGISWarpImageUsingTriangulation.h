@@ -78,12 +78,14 @@ namespace rsgis{namespace reg{
 	class DllExport RSGISWarpImageUsingTriangulation : public RSGISWarpImage
 	{
 	public:
-		RSGISWarpImageUsingTriangulation(std::string inputImage, std::string outputImage, std::string outProjWKT, std::string gcpFilePath, float outImgRes, RSGISWarpImageInterpolator *interpolator, std::string gdalFormat);
+		RSGISWarpImageUsingTriangulation(std::string inputImage, std::string outputImage, std::string outProjWKT, std::string gcpFilePath, float outImgRes, RSGISWarpImageInterpolator *interpolator, std::string gdalFormat, unsigned int numThreads=1, double maxTransformError=0);
 		void initWarp();
 		~RSGISWarpImageUsingTriangulation();
 	protected:
         geos::geom::Envelope* newImageExtent(unsigned int width, unsigned int height);
-		void findNearestPixel(double eastings, double northings, unsigned int *x, unsigned int *y, float inImgRes);
+		void findPixelLocation(double eastings, double northings, double *x, double *y, float inImgRes);
+        /** CGAL point location uses the random number generator held by the triangulation so cannot be called from multiple threads. */
+        bool isThreadSafe(){return false;};
 		std::list<RSGISGCPImg2MapNode*>* normGCPs(std::list<const RSGISGCPImg2MapNode*> *gcps, double eastings, double northings);
 		void fitPlane2XPoints(std::list<RSGISGCPImg2MapNode*> *normPts, double *a, double *b, double *c);
 		void fitPlane2YPoints(std::list<RSGISGCPImg2MapNode*> *normPts, double *a, double *b, double *c);
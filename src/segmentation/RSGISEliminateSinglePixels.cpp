@@ -56,26 +56,12 @@ namespace rsgis{namespace segment{
             outData = imgUtils.createCopy(inClumpsData, outputImage, format, GDT_UInt32, projFromImage, proj);
             imgUtils.copyUIntGDALDataset(inClumpsData, outData);
             
-            unsigned long singlesCount = 0;
-            bool singlesRemoved = false;
-            
-            while(!singlesRemoved)
+            std::vector<size_t> singles;
+            unsigned long singlesCount = this->findSinglePixels(outData, tmpData, noDataVal, noDataValProvided, &singles);
+            if(singlesCount > 0)
             {
-                singlesCount = this->findSinglePixels(outData, tmpData, noDataVal, noDataValProvided);
-                if(singlesCount > 0)
-                {
-                    std::cout << "There are " << singlesCount << " single pixels within the image\n";
-                    if(!eliminateSinglePixels(inSpecData, outData, tmpData, outData, noDataVal, noDataValProvided))
-                    {
-                        singlesRemoved = true;
-                        break;
-                    }
-                }
-                else
-                {
-                    singlesRemoved = true;
-                    break;
-                }
+                std::cout << "There are " << singlesCount << " single pixels within the image\n";
+                this->eliminateSinglePixels(inSpecData, outData, &singles, noDataVal, noDataValProvided);
             }
             std::cout << "Complete, all connected single pixels have been removed\n";
             
@@ -175,7 +161,7 @@ namespace rsgis{namespace segment{
         }
     }
     
-    unsigned long RSGISEliminateSinglePixels::findSinglePixels(GDALDataset *inClumpsData, GDALDataset *tmpData, float noDataVal, bool noDataValProvided) 
+    unsigned long RSGISEliminateSinglePixels::findSinglePixels(GDALDataset *inClumpsData, GDALDataset *tmpData, float noDataVal, bool noDataValProvided, std::vector<size_t> *singles) 
     {
         unsigned long countSingles = 0;
         try 
@@ -269,6 +255,7 @@ namespace rsgis{namespace segment{
                         else
                         {
                             outData[j] = 1;
+                            singles->push_back((((size_t)i) * width) + j);
                             ++countSingles;
                         }
                     }
@@ -339,6 +326,7 @@ namespace rsgis{namespace segment{
                         else
                         {
                             outData[j] = 1;
+                            singles->push_back((((size_t)i) * width) + j);
                             ++countSingles;
                         }
                     }
@@ -425,6 +413,7 @@ namespace rsgis{namespace segment{
                         else
                         {
                             outData[j] = 1;
+                            singles->push_back((((size_t)i) * width) + j);
                             ++countSingles;
                         }
                     }
@@ -448,721 +437,193 @@ namespace rsgis{namespace segment{
         return countSingles;
     }
     
-    bool RSGISEliminateSinglePixels::eliminateSinglePixels(GDALDataset *inSpecData, GDALDataset *inClumpsData, GDALDataset *tmpData, GDALDataset *outDataset, float noDataVal, bool noDataValProvided) 
+    bool RSGISEliminateSinglePixels::eliminateSinglePixels(GDALDataset *inSpecData, GDALDataset *outDataset, std::vector<size_t> *singles, float noDataVal, bool noDataValProvided)
     {
         bool hasChangeOccured = false;
-        try 
+        try
         {
-            unsigned int width = inClumpsData->GetRasterXSize();
-            unsigned int height = inClumpsData->GetRasterYSize();
+            unsigned int width = outDataset->GetRasterXSize();
+            unsigned int height = outDataset->GetRasterYSize();
             unsigned int numBands = inSpecData->GetRasterCount();
             
-            GDALRasterBand *clumpBand = inClumpsData->GetRasterBand(1);
-            GDALRasterBand *singlePxlBand = tmpData->GetRasterBand(1);
-            GDALRasterBand *outBand = outDataset->GetRasterBand(1);
-            GDALRasterBand **specBands = new GDALRasterBand*[numBands];
+            // top, bottom, left, right
+            const int nOffX[] = {0, 0, -1, 1};
+            const int nOffY[] = {-1, 1, 0, 0};
             
-            unsigned int **inData = new unsigned int*[3];
-            inData[0] = new unsigned int[width];
-            inData[1] = new unsigned int[width];
-            inData[2] = new unsigned int[width];
-            
-            unsigned int **singlePxl = new unsigned int*[3];
-            singlePxl[0] = new unsigned int[width];
-            singlePxl[1] = new unsigned int[width];
-            singlePxl[2] = new unsigned int[width];
-                        
-            float ***specData = new float**[3];
-            specData[0] = new float*[numBands];
-            specData[1] = new float*[numBands];
-            specData[2] = new float*[numBands];
-            for(unsigned int i = 0; i < numBands; ++i)
+            rsgis::img::RSGISImageBlockCache<unsigned int> clumpsCache(outDataset, GDT_UInt32);
+            // The spectral blocks hold all the bands so the cache is limited to the memory of
+            // the default cache for a single band, but is at least two rows of blocks across
+            // the image so the neighbours above and below a pixel do not evict each other.
+            size_t specMaxNumBlocks = RSGIS_IMG_BLOCK_CACHE_MAX_BLOCKS / ((numBands > 0)?numBands:1);
+            size_t numXBlocks = (width + RSGIS_IMG_BLOCK_CACHE_BLOCK_SIZE - 1) / RSGIS_IMG_BLOCK_CACHE_BLOCK_SIZE;
+            if(specMaxNumBlocks < (2 * numXBlocks))
             {
-                specData[0][i] = new float[width];
-                specData[1][i] = new float[width];
-                specData[2][i] = new float[width];
-                specBands[i] = inSpecData->GetRasterBand(i+1);
+                specMaxNumBlocks = 2 * numXBlocks;
             }
+            rsgis::img::RSGISImageBlockCache<float> specCache(inSpecData, GDT_Float32, RSGIS_IMG_BLOCK_CACHE_BLOCK_SIZE, specMaxNumBlocks);
+            std::unordered_set<size_t> singlesSet(singles->begin(), singles->end());
             
-            unsigned int *outData = new unsigned int[width];
+            float *valsCentre = new float[numBands];
+            float *vals = new float[numBands];
+            
+            std::vector<size_t> changedPxls;
+            std::vector<unsigned int> changedVals;
+            std::vector<size_t> unchangedPxls;
+            unsigned int x = 0;
+            unsigned int y = 0;
+            long nX = 0;
+            long nY = 0;
+            size_t nIdx = 0;
             bool first = true;
-            float minDist = 0;
+            bool noDataCol = true;
             float dist = 0;
+            float minDist = 0;
             unsigned int minDistVal = 0;
             
-            int feedback = height/10;
-            int feedbackCounter = 0;
-            std::cout << "Started" << std::flush;
-            for(unsigned int i = 0; i < height; ++i)
+            // Each pass uses the clumps and single pixels from the end of the previous pass.
+            // A changed pixel takes the clump of a neighbour which is not single so is not
+            // single afterwards and a pixel which is not single never changes, so only the
+            // unchanged single pixels need checking for the next pass.
+            unsigned int passCount = 0;
+            while(!singles->empty())
             {
-                if((i % feedback) == 0)
+                changedPxls.clear();
+                changedVals.clear();
+                unchangedPxls.clear();
+                for(std::vector<size_t>::iterator iterPxls = singles->begin(); iterPxls != singles->end(); ++iterPxls)
                 {
-                    std::cout << "." << feedbackCounter << "." << std::flush;
-                    feedbackCounter = feedbackCounter + 10;
-                }
-                if(i == 0)
-                {
-                    clumpBand->RasterIO(GF_Read, 0, i, width, 1, inData[1], width, 1, GDT_UInt32, 0, 0);
-                    clumpBand->RasterIO(GF_Read, 0, i+1, width, 1, inData[2], width, 1, GDT_UInt32, 0, 0);
-                    singlePxlBand->RasterIO(GF_Read, 0, i, width, 1, singlePxl[1], width, 1, GDT_UInt32, 0, 0);
-                    singlePxlBand->RasterIO(GF_Read, 0, i+1, width, 1, singlePxl[2], width, 1, GDT_UInt32, 0, 0);
+                    x = (*iterPxls) % width;
+                    y = (*iterPxls) / width;
                     for(unsigned int n = 0; n < numBands; ++n)
                     {
-                        specBands[n]->RasterIO(GF_Read, 0, i, width, 1, specData[1][n], width, 1, GDT_Float32, 0, 0);
-                        specBands[n]->RasterIO(GF_Read, 0, i+1, width, 1, specData[2][n], width, 1, GDT_Float32, 0, 0);
+                        valsCentre[n] = specCache.getValue(x, y, n);
                     }
                     
-                    for(unsigned int j = 0; j < width; ++j)
+                    first = true;
+                    minDist = 0;
+                    minDistVal = 0;
+                    for(unsigned int k = 0; k < 4; ++k)
                     {
-                        if((noDataValProvided & (inData[1][j] != noDataVal)) | !noDataValProvided)
+                        nX = ((long)x) + nOffX[k];
+                        nY = ((long)y) + nOffY[k];
+                        if((nX < 0) || (nX >= ((long)width)) || (nY < 0) || (nY >= ((long)height)))
                         {
-                            if(singlePxl[1][j] == 1)
-                            {
-                                if(j == 0)
-                                {
-                                    first = true;
-                                    minDist = 0;
-                                    minDistVal = 0;
-                                    
-                                    //right
-                                    if((j < width-1) && (singlePxl[1][j+1] == 0))
-                                    {
-                                        dist = this->eucDistance(specData[1], specData[1], numBands, j+1, j);
-                                        if(first)
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[1][j+1];
-                                        }
-                                        else if(dist < minDist) 
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[1][j+1];
-                                        }
-                                    }
-                                    //bottom
-                                    else if(singlePxl[2][j] == 0)
-                                    {
-                                        dist = this->eucDistance(specData[2], specData[1], numBands, j, j);
-                                        if(first)
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[2][j];
-                                            first = false;
-                                        }
-                                        else if(dist < minDist) 
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[2][j];
-                                        }
-                                    }
-                                    
-                                    if(first)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = minDistVal;
-                                        hasChangeOccured = true;
-                                    }
-                                }
-                                else if(j == (width-1))
-                                {
-                                    first = true;
-                                    minDist = 0;
-                                    minDistVal = 0;
-                                    
-                                    //left
-                                    if((j > 0) && (singlePxl[1][j-1] == 0))
-                                    {
-                                        dist = this->eucDistance(specData[1], specData[1], numBands, j-1, j);
-                                        if(first)
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[1][j-1];
-                                            first = false;
-                                        }
-                                        else if(dist < minDist) 
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[1][j-1];
-                                        }
-                                    }
-                                    //bottom
-                                    else if(singlePxl[2][j] == 0)
-                                    {
-                                        dist = this->eucDistance(specData[2], specData[1], numBands, j, j);
-                                        if(first)
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[2][j];
-                                            first = false;
-                                        }
-                                        else if(dist < minDist) 
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[2][j];
-                                        }
-                                    }
-                                    
-                                    if(first)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = minDistVal;
-                                        hasChangeOccured = true;
-                                    }
-                                }
-                                else 
-                                {
-                                    first = true;
-                                    minDist = 0;
-                                    minDistVal = 0;
-                                    
-                                    //left
-                                    if((j > 0) && (singlePxl[1][j-1] == 0))
-                                    {
-                                        dist = this->eucDistance(specData[1], specData[1], numBands, j-1, j);
-                                        if(first)
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[1][j-1];
-                                            first = false;
-                                        }
-                                        else if(dist < minDist) 
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[1][j-1];
-                                        }
-                                    }
-                                    //right
-                                    else if((j < width-1) && (singlePxl[1][j+1] == 0))
-                                    {
-                                        dist = this->eucDistance(specData[1], specData[1], numBands, j+1, j);
-                                        if(first)
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[1][j+1];
-                                            first = false;
-                                        }
-                                        else if(dist < minDist) 
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[1][j+1];
-                                        }
-                                    }
-                                    //bottom
-                                    else if(singlePxl[2][j] == 0)
-                                    {
-                                        dist = this->eucDistance(specData[2], specData[1], numBands, j, j);
-                                        if(first)
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[2][j];
-                                            first = false;
-                                        }
-                                        else if(dist < minDist) 
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[2][j];
-                                        }
-                                    }
-                                    
-                                    if(first)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = minDistVal;
-                                        hasChangeOccured = true;
-                                    }
-                                }
-                            }
-                            else
+                            continue;
+                        }
+                        nIdx = (((size_t)nY) * width) + nX;
+                        if(singlesSet.count(nIdx) > 0)
+                        {
+                            continue;
+                        }
+                        
+                        noDataCol = noDataValProvided;
+                        for(unsigned int n = 0; n < numBands; ++n)
+                        {
+                            vals[n] = specCache.getValue(nX, nY, n);
+                            if(vals[n] != noDataVal)
                             {
-                                outData[j] = inData[1][j];
+                                noDataCol = false;
                             }
                         }
-                        else
+                        if(noDataCol)
                         {
-                            outData[j] = inData[1][j];
+                            continue;
+                        }
+                        
+                        dist = this->eucDistance(valsCentre, vals, numBands);
+                        if(first || (dist < minDist))
+                        {
+                            minDist = dist;
+                            minDistVal = clumpsCache.getValue(nX, nY);
+                            first = false;
                         }
                     }
                     
-                }
-                else if(i == (height-1))
-                {
-                    clumpBand->RasterIO(GF_Read, 0, i-1, width, 1, inData[0], width, 1, GDT_UInt32, 0, 0);
-                    clumpBand->RasterIO(GF_Read, 0, i, width, 1, inData[1], width, 1, GDT_UInt32, 0, 0);
-                    singlePxlBand->RasterIO(GF_Read, 0, i-1, width, 1, singlePxl[0], width, 1, GDT_UInt32, 0, 0);
-                    singlePxlBand->RasterIO(GF_Read, 0, i, width, 1, singlePxl[1], width, 1, GDT_UInt32, 0, 0);
-                    for(unsigned int n = 0; n < numBands; ++n)
+                    if(first)
                     {
-                        specBands[n]->RasterIO(GF_Read, 0, i-1, width, 1, specData[0][n], width, 1, GDT_Float32, 0, 0);
-                        specBands[n]->RasterIO(GF_Read, 0, i, width, 1, specData[1][n], width, 1, GDT_Float32, 0, 0);
+                        unchangedPxls.push_back(*iterPxls);
                     }
-                    
-                    for(unsigned int j = 0; j < width; ++j)
+                    else
                     {
-                        if((noDataValProvided & (inData[1][j] != noDataVal)) | !noDataValProvided)
-                        {
-                            if(singlePxl[1][j] == 1)
-                            {
-                                if(j == 0)
-                                {
-                                    first = true;
-                                    minDist = 0;
-                                    minDistVal = 0;
-                                    //top
-                                    if(singlePxl[0][j] == 0)
-                                    {
-                                        dist = this->eucDistance(specData[0], specData[1], numBands, j, j);
-                                        if(first)
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[0][j];
-                                            first = false;
-                                        }
-                                        else if(dist < minDist) 
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[0][j];
-                                        }
-                                    }
-                                    //right
-                                    else if((j < width-1) && (singlePxl[1][j+1] == 0))
-                                    {
-                                        dist = this->eucDistance(specData[1], specData[1], numBands, j+1, j);
-                                        if(first)
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[1][j+1];
-                                            first = false;
-                                        }
-                                        else if(dist < minDist) 
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[1][j+1];
-                                        }
-                                    }
-                                    
-                                    if(first)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = minDistVal;
-                                        hasChangeOccured = true;
-                                    }
-                                }
-                                else if(j == (width-1))
-                                {
-                                    first = true;
-                                    minDist = 0;
-                                    minDistVal = 0;
-                                    //top
-                                    if(singlePxl[0][j] == 0)
-                                    {
-                                        dist = this->eucDistance(specData[0], specData[1], numBands, j, j);
-                                        if(first)
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[0][j];
-                                            first = false;
-                                        }
-                                        else if(dist < minDist) 
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[0][j];
-                                        }
-                                    }
-                                    //left
-                                    else if((j > 0) && (singlePxl[1][j-1] == 0))
-                                    {
-                                        dist = this->eucDistance(specData[1], specData[1], numBands, j-1, j);
-                                        if(first)
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[1][j-1];
-                                            first = false;
-                                        }
-                                        else if(dist < minDist) 
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[1][j-1];
-                                        }
-                                    }
-                                    
-                                    if(first)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = minDistVal;
-                                        hasChangeOccured = true;
-                                    }
-                                }
-                                else 
-                                {
-                                    first = true;
-                                    minDist = 0;
-                                    minDistVal = 0;
-                                    //top
-                                    if(singlePxl[0][j] == 0)
-                                    {
-                                        dist = this->eucDistance(specData[0], specData[1], numBands, j, j);
-                                        if(first)
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[0][j];
-                                            first = false;
-                                        }
-                                        else if(dist < minDist) 
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[0][j];
-                                        }
-                                    }
-                                    //left
-                                    else if((j > 0) && (singlePxl[1][j-1] == 0))
-                                    {
-                                        dist = this->eucDistance(specData[1], specData[1], numBands, j-1, j);
-                                        if(first)
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[1][j-1];
-                                            first = false;
-                                        }
-                                        else if(dist < minDist) 
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[1][j-1];
-                                        }
-                                    }
-                                    //right
-                                    else if((j < width-1) && (singlePxl[1][j+1] == 0))
-                                    {
-                                        dist = this->eucDistance(specData[1], specData[1], numBands, j+1, j);
-                                        if(first)
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[1][j+1];
-                                            first = false;
-                                        }
-                                        else if(dist < minDist) 
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[1][j+1];
-                                        }
-                                    }
-                                    
-                                    if(first)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = minDistVal;
-                                        hasChangeOccured = true;
-                                    }
-                                }                                
-                            }
-                            else
-                            {
-                                outData[j] = inData[1][j];
-                            }
-                        }
-                        else
-                        {
-                            outData[j] = inData[1][j];
-                        }
+                        changedPxls.push_back(*iterPxls);
+                        changedVals.push_back(minDistVal);
                     }
                 }
-                else
+                
+                if(changedPxls.empty())
                 {
-                    clumpBand->RasterIO(GF_Read, 0, i-1, width, 1, inData[0], width, 1, GDT_UInt32, 0, 0);
-                    clumpBand->RasterIO(GF_Read, 0, i, width, 1, inData[1], width, 1, GDT_UInt32, 0, 0);
-                    clumpBand->RasterIO(GF_Read, 0, i+1, width, 1, inData[2], width, 1, GDT_UInt32, 0, 0);
-                    singlePxlBand->RasterIO(GF_Read, 0, i-1, width, 1, singlePxl[0], width, 1, GDT_UInt32, 0, 0);
-                    singlePxlBand->RasterIO(GF_Read, 0, i, width, 1, singlePxl[1], width, 1, GDT_UInt32, 0, 0);
-                    singlePxlBand->RasterIO(GF_Read, 0, i+1, width, 1, singlePxl[2], width, 1, GDT_UInt32, 0, 0);
-                    for(unsigned int n = 0; n < numBands; ++n)
+                    break;
+                }
+                hasChangeOccured = true;
+                
+                for(size_t i = 0; i < changedPxls.size(); ++i)
+                {
+                    clumpsCache.setValue(changedPxls.at(i) % width, changedPxls.at(i) / width, changedVals.at(i));
+                    singlesSet.erase(changedPxls.at(i));
+                }
+                
+                singles->clear();
+                for(std::vector<size_t>::iterator iterPxls = unchangedPxls.begin(); iterPxls != unchangedPxls.end(); ++iterPxls)
+                {
+                    if(this->isSinglePixel(&clumpsCache, (*iterPxls) % width, (*iterPxls) / width, noDataVal, noDataValProvided))
                     {
-                        specBands[n]->RasterIO(GF_Read, 0, i-1, width, 1, specData[0][n], width, 1, GDT_Float32, 0, 0);
-                        specBands[n]->RasterIO(GF_Read, 0, i, width, 1, specData[1][n], width, 1, GDT_Float32, 0, 0);
-                        specBands[n]->RasterIO(GF_Read, 0, i+1, width, 1, specData[2][n], width, 1, GDT_Float32, 0, 0);
+                        singles->push_back(*iterPxls);
                     }
-                    
-                    for(unsigned int j = 0; j < width; ++j)
+                    else
                     {
-                        if((noDataValProvided & (inData[1][j] != noDataVal)) | !noDataValProvided)
-                        {
-                            if(singlePxl[1][j] == 1)
-                            {
-                                if(j == 0)
-                                {
-                                    first = true;
-                                    minDist = 0;
-                                    minDistVal = 0;
-                                    //top
-                                    if(singlePxl[0][j] == 0)
-                                    {
-                                        dist = this->eucDistance(specData[0], specData[1], numBands, j, j);
-                                        if(first)
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[0][j];
-                                            first = false;
-                                        }
-                                        else if(dist < minDist) 
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[0][j];
-                                        }
-                                    }
-                                    //right
-                                    else if((j < width-1) && (singlePxl[1][j+1] == 0))
-                                    {
-                                        dist = this->eucDistance(specData[1], specData[1], numBands, j+1, j);
-                                        if(first)
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[1][j+1];
-                                            first = false;
-                                        }
-                                        else if(dist < minDist) 
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[1][j+1];
-                                        }
-                                    }
-                                    //bottom
-                                    else if(singlePxl[2][j] == 0)
-                                    {
-                                        dist = this->eucDistance(specData[2], specData[1], numBands, j, j);
-                                        if(first)
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[2][j];
-                                            first = false;
-                                        }
-                                        else if(dist < minDist) 
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[2][j];
-                                        }
-                                    }
-                                    
-                                    if(first)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = minDistVal;
-                                        hasChangeOccured = true;
-                                    }
-                                }
-                                else if(j == (width-1))
-                                {
-                                    first = true;
-                                    minDist = 0;
-                                    minDistVal = 0;
-                                    //top
-                                    if(singlePxl[0][j] == 0)
-                                    {
-                                        dist = this->eucDistance(specData[0], specData[1], numBands, j, j);
-                                        if(first)
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[0][j];
-                                            first = false;
-                                        }
-                                        else if(dist < minDist) 
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[0][j];
-                                        }
-                                    }
-                                    //left
-                                    else if((j > 0) && (singlePxl[1][j-1] == 0))
-                                    {
-                                        dist = this->eucDistance(specData[1], specData[1], numBands, j-1, j);
-                                        if(first)
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[1][j-1];
-                                            first = false;
-                                        }
-                                        else if(dist < minDist) 
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[1][j-1];
-                                        }
-                                    }
-                                    //bottom
-                                    else if(singlePxl[2][j] == 0)
-                                    {
-                                        dist = this->eucDistance(specData[2], specData[1], numBands, j, j);
-                                        if(first)
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[2][j];
-                                            first = false;
-                                        }
-                                        else if(dist < minDist) 
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[2][j];
-                                        }
-                                    }
-                                    
-                                    if(first)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = minDistVal;
-                                        hasChangeOccured = true;
-                                    }
-                                }
-                                else 
-                                {
-                                    first = true;
-                                    minDist = 0;
-                                    minDistVal = 0;
-                                    //top
-                                    if(singlePxl[0][j] == 0)
-                                    {
-                                        dist = this->eucDistance(specData[0], specData[1], numBands, j, j);
-                                        if(first)
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[0][j];
-                                            first = false;
-                                        }
-                                        else if(dist < minDist) 
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[0][j];
-                                        }
-                                    }
-                                    //left
-                                    else if((j > 0) && (singlePxl[1][j-1] == 0))
-                                    {
-                                        dist = this->eucDistance(specData[1], specData[1], numBands, j-1, j);
-                                        if(first)
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[1][j-1];
-                                            first = false;
-                                        }
-                                        else if(dist < minDist) 
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[1][j-1];
-                                        }
-                                    }
-                                    //right
-                                    else if((j < width-1) && (singlePxl[1][j+1] == 0))
-                                    {
-                                        dist = this->eucDistance(specData[1], specData[1], numBands, j+1, j);
-                                        if(first)
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[1][j+1];
-                                            first = false;
-                                        }
-                                        else if(dist < minDist) 
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[1][j+1];
-                                        }
-                                    }
-                                    //bottom
-                                    else if(singlePxl[2][j] == 0)
-                                    {
-                                        dist = this->eucDistance(specData[2], specData[1], numBands, j, j);
-                                        if(first)
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[2][j];
-                                            first = false;
-                                        }
-                                        else if(dist < minDist) 
-                                        {
-                                            minDist = dist;
-                                            minDistVal = inData[2][j];
-                                        }
-                                    }
-                                    
-                                    if(first)
-                                    {
-                                        outData[j] = inData[1][j];
-                                    }
-                                    else
-                                    {
-                                        outData[j] = minDistVal;
-                                        hasChangeOccured = true;
-                                    }
-                                }
-                            }
-                            else
-                            {
-                                outData[j] = inData[1][j];
-                            }
-                        }
-                        else
-                        {
-                            outData[j] = inData[1][j];
-                        }
+                        singlesSet.erase(*iterPxls);
                     }
                 }
-                
-                outBand->RasterIO(GF_Write, 0, i, width, 1, outData, width, 1, GDT_UInt32, 0, 0);
+                ++passCount;
+                std::cout << "Pass " << passCount << ": " << changedPxls.size() << " pixels changed, there are " << singles->size() << " single pixels remaining\n";
             }
-            std::cout << ". Complete\n";
             
-            delete[] inData[0];
-            delete[] inData[1];
-            delete[] inData[2];
-            delete[] inData;
-            delete[] singlePxl[0];
-            delete[] singlePxl[1];
-            delete[] singlePxl[2];
-            delete[] singlePxl;
-            for(unsigned int i = 0; i < numBands; ++i)
-            {
-                delete[] specData[0][i];
-                delete[] specData[1][i];
-                delete[] specData[2][i];
-            }
-            delete[] specData[0];
-            delete[] specData[1];
-            delete[] specData[2];
-            delete[] specData;
-            delete[] outData;
+            clumpsCache.flush();
+            
+            delete[] valsCentre;
+            delete[] vals;
         }
-        catch (rsgis::img::RSGISImageCalcException &e)
+        catch (RSGISImageException &e)
         {
-            throw e;
+            throw rsgis::img::RSGISImageCalcException(e.what());
         }
         
         return hasChangeOccured;
     }
     
-    float RSGISEliminateSinglePixels::eucDistance(float **vals1, float **vals2, unsigned int numBands, unsigned int col1, unsigned int col2)
+    bool RSGISEliminateSinglePixels::isSinglePixel(rsgis::img::RSGISImageBlockCache<unsigned int> *clumpsCache, unsigned int x, unsigned int y, float noDataVal, bool noDataValProvided)
+    {
+        unsigned int val = clumpsCache->getValue(x, y);
+        if(noDataValProvided && (val == noDataVal))
+        {
+            return false;
+        }
+        
+        if((y > 0) && (clumpsCache->getValue(x, y-1) == val))
+        {
+            return false;
+        }
+        if((y < clumpsCache->getHeight()-1) && (clumpsCache->getValue(x, y+1) == val))
+        {
+            return false;
+        }
+        if((x > 0) && (clumpsCache->getValue(x-1, y) == val))
+        {
+            return false;
+        }
+        if((x < clumpsCache->getWidth()-1) && (clumpsCache->getValue(x+1, y) == val))
+        {
+            return false;
+        }
+        return true;
+    }
+    
+    float RSGISEliminateSinglePixels::eucDistance(float *vals1, float *vals2, unsigned int numBands)
     {
         float dist = 0;
         for(unsigned int i = 0; i < numBands; ++i)
         {
-            dist += (vals1[i][col1] - vals2[i][col2]) * (vals1[i][col1] - vals2[i][col2]);
+            dist += (vals1[i] - vals2[i]) * (vals1[i] - vals2[i]);
         }
         
         if(dist > 0)
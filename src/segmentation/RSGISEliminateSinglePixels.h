@@ -25,11 +25,14 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include <unordered_set>
 #include <math.h>
 #include <stdlib.h>
 
 #include "img/RSGISImageUtils.h"
 #include "img/RSGISImageCalcException.h"
+#include "img/RSGISImageBlockCache.h"
 #include "math/RSGISMathsUtils.h"
 
 #include "img/RSGISCalcImageValue.h"
@@ -56,6 +59,13 @@
 
 namespace rsgis{namespace segment{
     
+    /**
+     * Merges single pixel clumps into the 4-connected neighbouring clump which is
+     * spectrally closest. eliminate() finds the single pixels once and then only
+     * revisits those pixels, holding the images in a block cache, repeating until
+     * none can be merged. eliminateBlocks() passes over the whole image using
+     * RSGISCalcImage until no changes occur.
+     */
     class DllExport RSGISEliminateSinglePixels
     {
     public:
@@ -64,9 +74,10 @@ namespace rsgis{namespace segment{
         void eliminateBlocks(GDALDataset *inSpecData, GDALDataset *inClumpsData, GDALDataset *tmpData, std::string outputImage, float noDataVal, bool noDataValProvided, bool projFromImage, std::string proj, std::string format);
         ~RSGISEliminateSinglePixels();
     private:
-        unsigned long findSinglePixels(GDALDataset *inClumpsData, GDALDataset *tmpData, float noDataVal, bool noDataValProvided);
-        bool eliminateSinglePixels(GDALDataset *inSpecData, GDALDataset *inClumpsData, GDALDataset *tmpData, GDALDataset *outDataset, float noDataVal, bool noDataValProvided);
-        inline float eucDistance(float **vals1, float **vals2, unsigned int numBands, unsigned int col1, unsigned int col2);
+        unsigned long findSinglePixels(GDALDataset *inClumpsData, GDALDataset *tmpData, float noDataVal, bool noDataValProvided, std::vector<size_t> *singles);
+        bool eliminateSinglePixels(GDALDataset *inSpecData, GDALDataset *outDataset, std::vector<size_t> *singles, float noDataVal, bool noDataValProvided);
+        bool isSinglePixel(rsgis::img::RSGISImageBlockCache<unsigned int> *clumpsCache, unsigned int x, unsigned int y, float noDataVal, bool noDataValProvided);
+        inline float eucDistance(float *vals1, float *vals2, unsigned int numBands);
     };
     
     
@@ -48,6 +48,7 @@ namespace rsgis{namespace vec{
 			inFeatureDefn = input->GetLayerDefn();
 			outFeatureDefn = outputLayer->GetLayerDefn();
 			
+			RSGISVectorFeatureWriter featWriter(outputLayer);
 			input->ResetReading();
 			while( (inFeature = input->GetNextFeature()) != NULL )
 			{		
@@ -57,19 +58,14 @@ namespace rsgis{namespace vec{
 				geometry = inFeature->GetGeometryRef();
 				if( geometry != NULL )
 				{
-					outFeature = OGRFeature::CreateFeature(outFeatureDefn);
+					outFeature = featWriter.createFeature();
 					outFeature->SetGeometry(geometry);
 					if(!ignoreAttr)
 					{
 						this->copyFeatureData(inFeature, outFeature, inFeatureDefn, outFeatureDefn);
 					}
 					
-					if( outputLayer->CreateFeature(outFeature) != OGRERR_NONE )
-					{
-						throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-					}
-					
-					OGRFeature::DestroyFeature(outFeature);
+					featWriter.writeFeature(outFeature);
 				} 
 				else 
 				{
@@ -77,6 +73,7 @@ namespace rsgis{namespace vec{
 				}
 				OGRFeature::DestroyFeature(inFeature);
 			}
+			featWriter.flush();
 		}
 		catch(RSGISVectorException &e)
 		{
@@ -34,6 +34,7 @@
 #include "common/RSGISVectorException.h"
 
 #include "vec/RSGISVectorUtils.h"
+#include "vec/RSGISVectorFeatureWriter.h"
 
 // mark all exported classes/functions with DllExport to have
 // them exported by Visual Studio
@@ -64,9 +64,7 @@ namespace rsgis{namespace vec{
 			unsigned long feedbackCounter = 0;
             unsigned long nextFeedback = 0;
 			unsigned long i = 0;
-            unsigned int transactionStep = 20000;
-            unsigned int nextTransaction = transactionStep;
-            bool openTransaction = false;
+            RSGISVectorFeatureWriter featWriter(output);
 			std::cout << "Started " << std::flush;
 			
 			input->ResetReading();
@@ -79,12 +77,6 @@ namespace rsgis{namespace vec{
                     nextFeedback = nextFeedback + feedback;
 				}
 				++i;
-
-                if(!openTransaction)
-                {
-                    output->StartTransaction();
-                    openTransaction = true;
-                }
 				
 				fid = inFeature->GetFID();
 				
@@ -122,17 +114,12 @@ namespace rsgis{namespace vec{
 				
 				if(polyOK && !nullGeometry)
 				{
-					outFeature = OGRFeature::CreateFeature(outFeatureDefn);
-					outFeature->SetGeometry(nPolygon);
+					outFeature = featWriter.createFeature();
+					outFeature->SetGeometryDirectly(nPolygon);
 					outFeature->SetFID(fid);
 					this->copyFeatureData(inFeature, outFeature, inFeatureDefn, outFeatureDefn);
 					
-					if( output->CreateFeature(outFeature) != OGRERR_NONE )
-					{
-						throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-					}
-					
-					OGRFeature::DestroyFeature(outFeature);
+					featWriter.writeFeature(outFeature);
 					numOutputted++;
 				}
 				else 
@@ -143,21 +130,10 @@ namespace rsgis{namespace vec{
                     }
 				}
 
-                if(openTransaction && (i == nextTransaction))
-                {
-                    output->CommitTransaction();
-                    openTransaction = false;
-                    nextTransaction = nextTransaction + transactionStep;
-                }
-
 				OGRFeature::DestroyFeature(inFeature);
 			}
 
-            if(openTransaction)
-            {
-                output->CommitTransaction();
-                openTransaction = false;
-            }
+            featWriter.flush();
 			std::cout << " Complete.\n";
 			
 			std::cout << numOutputted << " Polygons have been outputted from the " << numFeatures << " in the input file.\n";
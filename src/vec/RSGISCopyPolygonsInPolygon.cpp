@@ -36,9 +36,6 @@ namespace rsgis{namespace vec{
 		
 		OGRFeature *inFeature = NULL;
 		OGRFeature *outFeature = NULL;
-		OGRGeometry *geometry = NULL;
-		
-		bool polyOK = false;
 		
 		OGRFeatureDefn *inFeatureDefn = NULL;
 		OGRFeatureDefn *outFeatureDefn = NULL;
@@ -46,6 +43,9 @@ namespace rsgis{namespace vec{
 		long fid = 0;
 		long unsigned numOutputted = 0;
 		
+		geos::geom::Geometry *coverGEOSGeom = NULL;
+		const geos::geom::prep::PreparedGeometry *coverPrepGeom = NULL;
+		
 		try
 		{
 			// Copy feature defenitions for output shapefile
@@ -57,39 +57,173 @@ namespace rsgis{namespace vec{
 			
 			std::cout << "There are " << numFeatures << " to process\n";
 			
+			// The cover polygon is converted and prepared once rather than for every feature.
+			RSGISVectorUtils vecUtils;
+			coverGEOSGeom = vecUtils.convertOGRGeometry2GEOSGeometry(coverPolygon);
+			coverPrepGeom = RSGISVectorOverlayIndex::prepareGeometry(coverGEOSGeom);
+			
+			// Only read the features which intersect the envelope of the cover polygon.
+			OGREnvelope coverEnv;
+			coverPolygon->getEnvelope(&coverEnv);
+			input->SetSpatialFilterRect(coverEnv.MinX, coverEnv.MinY, coverEnv.MaxX, coverEnv.MaxY);
+			
+			RSGISVectorFeatureWriter featWriter(output);
+			RSGISOverlayIdxGeom geom;
+			geom.feat = NULL;
+			geom.env = NULL;
+			geom.idx = 0;
+			
 			input->ResetReading();
 			while( (inFeature = input->GetNextFeature()) != NULL )
 			{
 				fid = inFeature->GetFID();
 				
 				// Get Geometry.
-				polyOK = false;
-				geometry = inFeature->GetGeometryRef(); // Get geometry 
+				geom.ogrGeom = inFeature->GetGeometryRef(); // Get geometry 
+				geom.fid = fid;
+				geom.geosGeom = NULL;
+				if((geom.ogrGeom != NULL) && (coverPrepGeom != NULL))
+				{
+					geom.geosGeom = vecUtils.convertOGRGeometry2GEOSGeometry(geom.ogrGeom);
+				}
 				
 				// If coverPolygon contains polygons add to new shapefile
-				if(coverPolygon->Contains(geometry))
+				if((geom.ogrGeom != NULL) && RSGISVectorOverlayIndex::containsGeom(coverPrepGeom, coverPolygon, &geom))
 				{
 					numOutputted++;
 					
-					outFeature = OGRFeature::CreateFeature(outFeatureDefn);
-					outFeature->SetGeometry(geometry);
+					outFeature = featWriter.createFeature();
+					outFeature->SetGeometry(geom.ogrGeom);
 					outFeature->SetFID(fid);
 					this->copyFeatureData(inFeature, outFeature, inFeatureDefn, outFeatureDefn);
 					
-					if( output->CreateFeature(outFeature) != OGRERR_NONE )
+					featWriter.writeFeature(outFeature);
+				}
+				if(geom.geosGeom != NULL)
+				{
+					delete geom.geosGeom;
+				}
+				OGRFeature::DestroyFeature(inFeature);
+			}
+			featWriter.flush();
+			input->SetSpatialFilter(NULL);
+		}
+		catch(RSGISVectorException &e)
+		{
+			input->SetSpatialFilter(NULL);
+			if(coverPrepGeom != NULL)
+			{
+				delete coverPrepGeom;
+			}
+			if(coverGEOSGeom != NULL)
+			{
+				delete coverGEOSGeom;
+			}
+			throw e;
+		}
+		
+		if(coverPrepGeom != NULL)
+		{
+			delete coverPrepGeom;
+		}
+		if(coverGEOSGeom != NULL)
+		{
+			delete coverGEOSGeom;
+		}
+		return numOutputted;
+	}
+	
+	long unsigned RSGISCopyPolygonsInPolygon::copyPolygonsInPoly(RSGISVectorOverlayIndex *inputIdx, OGRFeatureDefn *inFeatureDefn, OGRLayer *output, OGRGeometry *coverPolygon, unsigned int numThreads)
+	{
+		OGRFeature *outFeature = NULL;
+		OGRFeatureDefn *outFeatureDefn = NULL;
+		long unsigned numOutputted = 0;
+		
+		geos::geom::Geometry *coverGEOSGeom = NULL;
+		geos::geom::Envelope *coverEnv = NULL;
+		std::vector<const geos::geom::prep::PreparedGeometry*> coverPrepGeoms;
+		
+		try
+		{
+			// Copy feature defenitions for output shapefile
+			this->copyFeatureDefn(output, inFeatureDefn);
+			outFeatureDefn = output->GetLayerDefn();
+			
+			numThreads = rsgis::getNumProcessingThreads(numThreads);
+			
+			RSGISVectorUtils vecUtils;
+			coverGEOSGeom = vecUtils.convertOGRGeometry2GEOSGeometry(coverPolygon);
+			coverEnv = vecUtils.getEnvelope(coverPolygon);
+			
+			// Only the features with an envelope within the cover envelope can be contained.
+			std::vector<size_t> candidates;
+			inputIdx->queryCandidates(coverEnv, &candidates, false);
+			std::vector<unsigned char> containedStatus(candidates.size(), 0);
+			
+			// Each thread has its own prepared copy of the cover polygon.
+			coverPrepGeoms.assign(numThreads, NULL);
+			rsgis::parallelForRange(0, candidates.size(), numThreads, 64, [&](size_t start, size_t end, unsigned int threadIdx)
+			{
+				if((coverPrepGeoms[threadIdx] == NULL) && (coverGEOSGeom != NULL))
+				{
+					coverPrepGeoms[threadIdx] = RSGISVectorOverlayIndex::prepareGeometry(coverGEOSGeom);
+				}
+				for(size_t i = start; i < end; ++i)
+				{
+					RSGISOverlayIdxGeom *geom = inputIdx->getGeom(candidates[i]);
+					if(coverEnv->covers(geom->env))
 					{
-						throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
+						try
+						{
+							if(RSGISVectorOverlayIndex::containsGeom(coverPrepGeoms[threadIdx], coverPolygon, geom))
+							{
+								containedStatus[i] = 1;
+							}
+						}
+						catch (geos::util::TopologyException &e) 
+						{
+							std::cout << "WARNING: " << e.what() << std::endl;
+						}
 					}
+				}
+			});
+			
+			RSGISVectorFeatureWriter featWriter(output);
+			for(size_t i = 0; i < candidates.size(); ++i)
+			{
+				if(containedStatus[i] == 1)
+				{
+					RSGISOverlayIdxGeom *geom = inputIdx->getGeom(candidates[i]);
+					numOutputted++;
+					
+					outFeature = featWriter.createFeature();
+					outFeature->SetGeometry(geom->ogrGeom);
+					outFeature->SetFID(geom->fid);
+					this->copyFeatureData(geom->feat, outFeature, inFeatureDefn, outFeatureDefn);
 					
-					OGRFeature::DestroyFeature(outFeature);
+					featWriter.writeFeature(outFeature);
 				}
-				OGRFeature::DestroyFeature(inFeature);
 			}
+			featWriter.flush();
 		}
 		catch(RSGISVectorException &e)
 		{
+			for(std::vector<const geos::geom::prep::PreparedGeometry*>::iterator iterPrep = coverPrepGeoms.begin(); iterPrep != coverPrepGeoms.end(); ++iterPrep)
+			{
+				delete (*iterPrep);
+			}
+			delete coverGEOSGeom;
+			delete coverEnv;
 			throw e;
 		}
+		
+		for(std::vector<const geos::geom::prep::PreparedGeometry*>::iterator iterPrep = coverPrepGeoms.begin(); iterPrep != coverPrepGeoms.end(); ++iterPrep)
+		{
+			delete (*iterPrep);
+		}
+		delete coverGEOSGeom;
+		delete coverEnv;
+		
 		return numOutputted;
 	}
 	
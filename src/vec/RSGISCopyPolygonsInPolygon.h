@@ -27,12 +27,16 @@
 #include <iostream>
 #include <string>
 #include <list>
+#include <vector>
 
 #include "ogrsf_frmts.h"
 
 #include "common/RSGISVectorException.h"
+#include "common/RSGISThreadUtils.h"
 
 #include "vec/RSGISVectorUtils.h"
+#include "vec/RSGISVectorFeatureWriter.h"
+#include "vec/RSGISVectorOverlayIndex.h"
 
 // mark all exported classes/functions with DllExport to have
 // them exported by Visual Studio
@@ -54,6 +58,8 @@ namespace rsgis{namespace vec{
 	public:
 		RSGISCopyPolygonsInPolygon();
 		long unsigned copyPolygonsInPoly(OGRLayer *input, OGRLayer *output, OGRGeometry *coverPolygon);
+		/** Copies the features within inputIdx (built with keepFeatures) contained by coverPolygon; the index can be reused for many cover polygons. */
+		long unsigned copyPolygonsInPoly(RSGISVectorOverlayIndex *inputIdx, OGRFeatureDefn *inFeatureDefn, OGRLayer *output, OGRGeometry *coverPolygon, unsigned int numThreads=1);
 		void copyFeatureDefn(OGRLayer *outputSHPLayer, OGRFeatureDefn *inFeatureDefn);
 		void copyFeatureData(OGRFeature *inFeature, OGRFeature *outFeature, OGRFeatureDefn *inFeatureDefn, OGRFeatureDefn *outFeatureDefn);
 		~RSGISCopyPolygonsInPolygon();
@@ -61,6 +61,7 @@ namespace rsgis{namespace vec{
 			unsigned long i = 0;
 			std::cout << "Started" << std::flush;
 			
+			RSGISVectorFeatureWriter featWriter(output);
 			input->ResetReading();
 			while( (inFeature = input->GetNextFeature()) != NULL )
 			{
@@ -87,22 +88,18 @@ namespace rsgis{namespace vec{
 				
 				if(!nullGeometry && (polygon->get_Area() > threshold))
 				{
-					outFeature = OGRFeature::CreateFeature(outFeatureDefn);
+					outFeature = featWriter.createFeature();
 					outFeature->SetGeometry(polygon);
 					outFeature->SetFID(fid);
 					this->copyFeatureData(inFeature, outFeature, inFeatureDefn, outFeatureDefn);
 					
-					if( output->CreateFeature(outFeature) != OGRERR_NONE )
-					{
-						throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-					}
-					
-					OGRFeature::DestroyFeature(outFeature);
+					featWriter.writeFeature(outFeature);
 					numOutputted++;
 				}
 				
 				OGRFeature::DestroyFeature(inFeature);
 			}
+			featWriter.flush();
 			std::cout << " Complete.\n";
 		}
 		catch(RSGISVectorException &e)
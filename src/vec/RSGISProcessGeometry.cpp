@@ -26,9 +26,11 @@
 
 namespace rsgis{namespace vec{
 	
-	RSGISProcessGeometry::RSGISProcessGeometry(RSGISProcessOGRGeometry *processGeom)
+	RSGISProcessGeometry::RSGISProcessGeometry(RSGISProcessOGRGeometry *processGeom, bool asyncWrite, unsigned long transactionSize)
 	{
 		this->processGeom = processGeom;
+		this->asyncWrite = asyncWrite;
+		this->transactionSize = transactionSize;
 	}
 	
 	void RSGISProcessGeometry::processGeometry(OGRLayer *inputLayer, OGRLayer *outputLayer, bool copyData, bool outVertical)
@@ -69,9 +71,7 @@ namespace rsgis{namespace vec{
 				std::cout << "Started " << std::flush;
 			}
 
-            unsigned int transactionStep = 20000;
-            unsigned int nextTransaction = transactionStep;
-            bool openTransaction = false;
+            RSGISVectorFeatureWriter featWriter(outputLayer, this->asyncWrite, this->transactionSize);
 
 			inputLayer->ResetReading();
 			while( (inFeature = inputLayer->GetNextFeature()) != NULL )
@@ -91,15 +91,10 @@ namespace rsgis{namespace vec{
                     nextFeedback = nextFeedback + feedback;
 				}
 
-                if(!openTransaction)
-                {
-                    outputLayer->StartTransaction();
-                    openTransaction = true;
-                }
 
 				fid = inFeature->GetFID();
 				
-				outFeature = OGRFeature::CreateFeature(outFeatureDefn);
+				outFeature = featWriter.createFeature();
 				
 				// Get Geometry.
 				geometry = inFeature->GetGeometryRef();
@@ -139,28 +134,12 @@ namespace rsgis{namespace vec{
 					this->copyFeatureData(inFeature, outFeature, inFeatureDefn, outFeatureDefn);
 				}
 				
-				if( outputLayer->CreateFeature(outFeature) != OGRERR_NONE )
-				{
-					throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-				}
-
-                if(openTransaction && (i == nextTransaction))
-                {
-                    outputLayer->CommitTransaction();
-                    openTransaction = false;
-                    nextTransaction = nextTransaction + transactionStep;
-                }
+				featWriter.writeFeature(outFeature);
 				
 				OGRFeature::DestroyFeature(inFeature);
-				OGRFeature::DestroyFeature(outFeature);
 				i++;
 			}
-
-            if(openTransaction)
-            {
-                outputLayer->CommitTransaction();
-                openTransaction = false;
-            }
+            featWriter.flush();
 			std::cout << " Complete.\n";
 			
 		}
@@ -212,9 +191,7 @@ namespace rsgis{namespace vec{
 				std::cout << "Started " << std::flush;
 			}
 
-            unsigned int transactionStep = 20000;
-            unsigned int nextTransaction = transactionStep;
-            bool openTransaction = false;
+            RSGISVectorFeatureWriter featWriter(outputLayer, this->asyncWrite, this->transactionSize);
 			
 			inputLayer->ResetReading();
 			while( (inFeature = inputLayer->GetNextFeature()) != NULL )
@@ -234,15 +211,10 @@ namespace rsgis{namespace vec{
                     nextFeedback = nextFeedback + feedback;
 				}
 
-                if(!openTransaction)
-                {
-                    outputLayer->StartTransaction();
-                    openTransaction = true;
-                }
 				
 				fid = inFeature->GetFID();
 				
-				outFeature = OGRFeature::CreateFeature(outFeatureDefn);
+				outFeature = featWriter.createFeature();
 				
 				// Get Geometry.
 				geometry = inFeature->GetGeometryRef();
@@ -263,27 +235,12 @@ namespace rsgis{namespace vec{
 					this->copyFeatureData(inFeature, outFeature, inFeatureDefn, outFeatureDefn);
 				}
 				
-				if( outputLayer->CreateFeature(outFeature) != OGRERR_NONE )
-				{
-					throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-				}
-
-                if(openTransaction && (i == nextTransaction))
-                {
-                    outputLayer->CommitTransaction();
-                    openTransaction = false;
-                    nextTransaction = nextTransaction + transactionStep;
-                }
+				featWriter.writeFeature(outFeature);
 				
 				OGRFeature::DestroyFeature(inFeature);
-				OGRFeature::DestroyFeature(outFeature);
 				i++;
 			}
-            if(openTransaction)
-            {
-                outputLayer->CommitTransaction();
-                openTransaction = false;
-            }
+            featWriter.flush();
 			std::cout << " Complete.\n";
 			
 		}
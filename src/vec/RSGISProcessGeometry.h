@@ -38,6 +38,7 @@
 #include "vec/RSGISVectorOutputException.h"
 #include "vec/RSGISProcessOGRGeometry.h"
 #include "vec/RSGISVectorUtils.h"
+#include "vec/RSGISVectorFeatureWriter.h"
 
 // mark all exported classes/functions with DllExport to have
 // them exported by Visual Studio
@@ -57,7 +58,8 @@ namespace rsgis{namespace vec{
 	class DllExport RSGISProcessGeometry
 		{
 		public:
-			RSGISProcessGeometry(RSGISProcessOGRGeometry *processGeom);
+			/** If asyncWrite is true the output layer is written on a separate thread so must not be in the same dataset as the input layer. */
+			RSGISProcessGeometry(RSGISProcessOGRGeometry *processGeom, bool asyncWrite=false, unsigned long transactionSize=RSGIS_VEC_WRITE_TRANSACTION_SIZE);
 			void processGeometry(OGRLayer *inputLayer, OGRLayer *outputLayer, bool copyData, bool outVertical);
 			void processGeometryPolygonOutput(OGRLayer *inputLayer, OGRLayer *outputLayer, bool copyData, bool outVertical);
 			~RSGISProcessGeometry();
@@ -65,6 +67,8 @@ namespace rsgis{namespace vec{
 			void copyFeatureDefn(OGRLayer *outputSHPLayer, OGRFeatureDefn *inFeatureDefn);
 			void copyFeatureData(OGRFeature *inFeature, OGRFeature *outFeature, OGRFeatureDefn *inFeatureDefn, OGRFeatureDefn *outFeatureDefn);
 			RSGISProcessOGRGeometry *processGeom;
+			bool asyncWrite;
+			unsigned long transactionSize;
 		};
 }}
 
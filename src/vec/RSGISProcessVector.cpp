@@ -25,13 +25,16 @@
 
 namespace rsgis{namespace vec{
 	
-	RSGISProcessVector::RSGISProcessVector(RSGISProcessOGRFeature *processFeatures)
+	RSGISProcessVector::RSGISProcessVector(RSGISProcessOGRFeature *processFeatures, bool asyncWrite, unsigned long transactionSize)
 	{
 		this->processFeatures = processFeatures;
+		this->asyncWrite = asyncWrite;
+		this->transactionSize = transactionSize;
 	}
 	
 	void RSGISProcessVector::processVectors(OGRLayer *inputLayer, OGRLayer *outputLayer, bool copyData, bool outVertical, bool newFirst)
 	{
+		rsgis::RSGISProgressReporter progress("RSGISProcessVector::processVectors", rsgis::rsgisFeaturesProcessed);
 		RSGISVectorUtils vecUtils;
 		
 		geos::geom::Envelope *env = NULL;
@@ -74,7 +77,8 @@ namespace rsgis{namespace vec{
 				std::cout << "Started" << std::flush;
 			}	
 
-            bool inTransaction = false;
+            RSGISVectorFeatureWriter featWriter(outputLayer, this->asyncWrite, this->transactionSize);
+			progress.start(numFeatures);
 			inputLayer->ResetReading();
 			while( (inFeature = inputLayer->GetNextFeature()) != NULL )
 			{
@@ -88,18 +92,18 @@ namespace rsgis{namespace vec{
 					{
 						std::cout << "." << feedbackCounter << "." << std::flush;
 					}
+					if(!progress.update(feedbackCounter))
+					{
+						OGRFeature::DestroyFeature(inFeature);
+						throw RSGISVectorException("The processing of the features was cancelled.");
+					}
 					
 					feedbackCounter = feedbackCounter + 10;
 				}
-                if(!inTransaction)
-                {
-                    outputLayer->StartTransaction();
-                    inTransaction = true;
-                }
 				
 				fid = inFeature->GetFID();
 				
-				outFeature = OGRFeature::CreateFeature(outFeatureDefn);
+				outFeature = featWriter.createFeature();
 
 				// Get Geometry.
 				nullGeometry = false;
@@ -152,27 +156,18 @@ namespace rsgis{namespace vec{
 						this->copyFeatureData(inFeature, outFeature, inFeatureDefn, outFeatureDefn);
 					}
 					
-					if( outputLayer->CreateFeature(outFeature) != OGRERR_NONE )
-					{
-						throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-					}
-
-					OGRFeature::DestroyFeature(outFeature);
+					featWriter.writeFeature(outFeature);
+				}
+				else
+				{
+					featWriter.discardFeature(outFeature);
 				}
 				OGRFeature::DestroyFeature(inFeature);
 				i++;
-                if(((i % 20000) == 0) & inTransaction)
-                {
-                    inputLayer->CommitTransaction();
-                    inTransaction = false;
-                }
-            }
-            if(inTransaction)
-            {
-                inputLayer->CommitTransaction();
-                inTransaction = false;
             }
+            featWriter.flush();
 			std::cout << " Complete.\n";
+			progress.complete();
 		}
 		catch(RSGISVectorOutputException& e)
 		{
@@ -186,6 +181,7 @@ namespace rsgis{namespace vec{
 		
 	void RSGISProcessVector::processVectors(OGRLayer *inputLayer, bool outVertical, bool morefeedback)
 	{
+		rsgis::RSGISProgressReporter progress("RSGISProcessVector::processVectors", rsgis::rsgisFeaturesProcessed);
 		RSGISVectorUtils vecUtils;
 		
 		geos::geom::Envelope *env = NULL;
@@ -224,7 +220,9 @@ namespace rsgis{namespace vec{
 				std::cout << "Started (" << numFeatures << " features) " << std::flush;
 			}	
 
-            bool inTransaction = false;
+            // Features are rewritten within the layer being read so can't be written asynchronously.
+            RSGISVectorFeatureWriter featWriter(inputLayer, false, this->transactionSize);
+			progress.start(numFeatures);
 			inputLayer->ResetReading();
 			while( (inFeature = inputLayer->GetNextFeature()) != NULL )
 			{
@@ -238,6 +236,11 @@ namespace rsgis{namespace vec{
 					{
 						std::cout << "." << feedbackCounter << "." << std::flush;
 					}
+					if(!progress.update(feedbackCounter))
+					{
+						OGRFeature::DestroyFeature(inFeature);
+						throw RSGISVectorException("The processing of the features was cancelled.");
+					}
 
                     if(morefeedback)
                     {
@@ -249,11 +252,6 @@ namespace rsgis{namespace vec{
                     }
                     nextFeedback = nextFeedback + feedback;
 				}
-                if(!inTransaction)
-                {
-                    inputLayer->StartTransaction();
-                    inTransaction = true;
-                }
 				
 				fid = inFeature->GetFID();
 				
@@ -297,28 +295,15 @@ namespace rsgis{namespace vec{
 					
 					delete env;
 
-					if( inputLayer->SetFeature(inFeature) != OGRERR_NONE )
-					{
-						throw RSGISVectorOutputException("Failed to write feature to the vector layer.");
-					}
+					featWriter.updateFeature(inFeature);
 				}
 				
 				OGRFeature::DestroyFeature(inFeature);
 				i++;
-                if(((i % 20000) == 0) & inTransaction)
-                {
-                    std::cout << "w" << std::flush;
-                    inputLayer->CommitTransaction();
-                    inTransaction = false;
-                }
 			}
-            if(inTransaction)
-            {
-                std::cout << "w" << std::flush;
-                inputLayer->CommitTransaction();
-                inTransaction = false;
-            }
+            featWriter.flush();
 			std::cout << " Complete.\n";
+			progress.complete();
 		}
 		catch(RSGISVectorOutputException& e)
 		{
@@ -332,6 +317,7 @@ namespace rsgis{namespace vec{
 	
 	void RSGISProcessVector::processVectorsNoOutput(OGRLayer *inputLayer, bool outVertical)
 	{
+		rsgis::RSGISProgressReporter progress("RSGISProcessVector::processVectorsNoOutput", rsgis::rsgisFeaturesProcessed);
 		RSGISVectorUtils vecUtils;
 		
 		geos::geom::Envelope *env = NULL;
@@ -364,6 +350,7 @@ namespace rsgis{namespace vec{
 			}
 			
 			
+			progress.start(numFeatures);
 			inputLayer->ResetReading();
 			while( (inFeature = inputLayer->GetNextFeature()) != NULL )
 			{
@@ -377,6 +364,11 @@ namespace rsgis{namespace vec{
 					{
 						std::cout << ".." << feedbackCounter << ".." << std::flush;
 					}
+					if(!progress.update(feedbackCounter))
+					{
+						OGRFeature::DestroyFeature(inFeature);
+						throw RSGISVectorException("The processing of the features was cancelled.");
+					}
 					
 					feedbackCounter = feedbackCounter + 10;
 				}
@@ -433,6 +425,7 @@ namespace rsgis{namespace vec{
 				i++;
 			}
 			std::cout << " Complete.\n";			
+			progress.complete();
 		}
 		catch(RSGISVectorOutputException& e)
 		{
@@ -31,12 +31,14 @@
 #include "ogrsf_frmts.h"
 
 #include "common/RSGISVectorException.h"
+#include "common/RSGISInstrumentation.h"
 
 #include "math/RSGISMathsUtils.h"
 
 #include "vec/RSGISVectorOutputException.h"
 #include "vec/RSGISProcessOGRFeature.h"
 #include "vec/RSGISVectorUtils.h"
+#include "vec/RSGISVectorFeatureWriter.h"
 
 #include "geos/geom/Envelope.h"
 
@@ -58,7 +60,8 @@ namespace rsgis{namespace vec{
 	class DllExport RSGISProcessVector
 		{
 		public:
-			RSGISProcessVector(RSGISProcessOGRFeature *processFeatures);
+			/** If asyncWrite is true the output layer is written on a separate thread so must not be in the same dataset as the input layer. */
+			RSGISProcessVector(RSGISProcessOGRFeature *processFeatures, bool asyncWrite=false, unsigned long transactionSize=RSGIS_VEC_WRITE_TRANSACTION_SIZE);
 			void processVectors(OGRLayer *inputLayer, OGRLayer *outputLayer, bool copyData, bool outVertical, bool newFirst);
 			void processVectors(OGRLayer *inputLayer, bool outVertical, bool morefeedback=false);
 			void processVectorsNoOutput(OGRLayer *inputLayer, bool outVertical);
@@ -69,6 +72,8 @@ namespace rsgis{namespace vec{
             void printGeometry(OGRGeometry *geometry);
             void printRing(OGRLinearRing *inGeomRing);
 			RSGISProcessOGRFeature *processFeatures;
+			bool asyncWrite;
+			unsigned long transactionSize;
 		};
 }}
 
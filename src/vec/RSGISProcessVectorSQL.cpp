@@ -34,6 +34,7 @@ namespace rsgis{namespace vec{
 	
 	void RSGISProcessVectorSQL::processVectors(GDALDataset *inputDS, OGRLayer *outputLayer, bool copyData, bool outVertical, std::string sql)
 	{
+		rsgis::RSGISProgressReporter progress("RSGISProcessVectorSQL::processVectors", rsgis::rsgisFeaturesProcessed);
 		RSGISVectorUtils vecUtils;
 		
 		geos::geom::Envelope *env = NULL;
@@ -91,6 +92,8 @@ namespace rsgis{namespace vec{
 					std::cout << "Started" << std::flush;
 				}				
 			}			
+			progress.start(numFeatures);
+			RSGISVectorFeatureWriter featWriter(outputLayer);
 			inputLayer->ResetReading();
 			while( (inFeature = inputLayer->GetNextFeature()) != NULL )
 			{
@@ -104,13 +107,18 @@ namespace rsgis{namespace vec{
 					{
 						std::cout << ".." << feedbackCounter << ".." << std::flush;
 					}
+					if(!progress.update(feedbackCounter))
+					{
+						OGRFeature::DestroyFeature(inFeature);
+						throw RSGISVectorException("The processing of the features was cancelled.");
+					}
 					
 					feedbackCounter = feedbackCounter + 10;
 				}
 				
 				fid = inFeature->GetFID();
 				
-				outFeature = OGRFeature::CreateFeature(outFeatureDefn);
+				outFeature = featWriter.createFeature();
 				
 				// Get Geometry.
 				nullGeometry = false;
@@ -142,6 +150,8 @@ namespace rsgis{namespace vec{
 				else if(geometry != NULL)
 				{
 					std::string message = std::string("Unsupport data type: ") + std::string(geometry->getGeometryName());
+					featWriter.discardFeature(outFeature);
+					OGRFeature::DestroyFeature(inFeature);
 					throw RSGISVectorException(message);
 				}
 				else 
@@ -163,21 +173,22 @@ namespace rsgis{namespace vec{
 						this->copyFeatureData(inFeature, outFeature, inFeatureDefn, outFeatureDefn);
 					}
 					
-					if( outputLayer->CreateFeature(outFeature) != OGRERR_NONE )
-					{
-						throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-					}
-					
-					OGRFeature::DestroyFeature(outFeature);
+					featWriter.writeFeature(outFeature);
+				}
+				else
+				{
+					featWriter.discardFeature(outFeature);
 				}
 				
 				OGRFeature::DestroyFeature(inFeature);
 				i++;
 			}
+			featWriter.flush();
 			if(toFeedback)
 			{
 				std::cout << " Complete.\n";
 			}
+			progress.complete();
 		}
 		catch(RSGISVectorOutputException& e)
 		{
@@ -191,6 +202,7 @@ namespace rsgis{namespace vec{
 	
 	void RSGISProcessVectorSQL::processVectors(GDALDataset *inputDS, bool outVertical, std::string sql)
 	{
+		rsgis::RSGISProgressReporter progress("RSGISProcessVectorSQL::processVectors", rsgis::rsgisFeaturesProcessed);
 		RSGISVectorUtils vecUtils;
 		
 		geos::geom::Envelope *env = NULL;
@@ -237,6 +249,7 @@ namespace rsgis{namespace vec{
 				}				
 			}
 			
+			progress.start(numFeatures);
 			inputLayer->ResetReading();
 			while( (inFeature = inputLayer->GetNextFeature()) != NULL )
 			{
@@ -250,6 +263,11 @@ namespace rsgis{namespace vec{
 					{
 						std::cout << ".." << feedbackCounter << ".." << std::flush;
 					}
+					if(!progress.update(feedbackCounter))
+					{
+						OGRFeature::DestroyFeature(inFeature);
+						throw RSGISVectorException("The processing of the features was cancelled.");
+					}
 					
 					feedbackCounter = feedbackCounter + 10;
 				}
@@ -309,6 +327,7 @@ namespace rsgis{namespace vec{
 			{
 				std::cout << " Complete.\n";
 			}
+			progress.complete();
 		}
 		catch(RSGISVectorOutputException& e)
 		{
@@ -322,6 +341,7 @@ namespace rsgis{namespace vec{
 	
 	void RSGISProcessVectorSQL::processVectorsNoOutput(GDALDataset *inputDS, bool outVertical, std::string sql)
 	{
+		rsgis::RSGISProgressReporter progress("RSGISProcessVectorSQL::processVectorsNoOutput", rsgis::rsgisFeaturesProcessed);
 		RSGISVectorUtils vecUtils;
 		
 		geos::geom::Envelope *env = NULL;
@@ -368,6 +388,7 @@ namespace rsgis{namespace vec{
 			}
 			
 			
+			progress.start(numFeatures);
 			inputLayer->ResetReading();
 			while( (inFeature = inputLayer->GetNextFeature()) != NULL )
 			{
@@ -381,6 +402,11 @@ namespace rsgis{namespace vec{
 					{
 						std::cout << ".." << feedbackCounter << ".." << std::flush;
 					}
+					if(!progress.update(feedbackCounter))
+					{
+						OGRFeature::DestroyFeature(inFeature);
+						throw RSGISVectorException("The processing of the features was cancelled.");
+					}
 					
 					feedbackCounter = feedbackCounter + 10;
 				}
@@ -435,6 +461,7 @@ namespace rsgis{namespace vec{
 			{
 				std::cout << " Complete.\n";
 			}			
+			progress.complete();
 		}
 		catch(RSGISVectorOutputException& e)
 		{
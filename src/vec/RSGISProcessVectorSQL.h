@@ -31,12 +31,14 @@
 #include "ogrsf_frmts.h"
 
 #include "common/RSGISVectorException.h"
+#include "common/RSGISInstrumentation.h"
 
 #include "math/RSGISMathsUtils.h"
 
 #include "vec/RSGISVectorOutputException.h"
 #include "vec/RSGISProcessOGRFeature.h"
 #include "vec/RSGISVectorUtils.h"
+#include "vec/RSGISVectorFeatureWriter.h"
 
 #include "geos/geom/Envelope.h"
 
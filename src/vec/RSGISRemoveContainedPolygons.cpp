@@ -32,21 +32,11 @@ namespace rsgis{namespace vec{
 		
 	}
 	
-	long unsigned RSGISRemoveContainedPolygons::removeContainedPolygons(OGRLayer *input, OGRLayer *output)
-	{		
-		OGRFeature *inFeature = NULL;
-		OGRFeature *tmpFeature = NULL;
-		OGRFeature *outFeature = NULL;
-		OGRGeometry *geometry = NULL;
-		OGRGeometry *tmpGeometry = NULL;
-
-		bool geomContained = false;
-		
+	long unsigned RSGISRemoveContainedPolygons::removeContainedPolygons(OGRLayer *input, OGRLayer *output, unsigned int numThreads)
+	{
 		OGRFeatureDefn *inFeatureDefn = NULL;
 		OGRFeatureDefn *outFeatureDefn = NULL;
 		
-		unsigned long currentFID = 0;
-		unsigned long tmpFID = 0;
 		unsigned long numOutputted = 0;
 		
 		try
@@ -56,75 +46,57 @@ namespace rsgis{namespace vec{
 			this->copyFeatureDefn(output, inFeatureDefn);
 			outFeatureDefn = output->GetLayerDefn();
 			
-			unsigned long numFeatures = input->GetFeatureCount(true);
+			numThreads = rsgis::getNumProcessingThreads(numThreads);
+			
+			// Read the features once and index their envelopes so only the polygons 
+			// whose envelope covers the envelope of a polygon are tested for containment.
+			RSGISVectorOverlayIndex inIdx;
+			inIdx.addLayer(input, true);
+			inIdx.build(numThreads);
 			
-			for(unsigned long i = 0; i < numFeatures; ++i)
+			size_t numGeoms = inIdx.getNumGeoms();
+			std::vector<unsigned char> containedStatus(numGeoms, 0);
+			
+			rsgis::parallelForRange(0, numGeoms, numThreads, 256, [&](size_t start, size_t end, unsigned int threadIdx)
 			{
-				geomContained = false;
-				inFeature = input->GetFeature(i);
-				
-				currentFID = inFeature->GetFID();
-				
-				geometry = inFeature->GetGeometryRef(); // Get geometry 
-				
-				if( geometry != NULL )
-				{					
-					for(unsigned long j = 0; j < numFeatures; ++j)
+				std::vector<size_t> candidates;
+				for(size_t i = start; i < end; ++i)
+				{
+					RSGISOverlayIdxGeom *geom = inIdx.getGeom(i);
+					if(geom->ogrGeom == NULL)
+					{
+						containedStatus[i] = 2;
+						continue;
+					}
+					else if(geom->env == NULL)
 					{
-						tmpFeature = input->GetFeature(j);
-						tmpFID = tmpFeature->GetFID();
-						
-						if(currentFID != tmpFID)
+						// Empty geometries are not contained by anything.
+						continue;
+					}
+					
+					inIdx.queryCandidates(geom->env, &candidates, true);
+					for(std::vector<size_t>::iterator iterCands = candidates.begin(); iterCands != candidates.end(); ++iterCands)
+					{
+						if((*iterCands) != i)
 						{
-							tmpGeometry = tmpFeature->GetGeometryRef();
-							if( tmpGeometry != NULL )
+							try 
 							{
-								try 
-								{
-									if(tmpGeometry->Contains(geometry))
-									{
-										geomContained = true;
-										break;
-									}
-								}
-								catch (geos::util::TopologyException &e) 
+								if(inIdx.containsGeom((*iterCands), geom, threadIdx))
 								{
-									std::cout << "WARNING: " << e.what() << std::endl;
+									containedStatus[i] = 1;
+									break;
 								}
-								
 							}
-							else 
+							catch (geos::util::TopologyException &e) 
 							{
-								std::cout << "Tmp Geometry is NULL - IGNORING...\n";
+								std::cout << "WARNING: " << e.what() << std::endl;
 							}
 						}
-						OGRFeature::DestroyFeature(tmpFeature);
 					}
-				
-				
-					if(!geomContained)
-					{
-						numOutputted++;
-						
-						outFeature = OGRFeature::CreateFeature(outFeatureDefn);
-						outFeature->SetGeometry(geometry);
-						outFeature->SetFID(currentFID);
-						this->copyFeatureData(inFeature, outFeature, inFeatureDefn, outFeatureDefn);
-						
-						if( output->CreateFeature(outFeature) != OGRERR_NONE )
-						{
-							throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-						}
-						
-						OGRFeature::DestroyFeature(outFeature);
-					}
-					OGRFeature::DestroyFeature(inFeature);
 				}
-				else 
-				{
-					std::cout << "Current Geometry is NULL - IGNORING...\n";
-				}
-			}
+			});
+			
+			numOutputted = this->writeUncontainedFeatures(&inIdx, &containedStatus, output, inFeatureDefn, outFeatureDefn);
 		}
 		catch(RSGISVectorException &e)
 		{
@@ -133,22 +105,13 @@ namespace rsgis{namespace vec{
 		return numOutputted;
 	}
 	
-	long unsigned RSGISRemoveContainedPolygons::removeContainedPolygons(OGRLayer *input, OGRLayer *output, std::vector<OGRPolygon*> *inputPolys)
+	long unsigned RSGISRemoveContainedPolygons::removeContainedPolygons(OGRLayer *input, OGRLayer *output, std::vector<OGRPolygon*> *inputPolys, unsigned int numThreads)
 	{
-		OGRFeature *inFeature = NULL;
-		OGRFeature *outFeature = NULL;
-		OGRGeometry *geometry = NULL;
-		
-		bool geomContained = false;
-		
 		OGRFeatureDefn *inFeatureDefn = NULL;
 		OGRFeatureDefn *outFeatureDefn = NULL;
 		
-		unsigned long currentFID = 0;
 		unsigned long numOutputted = 0;
 		
-		std::vector<OGRPolygon*>::iterator iterPolys;
-		
 		try
 		{
 			// Copy feature defenitions for output shapefile
@@ -156,26 +119,47 @@ namespace rsgis{namespace vec{
 			this->copyFeatureDefn(output, inFeatureDefn);
 			outFeatureDefn = output->GetLayerDefn();
 			
-			unsigned long numFeatures = input->GetFeatureCount(true);
+			numThreads = rsgis::getNumProcessingThreads(numThreads);
 			
-			for(unsigned long i = 0; i < numFeatures; ++i)
+			RSGISVectorOverlayIndex polysIdx;
+			for(size_t i = 0; i < inputPolys->size(); ++i)
 			{
-				geomContained = false;
-				inFeature = input->GetFeature(i);
-				
-				currentFID = inFeature->GetFID();
-				
-				geometry = inFeature->GetGeometryRef(); // Get geometry 
-				
-				if( geometry != NULL )
-				{					
-					for(iterPolys = inputPolys->begin(); iterPolys != inputPolys->end(); ++iterPolys)
+				polysIdx.addGeometry(inputPolys->at(i), i);
+			}
+			polysIdx.build(numThreads);
+			
+			// The input features are read into an index to convert their geometries to GEOS.
+			RSGISVectorOverlayIndex inIdx;
+			inIdx.addLayer(input, true);
+			inIdx.build(1);
+			
+			size_t numGeoms = inIdx.getNumGeoms();
+			std::vector<unsigned char> containedStatus(numGeoms, 0);
+			
+			rsgis::parallelForRange(0, numGeoms, numThreads, 256, [&](size_t start, size_t end, unsigned int threadIdx)
+			{
+				std::vector<size_t> candidates;
+				for(size_t i = start; i < end; ++i)
+				{
+					RSGISOverlayIdxGeom *geom = inIdx.getGeom(i);
+					if(geom->ogrGeom == NULL)
+					{
+						containedStatus[i] = 2;
+						continue;
+					}
+					else if(geom->env == NULL)
+					{
+						continue;
+					}
+					
+					polysIdx.queryCandidates(geom->env, &candidates, true);
+					for(std::vector<size_t>::iterator iterCands = candidates.begin(); iterCands != candidates.end(); ++iterCands)
 					{
 						try 
 						{
-							if((*iterPolys)->Contains(geometry))
+							if(polysIdx.containsGeom((*iterCands), geom, threadIdx))
 							{
-								geomContained = true;
+								containedStatus[i] = 1;
 								break;
 							}
 						}
@@ -184,31 +168,10 @@ namespace rsgis{namespace vec{
 							std::cout << "WARNING: " << e.what() << std::endl;
 						}
 					}
-					
-					
-					if(!geomContained)
-					{
-						numOutputted++;
-						
-						outFeature = OGRFeature::CreateFeature(outFeatureDefn);
-						outFeature->SetGeometry(geometry);
-						outFeature->SetFID(currentFID);
-						this->copyFeatureData(inFeature, outFeature, inFeatureDefn, outFeatureDefn);
-						
-						if( output->CreateFeature(outFeature) != OGRERR_NONE )
-						{
-							throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-						}
-						
-						OGRFeature::DestroyFeature(outFeature);
-					}
-					OGRFeature::DestroyFeature(inFeature);
-				}
-				else 
-				{
-					std::cout << "Current Geometry is NULL - IGNORING...\n";
 				}
-			}
+			});
+			
+			numOutputted = this->writeUncontainedFeatures(&inIdx, &containedStatus, output, inFeatureDefn, outFeatureDefn);
 		}
 		catch(RSGISVectorException &e)
 		{
@@ -217,6 +180,35 @@ namespace rsgis{namespace vec{
 		return numOutputted;
 	}
 	
+	long unsigned RSGISRemoveContainedPolygons::writeUncontainedFeatures(RSGISVectorOverlayIndex *inIdx, std::vector<unsigned char> *containedStatus, OGRLayer *output, OGRFeatureDefn *inFeatureDefn, OGRFeatureDefn *outFeatureDefn)
+	{
+		// Features are written in the order they were read from the input layer.
+		OGRFeature *outFeature = NULL;
+		unsigned long numOutputted = 0;
+		RSGISVectorFeatureWriter featWriter(output);
+		for(size_t i = 0; i < inIdx->getNumGeoms(); ++i)
+		{
+			RSGISOverlayIdxGeom *geom = inIdx->getGeom(i);
+			if(containedStatus->at(i) == 2)
+			{
+				std::cout << "Current Geometry is NULL - IGNORING...\n";
+			}
+			else if(containedStatus->at(i) == 0)
+			{
+				numOutputted++;
+				
+				outFeature = featWriter.createFeature();
+				outFeature->SetGeometry(geom->ogrGeom);
+				outFeature->SetFID(geom->fid);
+				this->copyFeatureData(geom->feat, outFeature, inFeatureDefn, outFeatureDefn);
+				
+				featWriter.writeFeature(outFeature);
+			}
+		}
+		featWriter.flush();
+		return numOutputted;
+	}
+	
 	void RSGISRemoveContainedPolygons::copyFeatureDefn(OGRLayer *outputSHPLayer, OGRFeatureDefn *inFeatureDefn)
 	{
 		int fieldCount = inFeatureDefn->GetFieldCount();
@@ -28,6 +28,7 @@
 #include <iostream>
 #include <string>
 #include <list>
+#include <vector>
 
 #include "ogrsf_frmts.h"
 
@@ -35,8 +36,11 @@
 #include "geos/util/TopologyException.h"
 
 #include "common/RSGISVectorException.h"
+#include "common/RSGISThreadUtils.h"
 
 #include "vec/RSGISVectorUtils.h"
+#include "vec/RSGISVectorFeatureWriter.h"
+#include "vec/RSGISVectorOverlayIndex.h"
 
 // mark all exported classes/functions with DllExport to have
 // them exported by Visual Studio
@@ -57,11 +61,13 @@ namespace rsgis{namespace vec{
 	{
 	public:
 		RSGISRemoveContainedPolygons();
-		long unsigned removeContainedPolygons(OGRLayer *input, OGRLayer *output);
-		long unsigned removeContainedPolygons(OGRLayer *input, OGRLayer *output, std::vector<OGRPolygon*> *inputPolys);
+		long unsigned removeContainedPolygons(OGRLayer *input, OGRLayer *output, unsigned int numThreads=1);
+		long unsigned removeContainedPolygons(OGRLayer *input, OGRLayer *output, std::vector<OGRPolygon*> *inputPolys, unsigned int numThreads=1);
 		void copyFeatureDefn(OGRLayer *outputSHPLayer, OGRFeatureDefn *inFeatureDefn);
 		void copyFeatureData(OGRFeature *inFeature, OGRFeature *outFeature, OGRFeatureDefn *inFeatureDefn, OGRFeatureDefn *outFeatureDefn);
 		~RSGISRemoveContainedPolygons();
+	protected:
+		long unsigned writeUncontainedFeatures(RSGISVectorOverlayIndex *inIdx, std::vector<unsigned char> *containedStatus, OGRLayer *output, OGRFeatureDefn *inFeatureDefn, OGRFeatureDefn *outFeatureDefn);
 	};
 	
 }}
@@ -66,6 +66,7 @@ namespace rsgis{namespace vec{
 			unsigned long i = 0;
 			std::cout << "Started" << std::flush;
 			
+			RSGISVectorFeatureWriter featWriter(output);
 			input->ResetReading();
 			while( (inFeature = input->GetNextFeature()) != NULL )
 			{
@@ -113,17 +114,12 @@ namespace rsgis{namespace vec{
 				
 				if(polyOK && !nullGeometry)
 				{
-					outFeature = OGRFeature::CreateFeature(outFeatureDefn);
+					outFeature = featWriter.createFeature();
 					outFeature->SetGeometry(nPolygon);
 					outFeature->SetFID(fid);
 					this->copyFeatureData(inFeature, outFeature, inFeatureDefn, outFeatureDefn);
 					
-					if( output->CreateFeature(outFeature) != OGRERR_NONE )
-					{
-						throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-					}
-					
-					OGRFeature::DestroyFeature(outFeature);
+					featWriter.writeFeature(outFeature);
 					numOutputted++;
 				}
 				else 
@@ -133,6 +129,7 @@ namespace rsgis{namespace vec{
 				
 				OGRFeature::DestroyFeature(inFeature);
 			}
+			featWriter.flush();
 			std::cout << " Complete.\n";
 			
 			std::cout << numOutputted << " Polygons have been outputted from the " << numFeatures << " in the input file.\n";
@@ -52,7 +52,9 @@ namespace rsgis{namespace vec{
 			outFeatureDefnLarge = outputLarge->GetLayerDefn();
 			this->copyFeatureDefn(outputSmall, inFeatureDefn);
 			outFeatureDefnSmall = outputSmall->GetLayerDefn();
-						
+			
+			RSGISVectorFeatureWriter largeFeatWriter(outputLarge);
+			RSGISVectorFeatureWriter smallFeatWriter(outputSmall);
 			input->ResetReading();
 			while( (inFeature = input->GetNextFeature()) != NULL )
 			{		
@@ -67,32 +69,21 @@ namespace rsgis{namespace vec{
 					
 					if(polygon->get_Area() > threshold)
 					{
-						outFeature = OGRFeature::CreateFeature(outFeatureDefnLarge);
+						outFeature = largeFeatWriter.createFeature();
 						outFeature->SetGeometry(polygon);
 						outFeature->SetFID(fid);
 						this->copyFeatureData(inFeature, outFeature, inFeatureDefn, outFeatureDefnLarge);
 						
-						if( outputLarge->CreateFeature(outFeature) != OGRERR_NONE )
-						{
-							throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-						}
-						
-						OGRFeature::DestroyFeature(outFeature);
-						
+						largeFeatWriter.writeFeature(outFeature);
 					}
 					else 
 					{
-						outFeature = OGRFeature::CreateFeature(outFeatureDefnSmall);
+						outFeature = smallFeatWriter.createFeature();
 						outFeature->SetGeometry(polygon);
 						outFeature->SetFID(fid);
 						this->copyFeatureData(inFeature, outFeature, inFeatureDefn, outFeatureDefnSmall);
 						
-						if( outputSmall->CreateFeature(outFeature) != OGRERR_NONE )
-						{
-							throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-						}
-						
-						OGRFeature::DestroyFeature(outFeature);
+						smallFeatWriter.writeFeature(outFeature);
 					}
 				} 
 				else 
@@ -101,7 +92,8 @@ namespace rsgis{namespace vec{
 				}
 				OGRFeature::DestroyFeature(inFeature);
 			}
-
+			largeFeatWriter.flush();
+			smallFeatWriter.flush();
 		}
 		catch(RSGISVectorException &e)
 		{
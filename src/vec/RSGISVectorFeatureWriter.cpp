@@ -0,0 +1,323 @@
+/*
+ *  RSGISVectorFeatureWriter.cpp
+ *  RSGIS_LIB
+ *
+ *  Created by agent on 19/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISVectorFeatureWriter.h"
+
+namespace rsgis{namespace vec{
+
+    RSGISVectorFeatureWriter::RSGISVectorFeatureWriter(OGRLayer *layer, bool asyncWrite, unsigned long transactionSize)
+    {
+        this->layer = layer;
+        this->layerDefn = layer->GetLayerDefn();
+        this->asyncWrite = asyncWrite;
+        this->transactionSize = transactionSize;
+        if(this->transactionSize == 0)
+        {
+            this->transactionSize = 1;
+        }
+        this->numInTransaction = 0;
+        this->numWritten = 0;
+        this->inTransaction = false;
+        this->stopWriting = false;
+        this->flushRequested = false;
+        this->writeInProgress = false;
+        this->writeErrorOccurred = false;
+        this->writeError = "";
+        this->writeThread = NULL;
+        if(this->asyncWrite)
+        {
+            this->writeThread = new std::thread(&RSGISVectorFeatureWriter::runWriteThread, this);
+        }
+    }
+
+    OGRFeature* RSGISVectorFeatureWriter::createFeature()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->poolMutex);
+            if(!this->featPool.empty())
+            {
+                OGRFeature *feature = this->featPool.back();
+                this->featPool.pop_back();
+                return feature;
+            }
+        }
+        return OGRFeature::CreateFeature(this->layerDefn);
+    }
+
+    void RSGISVectorFeatureWriter::writeFeature(OGRFeature *feature)
+    {
+        if(this->asyncWrite)
+        {
+            std::unique_lock<std::mutex> lock(this->queueMutex);
+            this->queueCondition.wait(lock, [this]{return (this->writeQueue.size() < RSGIS_VEC_WRITE_QUEUE_SIZE) || this->writeErrorOccurred;});
+            if(this->writeErrorOccurred)
+            {
+                lock.unlock();
+                this->recycleFeature(feature);
+                this->checkWriteError();
+            }
+            this->writeQueue.push_back(feature);
+            lock.unlock();
+            this->queueCondition.notify_all();
+        }
+        else
+        {
+            try
+            {
+                this->writeToLayer(feature, false);
+            }
+            catch(RSGISVectorOutputException &e)
+            {
+                this->recycleFeature(feature);
+                throw e;
+            }
+            this->recycleFeature(feature);
+        }
+    }
+
+    void RSGISVectorFeatureWriter::updateFeature(OGRFeature *feature)
+    {
+        if(this->asyncWrite)
+        {
+            throw RSGISVectorException("Features cannot be updated using an asynchronous feature writer.");
+        }
+        this->writeToLayer(feature, true);
+    }
+
+    void RSGISVectorFeatureWriter::discardFeature(OGRFeature *feature)
+    {
+        this->recycleFeature(feature);
+    }
+
+    void RSGISVectorFeatureWriter::flush()
+    {
+        if(this->asyncWrite)
+        {
+            std::unique_lock<std::mutex> lock(this->queueMutex);
+            this->flushRequested = true;
+            this->queueCondition.notify_all();
+            this->queueCondition.wait(lock, [this]{return !this->flushRequested;});
+            lock.unlock();
+            this->checkWriteError();
+        }
+        else
+        {
+            this->commitTransaction();
+        }
+    }
+
+    void RSGISVectorFeatureWriter::writeToLayer(OGRFeature *feature, bool update)
+    {
+        if(!this->inTransaction)
+        {
+            this->layer->StartTransaction();
+            this->inTransaction = true;
+        }
+
+        if(update)
+        {
+            if( this->layer->SetFeature(feature) != OGRERR_NONE )
+            {
+                throw RSGISVectorOutputException("Failed to write feature to the vector layer.");
+            }
+        }
+        else if( this->layer->CreateFeature(feature) != OGRERR_NONE )
+        {
+            throw RSGISVectorOutputException("Failed to write feature to the output vector layer.");
+        }
+        ++this->numWritten;
+        ++this->numInTransaction;
+
+        if(this->numInTransaction >= this->transactionSize)
+        {
+            this->commitTransaction();
+        }
+    }
+
+    void RSGISVectorFeatureWriter::commitTransaction()
+    {
+        if(this->inTransaction)
+        {
+            this->inTransaction = false;
+            this->numInTransaction = 0;
+            if( this->layer->CommitTransaction() != OGRERR_NONE )
+            {
+                throw RSGISVectorOutputException("Failed to commit the transaction to the output vector layer.");
+            }
+        }
+    }
+
+    void RSGISVectorFeatureWriter::recycleFeature(OGRFeature *feature)
+    {
+        if(feature == NULL)
+        {
+            return;
+        }
+
+        // Only features with the layer definition can be reused.
+        if(feature->GetDefnRef() == this->layerDefn)
+        {
+            std::lock_guard<std::mutex> lock(this->poolMutex);
+            if(this->featPool.size() < RSGIS_VEC_FEATURE_POOL_SIZE)
+            {
+                feature->SetGeometryDirectly(NULL);
+                int numFields = feature->GetFieldCount();
+                for(int i = 0; i < numFields; ++i)
+                {
+                    if(feature->IsFieldSet(i))
+                    {
+                        feature->UnsetField(i);
+                    }
+                }
+                feature->SetFID(OGRNullFID);
+                this->featPool.push_back(feature);
+                return;
+            }
+        }
+        OGRFeature::DestroyFeature(feature);
+    }
+
+    void RSGISVectorFeatureWriter::runWriteThread()
+    {
+        std::unique_lock<std::mutex> lock(this->queueMutex);
+        while(true)
+        {
+            this->queueCondition.wait(lock, [this]{return this->stopWriting || this->flushRequested || (!this->writeQueue.empty());});
+
+            if(!this->writeQueue.empty())
+            {
+                OGRFeature *feature = this->writeQueue.front();
+                this->writeQueue.pop_front();
+                this->writeInProgress = true;
+                bool writeFailed = this->writeErrorOccurred;
+                lock.unlock();
+                this->queueCondition.notify_all();
+
+                std::string message = "";
+                if(!writeFailed)
+                {
+                    try
+                    {
+                        this->writeToLayer(feature, false);
+                    }
+                    catch(RSGISVectorOutputException &e)
+                    {
+                        writeFailed = true;
+                        message = e.what();
+                    }
+                }
+                this->recycleFeature(feature);
+
+                lock.lock();
+                if(writeFailed && (!this->writeErrorOccurred))
+                {
+                    this->writeErrorOccurred = true;
+                    this->writeError = message;
+                }
+                this->writeInProgress = false;
+                this->queueCondition.notify_all();
+            }
+            else if(this->flushRequested)
+            {
+                lock.unlock();
+                std::string message = "";
+                try
+                {
+                    this->commitTransaction();
+                }
+                catch(RSGISVectorOutputException &e)
+                {
+                    message = e.what();
+                }
+                lock.lock();
+                if((message != "") && (!this->writeErrorOccurred))
+                {
+                    this->writeErrorOccurred = true;
+                    this->writeError = message;
+                }
+                this->flushRequested = false;
+                this->queueCondition.notify_all();
+            }
+            else if(this->stopWriting)
+            {
+                break;
+            }
+        }
+    }
+
+    void RSGISVectorFeatureWriter::checkWriteError()
+    {
+        std::unique_lock<std::mutex> lock(this->queueMutex);
+        if(this->writeErrorOccurred)
+        {
+            std::string message = this->writeError;
+            lock.unlock();
+            throw RSGISVectorOutputException(message);
+        }
+    }
+
+    RSGISVectorFeatureWriter::~RSGISVectorFeatureWriter()
+    {
+        bool errorReported = false;
+        {
+            std::lock_guard<std::mutex> lock(this->queueMutex);
+            errorReported = this->writeErrorOccurred;
+        }
+        try
+        {
+            this->flush();
+        }
+        catch(RSGISVectorException &e)
+        {
+            // A write error will already have been thrown to the caller.
+            if(!errorReported)
+            {
+                std::cerr << "WARNING: " << e.what() << std::endl;
+            }
+        }
+
+        if(this->writeThread != NULL)
+        {
+            {
+                std::lock_guard<std::mutex> lock(this->queueMutex);
+                this->stopWriting = true;
+            }
+            this->queueCondition.notify_all();
+            this->writeThread->join();
+            delete this->writeThread;
+
+            // Only left if an error stopped the writing.
+            for(std::deque<OGRFeature*>::iterator iterFeats = this->writeQueue.begin(); iterFeats != this->writeQueue.end(); ++iterFeats)
+            {
+                OGRFeature::DestroyFeature(*iterFeats);
+            }
+            this->writeQueue.clear();
+        }
+
+        for(std::vector<OGRFeature*>::iterator iterFeats = this->featPool.begin(); iterFeats != this->featPool.end(); ++iterFeats)
+        {
+            OGRFeature::DestroyFeature(*iterFeats);
+        }
+        this->featPool.clear();
+    }
+
+}}
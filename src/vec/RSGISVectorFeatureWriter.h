@@ -0,0 +1,122 @@
+/*
+ *  RSGISVectorFeatureWriter.h
+ *  RSGIS_LIB
+ *
+ *  Created by agent on 19/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISVectorFeatureWriter_H
+#define RSGISVectorFeatureWriter_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "ogrsf_frmts.h"
+
+#include "common/RSGISVectorException.h"
+
+#include "vec/RSGISVectorOutputException.h"
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_vec_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+/** The number of features written within each transaction by default. */
+#define RSGIS_VEC_WRITE_TRANSACTION_SIZE 20000
+/** The maximum number of features waiting to be written by the write thread. */
+#define RSGIS_VEC_WRITE_QUEUE_SIZE 4096
+/** The maximum number of written features kept for reuse. */
+#define RSGIS_VEC_FEATURE_POOL_SIZE 1024
+
+namespace rsgis{namespace vec{
+
+    /**
+     * Writes features to an OGR layer grouping the writes into transactions of
+     * transactionSize features, which for drivers such as GPKG and SQLite is far
+     * quicker than a transaction per feature. Features should be created with
+     * createFeature() and, once passed to writeFeature(), are owned by the writer
+     * which resets and reuses them.
+     *
+     * If asyncWrite is true the features are written by a separate thread, in the
+     * order they were given, so the caller can continue reading and processing.
+     * This must only be used when the layer is in a different dataset to any being
+     * read on the calling thread and updateFeature() is then not available.
+     *
+     * The outstanding features are written and the transaction committed by flush()
+     * or the destructor, which must happen before the dataset is closed.
+     */
+    class DllExport RSGISVectorFeatureWriter
+    {
+    public:
+        RSGISVectorFeatureWriter(OGRLayer *layer, bool asyncWrite=false, unsigned long transactionSize=RSGIS_VEC_WRITE_TRANSACTION_SIZE);
+        /** Returns an empty feature using the layer definition, reusing a written feature where possible. */
+        OGRFeature* createFeature();
+        /** Creates the feature within the layer (OGRLayer::CreateFeature); the writer takes ownership of the feature. */
+        void writeFeature(OGRFeature *feature);
+        /** Rewrites an existing feature (OGRLayer::SetFeature); the caller keeps ownership. Not available with asyncWrite. */
+        void updateFeature(OGRFeature *feature);
+        /** Returns a feature from createFeature() which is not going to be written. */
+        void discardFeature(OGRFeature *feature);
+        /** Writes all the queued features and commits the open transaction. */
+        void flush();
+        /** The number of features written; call flush() first when writing asynchronously. */
+        unsigned long getNumWritten(){return this->numWritten;};
+        ~RSGISVectorFeatureWriter();
+    protected:
+        void writeToLayer(OGRFeature *feature, bool update);
+        void commitTransaction();
+        void recycleFeature(OGRFeature *feature);
+        void runWriteThread();
+        void checkWriteError();
+        OGRLayer *layer;
+        OGRFeatureDefn *layerDefn;
+        bool asyncWrite;
+        unsigned long transactionSize;
+        unsigned long numInTransaction;
+        unsigned long numWritten;
+        bool inTransaction;
+        std::vector<OGRFeature*> featPool;
+        std::mutex poolMutex;
+        std::deque<OGRFeature*> writeQueue;
+        std::mutex queueMutex;
+        std::condition_variable queueCondition;
+        std::thread *writeThread;
+        bool stopWriting;
+        bool flushRequested;
+        bool writeInProgress;
+        bool writeErrorOccurred;
+        std::string writeError;
+    };
+
+}}
+
+#endif
@@ -172,6 +172,7 @@ namespace rsgis{namespace vec{
 			
 			OGRFeatureDefn *outputDefn = outputSHP->GetLayerDefn();
 			OGRFeature *featureOutput = NULL;
+			RSGISVectorFeatureWriter featWriter(outputSHP);
 			
 			int counter = 0;
 			int feedback = numFeatures/10;
@@ -192,18 +193,15 @@ namespace rsgis{namespace vec{
 					std::cout << ".." << counter << ".." << std::flush;
 				}			
 				
-				featureOutput = OGRFeature::CreateFeature(outputDefn);
+				featureOutput = featWriter.createFeature();
 				
 				data[i]->populateFeature(featureOutput, outputDefn);
 				
-				if( outputSHP->CreateFeature(featureOutput) != OGRERR_NONE )
-				{
-					throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-				}
-				OGRFeature::DestroyFeature(featureOutput);
+				featWriter.writeFeature(featureOutput);
 				
 				counter++;
 			}
+			featWriter.flush();
 			std::cout << " Complete.\n";
 		}
 		catch(RSGISException &e)
@@ -225,6 +223,7 @@ namespace rsgis{namespace vec{
 			
 			OGRFeatureDefn *outputDefn = outputSHP->GetLayerDefn();
 			OGRFeature *featureOutput = NULL;
+			RSGISVectorFeatureWriter featWriter(outputSHP);
 			
 			int counter = 0;
 			int feedback = numFeatures/10;
@@ -245,18 +244,15 @@ namespace rsgis{namespace vec{
 					std::cout << ".." << counter << ".." << std::flush;
 				}			
 				
-				featureOutput = OGRFeature::CreateFeature(outputDefn);
+				featureOutput = featWriter.createFeature();
 				
 				data[i]->populateFeature(featureOutput, outputDefn);
 				
-				if( outputSHP->CreateFeature(featureOutput) != OGRERR_NONE )
-				{
-					throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-				}
-				OGRFeature::DestroyFeature(featureOutput);
+				featWriter.writeFeature(featureOutput);
 				
 				counter++;
 			}
+			featWriter.flush();
 			std::cout << " Complete.\n";
 		}
 		catch(RSGISException &e)
@@ -278,6 +274,7 @@ namespace rsgis{namespace vec{
 			
 			OGRFeatureDefn *outputDefn = outputSHP->GetLayerDefn();
 			OGRFeature *featureOutput = NULL;
+			RSGISVectorFeatureWriter featWriter(outputSHP);
 			
 			int feedback = data->size()/10;
 			int feedbackCounter = 0;
@@ -297,16 +294,13 @@ namespace rsgis{namespace vec{
 					std::cout << ".." << i << ".." << std::flush;
 				}			
 				
-				featureOutput = OGRFeature::CreateFeature(outputDefn);
+				featureOutput = featWriter.createFeature();
 				
 				data->at(i)->populateFeature(featureOutput, outputDefn);
 				
-				if( outputSHP->CreateFeature(featureOutput) != OGRERR_NONE )
-				{
-					throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-				}
-				OGRFeature::DestroyFeature(featureOutput);
+				featWriter.writeFeature(featureOutput);
 			}
+			featWriter.flush();
 			std::cout << " Complete.\n";
 		}
 		catch(RSGISException &e)
@@ -430,6 +424,7 @@ namespace rsgis{namespace vec{
 			
 			OGRFeatureDefn *outputDefn = outputSHPLayer->GetLayerDefn();
 			OGRFeature *featureOutput = NULL;
+			RSGISVectorFeatureWriter featWriter(outputSHPLayer);
 			
 			// Write Polygons to file
 			std::vector<geos::geom::Polygon*>::iterator iterPolys;
@@ -437,16 +432,13 @@ namespace rsgis{namespace vec{
 			{
 				if((*iterPolys) != NULL)
                 {
-                    featureOutput = OGRFeature::CreateFeature(outputDefn);
+                    featureOutput = featWriter.createFeature();
                     featureOutput->SetGeometryDirectly(vecUtils.convertGEOSPolygon2OGRPolygon((*iterPolys)));
                     
-                    if( outputSHPLayer->CreateFeature(featureOutput) != OGRERR_NONE )
-                    {
-                        throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-                    }
-                    OGRFeature::DestroyFeature(featureOutput);
+                    featWriter.writeFeature(featureOutput);
                 }
 			}
+			featWriter.flush();
 			GDALClose(outputSHPDS);
 		}
 		catch(RSGISException &e)
@@ -614,6 +606,7 @@ namespace rsgis{namespace vec{
 			
 			OGRFeatureDefn *outputDefn = outputSHPLayer->GetLayerDefn();
 			OGRFeature *featureOutput = NULL;
+			RSGISVectorFeatureWriter featWriter(outputSHPLayer);
 			
 			geos::geom::Polygon *poly = NULL;
             rsgis::utils::PlotPoly *polyAtts = NULL;
@@ -624,7 +617,7 @@ namespace rsgis{namespace vec{
 				poly = polys->at(i);
 				polyAtts = polyDetails->at(i);
 				
-				featureOutput = OGRFeature::CreateFeature(outputDefn);
+				featureOutput = featWriter.createFeature();
 				
 				featureOutput->SetField(outputDefn->GetFieldIndex("id"), polyAtts->fid);
 				featureOutput->SetField(outputDefn->GetFieldIndex("zone"), polyAtts->zone);
@@ -643,12 +636,9 @@ namespace rsgis{namespace vec{
 				
 				featureOutput->SetGeometryDirectly(vecUtils.convertGEOSPolygon2OGRPolygon(poly));
 				
-				if( outputSHPLayer->CreateFeature(featureOutput) != OGRERR_NONE )
-				{
-					throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-				}
-				OGRFeature::DestroyFeature(featureOutput);
+				featWriter.writeFeature(featureOutput);
 			}
+			featWriter.flush();
 			GDALClose(outputSHPDS);
 		}
 		catch(RSGISException &e)
@@ -733,6 +723,7 @@ namespace rsgis{namespace vec{
 			}			
 			OGRFeatureDefn *outputDefn = outputSHPLayer->GetLayerDefn();
 			OGRFeature *featureOutput = NULL;
+			RSGISVectorFeatureWriter featWriter(outputSHPLayer);
 			
             geos::geom::Polygon *poly = NULL;
             rsgis::utils::ImageFootPrintPoly *polyAtts = NULL;
@@ -743,18 +734,15 @@ namespace rsgis{namespace vec{
 				poly = polys->at(i);
 				polyAtts = polyDetails->at(i);
 				
-				featureOutput = OGRFeature::CreateFeature(outputDefn);
+				featureOutput = featWriter.createFeature();
 				
 				featureOutput->SetField(outputDefn->GetFieldIndex("id"), polyAtts->fid);
 				featureOutput->SetField(outputDefn->GetFieldIndex("sceneName"), polyAtts->scene.c_str());
 				featureOutput->SetGeometryDirectly(vecUtils.convertGEOSPolygon2OGRPolygon(poly));
 				
-				if( outputSHPLayer->CreateFeature(featureOutput) != OGRERR_NONE )
-				{
-					throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-				}
-				OGRFeature::DestroyFeature(featureOutput);
+				featWriter.writeFeature(featureOutput);
 			}
+			featWriter.flush();
 			GDALClose(outputSHPDS);
 		}
 		catch(RSGISException &e)
@@ -821,6 +809,7 @@ namespace rsgis{namespace vec{
 			
 			OGRFeatureDefn *outputDefn = outputSHPLayer->GetLayerDefn();
 			OGRFeature *featureOutput = NULL;
+			RSGISVectorFeatureWriter featWriter(outputSHPLayer);
 			
 			// Write Polygons to file
 			if(polys->size() > 0)
@@ -830,18 +819,15 @@ namespace rsgis{namespace vec{
 				{
                     if((*iterPolys) != NULL)
                     {
-                        featureOutput = OGRFeature::CreateFeature(outputDefn);
+                        featureOutput = featWriter.createFeature();
                         featureOutput->SetGeometryDirectly(vecUtils.convertGEOSPolygon2OGRPolygon((*iterPolys)));
                         
-                        if( outputSHPLayer->CreateFeature(featureOutput) != OGRERR_NONE )
-                        {
-                            throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-                        }
-                        OGRFeature::DestroyFeature(featureOutput);
+                        featWriter.writeFeature(featureOutput);
                     }
 				}
 				
 			}
+			featWriter.flush();
 			GDALClose(outputSHPDS);
 		}
 		catch(RSGISException &e)
@@ -923,6 +909,7 @@ namespace rsgis{namespace vec{
             int outColIdx = outputDefn->GetFieldIndex(attName.c_str());
             unsigned int polyIdx = 0;
 			OGRFeature *featureOutput = NULL;
+			RSGISVectorFeatureWriter featWriter(outputSHPLayer);
 			
 			// Write Polygons to file
 			if(polys->size() > 0)
@@ -932,20 +919,17 @@ namespace rsgis{namespace vec{
 				{
                     if((*iterPolys) != NULL)
                     {
-                        featureOutput = OGRFeature::CreateFeature(outputDefn);
+                        featureOutput = featWriter.createFeature();
                         featureOutput->SetGeometryDirectly(vecUtils.convertGEOSPolygon2OGRPolygon((*iterPolys)));
                         
                         featureOutput->SetField(outColIdx, outAtts->at(polyIdx++).c_str());
                         
-                        if( outputSHPLayer->CreateFeature(featureOutput) != OGRERR_NONE )
-                        {
-                            throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-                        }
-                        OGRFeature::DestroyFeature(featureOutput);
+                        featWriter.writeFeature(featureOutput);
                     }
 				}
 				
 			}
+			featWriter.flush();
 			GDALClose(outputSHPDS);
 		}
 		catch(RSGISException &e)
@@ -1021,6 +1005,7 @@ namespace rsgis{namespace vec{
 			
 			OGRFeatureDefn *outputDefn = outputSHPLayer->GetLayerDefn();
 			OGRFeature *featureOutput = NULL;
+			RSGISVectorFeatureWriter featWriter(outputSHPLayer);
 			
 			// Write Polygons to file
 			if(polys->size() > 0)
@@ -1030,19 +1015,16 @@ namespace rsgis{namespace vec{
 				{
                     if((*iterPolys) != NULL)
                     {
-                        featureOutput = OGRFeature::CreateFeature(outputDefn);
+                        featureOutput = featWriter.createFeature();
                         featureOutput->SetField(outputDefn->GetFieldIndex(attribute.c_str()), attributeVal.c_str());
                         featureOutput->SetGeometryDirectly(vecUtils.convertGEOSPolygon2OGRPolygon((*iterPolys)));
                         
-                        if( outputSHPLayer->CreateFeature(featureOutput) != OGRERR_NONE )
-                        {
-                            throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-                        }
-                        OGRFeature::DestroyFeature(featureOutput);
+                        featWriter.writeFeature(featureOutput);
                     }
 				}
 				
 			}
+			featWriter.flush();
 			GDALClose(outputSHPDS);
 		}
 		catch(RSGISException &e)
@@ -1109,6 +1091,7 @@ namespace rsgis{namespace vec{
 			
 			OGRFeatureDefn *outputDefn = outputSHPLayer->GetLayerDefn();
 			OGRFeature *featureOutput = NULL;
+			RSGISVectorFeatureWriter featWriter(outputSHPLayer);
 			
 			// Write Polygons to file
 			std::list<geos::geom::Polygon*>::iterator iterPolys;
@@ -1116,16 +1099,13 @@ namespace rsgis{namespace vec{
 			{
                 if((*iterPolys) != NULL)
                 {
-                    featureOutput = OGRFeature::CreateFeature(outputDefn);
+                    featureOutput = featWriter.createFeature();
                     featureOutput->SetGeometryDirectly(vecUtils.convertGEOSPolygon2OGRPolygon((*iterPolys)));
                     
-                    if( outputSHPLayer->CreateFeature(featureOutput) != OGRERR_NONE )
-                    {
-                        throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-                    }
-                    OGRFeature::DestroyFeature(featureOutput);
+                    featWriter.writeFeature(featureOutput);
                 }
 			}
+			featWriter.flush();
 			GDALClose(outputSHPDS);
 		}
 		catch(RSGISException &e)
@@ -1192,20 +1172,18 @@ namespace rsgis{namespace vec{
 			
 			OGRFeatureDefn *outputDefn = outputSHPLayer->GetLayerDefn();
 			OGRFeature *featureOutput = NULL;
+			RSGISVectorFeatureWriter featWriter(outputSHPLayer);
 			
 			// Write Polygons to file
 			std::vector<geos::geom::Coordinate*>::iterator iterCoords;
 			for(iterCoords = coords->begin(); iterCoords != coords->end(); iterCoords++)
 			{
-				featureOutput = OGRFeature::CreateFeature(outputDefn);
+				featureOutput = featWriter.createFeature();
 				featureOutput->SetGeometryDirectly(vecUtils.convertGEOSCoordinate2OGRPoint((*iterCoords)));
 				
-				if( outputSHPLayer->CreateFeature(featureOutput) != OGRERR_NONE )
-				{
-					throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-				}
-				OGRFeature::DestroyFeature(featureOutput);
+				featWriter.writeFeature(featureOutput);
 			}
+			featWriter.flush();
 			GDALClose(outputSHPDS);
 		}
 		catch(RSGISException &e)
@@ -1272,20 +1250,18 @@ namespace rsgis{namespace vec{
 			
 			OGRFeatureDefn *outputDefn = outputSHPLayer->GetLayerDefn();
 			OGRFeature *featureOutput = NULL;
+			RSGISVectorFeatureWriter featWriter(outputSHPLayer);
 			
 			// Write Polygons to file
 			std::vector<geos::geom::LineString*>::iterator iterlines;
 			for(iterlines = lines->begin(); iterlines != lines->end(); iterlines++)
 			{
-				featureOutput = OGRFeature::CreateFeature(outputDefn);
+				featureOutput = featWriter.createFeature();
 				featureOutput->SetGeometryDirectly(vecUtils.convertGEOSLineString2OGRLineString((*iterlines)));
 				
-				if( outputSHPLayer->CreateFeature(featureOutput) != OGRERR_NONE )
-				{
-					throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-				}
-				OGRFeature::DestroyFeature(featureOutput);
+				featWriter.writeFeature(featureOutput);
 			}
+			featWriter.flush();
 			GDALClose(outputSHPDS);
 		}
 		catch(RSGISException &e)
@@ -1385,6 +1361,7 @@ namespace rsgis{namespace vec{
 		
 		OGRFeatureDefn *outputDefn = outputSHPLayer->GetLayerDefn();
 		OGRFeature *featureOutput = NULL;
+		RSGISVectorFeatureWriter featWriter(outputSHPLayer);
 		
 		std::list<double>::iterator iterX1;
 		std::list<double>::iterator iterY1;
@@ -1398,24 +1375,21 @@ namespace rsgis{namespace vec{
 		OGRLineString *line;
 		while(iterX1 != x1->end())
 		{
-			featureOutput = OGRFeature::CreateFeature(outputDefn);
+			featureOutput = featWriter.createFeature();
 			
 			line = new OGRLineString();
 			line->addPoint(*iterX1, *iterY1, 0);
 			line->addPoint(*iterX2, *iterY2, 0);
 			featureOutput->SetGeometryDirectly(line);
 			
-			if( outputSHPLayer->CreateFeature(featureOutput) != OGRERR_NONE )
-			{
-				throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-			}
-			OGRFeature::DestroyFeature(featureOutput);
+			featWriter.writeFeature(featureOutput);
 			
 			iterX1++;
 			iterY1++;
 			iterX2++;
 			iterY2++;
 		}
+		featWriter.flush();
 		GDALClose(outputSHPDS);
 	}
 	
@@ -1485,6 +1459,7 @@ namespace rsgis{namespace vec{
 			
 			OGRFeatureDefn *outputDefn = outputSHPLayer->GetLayerDefn();
 			OGRFeature *featureOutput = NULL;
+			RSGISVectorFeatureWriter featWriter(outputSHPLayer);
 			
 			// Write Polygons to file
 			std::list<geos::geom::Polygon*>::iterator iterPolys;
@@ -1492,17 +1467,14 @@ namespace rsgis{namespace vec{
 			{
 				for(iterPolys = polygons[i]->begin(); iterPolys != polygons[i]->end(); ++iterPolys)
 				{
-					featureOutput = OGRFeature::CreateFeature(outputDefn);
+					featureOutput = featWriter.createFeature();
 					featureOutput->SetField(outputDefn->GetFieldIndex("cluster"), i);
 					featureOutput->SetGeometryDirectly(vecUtils.convertGEOSPolygon2OGRPolygon((*iterPolys)));
 					
-					if( outputSHPLayer->CreateFeature(featureOutput) != OGRERR_NONE )
-					{
-						throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-					}
-					OGRFeature::DestroyFeature(featureOutput);
+					featWriter.writeFeature(featureOutput);
 				}
 			}
+			featWriter.flush();
 			GDALClose(outputSHPDS);
 		}
 		catch(RSGISException &e)
@@ -1577,6 +1549,7 @@ namespace rsgis{namespace vec{
             
             OGRFeatureDefn *outputDefn = outputSHPLayer->GetLayerDefn();
             OGRFeature *featureOutput = NULL;
+            RSGISVectorFeatureWriter featWriter(outputSHPLayer);
             
             // Write Polygons to file
             std::list<geos::geom::Point*>::iterator iterPoints;
@@ -1584,17 +1557,14 @@ namespace rsgis{namespace vec{
             {
                 for(iterPoints = points[i]->begin(); iterPoints != points[i]->end(); ++iterPoints)
                 {
-                    featureOutput = OGRFeature::CreateFeature(outputDefn);
+                    featureOutput = featWriter.createFeature();
                     featureOutput->SetField(outputDefn->GetFieldIndex("cluster"), i);
                     featureOutput->SetGeometryDirectly(vecUtils.convertGEOSPoint2OGRPoint((*iterPoints)));
                     
-                    if( outputSHPLayer->CreateFeature(featureOutput) != OGRERR_NONE )
-                    {
-                        throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-                    }
-                    OGRFeature::DestroyFeature(featureOutput);
+                    featWriter.writeFeature(featureOutput);
                 }
             }
+            featWriter.flush();
             GDALClose(outputSHPDS);
         }
         catch(RSGISException &e)
@@ -1669,21 +1639,19 @@ namespace rsgis{namespace vec{
 			
 			OGRFeatureDefn *outputDefn = outputSHPLayer->GetLayerDefn();
 			OGRFeature *featureOutput = NULL;
+			RSGISVectorFeatureWriter featWriter(outputSHPLayer);
 			
 			// Write Polygons to file
 			std::list<geos::geom::Polygon*>::iterator iterPolys;
 			for(int i = 0; i < numClusters; ++i)
 			{
-				featureOutput = OGRFeature::CreateFeature(outputDefn);
+				featureOutput = featWriter.createFeature();
 				featureOutput->SetField(outputDefn->GetFieldIndex("cluster"), i);
 				featureOutput->SetGeometryDirectly(vecUtils.convertGEOSPolygons2OGRMultiPolygon(polygons[i]));
 				
-				if( outputSHPLayer->CreateFeature(featureOutput) != OGRERR_NONE )
-				{
-					throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-				}
-				OGRFeature::DestroyFeature(featureOutput);
+				featWriter.writeFeature(featureOutput);
 			}
+			featWriter.flush();
 			GDALClose(outputSHPDS);
 		}
 		catch(RSGISException &e)
@@ -1791,13 +1759,14 @@ namespace rsgis{namespace vec{
 			
 			OGRFeatureDefn *outputDefn = outputSHPLayer->GetLayerDefn();
 			OGRFeature *featureOutput = NULL;
+			RSGISVectorFeatureWriter featWriter(outputSHPLayer);
 			
 			// Write Polygons to file
 			std::vector<geos::geom::Polygon*>::iterator iterPolys;
 			OGRPolygon *poly;
 			for(unsigned int i = 0; i < polys->size(); ++i)
 			{
-				featureOutput = OGRFeature::CreateFeature(outputDefn);
+				featureOutput = featWriter.createFeature();
 				for(unsigned int j = 0; j < numericColsName->size(); ++j)
 				{
 					featureOutput->SetField(outputDefn->GetFieldIndex((numericColsName->at(j)).c_str()), numericColsData[j]->at(i));
@@ -1809,12 +1778,9 @@ namespace rsgis{namespace vec{
 				poly = vecUtils.convertGEOSPolygon2OGRPolygon(polys->at(i));
 				featureOutput->SetGeometryDirectly(poly);
 				
-				if( outputSHPLayer->CreateFeature(featureOutput) != OGRERR_NONE )
-				{
-					throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-				}
-				OGRFeature::DestroyFeature(featureOutput);
+				featWriter.writeFeature(featureOutput);
 			}
+			featWriter.flush();
 			GDALClose(outputSHPDS);
 		}
 		catch(RSGISException &e)
@@ -1830,20 +1796,18 @@ namespace rsgis{namespace vec{
 		{			
 			OGRFeatureDefn *outputDefn = outLayer->GetLayerDefn();
 			OGRFeature *featureOutput = NULL;
+			RSGISVectorFeatureWriter featWriter(outLayer);
 			
 			// Write Polygons to file
 			std::list<OGRPolygon*>::iterator iterPolys;
 			for(iterPolys = polys->begin(); iterPolys != polys->end(); iterPolys++)
 			{
-				featureOutput = OGRFeature::CreateFeature(outputDefn);
+				featureOutput = featWriter.createFeature();
 				featureOutput->SetGeometryDirectly(*iterPolys);
 				
-				if( outLayer->CreateFeature(featureOutput) != OGRERR_NONE )
-				{
-					throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-				}
-				OGRFeature::DestroyFeature(featureOutput);
+				featWriter.writeFeature(featureOutput);
 			}
+			featWriter.flush();
 		}
 		catch(RSGISException &e)
 		{
@@ -1909,6 +1873,7 @@ namespace rsgis{namespace vec{
             
             OGRFeatureDefn *outputDefn = outputSHPLayer->GetLayerDefn();
             OGRFeature *featureOutput = NULL;
+            RSGISVectorFeatureWriter featWriter(outputSHPLayer);
             
             // Write Polygons to file
             if(pts->size() > 0)
@@ -1917,17 +1882,14 @@ namespace rsgis{namespace vec{
                 {
                     if((*iterPts) != NULL)
                     {
-                        featureOutput = OGRFeature::CreateFeature(outputDefn);
+                        featureOutput = featWriter.createFeature();
                         featureOutput->SetGeometryDirectly(*iterPts);
                         
-                        if( outputSHPLayer->CreateFeature(featureOutput) != OGRERR_NONE )
-                        {
-                            throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-                        }
-                        OGRFeature::DestroyFeature(featureOutput);
+                        featWriter.writeFeature(featureOutput);
                     }
                 }
             }
+            featWriter.flush();
             GDALClose(outputSHPDS);
             delete pts;
         }
@@ -36,6 +36,7 @@
 #include "vec/RSGISPointData.h"
 #include "vec/RSGISEmptyPolygon.h"
 #include "vec/RSGISVectorUtils.h"
+#include "vec/RSGISVectorFeatureWriter.h"
 
 #include "geom/RSGISPolygon.h"
 #include "geom/RSGISGeometry.h"
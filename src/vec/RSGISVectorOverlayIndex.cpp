@@ -0,0 +1,231 @@
+/*
+ *  RSGISVectorOverlayIndex.cpp
+ *  RSGIS_LIB
+ *
+ *  Created by agent on 19/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISVectorOverlayIndex.h"
+
+namespace rsgis{namespace vec{
+
+    RSGISVectorOverlayIndex::RSGISVectorOverlayIndex()
+    {
+        this->tree = new geos::index::strtree::STRtree();
+        this->built = false;
+    }
+
+    void RSGISVectorOverlayIndex::addLayer(OGRLayer *layer, bool keepFeatures)
+    {
+        if(this->built)
+        {
+            throw RSGISVectorException("Geometries cannot be added to the index once it has been built.");
+        }
+
+        OGRFeature *feature = NULL;
+        layer->ResetReading();
+        while( (feature = layer->GetNextFeature()) != NULL )
+        {
+            if(keepFeatures)
+            {
+                // The feature retains ownership of the geometry.
+                RSGISOverlayIdxGeom *geom = new RSGISOverlayIdxGeom();
+                geom->feat = feature;
+                geom->ogrGeom = feature->GetGeometryRef();
+                geom->geosGeom = NULL;
+                geom->env = NULL;
+                geom->fid = feature->GetFID();
+                geom->idx = this->geoms.size();
+                this->geoms.push_back(geom);
+            }
+            else
+            {
+                this->addGeometry(feature->GetGeometryRef(), feature->GetFID());
+                OGRFeature::DestroyFeature(feature);
+            }
+        }
+        layer->ResetReading();
+    }
+
+    void RSGISVectorOverlayIndex::addGeometry(OGRGeometry *ogrGeom, GIntBig fid)
+    {
+        if(this->built)
+        {
+            throw RSGISVectorException("Geometries cannot be added to the index once it has been built.");
+        }
+
+        RSGISOverlayIdxGeom *geom = new RSGISOverlayIdxGeom();
+        geom->feat = NULL;
+        geom->ogrGeom = NULL;
+        if(ogrGeom != NULL)
+        {
+            geom->ogrGeom = ogrGeom->clone();
+        }
+        geom->geosGeom = NULL;
+        geom->env = NULL;
+        geom->fid = fid;
+        geom->idx = this->geoms.size();
+        this->geoms.push_back(geom);
+    }
+
+    void RSGISVectorOverlayIndex::build(unsigned int numThreads)
+    {
+        if(!this->built)
+        {
+            RSGISVectorUtils vecUtils;
+            for(std::vector<RSGISOverlayIdxGeom*>::iterator iterGeoms = this->geoms.begin(); iterGeoms != this->geoms.end(); ++iterGeoms)
+            {
+                if(((*iterGeoms)->ogrGeom != NULL) && (!(*iterGeoms)->ogrGeom->IsEmpty()))
+                {
+                    (*iterGeoms)->geosGeom = vecUtils.convertOGRGeometry2GEOSGeometry((*iterGeoms)->ogrGeom);
+                    if((*iterGeoms)->geosGeom != NULL)
+                    {
+                        // GEOS computes the envelope on first use; doing it here means the
+                        // geometries are not modified when they are queried from multiple threads.
+                        (*iterGeoms)->geosGeom->getEnvelopeInternal();
+                    }
+                    (*iterGeoms)->env = vecUtils.getEnvelope((*iterGeoms)->ogrGeom);
+                    this->tree->insert((*iterGeoms)->env, (void*)(*iterGeoms));
+                }
+            }
+            // Building the tree now means no thread builds it during a query.
+            this->tree->build();
+            this->built = true;
+        }
+
+        this->clearPreparedCache();
+        if(numThreads == 0)
+        {
+            numThreads = 1;
+        }
+        this->prepCache.resize(numThreads);
+        for(unsigned int i = 0; i < numThreads; ++i)
+        {
+            this->prepCache.at(i).assign(this->geoms.size(), NULL);
+        }
+    }
+
+    void RSGISVectorOverlayIndex::queryCandidates(const geos::geom::Envelope *env, std::vector<size_t> *idxs, bool envCovers)
+    {
+        if(!this->built)
+        {
+            throw RSGISVectorException("The index must be built before it is queried.");
+        }
+
+        idxs->clear();
+        std::vector<void*> items;
+        this->tree->query(env, items);
+
+        RSGISOverlayIdxGeom *geom = NULL;
+        for(std::vector<void*>::iterator iterItems = items.begin(); iterItems != items.end(); ++iterItems)
+        {
+            geom = (RSGISOverlayIdxGeom*) (*iterItems);
+            if(envCovers)
+            {
+                if(geom->env->covers(env))
+                {
+                    idxs->push_back(geom->idx);
+                }
+            }
+            else if(geom->env->intersects(env))
+            {
+                idxs->push_back(geom->idx);
+            }
+        }
+        std::sort(idxs->begin(), idxs->end());
+    }
+
+    bool RSGISVectorOverlayIndex::containsGeom(size_t idx, RSGISOverlayIdxGeom *geom, unsigned int threadIdx)
+    {
+        RSGISOverlayIdxGeom *container = this->geoms.at(idx);
+        const geos::geom::prep::PreparedGeometry *prepGeom = NULL;
+        if(container->geosGeom != NULL)
+        {
+            std::vector<const geos::geom::prep::PreparedGeometry*> *threadCache = &this->prepCache.at(threadIdx);
+            prepGeom = threadCache->at(idx);
+            if(prepGeom == NULL)
+            {
+                prepGeom = RSGISVectorOverlayIndex::prepareGeometry(container->geosGeom);
+                threadCache->at(idx) = prepGeom;
+            }
+        }
+        return RSGISVectorOverlayIndex::containsGeom(prepGeom, container->ogrGeom, geom);
+    }
+
+    bool RSGISVectorOverlayIndex::containsGeom(const geos::geom::prep::PreparedGeometry *prepGeom, OGRGeometry *ogrGeom, RSGISOverlayIdxGeom *geom)
+    {
+        if((prepGeom != NULL) && (geom->geosGeom != NULL))
+        {
+            return prepGeom->contains(geom->geosGeom);
+        }
+        return ogrGeom->Contains(geom->ogrGeom);
+    }
+
+    const geos::geom::prep::PreparedGeometry* RSGISVectorOverlayIndex::prepareGeometry(const geos::geom::Geometry *geom)
+    {
+        if(geom == NULL)
+        {
+            return NULL;
+        }
+        // Depending on the GEOS version prepare() returns a raw or unique pointer.
+        std::unique_ptr<const geos::geom::prep::PreparedGeometry> prepGeom(geos::geom::prep::PreparedGeometryFactory::prepare(geom));
+        return prepGeom.release();
+    }
+
+    void RSGISVectorOverlayIndex::clearPreparedCache()
+    {
+        for(std::vector< std::vector<const geos::geom::prep::PreparedGeometry*> >::iterator iterThreads = this->prepCache.begin(); iterThreads != this->prepCache.end(); ++iterThreads)
+        {
+            for(std::vector<const geos::geom::prep::PreparedGeometry*>::iterator iterPrep = (*iterThreads).begin(); iterPrep != (*iterThreads).end(); ++iterPrep)
+            {
+                if((*iterPrep) != NULL)
+                {
+                    delete (*iterPrep);
+                }
+            }
+        }
+        this->prepCache.clear();
+    }
+
+    RSGISVectorOverlayIndex::~RSGISVectorOverlayIndex()
+    {
+        this->clearPreparedCache();
+        delete this->tree;
+        for(std::vector<RSGISOverlayIdxGeom*>::iterator iterGeoms = this->geoms.begin(); iterGeoms != this->geoms.end(); ++iterGeoms)
+        {
+            if((*iterGeoms)->geosGeom != NULL)
+            {
+                delete (*iterGeoms)->geosGeom;
+            }
+            if((*iterGeoms)->env != NULL)
+            {
+                delete (*iterGeoms)->env;
+            }
+            if((*iterGeoms)->feat != NULL)
+            {
+                OGRFeature::DestroyFeature((*iterGeoms)->feat);
+            }
+            else if((*iterGeoms)->ogrGeom != NULL)
+            {
+                delete (*iterGeoms)->ogrGeom;
+            }
+            delete (*iterGeoms);
+        }
+    }
+
+}}
@@ -0,0 +1,114 @@
+/*
+ *  RSGISVectorOverlayIndex.h
+ *  RSGIS_LIB
+ *
+ *  Created by agent on 19/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISVectorOverlayIndex_H
+#define RSGISVectorOverlayIndex_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+#include "ogrsf_frmts.h"
+
+#include "geos/geom/Envelope.h"
+#include "geos/geom/Geometry.h"
+#include "geos/geom/prep/PreparedGeometry.h"
+#include "geos/geom/prep/PreparedGeometryFactory.h"
+#include "geos/index/strtree/STRtree.h"
+#include "geos/util/TopologyException.h"
+
+#include "common/RSGISVectorException.h"
+
+#include "vec/RSGISVectorUtils.h"
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_vec_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace vec{
+
+    /**
+     * A geometry held within the RSGISVectorOverlayIndex. The feature is only
+     * populated when the index was built from a layer with keepFeatures set.
+     * geosGeom is NULL when the OGR geometry type has no GEOS converter in
+     * which case the predicates fall back to OGR.
+     */
+    struct DllExport RSGISOverlayIdxGeom
+    {
+        OGRFeature *feat;
+        OGRGeometry *ogrGeom;
+        geos::geom::Geometry *geosGeom;
+        geos::geom::Envelope *env;
+        GIntBig fid;
+        size_t idx;
+    };
+
+    /**
+     * Holds a set of geometries in memory within an STR-tree so overlay operations
+     * only test the geometries whose envelopes overlap rather than every pair. Once
+     * build() has been called the index is read-only and can be queried from multiple
+     * threads. Prepared geometries are created on demand and cached per thread as
+     * the GEOS prepared geometries build their internal indexes lazily.
+     */
+    class DllExport RSGISVectorOverlayIndex
+    {
+    public:
+        RSGISVectorOverlayIndex();
+        /** Reads every feature from the layer, in reading order, into the index. */
+        void addLayer(OGRLayer *layer, bool keepFeatures);
+        /** Adds a copy of the geometry to the index. */
+        void addGeometry(OGRGeometry *geom, GIntBig fid);
+        /** Builds the STR-tree and sets up the prepared geometry caches; must be called before querying. */
+        void build(unsigned int numThreads=1);
+        size_t getNumGeoms(){return this->geoms.size();};
+        RSGISOverlayIdxGeom* getGeom(size_t idx){return this->geoms.at(idx);};
+        /** Returns, in ascending order, the indexes of the geometries with an envelope intersecting env (or covering env if envCovers is true). */
+        void queryCandidates(const geos::geom::Envelope *env, std::vector<size_t> *idxs, bool envCovers);
+        /** Tests whether the geometry at idx contains the given geometry (using the prepared geometry for threadIdx). */
+        bool containsGeom(size_t idx, RSGISOverlayIdxGeom *geom, unsigned int threadIdx);
+        /** Tests whether the prepared geometry (which can be NULL) or the OGR geometry contains the given geometry. */
+        static bool containsGeom(const geos::geom::prep::PreparedGeometry *prepGeom, OGRGeometry *ogrGeom, RSGISOverlayIdxGeom *geom);
+        /** Returns a new prepared geometry or NULL if the geometry is NULL. */
+        static const geos::geom::prep::PreparedGeometry* prepareGeometry(const geos::geom::Geometry *geom);
+        ~RSGISVectorOverlayIndex();
+    protected:
+        void clearPreparedCache();
+        std::vector<RSGISOverlayIdxGeom*> geoms;
+        geos::index::strtree::STRtree *tree;
+        std::vector< std::vector<const geos::geom::prep::PreparedGeometry*> > prepCache;
+        bool built;
+    };
+
+}}
+
+#endif
@@ -173,6 +173,34 @@ namespace rsgis{namespace vec{
 		return geosGeomFactory->createPoint(*coord);
 	}
 	
+    geos::geom::Geometry* RSGISVectorUtils::convertOGRGeometry2GEOSGeometry(OGRGeometry *geom)
+    {
+        /// Converts an OGR Geometry to GEOS where a converter exists, otherwise NULL is returned.
+        if((geom == NULL) || geom->IsEmpty())
+        {
+            return NULL;
+        }
+        
+        OGRwkbGeometryType geomType = wkbFlatten(geom->getGeometryType());
+        if(geomType == wkbPolygon)
+        {
+            return this->convertOGRPolygon2GEOSPolygon((OGRPolygon *) geom);
+        }
+        else if(geomType == wkbMultiPolygon)
+        {
+            return this->convertOGRMultiPolygonGEOSMultiPolygon((OGRMultiPolygon *) geom);
+        }
+        else if(geomType == wkbPoint)
+        {
+            return this->convertOGRPoint2GEOSPoint((OGRPoint *) geom);
+        }
+        else if(geomType == wkbLineString)
+        {
+            return this->convertOGRLineString2GEOSLineString((OGRLineString *) geom);
+        }
+        return NULL;
+    }
+	
 	OGRPolygon* RSGISVectorUtils::convertGEOSPolygon2OGRPolygon(geos::geom::Polygon *poly)
 	{		
 		OGRPolygon *ogrPoly = new OGRPolygon();
@@ -84,6 +84,7 @@ namespace rsgis{namespace vec{
 			geos::geom::Polygon* convertOGRPolygon2GEOSPolygon(OGRPolygon *poly);
 			geos::geom::MultiPolygon* convertOGRMultiPolygonGEOSMultiPolygon(OGRMultiPolygon *mPoly);
 			geos::geom::Point* convertOGRPoint2GEOSPoint(OGRPoint *point);
+            geos::geom::Geometry* convertOGRGeometry2GEOSGeometry(OGRGeometry *geom);
 			OGRPolygon* convertGEOSPolygon2OGRPolygon(geos::geom::Polygon *poly);
 			OGRMultiPolygon* convertGEOSMultiPolygon2OGRMultiPolygon(geos::geom::MultiPolygon *mPoly);
 			OGRMultiPolygon* convertGEOSPolygons2OGRMultiPolygon(std::list<geos::geom::Polygon*> *polys);
@@ -731,10 +731,11 @@ namespace rsgis{namespace vec{
 		int numFeatures = inputLayer->GetFeatureCount();
 		int feedback = numFeatures/10;
 		int counter = 0;
+		RSGISVectorFeatureWriter featWriter(outputSHPLayer);
 		inputLayer->ResetReading();
 		while( (feature = inputLayer->GetNextFeature()) != NULL )
 		{
-			featureOutput = OGRFeature::CreateFeature(outputDefn);
+			featureOutput = featWriter.createFeature();
 			if(counter % feedback == 0)
 			{
 				std::cout << "Outputted " << counter << " of " << numFeatures << " features\n";
@@ -798,14 +799,11 @@ namespace rsgis{namespace vec{
 				}
 			}
 			
-			if( outputSHPLayer->CreateFeature(featureOutput) != OGRERR_NONE )
-			{
-				throw RSGISVectorOutputException("Failed to write feature to the output shapefile.");
-			}
-			OGRFeature::DestroyFeature(featureOutput);
+			featWriter.writeFeature(featureOutput);
 			OGRFeature::DestroyFeature(feature);
 			counter++;
-		}	
+		}
+		featWriter.flush();
 	}
 	
 	void ZonalStats::calcImageStats(GDALDataset *image, RSGISZonalPolygons *polygon)
@@ -0,0 +1,588 @@
+/*
+ *  rsgisbench.cpp
+ *  RSGIS_LIB
+ *
+ *  Benchmarks the core raster, RAT and vector engines on synthetic
+ *  data, writing the timings as JSON so they can be tracked across
+ *  commits.
+ *
+ *  Created by agent on 19/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <exception>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <ctime>
+#include <math.h>
+
+#ifndef _MSC_VER
+#include <sys/resource.h>
+#endif
+
+#include "gdal_priv.h"
+#include "ogrsf_frmts.h"
+#include "ogr_spatialref.h"
+
+#include "common/RSGISCommons.h"
+#include "common/RSGISException.h"
+#include "common/RSGISInstrumentation.h"
+
+#include "cmds/RSGISCmdImageCalc.h"
+#include "cmds/RSGISCmdFilterImages.h"
+#include "cmds/RSGISCmdSegmentation.h"
+#include "cmds/RSGISCmdRasterGIS.h"
+#include "cmds/RSGISCmdZonalStats.h"
+#include "cmds/RSGISCmdImageUtils.h"
+
+/** The size of the pixels (in metres) of the synthetic images. */
+#define RSGIS_BENCH_PXL_RES 10.0
+/** The number of categories in the synthetic image which is clumped. */
+#define RSGIS_BENCH_NUM_CATS 8
+
+struct BenchConfig
+{
+    unsigned int size;
+    unsigned int numBands;
+    unsigned int clumpSize;
+    unsigned int numPolys;
+    unsigned int repeats;
+    unsigned int numThreads;
+    std::string format;
+    std::string ext;
+    std::string tmpDir;
+    std::string outFile;
+    std::string label;
+    std::vector<std::string> only;
+};
+
+struct BenchResult
+{
+    std::string name;
+    unsigned long long numPxls;
+    std::vector<double> times;
+    long peakRSSKB;
+    unsigned long long counters[rsgis::rsgisNumInstrumentCounters];
+};
+
+/** A deterministic hash of the pixel location, so the test data are the same on every run. */
+static unsigned long long hashValues(unsigned long long a, unsigned long long b, unsigned long long c)
+{
+    unsigned long long z = (a * 0x9E3779B97F4A7C15ULL) ^ (b * 0xC2B2AE3D27D4EB4FULL) ^ (c * 0x165667B19E3779F9ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static void getProjWKT(std::string *wkt)
+{
+    OGRSpatialReference spatialRef;
+    spatialRef.importFromEPSG(32630);
+    char *wktStr = NULL;
+    spatialRef.exportToWkt(&wktStr);
+    *wkt = std::string(wktStr);
+    CPLFree(wktStr);
+}
+
+/**
+ * Creates an image of numBands float bands with a smooth surface plus noise,
+ * where xOff and yOff are the location (in pixels) of the image within the scene.
+ */
+static void createValuesImage(const BenchConfig &config, std::string outputImage, unsigned int xOff, unsigned int yOff, unsigned int width, unsigned int height)
+{
+    GDALDriver *gdalDriver = GetGDALDriverManager()->GetDriverByName(config.format.c_str());
+    if(gdalDriver == NULL)
+    {
+        throw rsgis::RSGISException("The GDAL driver '" + config.format + "' is not available.");
+    }
+    GDALDataset *dataset = gdalDriver->Create(outputImage.c_str(), width, height, config.numBands, GDT_Float32, NULL);
+    if(dataset == NULL)
+    {
+        throw rsgis::RSGISException("Could not create image: " + outputImage);
+    }
+    double trans[6] = {xOff * RSGIS_BENCH_PXL_RES, RSGIS_BENCH_PXL_RES, 0, (config.size - yOff) * RSGIS_BENCH_PXL_RES, 0, -RSGIS_BENCH_PXL_RES};
+    dataset->SetGeoTransform(trans);
+    std::string wkt;
+    getProjWKT(&wkt);
+    dataset->SetProjection(wkt.c_str());
+
+    float *rowData = new float[width];
+    for(unsigned int b = 0; b < config.numBands; ++b)
+    {
+        GDALRasterBand *band = dataset->GetRasterBand(b+1);
+        for(unsigned int y = 0; y < height; ++y)
+        {
+            unsigned int sceneY = y + yOff;
+            for(unsigned int x = 0; x < width; ++x)
+            {
+                unsigned int sceneX = x + xOff;
+                double surface = 500.0 * sin(sceneX / 50.0) * cos(sceneY / 70.0);
+                rowData[x] = 1000.0 + (b * 100.0) + surface + (hashValues(sceneX, sceneY, b) % 50);
+            }
+            band->RasterIO(GF_Write, 0, y, width, 1, rowData, width, 1, GDT_Float32, 0, 0);
+        }
+    }
+    delete[] rowData;
+    GDALClose(dataset);
+}
+
+/** Creates an image of cells (clumpSize x clumpSize pixels), each given one of RSGIS_BENCH_NUM_CATS categories, to be clumped. */
+static void createCategoriesImage(const BenchConfig &config, std::string outputImage)
+{
+    GDALDriver *gdalDriver = GetGDALDriverManager()->GetDriverByName(config.format.c_str());
+    GDALDataset *dataset = gdalDriver->Create(outputImage.c_str(), config.size, config.size, 1, GDT_UInt32, NULL);
+    if(dataset == NULL)
+    {
+        throw rsgis::RSGISException("Could not create image: " + outputImage);
+    }
+    double trans[6] = {0, RSGIS_BENCH_PXL_RES, 0, config.size * RSGIS_BENCH_PXL_RES, 0, -RSGIS_BENCH_PXL_RES};
+    dataset->SetGeoTransform(trans);
+    std::string wkt;
+    getProjWKT(&wkt);
+    dataset->SetProjection(wkt.c_str());
+
+    unsigned int *rowData = new unsigned int[config.size];
+    GDALRasterBand *band = dataset->GetRasterBand(1);
+    for(unsigned int y = 0; y < config.size; ++y)
+    {
+        for(unsigned int x = 0; x < config.size; ++x)
+        {
+            rowData[x] = (hashValues(x / config.clumpSize, y / config.clumpSize, 1000) % RSGIS_BENCH_NUM_CATS) + 1;
+        }
+        band->RasterIO(GF_Write, 0, y, config.size, 1, rowData, config.size, 1, GDT_UInt32, 0, 0);
+    }
+    delete[] rowData;
+    GDALClose(dataset);
+}
+
+/** Creates a shapefile with a grid of numPolys x numPolys square polygons covering the images. */
+static void createPolygons(const BenchConfig &config, std::string outputVec, std::string lyrName)
+{
+    GDALDriver *vecDriver = GetGDALDriverManager()->GetDriverByName("ESRI Shapefile");
+    if(vecDriver == NULL)
+    {
+        throw rsgis::RSGISException("The ESRI Shapefile driver is not available.");
+    }
+    vecDriver->Delete(outputVec.c_str());
+    GDALDataset *vecDS = vecDriver->Create(outputVec.c_str(), 0, 0, 0, GDT_Unknown, NULL);
+    if(vecDS == NULL)
+    {
+        throw rsgis::RSGISException("Could not create vector: " + outputVec);
+    }
+    OGRSpatialReference spatialRef;
+    spatialRef.importFromEPSG(32630);
+    OGRLayer *vecLyr = vecDS->CreateLayer(lyrName.c_str(), &spatialRef, wkbPolygon, NULL);
+    if(vecLyr == NULL)
+    {
+        throw rsgis::RSGISException("Could not create vector layer: " + lyrName);
+    }
+    OGRFieldDefn idField("PolyID", OFTInteger);
+    vecLyr->CreateField(&idField);
+
+    double polySize = (config.size * RSGIS_BENCH_PXL_RES) / config.numPolys;
+    double sceneMaxY = config.size * RSGIS_BENCH_PXL_RES;
+    for(unsigned int i = 0; i < config.numPolys; ++i)
+    {
+        for(unsigned int j = 0; j < config.numPolys; ++j)
+        {
+            double minX = j * polySize;
+            double maxY = sceneMaxY - (i * polySize);
+            OGRLinearRing ring;
+            ring.addPoint(minX, maxY);
+            ring.addPoint(minX + polySize, maxY);
+            ring.addPoint(minX + polySize, maxY - polySize);
+            ring.addPoint(minX, maxY - polySize);
+            ring.addPoint(minX, maxY);
+            OGRPolygon poly;
+            poly.addRing(&ring);
+
+            OGRFeature *feature = OGRFeature::CreateFeature(vecLyr->GetLayerDefn());
+            feature->SetField("PolyID", (int)((i * config.numPolys) + j));
+            feature->SetGeometry(&poly);
+            if(vecLyr->CreateFeature(feature) != OGRERR_NONE)
+            {
+                throw rsgis::RSGISException("Could not write a polygon to: " + outputVec);
+            }
+            OGRFeature::DestroyFeature(feature);
+        }
+    }
+    GDALClose(vecDS);
+}
+
+/** Resets the peak resident set size where the OS allows it (Linux), so the peak of each benchmark is reported. */
+static void resetPeakRSS()
+{
+#ifdef __linux__
+    FILE *clearRefs = fopen("/proc/self/clear_refs", "w");
+    if(clearRefs != NULL)
+    {
+        fputs("5", clearRefs);
+        fclose(clearRefs);
+    }
+#endif
+}
+
+/** The peak resident set size in KB, or -1 if it is not available. */
+static long getPeakRSSKB()
+{
+#ifdef __linux__
+    std::ifstream statusFile("/proc/self/status");
+    std::string line;
+    while(std::getline(statusFile, line))
+    {
+        if(line.compare(0, 6, "VmHWM:") == 0)
+        {
+            return atol(line.substr(6).c_str());
+        }
+    }
+#endif
+#ifndef _MSC_VER
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+#ifdef __APPLE__
+        return usage.ru_maxrss / 1024;
+#else
+        return usage.ru_maxrss;
+#endif
+    }
+#endif
+    return -1;
+}
+
+static void runBenchmark(const BenchConfig &config, std::string name, unsigned long long numPxls, std::function<void()> setup, std::function<void()> run, std::vector<BenchResult> *results)
+{
+    if((!config.only.empty()) && (std::find(config.only.begin(), config.only.end(), name) == config.only.end()))
+    {
+        return;
+    }
+    std::cout << "Benchmark: " << name << std::endl;
+
+    BenchResult result;
+    result.name = name;
+    result.numPxls = numPxls;
+    result.peakRSSKB = -1;
+
+    rsgis::RSGISInstrumentation *instrumentation = rsgis::RSGISInstrumentation::getInstance();
+    for(unsigned int r = 0; r < config.repeats; ++r)
+    {
+        setup();
+        instrumentation->reset();
+        resetPeakRSS();
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+        run();
+        std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
+        result.times.push_back(std::chrono::duration<double>(endTime - startTime).count());
+        result.peakRSSKB = std::max(result.peakRSSKB, getPeakRSSKB());
+    }
+    // The counters are for the last repeat.
+    for(int i = 0; i < rsgis::rsgisNumInstrumentCounters; ++i)
+    {
+        result.counters[i] = instrumentation->getCount((rsgis::RSGISInstrumentCounter)i);
+    }
+    results->push_back(result);
+}
+
+static double getMedian(std::vector<double> vals)
+{
+    std::sort(vals.begin(), vals.end());
+    size_t mid = vals.size() / 2;
+    if((vals.size() % 2) == 0)
+    {
+        return (vals[mid-1] + vals[mid]) / 2.0;
+    }
+    return vals[mid];
+}
+
+static void writeResultsJSON(const BenchConfig &config, std::vector<BenchResult> *results, std::ostream &out)
+{
+    time_t nowTime = time(NULL);
+    char timeStr[32];
+    strftime(timeStr, 32, "%Y-%m-%dT%H:%M:%SZ", gmtime(&nowTime));
+
+    out << "{\n";
+    out << "  \"benchmark\": \"rsgis_bench\",\n";
+    out << "  \"label\": \"" << config.label << "\",\n";
+    out << "  \"timestamp\": \"" << timeStr << "\",\n";
+    out << "  \"gdal_version\": \"" << GDALVersionInfo("RELEASE_NAME") << "\",\n";
+    out << "  \"config\": {\"size\": " << config.size << ", \"bands\": " << config.numBands << ", \"clump_size\": " << config.clumpSize << ", \"polygons\": " << (config.numPolys * config.numPolys) << ", \"repeats\": " << config.repeats << ", \"threads\": " << config.numThreads << ", \"format\": \"" << config.format << "\"},\n";
+    out << "  \"results\": [";
+    for(std::vector<BenchResult>::iterator iterResult = results->begin(); iterResult != results->end(); ++iterResult)
+    {
+        double medianTime = getMedian((*iterResult).times);
+        double minTime = *std::min_element((*iterResult).times.begin(), (*iterResult).times.end());
+        out << ((iterResult == results->begin())?"\n":",\n");
+        out << "    {\"name\": \"" << (*iterResult).name << "\", \"pixels\": " << (*iterResult).numPxls << ", \"times_seconds\": [";
+        for(size_t i = 0; i < (*iterResult).times.size(); ++i)
+        {
+            out << ((i > 0)?", ":"") << (*iterResult).times[i];
+        }
+        out << "], \"min_seconds\": " << minTime << ", \"median_seconds\": " << medianTime;
+        out << ", \"mpx_per_second\": " << ((medianTime > 0)?(((*iterResult).numPxls / 1.0e6) / medianTime):0.0);
+        out << ", \"peak_rss_kb\": " << (*iterResult).peakRSSKB << ", \"counters\": {";
+        for(int i = 0; i < rsgis::rsgisNumInstrumentCounters; ++i)
+        {
+            out << ((i > 0)?", ":"") << "\"" << rsgis::RSGISInstrumentation::getCounterName((rsgis::RSGISInstrumentCounter)i) << "\": " << (*iterResult).counters[i];
+        }
+        out << "}}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+static void printUsage()
+{
+    std::cout << "Usage: rsgis_bench [options]\n";
+    std::cout << "  --size N        width and height of the test images in pixels (default 2000)\n";
+    std::cout << "  --bands N       number of bands in the test image (default 3)\n";
+    std::cout << "  --clumpsize N   size in pixels of the cells which are clumped (default 10)\n";
+    std::cout << "  --polys N       the polygons are a N x N grid (default 50)\n";
+    std::cout << "  --repeats N     number of times each benchmark is run (default 3)\n";
+    std::cout << "  --threads N     threads used by the filter (0 = all, default 1)\n";
+    std::cout << "  --format F      GDAL format of the images (default KEA)\n";
+    std::cout << "  --ext E         file extension for the format (default kea)\n";
+    std::cout << "  --tmpdir D      directory for the test data (default .)\n";
+    std::cout << "  --out F         output JSON file (default rsgis_bench.json)\n";
+    std::cout << "  --label L       label (e.g., commit) recorded with the results\n";
+    std::cout << "  --only A,B      only run the named benchmarks (band_maths, window_filter,\n";
+    std::cout << "                  clump, rat_basic_stats, zonal_stats, mosaic)\n";
+}
+
+int main(int argc, char **argv)
+{
+    BenchConfig config;
+    config.size = 2000;
+    config.numBands = 3;
+    config.clumpSize = 10;
+    config.numPolys = 50;
+    config.repeats = 3;
+    config.numThreads = 1;
+    config.format = "KEA";
+    config.ext = "kea";
+    config.tmpDir = ".";
+    config.outFile = "rsgis_bench.json";
+    config.label = "";
+
+    for(int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if((arg == "-h") || (arg == "--help"))
+        {
+            printUsage();
+            return 0;
+        }
+        if((i + 1) >= argc)
+        {
+            std::cerr << "A value must be given for " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+        std::string val = argv[++i];
+        if(arg == "--size"){config.size = atoi(val.c_str());}
+        else if(arg == "--bands"){config.numBands = atoi(val.c_str());}
+        else if(arg == "--clumpsize"){config.clumpSize = atoi(val.c_str());}
+        else if(arg == "--polys"){config.numPolys = atoi(val.c_str());}
+        else if(arg == "--repeats"){config.repeats = atoi(val.c_str());}
+        else if(arg == "--threads"){config.numThreads = atoi(val.c_str());}
+        else if(arg == "--format"){config.format = val;}
+        else if(arg == "--ext"){config.ext = val;}
+        else if(arg == "--tmpdir"){config.tmpDir = val;}
+        else if(arg == "--out"){config.outFile = val;}
+        else if(arg == "--label"){config.label = val;}
+        else if(arg == "--only")
+        {
+            std::stringstream onlyStream(val);
+            std::string name;
+            while(std::getline(onlyStream, name, ','))
+            {
+                config.only.push_back(name);
+            }
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    if((config.size < 2) || (config.numBands < 2) || (config.clumpSize == 0) || (config.numPolys == 0) || (config.repeats == 0))
+    {
+        std::cerr << "The size and number of bands must be at least 2 and the clump size, number of polygons and repeats greater than 0." << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        GDALAllRegister();
+        OGRRegisterAll();
+
+        std::string base = config.tmpDir + "/rsgis_bench_";
+        std::string valsImage = base + "vals." + config.ext;
+        std::string catsImage = base + "cats." + config.ext;
+        std::string clumpsImage = base + "clumps." + config.ext;
+        std::string statsClumpsImage = base + "statsclumps." + config.ext;
+        std::string outImage = base + "out." + config.ext;
+        std::string polysLyr = "rsgis_bench_polys";
+        std::string polysVec = config.tmpDir + "/" + polysLyr + ".shp";
+        unsigned int tileSize = (config.size + 1) / 2;
+        std::string tileImages[4];
+        for(unsigned int i = 0; i < 4; ++i)
+        {
+            std::stringstream tileName;
+            tileName << base << "tile" << i << "." << config.ext;
+            tileImages[i] = tileName.str();
+        }
+
+        std::cout << "Creating the test data in " << config.tmpDir << std::endl;
+        createValuesImage(config, valsImage, 0, 0, config.size, config.size);
+        createCategoriesImage(config, catsImage);
+        for(unsigned int i = 0; i < 4; ++i)
+        {
+            unsigned int xOff = (i % 2) * tileSize;
+            unsigned int yOff = (i / 2) * tileSize;
+            createValuesImage(config, tileImages[i], xOff, yOff, std::min(tileSize, config.size - xOff), std::min(tileSize, config.size - yOff));
+        }
+        // Clumps with a RAT to be populated by rat_basic_stats (in case clump is not run).
+        rsgis::cmds::executeClump(catsImage, statsClumpsImage, config.format, false, false, 0, true);
+
+        unsigned long long numPxls = ((unsigned long long)config.size) * config.size;
+        std::vector<BenchResult> results;
+        std::function<void()> noSetup = [](){};
+
+        rsgis::cmds::VariableStruct bandMathsVars[2];
+        for(unsigned int i = 0; i < 2; ++i)
+        {
+            bandMathsVars[i].image = valsImage;
+            bandMathsVars[i].name = (i == 0)?"b1":"b2";
+            bandMathsVars[i].bandNum = i + 1;
+        }
+        runBenchmark(config, "band_maths", numPxls, noSetup, [&](){
+            rsgis::cmds::executeBandMaths(bandMathsVars, 2, outImage, "(b1-b2)/(b1+b2)", config.format, rsgis::rsgis_32float, false);
+        }, &results);
+
+        rsgis::cmds::RSGISFilterParameters meanFilter;
+        meanFilter.type = "Mean";
+        meanFilter.fileEnding = "mean";
+        meanFilter.option = "";
+        meanFilter.size = 5;
+        meanFilter.nLooks = 0;
+        meanFilter.stddev = 0;
+        meanFilter.stddevX = 0;
+        meanFilter.stddevY = 0;
+        meanFilter.angle = 0;
+        std::vector<rsgis::cmds::RSGISFilterParameters*> filterParams;
+        filterParams.push_back(&meanFilter);
+        runBenchmark(config, "window_filter", numPxls * config.numBands, noSetup, [&](){
+            rsgis::cmds::executeFilter(valsImage, &filterParams, base + "filter", config.format, config.ext, rsgis::rsgis_32float, false, config.numThreads);
+        }, &results);
+
+        runBenchmark(config, "clump", numPxls, noSetup, [&](){
+            rsgis::cmds::executeClump(catsImage, clumpsImage, config.format, false, false, 0, true);
+        }, &results);
+
+        std::vector<rsgis::cmds::RSGISBandAttStatsCmds*> bandStats;
+        for(unsigned int b = 1; b <= config.numBands; ++b)
+        {
+            std::stringstream bandName;
+            bandName << "b" << b;
+            rsgis::cmds::RSGISBandAttStatsCmds *bandStat = new rsgis::cmds::RSGISBandAttStatsCmds();
+            bandStat->band = b;
+            bandStat->calcMin = true;
+            bandStat->minField = bandName.str() + "Min";
+            bandStat->calcMax = true;
+            bandStat->maxField = bandName.str() + "Max";
+            bandStat->calcMean = true;
+            bandStat->meanField = bandName.str() + "Mean";
+            bandStat->calcStdDev = true;
+            bandStat->stdDevField = bandName.str() + "StdDev";
+            bandStat->calcSum = false;
+            bandStat->sumField = "";
+            bandStats.push_back(bandStat);
+        }
+        runBenchmark(config, "rat_basic_stats", numPxls * config.numBands, noSetup, [&](){
+            rsgis::cmds::executePopulateRATWithStats(valsImage, statsClumpsImage, &bandStats, 1);
+        }, &results);
+        for(std::vector<rsgis::cmds::RSGISBandAttStatsCmds*>::iterator iterStats = bandStats.begin(); iterStats != bandStats.end(); ++iterStats)
+        {
+            delete *iterStats;
+        }
+
+        std::vector<rsgis::cmds::RSGISZonalBandAttrsCmds> zonalAtts;
+        for(unsigned int b = 1; b <= config.numBands; ++b)
+        {
+            std::stringstream bandName;
+            bandName << "b" << b;
+            rsgis::cmds::RSGISZonalBandAttrsCmds zonalAtt = rsgis::cmds::RSGISZonalBandAttrsCmds();
+            zonalAtt.band = b;
+            zonalAtt.baseName = bandName.str();
+            zonalAtt.outMin = true;
+            zonalAtt.outMax = true;
+            zonalAtt.outMean = true;
+            zonalAtt.outStDev = true;
+            zonalAtt.outCount = false;
+            zonalAtt.outMode = false;
+            zonalAtt.outMedian = false;
+            zonalAtt.outSum = false;
+            zonalAtt.minThres = -std::numeric_limits<float>::infinity();
+            zonalAtt.maxThres = std::numeric_limits<float>::infinity();
+            zonalAtts.push_back(zonalAtt);
+        }
+        // The polygons are recreated for each run as the statistics are written to them.
+        runBenchmark(config, "zonal_stats", numPxls * config.numBands, [&](){
+            createPolygons(config, polysVec, polysLyr);
+        }, [&](){
+            // The command takes ownership of (and deletes) the band attributes.
+            std::vector<rsgis::cmds::RSGISZonalBandAttrsCmds> *runZonalAtts = new std::vector<rsgis::cmds::RSGISZonalBandAttrsCmds>(zonalAtts);
+            rsgis::cmds::executePixelBandStatsVecLyr(valsImage, polysVec, polysLyr, runZonalAtts, 1, false);
+        }, &results);
+
+        runBenchmark(config, "mosaic", numPxls * config.numBands, noSetup, [&](){
+            rsgis::cmds::executeImageMosaic(tileImages, 4, outImage, 0, 0, 0, 0, config.format, rsgis::rsgis_32float);
+        }, &results);
+
+        std::ofstream outJSON(config.outFile.c_str(), std::ios::out | std::ios::trunc);
+        if(!outJSON.is_open())
+        {
+            throw rsgis::RSGISException("Could not open the output file: " + config.outFile);
+        }
+        writeResultsJSON(config, &results, outJSON);
+        outJSON.close();
+
+        std::cout << "\nBenchmark\tMedian (s)\tMpx/s\tPeak RSS (KB)\n";
+        for(std::vector<BenchResult>::iterator iterResult = results.begin(); iterResult != results.end(); ++iterResult)
+        {
+            double medianTime = getMedian((*iterResult).times);
+            std::cout << (*iterResult).name << "\t" << medianTime << "\t" << ((medianTime > 0)?(((*iterResult).numPxls / 1.0e6) / medianTime):0.0) << "\t" << (*iterResult).peakRSSKB << std::endl;
+        }
+        std::cout << "Results written to " << config.outFile << std::endl;
+    }
+    catch(std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}